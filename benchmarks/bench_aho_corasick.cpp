@@ -0,0 +1,128 @@
+// bench_aho_corasick.cpp
+// 多关键字扫描吞吐（MB/s）：Aho–Corasick 一次扫描对比逐个模式调用
+// find_substring（SIMD 子串搜索）/ kmp_search，关键字个数 10 / 100 / 1000 / 10000；
+// 另测最左最长模式、忽略大小写、流式 64 KiB 分块，以及稠密表预算对吞吐的影响。
+// 逐模式搜索在关键字多时很慢，只在前两档运行。
+// 文本大小（MB）可由命令行指定：bench_aho_corasick [mb]
+
+#include "bench_common.h"
+#include "../src/algorithms/aho_corasick.h"
+#include "../src/algorithms/string.h"
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace zen::bench;
+
+static const int reps = 3;
+
+// 运行 fn reps 次，按总字节数报告 MB/s
+template<typename Fn>
+static void throughput(const char* name, size_t bytes, Fn fn) {
+    size_t sink = 0;
+    timer t;
+    for (int r = 0; r < reps; ++r) {
+        sink += fn();
+        do_not_optimize(sink);
+    }
+    double ms = t.elapsed_ms();
+    double mbps = static_cast<double>(bytes) * reps / (ms * 1e3);
+    printf("  %-40s %10.2f ms  %9.1f MB/s  (matches %zu)\n", name, ms / reps, mbps, sink / reps);
+}
+
+// 随机小写「单词」：长度 4~12
+static std::string random_word(rng& g) {
+    size_t len = 4 + g.next() % 9;
+    std::string w(len, 'a');
+    for (auto& c : w) c = static_cast<char>('a' + g.next() % 26);
+    return w;
+}
+
+// 由词表拼出的文本，keywords 中的词按约 1% 的概率混入
+static std::string make_text(size_t bytes, const std::vector<std::string>& keywords, rng& g) {
+    std::string s;
+    s.reserve(bytes + 64);
+    while (s.size() < bytes) {
+        if (g.next() % 100 == 0) s += keywords[g.next() % keywords.size()];
+        else s += random_word(g);
+        s += ' ';
+    }
+    return s;
+}
+
+int main(int argc, char** argv) {
+    size_t mb = argc > 1 ? static_cast<size_t>(strtoull(argv[1], nullptr, 10)) : 32;
+    rng g(11);
+
+    std::vector<std::string> all_keywords;
+    for (int i = 0; i < 10000; ++i) all_keywords.push_back(random_word(g));
+    std::string text = make_text(mb << 20, all_keywords, g);
+    size_t n = text.size();
+    printf("text = %zu MB\n\n", n >> 20);
+
+    for (size_t k : { 10u, 100u, 1000u, 10000u }) {
+        std::vector<std::string> keywords(all_keywords.begin(), all_keywords.begin() + k);
+        timer build;
+        zen::aho_corasick ac(keywords);
+        double build_ms = build.elapsed_ms();
+        printf("%zu keywords: %zu states (%zu dense), %zu classes, %.1f KiB, build %.2f ms\n", k,
+               ac.state_count(), ac.dense_state_count(), ac.class_count(),
+               static_cast<double>(ac.memory_bytes()) / 1024.0, build_ms);
+
+        throughput("aho_corasick all matches", n, [&] {
+            size_t c = 0;
+            ac.for_each_match(text, [&c](const zen::aho_corasick_match&) { ++c; });
+            return c;
+        });
+        throughput("aho_corasick leftmost-longest", n, [&] {
+            size_t c = 0;
+            ac.for_each_match(text, [&c](const zen::aho_corasick_match&) { ++c; },
+                              zen::aho_corasick::match_kind::leftmost_longest);
+            return c;
+        });
+        throughput("aho_corasick stream (64 KiB chunks)", n, [&] {
+            size_t c = 0;
+            auto sink = [&c](const zen::aho_corasick_match&) { ++c; };
+            zen::aho_corasick::stream st(ac);
+            for (size_t pos = 0; pos < n; pos += 64 << 10) st.feed(std::string_view(text).substr(pos, 64 << 10), sink);
+            st.finish(sink);
+            return c;
+        });
+
+        zen::aho_corasick::options icase;
+        icase.case_insensitive = true;
+        zen::aho_corasick aci(keywords, icase);
+        throughput("aho_corasick case-insensitive", n, [&] {
+            size_t c = 0;
+            aci.for_each_match(text, [&c](const zen::aho_corasick_match&) { ++c; });
+            return c;
+        });
+
+        zen::aho_corasick::options sparse;
+        sparse.dense_table_bytes = 16 << 10;
+        zen::aho_corasick acs(keywords, sparse);
+        char label[64];
+        snprintf(label, sizeof(label), "aho_corasick 16 KiB dense (%zu dense)", acs.dense_state_count());
+        throughput(label, n, [&] {
+            size_t c = 0;
+            acs.for_each_match(text, [&c](const zen::aho_corasick_match&) { ++c; });
+            return c;
+        });
+
+        if (k <= 100) {
+            throughput("find_all_substrings per keyword", n, [&] {
+                size_t c = 0;
+                for (const auto& w : keywords) c += zen::find_all_substrings(text, w).size();
+                return c;
+            });
+            throughput("kmp_search per keyword", n, [&] {
+                size_t c = 0;
+                for (const auto& w : keywords) c += zen::kmp_search(text, w).size();
+                return c;
+            });
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+// bench_btree_map.cpp
+// 对比 btree_map（B+ 树）与 map（红黑树）的点查找 / 插入 / 区间扫描 / 全量遍历
+
+#include "bench_common.h"
+#include "../src/containers/associative/btree_map.h"
+#include "../src/containers/associative/map.h"
+#include <algorithm>
+#include <vector>
+
+using namespace zen;
+using namespace zen::bench;
+
+template<typename Map>
+void run(const char* title, const std::vector<uint64_t>& keys, const std::vector<uint64_t>& probes) {
+    printf("%s (n = %zu)\n", title, keys.size());
+    Map m;
+
+    timer t;
+    for (uint64_t k : keys) m.insert({k, k});
+    report("insert (random order)", t.elapsed_ms(), keys.size());
+
+    t.reset();
+    uint64_t sum = 0;
+    for (uint64_t k : probes) {
+        auto it = m.find(k);
+        if (it != m.end()) sum += it->second;
+    }
+    do_not_optimize(sum);
+    report("find (random, 50% hit)", t.elapsed_ms(), probes.size());
+
+    // 每次扫描从随机位置起的 100 个元素
+    const size_t scans = probes.size() / 10, width = 100;
+    t.reset();
+    sum = 0;
+    for (size_t i = 0; i < scans; ++i) {
+        auto it = m.lower_bound(probes[i]);
+        for (size_t j = 0; j < width && it != m.end(); ++j, ++it) sum += it->second;
+    }
+    do_not_optimize(sum);
+    report("range scan (100 elems)", t.elapsed_ms(), scans * width);
+
+    t.reset();
+    sum = 0;
+    for (auto& kv : m) sum += kv.second;
+    do_not_optimize(sum);
+    report("full iteration", t.elapsed_ms(), keys.size());
+
+    t.reset();
+    for (size_t i = 0; i < keys.size(); i += 2) m.erase(keys[i]);
+    report("erase half", t.elapsed_ms(), keys.size() / 2);
+}
+
+int main() {
+    const size_t N = 2000000;
+    rng g;
+    std::vector<uint64_t> keys(N), probes(N);
+    for (auto& k : keys) k = g.next() | 1;
+    for (size_t i = 0; i < N; ++i) probes[i] = (i & 1) ? keys[g.next() % N] : (g.next() & ~1ULL);
+
+    run<map<uint64_t, uint64_t>>("map (red-black tree)", keys, probes);
+    run<btree_map<uint64_t, uint64_t>>("btree_map (B+ tree)", keys, probes);
+
+    // 已排序输入：批量构建 vs 逐个插入
+    std::vector<pair<uint64_t, uint64_t>> sorted;
+    std::vector<uint64_t> sk(keys);
+    std::sort(sk.begin(), sk.end());
+    sk.erase(std::unique(sk.begin(), sk.end()), sk.end());
+    for (uint64_t k : sk) sorted.push_back(pair<uint64_t, uint64_t>(k, k));
+
+    printf("sorted input (n = %zu)\n", sorted.size());
+    timer t;
+    {
+        map<uint64_t, uint64_t> m;
+        for (auto& kv : sorted) m.insert(kv);
+        report("map insert (ascending)", t.elapsed_ms(), sorted.size());
+    }
+    t.reset();
+    {
+        btree_map<uint64_t, uint64_t> m;
+        for (auto& kv : sorted) m.insert(kv);
+        report("btree_map insert (ascending)", t.elapsed_ms(), sorted.size());
+    }
+    t.reset();
+    {
+        btree_map<uint64_t, uint64_t> m(sorted_unique, sorted.begin(), sorted.end());
+        do_not_optimize(m);
+        report("btree_map bulk load", t.elapsed_ms(), sorted.size());
+    }
+    return 0;
+}
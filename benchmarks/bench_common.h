@@ -0,0 +1,74 @@
+#ifndef ZEN_BENCHMARKS_BENCH_COMMON_H
+#define ZEN_BENCHMARKS_BENCH_COMMON_H
+
+// 基准测试公共工具：计时、防优化、可复现的伪随机数
+// 不依赖 Google Benchmark，直接编译运行即可：
+//   g++ -O2 -std=c++17 -I../src bench_xxx.cpp -o bench_xxx -lpthread
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace zen {
+namespace bench {
+
+/**
+ * @brief 阻止编译器把基准中的计算结果优化掉
+ */
+template<typename T>
+inline void do_not_optimize(const T& v) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(v) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &v;
+#endif
+}
+
+/**
+ * @brief 单调时钟计时器
+ */
+class timer {
+public:
+    timer() : start_(std::chrono::steady_clock::now()) {}
+
+    void reset() { start_ = std::chrono::steady_clock::now(); }
+
+    double elapsed_ms() const {
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start_).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief splitmix64：生成可复现的测试数据
+ */
+class rng {
+public:
+    explicit rng(uint64_t seed = 0x1234567) : state_(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t state_;
+};
+
+/**
+ * @brief 打印一行结果：名称、总耗时、每次操作纳秒数
+ */
+inline void report(const char* name, double ms, size_t ops) {
+    printf("  %-40s %10.2f ms  %8.2f ns/op\n", name, ms, ms * 1e6 / static_cast<double>(ops));
+}
+
+} // namespace bench
+} // namespace zen
+
+#endif // ZEN_BENCHMARKS_BENCH_COMMON_H
@@ -0,0 +1,57 @@
+// bench_flat_hash_map.cpp
+// 对比 flat_hash_map（开放寻址）与 unordered_map（链式桶）的插入 / 查找 / 删除 / 遍历
+
+#include "bench_common.h"
+#include "../src/containers/associative/flat_hash_map.h"
+#include "../src/containers/associative/unordered_map.h"
+#include <cstdlib>
+#include <vector>
+
+using namespace zen;
+using namespace zen::bench;
+
+template<typename Map>
+void run(const char* title, const std::vector<uint64_t>& keys, const std::vector<uint64_t>& misses) {
+    printf("%s (n = %zu)\n", title, keys.size());
+    Map m;
+
+    timer t;
+    for (uint64_t k : keys) m.insert({k, k});
+    report("insert", t.elapsed_ms(), keys.size());
+
+    t.reset();
+    uint64_t sum = 0;
+    for (uint64_t k : keys) sum += m.find(k)->second;
+    do_not_optimize(sum);
+    report("find (hit)", t.elapsed_ms(), keys.size());
+
+    t.reset();
+    size_t found = 0;
+    for (uint64_t k : misses) found += m.contains(k) ? 1 : 0;
+    do_not_optimize(found);
+    report("find (miss)", t.elapsed_ms(), misses.size());
+
+    t.reset();
+    sum = 0;
+    for (auto& kv : m) sum += kv.second;
+    do_not_optimize(sum);
+    report("iterate", t.elapsed_ms(), keys.size());
+
+    t.reset();
+    for (uint64_t k : keys) m.erase(k);
+    report("erase", t.elapsed_ms(), keys.size());
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(atol(argv[1])) : 1000000;
+
+    rng r;
+    std::vector<uint64_t> keys(n), misses(n);
+    for (size_t i = 0; i < n; ++i) keys[i]   = r.next();
+    for (size_t i = 0; i < n; ++i) misses[i] = r.next();
+
+    run<unordered_map<uint64_t, uint64_t>>("unordered_map (chained)", keys, misses);
+    run<flat_hash_map<uint64_t, uint64_t>>("flat_hash_map (open addressing)", keys, misses);
+    return 0;
+}
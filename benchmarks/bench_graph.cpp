@@ -0,0 +1,192 @@
+// bench_graph.cpp
+// CSR 图（algorithms/csr_graph.h）对比邻接表 Graph 上的原有算法，R-MAT 随机图
+// （幂律度分布，平均出度 16）：
+//   构造：Graph -> csr_graph、边表 -> csr_graph（顺序 / 并行）、二进制边表文件 mmap 加载
+//   BFS：Graph bfs_order 对比方向优化 BFS（对称图，会切换到自底向上）
+//   SSSP：二叉堆 Dijkstra（CSR 上）对比 delta-stepping；原有 dijkstra 为 O(n^2)，
+//         只在 2^14 个顶点的子图上给出参考
+//   连通分量：find_connected_components(Graph) 对比并行并查集
+// 并行版本在 1–16 个线程下运行（t 个线程 = t-1 个线程池工作线程 + 调用线程）。
+// 规模可由命令行指定：bench_graph [log2 顶点数]
+
+#include "bench_common.h"
+#include "../src/algorithms/csr_graph.h"
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <vector>
+
+using namespace zen::bench;
+
+static const size_t thread_counts[] = { 1, 2, 4, 8, 16 };
+
+// 对每个线程数运行一次 fn(policy)（t = 1 时传 seq），打印耗时与相对基线的加速比
+template<typename Fn>
+static void scale(const char* name, Fn fn) {
+    printf("%s\n", name);
+    double base_ms = 0;
+    for (size_t t : thread_counts) {
+        double ms;
+        if (t == 1) {
+            timer tm;
+            fn(zen::execution::seq);
+            ms = tm.elapsed_ms();
+            base_ms = ms;
+        } else {
+            zen::thread_pool pool(t - 1);
+            auto policy = zen::execution::par.on(pool);
+            timer tm;
+            fn(policy);
+            ms = tm.elapsed_ms();
+        }
+        char label[64];
+        snprintf(label, sizeof(label), "%2zu threads", t);
+        printf("  %-16s %10.2f ms  speedup %5.2fx\n", label, ms, base_ms / ms);
+    }
+    printf("\n");
+}
+
+static void single(const char* name, double ms) {
+    printf("  %-40s %10.2f ms\n", name, ms);
+}
+
+// R-MAT(0.57, 0.19, 0.19) 边生成器，权重均匀分布在 [1, 256)
+static std::vector<zen::csr_edge<double>> rmat_edges(unsigned log_n, size_t m, rng& g) {
+    std::vector<zen::csr_edge<double>> edges(m);
+    for (auto& e : edges) {
+        uint32_t u = 0, v = 0;
+        for (unsigned bit = 0; bit < log_n; ++bit) {
+            uint64_t r = g.next() % 100;
+            if (r >= 57) {
+                if (r < 76) v |= 1u << bit;
+                else if (r < 95) u |= 1u << bit;
+                else { u |= 1u << bit; v |= 1u << bit; }
+            }
+        }
+        e = { u, v, 1.0 + static_cast<double>(g.next() % 255) };
+    }
+    return edges;
+}
+
+static std::vector<double> heap_dijkstra(const zen::csr_graph<double>& g, uint32_t s) {
+    std::vector<double> dist(g.vertex_count(), std::numeric_limits<double>::infinity());
+    using item = std::pair<double, uint32_t>;
+    std::priority_queue<item, std::vector<item>, std::greater<item>> pq;
+    dist[s] = 0;
+    pq.push({0.0, s});
+    while (!pq.empty()) {
+        item top = pq.top();
+        pq.pop();
+        if (top.first > dist[top.second]) continue;
+        uint32_t u = top.second;
+        for (auto i = g.offsets()[u]; i < g.offsets()[u + 1]; ++i) {
+            double nd = top.first + g.weights()[i];
+            uint32_t v = g.targets()[i];
+            if (nd < dist[v]) { dist[v] = nd; pq.push({nd, v}); }
+        }
+    }
+    return dist;
+}
+
+int main(int argc, char** argv) {
+    unsigned log_n = argc > 1 ? static_cast<unsigned>(strtoul(argv[1], nullptr, 10)) : 19;
+    size_t n = size_t(1) << log_n, m = n * 16;
+    printf("R-MAT graph: %zu vertices, %zu directed edges (symmetrized for BFS / SSSP / components)\n\n", n, m);
+
+    rng g(21);
+    auto edges = rmat_edges(log_n, m, g);
+    zen::csr_options sym;
+    sym.symmetrize = true;
+
+    // ---- 构造 ----
+    printf("construction\n");
+    zen::Graph<uint32_t, double> adj;
+    {
+        timer t;
+        for (size_t v = 0; v < n; ++v) adj.add_node(static_cast<uint32_t>(v));
+        for (const auto& e : edges) adj.add_undirected_edge(e.source, e.target, e.weight);
+        single("Graph (adjacency lists, undirected)", t.elapsed_ms());
+    }
+    {
+        timer t;
+        zen::csr_graph<double> c(adj);
+        single("csr_graph from Graph", t.elapsed_ms());
+        do_not_optimize(c.edge_count());
+    }
+    const char* path = "/tmp/zen_bench_graph.bin";
+    zen::write_edge_list(path, n, edges);
+    printf("\n");
+    scale("csr_graph from edge list (symmetrize, sort neighbors)", [&](auto policy) {
+        zen::csr_graph<double> c(policy, n, edges, sym);
+        do_not_optimize(c.edge_count());
+    });
+    scale("csr_graph from mmap'ed edge list file", [&](auto policy) {
+        zen::mapped_edge_list file(path);
+        zen::csr_graph<double> c(policy, file, sym);
+        do_not_optimize(c.edge_count());
+    });
+    remove(path);
+
+    zen::csr_graph<double> csr(n, edges, sym);
+    printf("csr_graph: %zu edges, %.1f MiB\n\n", csr.edge_count(),
+           static_cast<double>(csr.memory_bytes()) / (1024.0 * 1024.0));
+
+    // 从度数最大的顶点出发，保证大部分顶点可达
+    uint32_t source = 0;
+    for (uint32_t v = 0; v < n; ++v) if (csr.degree(v) > csr.degree(source)) source = v;
+
+    // ---- BFS ----
+    printf("BFS\n");
+    {
+        timer t;
+        auto order = zen::bfs_order(adj, source);
+        single("Graph bfs_order", t.elapsed_ms());
+        do_not_optimize(order.size());
+    }
+    printf("\n");
+    scale("direction-optimizing BFS (csr_graph)", [&](auto policy) {
+        auto r = zen::bfs(policy, csr, source);
+        do_not_optimize(r.depth[n - 1]);
+    });
+
+    // ---- SSSP ----
+    printf("SSSP\n");
+    {
+        const uint32_t small_n = 1u << 14;
+        zen::Graph<uint32_t, double> small;
+        for (uint32_t v = 0; v < small_n; ++v) small.add_node(v);
+        for (const auto& e : edges) {
+            if (e.source < small_n && e.target < small_n) small.add_undirected_edge(e.source, e.target, e.weight);
+        }
+        timer t;
+        auto d = zen::dijkstra(small, 0);
+        single("Graph dijkstra, O(n^2), 2^14-vertex subgraph", t.elapsed_ms());
+        do_not_optimize(d[small_n - 1]);
+    }
+    {
+        timer t;
+        auto d = heap_dijkstra(csr, source);
+        single("binary-heap Dijkstra (csr_graph)", t.elapsed_ms());
+        do_not_optimize(d[n - 1]);
+    }
+    printf("\n");
+    scale("delta-stepping (default delta)", [&](auto policy) {
+        auto d = zen::delta_stepping(policy, csr, source);
+        do_not_optimize(d[n - 1]);
+    });
+
+    // ---- 连通分量 ----
+    printf("connected components\n");
+    {
+        timer t;
+        auto c = zen::find_connected_components(adj);
+        single("Graph find_connected_components (BFS)", t.elapsed_ms());
+        do_not_optimize(c[n - 1]);
+    }
+    printf("\n");
+    scale("union-find components (csr_graph, Afforest sampling)", [&](auto policy) {
+        auto c = zen::find_connected_components(policy, csr);
+        do_not_optimize(c[n - 1]);
+    });
+    return 0;
+}
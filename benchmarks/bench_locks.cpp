@@ -0,0 +1,245 @@
+// bench_locks.cpp
+// 竞争下的锁开销，2 ~ 64 个线程：
+//   counter    : 所有线程反复加锁、递增共享计数器、解锁（临界区几纳秒），总操作数固定
+//   work       : 临界区内约 100 ns 的计算，锁外约 1 µs 的计算（更接近真实负载）
+//   notify_all : N 个线程在条件变量上等待，广播后全部醒来再各自持锁一次，测一轮的耗时
+//   ping-pong  : 两个线程经条件变量交替传递令牌（notify_one 的唤醒延迟）
+// 对比：原 spinlock（volatile + 无退避，原样保留，仅改名）、带退避的 spinlock、ticket_lock、
+//       zen::mutex（pthread）、fast_mutex；condition_variable 对比 fast_condition_variable。
+// 线程数多于核数时自旋锁的持锁线程可能被换出：原实现与 ticket_lock 在这种情况下
+// 会退化到每次交接都要等一个时间片，超过 4 倍核数时不测（显示 "-"）。
+// 线程数可由命令行指定：bench_locks [threads...]
+
+#include "bench_common.h"
+#include "../src/threading/sync/fast_mutex.h"
+#include "../src/threading/sync/fast_condition_variable.h"
+#include "../src/threading/sync/spinlock.h"
+#include "../src/threading/sync/mutex.h"
+#include "../src/threading/sync/condition_variable.h"
+#include "../src/threading/sync/lock_guard.h"
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace zen::bench;
+
+// ============================================================================
+// 原实现（原样保留，仅改名）
+// ============================================================================
+
+namespace legacy {
+
+inline bool cas(volatile int* ptr, int expected, int desired) noexcept {
+    return __sync_bool_compare_and_swap(ptr, expected, desired);
+}
+
+inline int atomic_load(const volatile int* ptr) noexcept {
+    zen::detail::compiler_barrier();
+    int val = *ptr;
+    zen::detail::compiler_barrier();
+    return val;
+}
+
+inline void atomic_store(volatile int* ptr, int val) noexcept {
+    zen::detail::compiler_barrier();
+    *ptr = val;
+    zen::detail::compiler_barrier();
+}
+
+class spinlock {
+public:
+    spinlock() noexcept : locked_(0) {}
+
+    void lock() noexcept {
+        while (true) {
+            if (atomic_load(&locked_) == 0 && cas(&locked_, 0, 1)) {
+                return;
+            }
+            while (atomic_load(&locked_) != 0) {
+                zen::detail::cpu_relax();
+            }
+        }
+    }
+
+    void unlock() noexcept {
+        zen::detail::memory_fence();
+        atomic_store(&locked_, 0);
+    }
+
+private:
+    volatile int locked_;
+    char padding_[64 - sizeof(int)];
+};
+
+} // namespace legacy
+
+// ============================================================================
+// 工作负载
+// ============================================================================
+
+static void spin_work(int iters) {
+    volatile long x = 0;
+    for (int i = 0; i < iters; ++i) x = x + i;
+}
+
+// 共 total 次加锁，平均分给 threads 个线程；返回每次加锁的平均纳秒数
+template<typename Lock>
+static double contended(size_t threads, long total, int inside, int outside) {
+    Lock lock;
+    long counter = 0;
+    long per = total / static_cast<long>(threads);
+    std::atomic<bool> go{false};
+    std::vector<std::thread> ts;
+    for (size_t t = 0; t < threads; ++t) {
+        ts.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (long i = 0; i < per; ++i) {
+                lock.lock();
+                ++counter;
+                if (inside) spin_work(inside);
+                lock.unlock();
+                if (outside) spin_work(outside);
+            }
+        });
+    }
+    timer tm;
+    go.store(true, std::memory_order_release);
+    for (auto& t : ts) t.join();
+    double ms = tm.elapsed_ms();
+    do_not_optimize(counter);
+    return ms * 1e6 / static_cast<double>(per * static_cast<long>(threads));
+}
+
+template<typename Mutex, typename Cond>
+static double broadcast_round(size_t waiters, int rounds) {
+    Mutex m;
+    Cond cv;
+    int epoch = 0, arrived = 0;
+    bool stop = false;
+    std::vector<std::thread> ts;
+    for (size_t t = 0; t < waiters; ++t) {
+        ts.emplace_back([&] {
+            int seen = 0;
+            zen::unique_lock<Mutex> ul(m);
+            for (;;) {
+                ++arrived;
+                cv.wait(ul, [&] { return epoch != seen || stop; });
+                if (stop) return;
+                seen = epoch;
+                spin_work(50);   // 醒来后持锁做一点事
+            }
+        });
+    }
+    auto wait_arrived = [&](int target) {
+        for (;;) {
+            {
+                zen::lock_guard<Mutex> lg(m);
+                if (arrived >= target) return;
+            }
+            std::this_thread::yield();
+        }
+    };
+    wait_arrived(static_cast<int>(waiters));
+    timer tm;
+    for (int r = 1; r <= rounds; ++r) {
+        {
+            zen::lock_guard<Mutex> lg(m);
+            epoch = r;
+        }
+        cv.notify_all();
+        wait_arrived(static_cast<int>(waiters) * (r + 1));
+    }
+    double ms = tm.elapsed_ms();
+    {
+        zen::lock_guard<Mutex> lg(m);
+        stop = true;
+    }
+    cv.notify_all();
+    for (auto& t : ts) t.join();
+    return ms * 1e3 / rounds;
+}
+
+template<typename Mutex, typename Cond>
+static double ping_pong(int exchanges) {
+    Mutex m;
+    Cond cv;
+    int turn = 0;
+    std::thread other([&] {
+        zen::unique_lock<Mutex> ul(m);
+        for (int i = 0; i < exchanges; ++i) {
+            cv.wait(ul, [&] { return turn == 1; });
+            turn = 0;
+            cv.notify_one();
+        }
+    });
+    timer tm;
+    {
+        zen::unique_lock<Mutex> ul(m);
+        for (int i = 0; i < exchanges; ++i) {
+            turn = 1;
+            cv.notify_one();
+            cv.wait(ul, [&] { return turn == 0; });
+        }
+    }
+    double ms = tm.elapsed_ms();
+    other.join();
+    return ms * 1e6 / exchanges;
+}
+
+static void row(const char* name, size_t threads, const std::vector<double>& ns) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s, %zu threads", name, threads);
+    printf("  %-28s", label);
+    for (double v : ns) {
+        if (v < 0) printf(" %12s", "-");
+        else       printf(" %9.1f ns", v);
+    }
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    std::vector<size_t> thread_counts;
+    for (int i = 1; i < argc; ++i) thread_counts.push_back(static_cast<size_t>(strtoul(argv[i], nullptr, 10)));
+    if (thread_counts.empty()) thread_counts = { 2, 4, 8, 16, 32, 64 };
+
+    size_t cores = std::thread::hardware_concurrency();
+    if (cores == 0) cores = 1;
+    printf("hardware_concurrency = %zu\n", cores);
+    printf("  %-28s %12s %12s %12s %12s %12s\n", "per lock acquisition",
+           "legacy spin", "spinlock", "ticket_lock", "zen::mutex", "fast_mutex");
+
+    const long total = 400000;
+    for (int pass = 0; pass < 2; ++pass) {
+        int inside  = pass == 0 ? 0 : 30;
+        int outside = pass == 0 ? 0 : 300;
+        const char* name = pass == 0 ? "counter" : "work";
+        for (size_t t : thread_counts) {
+            bool fair_ok = t <= cores * 4;   // 自旋锁交接依赖下一个线程正在运行
+            row(name, t, {
+                fair_ok ? contended<legacy::spinlock>(t, total, inside, outside) : -1,
+                contended<zen::spinlock>(t, total, inside, outside),
+                fair_ok ? contended<zen::ticket_lock>(t, total, inside, outside) : -1,
+                contended<zen::mutex>(t, total, inside, outside),
+                contended<zen::fast_mutex>(t, total, inside, outside),
+            });
+        }
+        printf("\n");
+    }
+
+    printf("  %-28s %15s %15s\n", "condition variables", "pthread cv", "fast cv");
+    for (size_t t : thread_counts) {
+        char label[64];
+        snprintf(label, sizeof(label), "notify_all, %zu waiters", t);
+        double a = broadcast_round<zen::mutex, zen::condition_variable>(t, 200);
+        double b = broadcast_round<zen::fast_mutex, zen::fast_condition_variable>(t, 200);
+        printf("  %-28s %12.1f us %12.1f us\n", label, a, b);
+    }
+    {
+        double a = ping_pong<zen::mutex, zen::condition_variable>(20000);
+        double b = ping_pong<zen::fast_mutex, zen::fast_condition_variable>(20000);
+        printf("  %-28s %12.1f ns %12.1f ns\n", "ping-pong, 2 threads", a, b);
+    }
+    return 0;
+}
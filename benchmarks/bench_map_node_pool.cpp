@@ -0,0 +1,50 @@
+// bench_map_node_pool.cpp
+// 红黑树节点分配：zen::map（slab 节点池）对比 std::map（每节点一次 malloc）
+// 的插入 / 删除 / clear 开销
+
+#include "bench_common.h"
+#include "../src/containers/associative/map.h"
+#include <map>
+#include <vector>
+
+using namespace zen::bench;
+
+template<typename Map>
+void run(const char* title, const std::vector<uint64_t>& keys, int rounds) {
+    printf("%s (n = %zu, rounds = %d)\n", title, keys.size(), rounds);
+    double t_insert = 0, t_erase = 0, t_clear = 0;
+    size_t ops = keys.size() * static_cast<size_t>(rounds);
+
+    for (int r = 0; r < rounds; ++r) {
+        Map m;
+        timer t;
+        for (uint64_t k : keys) m.insert({k, k});
+        t_insert += t.elapsed_ms();
+
+        // 删除一半再插回：空闲列表复用
+        t.reset();
+        for (size_t i = 0; i < keys.size(); i += 2) m.erase(keys[i]);
+        for (size_t i = 0; i < keys.size(); i += 2) m.insert({keys[i], keys[i]});
+        t_erase += t.elapsed_ms();
+
+        t.reset();
+        m.clear();
+        t_clear += t.elapsed_ms();
+        do_not_optimize(m);
+    }
+
+    report("insert", t_insert, ops);
+    report("erase + reinsert half", t_erase, ops);
+    report("clear", t_clear, ops);
+}
+
+int main() {
+    const size_t N = 200000;
+    rng g;
+    std::vector<uint64_t> keys(N);
+    for (auto& k : keys) k = g.next();
+
+    run<std::map<uint64_t, uint64_t>>("std::map (per-node malloc)", keys, 5);
+    run<zen::map<uint64_t, uint64_t>>("zen::map (node_pool)", keys, 5);
+    return 0;
+}
@@ -0,0 +1,124 @@
+// bench_numeric.cpp
+// 数值内核（algorithms/numeric_simd.h）：
+//   逐元素循环（accumulate / inner_product / partial_sum / 两遍方差）对比
+//   向量内核的通用 / SSE2 / AVX2 三级实现，以及 fast / kahan / pairwise 三种求和模式
+// 数组默认 8M 个元素（double 64 MB，超出末级缓存），报告吞吐量 GB/s
+// 元素个数可由命令行指定：bench_numeric [n]
+
+#include "bench_common.h"
+#include "../src/algorithms/numeric.h"
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace zen::bench;
+
+static const int rounds = 5;
+
+// 取 rounds 次中最快的一次，bytes 为单次读写的字节数
+template<typename Fn>
+static void run(const char* name, size_t bytes, Fn fn) {
+    double best = 1e300;
+    for (int r = 0; r < rounds; ++r) {
+        timer t;
+        auto v = fn();
+        double ms = t.elapsed_ms();
+        do_not_optimize(v);
+        if (ms < best) best = ms;
+    }
+    printf("  %-40s %10.2f ms  %8.2f GB/s\n", name, best, static_cast<double>(bytes) / (best * 1e6));
+}
+
+template<typename T>
+static void bench_type(const char* type_name, size_t n, rng& g) {
+    std::vector<T> a(n), b(n), out(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = static_cast<T>(static_cast<double>(g.next() >> 11) * 0x1.0p-53 * 100.0);
+        b[i] = static_cast<T>(static_cast<double>(g.next() >> 11) * 0x1.0p-53);
+    }
+    const T* p = a.data();
+    const T* q = b.data();
+    const size_t one = n * sizeof(T);
+    using namespace zen::detail;
+
+    printf("%s, n = %zu\n", type_name, n);
+
+    printf(" sum\n");
+    run("accumulate (strict order)", one, [&] { return zen::accumulate(p, p + n, T(0)); });
+    run("generic fast", one, [&] { return sum_generic(p, n); });
+#if ZEN_HAVE_SSE2
+    run("sse2 fast", one, [&] { return sum_sse2(p, n); });
+#endif
+#if ZEN_HAVE_AVX2_TARGET
+    if (zen::cpu_supports_avx2_target()) run("avx2 fast", one, [&] { return sum_avx2(p, n); });
+#endif
+    run("generic kahan", one, [&] { return sum_kahan_generic(p, n); });
+#if ZEN_HAVE_SSE2
+    run("sse2 kahan", one, [&] { return sum_kahan_sse2(p, n); });
+#endif
+#if ZEN_HAVE_AVX2_TARGET
+    if (zen::cpu_supports_avx2_target()) run("avx2 kahan", one, [&] { return sum_kahan_avx2(p, n); });
+#endif
+    run("zen::sum pairwise (dispatched)", one, [&] { return zen::sum(p, n, zen::summation::pairwise); });
+    run("zen::reduce (dispatched)", one, [&] { return zen::reduce(p, p + n, T(0)); });
+
+    printf(" dot\n");
+    run("inner_product (strict order)", 2 * one, [&] { return zen::inner_product(p, p + n, q, T(0)); });
+    run("generic", 2 * one, [&] { return dot_generic(p, q, n); });
+#if ZEN_HAVE_SSE2
+    run("sse2", 2 * one, [&] { return dot_sse2(p, q, n); });
+#endif
+#if ZEN_HAVE_AVX2_TARGET
+    if (zen::cpu_supports_avx2_target()) run("avx2", 2 * one, [&] { return dot_avx2(p, q, n); });
+#endif
+
+    printf(" min / max\n");
+    run("scalar loop", one, [&] {
+        T lo = p[0], hi = p[0];
+        for (size_t i = 1; i < n; ++i) {
+            if (p[i] < lo) lo = p[i];
+            if (p[i] > hi) hi = p[i];
+        }
+        return lo + hi;
+    });
+    run("zen::minmax_value (dispatched)", one, [&] {
+        auto r = zen::minmax_value(p, n);
+        return r.lo + r.hi;
+    });
+
+    printf(" prefix sum (read + write)\n");
+    run("partial_sum (strict order)", 2 * one, [&] { return *(zen::partial_sum(p, p + n, out.data()) - 1); });
+    run("generic", 2 * one, [&] { return prefix_sum_generic(p, out.data(), n, T(0)); });
+#if ZEN_HAVE_SSE2
+    run("sse2", 2 * one, [&] { return prefix_sum_sse2(p, out.data(), n, T(0)); });
+#endif
+#if ZEN_HAVE_AVX2_TARGET
+    if (zen::cpu_supports_avx2_target()) run("avx2", 2 * one, [&] { return prefix_sum_avx2(p, out.data(), n, T(0)); });
+#endif
+
+    printf(" variance\n");
+    run("two-pass scalar", one, [&] {
+        double s = 0;
+        for (size_t i = 0; i < n; ++i) s += p[i];
+        double mean = s / static_cast<double>(n), ss = 0;
+        for (size_t i = 0; i < n; ++i) ss += (p[i] - mean) * (p[i] - mean);
+        return ss / static_cast<double>(n - 1);
+    });
+    run("welford scalar", one, [&] {
+        zen::moments m;
+        for (size_t i = 0; i < n; ++i) m.add(p[i]);
+        return m.variance();
+    });
+    run("zen::compute_moments (dispatched)", one, [&] { return zen::compute_moments(p, n).variance(); });
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(strtoul(argv[1], nullptr, 10)) : (size_t(1) << 23);
+    rng g(19);
+    printf("cpu: sse2 %d, avx2 %d; best of %d rounds\n\n",
+           ZEN_HAVE_SSE2 ? 1 : 0, zen::cpu_supports_avx2_target() ? 1 : 0, rounds);
+    bench_type<double>("double", n, g);
+    bench_type<float>("float", n, g);
+    return 0;
+}
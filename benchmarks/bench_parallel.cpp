@@ -0,0 +1,103 @@
+// bench_parallel.cpp
+// 并行算法（algorithms/parallel.h）在 1–64 个线程下的扩展性：
+//   sort / stable_sort（uint64_t）、reduce、transform_reduce、transform、
+//   inclusive_scan、find_if（命中在 3/4 处）、count_if
+// t 个线程 = t-1 个线程池工作线程 + 调用线程；t = 1 为顺序版本（基线）。
+// 超过物理核数的线程数只用来观察过量订阅时的开销。
+// 元素个数可由命令行指定：bench_parallel [n]
+
+#include "bench_common.h"
+#include "../src/algorithms/parallel.h"
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace zen::bench;
+
+static const size_t thread_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+// 对每个线程数运行一次 fn(policy)（t = 1 时传 seq），打印耗时与相对基线的加速比
+template<typename Fn>
+static void scale(const char* name, size_t n, Fn fn) {
+    printf("%s (n = %zu)\n", name, n);
+    double base_ms = 0;
+    for (size_t t : thread_counts) {
+        double ms;
+        if (t == 1) {
+            timer tm;
+            fn(zen::execution::seq);
+            ms = tm.elapsed_ms();
+            base_ms = ms;
+        } else {
+            zen::thread_pool pool(t - 1);
+            auto policy = zen::execution::par.on(pool);
+            timer tm;
+            fn(policy);
+            ms = tm.elapsed_ms();
+        }
+        char label[64];
+        snprintf(label, sizeof(label), "%2zu threads", t);
+        printf("  %-16s %10.2f ms  speedup %5.2fx\n", label, ms, base_ms / ms);
+    }
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(strtoull(argv[1], nullptr, 10)) : 20000000;
+    printf("hardware_concurrency = %u\n\n", zen::thread::hardware_concurrency());
+
+    rng g(11);
+    std::vector<uint64_t> keys(n);
+    for (auto& k : keys) k = g.next();
+    std::vector<double> xs(n);
+    for (size_t i = 0; i < n; ++i) xs[i] = static_cast<double>(keys[i] % 1000000) * 1e-3;
+
+    scale("sort uint64_t", n, [&](auto policy) {
+        std::vector<uint64_t> v = keys;
+        zen::sort(policy, v.begin(), v.end());
+        do_not_optimize(v[n / 2]);
+    });
+
+    scale("stable_sort uint64_t", n, [&](auto policy) {
+        std::vector<uint64_t> v = keys;
+        zen::stable_sort(policy, v.begin(), v.end());
+        do_not_optimize(v[n / 2]);
+    });
+
+    scale("reduce double", n, [&](auto policy) {
+        double s = zen::reduce(policy, xs.begin(), xs.end(), 0.0);
+        do_not_optimize(s);
+    });
+
+    scale("transform_reduce sqrt-ish", n, [&](auto policy) {
+        double s = zen::transform_reduce(policy, xs.begin(), xs.end(), 0.0,
+                                         [](double a, double b) { return a + b; },
+                                         [](double x) { return x * x / (1.0 + x); });
+        do_not_optimize(s);
+    });
+
+    std::vector<double> out(n);
+    scale("transform x*3+1", n, [&](auto policy) {
+        zen::transform(policy, xs.begin(), xs.end(), out.begin(), [](double x) { return x * 3 + 1; });
+        do_not_optimize(out[n / 2]);
+    });
+
+    scale("inclusive_scan double", n, [&](auto policy) {
+        zen::inclusive_scan(policy, xs.begin(), xs.end(), out.begin());
+        do_not_optimize(out[n - 1]);
+    });
+
+    std::vector<uint64_t> needle(n, 0);
+    needle[n / 4 * 3] = 1;
+    scale("find_if (hit at 3/4)", n, [&](auto policy) {
+        auto it = zen::find_if(policy, needle.begin(), needle.end(), [](uint64_t x) { return x != 0; });
+        do_not_optimize(it);
+    });
+
+    scale("count_if", n, [&](auto policy) {
+        size_t c = zen::count_if(policy, keys.begin(), keys.end(), [](uint64_t x) { return (x & 7) == 3; });
+        do_not_optimize(c);
+    });
+
+    return 0;
+}
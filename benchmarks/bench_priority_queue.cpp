@@ -0,0 +1,247 @@
+// bench_priority_queue.cpp
+// 优先队列（containers/adapter/priority_queue.h）：
+//   堆操作：随机 push / pop，std::priority_queue 对比 d 叉 priority_queue（d = 2 / 4 / 8）
+//   Dijkstra：路网规模的网格图（默认 1024 x 1024 个路口，4 邻接，约 10% 的路段缺失，
+//             整数行驶时间 1..1000），对比
+//     - 原 graph.h 的 O(n^2) 线性扫描（只在 128 x 128 的子网格上给出参考）
+//     - 压入重复项、弹出时跳过过期项的二叉堆 / 4 叉堆
+//     - indexed_heap（d = 2 / 4 / 8，无重复项，即现在的 dijkstra）
+//     - radix_heap（dijkstra_radix）
+//   Prim：原 O(n^2) 版本（子网格）对比 indexed_heap 版本
+// 网格边长可由命令行指定：bench_priority_queue [side]
+
+#include "bench_common.h"
+#include "../src/containers/adapter/priority_queue.h"
+#include "../src/algorithms/graph.h"
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+using namespace zen::bench;
+
+using road_graph = zen::Graph<uint32_t, uint32_t>;
+using dist_t = uint32_t;
+
+static void single(const char* name, double ms) {
+    printf("  %-44s %10.2f ms\n", name, ms);
+}
+
+// side x side 网格，每条路段以 90% 的概率存在，权重 1..1000
+static road_graph make_grid(size_t side, rng& g) {
+    road_graph graph;
+    for (size_t v = 0; v < side * side; ++v) graph.add_node(static_cast<uint32_t>(v));
+    for (size_t y = 0; y < side; ++y) {
+        for (size_t x = 0; x < side; ++x) {
+            size_t v = y * side + x;
+            if (x + 1 < side && g.next() % 10 != 0) {
+                graph.add_undirected_edge(v, v + 1, static_cast<dist_t>(1 + g.next() % 1000));
+            }
+            if (y + 1 < side && g.next() % 10 != 0) {
+                graph.add_undirected_edge(v, v + side, static_cast<dist_t>(1 + g.next() % 1000));
+            }
+        }
+    }
+    return graph;
+}
+
+// 原 graph.h 的实现：每轮线性扫描未访问顶点取最小值
+static std::vector<dist_t> legacy_dijkstra(const road_graph& graph, size_t start) {
+    const dist_t INF = std::numeric_limits<dist_t>::max();
+    size_t n = graph.node_count();
+    std::vector<dist_t> dist(n, INF);
+    std::vector<bool> visited(n, false);
+    dist[start] = 0;
+    for (size_t i = 0; i < n; ++i) {
+        size_t u = n;
+        dist_t min_dist = INF;
+        for (size_t j = 0; j < n; ++j) {
+            if (!visited[j] && dist[j] < min_dist) {
+                min_dist = dist[j];
+                u = j;
+            }
+        }
+        if (u == n) break;
+        visited[u] = true;
+        for (const auto& edge : graph.neighbors(u)) {
+            if (dist[u] + edge.second < dist[edge.first]) dist[edge.first] = dist[u] + edge.second;
+        }
+    }
+    return dist;
+}
+
+static dist_t legacy_prim(const road_graph& graph) {
+    const dist_t INF = std::numeric_limits<dist_t>::max();
+    size_t n = graph.node_count();
+    std::vector<dist_t> key(n, INF);
+    std::vector<bool> in_mst(n, false);
+    key[0] = 0;
+    dist_t total = 0;
+    for (size_t count = 0; count < n; ++count) {
+        size_t u = n;
+        dist_t min_key = INF;
+        for (size_t v = 0; v < n; ++v) {
+            if (!in_mst[v] && key[v] < min_key) {
+                min_key = key[v];
+                u = v;
+            }
+        }
+        if (u == n) break;
+        in_mst[u] = true;
+        total += key[u];
+        for (const auto& edge : graph.neighbors(u)) {
+            if (!in_mst[edge.first] && edge.second < key[edge.first]) key[edge.first] = edge.second;
+        }
+    }
+    return total;
+}
+
+// 压入重复项的 Dijkstra：Queue 为以 (dist, vertex) 为元素的小顶堆
+template<typename Queue>
+static std::vector<dist_t> lazy_dijkstra(const road_graph& graph, size_t start) {
+    std::vector<dist_t> dist(graph.node_count(), std::numeric_limits<dist_t>::max());
+    Queue pq;
+    dist[start] = 0;
+    pq.push({ 0, start });
+    size_t pushes = 1;
+    while (!pq.empty()) {
+        auto top = pq.top();
+        pq.pop();
+        if (top.first > dist[top.second]) continue;
+        for (const auto& edge : graph.neighbors(top.second)) {
+            dist_t nd = top.first + edge.second;
+            if (nd < dist[edge.first]) {
+                dist[edge.first] = nd;
+                pq.push({ nd, edge.first });
+                ++pushes;
+            }
+        }
+    }
+    do_not_optimize(pushes);
+    return dist;
+}
+
+template<size_t Arity>
+static std::vector<dist_t> indexed_dijkstra(const road_graph& graph, size_t start) {
+    std::vector<dist_t> dist(graph.node_count(), std::numeric_limits<dist_t>::max());
+    zen::indexed_heap<dist_t, zen::less<dist_t>, Arity> heap(graph.node_count());
+    dist[start] = 0;
+    heap.push(start, 0);
+    while (!heap.empty()) {
+        size_t u = heap.top();
+        dist_t du = heap.top_key();
+        heap.pop();
+        for (const auto& edge : graph.neighbors(u)) {
+            dist_t nd = du + edge.second;
+            if (nd < dist[edge.first]) {
+                dist[edge.first] = nd;
+                heap.push_or_decrease(edge.first, nd);
+            }
+        }
+    }
+    return dist;
+}
+
+template<typename Queue>
+static void heap_ops(const char* name, const std::vector<uint32_t>& keys) {
+    timer t;
+    Queue q;
+    uint64_t sum = 0;
+    // 先涨到一半再交替 push / pop，最后清空
+    size_t half = keys.size() / 2;
+    for (size_t i = 0; i < half; ++i) q.push(keys[i]);
+    for (size_t i = half; i < keys.size(); ++i) {
+        sum += q.top();
+        q.pop();
+        q.push(keys[i]);
+    }
+    while (!q.empty()) {
+        sum += q.top();
+        q.pop();
+    }
+    do_not_optimize(sum);
+    single(name, t.elapsed_ms());
+}
+
+int main(int argc, char** argv) {
+    size_t side = argc > 1 ? static_cast<size_t>(strtoul(argv[1], nullptr, 10)) : 1024;
+    rng g(18);
+
+    // ---- 堆操作 ----
+    std::vector<uint32_t> keys(1 << 22);
+    for (auto& k : keys) k = static_cast<uint32_t>(g.next());
+    printf("heap operations: %zu random uint32 keys (push half, then pop+push, then drain)\n", keys.size());
+    heap_ops<std::priority_queue<uint32_t>>("std::priority_queue (binary)", keys);
+    heap_ops<zen::priority_queue<uint32_t, zen::vector<uint32_t>, zen::less<uint32_t>, 2>>(
+        "zen::priority_queue d=2", keys);
+    heap_ops<zen::priority_queue<uint32_t>>("zen::priority_queue d=4 (default)", keys);
+    heap_ops<zen::priority_queue<uint32_t, zen::vector<uint32_t>, zen::less<uint32_t>, 8>>(
+        "zen::priority_queue d=8", keys);
+    printf("\n");
+
+    // ---- Dijkstra ----
+    road_graph grid = make_grid(side, g);
+    size_t n = grid.node_count(), m = 0;
+    for (size_t v = 0; v < n; ++v) m += grid.neighbors(v).size();
+    size_t source = n / 2 + side / 2;
+    printf("road grid: %zu x %zu = %zu vertices, %zu directed edges\n", side, side, n, m);
+
+    const size_t small_side = side < 128 ? side : 128;
+    road_graph small = make_grid(small_side, g);
+    {
+        timer t;
+        auto d = legacy_dijkstra(small, 0);
+        single("legacy O(n^2) dijkstra, 128 x 128", t.elapsed_ms());
+        do_not_optimize(d.back());
+    }
+    {
+        timer t;
+        auto d = zen::dijkstra(small, 0);
+        single("dijkstra (indexed 4-ary), 128 x 128", t.elapsed_ms());
+        do_not_optimize(d.back());
+    }
+
+    using item = std::pair<dist_t, size_t>;
+    std::vector<dist_t> expect;
+    auto run = [&](const char* name, auto fn) {
+        timer t;
+        auto d = fn();
+        single(name, t.elapsed_ms());
+        if (expect.empty()) expect = d;
+        else if (d != expect) printf("  !! %s: distances differ\n", name);
+    };
+    run("std::priority_queue, duplicates", [&] {
+        return lazy_dijkstra<std::priority_queue<item, std::vector<item>, std::greater<item>>>(grid, source);
+    });
+    run("zen::priority_queue d=4, duplicates", [&] {
+        return lazy_dijkstra<zen::priority_queue<item, zen::vector<item>, std::greater<item>>>(grid, source);
+    });
+    run("indexed_heap d=2", [&] { return indexed_dijkstra<2>(grid, source); });
+    run("indexed_heap d=4 (zen::dijkstra)", [&] { return zen::dijkstra(grid, source); });
+    run("indexed_heap d=8", [&] { return indexed_dijkstra<8>(grid, source); });
+    run("radix_heap (zen::dijkstra_radix)", [&] { return zen::dijkstra_radix(grid, source); });
+    printf("\n");
+
+    // ---- Prim ----
+    printf("minimum spanning tree\n");
+    {
+        timer t;
+        auto w = legacy_prim(small);
+        single("legacy O(n^2) prim, 128 x 128", t.elapsed_ms());
+        do_not_optimize(w);
+    }
+    {
+        timer t;
+        auto w = zen::prim_mst(small);
+        single("prim_mst (indexed 4-ary), 128 x 128", t.elapsed_ms());
+        do_not_optimize(w);
+    }
+    {
+        timer t;
+        auto w = zen::prim_mst(grid);
+        single("prim_mst (indexed 4-ary), full grid", t.elapsed_ms());
+        do_not_optimize(w);
+    }
+    return 0;
+}
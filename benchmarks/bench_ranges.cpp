@@ -0,0 +1,151 @@
+// bench_ranges.cpp
+// 惰性范围视图（type/ranges.h）对比等价的手写循环：
+//   filter | transform 求和、transform | take、drop | stride、enumerate、
+//   zip 点积、chunk 分组求和、join 展平
+// 视图的迭代器内联后应与手写循环耗时相当（比值接近 1.00）。
+// 元素个数可由命令行指定：bench_ranges [n]
+
+#include "bench_common.h"
+#include "../src/type/ranges.h"
+#include <cstdlib>
+#include <vector>
+
+using namespace zen::bench;
+namespace rg = zen::ranges;
+
+static const int reps = 10;
+
+// 分别运行手写版本与视图版本各 reps 次，打印两者耗时与比值
+template<typename Loop, typename View>
+static void compare(const char* name, size_t n, Loop loop, View view) {
+    uint64_t a = 0, b = 0;
+    timer t1;
+    for (int r = 0; r < reps; ++r) { a += loop(); do_not_optimize(a); }
+    double loop_ms = t1.elapsed_ms();
+    timer t2;
+    for (int r = 0; r < reps; ++r) { b += view(); do_not_optimize(b); }
+    double view_ms = t2.elapsed_ms();
+    if (a != b) printf("  MISMATCH in %s: %llu vs %llu\n", name,
+                       static_cast<unsigned long long>(a), static_cast<unsigned long long>(b));
+
+    printf("%s\n", name);
+    report("hand-written loop", loop_ms, n * reps);
+    report("ranges view", view_ms, n * reps);
+    printf("  %-40s %10.2fx\n\n", "view / loop", view_ms / loop_ms);
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(strtoull(argv[1], nullptr, 10)) : 10000000;
+
+    rng g(5);
+    std::vector<uint32_t> xs(n), ys(n);
+    for (size_t i = 0; i < n; ++i) {
+        xs[i] = static_cast<uint32_t>(g.next());
+        ys[i] = static_cast<uint32_t>(g.next());
+    }
+
+    compare("filter | transform | sum", n,
+        [&] {
+            uint64_t s = 0;
+            for (size_t i = 0; i < n; ++i)
+                if (xs[i] & 1) s += static_cast<uint64_t>(xs[i]) * 3;
+            return s;
+        },
+        [&] {
+            uint64_t s = 0;
+            for (uint64_t x : xs | rg::filter([](uint32_t x) { return (x & 1) != 0; })
+                                 | rg::transform([](uint32_t x) { return static_cast<uint64_t>(x) * 3; }))
+                s += x;
+            return s;
+        });
+
+    compare("transform | take(n/2)", n / 2,
+        [&] {
+            uint64_t s = 0;
+            for (size_t i = 0; i < n / 2; ++i) s += xs[i] >> 3;
+            return s;
+        },
+        [&] {
+            uint64_t s = 0;
+            for (uint32_t x : xs | rg::transform([](uint32_t x) { return x >> 3; })
+                                 | rg::take(static_cast<std::ptrdiff_t>(n / 2)))
+                s += x;
+            return s;
+        });
+
+    compare("drop(7) | stride(3)", n / 3,
+        [&] {
+            uint64_t s = 0;
+            for (size_t i = 7; i < n; i += 3) s += xs[i];
+            return s;
+        },
+        [&] {
+            uint64_t s = 0;
+            for (uint32_t x : xs | rg::drop(7) | rg::stride(3)) s += x;
+            return s;
+        });
+
+    compare("enumerate (index-weighted sum)", n,
+        [&] {
+            uint64_t s = 0;
+            for (size_t i = 0; i < n; ++i) s += (xs[i] & 0xff) * i;
+            return s;
+        },
+        [&] {
+            uint64_t s = 0;
+            for (auto [i, x] : xs | rg::enumerate) s += (x & 0xff) * i;
+            return s;
+        });
+
+    compare("zip dot product", n,
+        [&] {
+            uint64_t s = 0;
+            for (size_t i = 0; i < n; ++i) s += static_cast<uint64_t>(xs[i] >> 16) * (ys[i] >> 16);
+            return s;
+        },
+        [&] {
+            uint64_t s = 0;
+            for (auto [x, y] : rg::zip(xs, ys)) s += static_cast<uint64_t>(x >> 16) * (y >> 16);
+            return s;
+        });
+
+    compare("chunk(64) max per chunk", n,
+        [&] {
+            uint64_t s = 0;
+            for (size_t b = 0; b < n; b += 64) {
+                size_t e = b + 64 < n ? b + 64 : n;
+                uint32_t m = 0;
+                for (size_t i = b; i < e; ++i) m = xs[i] > m ? xs[i] : m;
+                s += m;
+            }
+            return s;
+        },
+        [&] {
+            uint64_t s = 0;
+            for (auto c : xs | rg::chunk(64)) {
+                uint32_t m = 0;
+                for (uint32_t x : c) m = x > m ? x : m;
+                s += m;
+            }
+            return s;
+        });
+
+    std::vector<std::vector<uint32_t>> nested(n / 100);
+    for (size_t i = 0; i < nested.size(); ++i) nested[i].assign(xs.begin() + i * 100, xs.begin() + i * 100 + (i % 200));
+    size_t nested_total = 0;
+    for (const auto& v : nested) nested_total += v.size();
+    compare("join (vector<vector>)", nested_total,
+        [&] {
+            uint64_t s = 0;
+            for (const auto& v : nested)
+                for (uint32_t x : v) s += x;
+            return s;
+        },
+        [&] {
+            uint64_t s = 0;
+            for (uint32_t x : nested | rg::join) s += x;
+            return s;
+        });
+
+    return 0;
+}
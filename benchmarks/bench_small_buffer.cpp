@@ -0,0 +1,84 @@
+// bench_small_buffer.cpp
+// 短生命周期的小容器：分配次数与耗时
+//   - zen::vector（首次 push 即分配，之后 2 倍扩容）对比 zen::small_vector<T, 8>
+//   - std::string（libstdc++ 内联 15 字符）对比 zen::string（内联 22 字符）
+
+#include "bench_common.h"
+#include "../src/containers/sequential/vector.h"
+#include "../src/containers/sequential/small_vector.h"
+#include "../src/containers/sequential/string.h"
+#include <cstdlib>
+#include <new>
+#include <string>
+
+using namespace zen::bench;
+
+// 统计全局 operator new 调用次数
+static size_t g_allocs = 0;
+
+void* operator new(size_t n) {
+    ++g_allocs;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+static void report_allocs(const char* name, double ms, size_t ops, size_t allocs) {
+    report(name, ms, ops);
+    printf("  %-40s %10.3f allocs/op\n", "", static_cast<double>(allocs) / static_cast<double>(ops));
+}
+
+// 模拟"请求头列表"：每次构造 1 ~ 8 个元素的临时序列，遍历后丢弃
+template<typename Vec>
+static void run_vector(const char* name, size_t iters) {
+    rng g(42);
+    uint64_t sum = 0;
+    size_t before = g_allocs;
+    timer t;
+    for (size_t i = 0; i < iters; ++i) {
+        Vec v;
+        size_t n = 1 + g.next() % 8;
+        for (size_t k = 0; k < n; ++k) v.push_back(k * i);
+        for (auto x : v) sum += x;
+        do_not_optimize(v);
+    }
+    double ms = t.elapsed_ms();
+    do_not_optimize(sum);
+    report_allocs(name, ms, iters, g_allocs - before);
+}
+
+// 模拟路由参数 / 标签：长度 4 ~ 22 的短字符串拷贝、拼接
+template<typename Str>
+static void run_string(const char* name, size_t iters) {
+    static const char text[] = "abcdefghijklmnopqrstuvwxyz";
+    rng g(7);
+    size_t total = 0;
+    size_t before = g_allocs;
+    timer t;
+    for (size_t i = 0; i < iters; ++i) {
+        size_t n = 4 + g.next() % 19;
+        Str a(text, n / 2);
+        Str b(text + 3, n - n / 2);
+        Str c = a;
+        c += b;
+        total += c.size();
+        do_not_optimize(c);
+    }
+    double ms = t.elapsed_ms();
+    do_not_optimize(total);
+    report_allocs(name, ms, iters, g_allocs - before);
+}
+
+int main() {
+    const size_t ITERS = 2000000;
+
+    printf("short-lived vectors of 1..8 elements (iters = %zu)\n", ITERS);
+    run_vector<zen::vector<uint64_t>>("zen::vector<uint64_t>", ITERS);
+    run_vector<zen::small_vector<uint64_t, 8>>("zen::small_vector<uint64_t, 8>", ITERS);
+
+    printf("short strings of 4..22 chars (iters = %zu)\n", ITERS);
+    run_string<std::string>("std::string", ITERS);
+    run_string<zen::string>("zen::string", ITERS);
+    return 0;
+}
@@ -0,0 +1,117 @@
+// bench_sort.cpp
+// zen::sort（pdqsort）对比 std::sort 在各种输入分布下的耗时：
+//   random / sorted / reversed / organ-pipe / few-unique
+// 分别测 uint64_t（走无分支分块分区）和按键比较的记录类型（分支版分区）；
+// 另测 radix_sort（复用辅助缓冲区）对比 std::sort：32/64 位整数、double、字符串
+// 元素个数可由命令行指定：bench_sort [n]
+
+#include "bench_common.h"
+#include "../src/algorithms/sort.h"
+#include "../src/algorithms/radix_sort.h"
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace zen::bench;
+
+struct record {
+    uint64_t key;
+    uint64_t payload[3];
+};
+
+enum class distribution { random, sorted, reversed, organ_pipe, few_unique };
+
+static const char* distribution_name(distribution d) {
+    switch (d) {
+    case distribution::random:     return "random";
+    case distribution::sorted:     return "sorted";
+    case distribution::reversed:   return "reversed";
+    case distribution::organ_pipe: return "organ-pipe";
+    case distribution::few_unique: return "few-unique";
+    }
+    return "";
+}
+
+static std::vector<uint64_t> make_keys(distribution d, size_t n) {
+    rng g(7);
+    std::vector<uint64_t> v(n);
+    for (size_t i = 0; i < n; ++i) {
+        switch (d) {
+        case distribution::random:     v[i] = g.next(); break;
+        case distribution::sorted:     v[i] = i; break;
+        case distribution::reversed:   v[i] = n - i; break;
+        case distribution::organ_pipe: v[i] = i < n / 2 ? i : n - i; break;
+        case distribution::few_unique: v[i] = g.next() % 16; break;
+        }
+    }
+    return v;
+}
+
+template<typename T, typename Sort>
+static void run(const char* impl, distribution d, const std::vector<T>& input, Sort sort_fn) {
+    std::vector<T> v = input;
+    timer t;
+    sort_fn(v);
+    double ms = t.elapsed_ms();
+    do_not_optimize(v.front());
+
+    char name[64];
+    snprintf(name, sizeof(name), "%-10s %s", distribution_name(d), impl);
+    report(name, ms, v.size());
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(strtoull(argv[1], nullptr, 10)) : 10000000;
+    const distribution all[] = { distribution::random, distribution::sorted, distribution::reversed,
+                                 distribution::organ_pipe, distribution::few_unique };
+
+    printf("uint64_t keys (n = %zu)\n", n);
+    for (distribution d : all) {
+        std::vector<uint64_t> keys = make_keys(d, n);
+        run("std::sort", d, keys, [](std::vector<uint64_t>& v) { std::sort(v.begin(), v.end()); });
+        run("zen::sort", d, keys, [](std::vector<uint64_t>& v) { zen::sort(v.begin(), v.end()); });
+    }
+
+    printf("\n32-byte records by key (n = %zu)\n", n);
+    auto by_key = [](const record& a, const record& b) { return a.key < b.key; };
+    for (distribution d : all) {
+        std::vector<uint64_t> keys = make_keys(d, n);
+        std::vector<record> recs(n);
+        for (size_t i = 0; i < n; ++i) recs[i] = record{ keys[i], { i, i, i } };
+        run("std::sort", d, recs, [&](std::vector<record>& v) { std::sort(v.begin(), v.end(), by_key); });
+        run("zen::sort", d, recs, [&](std::vector<record>& v) { zen::sort(v.begin(), v.end(), by_key); });
+    }
+    printf("\nradix_sort with caller scratch, random keys (n = %zu)\n", n);
+    {
+        rng g(11);
+        std::vector<uint32_t> u32(n);
+        std::vector<uint64_t> u64(n);
+        std::vector<double> f64(n);
+        for (size_t i = 0; i < n; ++i) {
+            u64[i] = g.next();
+            u32[i] = static_cast<uint32_t>(u64[i] >> 32);
+            f64[i] = static_cast<double>(static_cast<int64_t>(g.next())) * 1e-9;
+        }
+        std::vector<uint32_t> s32(n);
+        std::vector<uint64_t> s64(n);
+        std::vector<double> sf(n);
+        run("std::sort  uint32", distribution::random, u32, [](std::vector<uint32_t>& v) { std::sort(v.begin(), v.end()); });
+        run("radix_sort uint32", distribution::random, u32, [&](std::vector<uint32_t>& v) { zen::radix_sort(v.begin(), v.end(), s32.data()); });
+        run("std::sort  uint64", distribution::random, u64, [](std::vector<uint64_t>& v) { std::sort(v.begin(), v.end()); });
+        run("radix_sort uint64", distribution::random, u64, [&](std::vector<uint64_t>& v) { zen::radix_sort(v.begin(), v.end(), s64.data()); });
+        run("std::sort  double", distribution::random, f64, [](std::vector<double>& v) { std::sort(v.begin(), v.end()); });
+        run("radix_sort double", distribution::random, f64, [&](std::vector<double>& v) { zen::radix_sort(v.begin(), v.end(), sf.data()); });
+
+        size_t ns = n / 10;
+        std::vector<std::string> words(ns);
+        for (size_t i = 0; i < ns; ++i) {
+            uint64_t r = g.next();
+            size_t len = 4 + r % 16;
+            for (size_t k = 0; k < len; ++k) words[i].push_back(static_cast<char>('a' + (g.next() % 26)));
+        }
+        run("std::sort  string", distribution::random, words, [](std::vector<std::string>& v) { std::sort(v.begin(), v.end()); });
+        run("radix_sort string", distribution::random, words, [](std::vector<std::string>& v) { zen::radix_sort(v.begin(), v.end()); });
+    }
+    return 0;
+}
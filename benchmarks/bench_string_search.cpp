@@ -0,0 +1,164 @@
+// bench_string_search.cpp
+// 大块日志文本上的扫描吞吐（GB/s）：
+//   子串搜索：通用 / SSE2 / AVX2 首尾字节过滤，对比 std::string_view::find、
+//            KMP、Boyer-Moore（统计全部匹配）
+//   多分隔符：find_first_of(byte_set) 各级实现对比 std::string_view::find_first_of
+//   单字节计数：count_char 各级实现对比 std::count
+//   切分：tokenize（string_view，零拷贝）对比 split（复制为 std::string）
+// 文本大小（MB）可由命令行指定：bench_string_search [mb]
+
+#include "bench_common.h"
+#include "../src/algorithms/string.h"
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace zen::bench;
+
+static const int reps = 5;
+
+// 运行 fn reps 次，按总字节数报告 GB/s
+template<typename Fn>
+static void throughput(const char* name, size_t bytes, Fn fn) {
+    size_t sink = 0;
+    timer t;
+    for (int r = 0; r < reps; ++r) {
+        sink += fn();
+        do_not_optimize(sink);
+    }
+    double ms = t.elapsed_ms();
+    double gbps = static_cast<double>(bytes) * reps / (ms * 1e6);
+    printf("  %-40s %10.2f ms  %7.2f GB/s  (result %zu)\n", name, ms / reps, gbps, sink / reps);
+}
+
+// 统计 pattern 的全部匹配，使用某一级子串搜索实现
+static size_t count_matches(zen::detail::find_substring_fn fn, std::string_view text, std::string_view pat) {
+    size_t count = 0, pos = 0;
+    while (pos <= text.size()) {
+        size_t r = fn(text.data() + pos, text.size() - pos, pat.data(), pat.size());
+        if (r == zen::detail::scan_npos) break;
+        ++count;
+        pos += r + 1;
+    }
+    return count;
+}
+
+// 模拟日志：时间戳、级别、路径、耗时，偶尔出现要搜索的错误串
+static std::string make_log(size_t bytes) {
+    static const char* levels[] = { "INFO", "DEBUG", "WARN", "INFO", "TRACE" };
+    static const char* paths[] = { "/api/v1/users", "/static/app.js", "/api/v2/orders", "/healthz" };
+    rng g(3);
+    std::string s;
+    s.reserve(bytes + 256);
+    char line[256];
+    while (s.size() < bytes) {
+        uint64_t x = g.next();
+        int len;
+        if (x % 5000 == 0) {
+            len = snprintf(line, sizeof(line), "ts=%llu level=ERROR msg=\"connection reset by peer\" path=%s\n",
+                           static_cast<unsigned long long>(x >> 24), paths[x % 4]);
+        } else {
+            len = snprintf(line, sizeof(line), "ts=%llu level=%s path=%s latency_us=%llu status=200\n",
+                           static_cast<unsigned long long>(x >> 24), levels[x % 5], paths[(x >> 8) % 4],
+                           static_cast<unsigned long long>((x >> 32) % 100000));
+        }
+        s.append(line, static_cast<size_t>(len));
+    }
+    return s;
+}
+
+int main(int argc, char** argv) {
+    size_t mb = argc > 1 ? static_cast<size_t>(strtoull(argv[1], nullptr, 10)) : 256;
+    std::string log = make_log(mb << 20);
+    std::string_view text = log;
+    size_t n = log.size();
+    const zen::cpu_feature_set& cpu = zen::cpu_features();
+    const bool avx2 = zen::cpu_supports_avx2_target();
+    printf("text = %zu MB, sse2 = %d, avx2 = %d\n\n", n >> 20, cpu.sse2, avx2 ? 1 : 0);
+
+    for (std::string_view pat : { std::string_view("connection reset"), std::string_view("ERROR"),
+                                  std::string_view("latency_us=99999") }) {
+        printf("substring \"%.*s\" (all matches)\n", static_cast<int>(pat.size()), pat.data());
+        throughput("std::string_view::find", n, [&] {
+            size_t c = 0;
+            for (size_t p = text.find(pat); p != std::string_view::npos; p = text.find(pat, p + 1)) ++c;
+            return c;
+        });
+        throughput("kmp_search", n, [&] { return zen::kmp_search(log, std::string(pat)).size(); });
+        throughput("boyer_moore_search", n, [&] { return zen::boyer_moore_search(log, std::string(pat)).size(); });
+        throughput("generic (memchr + memcmp)", n, [&] {
+            return count_matches(zen::detail::find_substring_generic, text, pat);
+        });
+#if ZEN_HAVE_SSE2
+        throughput("sse2 first/last filter", n, [&] {
+            return count_matches(zen::detail::find_substring_sse2, text, pat);
+        });
+#endif
+#if ZEN_HAVE_AVX2_TARGET
+        if (avx2) {
+            throughput("avx2 first/last filter", n, [&] {
+                return count_matches(zen::detail::find_substring_avx2, text, pat);
+            });
+        }
+#endif
+        throughput("find_all_substrings (dispatched)", n, [&] { return zen::find_all_substrings(text, pat).size(); });
+        printf("\n");
+    }
+
+    // 多分隔符：稠密集合（约每 7 字节命中一次，主要测单次调用开销）与
+    // 稀疏集合（约每行命中一次，主要测向量主循环）
+    for (const char* delims : { " =\"\n", "\"\n" }) {
+        zen::byte_set set(delims);
+        auto count_first_of = [&](zen::detail::find_first_of_fn fn) {
+            size_t c = 0, pos = 0;
+            while (pos < n) {
+                size_t r = fn(text.data() + pos, n - pos, set);
+                if (r == zen::detail::scan_npos) break;
+                ++c;
+                pos += r + 1;
+            }
+            return c;
+        };
+        printf("find_first_of (%zu delimiters, all occurrences)\n", set.size());
+        throughput("std::string_view::find_first_of", n, [&] {
+            size_t c = 0;
+            for (size_t p = text.find_first_of(delims); p != std::string_view::npos;
+                 p = text.find_first_of(delims, p + 1)) ++c;
+            return c;
+        });
+        throughput("generic (bitmap)", n, [&] { return count_first_of(zen::detail::find_first_of_generic); });
+#if ZEN_HAVE_SSE2
+        throughput("sse2 compare-or", n, [&] { return count_first_of(zen::detail::find_first_of_sse2); });
+#endif
+#if ZEN_HAVE_AVX2_TARGET
+        if (avx2) throughput("avx2 nibble shuffle", n, [&] { return count_first_of(zen::detail::find_first_of_avx2); });
+#endif
+        printf("\n");
+    }
+
+    printf("count '\\n'\n");
+    throughput("std::count", n, [&] { return static_cast<size_t>(std::count(log.begin(), log.end(), '\n')); });
+    throughput("generic", n, [&] { return zen::detail::count_char_generic(log.data(), n, '\n'); });
+#if ZEN_HAVE_SSE2
+    throughput("sse2", n, [&] { return zen::detail::count_char_sse2(log.data(), n, '\n'); });
+#endif
+#if ZEN_HAVE_AVX2_TARGET
+    if (avx2) throughput("avx2", n, [&] { return zen::detail::count_char_avx2(log.data(), n, '\n'); });
+#endif
+    printf("\n");
+
+    printf("split into fields (space / newline)\n");
+    throughput("split (std::string copies, per line)", n, [&] {
+        size_t c = 0;
+        for (const std::string& l : zen::split(log, '\n')) c += zen::split(l, ' ').size();
+        return c;
+    });
+    throughput("tokenize (string_view, zero-copy)", n, [&] {
+        size_t c = 0;
+        for (std::string_view field : zen::tokenize(text, " \n")) c += !field.empty();
+        return c;
+    });
+    return 0;
+}
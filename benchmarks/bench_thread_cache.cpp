@@ -0,0 +1,131 @@
+// bench_thread_cache.cpp
+// 多线程分配 / 释放：zen::tc_malloc（线程缓存分配器）对比系统 malloc
+//   - local：每个线程在自己的工作集内随机大小分配、释放
+//   - cross：生产者分配、消费者释放（对象跨线程经由中心转移表回流）
+
+#include "bench_common.h"
+#include "../src/memory/thread_cache.h"
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace zen::bench;
+
+struct malloc_backend {
+    static void* alloc(size_t n) { return std::malloc(n); }
+    static void  free(void* p, size_t) { std::free(p); }
+};
+
+struct tc_backend {
+    static void* alloc(size_t n) { return zen::tc_malloc(n); }
+    static void  free(void* p, size_t n) { zen::tc_free_sized(p, n); }
+};
+
+static const size_t OPS_PER_THREAD = 2000000;
+static const size_t WORKING_SET    = 1024;
+
+template<typename B>
+static void local_worker(uint64_t seed) {
+    rng g(seed);
+    void*  slot[WORKING_SET] = {};
+    size_t size[WORKING_SET] = {};
+    for (size_t i = 0; i < OPS_PER_THREAD; ++i) {
+        uint64_t r = g.next();
+        size_t k = r % WORKING_SET;
+        if (slot[k]) B::free(slot[k], size[k]);
+        size[k] = 8 + (r >> 32) % 512;       // 8 ~ 519 字节，偏向小对象
+        slot[k] = B::alloc(size[k]);
+        static_cast<char*>(slot[k])[0] = 1;
+    }
+    for (size_t k = 0; k < WORKING_SET; ++k) {
+        if (slot[k]) B::free(slot[k], size[k]);
+    }
+}
+
+template<typename B>
+static double run_local(unsigned threads) {
+    timer t;
+    std::vector<std::thread> ts;
+    for (unsigned i = 0; i < threads; ++i) ts.emplace_back(local_worker<B>, 0x1000 + i);
+    for (auto& th : ts) th.join();
+    return t.elapsed_ms();
+}
+
+// 单生产者单消费者环形队列
+struct spsc_ring {
+    static const size_t CAP = 4096;
+    void* buf[CAP];
+    std::atomic<size_t> head{0}, tail{0};
+
+    void push(void* p) {
+        size_t h = head.load(std::memory_order_relaxed);
+        while (h - tail.load(std::memory_order_acquire) == CAP) std::this_thread::yield();
+        buf[h % CAP] = p;
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    void* pop() {
+        size_t t = tail.load(std::memory_order_relaxed);
+        while (head.load(std::memory_order_acquire) == t) std::this_thread::yield();
+        void* p = buf[t % CAP];
+        tail.store(t + 1, std::memory_order_release);
+        return p;
+    }
+};
+
+static const size_t CROSS_SIZE = 64;
+
+template<typename B>
+static double run_cross(unsigned pairs) {
+    std::vector<spsc_ring> rings(pairs);
+    timer t;
+    std::vector<std::thread> ts;
+    for (unsigned i = 0; i < pairs; ++i) {
+        spsc_ring* q = &rings[i];
+        ts.emplace_back([q] {
+            for (size_t n = 0; n < OPS_PER_THREAD; ++n) q->push(B::alloc(CROSS_SIZE));
+        });
+        ts.emplace_back([q] {
+            for (size_t n = 0; n < OPS_PER_THREAD; ++n) B::free(q->pop(), CROSS_SIZE);
+        });
+    }
+    for (auto& th : ts) th.join();
+    return t.elapsed_ms();
+}
+
+int main() {
+    unsigned hw = std::thread::hardware_concurrency();
+    if (hw == 0) hw = 4;
+
+    printf("local alloc/free (ops/thread = %zu, working set = %zu)\n", OPS_PER_THREAD, WORKING_SET);
+    for (unsigned th = 1; th <= hw; th *= 2) {
+        char name[64];
+        size_t ops = OPS_PER_THREAD * th;
+        snprintf(name, sizeof(name), "malloc        threads=%u", th);
+        report(name, run_local<malloc_backend>(th), ops);
+        snprintf(name, sizeof(name), "zen::tc_malloc threads=%u", th);
+        report(name, run_local<tc_backend>(th), ops);
+    }
+
+    printf("cross-thread free (producer -> consumer, %zu-byte objects)\n", CROSS_SIZE);
+    unsigned max_pairs = hw / 2 ? hw / 2 : 1;
+    for (unsigned pairs = 1; pairs <= max_pairs; pairs *= 2) {
+        char name[64];
+        size_t ops = OPS_PER_THREAD * pairs;
+        snprintf(name, sizeof(name), "malloc        pairs=%u", pairs);
+        report(name, run_cross<malloc_backend>(pairs), ops);
+        snprintf(name, sizeof(name), "zen::tc_malloc pairs=%u", pairs);
+        report(name, run_cross<tc_backend>(pairs), ops);
+    }
+
+    zen::tc_flush_thread_stats();
+    zen::tc_stats s = zen::tc_get_stats();
+    printf("tc stats: bytes in use = %lld, span bytes = %llu\n",
+           static_cast<long long>(s.bytes_in_use), static_cast<unsigned long long>(s.span_bytes));
+    for (size_t i = 0; i < zen::TC_NUM_CLASSES; ++i) {
+        if (s.classes[i].hits + s.classes[i].misses == 0) continue;
+        printf("  class %6zu: hit rate %.4f\n", s.classes[i].size, s.classes[i].hit_rate());
+    }
+    return 0;
+}
@@ -0,0 +1,293 @@
+// bench_thread_pool.cpp
+// 线程池调度开销：原实现（单个 queue + mutex + condition_variable，
+// submit 经 std::bind + packaged_task + shared_ptr + function 多次分配）
+// 对比工作窃取的 zen::thread_pool
+//   spawn      : 池外提交 N 个空任务并等待全部完成
+//   futures    : 池外提交 N 个带返回值的任务，逐个 get
+//   parallel sum: 数组按 4096 个元素切块（每块约 1 µs），每块一个任务
+//   fib (flat) : fib(n) 在深度 d 处展开成 2^d 个任务，由调用线程提交并等待
+//   fib (fork/join): 递归派生、wait_until 等待（原实现中工作线程阻塞等待子任务会死锁，只测新实现）
+//   priority   : 积压大量 normal 任务时穿插提交 high 任务，比较两条通道的排队延迟（metrics()）
+// 线程数可由命令行指定：bench_thread_pool [threads...]
+
+#include "bench_common.h"
+#include "../src/threading/pool/thread_pool.h"
+#include "../src/utility/function.h"
+#include "../src/containers/adapter/queue.h"
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace zen::bench;
+
+// ============================================================================
+// 原实现（原样保留，仅改名）
+// ============================================================================
+
+class legacy_thread_pool {
+public:
+    explicit legacy_thread_pool(size_t num_threads) : stop_(false) {
+        workers_.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i) {
+            workers_.emplace_back([this] { worker_thread(); });
+        }
+    }
+
+    ~legacy_thread_pool() {
+        {
+            zen::lock_guard<zen::mutex> lock(queue_mutex_);
+            stop_ = true;
+        }
+        condition_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    template<typename F, typename... Args>
+    auto submit(F&& f, Args&&... args) -> zen::future<typename std::invoke_result<F, Args...>::type> {
+        using result_type = typename std::invoke_result<F, Args...>::type;
+        auto task = std::make_shared<zen::packaged_task<result_type()>>(
+            std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+        zen::future<result_type> result = task->get_future();
+        {
+            zen::lock_guard<zen::mutex> lock(queue_mutex_);
+            tasks_.emplace([task]() { (*task)(); });
+        }
+        condition_.notify_one();
+        return result;
+    }
+
+    template<typename F, typename... Args>
+    void submit_void(F&& f, Args&&... args) {
+        {
+            zen::lock_guard<zen::mutex> lock(queue_mutex_);
+            tasks_.emplace([f, args...]() mutable { f(args...); });
+        }
+        condition_.notify_one();
+    }
+
+private:
+    void worker_thread() {
+        while (true) {
+            zen::function<void()> task;
+            {
+                zen::unique_lock<zen::mutex> lock(queue_mutex_);
+                condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                if (stop_ && tasks_.empty()) return;
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+
+    zen::vector<zen::thread> workers_;
+    zen::queue<zen::function<void()>> tasks_;
+    zen::mutex queue_mutex_;
+    zen::condition_variable condition_;
+    bool stop_;
+};
+
+// ============================================================================
+// 工作负载
+// ============================================================================
+
+static void line(const char* name, size_t threads, double legacy_ms, double ws_ms) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s, %zu workers", name, threads);
+    if (legacy_ms < 0) {
+        printf("  %-40s %12s  %10.2f ms\n", label, "-", ws_ms);
+    } else {
+        printf("  %-40s %9.2f ms  %10.2f ms  %6.2fx\n", label, legacy_ms, ws_ms, legacy_ms / ws_ms);
+    }
+}
+
+// 等待计数器归零：原实现没有 wait()，调用线程只能自旋
+static void spin_until_zero(const std::atomic<long>& remaining) {
+    while (remaining.load(std::memory_order_acquire) != 0) zen::this_thread::yield();
+}
+
+template<typename Pool>
+static double spawn_empty(Pool& pool, long n) {
+    std::atomic<long> remaining{n};
+    timer t;
+    for (long i = 0; i < n; ++i) {
+        pool.submit_void([&remaining] { remaining.fetch_sub(1, std::memory_order_release); });
+    }
+    spin_until_zero(remaining);
+    return t.elapsed_ms();
+}
+
+template<typename Pool>
+static double futures(Pool& pool, int n) {
+    timer t;
+    std::vector<zen::future<int>> fs;
+    fs.reserve(n);
+    for (int i = 0; i < n; ++i) fs.push_back(pool.submit([i] { return i; }));
+    long long sum = 0;
+    for (auto& f : fs) sum += f.get();
+    do_not_optimize(sum);
+    return t.elapsed_ms();
+}
+
+template<typename Pool>
+static double parallel_sum(Pool& pool, const std::vector<uint32_t>& data) {
+    const size_t chunk = 4096;
+    size_t chunks = (data.size() + chunk - 1) / chunk;
+    std::vector<uint64_t> partial(chunks);
+    std::atomic<long> remaining{static_cast<long>(chunks)};
+    timer t;
+    for (size_t c = 0; c < chunks; ++c) {
+        pool.submit_void([&, c] {
+            size_t b = c * chunk, e = b + chunk < data.size() ? b + chunk : data.size();
+            uint64_t s = 0;
+            for (size_t i = b; i < e; ++i) s += data[i];
+            partial[c] = s;
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    spin_until_zero(remaining);
+    uint64_t total = 0;
+    for (uint64_t s : partial) total += s;
+    do_not_optimize(total);
+    return t.elapsed_ms();
+}
+
+static long fib_serial(int n) { return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2); }
+
+// 在深度 depth 处展开：叶子子问题作为任务提交
+static void collect_leaves(int n, int depth, std::vector<int>& leaves) {
+    if (depth == 0 || n < 2) {
+        leaves.push_back(n);
+        return;
+    }
+    collect_leaves(n - 1, depth - 1, leaves);
+    collect_leaves(n - 2, depth - 1, leaves);
+}
+
+template<typename Pool>
+static double fib_flat(Pool& pool, int n, int depth) {
+    std::vector<int> leaves;
+    collect_leaves(n, depth, leaves);
+    std::vector<long> out(leaves.size());
+    std::atomic<long> remaining{static_cast<long>(leaves.size())};
+    timer t;
+    for (size_t i = 0; i < leaves.size(); ++i) {
+        pool.submit_void([&, i] {
+            out[i] = fib_serial(leaves[i]);
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    spin_until_zero(remaining);
+    long sum = 0;
+    for (long v : out) sum += v;
+    do_not_optimize(sum);
+    return t.elapsed_ms();
+}
+
+static long fib_fork_join(zen::thread_pool& pool, int n, int cutoff) {
+    if (n < cutoff) return fib_serial(n);
+    std::atomic<bool> done{false};
+    long a = 0;
+    pool.submit_void([&] {
+        a = fib_fork_join(pool, n - 1, cutoff);
+        done.store(true, std::memory_order_release);
+    });
+    long b = fib_fork_join(pool, n - 2, cutoff);
+    pool.wait_until([&] { return done.load(std::memory_order_acquire); });
+    return a + b;
+}
+
+static void spin_work(int iters) {
+    volatile long x = 0;
+    for (int i = 0; i < iters; ++i) x = x + i;
+}
+
+// 每 1000 个 normal 任务插入一个 high 任务，报告两条通道的排队延迟
+static void priority_latency(size_t threads) {
+    zen::thread_pool_options opts;
+    opts.threads = threads;
+    opts.track_latency = true;
+    zen::thread_pool pool(opts);
+    for (int i = 0; i < 100000; ++i) {
+        pool.submit_void([] { spin_work(200); });
+        if (i % 1000 == 999) pool.submit_void(zen::task_priority::high, [] { spin_work(200); });
+    }
+    pool.wait();
+    zen::thread_pool_metrics m = pool.metrics();
+    const zen::task_latency& hi = m.latency[static_cast<size_t>(zen::task_priority::high)];
+    const zen::task_latency& lo = m.latency[static_cast<size_t>(zen::task_priority::normal)];
+    printf("  %-40s high p50 %8.1f us  p99 %8.1f us | normal p50 %8.1f us  p99 %8.1f us\n",
+           ("queue latency, " + std::to_string(threads) + " workers").c_str(),
+           hi.p50_ns / 1e3, hi.p99_ns / 1e3, lo.p50_ns / 1e3, lo.p99_ns / 1e3);
+}
+
+int main(int argc, char** argv) {
+    std::vector<size_t> thread_counts;
+    for (int i = 1; i < argc; ++i) thread_counts.push_back(static_cast<size_t>(strtoul(argv[i], nullptr, 10)));
+    if (thread_counts.empty()) thread_counts = { 1, 2, 4, 8, 16, 32 };
+
+    printf("hardware_concurrency = %u\n", zen::thread::hardware_concurrency());
+    printf("  %-40s %12s  %13s  %7s\n", "", "legacy", "work-stealing", "speedup");
+
+    rng g(21);
+    std::vector<uint32_t> data(1 << 24);
+    for (auto& x : data) x = static_cast<uint32_t>(g.next());
+
+    for (size_t t : thread_counts) {
+        double legacy, ws;
+        {
+            legacy_thread_pool lp(t);
+            legacy = spawn_empty(lp, 1000000);
+        }
+        {
+            zen::thread_pool wp(t);
+            ws = spawn_empty(wp, 1000000);
+        }
+        line("spawn 1M empty tasks", t, legacy, ws);
+
+        {
+            legacy_thread_pool lp(t);
+            legacy = futures(lp, 200000);
+        }
+        {
+            zen::thread_pool wp(t);
+            ws = futures(wp, 200000);
+        }
+        line("200k submit + future::get", t, legacy, ws);
+
+        {
+            legacy_thread_pool lp(t);
+            legacy = parallel_sum(lp, data);
+        }
+        {
+            zen::thread_pool wp(t);
+            ws = parallel_sum(wp, data);
+        }
+        line("parallel sum, 4096 chunks", t, legacy, ws);
+
+        {
+            legacy_thread_pool lp(t);
+            legacy = fib_flat(lp, 32, 16);
+        }
+        {
+            zen::thread_pool wp(t);
+            ws = fib_flat(wp, 32, 16);
+        }
+        line("fib(32) flat, 2^16 leaves", t, legacy, ws);
+
+        {
+            zen::thread_pool wp(t);
+            timer tm;
+            long r = fib_fork_join(wp, 32, 16);
+            ws = tm.elapsed_ms();
+            do_not_optimize(r);
+        }
+        line("fib(32) fork/join, cutoff 16", t, -1, ws);
+        priority_latency(t);
+        printf("\n");
+    }
+    return 0;
+}
@@ -2,21 +2,32 @@
 #define ZEN_ALGORITHMS_H
 
 #include "../../src/algorithms/sort.h"
+#include "../../src/algorithms/radix_sort.h"
 #include "../../src/algorithms/find.h"
 #include "../../src/algorithms/numeric.h"
+#include "../../src/algorithms/numeric_simd.h"
 #include "../../src/algorithms/transform.h"
 #include "../../src/algorithms/graph.h"
+#include "../../src/algorithms/csr_graph.h"
 #include "../../src/algorithms/string.h"
+#include "../../src/algorithms/aho_corasick.h"
+#include "../../src/algorithms/execution.h"
+#include "../../src/algorithms/parallel.h"
 
 namespace zen {
 
 // 算法模块：
-// - sort: 排序算法（快速排序、归并排序、堆排序、插入排序）
+// - sort: 排序算法（pdqsort、归并排序、堆排序、插入排序）
+// - radix_sort: 基数排序（整数 / 浮点 LSD，字符串 MSD）
 // - find: 查找算法（二分查找、线性查找）
-// - numeric: 数值算法（累积、差值、内积）
+// - numeric: 数值算法（累积、差值、内积；reduce / transform_reduce / inclusive_scan 对 float、double 走向量内核）
+// - numeric_simd: 向量化数值内核（求和 fast / kahan / pairwise、点积、min/max、前缀和、单遍均值方差）
 // - transform: 变换算法（映射、过滤、归约）
-// - graph: 图算法（BFS、DFS、Dijkstra、MST、拓扑排序）
-// - string: 字符串算法（KMP、Boyer-Moore、Rabin-Karp）
+// - graph: 图算法（BFS、DFS、Dijkstra / Prim（indexed_heap，整数权重可用 radix_heap）、拓扑排序）
+// - csr_graph: CSR 只读图（边表 / mmap 文件加载）与并行 BFS、delta-stepping、并查集连通分量
+// - string: 字符串算法（KMP、Boyer-Moore、Rabin-Karp、SIMD 子串搜索 / 多分隔符扫描、string_view 切分）
+// - aho_corasick: Aho–Corasick 多模式匹配（全部匹配 / 最左最长，支持忽略大小写与流式分块）
+// - execution / parallel: 执行策略（seq / par / par_unseq）与并行算法
 
 } // namespace zen
 
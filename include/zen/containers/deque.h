@@ -2,11 +2,14 @@
 #define ZEN_CONTAINERS_DEQUE_H
 
 #include "../../../src/containers/sequential/deque.h"
+#include "../../../src/containers/adapter/queue.h"
+#include "../../../src/containers/adapter/stack.h"
 
 namespace zen {
 
 // 顺序容器：
-// - Deque: 双端队列（支持头部和尾部的高效插入和删除）
+// - deque: 分段双端队列（两端 O(1) 插入删除，元素地址稳定）
+// - queue / stack: 以 deque 为底层的适配器
 
 } // namespace zen
 
@@ -0,0 +1,15 @@
+#ifndef ZEN_CONTAINERS_PRIORITY_QUEUE_H
+#define ZEN_CONTAINERS_PRIORITY_QUEUE_H
+
+#include "../../../src/containers/adapter/priority_queue.h"
+
+namespace zen {
+
+// 容器适配器：
+// - priority_queue: d 叉堆优先队列（默认 4 叉，接口与 std::priority_queue 一致）
+// - indexed_heap: 以整数 id 为元素、支持 decrease_key 的最小堆
+// - radix_heap: 单调整数键的基数堆
+
+} // namespace zen
+
+#endif // ZEN_CONTAINERS_PRIORITY_QUEUE_H
@@ -0,0 +1,13 @@
+#ifndef ZEN_CONTAINERS_SMALL_VECTOR_H
+#define ZEN_CONTAINERS_SMALL_VECTOR_H
+
+#include "../../../src/containers/sequential/small_vector.h"
+
+namespace zen {
+
+// 顺序容器：
+// - small_vector: 前 N 个元素内联存储、超出后溢出到堆的 vector
+
+} // namespace zen
+
+#endif // ZEN_CONTAINERS_SMALL_VECTOR_H
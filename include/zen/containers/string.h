@@ -0,0 +1,13 @@
+#ifndef ZEN_CONTAINERS_STRING_H
+#define ZEN_CONTAINERS_STRING_H
+
+#include "../../../src/containers/sequential/string.h"
+
+namespace zen {
+
+// 字符串：
+// - string: 带短字符串优化（最多 22 个字符内联）的字节字符串，与 string_view 互通
+
+} // namespace zen
+
+#endif // ZEN_CONTAINERS_STRING_H
@@ -4,6 +4,7 @@
 #include "../../../src/containers/associative/unordered_map.h"
 #include "../../../src/containers/associative/unordered_set.h"
 #include "../../../src/containers/associative/multimap.h"
+#include "../../../src/containers/associative/flat_hash_map.h"
 
 namespace zen {
 
@@ -11,6 +12,7 @@ namespace zen {
 // - UnorderedMap: 无序映射（基于哈希表）
 // - UnorderedSet: 无序集合（基于哈希表）
 // - MultiMap: 多值映射（允许键重复）
+// - flat_hash_map / flat_hash_set: 开放寻址哈希表（元素内联存储，SIMD 分组探测）
 
 } // namespace zen
 
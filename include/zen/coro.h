@@ -0,0 +1,18 @@
+#ifndef ZEN_CORO_H
+#define ZEN_CORO_H
+
+// C++20 协程（需要 ZEN_HAS_COROUTINES，否则以下头文件为空）
+
+// 协程帧分配
+#include "coro/frame_allocator.h"
+
+// 协程任务
+#include "coro/task.h"
+
+// 生成器
+#include "coro/generator.h"
+
+// future / 事件循环的可等待对象
+#include "coro/awaitables.h"
+
+#endif // ZEN_CORO_H
@@ -1,10 +1,7 @@
 #ifndef ZEN_MEMORY_H
 #define ZEN_MEMORY_H
 
-namespace zen {
+// 分配器、内存资源（arena / pool）与 arena_allocator
+#include "../../src/memory/memory.h"
 
-// Memory management declarations
-
-} // namespace zen
-
-#endif // ZEN_MEMORY_H
\ No newline at end of file
+#endif // ZEN_MEMORY_H
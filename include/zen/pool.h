@@ -7,4 +7,7 @@
 // 对象池
 #include "pool/object_pool.h"
 
+// 线程池（threading/pool/thread_pool.h 的兼容入口）
+#include "pool/thread_pool.h"
+
 #endif // ZEN_POOL_H
@@ -0,0 +1,500 @@
+#ifndef ZEN_ALGORITHMS_AHO_CORASICK_H
+#define ZEN_ALGORITHMS_AHO_CORASICK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zen {
+
+// ============================================================================
+// Aho–Corasick 多模式匹配
+// ============================================================================
+//
+// 把一组模式编译成自动机，一次扫描文本即可找出所有模式的出现位置，
+// 复杂度 O(文本长度 + 匹配数)，与模式个数无关。
+//
+// 存储布局（构造后只读，可被多个线程同时使用）：
+// - 字节先映射到等价类：出现在模式中的字节各占一类，其余字节共用类 0
+//   （类 0 总是回到根）。忽略大小写时大小写字母映射到同一类。
+//   每个状态的转移表宽度 = 类数，而不是 256。
+// - 状态按 BFS 顺序编号，浅层状态在前。前 dense_states 个状态（热状态）
+//   使用稠密行：已把失败链展开成完整的 DFA 转移，每字节一次查表。
+//   其余深层状态只保存 trie 边（按类排序的紧凑数组），未命中时沿失败链
+//   回到某个稠密状态后查表。稠密部分的大小由 dense_table_bytes 控制；
+//   模式集较小时全部状态都是稠密的。
+// - 稠密表项存目标状态的行首下标（状态号已乘以行宽），最高位标记
+//   「目标状态有输出」：没有匹配的字节只做一次加法和一次查表。
+//
+// 匹配语义：
+// - match_kind::all              : 报告所有（可重叠的）匹配
+// - match_kind::leftmost_longest : 不重叠的匹配；每次取起点最靠左的，
+//                                  起点相同取最长的（与逐个正则交替的
+//                                  POSIX 语义相同）
+// 流式：stream 对象保存自动机状态，文本可以分块喂入，跨块的匹配正常报告，
+// 偏移量是整个流中的绝对位置。
+// 空模式被忽略；重复的模式各自报告。
+// ============================================================================
+
+/**
+ * @brief 一次匹配：模式编号与在文本（流）中的位置 [begin, end)
+ */
+struct aho_corasick_match {
+    size_t pattern;
+    size_t begin;
+    size_t end;
+
+    size_t length() const noexcept { return end - begin; }
+
+    bool operator==(const aho_corasick_match& o) const noexcept {
+        return pattern == o.pattern && begin == o.begin && end == o.end;
+    }
+    bool operator!=(const aho_corasick_match& o) const noexcept { return !(*this == o); }
+};
+
+/**
+ * @brief 自动机构造选项
+ */
+struct aho_corasick_options {
+    bool   case_insensitive  = false;      // 仅对 ASCII 字母忽略大小写
+    size_t dense_table_bytes = 1u << 20;   // 稠密行总预算，超出部分的状态用稀疏边
+};
+
+/**
+ * @brief Aho–Corasick 自动机
+ */
+class aho_corasick {
+public:
+    using match = aho_corasick_match;
+
+    enum class match_kind { all, leftmost_longest };
+
+    using options = aho_corasick_options;
+
+    aho_corasick() { build(nullptr, 0, options{}); }
+
+    /**
+     * @brief 由模式集合构造（元素可转换为 std::string_view）
+     *
+     * 模式编号即其在集合中的下标。
+     */
+    template <typename Container,
+              typename = decltype(std::string_view(*std::declval<const Container&>().begin()))>
+    explicit aho_corasick(const Container& patterns, options opts = options{}) {
+        std::vector<std::string_view> views;
+        for (const auto& p : patterns) views.emplace_back(p);
+        build(views.data(), views.size(), opts);
+    }
+
+    aho_corasick(std::initializer_list<std::string_view> patterns, options opts = options{}) {
+        build(patterns.begin(), patterns.size(), opts);
+    }
+
+    size_t pattern_count() const noexcept { return pattern_len_.size(); }
+    size_t state_count() const noexcept { return fail_.size(); }
+    size_t dense_state_count() const noexcept { return dense_states_; }
+    size_t class_count() const noexcept { return stride_; }
+    size_t pattern_length(size_t pattern) const noexcept { return pattern_len_[pattern]; }
+    bool   case_insensitive() const noexcept { return case_insensitive_; }
+
+    /**
+     * @brief 自动机占用的内存（字节）
+     */
+    size_t memory_bytes() const noexcept {
+        return dense_.size() * sizeof(uint32_t) + sizeof(cls_) +
+               (fail_.size() + dict_.size() + out_.size() + sparse_begin_.size()) * sizeof(uint32_t) +
+               edge_cls_.size() * sizeof(uint16_t) + edge_next_.size() * sizeof(uint32_t) +
+               (pattern_len_.size() + pattern_next_.size()) * sizeof(uint32_t);
+    }
+
+    // ------------------------------------------------------------------------
+    // 流式扫描
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief 流式扫描状态：依次 feed 各块，最后调用 finish
+     *
+     * 回调签名为 fn(const match&)；返回 bool 时返回 false 表示停止，
+     * 此后 feed 不再报告匹配。stream 只引用自动机，自动机须比它活得久。
+     */
+    class stream {
+    public:
+        explicit stream(const aho_corasick& ac, match_kind kind = match_kind::all)
+            : ac_(&ac), kind_(kind) {}
+
+        template <typename Fn>
+        void feed(std::string_view chunk, Fn&& fn) {
+            if (stopped_) return;
+            if (kind_ == match_kind::all) {
+                feed_all(chunk, fn);
+            } else {
+                feed_leftmost_longest(chunk, fn);
+            }
+        }
+
+        /**
+         * @brief 流结束：leftmost_longest 模式下报告尚未确定的匹配
+         */
+        template <typename Fn>
+        void finish(Fn&& fn) {
+            while (!stopped_ && !pending_.empty()) commit_front(fn);
+        }
+
+        /**
+         * @brief 回到流的开头（偏移量归零）
+         */
+        void reset() noexcept {
+            state_ = 0;
+            offset_ = 0;
+            last_end_ = 0;
+            pending_.clear();
+            stopped_ = false;
+        }
+
+        size_t offset() const noexcept { return offset_; }
+
+    private:
+        template <typename Fn>
+        void emit(Fn& fn, const match& m) {
+            if constexpr (std::is_same_v<decltype(fn(m)), bool>) {
+                if (!fn(m)) stopped_ = true;
+            } else {
+                fn(m);
+            }
+        }
+
+        template <typename Fn>
+        void feed_all(std::string_view chunk, Fn& fn) {
+            const aho_corasick& ac = *ac_;
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(chunk.data());
+            const size_t n = chunk.size();
+            uint32_t s = state_;
+            for (size_t i = 0; i < n; ++i) {
+                uint32_t t = ac.step(s, ac.cls_[p[i]]);
+                s = t & state_mask;
+                if (t & output_bit) {
+                    size_t end = offset_ + i + 1;
+                    ac.for_each_output(ac.to_state(s), [&](uint32_t pid) {
+                        if (stopped_) return;
+                        emit(fn, match{pid, end - ac.pattern_len_[pid], end});
+                    });
+                    if (stopped_) break;
+                }
+            }
+            state_ = s;
+            offset_ += n;
+        }
+
+        // 待定匹配按起点排序，每个起点只保留最长的一个。当前状态深度为 d 时，
+        // 之后结束的匹配起点不早于 end - d，因此起点小于 end - d 的最左待定
+        // 匹配已不会被更左或更长的匹配取代，可以报告；报告后丢弃与它重叠的。
+        // 待定匹配的起点都在 [end - d, end) 内，个数不超过最长模式长度。
+        template <typename Fn>
+        void feed_leftmost_longest(std::string_view chunk, Fn& fn) {
+            const aho_corasick& ac = *ac_;
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(chunk.data());
+            const size_t n = chunk.size();
+            uint32_t s = state_;
+            for (size_t i = 0; i < n && !stopped_; ++i) {
+                uint32_t t = ac.step(s, ac.cls_[p[i]]);
+                s = t & state_mask;
+                size_t end = offset_ + i + 1;
+                if (t & output_bit) {
+                    ac.for_each_output(ac.to_state(s), [&](uint32_t pid) {
+                        size_t begin = end - ac.pattern_len_[pid];
+                        if (begin >= last_end_) add_pending(match{pid, begin, end});
+                    });
+                }
+                if (pending_.empty()) continue;
+                size_t horizon = end - ac.depth_[ac.to_state(s)];
+                while (!stopped_ && !pending_.empty() && pending_.front().begin < horizon) commit_front(fn);
+            }
+            state_ = s;
+            offset_ += n;
+        }
+
+        // 同一终点的输出从长到短给出，起点递增；先到的同起点匹配更短或等长
+        void add_pending(const match& m) {
+            auto it = pending_.end();
+            while (it != pending_.begin() && (it - 1)->begin > m.begin) --it;
+            if (it != pending_.begin() && (it - 1)->begin == m.begin) {
+                if (m.end > (it - 1)->end) *(it - 1) = m;
+                return;
+            }
+            pending_.insert(it, m);
+        }
+
+        template <typename Fn>
+        void commit_front(Fn& fn) {
+            match m = pending_.front();
+            pending_.pop_front();
+            last_end_ = m.end;
+            while (!pending_.empty() && pending_.front().begin < last_end_) pending_.pop_front();
+            emit(fn, m);
+        }
+
+        const aho_corasick* ac_;
+        match_kind kind_;
+        uint32_t   state_ = 0;          // 当前状态句柄
+        size_t     offset_ = 0;
+        size_t     last_end_ = 0;       // 上一个已报告匹配的终点（leftmost_longest）
+        std::deque<match> pending_;     // 尚未确定的匹配（leftmost_longest）
+        bool       stopped_ = false;
+    };
+
+    // ------------------------------------------------------------------------
+    // 一次性扫描
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief 对每个匹配调用 fn(const match&)；返回 bool 时返回 false 表示停止
+     */
+    template <typename Fn>
+    void for_each_match(std::string_view text, Fn&& fn, match_kind kind = match_kind::all) const {
+        stream st(*this, kind);
+        st.feed(text, fn);
+        st.finish(fn);
+    }
+
+    /**
+     * @brief 所有（可重叠的）匹配，按终点升序；终点相同时长的在前
+     */
+    std::vector<match> find_all(std::string_view text) const {
+        std::vector<match> result;
+        for_each_match(text, [&result](const match& m) { result.push_back(m); });
+        return result;
+    }
+
+    /**
+     * @brief 不重叠的最左最长匹配，按位置升序
+     */
+    std::vector<match> find_leftmost_longest(std::string_view text) const {
+        std::vector<match> result;
+        for_each_match(text, [&result](const match& m) { result.push_back(m); },
+                       match_kind::leftmost_longest);
+        return result;
+    }
+
+    /**
+     * @brief 文本中是否出现任一模式（找到第一个即返回）
+     */
+    bool contains_any(std::string_view text) const {
+        bool found = false;
+        for_each_match(text, [&found](const match&) { found = true; return false; });
+        return found;
+    }
+
+private:
+    static constexpr uint32_t output_bit = 0x80000000u;
+    static constexpr uint32_t state_mask = 0x7fffffffu;
+    static constexpr uint32_t none = 0xffffffffu;
+
+    // 扫描循环里的状态用「句柄」表示：稠密状态的句柄是其行首下标
+    // （状态号 × stride，预乘后每字节的查表不含乘法），稀疏状态的句柄
+    // 排在全部稠密行之后。状态号只在报告匹配时才需要。
+    uint32_t to_handle(uint32_t s) const noexcept {
+        return s < dense_states_ ? s * static_cast<uint32_t>(stride_) : dense_limit_ + (s - dense_states_);
+    }
+
+    uint32_t to_state(uint32_t h) const noexcept {
+        return h < dense_limit_ ? h / static_cast<uint32_t>(stride_) : h - dense_limit_ + dense_states_;
+    }
+
+    /**
+     * @brief 句柄 h 读入类 c 后的句柄（带输出标记）
+     */
+    uint32_t step(uint32_t h, unsigned c) const noexcept {
+        if (h < dense_limit_) return dense_[h + c];
+        return step_sparse(to_state(h), c);
+    }
+
+    uint32_t step_sparse(uint32_t s, unsigned c) const noexcept {
+        if (c == 0) return 0;
+        while (s >= dense_states_) {
+            uint32_t b = sparse_begin_[s - dense_states_], e = sparse_begin_[s - dense_states_ + 1];
+            for (uint32_t k = b; k < e; ++k) {
+                if (edge_cls_[k] == c) {
+                    uint32_t t = edge_next_[k];
+                    return has_output(t) ? (to_handle(t) | output_bit) : to_handle(t);
+                }
+                if (edge_cls_[k] > c) break;
+            }
+            s = fail_[s];
+        }
+        return dense_[static_cast<size_t>(s) * stride_ + c];
+    }
+
+    bool has_output(uint32_t s) const noexcept { return out_[s] != none || dict_[s] != none; }
+
+    /**
+     * @brief 对以状态 s 结尾的每个模式调用 fn(pattern)，从长到短
+     */
+    template <typename Fn>
+    void for_each_output(uint32_t s, Fn&& fn) const {
+        for (uint32_t u = out_[s] != none ? s : dict_[s]; u != none; u = dict_[u]) {
+            for (uint32_t pid = out_[u]; pid != none; pid = pattern_next_[pid]) fn(pid);
+        }
+    }
+
+    unsigned char fold(unsigned char c) const noexcept {
+        return (case_insensitive_ && c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c | 0x20) : c;
+    }
+
+    void build(const std::string_view* patterns, size_t count, const options& opts) {
+        case_insensitive_ = opts.case_insensitive;
+
+        // 1. 字节等价类
+        bool used[256] = {};
+        for (size_t i = 0; i < count; ++i) {
+            for (char ch : patterns[i]) used[fold(static_cast<unsigned char>(ch))] = true;
+        }
+        stride_ = 1;
+        for (unsigned b = 0; b < 256; ++b) {
+            cls_[b] = used[b] ? static_cast<uint16_t>(stride_++) : 0;
+        }
+        if (case_insensitive_) {
+            for (unsigned b = 'A'; b <= 'Z'; ++b) cls_[b] = cls_[b | 0x20];
+        }
+
+        // 2. trie（构造期使用按类排序的子节点列表）
+        struct node {
+            std::vector<std::pair<uint16_t, uint32_t>> children;
+            uint32_t pattern = none;   // 在此结束的第一个模式
+        };
+        std::vector<node> trie(1);
+        pattern_len_.assign(count, 0);
+        pattern_next_.assign(count, none);
+        std::vector<uint32_t> pattern_tail(1, none);
+        for (size_t i = 0; i < count; ++i) {
+            pattern_len_[i] = static_cast<uint32_t>(patterns[i].size());
+            if (patterns[i].empty()) continue;
+            uint32_t s = 0;
+            for (char ch : patterns[i]) {
+                uint16_t c = cls_[static_cast<unsigned char>(ch)];
+                auto& kids = trie[s].children;
+                auto it = kids.begin();
+                while (it != kids.end() && it->first < c) ++it;
+                if (it != kids.end() && it->first == c) {
+                    s = it->second;
+                } else {
+                    uint32_t t = static_cast<uint32_t>(trie.size());
+                    kids.insert(it, {c, t});
+                    trie.emplace_back();
+                    pattern_tail.push_back(none);
+                    s = t;
+                }
+            }
+            uint32_t pid = static_cast<uint32_t>(i);
+            if (trie[s].pattern == none) {
+                trie[s].pattern = pid;
+            } else {
+                pattern_next_[pattern_tail[s]] = pid;
+            }
+            pattern_tail[s] = pid;
+        }
+
+        // 3. BFS 重新编号（浅层在前），计算深度、失败链与输出链
+        const size_t states = trie.size();
+        std::vector<uint32_t> order;      // 新编号 -> trie 节点
+        std::vector<uint32_t> rank(states);
+        order.reserve(states);
+        order.push_back(0);
+        for (size_t head = 0; head < order.size(); ++head) {
+            for (const auto& kid : trie[order[head]].children) {
+                rank[kid.second] = static_cast<uint32_t>(order.size());
+                order.push_back(kid.second);
+            }
+        }
+        rank[0] = 0;
+
+        auto child = [&](uint32_t s, uint16_t c) -> uint32_t {   // 新编号上的 trie 边
+            for (const auto& kid : trie[order[s]].children) {
+                if (kid.first == c) return rank[kid.second];
+                if (kid.first > c) break;
+            }
+            return none;
+        };
+
+        fail_.assign(states, 0);
+        dict_.assign(states, none);
+        out_.assign(states, none);
+        depth_.assign(states, 0);
+        for (uint32_t s = 0; s < states; ++s) out_[s] = trie[order[s]].pattern;
+        // 父状态先于子状态处理；失败目标更浅，其 dict_ 已经算好
+        for (uint32_t s = 0; s < states; ++s) {
+            for (const auto& kid : trie[order[s]].children) {
+                uint32_t u = rank[kid.second];
+                depth_[u] = depth_[s] + 1;
+                if (s == 0) {
+                    fail_[u] = 0;
+                } else {
+                    uint32_t f = fail_[s];
+                    uint32_t t;
+                    while ((t = child(f, kid.first)) == none && f != 0) f = fail_[f];
+                    fail_[u] = t == none ? 0 : t;
+                }
+                uint32_t f = fail_[u];
+                dict_[u] = out_[f] != none ? f : dict_[f];
+            }
+        }
+
+        // 4. 稠密行：预算内的浅层状态，失败链完全展开
+        size_t row_bytes = stride_ * sizeof(uint32_t);
+        size_t budget_states = opts.dense_table_bytes / row_bytes;
+        if (budget_states < 1) budget_states = 1;
+        size_t max_states = (state_mask - states) / stride_;   // 句柄须放得进 31 位
+        if (budget_states > max_states) budget_states = max_states;
+        dense_states_ = static_cast<uint32_t>(budget_states < states ? budget_states : states);
+        dense_limit_ = dense_states_ * static_cast<uint32_t>(stride_);
+        dense_.assign(static_cast<size_t>(dense_states_) * stride_, 0);
+        for (uint32_t s = 0; s < dense_states_; ++s) {
+            uint32_t* row = &dense_[static_cast<size_t>(s) * stride_];
+            if (s != 0) {
+                const uint32_t* frow = &dense_[static_cast<size_t>(fail_[s]) * stride_];
+                for (size_t c = 0; c < stride_; ++c) row[c] = frow[c];
+            }
+            for (const auto& kid : trie[order[s]].children) {
+                uint32_t u = rank[kid.second];
+                row[kid.first] = has_output(u) ? (to_handle(u) | output_bit) : to_handle(u);
+            }
+        }
+
+        // 5. 稀疏边：其余状态只保存 trie 边
+        sparse_begin_.assign(states - dense_states_ + 1, 0);
+        edge_cls_.clear();
+        edge_next_.clear();
+        for (uint32_t s = dense_states_; s < states; ++s) {
+            sparse_begin_[s - dense_states_] = static_cast<uint32_t>(edge_cls_.size());
+            for (const auto& kid : trie[order[s]].children) {
+                edge_cls_.push_back(kid.first);
+                edge_next_.push_back(rank[kid.second]);
+            }
+        }
+        sparse_begin_[states - dense_states_] = static_cast<uint32_t>(edge_cls_.size());
+    }
+
+    bool     case_insensitive_ = false;
+    uint16_t cls_[256] = {};
+    size_t   stride_ = 1;                  // 类数（含类 0）
+    uint32_t dense_states_ = 0;
+    uint32_t dense_limit_ = 0;             // dense_states_ × stride_，句柄小于它即稠密状态
+    std::vector<uint32_t> dense_;          // dense_states_ × stride_
+    std::vector<uint32_t> sparse_begin_;   // 稀疏状态的边区间
+    std::vector<uint16_t> edge_cls_;
+    std::vector<uint32_t> edge_next_;
+    std::vector<uint32_t> fail_;
+    std::vector<uint32_t> dict_;           // 失败链上最近的有输出状态
+    std::vector<uint32_t> out_;            // 在此状态结束的第一个模式
+    std::vector<uint32_t> depth_;
+    std::vector<uint32_t> pattern_len_;
+    std::vector<uint32_t> pattern_next_;   // 相同模式的下一个编号
+};
+
+} // namespace zen
+
+#endif // ZEN_ALGORITHMS_AHO_CORASICK_H
@@ -11,6 +11,13 @@ struct less {
     }
 };
 
+template<typename T>
+struct greater {
+    constexpr bool operator()(const T& a, const T& b) const noexcept {
+        return b < a;
+    }
+};
+
 } // namespace zen
 
 #endif // ZEN_ALGORITHMS_COMPARATORS_H
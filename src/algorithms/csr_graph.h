@@ -0,0 +1,1068 @@
+/**
+ * @file csr_graph.h
+ * @brief 压缩稀疏行（CSR）图与并行图算法
+ * @details 面向千万级边的只读图：csr_graph 可由 Graph、边表或二进制边表文件
+ *          （mmap 映射）构造；提供方向优化的并行 BFS、delta-stepping 并行
+ *          单源最短路和并行并查集连通分量
+ */
+
+#ifndef ZEN_ALGORITHMS_CSR_GRAPH_H
+#define ZEN_ALGORITHMS_CSR_GRAPH_H
+
+#include "graph.h"
+#include "execution.h"
+#include "sort.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ZEN_GRAPH_HAVE_MMAP 1
+#else
+#define ZEN_GRAPH_HAVE_MMAP 0
+#endif
+
+namespace zen {
+
+// ============================================================================
+// CSR 图
+// ============================================================================
+//
+// 布局：offsets[v] .. offsets[v + 1] 是顶点 v 的出边在 targets / weights 中的
+// 区间。顶点编号为 32 位，边下标为 64 位。构造后只读，可被多个线程同时读取。
+// 无权图（边表文件不带权重）不保存 weights，weight() 一律返回 1。
+//
+// 构造选项：
+// - symmetrize       : 每条边 u→v 同时加入 v→u，得到无向图（is_symmetric()）
+// - build_incoming   : 有向图额外保存入边（转置 CSR）；方向优化 BFS 的自底向上
+//                      步骤需要入边，对称图直接使用出边
+// - sort_neighbors   : 每个顶点的邻居按编号升序（并行构造时邻居顺序不确定，
+//                      排序后结果与线程数无关，访问也更连续）
+// - remove_duplicates: 去掉重复的 (u, v)，保留权重最小的一条（要求 sort_neighbors）
+//
+// 带执行策略的构造函数并行统计度数、散列边和排序邻居；
+// 端点越界的边被忽略（与 Graph::add_directed_edge 一致）。
+// ============================================================================
+
+/**
+ * @brief 边表中的一条边
+ */
+template <typename WeightType = double>
+struct csr_edge {
+    uint32_t   source;
+    uint32_t   target;
+    WeightType weight;
+};
+
+/**
+ * @brief csr_graph 构造选项
+ */
+struct csr_options {
+    bool symmetrize        = false;
+    bool build_incoming    = false;
+    bool sort_neighbors    = true;
+    bool remove_duplicates = false;
+};
+
+/**
+ * @brief 连续数组上的只读区间（邻居、边权）
+ */
+template <typename T>
+struct csr_range {
+    const T* first = nullptr;
+    const T* last  = nullptr;
+
+    const T* begin() const noexcept { return first; }
+    const T* end() const noexcept { return last; }
+    size_t size() const noexcept { return static_cast<size_t>(last - first); }
+    bool empty() const noexcept { return first == last; }
+    const T& operator[](size_t i) const noexcept { return first[i]; }
+};
+
+class mapped_edge_list;
+
+namespace detail {
+
+// 图算法的默认最小块大小（执行策略用 with_grain(n) 指定时以策略为准）
+constexpr par_size_t csr_grain_vertices = 2048;    // 按顶点切块
+constexpr par_size_t csr_grain_edges    = 65536;   // 按边切块
+constexpr par_size_t csr_grain_frontier = 256;     // 按 BFS / SSSP 前沿切块
+
+/**
+ * @brief 分块局部结果的槽位数：parallel_chunk_count 不会超过它
+ */
+inline par_size_t csr_max_chunks(const parallel_context& ctx) noexcept {
+    return ctx.workers * 4;
+}
+
+/**
+ * @brief 把 [0, n) 切块后并行执行 body(chunk, begin, end)，返回块数
+ * @param grain 默认最小块大小，策略指定了粒度时不使用
+ */
+template <typename Body>
+par_size_t csr_for_chunks(const parallel_context& ctx, par_size_t n, par_size_t grain, Body body) {
+    par_size_t chunks = parallel_chunk_count(n, ctx.workers, ctx.grain_or(grain));
+    auto run = [&](par_size_t i) {
+        body(i, parallel_chunk_begin(n, chunks, i), parallel_chunk_begin(n, chunks, i + 1));
+    };
+    parallel_run_chunks(ctx, chunks, run);
+    return chunks;
+}
+
+/**
+ * @brief 把前 count 个分块的局部结果按块顺序拼接到 out，并清空各块
+ */
+template <typename T>
+void csr_concat_chunks(const parallel_context& ctx, std::vector<std::vector<T>>& parts,
+                       par_size_t count, std::vector<T>& out) {
+    std::vector<size_t> start(count + 1, 0);
+    for (par_size_t i = 0; i < count; ++i) start[i + 1] = start[i] + parts[i].size();
+    out.resize(start[count]);
+    auto copy = [&](par_size_t i) {
+        if (!parts[i].empty()) std::memcpy(out.data() + start[i], parts[i].data(), parts[i].size() * sizeof(T));
+        parts[i].clear();
+    };
+    if (start[count] < ctx.grain_or(csr_grain_edges)) {
+        for (par_size_t i = 0; i < count; ++i) copy(i);
+    } else {
+        parallel_run_chunks(ctx, count, copy);
+    }
+}
+
+/**
+ * @brief 原子地把 a 降为 min(a, v)，成功降低时返回 true
+ */
+template <typename T>
+bool atomic_fetch_min(std::atomic<T>& a, T v) noexcept {
+    T cur = a.load(std::memory_order_relaxed);
+    while (v < cur) {
+        if (a.compare_exchange_weak(cur, v, std::memory_order_relaxed)) return true;
+    }
+    return false;
+}
+
+} // namespace detail
+
+/**
+ * @brief 只读 CSR 图
+ * @tparam WeightType 边权重类型
+ */
+template <typename WeightType = double>
+class csr_graph {
+public:
+    using vertex_id = uint32_t;
+    using edge_id   = uint64_t;
+    using Weight    = WeightType;
+    using edge      = csr_edge<Weight>;
+
+    static constexpr vertex_id npos = static_cast<vertex_id>(-1);
+
+    csr_graph() : offsets_(1, 0) {}
+
+    /**
+     * @brief 由邻接表图构造（保留权重）
+     */
+    template <typename T, typename W>
+    explicit csr_graph(const Graph<T, W>& graph, csr_options opts = csr_options{})
+        : csr_graph(execution::seq, graph, opts) {}
+
+    template <typename Policy, typename T, typename W, typename = detail::enable_if_policy_t<Policy>>
+    csr_graph(Policy&& policy, const Graph<T, W>& graph, csr_options opts = csr_options{}) {
+        std::vector<edge> edges;
+        for (size_t u = 0; u < graph.node_count(); ++u) {
+            for (const auto& e : graph.neighbors(u)) {
+                edges.push_back(edge{static_cast<vertex_id>(u), static_cast<vertex_id>(e.first),
+                                     static_cast<Weight>(e.second)});
+            }
+        }
+        build_from_edges(detail::make_parallel_context(policy), graph.node_count(), edges, true, opts);
+    }
+
+    /**
+     * @brief 由边表构造：顶点为 [0, vertex_count)
+     */
+    csr_graph(size_t vertex_count, const std::vector<edge>& edges, csr_options opts = csr_options{})
+        : csr_graph(execution::seq, vertex_count, edges, opts) {}
+
+    template <typename Policy, typename = detail::enable_if_policy_t<Policy>>
+    csr_graph(Policy&& policy, size_t vertex_count, const std::vector<edge>& edges,
+              csr_options opts = csr_options{}) {
+        build_from_edges(detail::make_parallel_context(policy), vertex_count, edges, true, opts);
+    }
+
+    /**
+     * @brief 由已映射的二进制边表文件构造（见 mapped_edge_list）
+     */
+    explicit csr_graph(const mapped_edge_list& file, csr_options opts = csr_options{})
+        : csr_graph(execution::seq, file, opts) {}
+
+    template <typename Policy, typename = detail::enable_if_policy_t<Policy>>
+    csr_graph(Policy&& policy, const mapped_edge_list& file, csr_options opts = csr_options{});
+
+    size_t vertex_count() const noexcept { return offsets_.size() - 1; }
+    size_t edge_count() const noexcept { return targets_.size(); }
+    bool   weighted() const noexcept { return weighted_; }
+    bool   is_symmetric() const noexcept { return symmetric_; }
+
+    /**
+     * @brief 是否可以按入边遍历（对称图或构造时保存了入边）
+     */
+    bool has_incoming() const noexcept { return symmetric_ || !in_offsets_.empty(); }
+
+    size_t degree(vertex_id v) const noexcept { return static_cast<size_t>(offsets_[v + 1] - offsets_[v]); }
+
+    csr_range<vertex_id> neighbors(vertex_id v) const noexcept {
+        return { targets_.data() + offsets_[v], targets_.data() + offsets_[v + 1] };
+    }
+
+    /**
+     * @brief 顶点 v 出边的权重，与 neighbors(v) 一一对应；无权图为空区间
+     */
+    csr_range<Weight> edge_weights(vertex_id v) const noexcept {
+        if (weights_.empty()) return {};
+        return { weights_.data() + offsets_[v], weights_.data() + offsets_[v + 1] };
+    }
+
+    Weight weight(edge_id e) const noexcept { return weights_.empty() ? Weight(1) : weights_[e]; }
+
+    size_t in_degree(vertex_id v) const noexcept {
+        if (symmetric_) return degree(v);
+        return static_cast<size_t>(in_offsets_[v + 1] - in_offsets_[v]);
+    }
+
+    /**
+     * @brief 指向 v 的边的起点；要求 has_incoming()
+     */
+    csr_range<vertex_id> in_neighbors(vertex_id v) const noexcept {
+        if (symmetric_) return neighbors(v);
+        return { in_sources_.data() + in_offsets_[v], in_sources_.data() + in_offsets_[v + 1] };
+    }
+
+    const edge_id*   offsets() const noexcept { return offsets_.data(); }
+    const vertex_id* targets() const noexcept { return targets_.data(); }
+    const Weight*    weights() const noexcept { return weights_.empty() ? nullptr : weights_.data(); }
+
+    size_t memory_bytes() const noexcept {
+        return (offsets_.size() + in_offsets_.size()) * sizeof(edge_id) +
+               (targets_.size() + in_sources_.size()) * sizeof(vertex_id) + weights_.size() * sizeof(Weight);
+    }
+
+private:
+    void build_from_edges(const detail::parallel_context& ctx, size_t n, const std::vector<edge>& edges,
+                          bool has_weights, const csr_options& opts) {
+        const edge* e = edges.data();
+        build(ctx, n, edges.size(), has_weights, opts,
+              [e](size_t i) { return e[i].source; },
+              [e](size_t i) { return e[i].target; },
+              [e](size_t i) { return e[i].weight; });
+    }
+
+    /**
+     * @brief 计数排序构造：src(i) / dst(i) / wt(i) 给出第 i 条输入边
+     */
+    template <typename Src, typename Dst, typename Wt>
+    void build(const detail::parallel_context& ctx, size_t n, size_t m, bool has_weights,
+               const csr_options& opts, Src src, Dst dst, Wt wt) {
+        using detail::par_size_t;
+        symmetric_ = opts.symmetrize;
+        weighted_ = has_weights;
+        const bool sym = opts.symmetrize;
+
+        // 1. 按起点分行（计数排序），越界的边被丢弃
+        auto gen = [&](par_size_t b, par_size_t e, auto&& emit) {
+            for (par_size_t i = b; i < e; ++i) {
+                vertex_id s = src(i), t = dst(i);
+                if (s >= n || t >= n) continue;
+                Weight w = has_weights ? static_cast<Weight>(wt(i)) : Weight(1);
+                emit(s, t, w);
+                if (sym && s != t) emit(t, s, w);
+            }
+        };
+        fill_rows(ctx, n, m, detail::csr_grain_edges, gen, offsets_, targets_, has_weights ? &weights_ : nullptr);
+        if (!has_weights) weights_.clear();
+
+        // 4. 邻居排序 / 去重
+        if (opts.sort_neighbors || opts.remove_duplicates) sort_rows(ctx, opts.remove_duplicates);
+
+        // 5. 入边（转置）
+        in_offsets_.clear();
+        in_sources_.clear();
+        if (opts.build_incoming && !sym) build_incoming(ctx);
+    }
+
+    /**
+     * @brief 计数排序建行：gen(begin, end, emit) 对输入 [begin, end) 调用
+     *        emit(row, column, weight)，结果写入 offsets / columns / weights
+     *
+     * 单线程时直接计数、散列。多线程时不用原子游标（加锁指令要等此前的离散
+     * 写入完成，散列会慢一个数量级），而是两级划分：各输入块先按行块
+     * （连续的 2^shift 个行）统计并把条目写入按行块分组的临时数组，再由每个
+     * 行块独立完成块内的计数排序；行块 b 的第一行在结果中的偏移就是
+     * 前面各行块的条目总数。
+     */
+    template <typename Gen>
+    static void fill_rows(const detail::parallel_context& ctx, size_t n, size_t inputs, detail::par_size_t grain,
+                          Gen gen, std::vector<edge_id>& offsets, std::vector<vertex_id>& columns,
+                          std::vector<Weight>* weights) {
+        using detail::par_size_t;
+        offsets.assign(n + 1, 0);
+        if (n == 0 || !ctx.pool || ctx.workers <= 1 ||
+            detail::parallel_chunk_count(inputs, ctx.workers, ctx.grain_or(grain)) == 1) {
+            gen(par_size_t(0), inputs, [&](vertex_id r, vertex_id, Weight) { ++offsets[r + 1]; });
+            for (size_t v = 0; v < n; ++v) offsets[v + 1] += offsets[v];
+            columns.resize(offsets[n]);
+            if (weights) weights->resize(offsets[n]);
+            std::vector<edge_id> cursor(offsets.begin(), offsets.end() - 1);
+            gen(par_size_t(0), inputs, [&](vertex_id r, vertex_id c, Weight w) {
+                edge_id p = cursor[r]++;
+                columns[p] = c;
+                if (weights) (*weights)[p] = w;
+            });
+            return;
+        }
+
+        struct entry {
+            vertex_id row;
+            vertex_id column;
+            Weight    weight;
+        };
+        const par_size_t slots = detail::csr_max_chunks(ctx);
+        unsigned shift = 0;
+        while (((n - 1) >> shift) >= slots) ++shift;
+        const par_size_t blocks = ((n - 1) >> shift) + 1;
+
+        // 各输入块在每个行块中的条目数
+        std::vector<edge_id> hist(slots * blocks, 0);
+        par_size_t chunks = detail::csr_for_chunks(ctx, inputs, grain, [&](par_size_t c, par_size_t b, par_size_t e) {
+            edge_id* h = &hist[c * blocks];
+            gen(b, e, [&](vertex_id r, vertex_id, Weight) { ++h[r >> shift]; });
+        });
+        std::vector<edge_id> block_start(blocks + 1, 0);
+        for (par_size_t blk = 0; blk < blocks; ++blk) {
+            edge_id pos = block_start[blk];
+            for (par_size_t c = 0; c < chunks; ++c) {
+                edge_id cnt = hist[c * blocks + blk];
+                hist[c * blocks + blk] = pos;
+                pos += cnt;
+            }
+            block_start[blk + 1] = pos;
+        }
+
+        // 条目按行块分组写入临时数组
+        std::vector<entry> staged(block_start[blocks]);
+        detail::csr_for_chunks(ctx, inputs, grain, [&](par_size_t c, par_size_t b, par_size_t e) {
+            edge_id* cursor = &hist[c * blocks];
+            gen(b, e, [&](vertex_id r, vertex_id col, Weight w) { staged[cursor[r >> shift]++] = entry{r, col, w}; });
+        });
+
+        // 每个行块独立计数排序
+        columns.resize(block_start[blocks]);
+        if (weights) weights->resize(block_start[blocks]);
+        auto per_block = [&](par_size_t blk) {
+            size_t first = blk << shift, last = (blk + 1) << shift;
+            if (last > n) last = n;
+            const entry* lo = staged.data() + block_start[blk];
+            const entry* hi = staged.data() + block_start[blk + 1];
+            // 只写本行块的行首 offsets[first, last)；offsets[n] 最后单独写
+            std::vector<edge_id> cursor(last - first, 0);
+            for (const entry* p = lo; p != hi; ++p) ++cursor[p->row - first];
+            edge_id pos = block_start[blk];
+            for (size_t v = first; v < last; ++v) {
+                edge_id cnt = cursor[v - first];
+                offsets[v] = cursor[v - first] = pos;
+                pos += cnt;
+            }
+            for (const entry* p = lo; p != hi; ++p) {
+                edge_id q = cursor[p->row - first]++;
+                columns[q] = p->column;
+                if (weights) (*weights)[q] = p->weight;
+            }
+        };
+        detail::parallel_run_chunks(ctx, blocks, per_block);
+        offsets[n] = block_start[blocks];
+    }
+
+    void sort_rows(const detail::parallel_context& ctx, bool dedupe) {
+        using detail::par_size_t;
+        const size_t n = vertex_count();
+        std::vector<edge_id> kept(dedupe ? n : 0);
+        std::vector<std::vector<std::pair<vertex_id, Weight>>> scratch(detail::csr_max_chunks(ctx));
+        detail::csr_for_chunks(ctx, n, detail::csr_grain_vertices, [&](par_size_t c, par_size_t b, par_size_t e) {
+            auto& tmp = scratch[c];
+            for (par_size_t v = b; v < e; ++v) {
+                edge_id lo = offsets_[v], hi = offsets_[v + 1];
+                size_t len = static_cast<size_t>(hi - lo);
+                if (weights_.empty()) {
+                    vertex_id* row = targets_.data() + lo;
+                    zen::pdqsort(row, row + len);
+                    if (dedupe) {
+                        size_t w = 0;
+                        for (size_t k = 0; k < len; ++k) if (w == 0 || row[k] != row[w - 1]) row[w++] = row[k];
+                        kept[v] = w;
+                    }
+                    continue;
+                }
+                // 有权图：按 (目标, 权重) 排序，去重时保留的第一条权重最小
+                tmp.resize(len);
+                for (size_t k = 0; k < len; ++k) tmp[k] = { targets_[lo + k], weights_[lo + k] };
+                zen::pdqsort(tmp.begin(), tmp.end());
+                size_t w = 0;
+                for (size_t k = 0; k < len; ++k) {
+                    if (dedupe && w != 0 && tmp[k].first == targets_[lo + w - 1]) continue;
+                    targets_[lo + w] = tmp[k].first;
+                    weights_[lo + w] = tmp[k].second;
+                    ++w;
+                }
+                if (dedupe) kept[v] = w;
+            }
+        });
+        if (!dedupe) return;
+
+        // 各行去重后向前压实（写位置不超过读位置，顺序执行）
+        edge_id out = 0;
+        for (size_t v = 0; v < n; ++v) {
+            edge_id lo = offsets_[v];
+            offsets_[v] = out;
+            if (out != lo) {
+                std::memmove(targets_.data() + out, targets_.data() + lo, kept[v] * sizeof(vertex_id));
+                if (!weights_.empty()) std::memmove(weights_.data() + out, weights_.data() + lo, kept[v] * sizeof(Weight));
+            }
+            out += kept[v];
+        }
+        offsets_[n] = out;
+        targets_.resize(out);
+        targets_.shrink_to_fit();
+        if (!weights_.empty()) {
+            weights_.resize(out);
+            weights_.shrink_to_fit();
+        }
+    }
+
+    void build_incoming(const detail::parallel_context& ctx) {
+        using detail::par_size_t;
+        const size_t n = vertex_count();
+        auto gen = [&](par_size_t b, par_size_t e, auto&& emit) {
+            for (par_size_t u = b; u < e; ++u) {
+                for (edge_id k = offsets_[u]; k < offsets_[u + 1]; ++k) emit(targets_[k], static_cast<vertex_id>(u), Weight(1));
+            }
+        };
+        fill_rows(ctx, n, n, detail::csr_grain_vertices, gen, in_offsets_, in_sources_, nullptr);
+        detail::csr_for_chunks(ctx, n, detail::csr_grain_vertices, [&](par_size_t, par_size_t b, par_size_t e) {
+            for (par_size_t v = b; v < e; ++v) {
+                zen::pdqsort(in_sources_.data() + in_offsets_[v], in_sources_.data() + in_offsets_[v + 1]);
+            }
+        });
+    }
+
+    std::vector<edge_id>   offsets_;
+    std::vector<vertex_id> targets_;
+    std::vector<Weight>    weights_;
+    std::vector<edge_id>   in_offsets_;   // 仅有向图且 build_incoming 时非空
+    std::vector<vertex_id> in_sources_;
+    bool                   symmetric_ = false;
+    bool                   weighted_ = false;
+};
+
+// ============================================================================
+// 二进制边表文件
+// ============================================================================
+//
+// 文件格式（小端）：
+//   头部 32 字节：magic "ZENEDGE1" | u64 顶点数 | u64 边数 | u32 权重类型 | u32 保留
+//   之后是定长记录：u32 起点 | u32 终点 | 权重（按权重类型 0 / 4 / 8 字节）
+// 权重类型：0 无权、1 float、2 double、3 uint32、4 uint64。
+//
+// mapped_edge_list 以只读方式 mmap 整个文件，构造 csr_graph 时直接从映射中
+// 读取记录，不复制边表；不支持 mmap 的平台退化为一次性读入内存。
+// ============================================================================
+
+enum class edge_weight_kind : uint32_t {
+    none    = 0,
+    float32 = 1,
+    float64 = 2,
+    uint32  = 3,
+    uint64  = 4,
+};
+
+namespace detail {
+
+constexpr char   edge_list_magic[8]     = { 'Z', 'E', 'N', 'E', 'D', 'G', 'E', '1' };
+constexpr size_t edge_list_header_bytes = 32;
+
+inline size_t edge_weight_bytes(edge_weight_kind k) noexcept {
+    switch (k) {
+    case edge_weight_kind::none:    return 0;
+    case edge_weight_kind::float32: return 4;
+    case edge_weight_kind::float64: return 8;
+    case edge_weight_kind::uint32:  return 4;
+    case edge_weight_kind::uint64:  return 8;
+    }
+    return 0;
+}
+
+template <typename W>
+constexpr edge_weight_kind edge_weight_kind_of() noexcept {
+    if constexpr (is_same_v<W, float>) return edge_weight_kind::float32;
+    else if constexpr (std::is_floating_point<W>::value) return edge_weight_kind::float64;
+    else if constexpr (sizeof(W) <= 4) return edge_weight_kind::uint32;
+    else return edge_weight_kind::uint64;
+}
+
+} // namespace detail
+
+/**
+ * @brief 只读映射的二进制边表文件
+ */
+class mapped_edge_list {
+public:
+    mapped_edge_list() = default;
+    explicit mapped_edge_list(const char* path) { open(path); }
+    ~mapped_edge_list() { close(); }
+
+    mapped_edge_list(const mapped_edge_list&) = delete;
+    mapped_edge_list& operator=(const mapped_edge_list&) = delete;
+
+    /**
+     * @brief 打开并校验文件；失败（不存在、格式或长度不符）时返回 false
+     */
+    bool open(const char* path) {
+        close();
+        size_t len = 0;
+#if ZEN_GRAPH_HAVE_MMAP
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(detail::edge_list_header_bytes)) {
+            ::close(fd);
+            return false;
+        }
+        len = static_cast<size_t>(st.st_size);
+        void* p = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        ::madvise(p, len, MADV_SEQUENTIAL);
+        map_ = p;
+        map_len_ = len;
+        data_ = static_cast<const unsigned char*>(p);
+#else
+        FILE* fp = std::fopen(path, "rb");
+        if (!fp) return false;
+        unsigned char chunk[65536];
+        size_t r;
+        while ((r = std::fread(chunk, 1, sizeof(chunk), fp)) > 0) buffer_.insert(buffer_.end(), chunk, chunk + r);
+        std::fclose(fp);
+        len = buffer_.size();
+        data_ = buffer_.data();
+#endif
+        if (!parse_header(len)) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() noexcept {
+#if ZEN_GRAPH_HAVE_MMAP
+        if (map_) ::munmap(map_, map_len_);
+        map_ = nullptr;
+        map_len_ = 0;
+#else
+        buffer_.clear();
+#endif
+        data_ = nullptr;
+        record_bytes_ = 0;
+        vertex_count_ = edge_count_ = 0;
+        kind_ = edge_weight_kind::none;
+    }
+
+    bool   is_open() const noexcept { return data_ != nullptr; }
+    explicit operator bool() const noexcept { return is_open(); }
+    size_t vertex_count() const noexcept { return vertex_count_; }
+    size_t edge_count() const noexcept { return edge_count_; }
+    bool   weighted() const noexcept { return kind_ != edge_weight_kind::none; }
+    edge_weight_kind weight_kind() const noexcept { return kind_; }
+
+    uint32_t source(size_t i) const noexcept { return load<uint32_t>(record(i)); }
+    uint32_t target(size_t i) const noexcept { return load<uint32_t>(record(i) + 4); }
+
+    /**
+     * @brief 第 i 条边的权重，转换为 W；无权文件返回 1
+     */
+    template <typename W>
+    W weight(size_t i) const noexcept {
+        const unsigned char* p = record(i) + 8;
+        switch (kind_) {
+        case edge_weight_kind::float32: return static_cast<W>(load<float>(p));
+        case edge_weight_kind::float64: return static_cast<W>(load<double>(p));
+        case edge_weight_kind::uint32:  return static_cast<W>(load<uint32_t>(p));
+        case edge_weight_kind::uint64:  return static_cast<W>(load<uint64_t>(p));
+        default:                        return W(1);
+        }
+    }
+
+private:
+    template <typename T>
+    static T load(const unsigned char* p) noexcept {
+        T v;
+        std::memcpy(&v, p, sizeof(T));
+        return v;
+    }
+
+    const unsigned char* record(size_t i) const noexcept {
+        return data_ + detail::edge_list_header_bytes + i * record_bytes_;
+    }
+
+    bool parse_header(size_t len) {
+        if (std::memcmp(data_, detail::edge_list_magic, 8) != 0) return false;
+        uint64_t n = load<uint64_t>(data_ + 8), m = load<uint64_t>(data_ + 16);
+        uint32_t kind = load<uint32_t>(data_ + 24);
+        if (kind > static_cast<uint32_t>(edge_weight_kind::uint64)) return false;
+        if (n > static_cast<uint64_t>(csr_graph<>::npos)) return false;
+        kind_ = static_cast<edge_weight_kind>(kind);
+        record_bytes_ = 8 + detail::edge_weight_bytes(kind_);
+        if (m > (len - detail::edge_list_header_bytes) / record_bytes_ ||
+            detail::edge_list_header_bytes + m * record_bytes_ != len) return false;
+        vertex_count_ = static_cast<size_t>(n);
+        edge_count_ = static_cast<size_t>(m);
+        return true;
+    }
+
+#if ZEN_GRAPH_HAVE_MMAP
+    void*  map_ = nullptr;
+    size_t map_len_ = 0;
+#else
+    std::vector<unsigned char> buffer_;
+#endif
+    const unsigned char* data_ = nullptr;
+    size_t record_bytes_ = 0;   // parse_header 按权重类型设置
+    size_t vertex_count_ = 0;
+    size_t edge_count_ = 0;
+    edge_weight_kind kind_ = edge_weight_kind::none;
+};
+
+/**
+ * @brief 把边表写成二进制边表文件；weighted 为 false 时不写权重
+ */
+template <typename W>
+bool write_edge_list(const char* path, size_t vertex_count, const std::vector<csr_edge<W>>& edges,
+                     bool weighted = true) {
+    FILE* fp = std::fopen(path, "wb");
+    if (!fp) return false;
+    edge_weight_kind kind = weighted ? detail::edge_weight_kind_of<W>() : edge_weight_kind::none;
+    unsigned char header[detail::edge_list_header_bytes] = {};
+    uint64_t n = vertex_count, m = edges.size();
+    uint32_t k = static_cast<uint32_t>(kind);
+    std::memcpy(header, detail::edge_list_magic, 8);
+    std::memcpy(header + 8, &n, 8);
+    std::memcpy(header + 16, &m, 8);
+    std::memcpy(header + 24, &k, 4);
+    bool ok = std::fwrite(header, 1, sizeof(header), fp) == sizeof(header);
+
+    std::vector<unsigned char> buf;
+    const size_t rec = 8 + detail::edge_weight_bytes(kind);
+    buf.reserve(rec * 4096);
+    for (size_t i = 0; ok && i < edges.size(); ++i) {
+        unsigned char r[16];
+        std::memcpy(r, &edges[i].source, 4);
+        std::memcpy(r + 4, &edges[i].target, 4);
+        switch (kind) {
+        case edge_weight_kind::float32: { float v = static_cast<float>(edges[i].weight); std::memcpy(r + 8, &v, 4); break; }
+        case edge_weight_kind::float64: { double v = static_cast<double>(edges[i].weight); std::memcpy(r + 8, &v, 8); break; }
+        case edge_weight_kind::uint32:  { uint32_t v = static_cast<uint32_t>(edges[i].weight); std::memcpy(r + 8, &v, 4); break; }
+        case edge_weight_kind::uint64:  { uint64_t v = static_cast<uint64_t>(edges[i].weight); std::memcpy(r + 8, &v, 8); break; }
+        default: break;
+        }
+        buf.insert(buf.end(), r, r + rec);
+        if (buf.size() >= rec * 4096 || i + 1 == edges.size()) {
+            ok = std::fwrite(buf.data(), 1, buf.size(), fp) == buf.size();
+            buf.clear();
+        }
+    }
+    ok = (std::fclose(fp) == 0) && ok;
+    return ok;
+}
+
+template <typename WeightType>
+template <typename Policy, typename>
+csr_graph<WeightType>::csr_graph(Policy&& policy, const mapped_edge_list& file, csr_options opts) {
+    const mapped_edge_list* f = &file;
+    build(detail::make_parallel_context(policy), file.vertex_count(), file.edge_count(), file.weighted(), opts,
+          [f](size_t i) { return f->source(i); },
+          [f](size_t i) { return f->target(i); },
+          [f](size_t i) { return f->template weight<WeightType>(i); });
+}
+
+// ============================================================================
+// 方向优化 BFS
+// ============================================================================
+//
+// Beamer 等人的方向优化：前沿较小时自顶向下（前沿顶点检查出边，用 CAS 认领
+// 未访问的邻居）；前沿的出边数超过未访问部分边数的 1/alpha 时切换为自底向上
+// （每个未访问顶点检查入边，找到任一在前沿中的父节点即停止），前沿缩小到
+// n/beta 以下时再切回。自底向上要求 has_incoming()，否则始终自顶向下。
+// 两种步骤都在线程池上按块并行；结果（层数）与顺序 BFS 相同，父节点可能
+// 是同层的任一合法父节点。
+// ============================================================================
+
+/**
+ * @brief BFS 结果：未到达的顶点 parent / depth 为 npos，起点的父节点是自己
+ */
+struct csr_bfs_result {
+    std::vector<uint32_t> parent;
+    std::vector<uint32_t> depth;
+};
+
+template <typename Policy, typename W>
+detail::enable_if_policy_t<Policy, csr_bfs_result>
+bfs(Policy&& policy, const csr_graph<W>& graph, uint32_t source) {
+    using detail::par_size_t;
+    using vertex_id = typename csr_graph<W>::vertex_id;
+    constexpr vertex_id npos = csr_graph<W>::npos;
+    constexpr size_t alpha = 15, beta = 18;
+
+    const size_t n = graph.vertex_count();
+    csr_bfs_result result;
+    result.depth.assign(n, npos);
+    if (source >= n) {
+        result.parent.assign(n, npos);
+        return result;
+    }
+
+    auto ctx = detail::make_parallel_context(policy);
+    const auto* offsets = graph.offsets();
+    const auto* targets = graph.targets();
+    std::unique_ptr<std::atomic<vertex_id>[]> parent(new std::atomic<vertex_id>[n]);
+    detail::csr_for_chunks(ctx, n, detail::csr_grain_vertices, [&](par_size_t, par_size_t b, par_size_t e) {
+        for (par_size_t v = b; v < e; ++v) parent[v].store(npos, std::memory_order_relaxed);
+    });
+    uint32_t* depth = result.depth.data();
+    parent[source].store(source, std::memory_order_relaxed);
+    depth[source] = 0;
+
+    const par_size_t slots = detail::csr_max_chunks(ctx);
+    std::vector<std::vector<vertex_id>> local(slots);
+    std::vector<size_t> local_count(slots);
+    std::vector<vertex_id> frontier(1, source), next;
+    std::vector<uint8_t> front, next_front;
+
+    const bool can_bottom_up = graph.has_incoming();
+    size_t edges_to_check = graph.edge_count();
+    size_t scout = graph.degree(source);
+    uint32_t level = 0;
+
+    while (!frontier.empty()) {
+        if (can_bottom_up && scout > edges_to_check / alpha) {
+            // 队列 -> 位图
+            front.assign(n, 0);
+            next_front.resize(n);
+            for (vertex_id v : frontier) front[v] = 1;
+            size_t awake = frontier.size(), old_awake;
+            do {
+                old_awake = awake;
+                par_size_t chunks = detail::csr_for_chunks(ctx, n, detail::csr_grain_vertices,
+                    [&](par_size_t c, par_size_t b, par_size_t e) {
+                    size_t cnt = 0;
+                    for (par_size_t v = b; v < e; ++v) {
+                        next_front[v] = 0;
+                        if (parent[v].load(std::memory_order_relaxed) != npos) continue;
+                        for (vertex_id u : graph.in_neighbors(static_cast<vertex_id>(v))) {
+                            if (front[u]) {
+                                parent[v].store(u, std::memory_order_relaxed);
+                                depth[v] = level + 1;
+                                next_front[v] = 1;
+                                ++cnt;
+                                break;
+                            }
+                        }
+                    }
+                    local_count[c] = cnt;
+                });
+                awake = 0;
+                for (par_size_t c = 0; c < chunks; ++c) awake += local_count[c];
+                front.swap(next_front);
+                ++level;
+            } while (awake != 0 && (awake >= old_awake || awake > n / beta));
+
+            // 位图 -> 队列
+            par_size_t chunks = detail::csr_for_chunks(ctx, n, detail::csr_grain_vertices,
+                [&](par_size_t c, par_size_t b, par_size_t e) {
+                for (par_size_t v = b; v < e; ++v) if (front[v]) local[c].push_back(static_cast<vertex_id>(v));
+            });
+            detail::csr_concat_chunks(ctx, local, chunks, frontier);
+            scout = 1;
+            continue;
+        }
+
+        edges_to_check -= scout < edges_to_check ? scout : edges_to_check;
+        par_size_t chunks = detail::csr_for_chunks(ctx, frontier.size(), detail::csr_grain_frontier,
+            [&](par_size_t c, par_size_t b, par_size_t e) {
+            size_t found_edges = 0;
+            auto& out = local[c];
+            for (par_size_t k = b; k < e; ++k) {
+                vertex_id u = frontier[k];
+                for (auto i = offsets[u]; i < offsets[u + 1]; ++i) {
+                    vertex_id v = targets[i];
+                    vertex_id expected = npos;
+                    if (parent[v].load(std::memory_order_relaxed) == npos &&
+                        parent[v].compare_exchange_strong(expected, u, std::memory_order_relaxed)) {
+                        depth[v] = level + 1;
+                        out.push_back(v);
+                        found_edges += static_cast<size_t>(offsets[v + 1] - offsets[v]);
+                    }
+                }
+            }
+            local_count[c] = found_edges;
+        });
+        scout = 0;
+        for (par_size_t c = 0; c < chunks; ++c) scout += local_count[c];
+        detail::csr_concat_chunks(ctx, local, chunks, next);
+        frontier.swap(next);
+        ++level;
+    }
+
+    result.parent.resize(n);
+    for (size_t v = 0; v < n; ++v) result.parent[v] = parent[v].load(std::memory_order_relaxed);
+    return result;
+}
+
+/**
+ * @brief 顺序版本（与 execution::seq 相同）
+ */
+template <typename W>
+csr_bfs_result bfs(const csr_graph<W>& graph, uint32_t source) {
+    return bfs(execution::seq, graph, source);
+}
+
+// ============================================================================
+// delta-stepping 单源最短路
+// ============================================================================
+//
+// Meyer & Sanders 的 delta-stepping：按距离把顶点分进宽度为 delta 的桶，
+// 依次处理编号最小的非空桶；同一桶内的顶点并行松弛出边（原子 min 更新距离），
+// 距离变小的顶点进入对应的桶。每个分块有自己的局部桶，处理完一轮后取所有
+// 分块中最小的非空桶合并为下一轮前沿，轻边使顶点回到当前桶时同一桶会处理多轮。
+// 待处理的顶点距离都在 [当前桶下界, 当前桶上界 + 最大边权) 内，
+// 因此局部桶用长度为 最大边权 / delta + 3 的环形数组。
+// 被取代的旧条目在出桶时按距离过滤掉。
+//
+// 要求边权非负。delta 为 0 时取 最大边权 / 平均出度（至少为最小正权重量级），
+// 桶数约为平均出度；delta 越小越接近 Dijkstra（工作量少、并行度低），
+// 越大越接近 Bellman-Ford。不可达顶点的距离为无穷大（整数权重为最大值）。
+// ============================================================================
+
+template <typename Policy, typename W>
+detail::enable_if_policy_t<Policy, std::vector<W>>
+delta_stepping(Policy&& policy, const csr_graph<W>& graph, uint32_t source, W delta = W(0)) {
+    using detail::par_size_t;
+    using vertex_id = typename csr_graph<W>::vertex_id;
+    const W INF = std::numeric_limits<W>::has_infinity ? std::numeric_limits<W>::infinity()
+                                                       : std::numeric_limits<W>::max();
+    const size_t n = graph.vertex_count();
+    if (source >= n) return std::vector<W>(n, INF);
+
+    auto ctx = detail::make_parallel_context(policy);
+    const auto* offsets = graph.offsets();
+    const auto* targets = graph.targets();
+    const W* weights = graph.weights();
+    const size_t m = graph.edge_count();
+
+    // 最大边权（决定环形桶数与默认 delta）
+    W max_weight = W(1);
+    if (weights && m) {
+        std::vector<W> chunk_max(detail::csr_max_chunks(ctx), W(0));
+        par_size_t chunks = detail::csr_for_chunks(ctx, m, detail::csr_grain_edges, [&](par_size_t c, par_size_t b, par_size_t e) {
+            W mx = W(0);
+            for (par_size_t i = b; i < e; ++i) mx = weights[i] > mx ? weights[i] : mx;
+            chunk_max[c] = mx;
+        });
+        max_weight = W(0);
+        for (par_size_t c = 0; c < chunks; ++c) max_weight = chunk_max[c] > max_weight ? chunk_max[c] : max_weight;
+    }
+    if (!(delta > W(0))) {
+        double avg_degree = n ? static_cast<double>(m) / static_cast<double>(n) : 1.0;
+        double d = static_cast<double>(max_weight) / (avg_degree > 1.0 ? avg_degree : 1.0);
+        delta = static_cast<W>(d);
+        if (!(delta > W(0))) delta = std::numeric_limits<W>::is_integer ? W(1) : static_cast<W>(max_weight > W(0) ? max_weight : W(1));
+    }
+    const size_t ring = static_cast<size_t>(static_cast<double>(max_weight) / static_cast<double>(delta)) + 3;
+    auto bin_of = [delta](W d) { return static_cast<size_t>(d / delta); };
+
+    std::unique_ptr<std::atomic<W>[]> dist(new std::atomic<W>[n]);
+    detail::csr_for_chunks(ctx, n, detail::csr_grain_vertices, [&](par_size_t, par_size_t b, par_size_t e) {
+        for (par_size_t v = b; v < e; ++v) dist[v].store(INF, std::memory_order_relaxed);
+    });
+    dist[source].store(W(0), std::memory_order_relaxed);
+
+    const par_size_t slots = detail::csr_max_chunks(ctx);
+    std::vector<std::vector<std::vector<vertex_id>>> bins(slots, std::vector<std::vector<vertex_id>>(ring));
+    std::vector<std::vector<vertex_id>> gather(slots);
+    std::vector<vertex_id> frontier(1, source);
+    size_t current = 0;
+
+    for (;;) {
+        detail::csr_for_chunks(ctx, frontier.size(), detail::csr_grain_frontier, [&](par_size_t c, par_size_t b, par_size_t e) {
+            auto& my_bins = bins[c];
+            for (par_size_t k = b; k < e; ++k) {
+                vertex_id u = frontier[k];
+                W du = dist[u].load(std::memory_order_relaxed);
+                if (bin_of(du) < current) continue;   // 已在更早的桶中处理过
+                for (auto i = offsets[u]; i < offsets[u + 1]; ++i) {
+                    W nd = du + (weights ? weights[i] : W(1));
+                    vertex_id v = targets[i];
+                    if (detail::atomic_fetch_min(dist[v], nd)) my_bins[bin_of(nd) % ring].push_back(v);
+                }
+            }
+        });
+
+        // 下一个非空桶（编号不小于当前桶）
+        size_t next = static_cast<size_t>(-1);
+        for (size_t b = current; b < current + ring && next == static_cast<size_t>(-1); ++b) {
+            for (par_size_t c = 0; c < slots; ++c) {
+                if (!bins[c][b % ring].empty()) { next = b; break; }
+            }
+        }
+        if (next == static_cast<size_t>(-1)) break;
+        current = next;
+        for (par_size_t c = 0; c < slots; ++c) gather[c].swap(bins[c][current % ring]);
+        detail::csr_concat_chunks(ctx, gather, slots, frontier);
+    }
+
+    std::vector<W> result(n);
+    for (size_t v = 0; v < n; ++v) result[v] = dist[v].load(std::memory_order_relaxed);
+    return result;
+}
+
+/**
+ * @brief 顺序版本（与 execution::seq 相同）
+ */
+template <typename W>
+std::vector<W> delta_stepping(const csr_graph<W>& graph, uint32_t source, W delta = W(0)) {
+    return delta_stepping(execution::seq, graph, source, delta);
+}
+
+// ============================================================================
+// 并行并查集连通分量
+// ============================================================================
+//
+// 无锁并查集：合并时用 CAS 把编号较大的根挂到较小的根下，查找时做路径减半，
+// 因此每棵树的根是分量中编号最小的顶点。对称图采用 Afforest 式的采样：
+// 先只合并每个顶点的第一条边，压缩后抽样找出最大的分量，第二轮跳过该分量
+// 中的顶点（它们的边已无法再连接新的分量，除非经由其他顶点的边）。
+// 有向图按弱连通处理所有边。
+// 返回的分量编号按各分量最小顶点的顺序从 0 连续编号，与
+// find_connected_components(Graph) 的编号方式一致。
+// ============================================================================
+
+namespace detail {
+
+inline uint32_t uf_find(std::atomic<uint32_t>* parent, uint32_t x) noexcept {
+    for (;;) {
+        uint32_t p = parent[x].load(std::memory_order_relaxed);
+        if (p == x) return x;
+        uint32_t gp = parent[p].load(std::memory_order_relaxed);
+        if (gp != p) parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);   // 路径减半
+        x = gp;
+    }
+}
+
+inline void uf_unite(std::atomic<uint32_t>* parent, uint32_t a, uint32_t b) noexcept {
+    for (;;) {
+        a = uf_find(parent, a);
+        b = uf_find(parent, b);
+        if (a == b) return;
+        if (a < b) { uint32_t t = a; a = b; b = t; }
+        uint32_t expected = a;
+        if (parent[a].compare_exchange_weak(expected, b, std::memory_order_relaxed)) return;
+    }
+}
+
+} // namespace detail
+
+template <typename Policy, typename W>
+detail::enable_if_policy_t<Policy, std::vector<uint32_t>>
+find_connected_components(Policy&& policy, const csr_graph<W>& graph) {
+    using detail::par_size_t;
+    const size_t n = graph.vertex_count();
+    auto ctx = detail::make_parallel_context(policy);
+    const auto* offsets = graph.offsets();
+    const auto* targets = graph.targets();
+
+    std::unique_ptr<std::atomic<uint32_t>[]> parent(new std::atomic<uint32_t>[n ? n : 1]);
+    std::atomic<uint32_t>* p = parent.get();
+    detail::csr_for_chunks(ctx, n, detail::csr_grain_vertices, [&](par_size_t, par_size_t b, par_size_t e) {
+        for (par_size_t v = b; v < e; ++v) p[v].store(static_cast<uint32_t>(v), std::memory_order_relaxed);
+    });
+    auto compress = [&] {
+        detail::csr_for_chunks(ctx, n, detail::csr_grain_vertices, [&](par_size_t, par_size_t b, par_size_t e) {
+            for (par_size_t v = b; v < e; ++v) {
+                p[v].store(detail::uf_find(p, static_cast<uint32_t>(v)), std::memory_order_relaxed);
+            }
+        });
+    };
+
+    size_t first_round = 0;
+    uint32_t skip = csr_graph<W>::npos;
+    if (graph.is_symmetric() && n > 0) {
+        // 第一轮：每个顶点的第一条边
+        first_round = 1;
+        detail::csr_for_chunks(ctx, n, detail::csr_grain_vertices, [&](par_size_t, par_size_t b, par_size_t e) {
+            for (par_size_t v = b; v < e; ++v) {
+                if (offsets[v] != offsets[v + 1]) detail::uf_unite(p, static_cast<uint32_t>(v), targets[offsets[v]]);
+            }
+        });
+        compress();
+        // 抽样估计最大分量
+        uint64_t state = 0x9e3779b97f4a7c15ULL;
+        std::vector<std::pair<uint32_t, uint32_t>> counts;   // (根, 次数)，样本很少，线性查找即可
+        for (int s = 0; s < 1024; ++s) {
+            state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+            uint32_t r = p[state % n].load(std::memory_order_relaxed);
+            bool found = false;
+            for (auto& c : counts) if (c.first == r) { ++c.second; found = true; break; }
+            if (!found && counts.size() < 256) counts.push_back({r, 1});
+        }
+        uint32_t best = 0;
+        for (const auto& c : counts) if (c.second > best) { best = c.second; skip = c.first; }
+    }
+
+    // 第二轮（有向图为唯一一轮）：其余的边
+    detail::csr_for_chunks(ctx, n, detail::csr_grain_vertices, [&](par_size_t, par_size_t b, par_size_t e) {
+        for (par_size_t v = b; v < e; ++v) {
+            if (skip != csr_graph<W>::npos && detail::uf_find(p, static_cast<uint32_t>(v)) == skip) continue;
+            for (auto i = offsets[v] + first_round; i < offsets[v + 1]; ++i) {
+                detail::uf_unite(p, static_cast<uint32_t>(v), targets[i]);
+            }
+        }
+    });
+    compress();
+
+    // 按根（分量最小顶点）的顺序连续编号
+    std::vector<uint32_t> id(n);
+    uint32_t next_id = 0;
+    for (size_t v = 0; v < n; ++v) {
+        uint32_t r = p[v].load(std::memory_order_relaxed);
+        id[v] = (r == v) ? next_id++ : id[r];
+    }
+    return id;
+}
+
+/**
+ * @brief 顺序版本（与 execution::seq 相同）
+ */
+template <typename W>
+std::vector<uint32_t> find_connected_components(const csr_graph<W>& graph) {
+    return find_connected_components(execution::seq, graph);
+}
+
+} // namespace zen
+
+#endif // ZEN_ALGORITHMS_CSR_GRAPH_H
@@ -0,0 +1,268 @@
+#ifndef ZEN_ALGORITHMS_EXECUTION_H
+#define ZEN_ALGORITHMS_EXECUTION_H
+
+#include "../base/type_traits.h"
+#include "../iterators/iterator_base.h"
+#include "../threading/pool/thread_pool.h"
+#include "../threading/sync/mutex.h"
+#include "../threading/sync/condition_variable.h"
+#include "../threading/sync/spinlock.h"   // detail::cpu_relax
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace zen {
+
+// ============================================================================
+// 执行策略（execution policy）
+// ============================================================================
+//
+// 与 C++17 <execution> 对应的三种策略：
+// - execution::seq       : 顺序执行，等价于不带策略的重载
+// - execution::par       : 在 zen::thread_pool 上并行执行
+// - execution::par_unseq : 同 par；额外允许在同一线程内向量化（元素操作之间
+//                          不得有同步），目前调度方式与 par 相同
+//
+// 并行策略默认使用进程级的共享线程池（hardware_concurrency 个工作线程），
+// 也可以用 on(pool) 指定线程池、用 with_grain(n) 指定每块最少元素数：
+//   zen::sort(zen::execution::par.on(pool), v.begin(), v.end());
+//
+// 调度方式：区间被切成若干块，调用线程和线程池中的辅助任务通过一个原子计数器
+// 动态领取块；调用线程自己也领取，因此即使线程池全忙（例如在池内任务中嵌套
+// 调用并行算法），算法也能由调用线程独立完成，不会死锁。
+// 元素操作抛出的第一个异常会在调用线程重新抛出（标准库在这种情况下调用
+// std::terminate），其余块在异常后被跳过。
+// ============================================================================
+
+namespace execution {
+
+/**
+ * @brief 顺序执行策略
+ */
+struct sequenced_policy {};
+
+/**
+ * @brief 并行策略的公共部分：线程池与分块粒度
+ */
+template<typename Derived>
+struct parallel_policy_base {
+    thread_pool*        pool  = nullptr;   // nullptr 表示使用默认线程池
+    decltype(sizeof(0)) grain = 0;         // 0 表示由算法自行决定
+
+    /**
+     * @brief 返回在指定线程池上执行的同类策略
+     */
+    Derived on(thread_pool& p) const noexcept {
+        Derived d = static_cast<const Derived&>(*this);
+        d.pool = &p;
+        return d;
+    }
+
+    /**
+     * @brief 返回每块至少 g 个元素的同类策略（元素操作很重时可以调小）
+     */
+    Derived with_grain(decltype(sizeof(0)) g) const noexcept {
+        Derived d = static_cast<const Derived&>(*this);
+        d.grain = g;
+        return d;
+    }
+};
+
+/**
+ * @brief 并行执行策略
+ */
+struct parallel_policy : parallel_policy_base<parallel_policy> {};
+
+/**
+ * @brief 并行 + 向量化执行策略
+ */
+struct parallel_unsequenced_policy : parallel_policy_base<parallel_unsequenced_policy> {};
+
+inline constexpr sequenced_policy            seq{};
+inline constexpr parallel_policy             par{};
+inline constexpr parallel_unsequenced_policy par_unseq{};
+
+} // namespace execution
+
+/**
+ * @brief 判断类型是否为执行策略
+ */
+template<typename T> struct is_execution_policy { static constexpr bool value = false; };
+template<> struct is_execution_policy<execution::sequenced_policy>            { static constexpr bool value = true; };
+template<> struct is_execution_policy<execution::parallel_policy>             { static constexpr bool value = true; };
+template<> struct is_execution_policy<execution::parallel_unsequenced_policy> { static constexpr bool value = true; };
+
+template<typename T>
+inline constexpr bool is_execution_policy_v = is_execution_policy<remove_cvref_t<T>>::value;
+
+namespace detail {
+
+using par_size_t = decltype(sizeof(0));
+
+template<typename T>
+struct is_parallel_policy {
+    static constexpr bool value =
+        is_same_v<remove_cvref_t<T>, execution::parallel_policy> ||
+        is_same_v<remove_cvref_t<T>, execution::parallel_unsequenced_policy>;
+};
+
+// 只有在执行策略作为第一个参数时才参与重载，避免与顺序版本冲突
+template<typename Policy, typename R = void>
+using enable_if_policy_t = enable_if_t<is_execution_policy_v<Policy>, R>;
+
+/**
+ * @brief 进程级默认线程池（首次使用时创建）
+ */
+inline thread_pool& default_parallel_pool() {
+    static thread_pool pool;
+    return pool;
+}
+
+/**
+ * @brief 并行调度的参数：线程池、参与线程数、粒度
+ */
+struct parallel_context {
+    thread_pool* pool    = nullptr;
+    par_size_t   workers = 1;      // 线程池线程数 + 调用线程
+    par_size_t   grain   = 0;
+
+    par_size_t grain_or(par_size_t fallback) const noexcept {
+        return grain ? grain : fallback;
+    }
+};
+
+template<typename Policy>
+parallel_context make_parallel_context(const Policy& policy) {
+    parallel_context ctx;
+    if constexpr (is_parallel_policy<Policy>::value) {
+        ctx.pool    = policy.pool ? policy.pool : &default_parallel_pool();
+        ctx.workers = ctx.pool->size() + 1;
+        ctx.grain   = policy.grain;
+    }
+    return ctx;
+}
+
+/**
+ * @brief 按输入规模与参与线程数确定块数
+ *
+ * 每个线程约 4 块，块较多时负载更均衡；但每块不少于 grain 个元素，
+ * 以免调度开销超过计算本身。n < 2 * grain 时只有一块（直接顺序执行）。
+ */
+inline par_size_t parallel_chunk_count(par_size_t n, par_size_t workers, par_size_t grain) {
+    if (grain == 0) grain = 1;
+    if (workers <= 1 || n < 2 * grain) return 1;
+    par_size_t by_grain   = n / grain;
+    par_size_t by_workers = workers * 4;
+    return by_grain < by_workers ? by_grain : by_workers;
+}
+
+/**
+ * @brief 第 i 块（共 chunks 块）覆盖的下标区间起点，各块长度至多相差 1
+ */
+inline par_size_t parallel_chunk_begin(par_size_t n, par_size_t chunks, par_size_t i) {
+    par_size_t base = n / chunks, extra = n % chunks;
+    return i * base + (i < extra ? i : extra);
+}
+
+/**
+ * @brief 一次并行调用的共享状态
+ *
+ * 由 shared_ptr 持有：线程池中的辅助任务可能在算法返回之后才开始运行，
+ * 那时它领取不到块，只会释放自己的引用而不会触碰调用方栈上的数据。
+ */
+struct parallel_job {
+    std::atomic<par_size_t> next{0};
+    std::atomic<par_size_t> done{0};
+    std::atomic<bool>       failed{false};
+    par_size_t              chunks = 0;
+    void*                   body   = nullptr;
+    void (*invoke)(void* body, par_size_t chunk) = nullptr;
+
+    std::exception_ptr error;
+    mutex              error_mutex;
+    mutex              done_mutex;
+    condition_variable done_cond;
+    bool               finished = false;
+
+    /**
+     * @brief 领取并执行块，直到没有剩余块
+     */
+    void run() {
+        par_size_t i;
+        while ((i = next.fetch_add(1, std::memory_order_relaxed)) < chunks) {
+            if (!failed.load(std::memory_order_relaxed)) {
+                try {
+                    invoke(body, i);
+                } catch (...) {
+                    lock_guard<mutex> lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+                lock_guard<mutex> lock(done_mutex);
+                finished = true;
+                done_cond.notify_all();
+            }
+        }
+    }
+
+    /**
+     * @brief 等待所有已领取的块完成（先短暂自旋，再挂起）
+     */
+    void wait() {
+        for (int spin = 0; spin < 1024; ++spin) {
+            if (done.load(std::memory_order_acquire) == chunks) return;
+            detail::cpu_relax();
+        }
+        unique_lock<mutex> lock(done_mutex);
+        done_cond.wait(lock, [this] { return finished; });
+    }
+};
+
+/**
+ * @brief 并行执行 body(chunk)，chunk ∈ [0, chunks)
+ *
+ * chunks == 1 或没有线程池时直接在调用线程执行。
+ */
+template<typename Body>
+void parallel_run_chunks(const parallel_context& ctx, par_size_t chunks, Body& body) {
+    if (chunks == 0) return;
+    if (chunks == 1 || !ctx.pool || ctx.workers <= 1) {
+        for (par_size_t i = 0; i < chunks; ++i) body(i);
+        return;
+    }
+
+    auto job = std::make_shared<parallel_job>();
+    job->chunks = chunks;
+    job->body   = &body;
+    job->invoke = [](void* b, par_size_t i) { (*static_cast<Body*>(b))(i); };
+
+    par_size_t helpers = (ctx.workers - 1 < chunks - 1) ? ctx.workers - 1 : chunks - 1;
+    for (par_size_t h = 0; h < helpers; ++h) {
+        ctx.pool->submit_void([job] { job->run(); });
+    }
+
+    job->run();
+    job->wait();
+
+    if (job->error) std::rethrow_exception(job->error);
+}
+
+/**
+ * @brief 把 [0, n) 切块后并行执行 body(begin, end)
+ */
+template<typename Body>
+void parallel_for_range(const parallel_context& ctx, par_size_t n, par_size_t grain, Body body) {
+    par_size_t chunks = parallel_chunk_count(n, ctx.workers, grain);
+    auto chunk_body = [&](par_size_t i) {
+        body(parallel_chunk_begin(n, chunks, i), parallel_chunk_begin(n, chunks, i + 1));
+    };
+    parallel_run_chunks(ctx, chunks, chunk_body);
+}
+
+} // namespace detail
+
+} // namespace zen
+
+#endif // ZEN_ALGORITHMS_EXECUTION_H
@@ -12,10 +12,12 @@
 #include <queue>
 #include <stack>
 #include <limits>
+#include <cstdint>
 #include <unordered_map>
 #include <functional>
 #include <type_traits>
 #include "../base/type_traits.h"
+#include "../containers/adapter/priority_queue.h"
 
 namespace zen {
 
@@ -319,47 +321,53 @@ std::vector<size_t> dfs_order(const Graph<T, WeightType>& graph, size_t start) {
 // 最短路径算法 (Dijkstra)
 // ============================================================================
 
+namespace detail {
+
 /**
- * @brief Dijkstra 最短路径算法
+ * @brief 距离的「无穷大」：浮点为 infinity，整数为最大值
+ *
+ * numeric_limits<int>::infinity() 为 0，整数权重不能直接用它作为未到达标记。
  */
-template <typename T, typename WeightType = double>
-std::vector<typename Graph<T, WeightType>::Weight> dijkstra(
-    const Graph<T, WeightType>& graph,
-    size_t start
-) {
-    using Weight = typename Graph<T, WeightType>::Weight;
-    const Weight INF = std::numeric_limits<Weight>::infinity();
+template <typename Weight>
+constexpr Weight graph_infinity() noexcept {
+    return std::numeric_limits<Weight>::has_infinity ? std::numeric_limits<Weight>::infinity()
+                                                     : std::numeric_limits<Weight>::max();
+}
+
+/**
+ * @brief 以 4 叉 indexed_heap 运行 Dijkstra，parent 非空时记录前驱
+ *
+ * 每个顶点在堆中至多一项：松弛成功时 push_or_decrease，不会压入重复项。
+ * 复杂度 O((n + m) log n)。
+ */
+template <typename T, typename WeightType>
+std::vector<WeightType> dijkstra_indexed(const Graph<T, WeightType>& graph, size_t start,
+                                         std::vector<size_t>* parent) {
+    using Weight = WeightType;
+    const Weight INF = graph_infinity<Weight>();
 
     size_t n = graph.node_count();
     std::vector<Weight> dist(n, INF);
-    std::vector<bool> visited(n, false);
+    if (parent) parent->assign(n, static_cast<size_t>(-1));
+    if (start >= n) return dist;
 
+    indexed_heap<Weight> heap(n);
     dist[start] = 0;
+    heap.push(start, 0);
 
-    for (size_t i = 0; i < n; ++i) {
-        // 找到未访问的最小距离节点
-        size_t u = n;
-        Weight min_dist = INF;
-
-        for (size_t j = 0; j < n; ++j) {
-            if (!visited[j] && dist[j] < min_dist) {
-                min_dist = dist[j];
-                u = j;
-            }
-        }
-
-        if (u == n || dist[u] == INF) {
-            break;
-        }
-
-        visited[u] = true;
+    while (!heap.empty()) {
+        size_t u = heap.top();
+        Weight du = heap.top_key();
+        heap.pop();
 
         // 松弛操作
         for (const auto& edge : graph.neighbors(u)) {
             size_t v = edge.first;
-            Weight weight = edge.second;
-            if (dist[u] + weight < dist[v]) {
-                dist[v] = dist[u] + weight;
+            Weight nd = du + edge.second;
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                if (parent) (*parent)[v] = u;
+                heap.push_or_decrease(v, nd);
             }
         }
     }
@@ -367,6 +375,22 @@ std::vector<typename Graph<T, WeightType>::Weight> dijkstra(
     return dist;
 }
 
+} // namespace detail
+
+/**
+ * @brief Dijkstra 最短路径算法
+ * @return 各节点到 start 的距离，不可达为 infinity（整数权重为最大值）
+ *
+ * 权重需非负。使用带位置索引的 4 叉堆，堆中没有重复项。
+ */
+template <typename T, typename WeightType = double>
+std::vector<typename Graph<T, WeightType>::Weight> dijkstra(
+    const Graph<T, WeightType>& graph,
+    size_t start
+) {
+    return detail::dijkstra_indexed(graph, start, nullptr);
+}
+
 /**
  * @brief Dijkstra 最短路径（返回路径）
  */
@@ -377,93 +401,94 @@ std::vector<size_t> dijkstra_path(
     size_t end
 ) {
     using Weight = typename Graph<T, WeightType>::Weight;
-    const Weight INF = std::numeric_limits<Weight>::infinity();
 
-    size_t n = graph.node_count();
-    std::vector<Weight> dist(n, INF);
-    std::vector<size_t> parent(n, static_cast<size_t>(-1));
-    std::vector<bool> visited(n, false);
+    std::vector<size_t> parent;
+    std::vector<Weight> dist = detail::dijkstra_indexed(graph, start, &parent);
 
-    dist[start] = 0;
+    if (end >= dist.size() || dist[end] == detail::graph_infinity<Weight>()) {
+        return {};
+    }
 
-    for (size_t i = 0; i < n; ++i) {
-        size_t u = n;
-        Weight min_dist = INF;
+    std::vector<size_t> path;
+    for (size_t v = end; v != static_cast<size_t>(-1); v = parent[v]) {
+        path.push_back(v);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
 
-        for (size_t j = 0; j < n; ++j) {
-            if (!visited[j] && dist[j] < min_dist) {
-                min_dist = dist[j];
-                u = j;
-            }
-        }
+/**
+ * @brief 整数权重的 Dijkstra（单调基数堆）
+ * @return 各节点到 start 的距离，不可达为 WeightType 的最大值
+ *
+ * 权重需为非负整数。radix_heap 按位模式分桶，push 为 O(1)，没有元素间比较；
+ * 它不支持 decrease_key，松弛时直接压入新项，弹出时跳过键已过期的项。
+ * 路网这类边权范围不大的图上通常比比较堆更快。
+ */
+template <typename T, typename WeightType>
+std::vector<WeightType> dijkstra_radix(const Graph<T, WeightType>& graph, size_t start) {
+    static_assert(std::is_integral<WeightType>::value, "dijkstra_radix requires integer weights");
+    using Weight = WeightType;
+    const Weight INF = detail::graph_infinity<Weight>();
 
-        if (u == n || dist[u] == INF) {
-            break;
-        }
+    size_t n = graph.node_count();
+    std::vector<Weight> dist(n, INF);
+    if (start >= n) return dist;
 
-        visited[u] = true;
+    radix_heap<uint64_t, size_t> heap;
+    dist[start] = 0;
+    heap.push(0, start);
+
+    while (!heap.empty()) {
+        uint64_t key = heap.top_key();
+        size_t u = heap.top_value();
+        heap.pop();
+        if (key != static_cast<uint64_t>(dist[u])) continue;  // 过期项
 
         for (const auto& edge : graph.neighbors(u)) {
             size_t v = edge.first;
-            Weight weight = edge.second;
-            if (dist[u] + weight < dist[v]) {
-                dist[v] = dist[u] + weight;
-                parent[v] = u;
+            Weight nd = dist[u] + edge.second;
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                heap.push(static_cast<uint64_t>(nd), v);
             }
         }
     }
 
-    if (dist[end] == INF) {
-        return {};
-    }
-
-    std::vector<size_t> path;
-    for (size_t v = end; v != static_cast<size_t>(-1); v = parent[v]) {
-        path.push_back(v);
-    }
-    std::reverse(path.begin(), path.end());
-    return path;
+    return dist;
 }
 
 // ============================================================================
-// 最小生成树算法 (Prim 和 Kruskal)
+// 最小生成树算法 (Prim)
 // ============================================================================
 
 /**
  * @brief Prim 最小生成树算法
+ * @return 包含节点 0 的连通分量的最小生成树总权重
+ *
+ * 与 Dijkstra 相同，以 indexed_heap 维护各节点到树的最小边权，O((n + m) log n)。
  */
 template <typename T, typename WeightType = double>
 typename Graph<T, WeightType>::Weight prim_mst(
     const Graph<T, WeightType>& graph
 ) {
     using Weight = typename Graph<T, WeightType>::Weight;
-    const Weight INF = std::numeric_limits<Weight>::infinity();
+    const Weight INF = detail::graph_infinity<Weight>();
 
     size_t n = graph.node_count();
     if (n == 0) return 0;
 
     std::vector<Weight> key(n, INF);
     std::vector<bool> in_mst(n, false);
+    indexed_heap<Weight> heap(n);
 
     key[0] = 0;
+    heap.push(0, 0);
     Weight total_weight = 0;
 
-    for (size_t count = 0; count < n; ++count) {
-        // 找到不在 MST 中且 key 最小的节点
-        size_t u = n;
-        Weight min_key = INF;
-
-        for (size_t v = 0; v < n; ++v) {
-            if (!in_mst[v] && key[v] < min_key) {
-                min_key = key[v];
-                u = v;
-            }
-        }
-
-        if (u == n || min_key == INF) {
-            break;
-        }
-
+    while (!heap.empty()) {
+        size_t u = heap.top();
+        heap.pop();
         in_mst[u] = true;
         total_weight += key[u];
 
@@ -473,6 +498,7 @@ typename Graph<T, WeightType>::Weight prim_mst(
             Weight weight = edge.second;
             if (!in_mst[v] && weight < key[v]) {
                 key[v] = weight;
+                heap.push_or_decrease(v, weight);
             }
         }
     }
@@ -2,9 +2,11 @@
 #define ZEN_ALGORITHMS_NUMERIC_H
 
 #include "../base/type_traits.h"
+#include "../utility/swap.h"
 #include "../utility/pair.h"
 #include "../iterators/iterator_base.h"
 #include "comparators.h"
+#include "numeric_simd.h"
 
 namespace zen {
 
@@ -17,6 +19,9 @@ namespace zen {
  *
  * 复杂度：O(n)
  *
+ * 严格按从左到右求值，结果可逐位复现；float / double 大数组不关心求和顺序时，
+ * 用 reduce 或 zen::sum（numeric_simd.h，向量化多累加器）快数倍。
+ *
  * @tparam InputIt  输入迭代器
  * @tparam T        初始值/累加器类型
  * @tparam BinaryOp 二元操作符
@@ -46,6 +51,8 @@ T accumulate(InputIt first, InputIt last, T init) {
  * @brief 内积：对应元素相乘后累加
  *
  * result = init + sum(a[i] * b[i])
+ *
+ * 严格按从左到右求值；向量化版本见 transform_reduce / zen::dot。
  */
 template<typename InputIt1, typename InputIt2, typename T>
 T inner_product(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init) {
@@ -110,6 +117,8 @@ OutputIt adjacent_difference(InputIt first, InputIt last, OutputIt d_first) {
  *
  * s[0] = a[0]
  * s[i] = s[i-1] + a[i]
+ *
+ * 严格按从左到右求值；向量化版本见 inclusive_scan / zen::prefix_sum。
  */
 template<typename InputIt, typename OutputIt, typename BinaryOp>
 OutputIt partial_sum(InputIt first, InputIt last, OutputIt d_first, BinaryOp op) {
@@ -134,6 +143,137 @@ OutputIt partial_sum(InputIt first, InputIt last, OutputIt d_first) {
     return zen::partial_sum(first, last, d_first, [](const auto& a, const auto& b){ return a + b; });
 }
 
+// ============================================================================
+// 归约与扫描（reduce / transform_reduce / inclusive_scan）
+// ============================================================================
+//
+// 与 accumulate / partial_sum 的区别：不保证左结合的求值顺序，只要求 op
+// 满足结合律，因此带执行策略的版本（parallel.h）可以分块并行计算。
+// 这里的顺序版本按从左到右求值；例外是 float / double 指针区间上的默认加法 /
+// 内积 / 前缀和，会转到 numeric_simd.h 的多累加器向量内核（结果可能相差若干 ulp）。
+
+namespace detail {
+
+/**
+ * @brief It 是否为指向 float / double 的指针（连续区间，可走向量内核）
+ */
+template<typename It>
+struct simd_float_pointer {
+    static constexpr bool value = false;
+};
+
+template<typename T>
+struct simd_float_pointer<T*> {
+    using element = remove_cv_t<T>;
+    static constexpr bool value = is_same_v<element, float> || is_same_v<element, double>;
+};
+
+/** InputIt 为 float / double 指针且累加类型 T 与元素类型相同 */
+template<typename InputIt, typename T>
+constexpr bool simd_reducible() {
+    if constexpr (simd_float_pointer<InputIt>::value) {
+        return is_same_v<typename simd_float_pointer<InputIt>::element, T>;
+    } else {
+        return false;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief 归约：init op a[0] op a[1] op ...
+ */
+template<typename InputIt, typename T, typename BinaryOp>
+T reduce(InputIt first, InputIt last, T init, BinaryOp op) {
+    for (; first != last; ++first) {
+        init = op(zen::move(init), *first);
+    }
+    return init;
+}
+
+template<typename InputIt, typename T>
+T reduce(InputIt first, InputIt last, T init) {
+    if constexpr (detail::simd_reducible<InputIt, T>()) {
+        return init + zen::sum(first, static_cast<size_t>(last - first));
+    } else {
+        return zen::reduce(first, last, zen::move(init), [](const T& a, const T& b){ return a + b; });
+    }
+}
+
+template<typename InputIt>
+typename zen::iterator_traits<InputIt>::value_type reduce(InputIt first, InputIt last) {
+    using value_type = typename zen::iterator_traits<InputIt>::value_type;
+    return zen::reduce(first, last, value_type{});
+}
+
+/**
+ * @brief 先逐元素变换再归约：init op t(a[0]) op t(a[1]) ...
+ */
+template<typename InputIt, typename T, typename BinaryOp, typename UnaryOp>
+T transform_reduce(InputIt first, InputIt last, T init, BinaryOp reduce_op, UnaryOp transform_op) {
+    for (; first != last; ++first) {
+        init = reduce_op(zen::move(init), transform_op(*first));
+    }
+    return init;
+}
+
+/**
+ * @brief 两个区间逐对变换后归约（默认即内积）
+ */
+template<typename InputIt1, typename InputIt2, typename T, typename BinaryOp1, typename BinaryOp2>
+T transform_reduce(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init,
+                   BinaryOp1 reduce_op, BinaryOp2 transform_op) {
+    for (; first1 != last1; ++first1, ++first2) {
+        init = reduce_op(zen::move(init), transform_op(*first1, *first2));
+    }
+    return init;
+}
+
+template<typename InputIt1, typename InputIt2, typename T>
+T transform_reduce(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init) {
+    if constexpr (detail::simd_reducible<InputIt1, T>() && detail::simd_reducible<InputIt2, T>()) {
+        return init + zen::dot(first1, first2, static_cast<size_t>(last1 - first1));
+    } else {
+        return zen::transform_reduce(first1, last1, first2, zen::move(init),
+                                     [](const T& a, const T& b){ return a + b; },
+                                     [](const auto& a, const auto& b){ return a * b; });
+    }
+}
+
+/**
+ * @brief 包含式扫描：d[i] = init op a[0] op ... op a[i]
+ *
+ * 与 partial_sum 相同，但带初值的重载允许累加类型与元素类型不同。
+ */
+template<typename InputIt, typename OutputIt, typename BinaryOp, typename T>
+OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt d_first, BinaryOp op, T init) {
+    for (; first != last; ++first, ++d_first) {
+        init = op(zen::move(init), *first);
+        *d_first = init;
+    }
+    return d_first;
+}
+
+template<typename InputIt, typename OutputIt, typename BinaryOp>
+OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt d_first, BinaryOp op) {
+    return zen::partial_sum(first, last, d_first, op);
+}
+
+template<typename InputIt, typename OutputIt>
+OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt d_first) {
+    if constexpr (detail::simd_float_pointer<InputIt>::value && detail::simd_float_pointer<OutputIt>::value) {
+        using element = typename detail::simd_float_pointer<InputIt>::element;
+        if constexpr (is_same_v<OutputIt, element*>) {
+            // d_first 可以等于 first（原地扫描）
+            return zen::prefix_sum(first, d_first, static_cast<size_t>(last - first));
+        } else {
+            return zen::partial_sum(first, last, d_first);
+        }
+    } else {
+        return zen::partial_sum(first, last, d_first);
+    }
+}
+
 // ============================================================================
 // 计数（iota）- 填充递增序列
 // ============================================================================
@@ -0,0 +1,810 @@
+#ifndef ZEN_ALGORITHMS_NUMERIC_SIMD_H
+#define ZEN_ALGORITHMS_NUMERIC_SIMD_H
+
+#include "../base/cpu_features.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace zen {
+
+// ============================================================================
+// 连续 float / double 数组上的向量化数值内核
+// ============================================================================
+//
+// 面向大块遥测数据的求和、点积、极值、前缀和与均值 / 方差，参数为指针 + 长度：
+// - sum(p, n, mode)        : 求和，mode 选择 fast / kahan / pairwise
+// - dot(a, b, n)           : 点积
+// - minmax_value(p, n)     : 同时求最小值与最大值
+// - prefix_sum(in, out, n) : 包含式前缀和（in 与 out 可以相同）
+// - compute_moments(p, n)  : 一次读入求均值与方差（返回可合并的 moments）
+//
+// 归约使用多个独立累加器（AVX2 下 double 为 4 个 4 路向量，共 16 路部分和），
+// 加法延迟被流水线掩盖，大数组上可以跑满内存带宽。代价是求和顺序与逐个累加不同，
+// 浮点结果可能相差若干 ulp；需要逐位复现从左到右结果的场合请用 accumulate。
+//
+// 求和模式：
+// - fast     : 多累加器直接相加，误差随 n / 路数线性增长
+// - kahan    : 每一路做 Kahan 补偿求和，误差与 n 基本无关，约为 fast 的 2~4 倍耗时
+// - pairwise : 按 1024 个元素分块（块内多累加器），块间两两递归相加，
+//              误差按 log(n) 增长，速度与 fast 相当
+// kahan 依赖浮点运算不被重排，不要在 -ffast-math 下使用。
+//
+// 运行期按 cpu_features() 选择 AVX2 / SSE2 / 通用实现，选择结果只计算一次；
+// detail 中的各级实现也可以直接调用（测试与基准用来覆盖每一级）。
+// ============================================================================
+
+/**
+ * @brief 求和模式
+ */
+enum class summation { fast, kahan, pairwise };
+
+/**
+ * @brief 可合并的均值 / 方差累积量（Welford）
+ *
+ * count 个样本的均值 mean 与离差平方和 m2 = Σ(x - mean)²。
+ * add 为 Welford 单点更新，merge 为 Chan 等人的两组合并公式，
+ * 分块 / 分线程统计后合并的结果与整体一次统计在数值上等价。
+ */
+struct moments {
+    size_t count = 0;
+    double mean  = 0.0;
+    double m2    = 0.0;
+
+    void add(double x) noexcept {
+        ++count;
+        double delta = x - mean;
+        mean += delta / static_cast<double>(count);
+        m2 += delta * (x - mean);
+    }
+
+    void merge(const moments& o) noexcept {
+        if (o.count == 0) return;
+        if (count == 0) {
+            *this = o;
+            return;
+        }
+        double n1 = static_cast<double>(count), n2 = static_cast<double>(o.count);
+        double n = n1 + n2;
+        double delta = o.mean - mean;
+        mean += delta * (n2 / n);
+        m2 += o.m2 + delta * delta * (n1 * n2 / n);
+        count += o.count;
+    }
+
+    /** 样本方差（除以 n - 1） */
+    double variance() const noexcept {
+        return count > 1 ? m2 / static_cast<double>(count - 1) : 0.0;
+    }
+
+    /** 总体方差（除以 n） */
+    double population_variance() const noexcept {
+        return count > 0 ? m2 / static_cast<double>(count) : 0.0;
+    }
+};
+
+/**
+ * @brief minmax_value 的结果
+ */
+template<typename T>
+struct minmax_result {
+    T lo;
+    T hi;
+};
+
+namespace detail {
+
+// pairwise 求和的叶子块大小；compute_moments 的分块大小（块留在 L1 中读第二遍）
+static constexpr size_t pairwise_block = 1024;
+static constexpr size_t moments_block  = 2048;
+
+// 数据按 shift 平移后的一阶、二阶和：Σ(x - shift)、Σ(x - shift)²（以 double 累加）
+struct shifted_sums {
+    double s1 = 0.0;
+    double s2 = 0.0;
+};
+
+// ----------------------------------------------------------------------------
+// 通用实现（任意平台；也用于向量实现的尾部）
+// ----------------------------------------------------------------------------
+
+template<typename T>
+T sum_generic(const T* p, size_t n) {
+    T a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        a0 += p[i];
+        a1 += p[i + 1];
+        a2 += p[i + 2];
+        a3 += p[i + 3];
+    }
+    for (; i < n; ++i) a0 += p[i];
+    return (a0 + a1) + (a2 + a3);
+}
+
+// Kahan 一步：c 保存上一次加法丢掉的低位（取负），先从下一个加数里扣回
+template<typename T>
+inline void kahan_add(T& s, T& c, T x) {
+    T y = x - c;
+    T t = s + y;
+    c = (t - s) - y;
+    s = t;
+}
+
+template<typename T>
+T sum_kahan_generic(const T* p, size_t n) {
+    T s = 0, c = 0;
+    for (size_t i = 0; i < n; ++i) kahan_add(s, c, p[i]);
+    return s;
+}
+
+template<typename T>
+T dot_generic(const T* a, const T* b, size_t n) {
+    T a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        a0 += a[i] * b[i];
+        a1 += a[i + 1] * b[i + 1];
+        a2 += a[i + 2] * b[i + 2];
+        a3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; ++i) a0 += a[i] * b[i];
+    return (a0 + a1) + (a2 + a3);
+}
+
+// lo / hi 为输入输出：与已有的 lo / hi 合并；NaN 不满足比较，自然被跳过
+template<typename T>
+void minmax_generic(const T* p, size_t n, T& lo, T& hi) {
+    for (size_t i = 0; i < n; ++i) {
+        if (p[i] < lo) lo = p[i];
+        if (p[i] > hi) hi = p[i];
+    }
+}
+
+// 返回最后一个前缀和（作为下一段的进位）
+template<typename T>
+T prefix_sum_generic(const T* in, T* out, size_t n, T carry) {
+    for (size_t i = 0; i < n; ++i) {
+        carry += in[i];
+        out[i] = carry;
+    }
+    return carry;
+}
+
+template<typename T>
+shifted_sums shifted_sums_generic(const T* p, size_t n, double shift) {
+    shifted_sums r;
+    for (size_t i = 0; i < n; ++i) {
+        double d = static_cast<double>(p[i]) - shift;
+        r.s1 += d;
+        r.s2 += d * d;
+    }
+    return r;
+}
+
+#if ZEN_HAVE_SSE2
+
+// ----------------------------------------------------------------------------
+// SSE2：double 2 路、float 4 路，每种归约 4 个累加器
+// ----------------------------------------------------------------------------
+
+inline double hsum_sse2(__m128d v) {
+    return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+inline float hsum_sse2(__m128 v) {
+    __m128 h = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_add_ss(h, _mm_shuffle_ps(h, h, 1)));
+}
+
+inline double sum_sse2(const double* p, size_t n) {
+    __m128d a0 = _mm_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        a0 = _mm_add_pd(a0, _mm_loadu_pd(p + i));
+        a1 = _mm_add_pd(a1, _mm_loadu_pd(p + i + 2));
+        a2 = _mm_add_pd(a2, _mm_loadu_pd(p + i + 4));
+        a3 = _mm_add_pd(a3, _mm_loadu_pd(p + i + 6));
+    }
+    return hsum_sse2(_mm_add_pd(_mm_add_pd(a0, a1), _mm_add_pd(a2, a3))) + sum_generic(p + i, n - i);
+}
+
+inline float sum_sse2(const float* p, size_t n) {
+    __m128 a0 = _mm_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        a0 = _mm_add_ps(a0, _mm_loadu_ps(p + i));
+        a1 = _mm_add_ps(a1, _mm_loadu_ps(p + i + 4));
+        a2 = _mm_add_ps(a2, _mm_loadu_ps(p + i + 8));
+        a3 = _mm_add_ps(a3, _mm_loadu_ps(p + i + 12));
+    }
+    return hsum_sse2(_mm_add_ps(_mm_add_ps(a0, a1), _mm_add_ps(a2, a3))) + sum_generic(p + i, n - i);
+}
+
+// 两组独立的 (s, c) 补偿累加器，最后把各路的 s - c 再做一遍补偿求和
+inline double sum_kahan_sse2(const double* p, size_t n) {
+    __m128d s0 = _mm_setzero_pd(), c0 = s0, s1 = s0, c1 = s0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128d y0 = _mm_sub_pd(_mm_loadu_pd(p + i), c0);
+        __m128d y1 = _mm_sub_pd(_mm_loadu_pd(p + i + 2), c1);
+        __m128d t0 = _mm_add_pd(s0, y0);
+        __m128d t1 = _mm_add_pd(s1, y1);
+        c0 = _mm_sub_pd(_mm_sub_pd(t0, s0), y0);
+        c1 = _mm_sub_pd(_mm_sub_pd(t1, s1), y1);
+        s0 = t0;
+        s1 = t1;
+    }
+    alignas(16) double s[4], c[4];
+    _mm_store_pd(s, s0);
+    _mm_store_pd(s + 2, s1);
+    _mm_store_pd(c, c0);
+    _mm_store_pd(c + 2, c1);
+    double total = 0, comp = 0;
+    for (int k = 0; k < 4; ++k) {
+        kahan_add(total, comp, s[k] - c[k]);
+    }
+    for (; i < n; ++i) kahan_add(total, comp, p[i]);
+    return total;
+}
+
+inline float sum_kahan_sse2(const float* p, size_t n) {
+    __m128 s0 = _mm_setzero_ps(), c0 = s0, s1 = s0, c1 = s0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128 y0 = _mm_sub_ps(_mm_loadu_ps(p + i), c0);
+        __m128 y1 = _mm_sub_ps(_mm_loadu_ps(p + i + 4), c1);
+        __m128 t0 = _mm_add_ps(s0, y0);
+        __m128 t1 = _mm_add_ps(s1, y1);
+        c0 = _mm_sub_ps(_mm_sub_ps(t0, s0), y0);
+        c1 = _mm_sub_ps(_mm_sub_ps(t1, s1), y1);
+        s0 = t0;
+        s1 = t1;
+    }
+    alignas(16) float s[8], c[8];
+    _mm_store_ps(s, s0);
+    _mm_store_ps(s + 4, s1);
+    _mm_store_ps(c, c0);
+    _mm_store_ps(c + 4, c1);
+    float total = 0, comp = 0;
+    for (int k = 0; k < 8; ++k) {
+        kahan_add(total, comp, s[k] - c[k]);
+    }
+    for (; i < n; ++i) kahan_add(total, comp, p[i]);
+    return total;
+}
+
+inline double dot_sse2(const double* a, const double* b, size_t n) {
+    __m128d a0 = _mm_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        a0 = _mm_add_pd(a0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        a1 = _mm_add_pd(a1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+        a2 = _mm_add_pd(a2, _mm_mul_pd(_mm_loadu_pd(a + i + 4), _mm_loadu_pd(b + i + 4)));
+        a3 = _mm_add_pd(a3, _mm_mul_pd(_mm_loadu_pd(a + i + 6), _mm_loadu_pd(b + i + 6)));
+    }
+    return hsum_sse2(_mm_add_pd(_mm_add_pd(a0, a1), _mm_add_pd(a2, a3))) + dot_generic(a + i, b + i, n - i);
+}
+
+inline float dot_sse2(const float* a, const float* b, size_t n) {
+    __m128 a0 = _mm_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+        a2 = _mm_add_ps(a2, _mm_mul_ps(_mm_loadu_ps(a + i + 8), _mm_loadu_ps(b + i + 8)));
+        a3 = _mm_add_ps(a3, _mm_mul_ps(_mm_loadu_ps(a + i + 12), _mm_loadu_ps(b + i + 12)));
+    }
+    return hsum_sse2(_mm_add_ps(_mm_add_ps(a0, a1), _mm_add_ps(a2, a3))) + dot_generic(a + i, b + i, n - i);
+}
+
+// min(v, lo)：任一操作数为 NaN 时返回第二个操作数，数据中的 NaN 因此被跳过
+inline void minmax_sse2(const double* p, size_t n, double& lo, double& hi) {
+    __m128d l0 = _mm_set1_pd(lo), l1 = l0, h0 = _mm_set1_pd(hi), h1 = h0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128d v0 = _mm_loadu_pd(p + i), v1 = _mm_loadu_pd(p + i + 2);
+        l0 = _mm_min_pd(v0, l0);
+        l1 = _mm_min_pd(v1, l1);
+        h0 = _mm_max_pd(v0, h0);
+        h1 = _mm_max_pd(v1, h1);
+    }
+    __m128d l = _mm_min_pd(l0, l1), h = _mm_max_pd(h0, h1);
+    lo = _mm_cvtsd_f64(_mm_min_sd(l, _mm_unpackhi_pd(l, l)));
+    hi = _mm_cvtsd_f64(_mm_max_sd(h, _mm_unpackhi_pd(h, h)));
+    minmax_generic(p + i, n - i, lo, hi);
+}
+
+inline void minmax_sse2(const float* p, size_t n, float& lo, float& hi) {
+    __m128 l0 = _mm_set1_ps(lo), l1 = l0, h0 = _mm_set1_ps(hi), h1 = h0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128 v0 = _mm_loadu_ps(p + i), v1 = _mm_loadu_ps(p + i + 4);
+        l0 = _mm_min_ps(v0, l0);
+        l1 = _mm_min_ps(v1, l1);
+        h0 = _mm_max_ps(v0, h0);
+        h1 = _mm_max_ps(v1, h1);
+    }
+    __m128 l = _mm_min_ps(l0, l1), h = _mm_max_ps(h0, h1);
+    l = _mm_min_ps(l, _mm_movehl_ps(l, l));
+    h = _mm_max_ps(h, _mm_movehl_ps(h, h));
+    lo = _mm_cvtss_f32(_mm_min_ss(l, _mm_shuffle_ps(l, l, 1)));
+    hi = _mm_cvtss_f32(_mm_max_ss(h, _mm_shuffle_ps(h, h, 1)));
+    minmax_generic(p + i, n - i, lo, hi);
+}
+
+// 寄存器内扫描：x + (x 左移 1 路) [+ 左移 2 路]，再加上前一段的进位（广播的最后一路）
+inline double prefix_sum_sse2(const double* in, double* out, size_t n, double carry) {
+    __m128d c = _mm_set1_pd(carry);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d x = _mm_loadu_pd(in + i);
+        x = _mm_add_pd(x, _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8)));
+        x = _mm_add_pd(x, c);
+        _mm_storeu_pd(out + i, x);
+        c = _mm_unpackhi_pd(x, x);
+    }
+    return prefix_sum_generic(in + i, out + i, n - i, _mm_cvtsd_f64(c));
+}
+
+inline float prefix_sum_sse2(const float* in, float* out, size_t n, float carry) {
+    __m128 c = _mm_set1_ps(carry);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x = _mm_loadu_ps(in + i);
+        x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)));
+        x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8)));
+        x = _mm_add_ps(x, c);
+        _mm_storeu_ps(out + i, x);
+        c = _mm_shuffle_ps(x, x, 0xFF);
+    }
+    return prefix_sum_generic(in + i, out + i, n - i, _mm_cvtss_f32(c));
+}
+
+inline shifted_sums shifted_sums_sse2(const double* p, size_t n, double shift) {
+    __m128d m = _mm_set1_pd(shift);
+    __m128d s0 = _mm_setzero_pd(), s1 = s0, q0 = s0, q1 = s0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128d d0 = _mm_sub_pd(_mm_loadu_pd(p + i), m);
+        __m128d d1 = _mm_sub_pd(_mm_loadu_pd(p + i + 2), m);
+        s0 = _mm_add_pd(s0, d0);
+        s1 = _mm_add_pd(s1, d1);
+        q0 = _mm_add_pd(q0, _mm_mul_pd(d0, d0));
+        q1 = _mm_add_pd(q1, _mm_mul_pd(d1, d1));
+    }
+    shifted_sums tail = shifted_sums_generic(p + i, n - i, shift);
+    tail.s1 += hsum_sse2(_mm_add_pd(s0, s1));
+    tail.s2 += hsum_sse2(_mm_add_pd(q0, q1));
+    return tail;
+}
+
+// float 先扩展为 double 再做平移与平方，方差不受 float 尾数精度限制
+inline shifted_sums shifted_sums_sse2(const float* p, size_t n, double shift) {
+    __m128d m = _mm_set1_pd(shift);
+    __m128d s0 = _mm_setzero_pd(), s1 = s0, q0 = s0, q1 = s0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x = _mm_loadu_ps(p + i);
+        __m128d d0 = _mm_sub_pd(_mm_cvtps_pd(x), m);
+        __m128d d1 = _mm_sub_pd(_mm_cvtps_pd(_mm_movehl_ps(x, x)), m);
+        s0 = _mm_add_pd(s0, d0);
+        s1 = _mm_add_pd(s1, d1);
+        q0 = _mm_add_pd(q0, _mm_mul_pd(d0, d0));
+        q1 = _mm_add_pd(q1, _mm_mul_pd(d1, d1));
+    }
+    shifted_sums tail = shifted_sums_generic(p + i, n - i, shift);
+    tail.s1 += hsum_sse2(_mm_add_pd(s0, s1));
+    tail.s2 += hsum_sse2(_mm_add_pd(q0, q1));
+    return tail;
+}
+#endif
+
+#if ZEN_HAVE_AVX2_TARGET
+
+// ----------------------------------------------------------------------------
+// AVX2：double 4 路、float 8 路，每种归约 4 个累加器（Kahan 为 2 组）
+// ----------------------------------------------------------------------------
+
+ZEN_TARGET_AVX2
+inline double hsum_avx2(__m256d v) {
+    __m128d x = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(x, _mm_unpackhi_pd(x, x)));
+}
+
+ZEN_TARGET_AVX2
+inline float hsum_avx2(__m256 v) {
+    __m128 x = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+    return _mm_cvtss_f32(_mm_add_ss(x, _mm_shuffle_ps(x, x, 1)));
+}
+
+ZEN_TARGET_AVX2
+inline double sum_avx2(const double* p, size_t n) {
+    __m256d a0 = _mm256_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        a0 = _mm256_add_pd(a0, _mm256_loadu_pd(p + i));
+        a1 = _mm256_add_pd(a1, _mm256_loadu_pd(p + i + 4));
+        a2 = _mm256_add_pd(a2, _mm256_loadu_pd(p + i + 8));
+        a3 = _mm256_add_pd(a3, _mm256_loadu_pd(p + i + 12));
+    }
+    return hsum_avx2(_mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3))) + sum_generic(p + i, n - i);
+}
+
+ZEN_TARGET_AVX2
+inline float sum_avx2(const float* p, size_t n) {
+    __m256 a0 = _mm256_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        a0 = _mm256_add_ps(a0, _mm256_loadu_ps(p + i));
+        a1 = _mm256_add_ps(a1, _mm256_loadu_ps(p + i + 8));
+        a2 = _mm256_add_ps(a2, _mm256_loadu_ps(p + i + 16));
+        a3 = _mm256_add_ps(a3, _mm256_loadu_ps(p + i + 24));
+    }
+    return hsum_avx2(_mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3))) + sum_generic(p + i, n - i);
+}
+
+ZEN_TARGET_AVX2
+inline double sum_kahan_avx2(const double* p, size_t n) {
+    __m256d s0 = _mm256_setzero_pd(), c0 = s0, s1 = s0, c1 = s0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d y0 = _mm256_sub_pd(_mm256_loadu_pd(p + i), c0);
+        __m256d y1 = _mm256_sub_pd(_mm256_loadu_pd(p + i + 4), c1);
+        __m256d t0 = _mm256_add_pd(s0, y0);
+        __m256d t1 = _mm256_add_pd(s1, y1);
+        c0 = _mm256_sub_pd(_mm256_sub_pd(t0, s0), y0);
+        c1 = _mm256_sub_pd(_mm256_sub_pd(t1, s1), y1);
+        s0 = t0;
+        s1 = t1;
+    }
+    alignas(32) double s[8], c[8];
+    _mm256_store_pd(s, s0);
+    _mm256_store_pd(s + 4, s1);
+    _mm256_store_pd(c, c0);
+    _mm256_store_pd(c + 4, c1);
+    double total = 0, comp = 0;
+    for (int k = 0; k < 8; ++k) {
+        kahan_add(total, comp, s[k] - c[k]);
+    }
+    for (; i < n; ++i) kahan_add(total, comp, p[i]);
+    return total;
+}
+
+ZEN_TARGET_AVX2
+inline float sum_kahan_avx2(const float* p, size_t n) {
+    __m256 s0 = _mm256_setzero_ps(), c0 = s0, s1 = s0, c1 = s0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 y0 = _mm256_sub_ps(_mm256_loadu_ps(p + i), c0);
+        __m256 y1 = _mm256_sub_ps(_mm256_loadu_ps(p + i + 8), c1);
+        __m256 t0 = _mm256_add_ps(s0, y0);
+        __m256 t1 = _mm256_add_ps(s1, y1);
+        c0 = _mm256_sub_ps(_mm256_sub_ps(t0, s0), y0);
+        c1 = _mm256_sub_ps(_mm256_sub_ps(t1, s1), y1);
+        s0 = t0;
+        s1 = t1;
+    }
+    alignas(32) float s[16], c[16];
+    _mm256_store_ps(s, s0);
+    _mm256_store_ps(s + 8, s1);
+    _mm256_store_ps(c, c0);
+    _mm256_store_ps(c + 8, c1);
+    float total = 0, comp = 0;
+    for (int k = 0; k < 16; ++k) {
+        kahan_add(total, comp, s[k] - c[k]);
+    }
+    for (; i < n; ++i) kahan_add(total, comp, p[i]);
+    return total;
+}
+
+ZEN_TARGET_AVX2
+inline double dot_avx2(const double* a, const double* b, size_t n) {
+    __m256d a0 = _mm256_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        a0 = _mm256_add_pd(a0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        a1 = _mm256_add_pd(a1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+        a2 = _mm256_add_pd(a2, _mm256_mul_pd(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8)));
+        a3 = _mm256_add_pd(a3, _mm256_mul_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12)));
+    }
+    return hsum_avx2(_mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3))) + dot_generic(a + i, b + i, n - i);
+}
+
+ZEN_TARGET_AVX2
+inline float dot_avx2(const float* a, const float* b, size_t n) {
+    __m256 a0 = _mm256_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        a0 = _mm256_add_ps(a0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        a1 = _mm256_add_ps(a1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+        a2 = _mm256_add_ps(a2, _mm256_mul_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16)));
+        a3 = _mm256_add_ps(a3, _mm256_mul_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24)));
+    }
+    return hsum_avx2(_mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3))) + dot_generic(a + i, b + i, n - i);
+}
+
+ZEN_TARGET_AVX2
+inline void minmax_avx2(const double* p, size_t n, double& lo, double& hi) {
+    __m256d l0 = _mm256_set1_pd(lo), l1 = l0, h0 = _mm256_set1_pd(hi), h1 = h0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d v0 = _mm256_loadu_pd(p + i), v1 = _mm256_loadu_pd(p + i + 4);
+        l0 = _mm256_min_pd(v0, l0);
+        l1 = _mm256_min_pd(v1, l1);
+        h0 = _mm256_max_pd(v0, h0);
+        h1 = _mm256_max_pd(v1, h1);
+    }
+    __m256d l4 = _mm256_min_pd(l0, l1), h4 = _mm256_max_pd(h0, h1);
+    __m128d l = _mm_min_pd(_mm256_castpd256_pd128(l4), _mm256_extractf128_pd(l4, 1));
+    __m128d h = _mm_max_pd(_mm256_castpd256_pd128(h4), _mm256_extractf128_pd(h4, 1));
+    lo = _mm_cvtsd_f64(_mm_min_sd(l, _mm_unpackhi_pd(l, l)));
+    hi = _mm_cvtsd_f64(_mm_max_sd(h, _mm_unpackhi_pd(h, h)));
+    minmax_generic(p + i, n - i, lo, hi);
+}
+
+ZEN_TARGET_AVX2
+inline void minmax_avx2(const float* p, size_t n, float& lo, float& hi) {
+    __m256 l0 = _mm256_set1_ps(lo), l1 = l0, h0 = _mm256_set1_ps(hi), h1 = h0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 v0 = _mm256_loadu_ps(p + i), v1 = _mm256_loadu_ps(p + i + 8);
+        l0 = _mm256_min_ps(v0, l0);
+        l1 = _mm256_min_ps(v1, l1);
+        h0 = _mm256_max_ps(v0, h0);
+        h1 = _mm256_max_ps(v1, h1);
+    }
+    __m256 l8 = _mm256_min_ps(l0, l1), h8 = _mm256_max_ps(h0, h1);
+    __m128 l = _mm_min_ps(_mm256_castps256_ps128(l8), _mm256_extractf128_ps(l8, 1));
+    __m128 h = _mm_max_ps(_mm256_castps256_ps128(h8), _mm256_extractf128_ps(h8, 1));
+    l = _mm_min_ps(l, _mm_movehl_ps(l, l));
+    h = _mm_max_ps(h, _mm_movehl_ps(h, h));
+    lo = _mm_cvtss_f32(_mm_min_ss(l, _mm_shuffle_ps(l, l, 1)));
+    hi = _mm_cvtss_f32(_mm_max_ss(h, _mm_shuffle_ps(h, h, 1)));
+    minmax_generic(p + i, n - i, lo, hi);
+}
+
+ZEN_TARGET_AVX2
+inline double prefix_sum_avx2(const double* in, double* out, size_t n, double carry) {
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d c = _mm256_set1_pd(carry);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(in + i);
+        // [0, x0, x1, x2]
+        x = _mm256_add_pd(x, _mm256_blend_pd(_mm256_permute4x64_pd(x, 0x90), zero, 1));
+        // [0, 0, y0, y1]
+        x = _mm256_add_pd(x, _mm256_permute2f128_pd(x, x, 0x08));
+        x = _mm256_add_pd(x, c);
+        _mm256_storeu_pd(out + i, x);
+        c = _mm256_permute4x64_pd(x, 0xFF);
+    }
+    return prefix_sum_generic(in + i, out + i, n - i, _mm256_cvtsd_f64(c));
+}
+
+ZEN_TARGET_AVX2
+inline float prefix_sum_avx2(const float* in, float* out, size_t n, float carry) {
+    __m256 c = _mm256_set1_ps(carry);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(in + i);
+        // 两个 128 位半区内各自扫描
+        x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 4)));
+        x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 8)));
+        // 低半区的总和加到高半区
+        __m256 low_total = _mm256_permute_ps(x, 0xFF);
+        x = _mm256_add_ps(x, _mm256_permute2f128_ps(low_total, low_total, 0x08));
+        x = _mm256_add_ps(x, c);
+        _mm256_storeu_ps(out + i, x);
+        __m256 last = _mm256_permute_ps(x, 0xFF);
+        c = _mm256_permute2f128_ps(last, last, 0x11);
+    }
+    return prefix_sum_generic(in + i, out + i, n - i, _mm256_cvtss_f32(c));
+}
+
+ZEN_TARGET_AVX2
+inline shifted_sums shifted_sums_avx2(const double* p, size_t n, double shift) {
+    __m256d m = _mm256_set1_pd(shift);
+    __m256d s0 = _mm256_setzero_pd(), s1 = s0, q0 = s0, q1 = s0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(p + i), m);
+        __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(p + i + 4), m);
+        s0 = _mm256_add_pd(s0, d0);
+        s1 = _mm256_add_pd(s1, d1);
+        q0 = _mm256_add_pd(q0, _mm256_mul_pd(d0, d0));
+        q1 = _mm256_add_pd(q1, _mm256_mul_pd(d1, d1));
+    }
+    shifted_sums tail = shifted_sums_generic(p + i, n - i, shift);
+    tail.s1 += hsum_avx2(_mm256_add_pd(s0, s1));
+    tail.s2 += hsum_avx2(_mm256_add_pd(q0, q1));
+    return tail;
+}
+
+ZEN_TARGET_AVX2
+inline shifted_sums shifted_sums_avx2(const float* p, size_t n, double shift) {
+    __m256d m = _mm256_set1_pd(shift);
+    __m256d s0 = _mm256_setzero_pd(), s1 = s0, q0 = s0, q1 = s0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(p + i);
+        __m256d d0 = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(x)), m);
+        __m256d d1 = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(x, 1)), m);
+        s0 = _mm256_add_pd(s0, d0);
+        s1 = _mm256_add_pd(s1, d1);
+        q0 = _mm256_add_pd(q0, _mm256_mul_pd(d0, d0));
+        q1 = _mm256_add_pd(q1, _mm256_mul_pd(d1, d1));
+    }
+    shifted_sums tail = shifted_sums_generic(p + i, n - i, shift);
+    tail.s1 += hsum_avx2(_mm256_add_pd(s0, s1));
+    tail.s2 += hsum_avx2(_mm256_add_pd(q0, q1));
+    return tail;
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// 运行期分派
+// ----------------------------------------------------------------------------
+
+template<typename T>
+struct numeric_kernels {
+    T (*sum)(const T*, size_t)                           = sum_generic<T>;
+    T (*sum_kahan)(const T*, size_t)                     = sum_kahan_generic<T>;
+    T (*dot)(const T*, const T*, size_t)                 = dot_generic<T>;
+    void (*minmax)(const T*, size_t, T&, T&)             = minmax_generic<T>;
+    T (*prefix_sum)(const T*, T*, size_t, T)             = prefix_sum_generic<T>;
+    shifted_sums (*shifted)(const T*, size_t, double)    = shifted_sums_generic<T>;
+};
+
+template<typename T>
+numeric_kernels<T> select_numeric_kernels() {
+    numeric_kernels<T> k;
+#if ZEN_HAVE_SSE2
+    k.sum        = sum_sse2;
+    k.sum_kahan  = sum_kahan_sse2;
+    k.dot        = dot_sse2;
+    k.minmax     = minmax_sse2;
+    k.prefix_sum = prefix_sum_sse2;
+    k.shifted    = shifted_sums_sse2;
+#endif
+#if ZEN_HAVE_AVX2_TARGET
+    if (cpu_supports_avx2_target()) {
+        k.sum        = sum_avx2;
+        k.sum_kahan  = sum_kahan_avx2;
+        k.dot        = dot_avx2;
+        k.minmax     = minmax_avx2;
+        k.prefix_sum = prefix_sum_avx2;
+        k.shifted    = shifted_sums_avx2;
+    }
+#endif
+    return k;
+}
+
+template<typename T>
+const numeric_kernels<T>& numeric_simd() {
+    static const numeric_kernels<T> kernels = select_numeric_kernels<T>();
+    return kernels;
+}
+
+template<typename T>
+T sum_pairwise(const T* p, size_t n, T (*leaf)(const T*, size_t)) {
+    if (n <= pairwise_block) return leaf(p, n);
+    // 左半取块大小的整数倍，叶子块始终完整
+    size_t half = (n / pairwise_block + 1) / 2 * pairwise_block;
+    return sum_pairwise(p, half, leaf) + sum_pairwise(p + half, n - half, leaf);
+}
+
+template<typename T>
+T sum_dispatch(const T* p, size_t n, summation mode) {
+    const numeric_kernels<T>& k = numeric_simd<T>();
+    switch (mode) {
+    case summation::kahan:    return k.sum_kahan(p, n);
+    case summation::pairwise: return sum_pairwise(p, n, k.sum);
+    default:                  return k.sum(p, n);
+    }
+}
+
+// 分块：先用求和内核得到块均值作为平移量，再在 L1 中读第二遍求平移后的一阶、二阶和，
+// m2 = Σd² - (Σd)² / n 修正平移量与真实块均值的舍入差；各块以 Chan 公式合并。
+// 对内存只读一遍，且不受 Σx² - (Σx)²/n 那样的大数相消影响。
+template<typename T>
+moments moments_dispatch(const T* p, size_t n) {
+    const numeric_kernels<T>& k = numeric_simd<T>();
+    moments total;
+    for (size_t i = 0; i < n; i += moments_block) {
+        size_t len = n - i < moments_block ? n - i : moments_block;
+        double cnt = static_cast<double>(len);
+        double shift = static_cast<double>(k.sum(p + i, len)) / cnt;
+        shifted_sums s = k.shifted(p + i, len, shift);
+        moments block;
+        block.count = len;
+        block.mean = shift + s.s1 / cnt;
+        block.m2 = s.s2 - s.s1 * s.s1 / cnt;
+        if (block.m2 < 0) block.m2 = 0;
+        total.merge(block);
+    }
+    return total;
+}
+
+template<typename T>
+minmax_result<T> minmax_dispatch(const T* p, size_t n) {
+    T lo = std::numeric_limits<T>::infinity();
+    T hi = -std::numeric_limits<T>::infinity();
+    numeric_simd<T>().minmax(p, n, lo, hi);
+    return { lo, hi };
+}
+
+} // namespace detail
+
+// ============================================================================
+// 公开接口（float / double）
+// ============================================================================
+
+/**
+ * @brief 求和
+ * @param mode 求和模式，见文件头说明
+ */
+inline double sum(const double* p, size_t n, summation mode = summation::fast) {
+    return detail::sum_dispatch(p, n, mode);
+}
+
+inline float sum(const float* p, size_t n, summation mode = summation::fast) {
+    return detail::sum_dispatch(p, n, mode);
+}
+
+/**
+ * @brief 点积 Σ a[i] * b[i]
+ */
+inline double dot(const double* a, const double* b, size_t n) {
+    return detail::numeric_simd<double>().dot(a, b, n);
+}
+
+inline float dot(const float* a, const float* b, size_t n) {
+    return detail::numeric_simd<float>().dot(a, b, n);
+}
+
+/**
+ * @brief 同时求最小值与最大值
+ * @return {lo, hi}；NaN 被忽略，n == 0 或全为 NaN 时返回 {+inf, -inf}
+ */
+inline minmax_result<double> minmax_value(const double* p, size_t n) {
+    return detail::minmax_dispatch(p, n);
+}
+
+inline minmax_result<float> minmax_value(const float* p, size_t n) {
+    return detail::minmax_dispatch(p, n);
+}
+
+/**
+ * @brief 包含式前缀和：out[i] = in[0] + ... + in[i]
+ *
+ * in 与 out 可以是同一数组（原地），其他情况下不能重叠。
+ * @return out 的末尾（out + n）
+ */
+inline double* prefix_sum(const double* in, double* out, size_t n) {
+    detail::numeric_simd<double>().prefix_sum(in, out, n, 0.0);
+    return out + n;
+}
+
+inline float* prefix_sum(const float* in, float* out, size_t n) {
+    detail::numeric_simd<float>().prefix_sum(in, out, n, 0.0f);
+    return out + n;
+}
+
+/**
+ * @brief 一次读入求 count / mean / m2（float 以 double 精度统计）
+ *
+ * 结果可与其他数组、其他线程的 moments 用 merge 合并。
+ */
+inline moments compute_moments(const double* p, size_t n) {
+    return detail::moments_dispatch(p, n);
+}
+
+inline moments compute_moments(const float* p, size_t n) {
+    return detail::moments_dispatch(p, n);
+}
+
+} // namespace zen
+
+#endif // ZEN_ALGORITHMS_NUMERIC_SIMD_H
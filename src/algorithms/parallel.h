@@ -0,0 +1,684 @@
+#ifndef ZEN_ALGORITHMS_PARALLEL_H
+#define ZEN_ALGORITHMS_PARALLEL_H
+
+#include "execution.h"
+#include "sort.h"
+#include "find.h"
+#include "numeric.h"
+#include "transform.h"
+#include "../utility/optional.h"
+#include <atomic>
+#include <memory>
+#include <new>
+
+namespace zen {
+
+// ============================================================================
+// 并行算法（带执行策略的重载）
+// ============================================================================
+//
+// 每个算法的第一个参数为执行策略（见 execution.h）：
+//   zen::sort(zen::execution::par, v.begin(), v.end());
+//   double s = zen::reduce(zen::execution::par, v.begin(), v.end(), 0.0);
+//
+// - execution::seq 或迭代器不支持 first + n / last - first 时退化为顺序版本
+// - 区间短于两块（粒度见各算法）时也直接顺序执行
+// - reduce / transform_reduce / inclusive_scan 及带策略的 accumulate 只要求
+//   op 满足结合律：块内从左到右计算，块间结果按块顺序合并，
+//   因此不要求交换律，结果与顺序版本的结合方式不同（浮点数可能有舍入差异）
+// - find_if 按块顺序领取，某块找到后，起点在其之后的块直接跳过，
+//   正在扫描的块也会周期性检查并提前结束
+// - sort / stable_sort 先并行排序各段，再逐轮两两归并；每轮归并按 merge path
+//   切成多个独立片段并行执行，最后一轮也能用满所有线程。需要 n 个元素的
+//   临时缓冲区；stable_sort 的结果是稳定的
+// ============================================================================
+
+namespace detail {
+
+// 各类算法的默认最小块大小（元素数）
+constexpr par_size_t par_grain_elementwise = 4096;   // for_each / transform / count
+constexpr par_size_t par_grain_reduce      = 8192;   // reduce / scan
+constexpr par_size_t par_grain_search      = 4096;   // find_if
+constexpr par_size_t par_grain_sort        = 16384;  // 每段排序的最少元素数
+
+template<typename... Its>
+struct all_random_access {
+    static constexpr bool value = (has_iterator_difference<Its>::value && ...);
+};
+
+} // namespace detail
+
+// ============================================================================
+// for_each
+// ============================================================================
+
+/**
+ * @brief 对区间每个元素并行应用 f（各元素的调用顺序不确定）
+ */
+template<typename Policy, typename RandomIt, typename UnaryFunc>
+detail::enable_if_policy_t<Policy>
+for_each(Policy&& policy, RandomIt first, RandomIt last, UnaryFunc f) {
+    if constexpr (!detail::all_random_access<RandomIt>::value) {
+        zen::for_each(first, last, f);
+    } else {
+        auto ctx = detail::make_parallel_context(policy);
+        detail::parallel_for_range(ctx, static_cast<detail::par_size_t>(last - first),
+                                   ctx.grain_or(detail::par_grain_elementwise),
+                                   [&](detail::par_size_t b, detail::par_size_t e) {
+            for (RandomIt it = first + b, end = first + e; it != end; ++it) f(*it);
+        });
+    }
+}
+
+// ============================================================================
+// transform
+// ============================================================================
+
+/**
+ * @brief 并行一元转换：d[i] = op(s[i])
+ */
+template<typename Policy, typename RandomIt, typename OutputIt, typename UnaryOp>
+detail::enable_if_policy_t<Policy, OutputIt>
+transform(Policy&& policy, RandomIt first, RandomIt last, OutputIt d_first, UnaryOp op) {
+    if constexpr (!detail::all_random_access<RandomIt, OutputIt>::value) {
+        return zen::transform(first, last, d_first, op);
+    } else {
+        auto ctx = detail::make_parallel_context(policy);
+        auto n = static_cast<detail::par_size_t>(last - first);
+        detail::parallel_for_range(ctx, n, ctx.grain_or(detail::par_grain_elementwise),
+                                   [&](detail::par_size_t b, detail::par_size_t e) {
+            zen::transform(first + b, first + e, d_first + b, op);
+        });
+        return d_first + n;
+    }
+}
+
+/**
+ * @brief 并行二元转换：d[i] = op(s1[i], s2[i])
+ */
+template<typename Policy, typename RandomIt1, typename RandomIt2, typename OutputIt, typename BinaryOp>
+detail::enable_if_policy_t<Policy, OutputIt>
+transform(Policy&& policy, RandomIt1 first1, RandomIt1 last1, RandomIt2 first2,
+          OutputIt d_first, BinaryOp op) {
+    if constexpr (!detail::all_random_access<RandomIt1, RandomIt2, OutputIt>::value) {
+        return zen::transform(first1, last1, first2, d_first, op);
+    } else {
+        auto ctx = detail::make_parallel_context(policy);
+        auto n = static_cast<detail::par_size_t>(last1 - first1);
+        detail::parallel_for_range(ctx, n, ctx.grain_or(detail::par_grain_elementwise),
+                                   [&](detail::par_size_t b, detail::par_size_t e) {
+            zen::transform(first1 + b, first1 + e, first2 + b, d_first + b, op);
+        });
+        return d_first + n;
+    }
+}
+
+// ============================================================================
+// reduce / transform_reduce / accumulate
+// ============================================================================
+
+namespace detail {
+
+/**
+ * @brief 分块并行归约的公共实现
+ *
+ * chunk_fold(b, e, acc) 把 [b, e) 折叠进 acc（acc 为空时以第一个元素开头）；
+ * 块结果再按块顺序用 op 合并到 init 上。
+ */
+template<typename T, typename BinaryOp, typename ChunkFold>
+T parallel_reduce_impl(const parallel_context& ctx, par_size_t n, par_size_t grain,
+                       T init, BinaryOp& op, ChunkFold chunk_fold) {
+    par_size_t chunks = parallel_chunk_count(n, ctx.workers, grain);
+    if (chunks <= 1) {
+        optional<T> acc(zen::move(init));
+        chunk_fold(0, n, acc);
+        return zen::move(*acc);
+    }
+
+    std::unique_ptr<optional<T>[]> partial(new optional<T>[chunks]);
+    auto body = [&](par_size_t i) {
+        chunk_fold(parallel_chunk_begin(n, chunks, i),
+                   parallel_chunk_begin(n, chunks, i + 1), partial[i]);
+    };
+    parallel_run_chunks(ctx, chunks, body);
+
+    for (par_size_t i = 0; i < chunks; ++i) {
+        if (partial[i]) init = op(zen::move(init), zen::move(*partial[i]));
+    }
+    return init;
+}
+
+} // namespace detail
+
+/**
+ * @brief 并行归约：init op a[0] op ... （op 需满足结合律）
+ */
+template<typename Policy, typename RandomIt, typename T, typename BinaryOp>
+detail::enable_if_policy_t<Policy, T>
+reduce(Policy&& policy, RandomIt first, RandomIt last, T init, BinaryOp op) {
+    if constexpr (!detail::all_random_access<RandomIt>::value) {
+        return zen::reduce(first, last, zen::move(init), op);
+    } else {
+        auto ctx = detail::make_parallel_context(policy);
+        return detail::parallel_reduce_impl(ctx, static_cast<detail::par_size_t>(last - first),
+                                            ctx.grain_or(detail::par_grain_reduce),
+                                            zen::move(init), op,
+            [&](detail::par_size_t b, detail::par_size_t e, optional<T>& acc) {
+                if (b == e) return;
+                RandomIt it = first + b, end = first + e;
+                T value = acc ? op(zen::move(*acc), *it) : T(*it);
+                for (++it; it != end; ++it) value = op(zen::move(value), *it);
+                acc = zen::move(value);
+            });
+    }
+}
+
+template<typename Policy, typename RandomIt, typename T>
+detail::enable_if_policy_t<Policy, T>
+reduce(Policy&& policy, RandomIt first, RandomIt last, T init) {
+    auto plus = [](const T& a, const T& b){ return a + b; };
+    if constexpr (detail::simd_reducible<RandomIt, T>()) {
+        // float / double 连续区间：每块用向量求和内核
+        auto ctx = detail::make_parallel_context(policy);
+        return detail::parallel_reduce_impl(ctx, static_cast<detail::par_size_t>(last - first),
+                                            ctx.grain_or(detail::par_grain_reduce), init, plus,
+            [&](detail::par_size_t b, detail::par_size_t e, optional<T>& acc) {
+                if (b == e) return;
+                T s = zen::sum(first + b, static_cast<size_t>(e - b));
+                acc = acc ? *acc + s : s;
+            });
+    } else {
+        return zen::reduce(policy, first, last, zen::move(init), plus);
+    }
+}
+
+template<typename Policy, typename RandomIt>
+detail::enable_if_policy_t<Policy, typename zen::iterator_traits<RandomIt>::value_type>
+reduce(Policy&& policy, RandomIt first, RandomIt last) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    return zen::reduce(policy, first, last, value_type{});
+}
+
+/**
+ * @brief 带执行策略的 accumulate：等价于 reduce（op 需满足结合律）
+ */
+template<typename Policy, typename RandomIt, typename T, typename BinaryOp>
+detail::enable_if_policy_t<Policy, T>
+accumulate(Policy&& policy, RandomIt first, RandomIt last, T init, BinaryOp op) {
+    return zen::reduce(policy, first, last, zen::move(init), op);
+}
+
+template<typename Policy, typename RandomIt, typename T>
+detail::enable_if_policy_t<Policy, T>
+accumulate(Policy&& policy, RandomIt first, RandomIt last, T init) {
+    return zen::reduce(policy, first, last, zen::move(init));
+}
+
+/**
+ * @brief 并行变换归约：init op t(a[0]) op t(a[1]) ...
+ */
+template<typename Policy, typename RandomIt, typename T, typename BinaryOp, typename UnaryOp>
+detail::enable_if_policy_t<Policy, T>
+transform_reduce(Policy&& policy, RandomIt first, RandomIt last, T init,
+                 BinaryOp reduce_op, UnaryOp transform_op) {
+    if constexpr (!detail::all_random_access<RandomIt>::value) {
+        return zen::transform_reduce(first, last, zen::move(init), reduce_op, transform_op);
+    } else {
+        auto ctx = detail::make_parallel_context(policy);
+        return detail::parallel_reduce_impl(ctx, static_cast<detail::par_size_t>(last - first),
+                                            ctx.grain_or(detail::par_grain_reduce),
+                                            zen::move(init), reduce_op,
+            [&](detail::par_size_t b, detail::par_size_t e, optional<T>& acc) {
+                if (b == e) return;
+                RandomIt it = first + b, end = first + e;
+                T value = acc ? reduce_op(zen::move(*acc), transform_op(*it)) : T(transform_op(*it));
+                for (++it; it != end; ++it) value = reduce_op(zen::move(value), transform_op(*it));
+                acc = zen::move(value);
+            });
+    }
+}
+
+/**
+ * @brief 两个区间的并行变换归约：init op t(a[0], b[0]) op ...
+ */
+template<typename Policy, typename RandomIt1, typename RandomIt2, typename T,
+         typename BinaryOp1, typename BinaryOp2>
+detail::enable_if_policy_t<Policy, T>
+transform_reduce(Policy&& policy, RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, T init,
+                 BinaryOp1 reduce_op, BinaryOp2 transform_op) {
+    if constexpr (!detail::all_random_access<RandomIt1, RandomIt2>::value) {
+        return zen::transform_reduce(first1, last1, first2, zen::move(init), reduce_op, transform_op);
+    } else {
+        auto ctx = detail::make_parallel_context(policy);
+        return detail::parallel_reduce_impl(ctx, static_cast<detail::par_size_t>(last1 - first1),
+                                            ctx.grain_or(detail::par_grain_reduce),
+                                            zen::move(init), reduce_op,
+            [&](detail::par_size_t b, detail::par_size_t e, optional<T>& acc) {
+                if (b == e) return;
+                RandomIt1 it = first1 + b, end = first1 + e;
+                RandomIt2 it2 = first2 + b;
+                T value = acc ? reduce_op(zen::move(*acc), transform_op(*it, *it2))
+                              : T(transform_op(*it, *it2));
+                for (++it, ++it2; it != end; ++it, ++it2) {
+                    value = reduce_op(zen::move(value), transform_op(*it, *it2));
+                }
+                acc = zen::move(value);
+            });
+    }
+}
+
+/**
+ * @brief 并行内积：init + Σ a[i] * b[i]
+ */
+template<typename Policy, typename RandomIt1, typename RandomIt2, typename T>
+detail::enable_if_policy_t<Policy, T>
+transform_reduce(Policy&& policy, RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, T init) {
+    auto plus = [](const T& a, const T& b){ return a + b; };
+    if constexpr (detail::simd_reducible<RandomIt1, T>() && detail::simd_reducible<RandomIt2, T>()) {
+        // float / double 连续区间：每块用向量点积内核
+        auto ctx = detail::make_parallel_context(policy);
+        return detail::parallel_reduce_impl(ctx, static_cast<detail::par_size_t>(last1 - first1),
+                                            ctx.grain_or(detail::par_grain_reduce), init, plus,
+            [&](detail::par_size_t b, detail::par_size_t e, optional<T>& acc) {
+                if (b == e) return;
+                T d = zen::dot(first1 + b, first2 + b, static_cast<size_t>(e - b));
+                acc = acc ? *acc + d : d;
+            });
+    } else {
+        return zen::transform_reduce(policy, first1, last1, first2, zen::move(init), plus,
+                                     [](const auto& a, const auto& b){ return a * b; });
+    }
+}
+
+// ============================================================================
+// inclusive_scan
+// ============================================================================
+
+/**
+ * @brief 并行包含式扫描：d[i] = init op a[0] op ... op a[i]
+ *
+ * 两趟：先并行求每块的归约值，顺序求块间前缀，再并行做块内扫描。
+ * 输入只在两趟中被读取，因此允许 d_first == first（原地扫描）。
+ */
+template<typename Policy, typename RandomIt, typename OutputIt, typename BinaryOp, typename T>
+detail::enable_if_policy_t<Policy, OutputIt>
+inclusive_scan(Policy&& policy, RandomIt first, RandomIt last, OutputIt d_first, BinaryOp op, T init) {
+    if constexpr (!detail::all_random_access<RandomIt, OutputIt>::value) {
+        return zen::inclusive_scan(first, last, d_first, op, zen::move(init));
+    } else {
+        auto ctx = detail::make_parallel_context(policy);
+        auto n = static_cast<detail::par_size_t>(last - first);
+        detail::par_size_t chunks = detail::parallel_chunk_count(
+            n, ctx.workers, ctx.grain_or(detail::par_grain_reduce));
+        if (chunks <= 1) {
+            return zen::inclusive_scan(first, last, d_first, op, zen::move(init));
+        }
+
+        // 第一趟：除最后一块外，求各块的归约值
+        std::unique_ptr<optional<T>[]> carry(new optional<T>[chunks]);
+        auto reduce_body = [&](detail::par_size_t i) {
+            auto b = detail::parallel_chunk_begin(n, chunks, i);
+            auto e = detail::parallel_chunk_begin(n, chunks, i + 1);
+            RandomIt it = first + b, end = first + e;
+            T value(*it);
+            for (++it; it != end; ++it) value = op(zen::move(value), *it);
+            carry[i] = zen::move(value);
+        };
+        parallel_run_chunks(ctx, chunks - 1, reduce_body);
+
+        // 块间前缀：carry[i] 变为第 i 块之前所有元素（含 init）的归约
+        T running = zen::move(init);
+        for (detail::par_size_t i = 0; i < chunks; ++i) {
+            T next = (i + 1 < chunks) ? op(running, zen::move(*carry[i])) : running;
+            carry[i] = zen::move(running);
+            running = zen::move(next);
+        }
+
+        // 第二趟：块内扫描
+        auto scan_body = [&](detail::par_size_t i) {
+            auto b = detail::parallel_chunk_begin(n, chunks, i);
+            auto e = detail::parallel_chunk_begin(n, chunks, i + 1);
+            zen::inclusive_scan(first + b, first + e, d_first + b, op, zen::move(*carry[i]));
+        };
+        parallel_run_chunks(ctx, chunks, scan_body);
+        return d_first + n;
+    }
+}
+
+template<typename Policy, typename RandomIt, typename OutputIt, typename BinaryOp>
+detail::enable_if_policy_t<Policy, OutputIt>
+inclusive_scan(Policy&& policy, RandomIt first, RandomIt last, OutputIt d_first, BinaryOp op) {
+    if (first == last) return d_first;
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    value_type head(*first);
+    *d_first = head;
+    return zen::inclusive_scan(policy, first + 1, last, d_first + 1, op, zen::move(head));
+}
+
+template<typename Policy, typename RandomIt, typename OutputIt>
+detail::enable_if_policy_t<Policy, OutputIt>
+inclusive_scan(Policy&& policy, RandomIt first, RandomIt last, OutputIt d_first) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    return zen::inclusive_scan(policy, first, last, d_first,
+                               [](const value_type& a, const value_type& b){ return a + b; });
+}
+
+// ============================================================================
+// find_if / count_if
+// ============================================================================
+
+/**
+ * @brief 并行查找第一个满足 pred 的元素（提前取消）
+ *
+ * 结果与顺序版本相同：返回下标最小的匹配。
+ */
+template<typename Policy, typename RandomIt, typename UnaryPred>
+detail::enable_if_policy_t<Policy, RandomIt>
+find_if(Policy&& policy, RandomIt first, RandomIt last, UnaryPred pred) {
+    if constexpr (!detail::all_random_access<RandomIt>::value) {
+        return zen::find_if(first, last, pred);
+    } else {
+        auto ctx = detail::make_parallel_context(policy);
+        auto n = static_cast<detail::par_size_t>(last - first);
+        std::atomic<detail::par_size_t> best{n};
+
+        detail::parallel_for_range(ctx, n, ctx.grain_or(detail::par_grain_search),
+                                   [&](detail::par_size_t b, detail::par_size_t e) {
+            if (b >= best.load(std::memory_order_relaxed)) return;   // 前面的块已命中
+            for (detail::par_size_t i = b; i < e; ++i) {
+                if ((i & 255) == 0 && best.load(std::memory_order_relaxed) < i) return;
+                if (pred(first[i])) {
+                    detail::par_size_t cur = best.load(std::memory_order_relaxed);
+                    while (i < cur && !best.compare_exchange_weak(cur, i, std::memory_order_relaxed)) {}
+                    return;
+                }
+            }
+        });
+        return first + best.load(std::memory_order_relaxed);
+    }
+}
+
+template<typename Policy, typename RandomIt, typename T>
+detail::enable_if_policy_t<Policy, RandomIt>
+find(Policy&& policy, RandomIt first, RandomIt last, const T& value) {
+    return zen::find_if(policy, first, last, [&value](const auto& x) { return x == value; });
+}
+
+/**
+ * @brief 并行统计满足 pred 的元素个数
+ */
+template<typename Policy, typename RandomIt, typename UnaryPred>
+detail::enable_if_policy_t<Policy, size_t>
+count_if(Policy&& policy, RandomIt first, RandomIt last, UnaryPred pred) {
+    if constexpr (!detail::all_random_access<RandomIt>::value) {
+        return zen::count_if(first, last, pred);
+    } else {
+        auto ctx = detail::make_parallel_context(policy);
+        std::atomic<size_t> total{0};
+        detail::parallel_for_range(ctx, static_cast<detail::par_size_t>(last - first),
+                                   ctx.grain_or(detail::par_grain_elementwise),
+                                   [&](detail::par_size_t b, detail::par_size_t e) {
+            total.fetch_add(zen::count_if(first + b, first + e, pred), std::memory_order_relaxed);
+        });
+        return total.load(std::memory_order_relaxed);
+    }
+}
+
+template<typename Policy, typename RandomIt, typename T>
+detail::enable_if_policy_t<Policy, size_t>
+count(Policy&& policy, RandomIt first, RandomIt last, const T& value) {
+    return zen::count_if(policy, first, last, [&value](const auto& x) { return x == value; });
+}
+
+// ============================================================================
+// sort / stable_sort
+// ============================================================================
+
+namespace detail {
+
+/**
+ * @brief merge path：a、b 归并结果的前 t 个元素中有多少来自 a
+ *
+ * 相等元素 a 优先（稳定）。
+ */
+template<typename ItA, typename ItB, typename Compare>
+par_size_t merge_path_split(ItA a, par_size_t na, ItB b, par_size_t nb, par_size_t t, Compare& comp) {
+    par_size_t lo = t > nb ? t - nb : 0;
+    par_size_t hi = t < na ? t : na;
+    while (lo < hi) {
+        par_size_t mid = lo + (hi - lo) / 2;
+        if (!comp(b[t - mid - 1], a[mid])) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief 顺序归并 a[0, na) 与 b[0, nb) 到 out（Construct 为 true 时在未初始化内存上构造）
+ *
+ * Construct 模式下比较或移动抛异常时，先析构本次已构造的元素再重新抛出。
+ */
+template<bool Construct, typename ItA, typename ItB, typename Out, typename Compare>
+void merge_move(ItA a, par_size_t na, ItB b, par_size_t nb, Out out, Compare& comp) {
+    using value_type = typename zen::iterator_traits<Out>::value_type;
+    Out start = out;
+    auto put = [&](auto&& v) {
+        if constexpr (Construct) ::new (static_cast<void*>(&*out)) value_type(zen::move(v));
+        else *out = zen::move(v);
+        ++out;
+    };
+    auto merge = [&] {
+        par_size_t i = 0, j = 0;
+        while (i < na && j < nb) {
+            if (comp(b[j], a[i])) put(b[j++]);
+            else                  put(a[i++]);
+        }
+        while (i < na) put(a[i++]);
+        while (j < nb) put(b[j++]);
+    };
+    if constexpr (Construct && !is_trivially_destructible_v<value_type>) {
+        try {
+            merge();
+        } catch (...) {
+            for (; start != out; ++start) (*start).~value_type();
+            throw;
+        }
+    } else {
+        static_cast<void>(start);
+        merge();
+    }
+}
+
+// 归并目标是否为未初始化内存（第一轮归并到临时缓冲区时为 true）
+template<bool Construct>
+struct merge_mode { static constexpr bool value = Construct; };
+
+/**
+ * @brief 并行归并排序骨架：各段用 run_sort 排序，再逐轮两两归并
+ */
+template<typename RandomIt, typename Compare, typename RunSort>
+void parallel_merge_sort(const parallel_context& ctx, RandomIt first, RandomIt last,
+                         Compare comp, RunSort run_sort) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    par_size_t n = static_cast<par_size_t>(last - first);
+    par_size_t grain = ctx.grain_or(par_grain_sort);
+
+    // 段数：每个线程一段（排序本身已足够均衡），且每段不少于 grain
+    par_size_t runs = n / grain;
+    if (runs > ctx.workers) runs = ctx.workers;
+    if (runs <= 1 || !ctx.pool) {
+        run_sort(first, last, comp);
+        return;
+    }
+
+    // 1. 并行排序各段
+    auto sort_body = [&](par_size_t i) {
+        run_sort(first + parallel_chunk_begin(n, runs, i),
+                 first + parallel_chunk_begin(n, runs, i + 1), comp);
+    };
+    parallel_run_chunks(ctx, runs, sort_body);
+
+    // 段边界
+    std::unique_ptr<par_size_t[]> bounds(new par_size_t[runs + 1]);
+    for (par_size_t i = 0; i <= runs; ++i) bounds[i] = parallel_chunk_begin(n, runs, i);
+
+    merge_buffer<value_type> owner(static_cast<value_type*>(::operator new(n * sizeof(value_type))));
+    value_type* buf = owner.get();
+    bool in_buf = false;        // 当前数据在 buf 中还是原数组中
+    bool buf_constructed = false;
+
+    // 2. 逐轮两两归并，数据在原数组与 buf 之间往返
+    par_size_t parts_per_round = ctx.workers * 2;
+    while (runs > 1) {
+        par_size_t pairs = runs / 2;
+        bool odd = (runs & 1) != 0;
+
+        // 把本轮所有归并切成约 parts_per_round 个片段，长度与归并规模成正比
+        // 片段：归并 [lo, mid) 与 [mid, hi) 的输出区间 [t0, t1)，其中前 i0 / i1 个取自左段
+        struct piece { par_size_t lo, mid, hi, t0, t1, i0, i1; bool built = false; };
+        std::unique_ptr<piece[]> pieces;
+        par_size_t piece_count = 0;
+        {
+            par_size_t total = 0;
+            std::unique_ptr<par_size_t[]> split(new par_size_t[pairs + 1]);
+            for (par_size_t p = 0; p < pairs + (odd ? 1 : 0); ++p) {
+                par_size_t len = (p < pairs) ? bounds[2 * p + 2] - bounds[2 * p]
+                                             : bounds[runs] - bounds[runs - 1];
+                par_size_t k = (len * parts_per_round + n - 1) / n;
+                if (k == 0) k = 1;
+                if (p < pairs) split[p] = k;
+                total += k;
+            }
+            pieces.reset(new piece[total]);
+            for (par_size_t p = 0; p < pairs; ++p) {
+                par_size_t lo = bounds[2 * p], mid = bounds[2 * p + 1], hi = bounds[2 * p + 2];
+                par_size_t len = hi - lo, k = split[p];
+                for (par_size_t q = 0; q < k; ++q) {
+                    pieces[piece_count++] = { lo, mid, hi, len * q / k, len * (q + 1) / k, 0, 0 };
+                }
+            }
+            if (odd) {
+                // 奇数段直接搬运，按同样的比例切片
+                par_size_t lo = bounds[runs - 1], hi = bounds[runs], len = hi - lo;
+                par_size_t k = total - piece_count;
+                for (par_size_t q = 0; q < k; ++q) {
+                    pieces[piece_count++] = { lo, hi, hi, len * q / k, len * (q + 1) / k, 0, 0 };
+                }
+            }
+        }
+
+        // 切分点要在任何片段开始搬运之前全部算好：搬运会把源元素移走，
+        // 其他片段再二分查找同一源区间就会读到被移走的对象。
+        // 片段数约为线程数的两倍，每个只需 O(log n) 次比较，顺序计算即可
+        auto compute_splits = [&](auto src) {
+            for (par_size_t idx = 0; idx < piece_count; ++idx) {
+                piece& pc = pieces[idx];
+                par_size_t na = pc.mid - pc.lo, nb = pc.hi - pc.mid;
+                pc.i0 = merge_path_split(src + pc.lo, na, src + pc.mid, nb, pc.t0, comp);
+                pc.i1 = merge_path_split(src + pc.lo, na, src + pc.mid, nb, pc.t1, comp);
+            }
+        };
+        if (in_buf) compute_splits(buf);
+        else        compute_splits(first);
+
+        auto merge_body = [&](par_size_t idx) {
+            piece& pc = pieces[idx];
+            auto run = [&](auto src, auto dst, auto construct) {
+                auto a = src + pc.lo;
+                auto b = src + pc.mid;
+                merge_move<decltype(construct)::value>(a + pc.i0, pc.i1 - pc.i0,
+                                                      b + (pc.t0 - pc.i0), (pc.t1 - pc.i1) - (pc.t0 - pc.i0),
+                                                      dst + (pc.lo + pc.t0), comp);
+            };
+            if (in_buf) run(buf, first, merge_mode<false>{});
+            else if (buf_constructed) run(first, buf, merge_mode<false>{});
+            else {
+                run(first, buf, merge_mode<true>{});
+                pc.built = true;
+            }
+        };
+        if (buf_constructed) {
+            parallel_run_chunks(ctx, piece_count, merge_body);
+        } else {
+            // 第一轮在未初始化内存上构造：失败时只有完成的片段需要析构
+            try {
+                parallel_run_chunks(ctx, piece_count, merge_body);
+            } catch (...) {
+                if constexpr (!is_trivially_destructible_v<value_type>) {
+                    for (par_size_t idx = 0; idx < piece_count; ++idx) {
+                        const piece& pc = pieces[idx];
+                        if (!pc.built) continue;
+                        for (par_size_t i = pc.lo + pc.t0; i < pc.lo + pc.t1; ++i) buf[i].~value_type();
+                    }
+                }
+                throw;
+            }
+            owner.get_deleter().constructed = n;
+        }
+
+        buf_constructed = true;
+        in_buf = !in_buf;
+
+        // 更新段边界
+        par_size_t new_runs = pairs + (odd ? 1 : 0);
+        for (par_size_t p = 0; p < pairs; ++p) bounds[p] = bounds[2 * p];
+        if (odd) bounds[pairs] = bounds[runs - 1];
+        bounds[new_runs] = n;
+        runs = new_runs;
+    }
+
+    // 3. 结果在 buf 中时搬回原数组；buf 随 owner 析构
+    if (in_buf) {
+        parallel_for_range(ctx, n, par_grain_elementwise, [&](par_size_t b, par_size_t e) {
+            for (par_size_t i = b; i < e; ++i) first[i] = zen::move(buf[i]);
+        });
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief 并行排序（不稳定，各段使用 zen::sort）
+ */
+template<typename Policy, typename RandomIt, typename Compare>
+detail::enable_if_policy_t<Policy>
+sort(Policy&& policy, RandomIt first, RandomIt last, Compare comp) {
+    if constexpr (!detail::is_parallel_policy<Policy>::value) {
+        zen::sort(first, last, comp);
+    } else {
+        detail::parallel_merge_sort(detail::make_parallel_context(policy), first, last, comp,
+                                    [](RandomIt b, RandomIt e, Compare& c) { zen::sort(b, e, c); });
+    }
+}
+
+template<typename Policy, typename RandomIt>
+detail::enable_if_policy_t<Policy>
+sort(Policy&& policy, RandomIt first, RandomIt last) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    zen::sort(policy, first, last, zen::less<value_type>{});
+}
+
+/**
+ * @brief 并行稳定排序（各段使用 zen::stable_sort，归并时相等元素保持原顺序）
+ */
+template<typename Policy, typename RandomIt, typename Compare>
+detail::enable_if_policy_t<Policy>
+stable_sort(Policy&& policy, RandomIt first, RandomIt last, Compare comp) {
+    if constexpr (!detail::is_parallel_policy<Policy>::value) {
+        zen::stable_sort(first, last, comp);
+    } else {
+        detail::parallel_merge_sort(detail::make_parallel_context(policy), first, last, comp,
+                                    [](RandomIt b, RandomIt e, Compare& c) { zen::stable_sort(b, e, c); });
+    }
+}
+
+template<typename Policy, typename RandomIt>
+detail::enable_if_policy_t<Policy>
+stable_sort(Policy&& policy, RandomIt first, RandomIt last) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    zen::stable_sort(policy, first, last, zen::less<value_type>{});
+}
+
+} // namespace zen
+
+#endif // ZEN_ALGORITHMS_PARALLEL_H
@@ -0,0 +1,365 @@
+#ifndef ZEN_ALGORITHMS_RADIX_SORT_H
+#define ZEN_ALGORITHMS_RADIX_SORT_H
+
+#include "../base/type_traits.h"
+#include "../utility/swap.h"
+#include "../iterators/iterator_base.h"
+#include <cstring>      // memcpy, memcmp
+
+namespace zen {
+
+// ============================================================================
+// 基数排序（Radix Sort）
+// ============================================================================
+//
+// 不做比较的排序，适合整数、浮点数和字符串键：
+// - 整数 / 浮点数：LSD（低位优先）按字节分配，每趟 O(n)，最多 sizeof(K) 趟。
+//   键先变换成无符号整数，使其无符号顺序与原类型的 < 一致：
+//     有符号整数翻转符号位；浮点数负数翻转全部位、非负数只翻转符号位。
+//   所有元素某一字节都相同时跳过该趟。需要 n 个元素的辅助缓冲区，
+//   可由调用方提供以便重复排序时不再分配。
+// - 字符串（有 data()/size() 的类型，如 std::string、string_view、zen::string）：
+//   MSD（高位优先）American flag 排序，按字节原地分桶，小桶改用插入排序。
+//   只递归较小的桶、最大的桶就地迭代，栈深度 O(log n)，不分配内存。
+// 两者都可以传入键提取函数，按记录中的某个字段排序。
+// 稳定性：LSD 是稳定的；American flag 不稳定。
+// ============================================================================
+
+namespace detail {
+
+template<decltype(sizeof(0)) N> struct radix_uint;
+template<> struct radix_uint<1> { using type = unsigned char; };
+template<> struct radix_uint<2> { using type = unsigned short; };
+template<> struct radix_uint<4> { using type = unsigned int; };
+template<> struct radix_uint<8> { using type = unsigned long long; };
+
+static_assert(sizeof(unsigned int) == 4 && sizeof(unsigned long long) == 8,
+              "radix_sort assumes 32-bit int and 64-bit long long");
+
+/**
+ * @brief 可以做 LSD 基数排序的键：不超过 64 位的整数，32/64 位浮点数
+ */
+template<typename K>
+struct is_radix_key {
+    static constexpr bool value =
+        (is_integral_v<K> && sizeof(K) <= 8) ||
+        (is_floating_point_v<K> && (sizeof(K) == 4 || sizeof(K) == 8));
+};
+
+/**
+ * @brief 可以做 MSD 字符串排序的键：有 data()/size()，元素为单字节
+ */
+template<typename T, typename = void>
+struct is_radix_string {
+    static constexpr bool value = false;
+};
+
+// 只在不求值语境中使用
+template<typename T>
+const T& radix_declval() noexcept;
+
+template<typename T>
+struct is_radix_string<T, decltype(static_cast<void>(
+        radix_declval<T>().data() + radix_declval<T>().size()))> {
+    static constexpr bool value = sizeof(*radix_declval<T>().data()) == 1;
+};
+
+/**
+ * @brief 把键变换为无符号整数，无符号比较的顺序与键的 < 一致
+ */
+template<typename K>
+inline typename radix_uint<sizeof(K)>::type radix_bits(K k) noexcept {
+    using U = typename radix_uint<sizeof(K)>::type;
+    constexpr U sign = static_cast<U>(static_cast<U>(1) << (sizeof(K) * 8 - 1));
+    if constexpr (is_floating_point_v<K>) {
+        U u;
+        memcpy(&u, &k, sizeof(K));
+        return (u & sign) ? static_cast<U>(~u) : static_cast<U>(u | sign);
+    } else if constexpr (static_cast<K>(-1) < static_cast<K>(0)) {
+        return static_cast<U>(static_cast<U>(k) ^ sign);
+    } else {
+        return static_cast<U>(k);
+    }
+}
+
+struct radix_identity {
+    template<typename T>
+    constexpr const T& operator()(const T& x) const noexcept { return x; }
+};
+
+/**
+ * @brief LSD 的一趟分配：按 shift 处的字节把 src 稳定地分配到 dst
+ */
+template<typename Src, typename Dst, typename KeyFn>
+void lsd_scatter(Src src, Dst dst, decltype(sizeof(0)) n, decltype(sizeof(0))* offsets,
+                 unsigned shift, KeyFn& key) {
+    for (decltype(sizeof(0)) i = 0; i < n; ++i) {
+        unsigned b = static_cast<unsigned>((radix_bits(key(src[i])) >> shift) & 0xff);
+        dst[offsets[b]++] = zen::move(src[i]);
+    }
+}
+
+/**
+ * @brief 按键的低 passes 个字节在 a、b 之间来回分配
+ * @return 结果是否落在 b 中
+ */
+template<typename A, typename B, typename KeyFn>
+bool lsd_passes(A a, B b, decltype(sizeof(0)) n, unsigned passes, KeyFn& key) {
+    using size_type = decltype(sizeof(0));
+    using K = typename remove_cvref<decltype(key(a[0]))>::type;
+    using U = typename radix_uint<sizeof(K)>::type;
+
+    // 一次遍历统计所有趟的直方图
+    size_type counts[sizeof(K)][256] = {};
+    for (size_type i = 0; i < n; ++i) {
+        U bits = radix_bits(key(a[i]));
+        for (unsigned p = 0; p < passes; ++p) {
+            ++counts[p][(bits >> (p * 8)) & 0xff];
+        }
+    }
+
+    const U first_bits = radix_bits(key(a[0]));
+    bool in_b = false;
+    for (unsigned p = 0; p < passes; ++p) {
+        size_type* c = counts[p];
+        // 所有元素这一字节都相同，这一趟不改变顺序
+        if (c[(first_bits >> (p * 8)) & 0xff] == n) continue;
+
+        size_type sum = 0;
+        for (unsigned b = 0; b < 256; ++b) {
+            size_type cnt = c[b];
+            c[b] = sum;
+            sum += cnt;
+        }
+        if (in_b) lsd_scatter(b, a, n, c, p * 8, key);
+        else lsd_scatter(a, b, n, c, p * 8, key);
+        in_b = !in_b;
+    }
+    return in_b;
+}
+
+// 超过该长度时先按最高的非常量字节做一趟 MSD 分桶，各桶递归处理，
+// 直到桶能放进缓存后再对更低的字节做 LSD：避免 256 路分配在大数组上的缓存 / TLB 缺失
+constexpr decltype(sizeof(0)) lsd_msd_threshold = decltype(sizeof(0))(1) << 16;
+
+/**
+ * @brief 按键的低 passes 个字节排序 a，b 为等长的辅助区
+ * @return 结果是否落在 b 中
+ */
+template<typename A, typename B, typename KeyFn>
+bool hybrid_radix_sort(A a, B b, decltype(sizeof(0)) n, unsigned passes, KeyFn& key) {
+    using size_type = decltype(sizeof(0));
+    using K = typename remove_cvref<decltype(key(a[0]))>::type;
+    using U = typename radix_uint<sizeof(K)>::type;
+
+    if (n < lsd_msd_threshold || passes <= 1) return lsd_passes(a, b, n, passes, key);
+
+    // 找出低 passes 个字节中最高的、并非所有元素都相同的字节
+    const U first_bits = radix_bits(key(a[0]));
+    U diff = 0;
+    for (size_type i = 0; i < n; ++i) diff |= static_cast<U>(radix_bits(key(a[i])) ^ first_bits);
+    unsigned top = passes;
+    while (top > 0 && ((diff >> ((top - 1) * 8)) & 0xff) == 0) --top;
+    if (top == 0) return false;
+    --top;
+    if (top == 0) return lsd_passes(a, b, n, 1, key);
+
+    const unsigned shift = top * 8;
+    size_type starts[257] = {};
+    for (size_type i = 0; i < n; ++i) {
+        ++starts[((radix_bits(key(a[i])) >> shift) & 0xff) + 1];
+    }
+    for (unsigned k = 1; k < 257; ++k) starts[k] += starts[k - 1];
+    size_type offsets[256];
+    for (unsigned k = 0; k < 256; ++k) offsets[k] = starts[k];
+    lsd_scatter(a, b, n, offsets, shift, key);
+
+    // 各桶排好后统一放回 a
+    for (unsigned k = 0; k < 256; ++k) {
+        size_type size = starts[k + 1] - starts[k];
+        if (size == 0) continue;
+        A dst = a + static_cast<decltype(a - a)>(starts[k]);
+        B src = b + static_cast<decltype(b - b)>(starts[k]);
+        if (size > 1 && hybrid_radix_sort(src, dst, size, top, key)) continue;
+        for (size_type i = 0; i < size; ++i) dst[i] = zen::move(src[i]);
+    }
+    return false;
+}
+
+template<typename RandomIt, typename T, typename KeyFn>
+void lsd_radix_sort(RandomIt first, decltype(sizeof(0)) n, T* scratch, KeyFn& key) {
+    using K = typename remove_cvref<decltype(key(*first))>::type;
+    if (n < 2) return;
+    if (hybrid_radix_sort(first, scratch, n, sizeof(K), key)) {
+        for (decltype(sizeof(0)) i = 0; i < n; ++i) first[i] = zen::move(scratch[i]);
+    }
+}
+
+/**
+ * @brief 不提供辅助缓冲区时临时分配一块
+ */
+template<typename RandomIt, typename KeyFn>
+void lsd_radix_sort_alloc(RandomIt first, decltype(sizeof(0)) n, KeyFn& key) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    if (n < 2) return;
+    if constexpr (is_trivially_copyable_v<value_type>) {
+        value_type* tmp = static_cast<value_type*>(::operator new(n * sizeof(value_type)));
+        lsd_radix_sort(first, n, tmp, key);
+        ::operator delete(tmp);
+    } else {
+        value_type* tmp = new value_type[n];
+        lsd_radix_sort(first, n, tmp, key);
+        delete[] tmp;
+    }
+}
+
+constexpr decltype(sizeof(0)) msd_insertion_threshold = 32;
+
+/**
+ * @brief 第 depth 个字节所在的桶：0 表示字符串在此之前已结束，否则为字节值 + 1
+ */
+template<typename T, typename KeyFn>
+inline unsigned msd_bucket(const T& x, decltype(sizeof(0)) depth, KeyFn& key) {
+    decltype(auto) k = key(x);
+    return k.size() > depth ? 1u + static_cast<unsigned char>(k.data()[depth]) : 0u;
+}
+
+/**
+ * @brief 比较前 depth 个字节都相同的两个键的剩余部分
+ */
+template<typename T, typename KeyFn>
+inline bool msd_less(const T& a, const T& b, decltype(sizeof(0)) depth, KeyFn& key) {
+    decltype(auto) ka = key(a);
+    decltype(auto) kb = key(b);
+    auto la = static_cast<decltype(sizeof(0))>(ka.size());
+    auto lb = static_cast<decltype(sizeof(0))>(kb.size());
+    auto len = (la < lb ? la : lb) - depth;
+    int r = len ? memcmp(ka.data() + depth, kb.data() + depth, len) : 0;
+    return r != 0 ? r < 0 : la < lb;
+}
+
+template<typename RandomIt, typename KeyFn>
+void msd_insertion_sort(RandomIt first, decltype(sizeof(0)) n, decltype(sizeof(0)) depth, KeyFn& key) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    for (decltype(sizeof(0)) i = 1; i < n; ++i) {
+        if (!msd_less(first[i], first[i - 1], depth, key)) continue;
+        value_type tmp = zen::move(first[i]);
+        decltype(sizeof(0)) j = i;
+        do {
+            first[j] = zen::move(first[j - 1]);
+            --j;
+        } while (j > 0 && msd_less(tmp, first[j - 1], depth, key));
+        first[j] = zen::move(tmp);
+    }
+}
+
+/**
+ * @brief American flag 排序：区间内所有键的前 depth 个字节相同
+ */
+template<typename RandomIt, typename KeyFn>
+void american_flag_sort(RandomIt first, decltype(sizeof(0)) n, decltype(sizeof(0)) depth, KeyFn& key) {
+    using size_type = decltype(sizeof(0));
+
+    while (true) {
+        if (n < msd_insertion_threshold) {
+            msd_insertion_sort(first, n, depth, key);
+            return;
+        }
+
+        // starts[b] .. starts[b + 1] 为桶 b 的范围；next[b] 为桶 b 中下一个待归位的位置
+        size_type starts[258] = {};
+        for (size_type i = 0; i < n; ++i) ++starts[msd_bucket(first[i], depth, key) + 1];
+        for (unsigned b = 1; b < 258; ++b) starts[b] += starts[b - 1];
+
+        size_type next[257];
+        for (unsigned b = 0; b < 257; ++b) next[b] = starts[b];
+
+        // 原地置换：每次交换都把一个元素放进它最终所在的桶
+        for (unsigned b = 0; b < 257; ++b) {
+            while (next[b] < starts[b + 1]) {
+                unsigned c = msd_bucket(first[next[b]], depth, key);
+                if (c == b) ++next[b];
+                else zen::swap(first[next[b]], first[next[c]++]);
+            }
+        }
+
+        // 桶 0 的字符串已全部相等；其余桶中较小的递归，最大的一个就地继续
+        unsigned largest = 1;
+        for (unsigned b = 2; b < 257; ++b) {
+            if (starts[b + 1] - starts[b] > starts[largest + 1] - starts[largest]) largest = b;
+        }
+        for (unsigned b = 1; b < 257; ++b) {
+            size_type size = starts[b + 1] - starts[b];
+            if (b != largest && size > 1) {
+                american_flag_sort(first + static_cast<decltype(first - first)>(starts[b]), size, depth + 1, key);
+            }
+        }
+
+        first = first + static_cast<decltype(first - first)>(starts[largest]);
+        n = starts[largest + 1] - starts[largest];
+        ++depth;
+    }
+}
+
+template<typename RandomIt, typename KeyFn>
+void radix_sort_dispatch(RandomIt first, RandomIt last, KeyFn& key) {
+    using K = typename remove_cvref<decltype(key(*first))>::type;
+    auto n = static_cast<decltype(sizeof(0))>(last - first);
+    if constexpr (is_radix_key<K>::value) {
+        lsd_radix_sort_alloc(first, n, key);
+    } else {
+        static_assert(is_radix_string<K>::value,
+                      "radix_sort keys must be integers, float/double, or byte strings with data()/size()");
+        if (n > 1) american_flag_sort(first, n, 0, key);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief 基数排序：整数 / 浮点数用 LSD，字符串用 MSD（American flag）
+ *
+ * 整数与浮点数按 < 升序（-0.0 排在 +0.0 之前）；字符串按字节无符号字典序，
+ * 与 std::string 的 < 一致。整数键需要临时分配 n 个元素的缓冲区。
+ */
+template<typename RandomIt>
+void radix_sort(RandomIt first, RandomIt last) {
+    detail::radix_identity key;
+    detail::radix_sort_dispatch(first, last, key);
+}
+
+/**
+ * @brief 基数排序，按 key(element) 提取的整数 / 浮点 / 字符串键排序
+ *
+ * LSD 路径是稳定的，可用于多关键字排序（先按次要字段、再按主要字段）。
+ */
+template<typename RandomIt, typename KeyFn, typename = enable_if_t<!is_pointer_v<KeyFn>>>
+void radix_sort(RandomIt first, RandomIt last, KeyFn key) {
+    detail::radix_sort_dispatch(first, last, key);
+}
+
+/**
+ * @brief LSD 基数排序，使用调用方提供的辅助缓冲区（不分配内存）
+ *
+ * @param scratch 至少 last - first 个已构造元素的缓冲区，排序后内容未指定
+ */
+template<typename RandomIt>
+void radix_sort(RandomIt first, RandomIt last,
+                typename zen::iterator_traits<RandomIt>::value_type* scratch) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    static_assert(detail::is_radix_key<value_type>::value, "scratch buffers are only used by integer/float keys");
+    detail::radix_identity key;
+    detail::lsd_radix_sort(first, static_cast<decltype(sizeof(0))>(last - first), scratch, key);
+}
+
+template<typename RandomIt, typename KeyFn>
+void radix_sort(RandomIt first, RandomIt last, KeyFn key,
+                typename zen::iterator_traits<RandomIt>::value_type* scratch) {
+    using K = typename remove_cvref<decltype(key(*first))>::type;
+    static_assert(detail::is_radix_key<K>::value, "scratch buffers are only used by integer/float keys");
+    detail::lsd_radix_sort(first, static_cast<decltype(sizeof(0))>(last - first), scratch, key);
+}
+
+} // namespace zen
+
+#endif // ZEN_ALGORITHMS_RADIX_SORT_H
@@ -6,84 +6,49 @@
 #include "../iterators/iterator_base.h"
 #include "../utility/pair.h"
 #include "comparators.h"
+#include "radix_sort.h"
+#include <memory>
+#include <new>
 
 namespace zen {
 
+template<typename ForwardIt, typename Compare>
+void insertion_sort(ForwardIt first, ForwardIt last, Compare comp);
+
 // ============================================================================
-// 快速排序（Quick Sort）
+// 归并排序（Merge Sort）- 原地版本
 // ============================================================================
 
+namespace detail {
+
 /**
- * @brief 快速排序（原地分区版本）
- *
- * 平均复杂度：O(n log n)，最坏 O(n²)（已优化：三数取中 + 插入排序小数组）
- * 不稳定排序
+ * @brief 归并缓冲区（operator new 得到的原始内存）的删除器：析构 [0, constructed) 后释放
  *
- * @tparam RandomIt 随机访问迭代器
- * @tparam Compare  比较函数对象
- * @param first    区间起始
- * @param last     区间结束（不含）
- * @param comp     比较函数，默认 less<T>
+ * 缓冲区由 unique_ptr 持有，比较或移动抛异常时已构造的元素同样会被析构。
  */
-template<typename RandomIt, typename Compare>
-void quick_sort(RandomIt first, RandomIt last, Compare comp) {
-    if (first >= last - 1) return;
-
-    // 小数组用插入排序（阈值 16）
-    size_t dist = static_cast<size_t>(last - first);
-    if (dist <= 16) {
-        for (RandomIt i = first + 1; i < last; ++i) {
-            auto key = zen::move(*i);
-            RandomIt j = i;
-            while (j > first && comp(key, *(j - 1))) {
-                *j = zen::move(*(j - 1));
-                --j;
-            }
-            *j = zen::move(key);
-        }
-        return;
-    }
-
-    // 三数取中选 pivot
-    RandomIt mid = first + (last - first) / 2;
-    if (comp(*mid, *first))  zen::swap(*mid, *first);
-    if (comp(*(last - 1), *first)) zen::swap(*(last - 1), *first);
-    if (comp(*(last - 1), *mid)) zen::swap(*(last - 1), *mid);
+template<typename T>
+struct merge_buffer_deleter {
+    size_t constructed = 0;
 
-    auto pivot = *(last - 1);
-
-    // 分区
-    RandomIt i = first;
-    RandomIt j = last - 1;
-    while (true) {
-        while (i < last && comp(*i, pivot)) ++i;
-        while (j > first && !comp(*(j - 1), pivot)) --j;
-        if (i >= j) break;
-        zen::swap(*i, *j);
-        ++i; --j;
+    void operator()(T* p) const noexcept {
+        if constexpr (!is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < constructed; ++i) p[i].~T();
+        }
+        ::operator delete(p);
     }
-    zen::swap(*i, *(last - 1));
+};
 
-    // 递归排序
-    quick_sort(first, i, comp);
-    quick_sort(i + 1, last, comp);
-}
+template<typename T>
+using merge_buffer = std::unique_ptr<T, merge_buffer_deleter<T>>;
 
-template<typename RandomIt>
-void quick_sort(RandomIt first, RandomIt last) {
-    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
-    quick_sort(first, last, less<value_type>());
-}
-
-// ============================================================================
-// 归并排序（Merge Sort）- 原地版本
-// ============================================================================
+} // namespace detail
 
 /**
  * @brief 归并排序（原地版本，使用临时缓冲区）
  *
  * 复杂度：O(n log n)
- * 稳定排序
+ * 稳定排序：先对长度 32 的段做插入排序，再自底向上归并，
+ * 相等元素总是先取左侧；数据在原区间与缓冲区之间往返，每轮只搬运一次。
  *
  * @tparam RandomIt 随机访问迭代器
  * @tparam Compare  比较函数对象
@@ -94,37 +59,45 @@ void merge_sort(RandomIt first, RandomIt last, Compare comp) {
     if (n <= 1) return;
 
     using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    constexpr size_t run = 32;
 
-    // 临时缓冲区
-    value_type* tmp = static_cast<value_type*>(::operator new(n * sizeof(value_type)));
+    for (size_t i = 0; i < n; i += run) {
+        insertion_sort(first + i, first + (i + run < n ? i + run : n), comp);
+    }
+    if (n <= run) return;
+
+    // 临时缓冲区：先把元素移动构造进去，之后两边都是已构造的对象，只做移动赋值
+    detail::merge_buffer<value_type> owner(static_cast<value_type*>(::operator new(n * sizeof(value_type))));
+    value_type* tmp = owner.get();
+    for (size_t i = 0; i < n; ++i) {
+        ::new (static_cast<void*>(tmp + i)) value_type(zen::move(*(first + i)));
+        ++owner.get_deleter().constructed;
+    }
 
-    // 自底向上归并
-    for (size_t width = 1; width < n; width *= 2) {
+    // 自底向上归并：src -> dst，每轮交换角色
+    auto merge_pass = [&](auto src, auto dst, size_t width) {
         for (size_t i = 0; i < n; i += 2 * width) {
-            size_t left  = i;
             size_t mid   = (i + width < n) ? i + width : n;
             size_t right = (i + 2 * width < n) ? i + 2 * width : n;
-
-            // 归并到临时区
-            size_t l = left, r = mid, k = left;
+            size_t l = i, r = mid, k = i;
             while (l < mid && r < right) {
-                if (comp(*(first + l), *(first + r))) {
-                    tmp[k++] = zen::move(*(first + l++));
-                } else {
-                    tmp[k++] = zen::move(*(first + r++));
-                }
-            }
-            while (l < mid)  tmp[k++] = zen::move(*(first + l++));
-            while (r < right) tmp[k++] = zen::move(*(first + r++));
-
-            // 拷贝回原数组
-            for (size_t p = left; p < right; ++p) {
-                *(first + p) = zen::move(tmp[p]);
+                if (comp(*(src + r), *(src + l))) *(dst + k++) = zen::move(*(src + r++));
+                else                              *(dst + k++) = zen::move(*(src + l++));
             }
+            while (l < mid)   *(dst + k++) = zen::move(*(src + l++));
+            while (r < right) *(dst + k++) = zen::move(*(src + r++));
         }
-    }
+    };
 
-    ::operator delete(tmp);
+    bool in_tmp = true;
+    for (size_t width = run; width < n; width *= 2) {
+        if (in_tmp) merge_pass(tmp, first, width);
+        else        merge_pass(first, tmp, width);
+        in_tmp = !in_tmp;
+    }
+    if (in_tmp) {
+        for (size_t i = 0; i < n; ++i) *(first + i) = zen::move(tmp[i]);
+    }
 }
 
 template<typename RandomIt>
@@ -246,21 +219,534 @@ void selection_sort(ForwardIt first, ForwardIt last) {
 }
 
 // ============================================================================
-// 默认 sort（使用快速排序）
+// pdqsort（Pattern-Defeating Quicksort）
+// ============================================================================
+//
+// zen::sort 的实现，在 introsort 基础上加入 pdqsort 的模式识别：
+// - 小区间（< 24）用插入排序；非最左子区间用无哨兵检查的插入排序
+// - 三数取中 / 大区间用 ninther 选 pivot，pivot 原地移出，不做拷贝
+// - 分区后若区间已经有序（没有发生交换），尝试有限步数的插入排序，
+//   对已排序 / 近乎有序的输入整体退化为 O(n)
+// - 与前一个 pivot 相等的区间整体划到左边（partition_left），
+//   大量重复元素时为 O(n·k)（k 为不同值的个数）
+// - 分区严重失衡时打乱若干元素破坏对抗模式；失衡次数超过 log n
+//   或递归深度超过 2·log n 时改用堆排序，最坏 O(n log n)
+// - 对算术类型 + less/greater 比较器使用 BlockQuicksort 式的无分支分块分区，
+//   比较结果只写入偏移缓冲区，消除分支预测失败
+// 入口处另外检测整体升序 / 降序的输入（降序直接翻转）。
+// ============================================================================
+
+namespace detail {
+
+constexpr decltype(sizeof(0)) pdq_insertion_threshold = 24;
+constexpr decltype(sizeof(0)) pdq_ninther_threshold   = 128;
+constexpr decltype(sizeof(0)) pdq_partial_limit       = 8;
+constexpr decltype(sizeof(0)) pdq_block_size          = 64;
+
+/**
+ * @brief 比较器对算术类型只是普通的 < / >，可以走无分支分区
+ */
+template<typename T, typename Compare>
+struct is_branchless_compare {
+    static constexpr bool value = false;
+};
+
+template<typename T>
+struct is_branchless_compare<T, less<T>> {
+    static constexpr bool value = is_integral_v<T> || is_floating_point_v<T> || is_pointer_v<T>;
+};
+
+template<typename T>
+struct is_branchless_compare<T, greater<T>> {
+    static constexpr bool value = is_integral_v<T> || is_floating_point_v<T> || is_pointer_v<T>;
+};
+
+inline int floor_log2(decltype(sizeof(0)) n) {
+    int log = 0;
+    while (n >>= 1) ++log;
+    return log;
+}
+
+template<typename RandomIt, typename Compare>
+inline void sort2(RandomIt a, RandomIt b, Compare& comp) {
+    if (comp(*b, *a)) zen::swap(*a, *b);
+}
+
+template<typename RandomIt, typename Compare>
+inline void sort3(RandomIt a, RandomIt b, RandomIt c, Compare& comp) {
+    sort2(a, b, comp);
+    sort2(b, c, comp);
+    sort2(a, b, comp);
+}
+
+/**
+ * @brief 有哨兵检查的插入排序（用于最左侧区间）
+ */
+template<typename RandomIt, typename Compare>
+void pdq_insertion_sort(RandomIt begin, RandomIt end, Compare& comp) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    if (begin == end) return;
+
+    for (RandomIt cur = begin + 1; cur != end; ++cur) {
+        RandomIt sift = cur;
+        RandomIt sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            value_type tmp = zen::move(*sift);
+            do {
+                *sift-- = zen::move(*sift_1);
+            } while (sift != begin && comp(tmp, *--sift_1));
+            *sift = zen::move(tmp);
+        }
+    }
+}
+
+/**
+ * @brief 无边界检查的插入排序
+ * @pre *(begin - 1) 不大于区间内任何元素（上一次分区的 pivot 充当哨兵）
+ */
+template<typename RandomIt, typename Compare>
+void pdq_unguarded_insertion_sort(RandomIt begin, RandomIt end, Compare& comp) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    if (begin == end) return;
+
+    for (RandomIt cur = begin + 1; cur != end; ++cur) {
+        RandomIt sift = cur;
+        RandomIt sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            value_type tmp = zen::move(*sift);
+            do {
+                *sift-- = zen::move(*sift_1);
+            } while (comp(tmp, *--sift_1));
+            *sift = zen::move(tmp);
+        }
+    }
+}
+
+/**
+ * @brief 尝试插入排序，元素移动总数超过 pdq_partial_limit 时放弃
+ * @return 区间是否已经排好
+ */
+template<typename RandomIt, typename Compare>
+bool pdq_partial_insertion_sort(RandomIt begin, RandomIt end, Compare& comp) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    if (begin == end) return true;
+
+    decltype(sizeof(0)) limit = 0;
+    for (RandomIt cur = begin + 1; cur != end; ++cur) {
+        RandomIt sift = cur;
+        RandomIt sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            value_type tmp = zen::move(*sift);
+            do {
+                *sift-- = zen::move(*sift_1);
+            } while (sift != begin && comp(tmp, *--sift_1));
+            *sift = zen::move(tmp);
+            limit += static_cast<decltype(sizeof(0))>(cur - sift);
+        }
+        if (limit > pdq_partial_limit) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 按偏移缓冲区交换左右两侧放错位置的元素
+ *
+ * 两侧个数相同时逐对 swap；否则用一次循环置换，少一半的移动。
+ */
+template<typename RandomIt>
+void pdq_swap_offsets(RandomIt first, RandomIt last,
+                      const unsigned char* offsets_l, const unsigned char* offsets_r,
+                      decltype(sizeof(0)) num, bool use_swaps) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    if (use_swaps) {
+        for (decltype(sizeof(0)) i = 0; i < num; ++i) {
+            zen::swap(*(first + offsets_l[i]), *(last - offsets_r[i]));
+        }
+    } else if (num > 0) {
+        RandomIt l = first + offsets_l[0];
+        RandomIt r = last - offsets_r[0];
+        value_type tmp(zen::move(*l));
+        *l = zen::move(*r);
+        for (decltype(sizeof(0)) i = 1; i < num; ++i) {
+            l = first + offsets_l[i];
+            *r = zen::move(*l);
+            r = last - offsets_r[i];
+            *l = zen::move(*r);
+        }
+        *r = zen::move(tmp);
+    }
+}
+
+/**
+ * @brief 以 *begin 为 pivot 分区：左侧 < pivot，右侧 >= pivot（分支版）
+ * @return (pivot 最终位置, 分区前是否已经满足划分)
+ */
+template<typename RandomIt, typename Compare>
+pair<RandomIt, bool> pdq_partition_right(RandomIt begin, RandomIt end, Compare& comp) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    value_type pivot(zen::move(*begin));
+    RandomIt first = begin;
+    RandomIt last = end;
+
+    // 三数取中保证了右侧存在 >= pivot 的元素，左扫描无需边界检查
+    while (comp(*++first, pivot)) {}
+    if (first - 1 == begin) {
+        while (first < last && !comp(*--last, pivot)) {}
+    } else {
+        while (!comp(*--last, pivot)) {}
+    }
+
+    bool already_partitioned = first >= last;
+    while (first < last) {
+        zen::swap(*first, *last);
+        while (comp(*++first, pivot)) {}
+        while (!comp(*--last, pivot)) {}
+    }
+
+    RandomIt pivot_pos = first - 1;
+    *begin = zen::move(*pivot_pos);
+    *pivot_pos = zen::move(pivot);
+    return pair<RandomIt, bool>(pivot_pos, already_partitioned);
+}
+
+/**
+ * @brief pdq_partition_right 的无分支分块版本（BlockQuicksort）
+ *
+ * 每次在左右各扫描一块 pdq_block_size 个元素，把放错位置的元素偏移
+ * 无条件写入缓冲区、只按比较结果推进计数，再成批交换。
+ */
+template<typename RandomIt, typename Compare>
+pair<RandomIt, bool> pdq_partition_right_branchless(RandomIt begin, RandomIt end, Compare& comp) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    using size_type = decltype(sizeof(0));
+    value_type pivot(zen::move(*begin));
+    RandomIt first = begin;
+    RandomIt last = end;
+
+    while (comp(*++first, pivot)) {}
+    if (first - 1 == begin) {
+        while (first < last && !comp(*--last, pivot)) {}
+    } else {
+        while (!comp(*--last, pivot)) {}
+    }
+
+    bool already_partitioned = first >= last;
+    if (!already_partitioned) {
+        zen::swap(*first, *last);
+        ++first;
+
+        alignas(64) unsigned char offsets_l[pdq_block_size];
+        alignas(64) unsigned char offsets_r[pdq_block_size];
+
+        RandomIt offsets_l_base = first;
+        RandomIt offsets_r_base = last;
+        size_type num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+        while (first < last) {
+            // 只有一侧缓冲区用完时才去扫描那一侧；剩余不足两块时按比例切分
+            size_type num_unknown = static_cast<size_type>(last - first);
+            size_type left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+            size_type right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+            if (left_split >= pdq_block_size) {
+                for (size_type i = 0; i < pdq_block_size; ) {
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                }
+            } else {
+                for (size_type i = 0; i < left_split; ) {
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                }
+            }
+
+            if (right_split >= pdq_block_size) {
+                for (size_type i = 0; i < pdq_block_size; ) {
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                }
+            } else {
+                for (size_type i = 0; i < right_split; ) {
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                }
+            }
+
+            size_type num = num_l < num_r ? num_l : num_r;
+            pdq_swap_offsets(offsets_l_base, offsets_r_base,
+                             offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+            num_l -= num; num_r -= num;
+            start_l += num; start_r += num;
+            if (num_l == 0) { start_l = 0; offsets_l_base = first; }
+            if (num_r == 0) { start_r = 0; offsets_r_base = last; }
+        }
+
+        // 扫描结束后最多一侧还有残留，把它们换到分界处
+        if (num_l) {
+            const unsigned char* offs = offsets_l + start_l;
+            while (num_l--) zen::swap(*(offsets_l_base + offs[num_l]), *--last);
+            first = last;
+        }
+        if (num_r) {
+            const unsigned char* offs = offsets_r + start_r;
+            while (num_r--) { zen::swap(*(offsets_r_base - offs[num_r]), *first); ++first; }
+            last = first;
+        }
+    }
+
+    RandomIt pivot_pos = first - 1;
+    *begin = zen::move(*pivot_pos);
+    *pivot_pos = zen::move(pivot);
+    return pair<RandomIt, bool>(pivot_pos, already_partitioned);
+}
+
+/**
+ * @brief 以 *begin 为 pivot 分区：左侧 <= pivot，右侧 > pivot
+ *
+ * 当 pivot 与左邻区间的哨兵相等时使用，把所有等于 pivot 的元素一次性收走。
+ * @return pivot 最终位置
+ */
+template<typename RandomIt, typename Compare>
+RandomIt pdq_partition_left(RandomIt begin, RandomIt end, Compare& comp) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    value_type pivot(zen::move(*begin));
+    RandomIt first = begin;
+    RandomIt last = end;
+
+    while (comp(pivot, *--last)) {}
+    if (last + 1 == end) {
+        while (first < last && !comp(pivot, *++first)) {}
+    } else {
+        while (!comp(pivot, *++first)) {}
+    }
+
+    while (first < last) {
+        zen::swap(*first, *last);
+        while (comp(pivot, *--last)) {}
+        while (!comp(pivot, *++first)) {}
+    }
+
+    RandomIt pivot_pos = last;
+    *begin = zen::move(*pivot_pos);
+    *pivot_pos = zen::move(pivot);
+    return pivot_pos;
+}
+
+/**
+ * @brief pdqsort 主循环：较小的一侧递归，另一侧迭代
+ *
+ * @param bad_allowed 还允许出现的严重失衡分区次数
+ * @param depth_limit 剩余的分区层数（2·log n）
+ * @param leftmost    区间左侧是否没有可作哨兵的元素
+ */
+template<bool Branchless, typename RandomIt, typename Compare>
+void pdqsort_loop(RandomIt begin, RandomIt end, Compare& comp,
+                  int bad_allowed, int depth_limit, bool leftmost) {
+    using size_type = decltype(sizeof(0));
+
+    while (true) {
+        size_type size = static_cast<size_type>(end - begin);
+
+        if (size < pdq_insertion_threshold) {
+            if (leftmost) pdq_insertion_sort(begin, end, comp);
+            else pdq_unguarded_insertion_sort(begin, end, comp);
+            return;
+        }
+
+        if (depth_limit-- == 0) {
+            heap_sort(begin, end, comp);
+            return;
+        }
+
+        // 选 pivot 并放到 *begin：大区间用 ninther（三组三数取中的中位数）
+        size_type s2 = size / 2;
+        if (size > pdq_ninther_threshold) {
+            sort3(begin, begin + s2, end - 1, comp);
+            sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+            sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+            sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+            zen::swap(*begin, *(begin + s2));
+        } else {
+            sort3(begin + s2, begin, end - 1, comp);
+        }
+
+        // pivot 等于左邻哨兵：区间中没有比它更小的元素，等值元素整体划到左侧后跳过
+        if (!leftmost && !comp(*(begin - 1), *begin)) {
+            begin = pdq_partition_left(begin, end, comp) + 1;
+            continue;
+        }
+
+        pair<RandomIt, bool> part = Branchless
+            ? pdq_partition_right_branchless(begin, end, comp)
+            : pdq_partition_right(begin, end, comp);
+        RandomIt pivot_pos = part.first;
+        bool already_partitioned = part.second;
+
+        size_type l_size = static_cast<size_type>(pivot_pos - begin);
+        size_type r_size = static_cast<size_type>(end - (pivot_pos + 1));
+        bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+        if (highly_unbalanced) {
+            if (--bad_allowed == 0) {
+                heap_sort(begin, end, comp);
+                return;
+            }
+
+            // 交换若干固定位置的元素，打破导致失衡的输入模式
+            if (l_size >= pdq_insertion_threshold) {
+                zen::swap(*begin, *(begin + l_size / 4));
+                zen::swap(*(pivot_pos - 1), *(pivot_pos - l_size / 4));
+                if (l_size > pdq_ninther_threshold) {
+                    zen::swap(*(begin + 1), *(begin + (l_size / 4 + 1)));
+                    zen::swap(*(begin + 2), *(begin + (l_size / 4 + 2)));
+                    zen::swap(*(pivot_pos - 2), *(pivot_pos - (l_size / 4 + 1)));
+                    zen::swap(*(pivot_pos - 3), *(pivot_pos - (l_size / 4 + 2)));
+                }
+            }
+            if (r_size >= pdq_insertion_threshold) {
+                zen::swap(*(pivot_pos + 1), *(pivot_pos + (1 + r_size / 4)));
+                zen::swap(*(end - 1), *(end - r_size / 4));
+                if (r_size > pdq_ninther_threshold) {
+                    zen::swap(*(pivot_pos + 2), *(pivot_pos + (2 + r_size / 4)));
+                    zen::swap(*(pivot_pos + 3), *(pivot_pos + (3 + r_size / 4)));
+                    zen::swap(*(end - 2), *(end - (1 + r_size / 4)));
+                    zen::swap(*(end - 3), *(end - (2 + r_size / 4)));
+                }
+            }
+        } else if (already_partitioned
+                   && pdq_partial_insertion_sort(begin, pivot_pos, comp)
+                   && pdq_partial_insertion_sort(pivot_pos + 1, end, comp)) {
+            // 分区时一次交换都没有，且两侧都接近有序：整段已排好
+            return;
+        }
+
+        // 较小一侧递归，保证栈深度 O(log n)
+        if (l_size < r_size) {
+            pdqsort_loop<Branchless>(begin, pivot_pos, comp, bad_allowed, depth_limit, leftmost);
+            begin = pivot_pos + 1;
+            leftmost = false;
+        } else {
+            pdqsort_loop<Branchless>(pivot_pos + 1, end, comp, bad_allowed, depth_limit, false);
+            end = pivot_pos;
+        }
+    }
+}
+
+/**
+ * @brief 检测整体单调的输入
+ *
+ * 已升序时直接返回 true；整体降序（不严格）时原地翻转并返回 true。
+ * 一旦发现方向被破坏立即停止，随机输入只多几次比较。
+ */
+template<typename RandomIt, typename Compare>
+bool pdq_sorted_run(RandomIt begin, RandomIt end, Compare& comp) {
+    RandomIt i = begin + 1;
+    if (comp(*i, *begin)) {
+        while (++i != end && !comp(*(i - 1), *i)) {}
+        if (i != end) return false;
+        for (RandomIt l = begin, r = end - 1; l < r; ++l, --r) zen::swap(*l, *r);
+        return true;
+    }
+    while (++i != end && !comp(*i, *(i - 1))) {}
+    return i == end;
+}
+
+} // namespace detail
+
+/**
+ * @brief pdqsort：模式消除快速排序
+ *
+ * 复杂度：平均 O(n log n)，最坏 O(n log n)（堆排序兜底）；
+ * 有序、逆序输入 O(n)；递归栈深度 O(log n)
+ * 不稳定排序
+ */
+template<typename RandomIt, typename Compare>
+void pdqsort(RandomIt first, RandomIt last, Compare comp) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    if (last - first < 2) return;
+    if (detail::pdq_sorted_run(first, last, comp)) return;
+
+    int log_n = detail::floor_log2(static_cast<decltype(sizeof(0))>(last - first));
+    detail::pdqsort_loop<detail::is_branchless_compare<value_type, Compare>::value>(
+        first, last, comp, log_n, 2 * log_n, true);
+}
+
+template<typename RandomIt>
+void pdqsort(RandomIt first, RandomIt last) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    pdqsort(first, last, zen::less<value_type>{});
+}
+
+// ============================================================================
+// 快速排序（Quick Sort）
+// ============================================================================
+
+/**
+ * @brief 快速排序
+ *
+ * 保留的旧接口，等同于 pdqsort（见上）：不再有 O(n²) 最坏情况和无界递归。
+ * 不稳定排序
+ */
+template<typename RandomIt, typename Compare>
+void quick_sort(RandomIt first, RandomIt last, Compare comp) {
+    pdqsort(first, last, comp);
+}
+
+template<typename RandomIt>
+void quick_sort(RandomIt first, RandomIt last) {
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    quick_sort(first, last, less<value_type>());
+}
+
 // ============================================================================
+// 默认 sort（使用 pdqsort，算术类型大数组用 radix_sort）
+// ============================================================================
+
+namespace detail {
+
+// 默认比较器下，不小于该长度、键宽不超过 32 位的整数 / 浮点数组改用基数排序。
+// 64 位键需要 8 趟分配，实测与 pdqsort 互有胜负，不自动切换
+constexpr decltype(sizeof(0)) radix_sort_threshold = 2048;
+
+template<typename T>
+struct prefers_radix_sort {
+    static constexpr bool value = is_radix_key<T>::value && sizeof(T) <= 4;
+};
+
+} // namespace detail
 
 /**
- * @brief 默认排序（quick_sort）
+ * @brief 默认排序（pdqsort）
+ *
+ * 比较器为 less<T> 且 T 为不超过 32 位的整数 / 浮点数时，较大的区间改用
+ * radix_sort（需要临时分配 n 个元素的缓冲区；不想分配时直接调用 pdqsort）。
  */
 template<typename RandomIt, typename Compare>
 void sort(RandomIt first, RandomIt last, Compare comp) {
-    quick_sort(first, last, comp);
+    using value_type = typename zen::iterator_traits<RandomIt>::value_type;
+    if constexpr (is_same_v<Compare, less<value_type>> && detail::prefers_radix_sort<value_type>::value) {
+        if (static_cast<decltype(sizeof(0))>(last - first) >= detail::radix_sort_threshold) {
+            radix_sort(first, last);
+            return;
+        }
+    }
+    pdqsort(first, last, comp);
 }
 
 template<typename RandomIt>
 void sort(RandomIt first, RandomIt last) {
     using value_type = typename zen::iterator_traits<RandomIt>::value_type;
-    sort(first, last, zen::less<value_type>{});
+    zen::sort(first, last, zen::less<value_type>{});
 }
 
 // ============================================================================
@@ -275,7 +761,7 @@ void stable_sort(RandomIt first, RandomIt last, Compare comp) {
 template<typename RandomIt>
 void stable_sort(RandomIt first, RandomIt last) {
     using value_type = typename zen::iterator_traits<RandomIt>::value_type;
-    stable_sort(first, last, less<value_type>{});
+    zen::stable_sort(first, last, less<value_type>{});
 }
 
 // ============================================================================
@@ -296,7 +782,7 @@ void partial_sort(RandomIt first, RandomIt middle, RandomIt last, Compare comp)
 template<typename RandomIt>
 void partial_sort(RandomIt first, RandomIt middle, RandomIt last) {
     using value_type = typename zen::iterator_traits<RandomIt>::value_type;
-    partial_sort(first, middle, last, less<value_type>{});
+    zen::partial_sort(first, middle, last, less<value_type>{});
 }
 
 // ============================================================================
@@ -341,7 +827,7 @@ void nth_element(RandomIt first, RandomIt nth, RandomIt last, Compare comp) {
 template<typename RandomIt>
 void nth_element(RandomIt first, RandomIt nth, RandomIt last) {
     using value_type = typename zen::iterator_traits<RandomIt>::value_type;
-    nth_element(first, nth, last, zen::less<value_type>{});
+    zen::nth_element(first, nth, last, zen::less<value_type>{});
 }
 
 // ============================================================================
@@ -363,7 +849,7 @@ bool is_sorted(ForwardIt first, ForwardIt last, Compare comp) {
 template<typename ForwardIt>
 bool is_sorted(ForwardIt first, ForwardIt last) {
     using value_type = typename zen::iterator_traits<ForwardIt>::value_type;
-    return is_sorted(first, last, zen::less<value_type>{});
+    return zen::is_sorted(first, last, zen::less<value_type>{});
 }
 
 } // namespace zen
@@ -2,18 +2,25 @@
  * @file string.h
  * @brief 字符串算法模块
  * @details 提供字符串搜索和匹配算法
- *          包括 KMP、Boyer-Moore、Rabin-Karp、正则表达式等
+ *          包括 KMP、Boyer-Moore、Rabin-Karp、正则表达式等，
+ *          以及 SIMD 子串搜索 / 多分隔符扫描和 string_view 零拷贝切分
  */
 
 #ifndef ZEN_ALGORITHMS_STRING_H
 #define ZEN_ALGORITHMS_STRING_H
 
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <algorithm>
 #include <cctype>
+#include <sstream>
 #include <utility>
+#include "../base/cpu_features.h"
+#include "../utility/hash.h"
 
 namespace zen {
 
@@ -190,8 +197,8 @@ inline std::vector<size_t> rabin_karp_search(
 
     // 计算初始哈希值
     for (size_t i = 0; i < m; ++i) {
-        pattern_hash = (pattern_hash * base + pattern[i]) % mod;
-        text_hash = (text_hash * base + text[i]) % mod;
+        pattern_hash = (pattern_hash * base + static_cast<unsigned char>(pattern[i])) % mod;
+        text_hash = (text_hash * base + static_cast<unsigned char>(text[i])) % mod;
     }
 
     // 滑动窗口
@@ -203,12 +210,10 @@ inline std::vector<size_t> rabin_karp_search(
             }
         }
 
-        // 滚动哈希
+        // 滚动哈希（先加 mod 再减，避免无符号下溢）
         if (i < n - m) {
-            text_hash = ((text_hash - text[i] * highest_power) * base + text[i + m]) % mod;
-            if (text_hash < 0) {
-                text_hash += mod;
-            }
+            size_t leading = static_cast<unsigned char>(text[i]) * highest_power % mod;
+            text_hash = ((text_hash + mod - leading) * base + static_cast<unsigned char>(text[i + m])) % mod;
         }
     }
 
@@ -228,6 +233,396 @@ inline size_t rabin_karp_find_first(
     return positions.empty() ? std::string::npos : positions[0];
 }
 
+// ============================================================================
+// 向量化子串搜索与字节扫描
+// ============================================================================
+//
+// 面向大块文本（日志缓冲区等）的搜索原语，全部以 std::string_view 为参数，
+// 不复制文本：
+// - find_substring(text, pattern)      : 第一个匹配位置
+// - for_each_substring / find_all_substrings : 所有（可重叠的）匹配位置
+// - find_first_of(text, byte_set)      : 第一个属于字节集合的字节（多分隔符）
+// - count_char(text, c)                : 统计某个字节出现的次数（如行数）
+//
+// 子串搜索使用「首尾字节过滤」：每次取 16/32 个候选起点，同时比较候选起点处
+// 的字节与 pattern 首字节、候选终点处的字节与 pattern 尾字节，只有两者都相等
+// 的位置才做 memcmp。对自然文本，误报率很低，吞吐接近内存带宽。
+//
+// 运行期按 cpu_features() 选择 AVX2 / SSE2 / 通用实现，选择结果只计算一次。
+// detail 中的各级实现也可以直接调用（测试与基准用来覆盖每一级）。
+// ============================================================================
+
+/**
+ * @brief 字节集合：用于一次扫描多个分隔符
+ *
+ * 除 256 位位图外，还预先计算两种向量化表示：
+ * - 半字节分类表：字节 c 属于集合 ⇔ (lo[c & 15] & hi[c >> 4]) != 0。
+ *   集合中不同的高半字节不超过 8 个时可用（每个高半字节占一位），
+ *   AVX2 下每 32 字节只需两次 shuffle；常见的 ASCII 分隔符集合都满足。
+ * - 字节列表：不超过 16 个字节时，逐个广播比较后取或。
+ */
+class byte_set {
+public:
+    static constexpr size_t max_listed = 16;
+
+    byte_set() = default;
+
+    /**
+     * @brief 由一组字节构造（重复字节只计一次）
+     */
+    explicit byte_set(std::string_view chars) {
+        for (char ch : chars) insert(static_cast<unsigned char>(ch));
+    }
+
+    void insert(unsigned char c) {
+        if (contains(c)) return;
+        bits_[c >> 6] |= uint64_t(1) << (c & 63);
+        if (count_ < max_listed) chars_[count_] = static_cast<char>(c);
+        ++count_;
+
+        unsigned h = c >> 4;
+        int slot = -1;
+        for (int k = 0; k < 8; ++k) {
+            if (hi_[h] & (1u << k)) { slot = k; break; }
+        }
+        if (slot < 0) {
+            if (nibble_slots_ < 8) {
+                slot = nibble_slots_++;
+                hi_[h] = static_cast<uint8_t>(hi_[h] | (1u << slot));
+            } else {
+                nibble_ok_ = false;
+            }
+        }
+        if (slot >= 0) lo_[c & 15] = static_cast<uint8_t>(lo_[c & 15] | (1u << slot));
+    }
+
+    bool contains(unsigned char c) const noexcept {
+        return (bits_[c >> 6] >> (c & 63)) & 1;
+    }
+
+    size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+
+    // 供向量化实现使用
+    bool listed() const noexcept { return count_ <= max_listed; }
+    bool nibble_classifiable() const noexcept { return nibble_ok_; }
+    const char* chars() const noexcept { return chars_; }
+    const uint8_t* lo_table() const noexcept { return lo_; }
+    const uint8_t* hi_table() const noexcept { return hi_; }
+
+private:
+    uint64_t bits_[4] = {0, 0, 0, 0};
+    size_t   count_ = 0;
+    char     chars_[max_listed] = {};
+    alignas(16) uint8_t lo_[16] = {};
+    alignas(16) uint8_t hi_[16] = {};
+    int      nibble_slots_ = 0;
+    bool     nibble_ok_ = true;
+};
+
+namespace detail {
+
+constexpr size_t scan_npos = static_cast<size_t>(-1);
+
+/** 返回最低位 1 的下标（mask 必须非 0） */
+inline unsigned scan_ctz(uint32_t mask) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned n = 0;
+    while (!(mask & 1u)) { mask >>= 1; ++n; }
+    return n;
+#endif
+}
+
+inline unsigned scan_popcount(uint32_t mask) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_popcount(mask));
+#else
+    unsigned n = 0;
+    for (; mask; mask &= mask - 1) ++n;
+    return n;
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// 子串搜索：s[0, n) 中查找 p[0, m)，返回下标或 scan_npos
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief 通用实现：memchr 定位首字节后 memcmp（也用于向量化版本的尾部）
+ */
+inline size_t find_substring_generic(const char* s, size_t n, const char* p, size_t m) {
+    if (m == 0) return 0;
+    if (m > n) return scan_npos;
+    const char* cur = s;
+    const char* last = s + (n - m);   // 最后一个可能的起点
+    while (cur <= last) {
+        cur = static_cast<const char*>(std::memchr(cur, p[0], static_cast<size_t>(last - cur) + 1));
+        if (!cur) return scan_npos;
+        if (std::memcmp(cur + 1, p + 1, m - 1) == 0) return static_cast<size_t>(cur - s);
+        ++cur;
+    }
+    return scan_npos;
+}
+
+/**
+ * @brief 处理向量化主循环剩下的起点 [i, n - m]
+ */
+inline size_t find_substring_tail(const char* s, size_t n, const char* p, size_t m, size_t i) {
+    size_t r = find_substring_generic(s + i, n - i, p, m);
+    return r == scan_npos ? scan_npos : i + r;
+}
+
+#if ZEN_HAVE_SSE2
+inline size_t find_substring_sse2(const char* s, size_t n, const char* p, size_t m) {
+    if (m < 2 || m > n) return find_substring_generic(s, n, p, m);
+    const __m128i first = _mm_set1_epi8(p[0]);
+    const __m128i last  = _mm_set1_epi8(p[m - 1]);
+    size_t i = 0;
+    // 本轮候选起点 [i, i + 16)，读取的最后一个字节是 s[i + m + 14]
+    for (; i + m + 15 <= n; i += 16) {
+        __m128i bf = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        __m128i bl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m - 1));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(bf, first), _mm_cmpeq_epi8(bl, last))));
+        while (mask) {
+            unsigned bit = scan_ctz(mask);
+            if (std::memcmp(s + i + bit + 1, p + 1, m - 2) == 0) return i + bit;
+            mask &= mask - 1;
+        }
+    }
+    return find_substring_tail(s, n, p, m, i);
+}
+#endif
+
+#if ZEN_HAVE_AVX2_TARGET
+ZEN_TARGET_AVX2
+inline size_t find_substring_avx2(const char* s, size_t n, const char* p, size_t m) {
+    if (m < 2 || m > n) return find_substring_generic(s, n, p, m);
+    const __m256i first = _mm256_set1_epi8(p[0]);
+    const __m256i last  = _mm256_set1_epi8(p[m - 1]);
+    size_t i = 0;
+    for (; i + m + 31 <= n; i += 32) {
+        __m256i bf = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        __m256i bl = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + m - 1));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(bf, first), _mm256_cmpeq_epi8(bl, last))));
+        while (mask) {
+            unsigned bit = scan_ctz(mask);
+            if (std::memcmp(s + i + bit + 1, p + 1, m - 2) == 0) return i + bit;
+            mask &= mask - 1;
+        }
+    }
+    return find_substring_tail(s, n, p, m, i);
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// 多分隔符扫描：s[0, n) 中第一个属于 set 的字节
+// ---------------------------------------------------------------------------
+
+inline size_t find_first_of_generic(const char* s, size_t n, const byte_set& set) {
+    for (size_t i = 0; i < n; ++i) {
+        if (set.contains(static_cast<unsigned char>(s[i]))) return i;
+    }
+    return scan_npos;
+}
+
+#if ZEN_HAVE_SSE2
+inline size_t find_first_of_sse2(const char* s, size_t n, const byte_set& set) {
+    if (!set.listed()) return find_first_of_generic(s, n, set);
+    __m128i needles[byte_set::max_listed];
+    const size_t k = set.size();
+    for (size_t j = 0; j < k; ++j) needles[j] = _mm_set1_epi8(set.chars()[j]);
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        __m128i hit = _mm_setzero_si128();
+        for (size_t j = 0; j < k; ++j) hit = _mm_or_si128(hit, _mm_cmpeq_epi8(v, needles[j]));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hit));
+        if (mask) return i + scan_ctz(mask);
+    }
+    size_t r = find_first_of_generic(s + i, n - i, set);
+    return r == scan_npos ? scan_npos : i + r;
+}
+#endif
+
+#if ZEN_HAVE_AVX2_TARGET
+ZEN_TARGET_AVX2
+inline size_t find_first_of_avx2(const char* s, size_t n, const byte_set& set) {
+    size_t i = 0;
+    if (set.nibble_classifiable()) {
+        const __m256i lo_tbl = _mm256_broadcastsi128_si256(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(set.lo_table())));
+        const __m256i hi_tbl = _mm256_broadcastsi128_si256(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(set.hi_table())));
+        const __m256i low4 = _mm256_set1_epi8(0x0f);
+        const __m256i zero = _mm256_setzero_si256();
+        for (; i + 32 <= n; i += 32) {
+            __m256i v  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+            __m256i lo = _mm256_shuffle_epi8(lo_tbl, _mm256_and_si256(v, low4));
+            __m256i hi = _mm256_shuffle_epi8(hi_tbl, _mm256_and_si256(_mm256_srli_epi16(v, 4), low4));
+            uint32_t miss = static_cast<uint32_t>(_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), zero)));
+            if (miss != 0xffffffffu) return i + scan_ctz(~miss);
+        }
+    } else if (set.listed()) {
+        __m256i needles[byte_set::max_listed];
+        const size_t k = set.size();
+        for (size_t j = 0; j < k; ++j) needles[j] = _mm256_set1_epi8(set.chars()[j]);
+        for (; i + 32 <= n; i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+            __m256i hit = _mm256_setzero_si256();
+            for (size_t j = 0; j < k; ++j) hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(v, needles[j]));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+            if (mask) return i + scan_ctz(mask);
+        }
+    }
+    size_t r = find_first_of_generic(s + i, n - i, set);
+    return r == scan_npos ? scan_npos : i + r;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// 单字节计数
+// ---------------------------------------------------------------------------
+
+inline size_t count_char_generic(const char* s, size_t n, char c) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) count += (s[i] == c);
+    return count;
+}
+
+#if ZEN_HAVE_SSE2
+inline size_t count_char_sse2(const char* s, size_t n, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    size_t count = 0, i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        count += scan_popcount(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle))));
+    }
+    return count + count_char_generic(s + i, n - i, c);
+}
+#endif
+
+#if ZEN_HAVE_AVX2_TARGET
+ZEN_TARGET_AVX2
+inline size_t count_char_avx2(const char* s, size_t n, char c) {
+    // 每次比较结果为 0 / -1，逐字节累减到计数器里，最多 255 轮后用 sad 横向求和
+    const __m256i needle = _mm256_set1_epi8(c);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t count = 0, i = 0;
+    while (i + 32 <= n) {
+        __m256i acc = _mm256_setzero_si256();
+        size_t rounds = (n - i) / 32;
+        if (rounds > 255) rounds = 255;
+        for (size_t r = 0; r < rounds; ++r, i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+            acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(v, needle));
+        }
+        alignas(32) uint64_t sums[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(sums), _mm256_sad_epu8(acc, zero));
+        count += static_cast<size_t>(sums[0] + sums[1] + sums[2] + sums[3]);
+    }
+    return count + count_char_generic(s + i, n - i, c);
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// 运行期分派
+// ---------------------------------------------------------------------------
+
+using find_substring_fn = size_t (*)(const char*, size_t, const char*, size_t);
+using find_first_of_fn  = size_t (*)(const char*, size_t, const byte_set&);
+using count_char_fn     = size_t (*)(const char*, size_t, char);
+
+struct string_scan_kernels {
+    find_substring_fn find_substring = find_substring_generic;
+    find_first_of_fn  find_first_of  = find_first_of_generic;
+    count_char_fn     count_char     = count_char_generic;
+};
+
+inline string_scan_kernels select_string_scan_kernels() {
+    string_scan_kernels k;
+#if ZEN_HAVE_SSE2
+    k.find_substring = find_substring_sse2;
+    k.find_first_of  = find_first_of_sse2;
+    k.count_char     = count_char_sse2;
+#endif
+#if ZEN_HAVE_AVX2_TARGET
+    if (cpu_supports_avx2_target()) {
+        k.find_substring = find_substring_avx2;
+        k.find_first_of  = find_first_of_avx2;
+        k.count_char     = count_char_avx2;
+    }
+#endif
+    return k;
+}
+
+inline const string_scan_kernels& string_scan() {
+    static const string_scan_kernels kernels = select_string_scan_kernels();
+    return kernels;
+}
+
+} // namespace detail
+
+/**
+ * @brief 查找 pattern 在 text 中从 pos 开始的第一次出现
+ * @return 匹配起点；没有匹配时返回 std::string::npos（空 pattern 返回 pos）
+ */
+inline size_t find_substring(std::string_view text, std::string_view pattern, size_t pos = 0) {
+    if (pos > text.size()) return std::string::npos;
+    size_t r = detail::string_scan().find_substring(text.data() + pos, text.size() - pos,
+                                                    pattern.data(), pattern.size());
+    return r == detail::scan_npos ? std::string::npos : pos + r;
+}
+
+/**
+ * @brief 对每个（可重叠的）匹配位置调用 fn(pos)，不分配内存
+ *
+ * fn 返回 bool 时，返回 false 表示停止搜索。
+ */
+template <typename Fn>
+void for_each_substring(std::string_view text, std::string_view pattern, Fn fn) {
+    if (pattern.empty()) return;
+    for (size_t pos = find_substring(text, pattern); pos != std::string::npos;
+         pos = find_substring(text, pattern, pos + 1)) {
+        if constexpr (std::is_same_v<decltype(fn(pos)), bool>) {
+            if (!fn(pos)) return;
+        } else {
+            fn(pos);
+        }
+    }
+}
+
+/**
+ * @brief 查找所有（可重叠的）匹配位置，结果与 kmp_search 相同
+ */
+inline std::vector<size_t> find_all_substrings(std::string_view text, std::string_view pattern) {
+    std::vector<size_t> positions;
+    for_each_substring(text, pattern, [&positions](size_t pos) { positions.push_back(pos); });
+    return positions;
+}
+
+/**
+ * @brief 查找 text 中从 pos 开始第一个属于 set 的字节
+ * @return 下标；没有时返回 std::string::npos
+ */
+inline size_t find_first_of(std::string_view text, const byte_set& set, size_t pos = 0) {
+    if (pos >= text.size()) return std::string::npos;
+    size_t r = detail::string_scan().find_first_of(text.data() + pos, text.size() - pos, set);
+    return r == detail::scan_npos ? std::string::npos : pos + r;
+}
+
+/**
+ * @brief 统计字节 c 在 text 中出现的次数
+ */
+inline size_t count_char(std::string_view text, char c) {
+    return detail::string_scan().count_char(text.data(), text.size(), c);
+}
+
 // ============================================================================
 // 字符串编辑距离 (Levenshtein Distance)
 // ============================================================================
@@ -266,6 +661,155 @@ inline size_t levenshtein_distance(const std::string& str1, const std::string& s
     return dp[m][n];
 }
 
+// ============================================================================
+// 零拷贝切分与裁剪（string_view）
+// ============================================================================
+//
+// 返回指向原文本的 std::string_view，不复制字符；调用方需保证原文本
+// 在使用结果期间存活。tokenize 是惰性的，遍历过程中不分配内存。
+
+/**
+ * @brief 按单个分隔符切分，跳过空片段（与 split 的结果相同）
+ */
+inline std::vector<std::string_view> split_view(std::string_view str, char delimiter) {
+    std::vector<std::string_view> tokens;
+    const char* p = str.data();
+    const char* end = p + str.size();
+    while (p < end) {
+        const char* d = static_cast<const char*>(std::memchr(p, delimiter, static_cast<size_t>(end - p)));
+        if (!d) d = end;
+        if (d != p) tokens.emplace_back(p, static_cast<size_t>(d - p));
+        p = d + 1;
+    }
+    return tokens;
+}
+
+/**
+ * @brief 按多个分隔符惰性切分的范围，元素为 std::string_view
+ *
+ *   for (std::string_view field : zen::tokenize(line, " \t,;")) ...
+ *
+ * 分隔符扫描走 find_first_of 的向量化实现。skip_empty 为 false 时保留
+ * 相邻分隔符之间的空片段（"a,,b" 得到 "a"、""、"b"，空串得到一个空片段）。
+ */
+class token_range {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::string_view;
+        using pointer = const std::string_view*;
+
+        iterator() = default;
+
+        reference operator*() const { return token_; }
+        pointer operator->() const { return &token_; }
+
+        iterator& operator++() {
+            advance(next_);
+            return *this;
+        }
+        iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.next_ == b.next_; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return a.next_ != b.next_; }
+
+    private:
+        friend class token_range;
+
+        // 结束状态：next_ == npos
+        iterator(const token_range* range, size_t start) : range_(range) { advance(start); }
+
+        void advance(size_t start) {
+            std::string_view text = range_->text_;
+            while (start != std::string::npos && start <= text.size()) {
+                size_t d = zen::find_first_of(text, range_->delims_, start);
+                size_t stop = d == std::string::npos ? text.size() : d;
+                // 下一片段从分隔符之后开始；到达末尾时下一次进入结束状态
+                next_ = d == std::string::npos ? text.size() + 1 : d + 1;
+                if (stop > start || !range_->skip_empty_) {
+                    token_ = text.substr(start, stop - start);
+                    return;
+                }
+                start = next_;
+            }
+            next_ = std::string::npos;
+        }
+
+        const token_range* range_ = nullptr;
+        std::string_view   token_;
+        size_t             next_ = std::string::npos;
+    };
+
+    token_range(std::string_view text, std::string_view delimiters, bool skip_empty)
+        : text_(text), delims_(delimiters), skip_empty_(skip_empty) {}
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(); }
+
+    /**
+     * @brief 收集为 vector（只保存 string_view，不复制字符）
+     */
+    std::vector<std::string_view> to_vector() const {
+        return std::vector<std::string_view>(begin(), end());
+    }
+
+private:
+    std::string_view text_;
+    byte_set         delims_;
+    bool             skip_empty_;
+};
+
+/**
+ * @brief 按 delimiters 中的任一字节切分
+ * @param text 文本
+ * @param delimiters 分隔符集合
+ * @param skip_empty 是否跳过空片段（默认跳过）
+ */
+inline token_range tokenize(std::string_view text, std::string_view delimiters, bool skip_empty = true) {
+    return token_range(text, delimiters, skip_empty);
+}
+
+/**
+ * @brief 去除首尾空白字符，返回原文本的子视图
+ */
+inline std::string_view ltrim_view(std::string_view str) {
+    size_t start = 0;
+    while (start < str.size() && std::isspace(static_cast<unsigned char>(str[start]))) {
+        start++;
+    }
+    return str.substr(start);
+}
+
+inline std::string_view rtrim_view(std::string_view str) {
+    size_t end = str.size();
+    while (end > 0 && std::isspace(static_cast<unsigned char>(str[end - 1]))) {
+        end--;
+    }
+    return str.substr(0, end);
+}
+
+inline std::string_view trim_view(std::string_view str) {
+    return rtrim_view(ltrim_view(str));
+}
+
+/**
+ * @brief 原地转换 ASCII 大小写（不依赖 locale，编译器可自动向量化）
+ */
+inline void to_lower_inplace(std::string& str) {
+    for (char& c : str) {
+        c = static_cast<char>(static_cast<unsigned char>(c - 'A') < 26 ? c | 0x20 : c);
+    }
+}
+
+inline void to_upper_inplace(std::string& str) {
+    for (char& c : str) {
+        c = static_cast<char>(static_cast<unsigned char>(c - 'a') < 26 ? c & ~0x20 : c);
+    }
+}
+
 // ============================================================================
 // 字符串处理工具
 // ============================================================================
@@ -278,15 +822,9 @@ inline size_t levenshtein_distance(const std::string& str1, const std::string& s
  */
 inline std::vector<std::string> split(const std::string& str, char delimiter) {
     std::vector<std::string> tokens;
-    std::string token;
-    std::stringstream ss(str);
-
-    while (std::getline(ss, token, delimiter)) {
-        if (!token.empty()) {
-            tokens.push_back(token);
-        }
+    for (std::string_view token : split_view(str, delimiter)) {
+        tokens.emplace_back(token);
     }
-
     return tokens;
 }
 
@@ -371,21 +909,21 @@ inline std::string to_upper(const std::string& str) {
 /**
  * @brief 检查字符串是否以指定前缀开头
  */
-inline bool starts_with(const std::string& str, const std::string& prefix) {
+inline bool starts_with(std::string_view str, std::string_view prefix) {
     if (prefix.size() > str.size()) {
         return false;
     }
-    return str.compare(0, prefix.size(), prefix) == 0;
+    return std::memcmp(str.data(), prefix.data(), prefix.size()) == 0;
 }
 
 /**
  * @brief 检查字符串是否以指定后缀结尾
  */
-inline bool ends_with(const std::string& str, const std::string& suffix) {
+inline bool ends_with(std::string_view str, std::string_view suffix) {
     if (suffix.size() > str.size()) {
         return false;
     }
-    return str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+    return std::memcmp(str.data() + str.size() - suffix.size(), suffix.data(), suffix.size()) == 0;
 }
 
 /**
@@ -400,13 +938,24 @@ inline std::string replace_all(std::string str, const std::string& from, const s
         return str;
     }
 
-    size_t pos = 0;
-    while ((pos = str.find(from, pos)) != std::string::npos) {
-        str.replace(pos, from.size(), to);
-        pos += to.size();
+    size_t pos = find_substring(str, from);
+    if (pos == std::string::npos) {
+        return str;
     }
 
-    return str;
+    // 一次遍历拼出结果，避免原地 replace 反复搬移尾部
+    std::string result;
+    result.reserve(str.size());
+    size_t copied = 0;
+    do {
+        result.append(str, copied, pos - copied);
+        result += to;
+        copied = pos + from.size();
+        pos = find_substring(str, from, copied);
+    } while (pos != std::string::npos);
+    result.append(str, copied, std::string::npos);
+
+    return result;
 }
 
 /**
@@ -434,8 +983,18 @@ inline bool is_palindrome(const std::string& str) {
 
 // ============================================================================
 // 字符串哈希
+//
+// 容器使用的哈希统一由 utility/hash.h 提供（hash<std::string> / hash_bytes），
+// 以下函数保留给需要特定算法的场景。
 // ============================================================================
 
+/**
+ * @brief 计算字符串的哈希值（wyhash 风格，与 hash<std::string> 结果一致）
+ */
+inline size_t hash_string(const std::string& str) {
+    return static_cast<size_t>(hash_bytes(str.data(), str.size()));
+}
+
 /**
  * @brief 计算字符串的哈希值（DJB2 算法）
  */
@@ -459,18 +1018,10 @@ inline size_t hash_sdbm(const std::string& str) {
 }
 
 /**
- * @brief 计算字符串的哈希值（FNV-1a 算法）
+ * @brief 计算字符串的哈希值（FNV-1a 算法，结果跨平台稳定）
  */
 inline size_t hash_fnv1a(const std::string& str) {
-    const size_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
-    const size_t FNV_PRIME = 1099511628211ULL;
-
-    size_t hash = FNV_OFFSET_BASIS;
-    for (unsigned char c : str) {
-        hash ^= c;
-        hash *= FNV_PRIME;
-    }
-    return hash;
+    return static_cast<size_t>(fnv1a_bytes(reinterpret_cast<const unsigned char*>(str.data()), str.size()));
 }
 
 // ============================================================================
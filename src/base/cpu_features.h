@@ -0,0 +1,98 @@
+#ifndef ZEN_BASE_CPU_FEATURES_H
+#define ZEN_BASE_CPU_FEATURES_H
+
+// ============================================================================
+// CPU 特性检测与 SIMD 目标宏
+// ============================================================================
+//
+// 向量化代码按「编译期能否生成 + 运行期 CPU 是否支持」两级选择实现：
+// - ZEN_ARCH_X86       : x86 / x86-64 目标
+// - ZEN_HAVE_SSE2      : 编译期可直接使用 SSE2（x86-64 总是成立）
+// - ZEN_HAVE_AVX2_TARGET : 编译器支持按函数开启 AVX2（GCC / Clang 的
+//                        __attribute__((target("avx2")))），不要求 -mavx2；
+//                        这类函数只能在 cpu_supports_avx2_target() 为真时调用
+// - ZEN_TARGET_AVX2    : 标在 AVX2 实现函数上的属性；同时开启 BMI1 与 POPCNT
+//                        （编译器会把位扫描 / 计数生成 tzcnt、popcnt 指令）
+//
+// cpu_features() 在首次调用时检测一次并缓存结果。
+// ============================================================================
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ZEN_ARCH_X86 1
+#else
+#define ZEN_ARCH_X86 0
+#endif
+
+#if ZEN_ARCH_X86 && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define ZEN_HAVE_SSE2 1
+#else
+#define ZEN_HAVE_SSE2 0
+#endif
+
+#if ZEN_ARCH_X86 && (defined(__GNUC__) || defined(__clang__))
+#define ZEN_HAVE_AVX2_TARGET 1
+#define ZEN_TARGET_AVX2 __attribute__((target("avx2,bmi,popcnt")))
+#else
+#define ZEN_HAVE_AVX2_TARGET 0
+#define ZEN_TARGET_AVX2
+#endif
+
+#if ZEN_HAVE_SSE2 || ZEN_HAVE_AVX2_TARGET
+#include <immintrin.h>
+#endif
+
+namespace zen {
+
+/**
+ * @brief 运行期检测到的 CPU 特性
+ */
+struct cpu_feature_set {
+    bool sse2     = false;
+    bool sse42    = false;
+    bool popcnt   = false;
+    bool bmi1     = false;
+    bool avx2     = false;   // 同时要求操作系统保存 YMM 状态
+    bool fma      = false;
+    bool avx512bw = false;
+};
+
+namespace detail {
+
+inline cpu_feature_set detect_cpu_features() {
+    cpu_feature_set f;
+#if ZEN_ARCH_X86 && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    f.sse2     = __builtin_cpu_supports("sse2");
+    f.sse42    = __builtin_cpu_supports("sse4.2");
+    f.popcnt   = __builtin_cpu_supports("popcnt");
+    f.bmi1     = __builtin_cpu_supports("bmi");
+    f.avx2     = __builtin_cpu_supports("avx2");
+    f.fma      = __builtin_cpu_supports("fma");
+    f.avx512bw = __builtin_cpu_supports("avx512bw");
+#elif ZEN_HAVE_SSE2
+    f.sse2 = true;
+#endif
+    return f;
+}
+
+} // namespace detail
+
+/**
+ * @brief 当前 CPU 的特性（首次调用时检测）
+ */
+inline const cpu_feature_set& cpu_features() {
+    static const cpu_feature_set features = detail::detect_cpu_features();
+    return features;
+}
+
+/**
+ * @brief 能否调用 ZEN_TARGET_AVX2 函数：AVX2 以及该属性一并开启的 BMI1、POPCNT 均可用
+ */
+inline bool cpu_supports_avx2_target() {
+    const cpu_feature_set& f = cpu_features();
+    return f.avx2 && f.bmi1 && f.popcnt;
+}
+
+} // namespace zen
+
+#endif // ZEN_BASE_CPU_FEATURES_H
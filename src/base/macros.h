@@ -15,6 +15,17 @@
 #define ZEN_LINUX 0
 #endif
 
+// Language feature macros
+// ZEN_HAS_COROUTINES: compiling as C++20 with <coroutine> available
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && defined(__has_include)
+#  if __has_include(<coroutine>)
+#    define ZEN_HAS_COROUTINES 1
+#  endif
+#endif
+#ifndef ZEN_HAS_COROUTINES
+#define ZEN_HAS_COROUTINES 0
+#endif
+
 // Utility macros
 #define ZEN_UNUSED(x) (void)(x)
 #define ZEN_ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
@@ -526,6 +526,59 @@ constexpr bool is_signed_v = is_signed<T>::value;
 template<typename T>
 constexpr bool is_unsigned_v = is_unsigned<T>::value;
 
+// ============================================================================
+// 平凡性判断（依赖编译器内建，与标准库实现方式相同）
+// ============================================================================
+
+/**
+ * @brief 判断析构函数是否平凡（可以跳过析构调用）
+ */
+template<typename T>
+struct is_trivially_destructible {
+    static constexpr bool value = __has_trivial_destructor(T);
+};
+
+template<typename T>
+constexpr bool is_trivially_destructible_v = is_trivially_destructible<T>::value;
+
+/**
+ * @brief 判断类型是否可平凡拷贝（可以用 memcpy 代替拷贝 / 移动构造与赋值）
+ */
+template<typename T>
+struct is_trivially_copyable {
+    static constexpr bool value = __is_trivially_copyable(T);
+};
+
+template<typename T>
+constexpr bool is_trivially_copyable_v = is_trivially_copyable<T>::value;
+
+/**
+ * @brief 判断类型是否可平凡重定位
+ *
+ * "重定位" = 在新地址移动构造 + 析构旧对象。对满足此 trait 的类型，
+ * 容器扩容、中间插入 / 删除时直接 memcpy / memmove 字节，且不再析构旧位置。
+ *
+ * 默认等于 is_trivially_copyable。许多类型虽然有非平凡的移动构造 / 析构，
+ * 但对象不持有指向自身的指针，同样可以按字节搬移（如 unique_ptr、shared_ptr、
+ * 不含内联缓冲区自指针的字符串）。这类类型可以特化本 trait：
+ *
+ * @code
+ * template<> struct zen::is_trivially_relocatable<my_handle> {
+ *     static constexpr bool value = true;
+ * };
+ * @endcode
+ *
+ * 注意：持有指向自身（或内部缓冲区）指针的类型绝不能特化为 true，
+ * 例如 small_vector、以 data_ 指向内联缓冲区的 SSO 字符串。
+ */
+template<typename T>
+struct is_trivially_relocatable {
+    static constexpr bool value = is_trivially_copyable<T>::value;
+};
+
+template<typename T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
 } // namespace zen
 
 #endif // ZEN_BASE_TYPE_TRAITS_H
\ No newline at end of file
@@ -1,10 +1,538 @@
 #ifndef ZEN_CONTAINERS_ADAPTER_PRIORITY_QUEUE_H
 #define ZEN_CONTAINERS_ADAPTER_PRIORITY_QUEUE_H
 
+#include "../../base/type_traits.h"
+#include "../../utility/swap.h"
+#include "../../algorithms/comparators.h"
+#include "../sequential/vector.h"
+
 namespace zen {
 
-// Priority queue container adapter implementation
+// ============================================================================
+// 优先队列：d 叉堆及其变体
+//
+// - priority_queue: 与 std::priority_queue 接口一致的容器适配器，底层为 d 叉堆
+//   （默认 d = 4）。d 叉堆树高为 log_d(n)，上浮比较次数少；下沉时一个节点的
+//   d 个孩子相邻存放，4 叉堆下 double / 指针大小的元素正好落在同一条缓存行，
+//   比二叉堆少一半的缓存缺失。pop 采用自底向上下沉（先把空位沿较优孩子推到
+//   叶子，再让末尾元素上浮），省掉每层与被下沉元素的比较。
+// - indexed_heap: 元素为 [0, capacity) 内的整数 id 的最小堆，记录每个 id 在堆中的
+//   位置，支持 decrease_key / erase / contains。Dijkstra、Prim 用它可以做到堆中
+//   每个顶点至多一项，不再压入重复项、弹出后再丢弃。
+// - radix_heap: 单调整数优先级的基数堆。要求压入的键不小于最近一次弹出的键
+//   （Dijkstra 满足这一点），push 为 O(1)，pop 均摊 O(log C)，C 为键的范围；
+//   只比较位模式、不做元素间比较，整数边权的最短路上通常比比较堆更快。
+// ============================================================================
+
+namespace detail {
+
+/**
+ * @brief d 叉堆的上浮 / 下沉原语
+ *
+ * before(a, b) 为 true 表示 a 应位于 b 之上（更靠近堆顶）；
+ * move(dst, src) 把 first[src] 移到 first[dst]（indexed_heap 借此同步位置表）。
+ * 各函数只移动沿途元素、留出空位，返回空位下标，由调用方放入目标元素。
+ */
+template<size_t Arity>
+struct d_ary_heap_ops {
+    static_assert(Arity >= 2, "heap arity must be at least 2");
+
+    static constexpr size_t parent(size_t i) noexcept { return (i - 1) / Arity; }
+    static constexpr size_t first_child(size_t i) noexcept { return i * Arity + 1; }
+
+    /** mask 选择：pick 为 true 取 b，否则取 a（不产生分支） */
+    static constexpr size_t select(bool pick, size_t a, size_t b) noexcept {
+        return a ^ ((a ^ b) & (size_t(0) - static_cast<size_t>(pick)));
+    }
+
+    /**
+     * @brief 孩子 [c, min(c + Arity, n)) 中最优的一个
+     *
+     * 随机键下孩子间的比较结果无法预测，d >= 3 时用算术选择代替分支（GCC 会把 ?: 编成条件跳转）；
+     * 4 叉满节点两两比较再比较胜者，依赖链深度 2 而不是 3。
+     */
+    template<typename It, typename Before>
+    static size_t best_child(It first, size_t c, size_t n, Before& before) {
+        if (Arity == 2 && c + 2 <= n) {
+            // 二叉堆每层只有一次比较，分支预测失败的代价低于条件选择拉长的依赖链
+            return before(first[c + 1], first[c]) ? c + 1 : c;
+        }
+        if (Arity == 4 && c + 4 <= n) {
+            size_t a = c + static_cast<size_t>(before(first[c + 1], first[c]));
+            size_t b = c + 2 + static_cast<size_t>(before(first[c + 3], first[c + 2]));
+            return select(before(first[b], first[a]), a, b);
+        }
+        size_t best = c;
+        if (c + Arity <= n) {
+            for (size_t k = 1; k < Arity; ++k) best = select(before(first[c + k], first[best]), best, c + k);
+        } else {
+            for (size_t k = c + 1; k < n; ++k) best = select(before(first[k], first[best]), best, k);
+        }
+        return best;
+    }
+
+    /** 从空位 hole 向上：父节点排在 value 之后时下移父节点 */
+    template<typename It, typename T, typename Before, typename Move>
+    static size_t sift_up(It first, size_t hole, const T& value, Before& before, Move& move) {
+        while (hole > 0) {
+            size_t p = parent(hole);
+            if (!before(value, first[p])) break;
+            move(hole, p);
+            hole = p;
+        }
+        return hole;
+    }
+
+    /** 从空位 hole 向下（堆大小 n）：最优孩子排在 value 之前时上移该孩子 */
+    template<typename It, typename T, typename Before, typename Move>
+    static size_t sift_down(It first, size_t hole, size_t n, const T& value, Before& before, Move& move) {
+        for (;;) {
+            size_t c = first_child(hole);
+            if (c >= n) break;
+            size_t best = best_child(first, c, n, before);
+            if (!before(first[best], value)) break;
+            move(hole, best);
+            hole = best;
+        }
+        return hole;
+    }
+
+    /** 自底向上下沉：空位无条件沿最优孩子走到叶子，之后由调用方对末尾元素做 sift_up */
+    template<typename It, typename Before, typename Move>
+    static size_t sift_hole_to_leaf(It first, size_t hole, size_t n, Before& before, Move& move) {
+        for (;;) {
+            size_t c = first_child(hole);
+            if (c >= n) break;
+            size_t best = best_child(first, c, n, before);
+            move(hole, best);
+            hole = best;
+        }
+        return hole;
+    }
+};
+
+} // namespace detail
+
+// ============================================================================
+// priority_queue - d 叉堆适配器
+// ============================================================================
+
+/**
+ * @brief 优先队列（默认大顶：Compare 为 less 时堆顶是最大元素，与 std 一致）
+ * @tparam T         元素类型
+ * @tparam Container 底层容器，需支持随机访问迭代器与 push_back / emplace_back / pop_back
+ * @tparam Compare   比较器，comp(a, b) 为 true 表示 a 的优先级低于 b
+ * @tparam Arity     堆的叉数 d（>= 2）；2 即传统二叉堆
+ */
+template<typename T, typename Container = vector<T>,
+         typename Compare = less<typename Container::value_type>, size_t Arity = 4>
+class priority_queue {
+    using ops = detail::d_ary_heap_ops<Arity>;
+
+public:
+    using container_type  = Container;
+    using value_compare   = Compare;
+    using value_type      = typename Container::value_type;
+    using size_type       = typename Container::size_type;
+    using reference       = typename Container::reference;
+    using const_reference = typename Container::const_reference;
+
+    static constexpr size_t arity = Arity;
+
+protected:
+    Container c;
+    Compare comp;
+
+public:
+    priority_queue() : c(), comp() {}
+    explicit priority_queue(const Compare& compare) : c(), comp(compare) {}
+
+    /** 以已有元素建堆（Floyd 自底向上，O(n)） */
+    priority_queue(const Compare& compare, const Container& cont) : c(cont), comp(compare) { make_heap(); }
+    priority_queue(const Compare& compare, Container&& cont)
+        : c(static_cast<Container&&>(cont)), comp(compare) { make_heap(); }
+
+    template<typename InputIt>
+    priority_queue(InputIt first, InputIt last, const Compare& compare = Compare())
+        : c(), comp(compare) {
+        for (; first != last; ++first) c.push_back(*first);
+        make_heap();
+    }
+
+    bool empty() const noexcept { return c.empty(); }
+    size_type size() const noexcept { return c.size(); }
+
+    /** 堆顶（优先级最高的元素） */
+    const_reference top() const { return c.front(); }
+
+    void push(const value_type& value) {
+        c.push_back(value);
+        fix_up_back();
+    }
+
+    void push(value_type&& value) {
+        c.push_back(static_cast<value_type&&>(value));
+        fix_up_back();
+    }
+
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        c.emplace_back(static_cast<Args&&>(args)...);
+        fix_up_back();
+    }
+
+    /** 弹出堆顶 */
+    void pop() {
+        size_t n = c.size() - 1;
+        if (n == 0) {
+            c.pop_back();
+            return;
+        }
+        value_type last = static_cast<value_type&&>(c.back());
+        c.pop_back();
+        auto first = c.begin();
+        auto before = before_fn();
+        auto move = move_fn(first);
+        size_t hole = ops::sift_hole_to_leaf(first, 0, n, before, move);
+        hole = ops::sift_up(first, hole, last, before, move);
+        first[hole] = static_cast<value_type&&>(last);
+    }
+
+    /**
+     * @brief 以 value 替换堆顶（等价于 pop 后 push，但只做一次下沉）
+     *
+     * 「取出最优、放回更新后的值」的循环（如多路归并、定时器轮转）用它可以省掉一半的堆调整。
+     */
+    void replace_top(value_type value) {
+        auto first = c.begin();
+        auto before = before_fn();
+        auto move = move_fn(first);
+        size_t hole = ops::sift_down(first, 0, c.size(), value, before, move);
+        first[hole] = static_cast<value_type&&>(value);
+    }
+
+    void swap(priority_queue& other) noexcept {
+        zen::swap(c, other.c);
+        zen::swap(comp, other.comp);
+    }
+
+    /** 底层容器（只读，按堆序排列） */
+    const Container& container() const noexcept { return c; }
+
+private:
+    auto before_fn() const {
+        return [this](const value_type& a, const value_type& b) { return comp(b, a); };
+    }
+
+    template<typename It>
+    static auto move_fn(It first) {
+        return [first](size_t dst, size_t src) { first[dst] = static_cast<value_type&&>(first[src]); };
+    }
+
+    void fix_up_back() {
+        size_t n = c.size();
+        if (n <= 1) return;
+        auto first = c.begin();
+        auto before = before_fn();
+        auto move = move_fn(first);
+        value_type value = static_cast<value_type&&>(first[n - 1]);
+        size_t hole = ops::sift_up(first, n - 1, value, before, move);
+        first[hole] = static_cast<value_type&&>(value);
+    }
+
+    void make_heap() {
+        size_t n = c.size();
+        if (n <= 1) return;
+        auto first = c.begin();
+        auto before = before_fn();
+        auto move = move_fn(first);
+        for (size_t i = ops::parent(n - 1) + 1; i-- > 0;) {
+            value_type value = static_cast<value_type&&>(first[i]);
+            size_t hole = ops::sift_down(first, i, n, value, before, move);
+            first[hole] = static_cast<value_type&&>(value);
+        }
+    }
+};
+
+template<typename T, typename C, typename Cmp, size_t D>
+void swap(priority_queue<T, C, Cmp, D>& a, priority_queue<T, C, Cmp, D>& b) noexcept {
+    a.swap(b);
+}
+
+// ============================================================================
+// indexed_heap - 带位置索引的 d 叉最小堆
+// ============================================================================
+
+/**
+ * @brief 以整数 id 为元素、支持修改键的最小堆
+ * @tparam Key     键类型
+ * @tparam Compare 比较器，comp(a, b) 为 true 表示 a 应先于 b 弹出（默认 less：最小键在堆顶）
+ * @tparam Arity   堆的叉数 d
+ *
+ * id 取值范围为 [0, capacity())，同一 id 至多在堆中出现一次。
+ * 堆数组中键与 id 并排存放，上浮 / 下沉时比较不需要间接访问；
+ * pos_ 记录每个 id 的堆下标（不在堆中为 npos）。
+ *
+ * 注意与 priority_queue 的约定相反：这里堆顶是「最先」而不是「最大」的元素，
+ * 方法名沿用最短路文献中的 decrease_key。
+ */
+template<typename Key, typename Compare = less<Key>, size_t Arity = 4>
+class indexed_heap {
+    using ops = detail::d_ary_heap_ops<Arity>;
+
+public:
+    using key_type  = Key;
+    using size_type = size_t;
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    static constexpr size_t arity = Arity;
+
+    indexed_heap() = default;
+
+    explicit indexed_heap(size_t capacity, const Compare& compare = Compare())
+        : pos_(capacity, npos), comp_(compare) {}
+
+    /** id 的上界：可用 id 为 [0, capacity()) */
+    size_t capacity() const noexcept { return pos_.size(); }
+
+    /** 扩大 id 范围（新增的 id 均不在堆中）；不会缩小 */
+    void reserve_ids(size_t capacity) {
+        if (capacity > pos_.size()) pos_.resize(capacity, npos);
+    }
+
+    bool empty() const noexcept { return heap_.empty(); }
+    size_t size() const noexcept { return heap_.size(); }
+
+    bool contains(size_t id) const noexcept { return id < pos_.size() && pos_[id] != npos; }
+
+    /** id 当前的键（要求 contains(id)） */
+    const Key& key(size_t id) const { return heap_[pos_[id]].key; }
+
+    /** 堆顶 id 与其键 */
+    size_t top() const { return heap_.front().id; }
+    const Key& top_key() const { return heap_.front().key; }
+
+    /** 插入 id（要求 !contains(id)） */
+    void push(size_t id, const Key& k) {
+        heap_.push_back(entry{ k, id });
+        pos_[id] = heap_.size() - 1;
+        place_up(heap_.size() - 1);
+    }
+
+    /** 把 id 的键改为不晚于原值的 k，并上浮 */
+    void decrease_key(size_t id, const Key& k) {
+        size_t i = pos_[id];
+        heap_[i].key = k;
+        place_up(i);
+    }
+
+    /** 把 id 的键改为不早于原值的 k，并下沉 */
+    void increase_key(size_t id, const Key& k) {
+        size_t i = pos_[id];
+        heap_[i].key = k;
+        place_down(i);
+    }
+
+    /** 任意修改 id 的键 */
+    void update(size_t id, const Key& k) {
+        size_t i = pos_[id];
+        bool up = comp_(k, heap_[i].key);
+        heap_[i].key = k;
+        if (up) place_up(i);
+        else place_down(i);
+    }
+
+    /**
+     * @brief 不在堆中则插入；在堆中且 k 更早则 decrease_key
+     * @return 是否插入或修改了键
+     */
+    bool push_or_decrease(size_t id, const Key& k) {
+        size_t i = pos_[id];
+        if (i == npos) {
+            push(id, k);
+            return true;
+        }
+        if (!comp_(k, heap_[i].key)) return false;
+        heap_[i].key = k;
+        place_up(i);
+        return true;
+    }
+
+    /** 弹出堆顶 */
+    void pop() { remove_at(0); }
+
+    /** 删除任意 id（不在堆中时无操作） */
+    void erase(size_t id) {
+        if (contains(id)) remove_at(pos_[id]);
+    }
+
+    /** 清空（O(size())，id 范围保留） */
+    void clear() noexcept {
+        for (const entry& e : heap_) pos_[e.id] = npos;
+        heap_.clear();
+    }
+
+private:
+    struct entry {
+        Key key;
+        size_t id;
+    };
+
+    vector<entry> heap_;
+    vector<size_t> pos_;
+    Compare comp_{};
+
+    auto before_fn() const {
+        return [this](const entry& a, const entry& b) { return comp_(a.key, b.key); };
+    }
+
+    auto move_fn() {
+        entry* first = heap_.data();
+        size_t* pos = pos_.data();
+        return [first, pos](size_t dst, size_t src) {
+            first[dst] = static_cast<entry&&>(first[src]);
+            pos[first[dst].id] = dst;
+        };
+    }
+
+    void put(size_t i, entry&& e) {
+        pos_[e.id] = i;
+        heap_[i] = static_cast<entry&&>(e);
+    }
+
+    void place_up(size_t i) {
+        entry e = static_cast<entry&&>(heap_[i]);
+        auto before = before_fn();
+        auto move = move_fn();
+        put(ops::sift_up(heap_.data(), i, e, before, move), static_cast<entry&&>(e));
+    }
+
+    void place_down(size_t i) {
+        entry e = static_cast<entry&&>(heap_[i]);
+        auto before = before_fn();
+        auto move = move_fn();
+        put(ops::sift_down(heap_.data(), i, heap_.size(), e, before, move), static_cast<entry&&>(e));
+    }
+
+    void remove_at(size_t i) {
+        pos_[heap_[i].id] = npos;
+        size_t n = heap_.size() - 1;
+        if (i == n) {
+            heap_.pop_back();
+            return;
+        }
+        entry last = static_cast<entry&&>(heap_.back());
+        heap_.pop_back();
+        auto before = before_fn();
+        auto move = move_fn();
+        // 空位先走到叶子再让末尾元素上浮；末尾元素可能比 i 的祖先更早（erase 中间元素时），
+        // sift_up 会一直上浮到正确位置
+        size_t hole = ops::sift_hole_to_leaf(heap_.data(), i, n, before, move);
+        put(ops::sift_up(heap_.data(), hole, last, before, move), static_cast<entry&&>(last));
+    }
+};
+
+// ============================================================================
+// radix_heap - 单调基数堆
+// ============================================================================
+
+/**
+ * @brief 单调整数键的最小堆
+ * @tparam Key   无符号整数键
+ * @tparam Value 附带的值（如顶点 id）
+ *
+ * 按键与 last_（最近一次弹出的键）最高不同位分桶：桶 0 存放等于 last_ 的键，
+ * 桶 b 存放最高不同位为 b-1 的键。弹出时若桶 0 为空，取最低的非空桶，
+ * 以其中最小键为新的 last_ 重新分桶——该桶元素只会落到更低的桶，
+ * 每个元素一生最多被搬动 digits 次。
+ *
+ * 前提：push 的键不小于 last_key()（单调性），违反时行为未定义。
+ * 不支持 decrease_key：最短路中同一顶点可能有多项，弹出时跳过过期项。
+ */
+template<typename Key, typename Value>
+class radix_heap {
+    static_assert(is_unsigned<Key>::value, "radix_heap requires an unsigned integer key");
+
+public:
+    using key_type   = Key;
+    using value_type = Value;
+    using size_type  = size_t;
+
+    static constexpr unsigned digits = sizeof(Key) * 8;
+
+    radix_heap() = default;
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_t size() const noexcept { return size_; }
+
+    /** 最近一次弹出的键（单调下界） */
+    Key last_key() const noexcept { return last_; }
+
+    void push(Key k, const Value& v) {
+        buckets_[bucket_of(k)].push_back(entry{ k, v });
+        ++size_;
+    }
+
+    void push(Key k, Value&& v) {
+        buckets_[bucket_of(k)].push_back(entry{ k, static_cast<Value&&>(v) });
+        ++size_;
+    }
+
+    /** 堆顶键与值（要求非空；可能触发一次重新分桶） */
+    Key top_key() const {
+        refill();
+        return buckets_[0].back().key;
+    }
+
+    const Value& top_value() const {
+        refill();
+        return buckets_[0].back().value;
+    }
+
+    void pop() {
+        refill();
+        buckets_[0].pop_back();
+        --size_;
+    }
+
+    /** 清空并把单调下界重置为 k（桶的内存保留） */
+    void clear(Key k = Key()) noexcept {
+        for (auto& b : buckets_) b.clear();
+        size_ = 0;
+        last_ = k;
+    }
+
+private:
+    struct entry {
+        Key key;
+        Value value;
+    };
+
+    // top_key / top_value 在逻辑上是只读的，重新分桶不改变堆中的内容
+    mutable vector<entry> buckets_[digits + 1];
+    mutable Key last_ = Key();
+    size_t size_ = 0;
+
+    unsigned bucket_of(Key k) const noexcept {
+        unsigned long long x = static_cast<unsigned long long>(k ^ last_);
+        return x == 0 ? 0u : 64u - static_cast<unsigned>(__builtin_clzll(x));
+    }
+
+    void refill() const {
+        if (!buckets_[0].empty()) return;
+        unsigned b = 1;
+        while (buckets_[b].empty()) ++b;
+        vector<entry>& src = buckets_[b];
+        Key m = src[0].key;
+        for (size_t i = 1; i < src.size(); ++i) {
+            if (src[i].key < m) m = src[i].key;
+        }
+        last_ = m;
+        for (entry& e : src) buckets_[bucket_of(e.key)].push_back(static_cast<entry&&>(e));
+        src.clear();
+    }
+};
 
 } // namespace zen
 
-#endif // ZEN_CONTAINERS_ADAPTER_PRIORITY_QUEUE_H
\ No newline at end of file
+#endif // ZEN_CONTAINERS_ADAPTER_PRIORITY_QUEUE_H
@@ -1,10 +1,81 @@
 #ifndef ZEN_CONTAINERS_ADAPTER_QUEUE_H
 #define ZEN_CONTAINERS_ADAPTER_QUEUE_H
 
+#include "../sequential/deque.h"
+
 namespace zen {
 
-// Queue container adapter implementation
+// ============================================================================
+// queue - 先进先出适配器
+// ============================================================================
+
+/**
+ * @brief 先进先出队列
+ * @tparam T         元素类型
+ * @tparam Container 底层容器，需提供 front / back / push_back / emplace_back / pop_front
+ *
+ * 默认以分段 deque 为底层：尾进头出时只在跨块时申请 / 归还块，
+ * 且 deque 缓存一个空闲块，稳定运行的队列（如线程池任务队列）几乎不再分配内存。
+ */
+template<typename T, typename Container = deque<T>>
+class queue {
+public:
+    using container_type  = Container;
+    using value_type      = typename Container::value_type;
+    using size_type       = typename Container::size_type;
+    using reference       = typename Container::reference;
+    using const_reference = typename Container::const_reference;
+
+protected:
+    Container c;
+
+public:
+    queue() : c() {}
+    explicit queue(const Container& cont) : c(cont) {}
+    explicit queue(Container&& cont) : c(static_cast<Container&&>(cont)) {}
+
+    bool empty() const noexcept { return c.empty(); }
+    size_type size() const noexcept { return c.size(); }
+
+    reference front() { return c.front(); }
+    const_reference front() const { return c.front(); }
+    reference back() { return c.back(); }
+    const_reference back() const { return c.back(); }
+
+    void push(const value_type& value) { c.push_back(value); }
+    void push(value_type&& value) { c.push_back(static_cast<value_type&&>(value)); }
+
+    template<typename... Args>
+    reference emplace(Args&&... args) {
+        return c.emplace_back(static_cast<Args&&>(args)...);
+    }
+
+    void pop() { c.pop_front(); }
+
+    void swap(queue& other) noexcept { zen::swap(c, other.c); }
+
+    /** 底层容器（只读） */
+    const Container& container() const noexcept { return c; }
+
+    template<typename U, typename C>
+    friend bool operator==(const queue<U, C>& a, const queue<U, C>& b);
+};
+
+template<typename T, typename C>
+bool operator==(const queue<T, C>& a, const queue<T, C>& b) {
+    return a.c == b.c;
+}
+
+template<typename T, typename C>
+bool operator!=(const queue<T, C>& a, const queue<T, C>& b) {
+    return !(a == b);
+}
+
+template<typename T, typename C>
+void swap(queue<T, C>& a, queue<T, C>& b) noexcept {
+    a.swap(b);
+}
 
 } // namespace zen
 
-#endif // ZEN_CONTAINERS_ADAPTER_QUEUE_H
\ No newline at end of file
+#endif // ZEN_CONTAINERS_ADAPTER_QUEUE_H
@@ -1,10 +1,78 @@
 #ifndef ZEN_CONTAINERS_ADAPTER_STACK_H
 #define ZEN_CONTAINERS_ADAPTER_STACK_H
 
+#include "../sequential/deque.h"
+
 namespace zen {
 
-// Stack container adapter implementation
+// ============================================================================
+// stack - 后进先出适配器
+// ============================================================================
+
+/**
+ * @brief 后进先出栈
+ * @tparam T         元素类型
+ * @tparam Container 底层容器，需提供 back / push_back / emplace_back / pop_back
+ *
+ * 默认以分段 deque 为底层：增长时不搬移已有元素，栈顶引用在 push 后仍然有效。
+ */
+template<typename T, typename Container = deque<T>>
+class stack {
+public:
+    using container_type  = Container;
+    using value_type      = typename Container::value_type;
+    using size_type       = typename Container::size_type;
+    using reference       = typename Container::reference;
+    using const_reference = typename Container::const_reference;
+
+protected:
+    Container c;
+
+public:
+    stack() : c() {}
+    explicit stack(const Container& cont) : c(cont) {}
+    explicit stack(Container&& cont) : c(static_cast<Container&&>(cont)) {}
+
+    bool empty() const noexcept { return c.empty(); }
+    size_type size() const noexcept { return c.size(); }
+
+    reference top() { return c.back(); }
+    const_reference top() const { return c.back(); }
+
+    void push(const value_type& value) { c.push_back(value); }
+    void push(value_type&& value) { c.push_back(static_cast<value_type&&>(value)); }
+
+    template<typename... Args>
+    reference emplace(Args&&... args) {
+        return c.emplace_back(static_cast<Args&&>(args)...);
+    }
+
+    void pop() { c.pop_back(); }
+
+    void swap(stack& other) noexcept { zen::swap(c, other.c); }
+
+    /** 底层容器（只读） */
+    const Container& container() const noexcept { return c; }
+
+    template<typename U, typename C>
+    friend bool operator==(const stack<U, C>& a, const stack<U, C>& b);
+};
+
+template<typename T, typename C>
+bool operator==(const stack<T, C>& a, const stack<T, C>& b) {
+    return a.c == b.c;
+}
+
+template<typename T, typename C>
+bool operator!=(const stack<T, C>& a, const stack<T, C>& b) {
+    return !(a == b);
+}
+
+template<typename T, typename C>
+void swap(stack<T, C>& a, stack<T, C>& b) noexcept {
+    a.swap(b);
+}
 
 } // namespace zen
 
-#endif // ZEN_CONTAINERS_ADAPTER_STACK_H
\ No newline at end of file
+#endif // ZEN_CONTAINERS_ADAPTER_STACK_H
@@ -0,0 +1,982 @@
+#ifndef ZEN_CONTAINERS_ASSOCIATIVE_BTREE_MAP_H
+#define ZEN_CONTAINERS_ASSOCIATIVE_BTREE_MAP_H
+
+#include "../../base/type_traits.h"
+#include "../../utility/swap.h"
+#include "../../utility/pair.h"
+#include "../../memory/allocator.h"
+#include "../../iterators/iterator_base.h"
+#include "../sequential/vector.h"
+#include "map.h"    // less
+
+namespace zen {
+
+// ============================================================================
+// btree_map / btree_set - 缓存友好的有序容器（B+ 树）
+//
+// 与 map / set（红黑树）接口一致，但每个节点存放多个元素：
+// - 节点大小按缓存行对齐到约 256 字节（4 条缓存行），一次取入即可比较十几个键
+// - 元素只存放在叶子中，叶子之间双向链接，顺序遍历 / 区间扫描只是数组步进
+// - 内部节点只保存分隔键和子指针，扇出大、树高低（千万级元素约 6~7 层）
+//
+// 与 map 的差异：
+// - 插入 / 删除会在节点内移动元素，所有迭代器（含 end()）和元素地址失效
+// - 键需要可拷贝构造（内部节点保存分隔键的副本）
+// - 不提供节点句柄（元素不以独立节点存在）
+// ============================================================================
+
+namespace detail {
+
+/** 节点目标大小（字节） */
+static constexpr size_t BTREE_NODE_BYTES = 256;
+
+/** 给定可用字节数和每个槽位的开销，计算节点容量（至少 4） */
+constexpr size_t btree_fanout(size_t avail, size_t per_slot) noexcept {
+    return avail / per_slot < 4 ? 4 : avail / per_slot;
+}
+
+template<typename Key, typename Value>
+struct btree_map_policy {
+    using key_type   = Key;
+    using value_type = pair<const Key, Value>;
+    using iter_value = value_type;
+
+    static const Key& key(const value_type& v) noexcept { return v.first; }
+
+    /** 把 src 的内容移动到未构造的 dst 上，并析构 src（key 为 const，需要 const_cast 才能真正移动） */
+    template<typename A>
+    static void transfer(A& a, value_type* dst, value_type* src) {
+        a.construct(dst, zen::move(const_cast<Key&>(src->first)), zen::move(src->second));
+        a.destroy(src);
+    }
+};
+
+template<typename Key>
+struct btree_set_policy {
+    using key_type   = Key;
+    using value_type = Key;
+    using iter_value = const Key;   // 集合元素不可通过迭代器修改
+
+    static const Key& key(const value_type& v) noexcept { return v; }
+
+    template<typename A>
+    static void transfer(A& a, value_type* dst, value_type* src) {
+        a.construct(dst, zen::move(*src));
+        a.destroy(src);
+    }
+};
+
+} // namespace detail
+
+// ============================================================================
+// 迭代器
+// ============================================================================
+
+/**
+ * @brief B+ 树的双向迭代器：(叶子, 下标)
+ * @tparam Leaf 叶子节点类型
+ * @tparam T    元素类型（const 版本即 const_iterator）
+ *
+ * end() 表示为 (最右叶子, 元素数)；叶子内 ++ 只是下标加一，
+ * 到达叶子末尾时沿 next 链跳到下一个叶子。
+ */
+template<typename Leaf, typename T>
+struct btree_iterator {
+    using value_type        = remove_cv_t<T>;
+    using reference         = T&;
+    using pointer           = T*;
+    using difference_type   = decltype((char*)0 - (char*)0);
+    using iterator_category = bidirectional_iterator_tag;
+
+    Leaf*  leaf_;
+    size_t pos_;
+
+    btree_iterator() noexcept : leaf_(nullptr), pos_(0) {}
+    btree_iterator(Leaf* l, size_t p) noexcept : leaf_(l), pos_(p) {}
+
+    // 从非 const 迭代器构造
+    template<typename U, typename = enable_if_t<is_same_v<const U, T> && !is_same_v<U, T>>>
+    btree_iterator(const btree_iterator<Leaf, U>& it) noexcept
+        : leaf_(it.leaf_), pos_(it.pos_) {}
+
+    reference operator*()  const noexcept { return *leaf_->slot(pos_); }
+    pointer   operator->() const noexcept { return leaf_->slot(pos_); }
+
+    btree_iterator& operator++() noexcept {
+        if (++pos_ == leaf_->count && leaf_->next) {
+            leaf_ = leaf_->next;
+            pos_  = 0;
+        }
+        return *this;
+    }
+
+    btree_iterator operator++(int) noexcept { btree_iterator t = *this; ++(*this); return t; }
+
+    btree_iterator& operator--() noexcept {
+        if (pos_ == 0) {
+            leaf_ = leaf_->prev;
+            pos_  = leaf_->count;
+        }
+        --pos_;
+        return *this;
+    }
+
+    btree_iterator operator--(int) noexcept { btree_iterator t = *this; --(*this); return t; }
+
+    bool operator==(const btree_iterator& o) const noexcept { return leaf_ == o.leaf_ && pos_ == o.pos_; }
+    bool operator!=(const btree_iterator& o) const noexcept { return !(*this == o); }
+};
+
+// ============================================================================
+// btree - B+ 树内核
+// ============================================================================
+
+/**
+ * @brief btree_map / btree_set 共用的 B+ 树
+ * @tparam Policy  存储策略（元素类型、取键方式、元素搬移）
+ * @tparam Compare 比较器
+ * @tparam Alloc   分配器（rebind 到叶子 / 内部节点 / 元素类型）
+ *
+ * 结构不变式：
+ * - 内部节点 n 有 count 个分隔键、count + 1 个子节点，
+ *   children[i] 中所有键 < keys[i] <= children[i + 1] 中所有键
+ * - 删除后分隔键可能不再对应任何现存元素，但上述不等式始终成立
+ * - 非根节点删除后低于半满时，先向兄弟借一个元素，借不到就与兄弟合并
+ *
+ * 插入在最右叶子末尾追加时不对半分裂，而是新开一个空叶子，
+ * 顺序插入得到的节点接近全满。
+ */
+template<typename Policy, typename Compare, typename Alloc>
+class btree {
+public:
+    // -------------------------------------------------------------------------
+    // 类型定义
+    // -------------------------------------------------------------------------
+    using key_type        = typename Policy::key_type;
+    using value_type      = typename Policy::value_type;
+    using size_type       = size_t;
+    using difference_type = decltype((char*)0 - (char*)0);
+    using key_compare     = Compare;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+
+protected:
+    // -------------------------------------------------------------------------
+    // 节点
+    // -------------------------------------------------------------------------
+    struct inner_node;
+
+    struct node_base {
+        inner_node*    parent;
+        unsigned short count;   ///< 叶子：元素数；内部节点：分隔键数
+        unsigned short index;   ///< 在父节点 children 中的下标
+        bool           leaf;
+    };
+
+    static constexpr size_type LEAF_N = detail::btree_fanout(
+        detail::BTREE_NODE_BYTES - sizeof(node_base) - 2 * sizeof(void*), sizeof(value_type));
+    static constexpr size_type INNER_N = detail::btree_fanout(
+        detail::BTREE_NODE_BYTES - sizeof(node_base) - sizeof(void*), sizeof(key_type) + sizeof(void*));
+    static constexpr size_type LEAF_MIN  = LEAF_N / 2;
+    static constexpr size_type INNER_MIN = INNER_N / 2;
+
+    struct leaf_node : node_base {
+        leaf_node* prev;
+        leaf_node* next;
+        alignas(value_type) unsigned char storage[LEAF_N * sizeof(value_type)];
+
+        value_type* slot(size_t i) noexcept { return reinterpret_cast<value_type*>(storage) + i; }
+        const key_type& key(size_t i) noexcept { return Policy::key(*slot(i)); }
+    };
+
+    struct inner_node : node_base {
+        alignas(key_type) unsigned char keys[INNER_N * sizeof(key_type)];
+        node_base* children[INNER_N + 1];
+
+        key_type* key(size_t i) noexcept { return reinterpret_cast<key_type*>(keys) + i; }
+    };
+
+    using leaf_alloc  = typename Alloc::template rebind<leaf_node>::other;
+    using inner_alloc = typename Alloc::template rebind<inner_node>::other;
+    using value_alloc = typename Alloc::template rebind<value_type>::other;
+    using key_alloc   = typename Alloc::template rebind<key_type>::other;
+
+public:
+    using iterator       = btree_iterator<leaf_node, typename Policy::iter_value>;
+    using const_iterator = btree_iterator<leaf_node, const typename Policy::iter_value>;
+
+protected:
+    // -------------------------------------------------------------------------
+    // 成员变量
+    // -------------------------------------------------------------------------
+    node_base*  root_;      ///< 根节点（空树为 nullptr）
+    leaf_node*  first_;     ///< 最左叶子
+    leaf_node*  last_;      ///< 最右叶子
+    size_type   size_;
+    Compare     comp_;
+    leaf_alloc  lalloc_;
+    inner_alloc ialloc_;
+    value_alloc valloc_;
+    key_alloc   kalloc_;
+
+    // -------------------------------------------------------------------------
+    // 节点分配
+    // -------------------------------------------------------------------------
+
+    leaf_node* new_leaf() {
+        leaf_node* n = lalloc_.allocate(1);
+        n->parent = nullptr;
+        n->count  = 0;
+        n->index  = 0;
+        n->leaf   = true;
+        n->prev   = nullptr;
+        n->next   = nullptr;
+        return n;
+    }
+
+    inner_node* new_inner() {
+        inner_node* n = ialloc_.allocate(1);
+        n->parent = nullptr;
+        n->count  = 0;
+        n->index  = 0;
+        n->leaf   = false;
+        return n;
+    }
+
+    /** 递归析构并释放子树 */
+    void free_subtree(node_base* n) noexcept {
+        if (n->leaf) {
+            leaf_node* l = static_cast<leaf_node*>(n);
+            if (!is_trivially_destructible_v<value_type>) {
+                for (size_type i = 0; i < l->count; ++i) valloc_.destroy(l->slot(i));
+            }
+            lalloc_.deallocate(l, 1);
+            return;
+        }
+        inner_node* in = static_cast<inner_node*>(n);
+        for (size_type i = 0; i <= in->count; ++i) free_subtree(in->children[i]);
+        if (!is_trivially_destructible_v<key_type>) {
+            for (size_type i = 0; i < in->count; ++i) kalloc_.destroy(in->key(i));
+        }
+        ialloc_.deallocate(in, 1);
+    }
+
+    // -------------------------------------------------------------------------
+    // 节点内搬移
+    // -------------------------------------------------------------------------
+
+    void move_key(key_type* dst, key_type* src) {
+        kalloc_.construct(dst, zen::move(*src));
+        kalloc_.destroy(src);
+    }
+
+    /** 叶子内 [from, count) 右移 n 位 */
+    void shift_slots_right(leaf_node* l, size_type from, size_type n) {
+        for (size_type i = l->count; i-- > from; ) Policy::transfer(valloc_, l->slot(i + n), l->slot(i));
+    }
+
+    /** 叶子内 [from, count) 左移 1 位（from - 1 处必须已析构） */
+    void shift_slots_left(leaf_node* l, size_type from) {
+        for (size_type i = from; i < l->count; ++i) Policy::transfer(valloc_, l->slot(i - 1), l->slot(i));
+    }
+
+    void set_child(inner_node* p, size_type i, node_base* c) noexcept {
+        p->children[i] = c;
+        c->parent = p;
+        c->index  = static_cast<unsigned short>(i);
+    }
+
+    // -------------------------------------------------------------------------
+    // 节点内查找（二分）
+    // -------------------------------------------------------------------------
+
+    /** 第一个键 >= k 的槽位 */
+    template<typename K>
+    size_type leaf_lower(leaf_node* l, const K& k) const {
+        size_type lo = 0, hi = l->count;
+        while (lo < hi) {
+            size_type mid = (lo + hi) >> 1;
+            if (comp_(l->key(mid), k)) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    /** 第一个键 > k 的槽位 */
+    template<typename K>
+    size_type leaf_upper(leaf_node* l, const K& k) const {
+        size_type lo = 0, hi = l->count;
+        while (lo < hi) {
+            size_type mid = (lo + hi) >> 1;
+            if (comp_(k, l->key(mid))) hi = mid;
+            else lo = mid + 1;
+        }
+        return lo;
+    }
+
+    /** k 所在（或应插入）的叶子 */
+    leaf_node* find_leaf(const key_type& k) const {
+        node_base* n = root_;
+        while (!n->leaf) {
+            inner_node* in = static_cast<inner_node*>(n);
+            size_type lo = 0, hi = in->count;
+            while (lo < hi) {
+                size_type mid = (lo + hi) >> 1;
+                if (comp_(k, *in->key(mid))) hi = mid;
+                else lo = mid + 1;
+            }
+            n = in->children[lo];
+        }
+        return static_cast<leaf_node*>(n);
+    }
+
+    /** 把 (l, p) 规范化：p 落在叶子末尾时指向下一个叶子的开头 */
+    static iterator make_iter(leaf_node* l, size_type p) noexcept {
+        if (p == l->count && l->next) return iterator(l->next, 0);
+        return iterator(l, p);
+    }
+
+    // -------------------------------------------------------------------------
+    // 插入
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief 在 left 的父节点中插入分隔键 sep 与其右侧的新子节点 right
+     */
+    void insert_into_parent(node_base* left, const key_type& sep, node_base* right) {
+        inner_node* p = left->parent;
+        if (!p) {
+            p = new_inner();
+            kalloc_.construct(p->key(0), sep);
+            p->count = 1;
+            set_child(p, 0, left);
+            set_child(p, 1, right);
+            root_ = p;
+            return;
+        }
+        size_type ci = left->index;
+        if (p->count == INNER_N) {
+            // 父节点已满：先分裂，再决定插入哪一半
+            inner_node* r = new_inner();
+            bool append = ci == INNER_N &&
+                          (p->parent == nullptr || p->index == p->parent->count);
+            size_type mid = append ? INNER_N - 1 : INNER_N / 2;
+            for (size_type i = mid + 1; i < INNER_N; ++i) move_key(r->key(i - mid - 1), p->key(i));
+            for (size_type i = mid + 1; i <= INNER_N; ++i) set_child(r, i - mid - 1, p->children[i]);
+            r->count = static_cast<unsigned short>(INNER_N - mid - 1);
+            p->count = static_cast<unsigned short>(mid);
+            key_type up(zen::move(*p->key(mid)));
+            kalloc_.destroy(p->key(mid));
+            insert_into_parent(p, up, r);
+            if (ci > mid) {
+                ci -= mid + 1;
+                p = r;
+            }
+        }
+        for (size_type i = p->count; i > ci; --i) move_key(p->key(i), p->key(i - 1));
+        for (size_type i = p->count + 1; i > ci + 1; --i) set_child(p, i, p->children[i - 1]);
+        kalloc_.construct(p->key(ci), sep);
+        set_child(p, ci + 1, right);
+        ++p->count;
+    }
+
+    /**
+     * @brief 分裂已满的叶子 l，返回新元素应插入的 (叶子, 下标)
+     * @param k   待插入的键（在最右叶子末尾追加时用作分隔键）
+     */
+    pair<leaf_node*, size_type> split_leaf(leaf_node* l, size_type pos, const key_type& k) {
+        leaf_node* r = new_leaf();
+        size_type mid = (pos == LEAF_N && !l->next) ? LEAF_N : LEAF_N / 2;
+        for (size_type i = mid; i < LEAF_N; ++i) Policy::transfer(valloc_, r->slot(i - mid), l->slot(i));
+        r->count = static_cast<unsigned short>(LEAF_N - mid);
+        l->count = static_cast<unsigned short>(mid);
+
+        r->prev = l;
+        r->next = l->next;
+        if (l->next) l->next->prev = r;
+        else last_ = r;
+        l->next = r;
+
+        insert_into_parent(l, r->count ? r->key(0) : k, r);
+        if (mid == LEAF_N) return {r, 0};
+        if (pos <= mid) return {l, pos};
+        return {r, pos - mid};
+    }
+
+    /**
+     * @brief 键不存在时在 k 的位置用 args 构造新元素
+     */
+    template<typename... Args>
+    pair<iterator, bool> emplace_key(const key_type& k, Args&&... args) {
+        if (!root_) {
+            first_ = last_ = new_leaf();
+            root_ = first_;
+        }
+        leaf_node* l = find_leaf(k);
+        size_type pos = leaf_lower(l, k);
+        if (pos < l->count && !comp_(k, l->key(pos))) return {iterator(l, pos), false};
+
+        if (l->count == LEAF_N) {
+            auto target = split_leaf(l, pos, k);
+            l   = target.first;
+            pos = target.second;
+        }
+        shift_slots_right(l, pos, 1);
+        valloc_.construct(l->slot(pos), static_cast<Args&&>(args)...);
+        ++l->count;
+        ++size_;
+        return {iterator(l, pos), true};
+    }
+
+    // -------------------------------------------------------------------------
+    // 删除
+    // -------------------------------------------------------------------------
+
+    /** 从内部节点 p 中删除分隔键 ki 及其右侧子节点（子节点本身由调用者处理） */
+    void remove_from_inner(inner_node* p, size_type ki) {
+        kalloc_.destroy(p->key(ki));
+        for (size_type i = ki + 1; i < p->count; ++i) move_key(p->key(i - 1), p->key(i));
+        for (size_type i = ki + 2; i <= p->count; ++i) set_child(p, i - 1, p->children[i]);
+        --p->count;
+    }
+
+    /** 用兄弟节点的第一个键重写分隔键 */
+    void reset_key(inner_node* p, size_type ki, const key_type& k) {
+        kalloc_.destroy(p->key(ki));
+        kalloc_.construct(p->key(ki), k);
+    }
+
+    /** 内部节点低于半满时的借 / 合并，必要时向上递归 */
+    void rebalance_inner(inner_node* n) {
+        inner_node* p = n->parent;
+        if (!p) {
+            if (n->count == 0) {
+                // 根只剩一个孩子：树高减一
+                root_ = n->children[0];
+                root_->parent = nullptr;
+                root_->index  = 0;
+                ialloc_.deallocate(n, 1);
+            }
+            return;
+        }
+        if (n->count >= INNER_MIN) return;
+
+        size_type idx = n->index;
+        inner_node* left  = idx > 0        ? static_cast<inner_node*>(p->children[idx - 1]) : nullptr;
+        inner_node* right = idx < p->count ? static_cast<inner_node*>(p->children[idx + 1]) : nullptr;
+
+        if (left && left->count > INNER_MIN) {
+            // 向左兄弟借：父分隔键下移到 n 的最前，左兄弟最后一个键上移
+            for (size_type i = n->count; i > 0; --i) move_key(n->key(i), n->key(i - 1));
+            for (size_type i = n->count + 1; i > 0; --i) set_child(n, i, n->children[i - 1]);
+            move_key(n->key(0), p->key(idx - 1));
+            set_child(n, 0, left->children[left->count]);
+            move_key(p->key(idx - 1), left->key(left->count - 1));
+            --left->count;
+            ++n->count;
+            return;
+        }
+        if (right && right->count > INNER_MIN) {
+            // 向右兄弟借
+            move_key(n->key(n->count), p->key(idx));
+            set_child(n, n->count + 1, right->children[0]);
+            move_key(p->key(idx), right->key(0));
+            for (size_type i = 1; i < right->count; ++i) move_key(right->key(i - 1), right->key(i));
+            for (size_type i = 1; i <= right->count; ++i) set_child(right, i - 1, right->children[i]);
+            --right->count;
+            ++n->count;
+            return;
+        }
+
+        // 合并：右节点并入左节点，中间夹父分隔键
+        inner_node* l = left ? left : n;
+        inner_node* r = left ? n : right;
+        size_type ki = r->index - 1;
+        size_type base = l->count;
+        kalloc_.construct(l->key(base), *p->key(ki));
+        for (size_type i = 0; i < r->count; ++i) move_key(l->key(base + 1 + i), r->key(i));
+        for (size_type i = 0; i <= r->count; ++i) set_child(l, base + 1 + i, r->children[i]);
+        l->count = static_cast<unsigned short>(base + 1 + r->count);
+        ialloc_.deallocate(r, 1);
+        remove_from_inner(p, ki);
+        rebalance_inner(p);
+    }
+
+    /**
+     * @brief 删除 (l, pos) 处的元素，返回指向后继元素的迭代器
+     */
+    iterator erase_at(leaf_node* l, size_type pos) {
+        valloc_.destroy(l->slot(pos));
+        shift_slots_left(l, pos + 1);
+        --l->count;
+        --size_;
+
+        inner_node* p = l->parent;
+        if (!p) {
+            if (l->count == 0) {
+                lalloc_.deallocate(l, 1);
+                root_ = nullptr;
+                first_ = last_ = nullptr;
+                return end();
+            }
+            return make_iter(l, pos);
+        }
+        if (l->count >= LEAF_MIN) return make_iter(l, pos);
+
+        size_type idx = l->index;
+        leaf_node* left  = idx > 0        ? static_cast<leaf_node*>(p->children[idx - 1]) : nullptr;
+        leaf_node* right = idx < p->count ? static_cast<leaf_node*>(p->children[idx + 1]) : nullptr;
+
+        if (left && left->count > LEAF_MIN) {
+            // 向左兄弟借最后一个元素
+            shift_slots_right(l, 0, 1);
+            Policy::transfer(valloc_, l->slot(0), left->slot(left->count - 1));
+            --left->count;
+            ++l->count;
+            reset_key(p, idx - 1, l->key(0));
+            return make_iter(l, pos + 1);
+        }
+        if (right && right->count > LEAF_MIN) {
+            // 向右兄弟借第一个元素
+            Policy::transfer(valloc_, l->slot(l->count), right->slot(0));
+            ++l->count;
+            shift_slots_left(right, 1);
+            --right->count;
+            reset_key(p, idx, right->key(0));
+            return make_iter(l, pos);
+        }
+
+        // 合并：右叶子并入左叶子
+        leaf_node* dst = left ? left : l;
+        leaf_node* src = left ? l : right;
+        size_type base = dst->count;
+        for (size_type i = 0; i < src->count; ++i) Policy::transfer(valloc_, dst->slot(base + i), src->slot(i));
+        dst->count = static_cast<unsigned short>(base + src->count);
+        dst->next = src->next;
+        if (src->next) src->next->prev = dst;
+        else last_ = dst;
+        size_type ki = src->index - 1;
+        lalloc_.deallocate(src, 1);
+        remove_from_inner(p, ki);
+        rebalance_inner(p);
+
+        return left ? make_iter(dst, base + pos) : make_iter(dst, pos);
+    }
+
+    // -------------------------------------------------------------------------
+    // 批量构建
+    // -------------------------------------------------------------------------
+
+    /** 子树中的最小键（最左叶子的第一个元素） */
+    static const key_type& min_key(node_base* n) noexcept {
+        while (!n->leaf) n = static_cast<inner_node*>(n)->children[0];
+        return static_cast<leaf_node*>(n)->key(0);
+    }
+
+    /**
+     * @brief 由已排序、无重复的区间 [first, last) 构建整棵树（调用时树必须为空）
+     *
+     * build_sorted 需要先知道元素个数：可多趟遍历的区间先求长度，
+     * 单趟输入迭代器先缓存到临时数组。
+     */
+    template<typename InputIt>
+    void build_sorted_range(InputIt first, InputIt last) {
+        if constexpr (is_multipass_iterator<InputIt>::value) {
+            build_sorted(first, range_length(first, last));
+        } else {
+            vector<value_type> buf;
+            for (; first != last; ++first) buf.emplace_back(*first);
+            build_sorted(buf.data(), buf.size());
+        }
+    }
+
+    /**
+     * @brief 由已排序、无重复的 n 个元素自底向上构建整棵树（调用时树必须为空）
+     *
+     * 每层节点数取 ceil(n / 容量)，元素在节点间平均分配，
+     * 因此除根外每个节点都至少半满。构建期间借用 parent 字段
+     * 把同一层的节点串成链表。
+     */
+    template<typename InputIt>
+    void build_sorted(InputIt first, size_type n) {
+        if (n == 0) return;
+        size_type leaves = (n + LEAF_N - 1) / LEAF_N;
+        leaf_node* prev = nullptr;
+        node_base* level = nullptr;     // 当前层链表头
+        node_base* tail  = nullptr;
+        for (size_type i = 0; i < leaves; ++i) {
+            size_type cnt = n / leaves + (i < n % leaves ? 1 : 0);
+            leaf_node* l = new_leaf();
+            for (size_type j = 0; j < cnt; ++j, ++first) {
+                valloc_.construct(l->slot(j), *first);
+                ++l->count;
+                ++size_;
+            }
+            l->prev = prev;
+            if (prev) prev->next = l;
+            else first_ = l;
+            prev = l;
+            if (tail) tail->parent = reinterpret_cast<inner_node*>(l);   // 暂存同层后继
+            else level = l;
+            tail = l;
+        }
+        last_ = prev;
+
+        size_type count = leaves;
+        while (count > 1) {
+            size_type groups = (count + INNER_N) / (INNER_N + 1);
+            node_base* child = level;
+            level = tail = nullptr;
+            for (size_type g = 0; g < groups; ++g) {
+                size_type cnt = count / groups + (g < count % groups ? 1 : 0);
+                inner_node* in = new_inner();
+                for (size_type j = 0; j < cnt; ++j) {
+                    node_base* next = reinterpret_cast<node_base*>(child->parent);
+                    if (j > 0) kalloc_.construct(in->key(j - 1), min_key(child));
+                    set_child(in, j, child);
+                    child = next;
+                }
+                in->count = static_cast<unsigned short>(cnt - 1);
+                if (tail) tail->parent = in;
+                else level = in;
+                tail = in;
+            }
+            tail->parent = nullptr;
+            count = groups;
+        }
+        level->parent = nullptr;
+        root_ = level;
+    }
+
+    void reset() noexcept {
+        root_  = nullptr;
+        first_ = last_ = nullptr;
+        size_  = 0;
+    }
+
+public:
+    // -------------------------------------------------------------------------
+    // 构造 / 析构
+    // -------------------------------------------------------------------------
+
+    btree() : root_(nullptr), first_(nullptr), last_(nullptr), size_(0), comp_() {}
+
+    explicit btree(const Compare& comp, const Alloc& alloc = Alloc())
+        : root_(nullptr), first_(nullptr), last_(nullptr), size_(0), comp_(comp),
+          lalloc_(alloc), ialloc_(alloc), valloc_(alloc), kalloc_(alloc) {}
+
+    /**
+     * @brief 拷贝构造：源已有序，直接批量构建，O(n)
+     */
+    btree(const btree& other)
+        : root_(nullptr), first_(nullptr), last_(nullptr), size_(0), comp_(other.comp_),
+          lalloc_(other.lalloc_), ialloc_(other.ialloc_), valloc_(other.valloc_), kalloc_(other.kalloc_) {
+        build_sorted(other.begin(), other.size_);
+    }
+
+    btree(btree&& other) noexcept
+        : root_(other.root_), first_(other.first_), last_(other.last_), size_(other.size_),
+          comp_(zen::move(other.comp_)), lalloc_(zen::move(other.lalloc_)),
+          ialloc_(zen::move(other.ialloc_)), valloc_(zen::move(other.valloc_)),
+          kalloc_(zen::move(other.kalloc_)) {
+        other.reset();
+    }
+
+    ~btree() { clear(); }
+
+    btree& operator=(const btree& other) {
+        if (this != &other) {
+            btree tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    btree& operator=(btree&& other) noexcept {
+        if (this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+
+    void swap(btree& other) noexcept {
+        zen::swap(root_,   other.root_);
+        zen::swap(first_,  other.first_);
+        zen::swap(last_,   other.last_);
+        zen::swap(size_,   other.size_);
+        zen::swap(comp_,   other.comp_);
+        zen::swap(lalloc_, other.lalloc_);
+        zen::swap(ialloc_, other.ialloc_);
+        zen::swap(valloc_, other.valloc_);
+        zen::swap(kalloc_, other.kalloc_);
+    }
+
+    // -------------------------------------------------------------------------
+    // 容量
+    // -------------------------------------------------------------------------
+
+    bool      empty() const noexcept { return size_ == 0; }
+    size_type size()  const noexcept { return size_; }
+
+    /** 叶子节点容量（每个叶子最多存放的元素数） */
+    static constexpr size_type leaf_capacity() noexcept { return LEAF_N; }
+
+    // -------------------------------------------------------------------------
+    // 迭代器
+    // -------------------------------------------------------------------------
+
+    iterator       begin()        noexcept { return iterator(first_, 0); }
+    const_iterator begin()  const noexcept { return const_iterator(first_, 0); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator       end()        noexcept { return iterator(last_, last_ ? last_->count : 0); }
+    const_iterator end()  const noexcept { return const_iterator(last_, last_ ? last_->count : 0); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // -------------------------------------------------------------------------
+    // 查找
+    // -------------------------------------------------------------------------
+
+    iterator find(const key_type& k) {
+        if (!root_) return end();
+        leaf_node* l = find_leaf(k);
+        size_type pos = leaf_lower(l, k);
+        if (pos < l->count && !comp_(k, l->key(pos))) return iterator(l, pos);
+        return end();
+    }
+
+    const_iterator find(const key_type& k) const {
+        return const_cast<btree*>(this)->find(k);
+    }
+
+    bool      contains(const key_type& k) const { return find(k) != end(); }
+    size_type count(const key_type& k)    const { return contains(k) ? 1u : 0u; }
+
+    // -------------------------------------------------------------------------
+    // 范围查找
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief 返回第一个 key >= k 的迭代器
+     */
+    iterator lower_bound(const key_type& k) {
+        if (!root_) return end();
+        leaf_node* l = find_leaf(k);
+        return make_iter(l, leaf_lower(l, k));
+    }
+
+    const_iterator lower_bound(const key_type& k) const {
+        return const_cast<btree*>(this)->lower_bound(k);
+    }
+
+    /**
+     * @brief 返回第一个 key > k 的迭代器
+     */
+    iterator upper_bound(const key_type& k) {
+        if (!root_) return end();
+        leaf_node* l = find_leaf(k);
+        return make_iter(l, leaf_upper(l, k));
+    }
+
+    const_iterator upper_bound(const key_type& k) const {
+        return const_cast<btree*>(this)->upper_bound(k);
+    }
+
+    pair<iterator, iterator> equal_range(const key_type& k) {
+        return {lower_bound(k), upper_bound(k)};
+    }
+
+    pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+        return {lower_bound(k), upper_bound(k)};
+    }
+
+    // -------------------------------------------------------------------------
+    // 删除
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief 删除 pos 指向的元素，返回后继元素的迭代器
+     */
+    iterator erase(const_iterator pos) {
+        return erase_at(pos.leaf_, pos.pos_);
+    }
+
+    size_type erase(const key_type& k) {
+        iterator it = find(k);
+        if (it == end()) return 0;
+        erase_at(it.leaf_, it.pos_);
+        return 1;
+    }
+
+    /**
+     * @brief 删除 [first, last)
+     */
+    iterator erase(iterator first, iterator last) {
+        if (first == begin() && last == end()) {
+            clear();
+            return end();
+        }
+        // 删除会移动元素，按个数而不是按迭代器终点来删
+        size_type n = 0;
+        for (iterator it = first; it != last; ++it) ++n;
+        while (n--) first = erase(first);
+        return first;
+    }
+
+    void clear() noexcept {
+        if (root_) free_subtree(root_);
+        reset();
+    }
+
+    key_compare key_comp() const noexcept { return comp_; }
+};
+
+// ============================================================================
+// btree_map
+// ============================================================================
+
+/** 批量构建标签：输入区间已按比较器严格升序排列且无重复 */
+struct sorted_unique_t { explicit sorted_unique_t() = default; };
+constexpr sorted_unique_t sorted_unique{};
+
+/**
+ * @brief 基于 B+ 树的有序映射，接口与 map 相同
+ *
+ * 适合大量元素的有序索引：点查找少几次缓存未命中，
+ * 区间扫描与顺序遍历是连续内存访问。
+ *
+ * 示例：
+ * @code
+ * zen::btree_map<uint64_t, uint32_t> idx;
+ * idx[42] = 1;
+ * for (auto it = idx.lower_bound(10); it != idx.end() && it->first < 100; ++it) { ... }
+ *
+ * // 已排序且无重复的数据可直接批量构建，O(n)
+ * zen::btree_map<int, int> m(zen::sorted_unique, sorted.begin(), sorted.end());
+ * @endcode
+ */
+template<typename Key,
+         typename Value,
+         typename Compare = less<Key>,
+         typename Alloc = allocator<pair<const Key, Value>>>
+class btree_map
+    : public btree<detail::btree_map_policy<Key, Value>, Compare, Alloc> {
+    using base = btree<detail::btree_map_policy<Key, Value>, Compare, Alloc>;
+
+public:
+    using mapped_type = Value;
+    using typename base::value_type;
+    using typename base::iterator;
+    using typename base::size_type;
+
+    btree_map() = default;
+
+    /**
+     * @brief 从已排序、无重复的区间批量构建，O(n)，节点几乎全满
+     */
+    template<typename InputIt>
+    btree_map(sorted_unique_t, InputIt first, InputIt last) {
+        this->build_sorted_range(first, last);
+    }
+
+    /**
+     * @brief 用已排序、无重复的区间替换全部内容
+     */
+    template<typename InputIt>
+    void assign_sorted(InputIt first, InputIt last) {
+        this->clear();
+        this->build_sorted_range(first, last);
+    }
+
+    // -------------------------------------------------------------------------
+    // 下标访问
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief operator[]：若键不存在则默认插入（键已存在时不构造临时值）
+     */
+    Value& operator[](const Key& key) {
+        iterator it = this->find(key);
+        if (it != this->end()) return it->second;
+        return this->emplace_key(key, key, Value{}).first->second;
+    }
+
+    Value& operator[](Key&& key) {
+        iterator it = this->find(key);
+        if (it != this->end()) return it->second;
+        return this->emplace_key(key, zen::move(key), Value{}).first->second;
+    }
+
+    /**
+     * @brief at()：若键不存在，行为未定义（与 map 相同，不抛异常）
+     */
+    Value& at(const Key& key) {
+        return this->find(key)->second;
+    }
+
+    const Value& at(const Key& key) const {
+        return this->find(key)->second;
+    }
+
+    // -------------------------------------------------------------------------
+    // 插入
+    // -------------------------------------------------------------------------
+
+    pair<iterator, bool> insert(const value_type& kv) {
+        return this->emplace_key(kv.first, kv);
+    }
+
+    pair<iterator, bool> insert(value_type&& kv) {
+        return this->emplace_key(kv.first, zen::move(const_cast<Key&>(kv.first)), zen::move(kv.second));
+    }
+
+    template<typename... Args>
+    pair<iterator, bool> emplace(Args&&... args) {
+        return insert(value_type(static_cast<Args&&>(args)...));
+    }
+};
+
+// ============================================================================
+// btree_set
+// ============================================================================
+
+/**
+ * @brief 基于 B+ 树的有序集合，接口与 set 相同
+ */
+template<typename Key,
+         typename Compare = less<Key>,
+         typename Alloc = allocator<Key>>
+class btree_set
+    : public btree<detail::btree_set_policy<Key>, Compare, Alloc> {
+    using base = btree<detail::btree_set_policy<Key>, Compare, Alloc>;
+
+public:
+    using typename base::iterator;
+    using typename base::size_type;
+
+    btree_set() = default;
+
+    template<typename InputIt>
+    btree_set(sorted_unique_t, InputIt first, InputIt last) {
+        this->build_sorted_range(first, last);
+    }
+
+    template<typename InputIt>
+    void assign_sorted(InputIt first, InputIt last) {
+        this->clear();
+        this->build_sorted_range(first, last);
+    }
+
+    pair<iterator, bool> insert(const Key& k) { return this->emplace_key(k, k); }
+    pair<iterator, bool> insert(Key&& k)      { return this->emplace_key(k, zen::move(k)); }
+
+    template<typename... Args>
+    pair<iterator, bool> emplace(Args&&... args) {
+        return insert(Key(static_cast<Args&&>(args)...));
+    }
+};
+
+} // namespace zen
+
+#endif // ZEN_CONTAINERS_ASSOCIATIVE_BTREE_MAP_H
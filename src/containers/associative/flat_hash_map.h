@@ -0,0 +1,807 @@
+#ifndef ZEN_CONTAINERS_ASSOCIATIVE_FLAT_HASH_MAP_H
+#define ZEN_CONTAINERS_ASSOCIATIVE_FLAT_HASH_MAP_H
+
+#include "../../base/type_traits.h"
+#include <cstdint>  // uint32_t / uint64_t
+#include "../../utility/swap.h"
+#include "../../utility/pair.h"
+#include "../../memory/allocator.h"
+#include "../../iterators/iterator_base.h"
+#include "../../utility/hash.h"  // hash / equal_to
+
+// SSE2 在所有 x86-64 目标上都可用；其他平台退化为逐字节扫描
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ZEN_FLAT_HASH_SSE2 1
+#else
+#define ZEN_FLAT_HASH_SSE2 0
+#endif
+
+namespace zen {
+
+// ============================================================================
+// 控制字节与 16 路分组探测
+// ============================================================================
+
+namespace detail {
+
+/**
+ * 每个槽位对应一个控制字节：
+ * - 0x00 ~ 0x7F：槽位已占用，低 7 位保存哈希的 H2 片段
+ * - CTRL_EMPTY：槽位空闲
+ * - CTRL_SENTINEL：槽位数组末尾的哨兵（以及其后的填充字节）
+ *
+ * 空闲与哨兵的最高位都是 1，因此一条 movemask 即可得到"探测终止"位图。
+ */
+using ctrl_t = unsigned char;
+
+static constexpr ctrl_t CTRL_EMPTY    = 0x80;
+static constexpr ctrl_t CTRL_SENTINEL = 0xFF;
+static constexpr size_t FLAT_GROUP_WIDTH = 16;
+
+/**
+ * 空表共享的控制字节（全部为哨兵），使默认构造不分配内存，
+ * begin() == end() 也无需特判。
+ */
+alignas(16) inline constexpr ctrl_t flat_empty_ctrl[FLAT_GROUP_WIDTH] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+/** 返回最低位 1 的下标（mask 必须非 0） */
+inline unsigned flat_ctz(uint32_t mask) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned n = 0;
+    while (!(mask & 1u)) { mask >>= 1; ++n; }
+    return n;
+#endif
+}
+
+/**
+ * @brief 一次装载 16 个控制字节，返回匹配位图（bit i 对应第 i 个槽位）
+ */
+struct flat_group {
+#if ZEN_FLAT_HASH_SSE2
+    __m128i ctrl;
+
+    explicit flat_group(const ctrl_t* p) noexcept
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+    /** H2 相等的槽位（候选） */
+    uint32_t match(ctrl_t h2) const noexcept {
+        return static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(h2)), ctrl)));
+    }
+
+    /** 空闲或哨兵槽位（探测终止点） */
+    uint32_t match_empty() const noexcept {
+        return static_cast<uint32_t>(_mm_movemask_epi8(ctrl));
+    }
+
+    /** 已占用或哨兵槽位（迭代停靠点） */
+    uint32_t match_non_empty() const noexcept {
+        return ~static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(CTRL_EMPTY)), ctrl))) & 0xFFFFu;
+    }
+#else
+    const ctrl_t* ctrl;
+
+    explicit flat_group(const ctrl_t* p) noexcept : ctrl(p) {}
+
+    uint32_t match(ctrl_t h2) const noexcept {
+        uint32_t m = 0;
+        for (size_t i = 0; i < FLAT_GROUP_WIDTH; ++i) if (ctrl[i] == h2) m |= 1u << i;
+        return m;
+    }
+
+    uint32_t match_empty() const noexcept {
+        uint32_t m = 0;
+        for (size_t i = 0; i < FLAT_GROUP_WIDTH; ++i) if (ctrl[i] & 0x80) m |= 1u << i;
+        return m;
+    }
+
+    uint32_t match_non_empty() const noexcept {
+        uint32_t m = 0;
+        for (size_t i = 0; i < FLAT_GROUP_WIDTH; ++i) if (ctrl[i] != CTRL_EMPTY) m |= 1u << i;
+        return m;
+    }
+#endif
+};
+
+// ----------------------------------------------------------------------------
+// 存储策略：决定槽位里放什么、如何取键
+// ----------------------------------------------------------------------------
+
+template<typename Key, typename Value>
+struct flat_map_policy {
+    using key_type   = Key;
+    using value_type = pair<const Key, Value>;
+    using iter_value = value_type;
+
+    static const Key& key(const value_type& v) noexcept { return v.first; }
+
+    /** 把 src 的内容移动到未构造的 dst 上，并析构 src（key 为 const，需要 const_cast 才能真正移动） */
+    template<typename A>
+    static void transfer(A& a, value_type* dst, value_type* src) {
+        a.construct(dst, zen::move(const_cast<Key&>(src->first)), zen::move(src->second));
+        a.destroy(src);
+    }
+};
+
+template<typename Key>
+struct flat_set_policy {
+    using key_type   = Key;
+    using value_type = Key;
+    using iter_value = const Key;   // 集合元素不可通过迭代器修改
+
+    static const Key& key(const value_type& v) noexcept { return v; }
+
+    template<typename A>
+    static void transfer(A& a, value_type* dst, value_type* src) {
+        a.construct(dst, zen::move(*src));
+        a.destroy(src);
+    }
+};
+
+} // namespace detail
+
+// ============================================================================
+// 迭代器
+// ============================================================================
+
+/**
+ * @brief 开放寻址表的前向迭代器
+ * @tparam T 元素类型（const 版本即 const_iterator）
+ *
+ * 同时步进控制字节与槽位指针；++ 时按 16 字节一组跳过空槽，
+ * 末尾的哨兵字节保证跳跃一定终止。
+ */
+template<typename T>
+struct flat_hash_iterator {
+    using value_type        = remove_cv_t<T>;
+    using reference         = T&;
+    using pointer           = T*;
+    using difference_type   = decltype((char*)0 - (char*)0);
+    using iterator_category = forward_iterator_tag;
+
+    const detail::ctrl_t* ctrl_;
+    T*                    slot_;
+
+    flat_hash_iterator() noexcept : ctrl_(nullptr), slot_(nullptr) {}
+    flat_hash_iterator(const detail::ctrl_t* c, T* s) noexcept : ctrl_(c), slot_(s) {}
+
+    // 从非 const 迭代器构造
+    template<typename U, typename = enable_if_t<is_same_v<const U, T> && !is_same_v<U, T>>>
+    flat_hash_iterator(const flat_hash_iterator<U>& it) noexcept
+        : ctrl_(it.ctrl_), slot_(it.slot_) {}
+
+    reference operator*()  const noexcept { return *slot_; }
+    pointer   operator->() const noexcept { return slot_; }
+
+    flat_hash_iterator& operator++() noexcept {
+        ++ctrl_;
+        ++slot_;
+        skip_empty();
+        return *this;
+    }
+
+    flat_hash_iterator operator++(int) noexcept { flat_hash_iterator t = *this; ++(*this); return t; }
+
+    bool operator==(const flat_hash_iterator& o) const noexcept { return ctrl_ == o.ctrl_; }
+    bool operator!=(const flat_hash_iterator& o) const noexcept { return ctrl_ != o.ctrl_; }
+
+    /** 前进到下一个已占用槽位或哨兵 */
+    void skip_empty() noexcept {
+        for (;;) {
+            uint32_t bits = detail::flat_group(ctrl_).match_non_empty();
+            if (bits) {
+                unsigned s = detail::flat_ctz(bits);
+                ctrl_ += s;
+                slot_ += s;
+                return;
+            }
+            ctrl_ += detail::FLAT_GROUP_WIDTH;
+            slot_ += detail::FLAT_GROUP_WIDTH;
+        }
+    }
+};
+
+// ============================================================================
+// flat_hash_table - 开放寻址哈希表内核
+// ============================================================================
+
+/**
+ * @brief flat_hash_map / flat_hash_set 共用的开放寻址哈希表
+ * @tparam Policy   存储策略（槽位类型、取键方式）
+ * @tparam Hash     哈希函数，与 unordered_map 相同的定制点
+ * @tparam KeyEqual 键相等比较器
+ * @tparam Alloc    分配器
+ *
+ * 内存布局：
+ * - slots_: capacity_ + tail 个内联槽位（元素直接存放，无单独节点）
+ * - ctrl_:  每个槽位一个控制字节，末尾附一个哨兵和 15 个填充字节，
+ *           使任意位置起的 16 字节装载都不越界
+ *
+ * 哈希拆分：
+ * - 先用黄金分割常数乘法把 Hash 的结果打散为 64 位 m
+ * - H1 = m 的高位 → 起始槽位（home）
+ * - H2 = 紧随其后的 7 位 → 存入控制字节，用于 SIMD 初筛
+ *
+ * 探测：从 home 起做线性探测，每次比较 16 个控制字节；
+ * 只要窗口内出现空槽即可断定键不存在。
+ *
+ * 删除（无墓碑）：
+ * 表不回绕——溢出 capacity_ 的元素放入尾部的 tail 区，tail 也放满时扩容。
+ * 因此删除可以使用"反向移位"：把后续 home 不晚于空洞的元素逐个前移填洞，
+ * 直到遇到空槽。探测链始终连续，查找永远不会被墓碑拉长，
+ * 且元素只会向低地址移动，边迭代边 erase 不会重复或遗漏。
+ *
+ * 负载上限为 7/8（相对于 capacity_）。
+ */
+template<typename Policy, typename Hash, typename KeyEqual, typename Alloc>
+class flat_hash_table {
+public:
+    using key_type        = typename Policy::key_type;
+    using value_type      = typename Policy::value_type;
+    using size_type       = size_t;
+    using difference_type = decltype((char*)0 - (char*)0);
+    using hasher          = Hash;
+    using key_equal       = KeyEqual;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using iterator        = flat_hash_iterator<typename Policy::iter_value>;
+    using const_iterator  = flat_hash_iterator<const value_type>;
+
+protected:
+    using ctrl_t     = detail::ctrl_t;
+    using slot_alloc = typename Alloc::template rebind<value_type>::other;
+    using ctrl_alloc = typename Alloc::template rebind<ctrl_t>::other;
+
+    static constexpr size_type MIN_CAPACITY = detail::FLAT_GROUP_WIDTH;
+
+    ctrl_t*     ctrl_;          ///< 控制字节（空表时指向 flat_empty_ctrl）
+    value_type* slots_;         ///< 槽位数组
+    size_type   capacity_;      ///< home 槽位数（2 的幂，空表为 0）
+    size_type   slot_count_;    ///< 实际槽位数 = capacity_ + tail
+    size_type   size_;
+    unsigned    shift_;         ///< 64 - log2(capacity_)
+    Hash        hasher_;
+    KeyEqual    key_eq_;
+    slot_alloc  slot_alloc_;
+    ctrl_alloc  ctrl_alloc_;
+
+    // -------------------------------------------------------------------------
+    // 哈希拆分
+    // -------------------------------------------------------------------------
+
+    static uint64_t mix(size_t h) noexcept {
+        return static_cast<uint64_t>(h) * 0x9E3779B97F4A7C15ULL;
+    }
+
+    size_type home_of(uint64_t m) const noexcept {
+        return static_cast<size_type>(m >> shift_);
+    }
+
+    ctrl_t h2_of(uint64_t m) const noexcept {
+        return static_cast<ctrl_t>((m >> (shift_ - 7)) & 0x7F);
+    }
+
+    /** 溢出区长度：容量的 1/8，至少一个分组 */
+    static size_type tail_of(size_type cap) noexcept {
+        size_type t = cap >> 3;
+        return t < detail::FLAT_GROUP_WIDTH ? detail::FLAT_GROUP_WIDTH : t;
+    }
+
+    size_type max_load() const noexcept { return capacity_ - (capacity_ >> 3); }
+
+    // -------------------------------------------------------------------------
+    // 内存管理
+    // -------------------------------------------------------------------------
+
+    void reset_empty() noexcept {
+        ctrl_       = const_cast<ctrl_t*>(detail::flat_empty_ctrl);
+        slots_      = nullptr;
+        capacity_   = 0;
+        slot_count_ = 0;
+        size_       = 0;
+        shift_      = 64;
+    }
+
+    /** 按 cap 分配数组，控制字节全部置空，末尾写入哨兵 */
+    void allocate_arrays(size_type cap) {
+        size_type sc = cap + tail_of(cap);
+        ctrl_t* c = ctrl_alloc_.allocate(sc + detail::FLAT_GROUP_WIDTH);
+        value_type* s;
+        try {
+            s = slot_alloc_.allocate(sc);
+        } catch (...) {
+            ctrl_alloc_.deallocate(c, sc + detail::FLAT_GROUP_WIDTH);
+            throw;
+        }
+        for (size_type i = 0; i < sc; ++i) c[i] = detail::CTRL_EMPTY;
+        for (size_type i = 0; i < detail::FLAT_GROUP_WIDTH; ++i) c[sc + i] = detail::CTRL_SENTINEL;
+        ctrl_       = c;
+        slots_      = s;
+        capacity_   = cap;
+        slot_count_ = sc;
+        unsigned bits = 0;
+        while ((size_type(1) << bits) < cap) ++bits;
+        shift_ = 64 - bits;
+    }
+
+    void destroy_all() noexcept {
+        if (!capacity_) return;
+        for (size_type i = 0; i < slot_count_; ++i) {
+            if (ctrl_[i] != detail::CTRL_EMPTY) slot_alloc_.destroy(slots_ + i);
+        }
+    }
+
+    void free_arrays() noexcept {
+        if (!capacity_) return;
+        ctrl_alloc_.deallocate(ctrl_, slot_count_ + detail::FLAT_GROUP_WIDTH);
+        slot_alloc_.deallocate(slots_, slot_count_);
+    }
+
+    /** 从 home 起第一个空槽位（可能 >= slot_count_，表示溢出区已满） */
+    size_type find_empty(uint64_t m) const noexcept {
+        size_type pos = home_of(m);
+        for (;;) {
+            uint32_t e = detail::flat_group(ctrl_ + pos).match_empty();
+            if (e) return pos + detail::flat_ctz(e);
+            pos += detail::FLAT_GROUP_WIDTH;
+        }
+    }
+
+    /** 查找键，返回槽位下标，不存在时返回 slot_count_ */
+    template<typename K>
+    size_type find_index(const K& key) const noexcept {
+        if (size_ == 0) return slot_count_;
+        uint64_t m   = mix(hasher_(key));
+        size_type pos = home_of(m);
+        ctrl_t   h2  = h2_of(m);
+        for (;;) {
+            detail::flat_group g(ctrl_ + pos);
+            uint32_t bits = g.match(h2);
+            while (bits) {
+                size_type i = pos + detail::flat_ctz(bits);
+                if (key_eq_(Policy::key(slots_[i]), key)) return i;
+                bits &= bits - 1;
+            }
+            if (g.match_empty()) return slot_count_;
+            pos += detail::FLAT_GROUP_WIDTH;
+        }
+    }
+
+    /** 把元素（已知不在表中）搬入 m 对应的位置，必要时扩容 */
+    void transfer_unique(uint64_t m, value_type* src) {
+        size_type i = find_empty(m);
+        while (i >= slot_count_) {
+            rehash_to(capacity_ * 2);
+            i = find_empty(m);
+        }
+        Policy::transfer(slot_alloc_, slots_ + i, src);
+        ctrl_[i] = h2_of(m);
+        ++size_;
+    }
+
+    /**
+     * @brief 重建为 new_cap 个 home 槽位
+     *
+     * 新表自身在溢出时会继续翻倍，因此重建不会失败。
+     */
+    void rehash_to(size_type new_cap) {
+        flat_hash_table tmp(hasher_, key_eq_, slot_alloc_, ctrl_alloc_);
+        tmp.allocate_arrays(new_cap);
+        for (size_type i = 0; i < slot_count_; ++i) {
+            if (ctrl_[i] == detail::CTRL_EMPTY) continue;
+            tmp.transfer_unique(mix(hasher_(Policy::key(slots_[i]))), slots_ + i);
+        }
+        // 旧槽位中的元素均已被 transfer 析构，只需释放数组
+        free_arrays();
+        ctrl_       = tmp.ctrl_;
+        slots_      = tmp.slots_;
+        capacity_   = tmp.capacity_;
+        slot_count_ = tmp.slot_count_;
+        shift_      = tmp.shift_;
+        tmp.reset_empty();
+    }
+
+    /**
+     * @brief 查找 key；不存在时找出插入用的空槽位（必要时先扩容），但不构造元素
+     * @param m mix(hasher_(key))
+     * @return {槽位下标, 键是否已存在}
+     */
+    template<typename K>
+    pair<size_type, bool> find_or_prepare(const K& key, uint64_t m) {
+        size_type i = slot_count_;
+        if (capacity_) {
+            size_type pos = home_of(m);
+            ctrl_t    h2  = h2_of(m);
+            for (;;) {
+                detail::flat_group g(ctrl_ + pos);
+                uint32_t bits = g.match(h2);
+                while (bits) {
+                    size_type j = pos + detail::flat_ctz(bits);
+                    if (key_eq_(Policy::key(slots_[j]), key)) return {j, true};
+                    bits &= bits - 1;
+                }
+                uint32_t e = g.match_empty();
+                if (e) { i = pos + detail::flat_ctz(e); break; }
+                pos += detail::FLAT_GROUP_WIDTH;
+            }
+        }
+        if (i >= slot_count_ || size_ + 1 > max_load()) {
+            rehash_to(capacity_ ? capacity_ * 2 : MIN_CAPACITY);
+            i = find_empty(m);
+            while (i >= slot_count_) {
+                rehash_to(capacity_ * 2);
+                i = find_empty(m);
+            }
+        }
+        return {i, false};
+    }
+
+    /** 在 find_or_prepare 给出的空槽位上构造元素；构造抛异常时槽位保持为空 */
+    template<typename... Args>
+    iterator construct_at(size_type i, uint64_t m, Args&&... args) {
+        slot_alloc_.construct(slots_ + i, static_cast<Args&&>(args)...);
+        ctrl_[i] = h2_of(m);
+        ++size_;
+        return make_iter(i);
+    }
+
+    /**
+     * @brief 查找 key，不存在则在其探测链末尾用 args 构造新元素
+     * @return {迭代器, 是否新插入}
+     */
+    template<typename K, typename... Args>
+    pair<iterator, bool> emplace_key(const K& key, Args&&... args) {
+        uint64_t m = mix(hasher_(key));
+        pair<size_type, bool> r = find_or_prepare(key, m);
+        if (r.second) return {make_iter(r.first), false};
+        return {construct_at(r.first, m, static_cast<Args&&>(args)...), true};
+    }
+
+    /** 反向移位删除槽位 i 的元素 */
+    void erase_at(size_type i) {
+        slot_alloc_.destroy(slots_ + i);
+        size_type hole = i;
+        for (size_type j = i + 1; j < slot_count_ && ctrl_[j] != detail::CTRL_EMPTY; ++j) {
+            if (home_of(mix(hasher_(Policy::key(slots_[j])))) <= hole) {
+                Policy::transfer(slot_alloc_, slots_ + hole, slots_ + j);
+                ctrl_[hole] = ctrl_[j];
+                hole = j;
+            }
+        }
+        ctrl_[hole] = detail::CTRL_EMPTY;
+        --size_;
+    }
+
+    iterator       make_iter(size_type i)       noexcept { return iterator(ctrl_ + i, slots_ + i); }
+    const_iterator make_iter(size_type i) const noexcept { return const_iterator(ctrl_ + i, slots_ + i); }
+
+    flat_hash_table(const Hash& h, const KeyEqual& eq, const slot_alloc& sa, const ctrl_alloc& ca)
+        : hasher_(h), key_eq_(eq), slot_alloc_(sa), ctrl_alloc_(ca) {
+        reset_empty();
+    }
+
+public:
+    // -------------------------------------------------------------------------
+    // 构造 / 析构
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief 默认构造：不分配内存，首次插入时分配 16 个槽位
+     */
+    flat_hash_table() : hasher_(), key_eq_(), slot_alloc_(), ctrl_alloc_() {
+        reset_empty();
+    }
+
+    /**
+     * @brief 预留至少能容纳 n 个元素的空间
+     */
+    explicit flat_hash_table(size_type n) : flat_hash_table() { reserve(n); }
+
+    /**
+     * @brief 指定分配器（例如 arena_allocator）构造
+     */
+    explicit flat_hash_table(const Alloc& alloc)
+        : hasher_(), key_eq_(), slot_alloc_(alloc), ctrl_alloc_(alloc) {
+        reset_empty();
+    }
+
+    /**
+     * @brief 拷贝构造：控制字节原样复制，元素在相同下标上拷贝构造
+     *
+     * 元素拷贝抛出异常时析构已拷贝的元素、释放数组后重新抛出（析构函数不会运行）。
+     */
+    flat_hash_table(const flat_hash_table& o)
+        : hasher_(o.hasher_), key_eq_(o.key_eq_),
+          slot_alloc_(o.slot_alloc_), ctrl_alloc_(o.ctrl_alloc_) {
+        reset_empty();
+        if (!o.capacity_) return;
+        allocate_arrays(o.capacity_);
+        try {
+            for (size_type i = 0; i < slot_count_; ++i) {
+                if (o.ctrl_[i] != detail::CTRL_EMPTY) {
+                    slot_alloc_.construct(slots_ + i, o.slots_[i]);
+                    ctrl_[i] = o.ctrl_[i];
+                    ++size_;
+                }
+            }
+        } catch (...) {
+            destroy_all();
+            free_arrays();
+            throw;
+        }
+    }
+
+    flat_hash_table(flat_hash_table&& o) noexcept
+        : ctrl_(o.ctrl_), slots_(o.slots_), capacity_(o.capacity_),
+          slot_count_(o.slot_count_), size_(o.size_), shift_(o.shift_),
+          hasher_(zen::move(o.hasher_)), key_eq_(zen::move(o.key_eq_)),
+          slot_alloc_(zen::move(o.slot_alloc_)), ctrl_alloc_(zen::move(o.ctrl_alloc_)) {
+        o.reset_empty();
+    }
+
+    ~flat_hash_table() { destroy_all(); free_arrays(); }
+
+    flat_hash_table& operator=(const flat_hash_table& o) {
+        if (this != &o) {
+            flat_hash_table t(o);
+            swap(t);
+        }
+        return *this;
+    }
+
+    flat_hash_table& operator=(flat_hash_table&& o) noexcept {
+        if (this != &o) {
+            destroy_all(); free_arrays();
+            ctrl_ = o.ctrl_; slots_ = o.slots_; capacity_ = o.capacity_;
+            slot_count_ = o.slot_count_; size_ = o.size_; shift_ = o.shift_;
+            hasher_ = zen::move(o.hasher_); key_eq_ = zen::move(o.key_eq_);
+            slot_alloc_ = zen::move(o.slot_alloc_); ctrl_alloc_ = zen::move(o.ctrl_alloc_);
+            o.reset_empty();
+        }
+        return *this;
+    }
+
+    void swap(flat_hash_table& o) noexcept {
+        zen::swap(ctrl_, o.ctrl_);
+        zen::swap(slots_, o.slots_);
+        zen::swap(capacity_, o.capacity_);
+        zen::swap(slot_count_, o.slot_count_);
+        zen::swap(size_, o.size_);
+        zen::swap(shift_, o.shift_);
+        zen::swap(hasher_, o.hasher_);
+        zen::swap(key_eq_, o.key_eq_);
+        zen::swap(slot_alloc_, o.slot_alloc_);
+        zen::swap(ctrl_alloc_, o.ctrl_alloc_);
+    }
+
+    // -------------------------------------------------------------------------
+    // 容量
+    // -------------------------------------------------------------------------
+
+    bool      empty()        const noexcept { return size_ == 0; }
+    size_type size()         const noexcept { return size_; }
+    size_type bucket_count() const noexcept { return capacity_; }
+    float     load_factor()  const noexcept {
+        return capacity_ ? static_cast<float>(size_) / static_cast<float>(capacity_) : 0;
+    }
+
+    /**
+     * @brief 保证插入 n 个元素前不再扩容
+     */
+    void reserve(size_type n) {
+        size_type cap = capacity_ ? capacity_ : MIN_CAPACITY;
+        while (cap - (cap >> 3) < n) cap *= 2;
+        if (cap > capacity_) rehash_to(cap);
+    }
+
+    /**
+     * @brief 销毁所有元素，保留已分配的槽位
+     */
+    void clear() noexcept {
+        if (!capacity_) return;
+        destroy_all();
+        for (size_type i = 0; i < slot_count_; ++i) ctrl_[i] = detail::CTRL_EMPTY;
+        size_ = 0;
+    }
+
+    // -------------------------------------------------------------------------
+    // 迭代器
+    // -------------------------------------------------------------------------
+
+    iterator begin() noexcept {
+        iterator it(ctrl_, slots_);
+        it.skip_empty();
+        return it;
+    }
+    const_iterator begin() const noexcept {
+        const_iterator it(ctrl_, slots_);
+        it.skip_empty();
+        return it;
+    }
+    iterator       end()          noexcept { return make_iter(slot_count_); }
+    const_iterator end()    const noexcept { return make_iter(slot_count_); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend()   const noexcept { return end(); }
+
+    // -------------------------------------------------------------------------
+    // 查找
+    // -------------------------------------------------------------------------
+
+    iterator       find(const key_type& k)       noexcept { return make_iter(find_index(k)); }
+    const_iterator find(const key_type& k) const noexcept { return make_iter(find_index(k)); }
+
+    bool      contains(const key_type& k) const noexcept { return find_index(k) != slot_count_; }
+    size_type count(const key_type& k)    const noexcept { return contains(k) ? 1u : 0u; }
+
+    // 异构查找：Hash 与 KeyEqual 均为透明比较器时，可用 string_view 等直接查找，不构造 Key
+    template<typename K, typename H = Hash, typename E = KeyEqual,
+             typename = enable_if_t<is_transparent_lookup_v<H, E>>>
+    iterator       find(const K& k)       noexcept { return make_iter(find_index(k)); }
+    template<typename K, typename H = Hash, typename E = KeyEqual,
+             typename = enable_if_t<is_transparent_lookup_v<H, E>>>
+    const_iterator find(const K& k) const noexcept { return make_iter(find_index(k)); }
+    template<typename K, typename H = Hash, typename E = KeyEqual,
+             typename = enable_if_t<is_transparent_lookup_v<H, E>>>
+    bool           contains(const K& k) const noexcept { return find_index(k) != slot_count_; }
+    template<typename K, typename H = Hash, typename E = KeyEqual,
+             typename = enable_if_t<is_transparent_lookup_v<H, E>>>
+    size_type      count(const K& k)    const noexcept { return contains(k) ? 1u : 0u; }
+
+    // -------------------------------------------------------------------------
+    // 删除
+    // -------------------------------------------------------------------------
+
+    size_type erase(const key_type& k) {
+        size_type i = find_index(k);
+        if (i == slot_count_) return 0;
+        erase_at(i);
+        return 1;
+    }
+
+    template<typename K, typename H = Hash, typename E = KeyEqual,
+             typename = enable_if_t<is_transparent_lookup_v<H, E>>>
+    size_type erase(const K& k) {
+        size_type i = find_index(k);
+        if (i == slot_count_) return 0;
+        erase_at(i);
+        return 1;
+    }
+
+    /**
+     * @brief 删除 pos 指向的元素，返回其后继
+     *
+     * 反向移位可能把后面的元素挪到 pos 所在槽位，此时直接返回该槽位。
+     */
+    iterator erase(iterator pos) {
+        size_type i = static_cast<size_type>(pos.ctrl_ - ctrl_);
+        erase_at(i);
+        iterator it = make_iter(i);
+        it.skip_empty();
+        return it;
+    }
+
+    hasher    hash_function()   const noexcept { return hasher_; }
+    key_equal key_eq_function() const noexcept { return key_eq_; }
+};
+
+// ============================================================================
+// flat_hash_map
+// ============================================================================
+
+/**
+ * @brief 开放寻址、元素内联存储的哈希映射
+ *
+ * 与 unordered_map 接口和定制点（hash / equal_to / Alloc）一致，
+ * 但不为每个元素单独分配节点，查找通常只触及一条控制字节缓存行和一个槽位。
+ *
+ * 与 unordered_map 的差异：
+ * - 插入或 rehash 后，已有元素的指针 / 引用 / 迭代器全部失效
+ * - erase 会移动其后的元素，被移动元素的指针与迭代器失效
+ *
+ * 示例：
+ * @code
+ * zen::flat_hash_map<uint64_t, session*> sessions;
+ * sessions.reserve(1 << 20);
+ * sessions[id] = s;
+ * auto it = sessions.find(id);
+ * @endcode
+ */
+template<typename Key,
+         typename Value,
+         typename Hash     = hash<Key>,
+         typename KeyEqual = equal_to<Key>,
+         typename Alloc    = allocator<pair<const Key, Value>>>
+class flat_hash_map
+    : public flat_hash_table<detail::flat_map_policy<Key, Value>, Hash, KeyEqual, Alloc> {
+    using base = flat_hash_table<detail::flat_map_policy<Key, Value>, Hash, KeyEqual, Alloc>;
+
+public:
+    using mapped_type = Value;
+    using typename base::value_type;
+    using typename base::iterator;
+    using typename base::const_iterator;
+
+    using base::base;
+
+    pair<iterator, bool> insert(const value_type& kv) {
+        return this->emplace_key(kv.first, kv);
+    }
+
+    pair<iterator, bool> insert(value_type&& kv) {
+        return this->emplace_key(kv.first, zen::move(const_cast<Key&>(kv.first)), zen::move(kv.second));
+    }
+
+    template<typename... Args>
+    pair<iterator, bool> emplace(Args&&... args) {
+        return insert(value_type(static_cast<Args&&>(args)...));
+    }
+
+    /**
+     * @brief 键不存在时才用 args 构造值（键存在时不构造任何临时对象，右值实参也不会被移走）
+     */
+    template<typename... Args>
+    pair<iterator, bool> try_emplace(const Key& k, Args&&... args) {
+        uint64_t m = this->mix(this->hasher_(k));
+        pair<size_t, bool> r = this->find_or_prepare(k, m);
+        if (r.second) return {this->make_iter(r.first), false};
+        return {this->construct_at(r.first, m, k, Value(static_cast<Args&&>(args)...)), true};
+    }
+
+    Value& operator[](const Key& k) {
+        size_t i = this->find_index(k);
+        if (i != this->slot_count_) return this->slots_[i].second;
+        return this->emplace_key(k, k, Value{}).first->second;
+    }
+
+    Value& operator[](Key&& k) {
+        size_t i = this->find_index(k);
+        if (i != this->slot_count_) return this->slots_[i].second;
+        return this->emplace_key(k, zen::move(k), Value{}).first->second;
+    }
+
+    /**
+     * @brief at()：若键不存在，行为未定义（与 map::at 一致，不抛异常）
+     */
+    Value&       at(const Key& k)       noexcept { return this->slots_[this->find_index(k)].second; }
+    const Value& at(const Key& k) const noexcept { return this->slots_[this->find_index(k)].second; }
+};
+
+// ============================================================================
+// flat_hash_set
+// ============================================================================
+
+/**
+ * @brief 开放寻址、元素内联存储的哈希集合（槽位只存 Key，不带占位值）
+ */
+template<typename Key,
+         typename Hash     = hash<Key>,
+         typename KeyEqual = equal_to<Key>,
+         typename Alloc    = allocator<Key>>
+class flat_hash_set
+    : public flat_hash_table<detail::flat_set_policy<Key>, Hash, KeyEqual, Alloc> {
+    using base = flat_hash_table<detail::flat_set_policy<Key>, Hash, KeyEqual, Alloc>;
+
+public:
+    using typename base::iterator;
+
+    using base::base;
+
+    pair<iterator, bool> insert(const Key& k) { return this->emplace_key(k, k); }
+    pair<iterator, bool> insert(Key&& k)      { return this->emplace_key(k, zen::move(k)); }
+
+    template<typename... Args>
+    pair<iterator, bool> emplace(Args&&... args) {
+        return insert(Key(static_cast<Args&&>(args)...));
+    }
+};
+
+} // namespace zen
+
+#endif // ZEN_CONTAINERS_ASSOCIATIVE_FLAT_HASH_MAP_H
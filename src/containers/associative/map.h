@@ -5,24 +5,12 @@
 #include "../../utility/swap.h"
 #include "../../utility/pair.h"
 #include "../../memory/allocator.h"
+#include "../../memory/node_pool.h"
 #include "../../iterators/iterator_base.h"
+#include "../../algorithms/comparators.h"  // less
 
 namespace zen {
 
-// ============================================================================
-// 比较器
-// ============================================================================
-
-/**
- * @brief 默认小于比较器
- */
-template<typename T>
-struct less {
-    constexpr bool operator()(const T& a, const T& b) const noexcept {
-        return a < b;
-    }
-};
-
 // ============================================================================
 // 红黑树节点颜色
 // ============================================================================
@@ -221,11 +209,106 @@ struct rb_const_iterator {
 };
 
 // ============================================================================
-// map 容器（基于红黑树）
+// 节点句柄（extract / insert(node_type&&)）
+// ============================================================================
+
+/**
+ * @brief 从红黑树中摘下的单个节点
+ *
+ * 句柄独占节点，并持有节点所属 node_pool 的一个引用，
+ * 因此原容器析构后句柄依然有效。句柄析构时若仍持有节点，
+ * 则析构元素并把内存还给原节点池。
+ *
+ * 插入任何容器都是直接重新挂链，不移动元素、不重新分配节点：
+ * 插入其他容器时，目标容器的节点池接收（adopt）来源节点池，
+ * 节点内存保持有效直到目标容器 clear() / 析构。
+ */
+template<typename Key, typename Value, typename NodeAlloc>
+class rb_node_handle {
+public:
+    using key_type    = Key;
+    using mapped_type = Value;
+    using value_type  = pair<const Key, Value>;
+
+private:
+    using tree_node = rb_node<Key, Value>;
+    using pool_type = node_pool<tree_node, NodeAlloc>;
+
+    template<typename, typename, typename, typename, bool> friend class rb_tree;
+
+    tree_node* node_;
+    pool_type* pool_;
+
+    rb_node_handle(tree_node* n, pool_type* p) noexcept : node_(n), pool_(p) {
+        pool_->add_ref();
+    }
+
+    /** 交出节点（不析构），同时放弃对节点池的引用 */
+    tree_node* release() noexcept {
+        tree_node* n = node_;
+        pool_type::unref(pool_);
+        node_ = nullptr;
+        pool_ = nullptr;
+        return n;
+    }
+
+    void reset() noexcept {
+        if (!node_) return;
+        NodeAlloc a = pool_->get_allocator();
+        a.destroy(node_);
+        pool_->deallocate(node_);
+        pool_type::unref(pool_);
+        node_ = nullptr;
+        pool_ = nullptr;
+    }
+
+public:
+    rb_node_handle() noexcept : node_(nullptr), pool_(nullptr) {}
+
+    rb_node_handle(rb_node_handle&& o) noexcept : node_(o.node_), pool_(o.pool_) {
+        o.node_ = nullptr;
+        o.pool_ = nullptr;
+    }
+
+    rb_node_handle& operator=(rb_node_handle&& o) noexcept {
+        if (this != &o) {
+            reset();
+            node_ = o.node_; pool_ = o.pool_;
+            o.node_ = nullptr; o.pool_ = nullptr;
+        }
+        return *this;
+    }
+
+    rb_node_handle(const rb_node_handle&) = delete;
+    rb_node_handle& operator=(const rb_node_handle&) = delete;
+
+    ~rb_node_handle() { reset(); }
+
+    bool empty() const noexcept { return node_ == nullptr; }
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+
+    /** 键可修改：节点不在任何树中，改键后再插入即可"重命名"条目 */
+    Key&   key()    const noexcept { return const_cast<Key&>(node_->kv.first); }
+    Value& mapped() const noexcept { return node_->kv.second; }
+    value_type& value() const noexcept { return node_->kv; }
+};
+
+/**
+ * @brief insert(node_type&&) 的返回值
+ */
+template<typename Iterator, typename NodeType>
+struct rb_insert_return {
+    Iterator position;
+    bool     inserted;
+    NodeType node;      ///< 插入失败（键已存在）时节点原样退回
+};
+
+// ============================================================================
+// rb_tree（map / multimap / set / multiset 共用的红黑树内核）
 // ============================================================================
 
 /**
- * @brief 有序关联容器，基于红黑树实现
+ * @brief 红黑树内核
  *
  * 红黑树性质：
  *  1. 每个节点是红色或黑色
@@ -239,16 +322,23 @@ struct rb_const_iterator {
  *  - begin / end：O(1)
  *  - 中序遍历：O(n)
  *
+ * 节点内存：
+ *  每个容器独占一个 node_pool（首次插入时创建），节点按块批量申请，
+ *  erase 的节点进入池的空闲列表复用；clear() / 析构时整块归还，
+ *  元素可平凡析构时甚至无需遍历树。
+ *
  * @tparam Key     键类型
  * @tparam Value   值类型
- * @tparam Compare 比较器，默认为 less<Key>
- * @tparam Alloc   分配器，默认为 allocator<pair<const Key, Value>>
+ * @tparam Compare 比较器
+ * @tparam Alloc   分配器（rebind 到节点类型后用于申请节点块）
+ * @tparam Multi   是否允许重复键
  */
 template<typename Key,
          typename Value,
-         typename Compare = less<Key>,
-         typename Alloc = allocator<pair<const Key, Value>>>
-class map {
+         typename Compare,
+         typename Alloc,
+         bool     Multi>
+class rb_tree {
 public:
     // -------------------------------------------------------------------------
     // 类型定义
@@ -266,21 +356,28 @@ public:
     using iterator        = rb_iterator<Key, Value>;
     using const_iterator  = rb_const_iterator<Key, Value>;
 
-private:
+protected:
     // -------------------------------------------------------------------------
     // 内部类型
     // -------------------------------------------------------------------------
-    using node_type  = rb_node<Key, Value>;
-    using node_alloc = typename Alloc::template rebind<node_type>::other;
+    using tree_node  = rb_node<Key, Value>;
+    using node_alloc = typename Alloc::template rebind<tree_node>::other;
+    using pool_type  = node_pool<tree_node, node_alloc>;
+
+public:
+    using node_type          = rb_node_handle<Key, Value, node_alloc>;
+    using insert_return_type = rb_insert_return<iterator, node_type>;
 
+protected:
     // -------------------------------------------------------------------------
     // 成员变量
     // -------------------------------------------------------------------------
-    node_type*  nil_;       ///< 哨兵节点（所有叶子、根的父）
-    node_type*  root_;      ///< 根节点（初始时等于 nil_）
+    tree_node*  nil_;       ///< 哨兵节点（所有叶子、根的父）
+    tree_node*  root_;      ///< 根节点（初始时等于 nil_）
     size_type   size_;      ///< 节点数量
     Compare     comp_;
-    node_alloc  alloc_;
+    node_alloc  alloc_;     ///< 哨兵分配、元素构造 / 析构
+    pool_type*  pool_;      ///< 节点池（空树时可能为 nullptr）
 
     // -------------------------------------------------------------------------
     // 内部辅助
@@ -288,8 +385,9 @@ private:
 
     /** 分配并构造节点 */
     template<typename... Args>
-    node_type* make_node(Args&&... args) {
-        node_type* n = alloc_.allocate(1);
+    tree_node* make_node(Args&&... args) {
+        if (!pool_) pool_ = pool_type::create(alloc_);
+        tree_node* n = pool_->allocate();
         alloc_.construct(n, static_cast<Args&&>(args)...);
         n->left  = nil_;
         n->right = nil_;
@@ -298,24 +396,48 @@ private:
         return n;
     }
 
-    /** 析构并释放节点 */
-    void free_node(node_type* n) {
+    /** 析构节点并放回节点池 */
+    void free_node(tree_node* n) {
         alloc_.destroy(n);
-        alloc_.deallocate(n, 1);
+        pool_->deallocate(n);
     }
 
     /** 递归释放子树（后序） */
-    void free_subtree(node_type* x) {
+    void free_subtree(tree_node* x) {
         if (x == nil_) return;
         free_subtree(x->left);
         free_subtree(x->right);
         free_node(x);
     }
 
+    /** 递归析构子树中的元素，不归还内存（随后整块释放） */
+    void destroy_subtree(tree_node* x) {
+        if (x == nil_) return;
+        destroy_subtree(x->left);
+        destroy_subtree(x->right);
+        alloc_.destroy(x);
+    }
+
+    /**
+     * @brief 释放全部节点
+     *
+     * 没有未归还的节点句柄时整块释放节点池；
+     * 否则句柄里的节点仍在池中，只能逐个放回空闲列表。
+     */
+    void release_nodes() noexcept {
+        if (!pool_) return;
+        if (pool_->shared()) {
+            free_subtree(root_);
+            return;
+        }
+        if (!is_trivially_destructible_v<value_type>) destroy_subtree(root_);
+        pool_->release_all();
+    }
+
     /** 递归复制子树 */
-    node_type* copy_subtree(node_type* x, node_type* src_nil) {
+    tree_node* copy_subtree(tree_node* x, tree_node* src_nil) {
         if (x == src_nil) return nil_;
-        node_type* n = make_node(x->kv);
+        tree_node* n = make_node(x->kv);
         n->color = x->color;
         n->left  = copy_subtree(x->left,  src_nil);
         n->right = copy_subtree(x->right, src_nil);
@@ -337,8 +459,8 @@ private:
      *     / \      / \
      *    B   C    A   B
      */
-    void left_rotate(node_type* x) {
-        node_type* y = x->right;
+    void left_rotate(tree_node* x) {
+        tree_node* y = x->right;
         x->right = y->left;
         if (y->left != nil_) y->left->parent = x;
 
@@ -364,8 +486,8 @@ private:
      *   / \            / \
      *  A   B          B   C
      */
-    void right_rotate(node_type* y) {
-        node_type* x = y->left;
+    void right_rotate(tree_node* y) {
+        tree_node* x = y->left;
         y->left = x->right;
         if (x->right != nil_) x->right->parent = y;
 
@@ -392,11 +514,11 @@ private:
      * 违反情况：z 和 z 的父节点都是红色（性质4）
      * 分三种情况处理，通过重新着色和旋转修复。
      */
-    void insert_fixup(node_type* z) {
+    void insert_fixup(tree_node* z) {
         while (z->parent->color == rb_color::RED) {
             if (z->parent == z->parent->parent->left) {
                 // z 的父节点是祖父的左孩子
-                node_type* uncle = z->parent->parent->right;
+                tree_node* uncle = z->parent->parent->right;
                 if (uncle->color == rb_color::RED) {
                     // Case 1: 叔叔节点是红色 → 重新着色，问题上移
                     z->parent->color          = rb_color::BLACK;
@@ -416,7 +538,7 @@ private:
                 }
             } else {
                 // z 的父节点是祖父的右孩子（镜像情况）
-                node_type* uncle = z->parent->parent->left;
+                tree_node* uncle = z->parent->parent->left;
                 if (uncle->color == rb_color::RED) {
                     z->parent->color          = rb_color::BLACK;
                     uncle->color              = rb_color::BLACK;
@@ -443,7 +565,7 @@ private:
     /**
      * @brief 将 v 替换 u 在树中的位置（仅修改父指针，不改子树）
      */
-    void transplant(node_type* u, node_type* v) {
+    void transplant(tree_node* u, tree_node* v) {
         if (u->parent == nil_) {
             root_ = v;
         } else if (u == u->parent->left) {
@@ -457,7 +579,7 @@ private:
     /**
      * @brief 找到以 x 为根的子树中的最小节点
      */
-    node_type* tree_minimum(node_type* x) const noexcept {
+    tree_node* tree_minimum(tree_node* x) const noexcept {
         while (x->left != nil_) x = x->left;
         return x;
     }
@@ -467,10 +589,10 @@ private:
      *
      * 当删除的节点（或其后继）是黑色时，需要修复黑高不平衡。
      */
-    void erase_fixup(node_type* x) {
+    void erase_fixup(tree_node* x) {
         while (x != root_ && x->color == rb_color::BLACK) {
             if (x == x->parent->left) {
-                node_type* w = x->parent->right; // 兄弟节点
+                tree_node* w = x->parent->right; // 兄弟节点
                 if (w->color == rb_color::RED) {
                     // Case 1: 兄弟是红色 → 变换为兄弟是黑色的情况
                     w->color          = rb_color::BLACK;
@@ -500,7 +622,7 @@ private:
                 }
             } else {
                 // 镜像情况
-                node_type* w = x->parent->left;
+                tree_node* w = x->parent->left;
                 if (w->color == rb_color::RED) {
                     w->color          = rb_color::BLACK;
                     x->parent->color  = rb_color::RED;
@@ -533,8 +655,8 @@ private:
     // 查找内部实现
     // -------------------------------------------------------------------------
 
-    node_type* find_node(const Key& key) const noexcept {
-        node_type* cur = root_;
+    tree_node* find_node(const Key& key) const noexcept {
+        tree_node* cur = root_;
         while (cur != nil_) {
             if (comp_(key, cur->kv.first)) {
                 cur = cur->left;
@@ -547,6 +669,34 @@ private:
         return nil_; // 未找到
     }
 
+    tree_node* lower_bound_node(const Key& k) const noexcept {
+        tree_node* result = nil_;
+        tree_node* cur    = root_;
+        while (cur != nil_) {
+            if (!comp_(cur->kv.first, k)) {
+                result = cur;
+                cur = cur->left;
+            } else {
+                cur = cur->right;
+            }
+        }
+        return result;
+    }
+
+    tree_node* upper_bound_node(const Key& k) const noexcept {
+        tree_node* result = nil_;
+        tree_node* cur    = root_;
+        while (cur != nil_) {
+            if (comp_(k, cur->kv.first)) {
+                result = cur;
+                cur = cur->left;
+            } else {
+                cur = cur->right;
+            }
+        }
+        return result;
+    }
+
     // -------------------------------------------------------------------------
     // 初始化哨兵
     // -------------------------------------------------------------------------
@@ -566,19 +716,36 @@ public:
     // -------------------------------------------------------------------------
 
     /**
-     * @brief 默认构造函数
+     * @brief 默认构造函数（节点池延迟到首次插入时创建）
      */
-    map() : nil_(nullptr), root_(nullptr), size_(0), comp_(), alloc_() {
+    rb_tree() : nil_(nullptr), root_(nullptr), size_(0), comp_(), alloc_(), pool_(nullptr) {
         init_nil();
         root_ = nil_;
         nil_->parent = nil_; // root 的 parent 指向 nil
     }
 
+    /**
+     * @brief 指定分配器（例如 arena_allocator）构造
+     */
+    explicit rb_tree(const Alloc& alloc)
+        : nil_(nullptr), root_(nullptr), size_(0), comp_(), alloc_(alloc), pool_(nullptr) {
+        init_nil();
+        root_ = nil_;
+        nil_->parent = nil_;
+    }
+
+    explicit rb_tree(const Compare& comp, const Alloc& alloc = Alloc())
+        : nil_(nullptr), root_(nullptr), size_(0), comp_(comp), alloc_(alloc), pool_(nullptr) {
+        init_nil();
+        root_ = nil_;
+        nil_->parent = nil_;
+    }
+
     /**
      * @brief 拷贝构造函数
      */
-    map(const map& other) : nil_(nullptr), root_(nullptr), size_(0),
-                             comp_(other.comp_), alloc_(other.alloc_) {
+    rb_tree(const rb_tree& other) : nil_(nullptr), root_(nullptr), size_(0),
+                                    comp_(other.comp_), alloc_(other.alloc_), pool_(nullptr) {
         init_nil();
         root_  = copy_subtree(other.root_, other.nil_);
         size_  = other.size_;
@@ -589,13 +756,14 @@ public:
     }
 
     /**
-     * @brief 移动构造函数
+     * @brief 移动构造函数（节点池随树一起转移）
      */
-    map(map&& other) noexcept
+    rb_tree(rb_tree&& other) noexcept
         : nil_(other.nil_), root_(other.root_), size_(other.size_),
-          comp_(zen::move(other.comp_)), alloc_(zen::move(other.alloc_)) {
-        // 给 other 一个新的合法空状态
-        other.alloc_ = node_alloc{};
+          comp_(zen::move(other.comp_)), alloc_(zen::move(other.alloc_)),
+          pool_(other.pool_) {
+        // 给 other 一个新的合法空状态（沿用原分配器）
+        other.pool_  = nullptr;
         other.init_nil();
         other.root_ = other.nil_;
         other.size_ = 0;
@@ -604,8 +772,9 @@ public:
     /**
      * @brief 析构函数
      */
-    ~map() {
-        free_subtree(root_);
+    ~rb_tree() {
+        release_nodes();
+        pool_type::unref(pool_);
         alloc_.deallocate(nil_, 1); // 释放哨兵（不调用析构，因为 kv 没有构造）
     }
 
@@ -613,21 +782,18 @@ public:
     // 赋值运算符
     // -------------------------------------------------------------------------
 
-    map& operator=(const map& other) {
+    rb_tree& operator=(const rb_tree& other) {
         if (this != &other) {
-            map tmp(other);
-            zen::swap(nil_,   tmp.nil_);
-            zen::swap(root_,  tmp.root_);
-            zen::swap(size_,  tmp.size_);
-            zen::swap(comp_,  tmp.comp_);
-            zen::swap(alloc_, tmp.alloc_);
+            rb_tree tmp(other);
+            swap(tmp);
         }
         return *this;
     }
 
-    map& operator=(map&& other) noexcept {
+    rb_tree& operator=(rb_tree&& other) noexcept {
         if (this != &other) {
-            free_subtree(root_);
+            release_nodes();
+            pool_type::unref(pool_);
             alloc_.deallocate(nil_, 1);
 
             nil_   = other.nil_;
@@ -635,8 +801,9 @@ public:
             size_  = other.size_;
             comp_  = zen::move(other.comp_);
             alloc_ = zen::move(other.alloc_);
+            pool_  = other.pool_;
 
-            other.alloc_ = node_alloc{};
+            other.pool_  = nullptr;
             other.init_nil();
             other.root_ = other.nil_;
             other.size_ = 0;
@@ -644,6 +811,15 @@ public:
         return *this;
     }
 
+    void swap(rb_tree& other) noexcept {
+        zen::swap(nil_,   other.nil_);
+        zen::swap(root_,  other.root_);
+        zen::swap(size_,  other.size_);
+        zen::swap(comp_,  other.comp_);
+        zen::swap(alloc_, other.alloc_);
+        zen::swap(pool_,  other.pool_);
+    }
+
     // -------------------------------------------------------------------------
     // 容量
     // -------------------------------------------------------------------------
@@ -683,14 +859,16 @@ public:
 
     /**
      * @brief 查找键，返回对应迭代器，若不存在返回 end()
+     *
+     * 允许重复键时返回任意一个等价元素。
      */
     iterator find(const Key& key) noexcept {
-        node_type* n = find_node(key);
+        tree_node* n = find_node(key);
         return iterator(n, nil_);
     }
 
     const_iterator find(const Key& key) const noexcept {
-        node_type* n = find_node(key);
+        tree_node* n = find_node(key);
         return const_iterator(n, nil_);
     }
 
@@ -702,100 +880,67 @@ public:
     }
 
     size_type count(const Key& key) const noexcept {
-        return contains(key) ? 1u : 0u;
+        if (!Multi) return contains(key) ? 1u : 0u;
+        size_type n = 0;
+        const_iterator last(upper_bound_node(key), nil_);
+        for (const_iterator it(lower_bound_node(key), nil_); it != last; ++it) ++n;
+        return n;
     }
 
     // -------------------------------------------------------------------------
-    // 下标访问
+    // 范围查找
     // -------------------------------------------------------------------------
 
     /**
-     * @brief operator[]：若键不存在则默认插入
+     * @brief 返回第一个 key >= k 的迭代器（lower_bound）
      */
-    Value& operator[](const Key& key) {
-        node_type* n = find_node(key);
-        if (n == nil_) {
-            auto res = insert(value_type(key, Value{}));
-            return res.first->second;
-        }
-        return n->kv.second;
-    }
+    iterator       lower_bound(const Key& k)       noexcept { return iterator(lower_bound_node(k), nil_); }
+    const_iterator lower_bound(const Key& k) const noexcept { return const_iterator(lower_bound_node(k), nil_); }
 
-    Value& operator[](Key&& key) {
-        node_type* n = find_node(key);
-        if (n == nil_) {
-            auto res = insert(value_type(zen::move(key), Value{}));
-            return res.first->second;
-        }
-        return n->kv.second;
-    }
+    /**
+     * @brief 返回第一个 key > k 的迭代器（upper_bound）
+     */
+    iterator       upper_bound(const Key& k)       noexcept { return iterator(upper_bound_node(k), nil_); }
+    const_iterator upper_bound(const Key& k) const noexcept { return const_iterator(upper_bound_node(k), nil_); }
 
     /**
-     * @brief at()：若键不存在，行为未定义（与 std::map 不同，不抛异常）
+     * @brief 返回 [lower_bound(k), upper_bound(k))
      */
-    Value& at(const Key& key) noexcept {
-        return find_node(key)->kv.second;
+    pair<iterator, iterator> equal_range(const Key& k) noexcept {
+        return {lower_bound(k), upper_bound(k)};
     }
-
-    const Value& at(const Key& key) const noexcept {
-        return find_node(key)->kv.second;
+    pair<const_iterator, const_iterator> equal_range(const Key& k) const noexcept {
+        return {lower_bound(k), upper_bound(k)};
     }
 
+protected:
     // -------------------------------------------------------------------------
     // 插入
     // -------------------------------------------------------------------------
 
     /**
-     * @brief 插入键值对
-     * @return {迭代器, 是否插入成功}（若已存在则返回已有元素的迭代器 + false）
-     */
-    pair<iterator, bool> insert(const value_type& kv) {
-        return insert_impl(kv.first, kv.second);
-    }
-
-    pair<iterator, bool> insert(value_type&& kv) {
-        return insert_impl(zen::move(const_cast<Key&>(kv.first)),
-                           zen::move(kv.second));
-    }
-
-    /**
-     * @brief 就地构造并插入（emplace）
-     */
-    template<typename... Args>
-    pair<iterator, bool> emplace(Args&&... args) {
-        // 构造临时节点来获取 key
-        node_type* z = make_node(static_cast<Args&&>(args)...);
-        return insert_node(z);
-    }
-
-private:
-    template<typename K, typename V>
-    pair<iterator, bool> insert_impl(K&& key, V&& val) {
-        node_type* z = make_node(zen::forward<K>(key), zen::forward<V>(val));
-        return insert_node(z);
-    }
-
-    /**
-     * @brief 将已构造好的节点 z 插入红黑树
+     * @brief 把已构造好的节点 z 挂入红黑树
+     * @return 唯一键模式下若键已存在，返回已有节点（z 未挂入）；否则返回 nullptr
      */
-    pair<iterator, bool> insert_node(node_type* z) {
-        node_type* y = nil_;
-        node_type* x = root_;
+    tree_node* link_node(tree_node* z) {
+        tree_node* y = nil_;
+        tree_node* x = root_;
 
-        // 标准 BST 插入：找到插入位置
+        // 标准 BST 插入：找到插入位置（重复键放在等价元素的右侧，保持插入顺序）
         while (x != nil_) {
             y = x;
             if (comp_(z->kv.first, x->kv.first)) {
                 x = x->left;
-            } else if (comp_(x->kv.first, z->kv.first)) {
+            } else if (Multi || comp_(x->kv.first, z->kv.first)) {
                 x = x->right;
             } else {
-                // 键已存在：释放新节点，返回已有迭代器
-                free_node(z);
-                return {iterator(x, nil_), false};
+                return x;
             }
         }
 
+        z->left   = nil_;
+        z->right  = nil_;
+        z->color  = rb_color::RED;
         z->parent = y;
         if (y == nil_) {
             root_ = z; // 树为空
@@ -808,52 +953,28 @@ private:
         ++size_;
         insert_fixup(z);
         nil_->parent = root_; // 更新 end() 的 -- 支持
-        return {iterator(z, nil_), true};
-    }
-
-public:
-    // -------------------------------------------------------------------------
-    // 删除
-    // -------------------------------------------------------------------------
-
-    /**
-     * @brief 删除指定迭代器指向的元素
-     * @param pos 指向要删除元素的迭代器（必须有效且非 end()）
-     */
-    iterator erase(iterator pos) {
-        iterator next = pos;
-        ++next;
-        erase_node(pos.node_);
-        return next;
-    }
-
-    /**
-     * @brief 按键删除，返回删除的元素个数（0 或 1）
-     */
-    size_type erase(const Key& key) {
-        node_type* n = find_node(key);
-        if (n == nil_) return 0;
-        erase_node(n);
-        return 1;
+        return nullptr;
     }
 
     /**
-     * @brief 清除所有元素
+     * @brief 将已构造好的节点 z 插入红黑树，键已存在时释放 z
      */
-    void clear() noexcept {
-        free_subtree(root_);
-        root_ = nil_;
-        nil_->parent = nil_;
-        size_ = 0;
+    pair<iterator, bool> insert_node(tree_node* z) {
+        tree_node* dup = link_node(z);
+        if (dup) {
+            // 键已存在：释放新节点，返回已有迭代器
+            free_node(z);
+            return {iterator(dup, nil_), false};
+        }
+        return {iterator(z, nil_), true};
     }
 
-private:
     /**
-     * @brief 从树中删除节点 z（标准红黑树删除算法）
+     * @brief 从树中摘下节点 z（标准红黑树删除算法），不释放内存
      */
-    void erase_node(node_type* z) {
-        node_type* y = z;   // y 是实际被删除（或移走）的节点
-        node_type* x;       // x 是替代 y 位置的节点
+    void unlink_node(tree_node* z) {
+        tree_node* y = z;   // y 是实际被删除（或移走）的节点
+        tree_node* x;       // x 是替代 y 位置的节点
         rb_color   y_original_color = y->color;
 
         if (z->left == nil_) {
@@ -883,7 +1004,6 @@ private:
             y->color = z->color;
         }
 
-        free_node(z);
         --size_;
 
         if (y_original_color == rb_color::BLACK) {
@@ -893,57 +1013,95 @@ private:
         nil_->parent = root_; // 保持 end()--.
     }
 
+    /**
+     * @brief 插入节点句柄
+     *
+     * 节点直接挂链，元素不移动。键已存在时句柄原样退回；
+     * 节点来自其他节点池时，本池接收（adopt）该池，之后按本池节点释放。
+     */
+    insert_return_type insert_handle(node_type&& nh) {
+        if (nh.empty()) return {end(), false, node_type()};
+        tree_node* z = nh.node_;
+        if (!pool_) pool_ = pool_type::create(alloc_);
+        tree_node* dup = link_node(z);
+        if (dup) return {iterator(dup, nil_), false, zen::move(nh)};
+        if (nh.pool_ != pool_) {
+            try {
+                pool_->adopt(nh.pool_);
+            } catch (...) {
+                unlink_node(z);
+                throw;
+            }
+        }
+        nh.release();
+        return {iterator(z, nil_), true, node_type()};
+    }
+
 public:
     // -------------------------------------------------------------------------
-    // 范围查找
+    // 删除
     // -------------------------------------------------------------------------
 
     /**
-     * @brief 返回第一个 key >= k 的迭代器（lower_bound）
+     * @brief 删除指定迭代器指向的元素
+     * @param pos 指向要删除元素的迭代器（必须有效且非 end()）
      */
-    iterator lower_bound(const Key& k) noexcept {
-        node_type* result = nil_;
-        node_type* cur    = root_;
-        while (cur != nil_) {
-            if (!comp_(cur->kv.first, k)) {
-                result = cur;
-                cur = cur->left;
-            } else {
-                cur = cur->right;
-            }
-        }
-        return iterator(result, nil_);
+    iterator erase(iterator pos) {
+        iterator next = pos;
+        ++next;
+        unlink_node(pos.node_);
+        free_node(pos.node_);
+        return next;
     }
 
-    const_iterator lower_bound(const Key& k) const noexcept {
-        const node_type* result = nil_;
-        const node_type* cur    = root_;
-        while (cur != nil_) {
-            if (!comp_(cur->kv.first, k)) {
-                result = cur;
-                cur = cur->left;
-            } else {
-                cur = cur->right;
-            }
+    /**
+     * @brief 按键删除，返回删除的元素个数
+     */
+    size_type erase(const Key& key) {
+        if (!Multi) {
+            tree_node* n = find_node(key);
+            if (n == nil_) return 0;
+            unlink_node(n);
+            free_node(n);
+            return 1;
         }
-        return const_iterator(result, nil_);
+        size_type cnt = 0;
+        iterator last = upper_bound(key);
+        for (iterator it = lower_bound(key); it != last; ++cnt) it = erase(it);
+        return cnt;
     }
 
     /**
-     * @brief 返回第一个 key > k 的迭代器（upper_bound）
+     * @brief 清除所有元素，节点池整块归还
      */
-    iterator upper_bound(const Key& k) noexcept {
-        node_type* result = nil_;
-        node_type* cur    = root_;
-        while (cur != nil_) {
-            if (comp_(k, cur->kv.first)) {
-                result = cur;
-                cur = cur->left;
-            } else {
-                cur = cur->right;
-            }
-        }
-        return iterator(result, nil_);
+    void clear() noexcept {
+        release_nodes();
+        root_ = nil_;
+        nil_->parent = nil_;
+        size_ = 0;
+    }
+
+    // -------------------------------------------------------------------------
+    // 节点句柄
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief 摘下 pos 指向的节点，元素本身不移动、不复制
+     */
+    node_type extract(const_iterator pos) {
+        tree_node* n = const_cast<tree_node*>(pos.node_);
+        unlink_node(n);
+        return node_type(n, pool_);
+    }
+
+    /**
+     * @brief 按键摘下节点，键不存在时返回空句柄
+     */
+    node_type extract(const Key& key) {
+        tree_node* n = find_node(key);
+        if (n == nil_) return node_type();
+        unlink_node(n);
+        return node_type(n, pool_);
     }
 
     /**
@@ -953,30 +1111,184 @@ public:
 };
 
 // ============================================================================
-// set（基于红黑树，仅存储 key）
+// map 容器（基于红黑树）
 // ============================================================================
 
 /**
- * @brief 有序集合，基于红黑树实现（map 的键值相同特化）
+ * @brief 有序关联容器，键唯一
  *
- * 用 map<Key, unit_t> 实现，其中 unit_t 是空结构体。
+ * @tparam Key     键类型
+ * @tparam Value   值类型
+ * @tparam Compare 比较器，默认为 less<Key>
+ * @tparam Alloc   分配器，默认为 allocator<pair<const Key, Value>>
+ *
+ * 示例：
+ * @code
+ * zen::map<int, std::string> a, b;
+ * a[1] = "one";
+ * auto nh = a.extract(1);      // 摘下节点，不复制元素
+ * nh.key() = 2;                // 句柄中可以改键
+ * b.insert(zen::move(nh));     // 挂入 b
+ * @endcode
  */
-struct unit_t {};
+template<typename Key,
+         typename Value,
+         typename Compare = less<Key>,
+         typename Alloc = allocator<pair<const Key, Value>>>
+class map : public rb_tree<Key, Value, Compare, Alloc, false> {
+    using base = rb_tree<Key, Value, Compare, Alloc, false>;
+    using typename base::tree_node;
+
+public:
+    using typename base::value_type;
+    using typename base::iterator;
+    using typename base::node_type;
+    using typename base::insert_return_type;
+
+    using base::base;
+
+    // -------------------------------------------------------------------------
+    // 下标访问
+    // -------------------------------------------------------------------------
 
-template<typename Key, typename Compare = less<Key>>
+    /**
+     * @brief operator[]：若键不存在则默认插入
+     */
+    Value& operator[](const Key& key) {
+        tree_node* n = this->find_node(key);
+        if (n == this->nil_) {
+            auto res = insert(value_type(key, Value{}));
+            return res.first->second;
+        }
+        return n->kv.second;
+    }
+
+    Value& operator[](Key&& key) {
+        tree_node* n = this->find_node(key);
+        if (n == this->nil_) {
+            auto res = insert(value_type(zen::move(key), Value{}));
+            return res.first->second;
+        }
+        return n->kv.second;
+    }
+
+    /**
+     * @brief at()：若键不存在，行为未定义（与 std::map 不同，不抛异常）
+     */
+    Value& at(const Key& key) noexcept {
+        return this->find_node(key)->kv.second;
+    }
+
+    const Value& at(const Key& key) const noexcept {
+        return this->find_node(key)->kv.second;
+    }
+
+    // -------------------------------------------------------------------------
+    // 插入
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief 插入键值对
+     * @return {迭代器, 是否插入成功}（若已存在则返回已有元素的迭代器 + false）
+     */
+    pair<iterator, bool> insert(const value_type& kv) {
+        return this->insert_node(this->make_node(kv.first, kv.second));
+    }
+
+    pair<iterator, bool> insert(value_type&& kv) {
+        return this->insert_node(this->make_node(zen::move(const_cast<Key&>(kv.first)),
+                                           zen::move(kv.second)));
+    }
+
+    /**
+     * @brief 插入节点句柄；键已存在时句柄原样退回到返回值的 node 中
+     */
+    insert_return_type insert(node_type&& nh) {
+        return this->insert_handle(zen::move(nh));
+    }
+
+    /**
+     * @brief 就地构造并插入（emplace）
+     */
+    template<typename... Args>
+    pair<iterator, bool> emplace(Args&&... args) {
+        // 构造临时节点来获取 key
+        return this->insert_node(this->make_node(static_cast<Args&&>(args)...));
+    }
+
+};
+
+// ============================================================================
+// multimap（基于红黑树，允许重复键）
+// ============================================================================
+
+/**
+ * @brief 有序关联容器，允许重复键；等价键按插入顺序排列
+ */
+template<typename Key,
+         typename Value,
+         typename Compare = less<Key>,
+         typename Alloc = allocator<pair<const Key, Value>>>
+class multimap : public rb_tree<Key, Value, Compare, Alloc, true> {
+    using base = rb_tree<Key, Value, Compare, Alloc, true>;
+
+public:
+    using typename base::value_type;
+    using typename base::iterator;
+    using typename base::node_type;
+
+    using base::base;
+
+    iterator insert(const value_type& kv) {
+        return this->insert_node(this->make_node(kv.first, kv.second)).first;
+    }
+
+    iterator insert(value_type&& kv) {
+        return this->insert_node(this->make_node(zen::move(const_cast<Key&>(kv.first)),
+                                                 zen::move(kv.second))).first;
+    }
+
+    /**
+     * @brief 插入节点句柄（重复键总能插入成功）
+     */
+    iterator insert(node_type&& nh) {
+        return this->insert_handle(zen::move(nh)).position;
+    }
+
+    template<typename... Args>
+    iterator emplace(Args&&... args) {
+        return this->insert_node(this->make_node(static_cast<Args&&>(args)...)).first;
+    }
+};
+
+// ============================================================================
+// set / multiset（基于红黑树，仅存储 key）
+// ============================================================================
+
+/**
+ * @brief 有序集合，基于红黑树实现（map 的键值相同特化）
+ *
+ * 用 map<Key, unit_t> 实现，其中 unit_t 是空结构体（定义见 utility/pair.h）。
+ */
+template<typename Key, typename Compare = less<Key>, typename Alloc = allocator<Key>>
 class set {
+    using tree_alloc = typename Alloc::template rebind<pair<const Key, unit_t>>::other;
+
 public:
     using key_type       = Key;
     using value_type     = Key;
     using size_type      = size_t;
     using iterator       = rb_iterator<Key, unit_t>;
     using const_iterator = rb_const_iterator<Key, unit_t>;
+    using node_type      = typename map<Key, unit_t, Compare, tree_alloc>::node_type;
+    using insert_return_type = typename map<Key, unit_t, Compare, tree_alloc>::insert_return_type;
 
 private:
-    map<Key, unit_t, Compare> tree_;
+    map<Key, unit_t, Compare, tree_alloc> tree_;
 
 public:
     set() = default;
+    explicit set(const Alloc& alloc) : tree_(tree_alloc(alloc)) {}
 
     bool      empty() const noexcept { return tree_.empty(); }
     size_type size()  const noexcept { return tree_.size(); }
@@ -998,6 +1310,12 @@ public:
     iterator  erase(iterator pos)   { return tree_.erase(pos); }
     void      clear() noexcept      { tree_.clear(); }
 
+    node_type extract(const Key& key)         { return tree_.extract(key); }
+    node_type extract(const_iterator pos)     { return tree_.extract(pos); }
+
+    /** 键已存在时 inserted 为 false，节点经 node 原样退回 */
+    insert_return_type insert(node_type&& nh) { return tree_.insert(zen::move(nh)); }
+
     bool      contains(const Key& k) const noexcept { return tree_.contains(k); }
     size_type count(const Key& k)    const noexcept { return tree_.count(k); }
 
@@ -1007,6 +1325,62 @@ public:
     iterator       lower_bound(const Key& k)       noexcept { return tree_.lower_bound(k); }
     const_iterator lower_bound(const Key& k) const noexcept { return tree_.lower_bound(k); }
     iterator       upper_bound(const Key& k)       noexcept { return tree_.upper_bound(k); }
+    const_iterator upper_bound(const Key& k) const noexcept { return tree_.upper_bound(k); }
+};
+
+/**
+ * @brief 允许重复元素的有序集合（multimap<Key, unit_t>）
+ */
+template<typename Key, typename Compare = less<Key>, typename Alloc = allocator<Key>>
+class multiset {
+    using tree_alloc = typename Alloc::template rebind<pair<const Key, unit_t>>::other;
+
+public:
+    using key_type       = Key;
+    using value_type     = Key;
+    using size_type      = size_t;
+    using iterator       = rb_iterator<Key, unit_t>;
+    using const_iterator = rb_const_iterator<Key, unit_t>;
+    using node_type      = typename multimap<Key, unit_t, Compare, tree_alloc>::node_type;
+
+private:
+    multimap<Key, unit_t, Compare, tree_alloc> tree_;
+
+public:
+    multiset() = default;
+    explicit multiset(const Alloc& alloc) : tree_(tree_alloc(alloc)) {}
+
+    bool      empty() const noexcept { return tree_.empty(); }
+    size_type size()  const noexcept { return tree_.size(); }
+
+    iterator       begin()  noexcept { return tree_.begin(); }
+    const_iterator begin()  const noexcept { return tree_.begin(); }
+    iterator       end()    noexcept { return tree_.end(); }
+    const_iterator end()    const noexcept { return tree_.end(); }
+
+    iterator insert(const Key& key) { return tree_.insert({key, unit_t{}}); }
+    iterator insert(Key&& key)      { return tree_.insert({zen::move(key), unit_t{}}); }
+
+    size_type erase(const Key& key) { return tree_.erase(key); }
+    iterator  erase(iterator pos)   { return tree_.erase(pos); }
+    void      clear() noexcept      { tree_.clear(); }
+
+    node_type extract(const Key& key)     { return tree_.extract(key); }
+    node_type extract(const_iterator pos) { return tree_.extract(pos); }
+    iterator  insert(node_type&& nh)      { return tree_.insert(zen::move(nh)); }
+
+    bool      contains(const Key& k) const noexcept { return tree_.contains(k); }
+    size_type count(const Key& k)    const noexcept { return tree_.count(k); }
+
+    iterator       find(const Key& k)       noexcept { return tree_.find(k); }
+    const_iterator find(const Key& k) const noexcept { return tree_.find(k); }
+
+    iterator       lower_bound(const Key& k)       noexcept { return tree_.lower_bound(k); }
+    const_iterator lower_bound(const Key& k) const noexcept { return tree_.lower_bound(k); }
+    iterator       upper_bound(const Key& k)       noexcept { return tree_.upper_bound(k); }
+    const_iterator upper_bound(const Key& k) const noexcept { return tree_.upper_bound(k); }
+
+    pair<iterator, iterator> equal_range(const Key& k) noexcept { return tree_.equal_range(k); }
 };
 
 } // namespace zen
@@ -2,67 +2,14 @@
 #define ZEN_CONTAINERS_ASSOCIATIVE_UNORDERED_MAP_H
 
 #include "../../base/type_traits.h"
-#include <cstdint>  // uintptr_t
 #include "../../utility/swap.h"
 #include "../../utility/pair.h"
+#include "../../utility/hash.h"  // hash / equal_to
 #include "../../memory/allocator.h"
 #include "../../iterators/iterator_base.h"
 
 namespace zen {
 
-// ============================================================================
-// 哈希函数（FNV-1a，不依赖 std::hash）
-// ============================================================================
-
-template<typename Key>
-struct hash;
-
-template<typename T>
-struct integral_hash {
-    size_t operator()(T v) const noexcept {
-        const unsigned char* p = reinterpret_cast<const unsigned char*>(&v);
-        size_t h = static_cast<size_t>(14695981039346656037ULL);
-        for (size_t i = 0; i < sizeof(T); ++i) {
-            h ^= static_cast<size_t>(p[i]);
-            h *= static_cast<size_t>(1099511628211ULL);
-        }
-        return h;
-    }
-};
-
-template<> struct hash<bool>               : integral_hash<bool>               {};
-template<> struct hash<char>               : integral_hash<char>               {};
-template<> struct hash<signed char>        : integral_hash<signed char>        {};
-template<> struct hash<unsigned char>      : integral_hash<unsigned char>      {};
-template<> struct hash<short>              : integral_hash<short>              {};
-template<> struct hash<unsigned short>     : integral_hash<unsigned short>     {};
-template<> struct hash<int>                : integral_hash<int>                {};
-template<> struct hash<unsigned int>       : integral_hash<unsigned int>       {};
-template<> struct hash<long>               : integral_hash<long>               {};
-template<> struct hash<unsigned long>      : integral_hash<unsigned long>      {};
-template<> struct hash<long long>          : integral_hash<long long>          {};
-template<> struct hash<unsigned long long> : integral_hash<unsigned long long> {};
-template<> struct hash<float>              : integral_hash<float>              {};
-template<> struct hash<double>             : integral_hash<double>             {};
-
-template<typename T>
-struct hash<T*> {
-    size_t operator()(T* p) const noexcept {
-        return integral_hash<uintptr_t>{}(reinterpret_cast<uintptr_t>(p));
-    }
-};
-
-// ============================================================================
-// 键相等比较器
-// ============================================================================
-
-template<typename T>
-struct equal_to {
-    constexpr bool operator()(const T& a, const T& b) const noexcept {
-        return a == b;
-    }
-};
-
 // ============================================================================
 // 哈希桶节点
 // ============================================================================
@@ -246,7 +193,8 @@ private:
         }
     }
 
-    node_type* find_node(const Key& key) const noexcept {
+    template<typename K>
+    node_type* find_node(const K& key) const noexcept {
         size_t hv = hasher_(key);
         size_t bi = bucket_index(hv);
         node_type* cur = buckets_[bi];
@@ -269,6 +217,15 @@ public:
         buckets_ = alloc_buckets(bucket_count_);
     }
 
+    /**
+     * @brief 指定分配器（例如 arena_allocator）构造，节点与桶数组都从它分配
+     */
+    explicit unordered_map(const Alloc& alloc)
+        : buckets_(nullptr), bucket_count_(INITIAL_BUCKETS), size_(0),
+          hasher_(), key_eq_(), node_alloc_(alloc), ptr_alloc_(alloc) {
+        buckets_ = alloc_buckets(bucket_count_);
+    }
+
     unordered_map(const unordered_map& o)
         : buckets_(nullptr), bucket_count_(o.bucket_count_), size_(0),
           hasher_(o.hasher_), key_eq_(o.key_eq_),
@@ -357,6 +314,26 @@ public:
     bool contains(const Key& k) const noexcept { return find_node(k) != nullptr; }
     size_type count(const Key& k) const noexcept { return find_node(k) ? 1u : 0u; }
 
+    // 异构查找：Hash 与 KeyEqual 均为透明比较器时，可用 string_view 等直接查找，不构造 Key
+    template<typename K, typename H = Hash, typename E = KeyEqual,
+             typename = enable_if_t<is_transparent_lookup_v<H, E>>>
+    iterator find(const K& k) noexcept {
+        node_type* n = find_node(k);
+        return iterator(buckets_, bucket_count_, n ? bucket_index(n->hash_val) : bucket_count_, n);
+    }
+    template<typename K, typename H = Hash, typename E = KeyEqual,
+             typename = enable_if_t<is_transparent_lookup_v<H, E>>>
+    const_iterator find(const K& k) const noexcept {
+        node_type* n = find_node(k);
+        return const_iterator(buckets_, bucket_count_, n ? bucket_index(n->hash_val) : bucket_count_, n);
+    }
+    template<typename K, typename H = Hash, typename E = KeyEqual,
+             typename = enable_if_t<is_transparent_lookup_v<H, E>>>
+    bool contains(const K& k) const noexcept { return find_node(k) != nullptr; }
+    template<typename K, typename H = Hash, typename E = KeyEqual,
+             typename = enable_if_t<is_transparent_lookup_v<H, E>>>
+    size_type count(const K& k) const noexcept { return find_node(k) ? 1u : 0u; }
+
     Value& operator[](const Key& k) {
         node_type* n = find_node(k);
         if (!n) {
@@ -1,557 +1,815 @@
-/**
- * @file deque.h
- * @brief 双端队列容器
- * @details 支持头部和尾部的高效插入和删除操作
- *          基于循环缓冲区实现
- */
-
-#ifndef ZEN_CONTAINERS_DEQUE_H
-#define ZEN_CONTAINERS_DEQUE_H
+#ifndef ZEN_CONTAINERS_SEQUENTIAL_DEQUE_H
+#define ZEN_CONTAINERS_SEQUENTIAL_DEQUE_H
 
-#include <initializer_list>
-#include <stdexcept>
-#include <algorithm>
-#include "../memory/allocator.h"
-#include "../iterators/iterator.h"
+#include "../../base/type_traits.h"
+#include "../../memory/allocator.h"
+#include "../../iterators/iterator_base.h"
+#include "../../utility/swap.h"
+#include <cstring>      // memmove
 
 namespace zen {
 
+namespace detail {
+
 // ============================================================================
-// 双端队列迭代器
+// 块大小：约 4 KiB，元素个数取 2 的幂（至少 16 个）
+// 下标 → (块, 块内偏移) 只需移位和按位与
 // ============================================================================
 
-template <typename T>
-class DequeIterator {
-public:
-    using iterator_category = std::random_access_iterator_tag;
-    using value_type = T;
-    using difference_type = ptrdiff_t;
-    using pointer = T*;
-    using reference = T&;
-
-    DequeIterator() : data_(nullptr), index_(0), capacity_(0) {}
-    DequeIterator(pointer data, size_t index, size_t capacity)
-        : data_(data), index_(index), capacity_(capacity) {}
+constexpr size_t DEQUE_BLOCK_BYTES = 4096;
 
-    reference operator*() const { return data_[index_]; }
-    pointer operator->() const { return &data_[index_]; }
-
-    DequeIterator& operator++() {
-        index_ = (index_ + 1) % capacity_;
-        return *this;
+template<typename T>
+struct deque_block {
+    static constexpr size_t floor_pow2(size_t n) noexcept {
+        size_t p = 1;
+        while (p * 2 <= n) p *= 2;
+        return p;
     }
 
-    DequeIterator operator++(int) {
-        DequeIterator tmp = *this;
-        ++(*this);
-        return tmp;
+    static constexpr size_t log2(size_t n) noexcept {
+        size_t r = 0;
+        while (n > 1) { n >>= 1; ++r; }
+        return r;
     }
 
-    DequeIterator& operator--() {
-        index_ = (index_ + capacity_ - 1) % capacity_;
-        return *this;
-    }
+    static constexpr size_t size  = floor_pow2(DEQUE_BLOCK_BYTES / sizeof(T) > 16 ? DEQUE_BLOCK_BYTES / sizeof(T) : 16);
+    static constexpr size_t shift = log2(size);
+    static constexpr size_t mask  = size - 1;
+};
+
+} // namespace detail
+
+// ============================================================================
+// deque_iterator - 分段迭代器
+// ============================================================================
+
+/**
+ * @brief deque 的随机访问迭代器
+ * @tparam T 元素类型（const 迭代器为 const U）
+ *
+ * 记录当前元素、所在块的起点和块在中控数组（map）里的位置；
+ * ++ / -- 只在跨块时查一次 map，+= n 用移位算出目标块，不做取模。
+ */
+template<typename T>
+struct deque_iterator {
+    using value_type        = remove_cv_t<T>;
+    using reference         = T&;
+    using pointer           = T*;
+    using difference_type   = decltype((char*)0 - (char*)0);
+    using iterator_category = random_access_iterator_tag;
+
+    using block   = detail::deque_block<value_type>;
+    using map_ptr = value_type**;
+
+    T*      cur_;     // 当前元素
+    T*      first_;   // 当前块起点
+    map_ptr node_;    // 当前块在 map 中的位置
+
+    static constexpr difference_type B = static_cast<difference_type>(block::size);
+
+    deque_iterator() noexcept : cur_(nullptr), first_(nullptr), node_(nullptr) {}
+    deque_iterator(T* cur, map_ptr node) noexcept : cur_(cur), first_(*node), node_(node) {}
 
-    DequeIterator operator--(int) {
-        DequeIterator tmp = *this;
-        --(*this);
-        return tmp;
+    // 从非 const 迭代器构造
+    template<typename U, typename = enable_if_t<is_same_v<const U, T> && !is_same_v<U, T>>>
+    deque_iterator(const deque_iterator<U>& it) noexcept
+        : cur_(it.cur_), first_(it.first_), node_(it.node_) {}
+
+    void set_node(map_ptr n) noexcept {
+        node_  = n;
+        first_ = *n;
     }
 
-    DequeIterator& operator+=(difference_type n) {
-        index_ = (index_ + n + capacity_) % capacity_;
+    reference operator*()  const noexcept { return *cur_; }
+    pointer   operator->() const noexcept { return cur_; }
+
+    deque_iterator& operator++() noexcept {
+        if (++cur_ == first_ + B) {
+            set_node(node_ + 1);
+            cur_ = first_;
+        }
         return *this;
     }
 
-    DequeIterator operator+(difference_type n) const {
-        DequeIterator tmp = *this;
-        tmp += n;
-        return tmp;
-    }
+    deque_iterator operator++(int) noexcept { deque_iterator t = *this; ++(*this); return t; }
 
-    DequeIterator& operator-=(difference_type n) {
-        index_ = (index_ - n + capacity_) % capacity_;
+    deque_iterator& operator--() noexcept {
+        if (cur_ == first_) {
+            set_node(node_ - 1);
+            cur_ = first_ + B;
+        }
+        --cur_;
         return *this;
     }
 
-    DequeIterator operator-(difference_type n) const {
-        DequeIterator tmp = *this;
-        tmp -= n;
-        return tmp;
-    }
+    deque_iterator operator--(int) noexcept { deque_iterator t = *this; --(*this); return t; }
 
-    reference operator[](difference_type n) const {
-        return data_[(index_ + n + capacity_) % capacity_];
+    deque_iterator& operator+=(difference_type n) noexcept {
+        difference_type off = n + (cur_ - first_);
+        if (off >= 0 && off < B) {
+            cur_ += n;
+        } else {
+            // 向下取整的块偏移（off 为负时同样正确）
+            difference_type node_off = off > 0
+                ? off >> block::shift
+                : -((-off - 1) >> block::shift) - 1;
+            set_node(node_ + node_off);
+            cur_ = first_ + (off - node_off * B);
+        }
+        return *this;
     }
 
-    friend difference_type operator-(const DequeIterator& a, const DequeIterator& b) {
-        return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
-    }
+    deque_iterator& operator-=(difference_type n) noexcept { return *this += -n; }
 
-    friend bool operator==(const DequeIterator& a, const DequeIterator& b) {
-        return a.index_ == b.index_;
-    }
+    deque_iterator operator+(difference_type n) const noexcept { deque_iterator t = *this; return t += n; }
+    deque_iterator operator-(difference_type n) const noexcept { deque_iterator t = *this; return t -= n; }
 
-    friend bool operator!=(const DequeIterator& a, const DequeIterator& b) {
-        return a.index_ != b.index_;
-    }
+    friend deque_iterator operator+(difference_type n, const deque_iterator& it) noexcept { return it + n; }
 
-    friend bool operator<(const DequeIterator& a, const DequeIterator& b) {
-        return a.index_ < b.index_;
-    }
+    reference operator[](difference_type n) const noexcept { return *(*this + n); }
 
-    friend bool operator>(const DequeIterator& a, const DequeIterator& b) {
-        return a.index_ > b.index_;
+    friend difference_type operator-(const deque_iterator& a, const deque_iterator& b) noexcept {
+        return (a.node_ - b.node_) * B + (a.cur_ - a.first_) - (b.cur_ - b.first_);
     }
 
-    friend bool operator<=(const DequeIterator& a, const DequeIterator& b) {
-        return a.index_ <= b.index_;
-    }
+    bool operator==(const deque_iterator& o) const noexcept { return cur_ == o.cur_; }
+    bool operator!=(const deque_iterator& o) const noexcept { return cur_ != o.cur_; }
 
-    friend bool operator>=(const DequeIterator& a, const DequeIterator& b) {
-        return a.index_ >= b.index_;
+    bool operator<(const deque_iterator& o) const noexcept {
+        return node_ == o.node_ ? cur_ < o.cur_ : node_ < o.node_;
     }
-
-private:
-    pointer data_;
-    size_t index_;
-    size_t capacity_;
+    bool operator>(const deque_iterator& o)  const noexcept { return o < *this; }
+    bool operator<=(const deque_iterator& o) const noexcept { return !(o < *this); }
+    bool operator>=(const deque_iterator& o) const noexcept { return !(*this < o); }
 };
 
 // ============================================================================
-// 双端队列
+// deque - 分段双端队列
 // ============================================================================
 
 /**
- * @brief 双端队列容器
- * @tparam T 元素类型
+ * @brief 由定长块组成的双端队列
+ * @tparam T     元素类型
+ * @tparam Alloc 分配器（分配元素块；rebind 到 T* 分配中控数组）
+ *
+ * 结构：
+ *
+ *   map_ ─> [ · | · | b0 | b1 | b2 | · ]        中控数组：块指针，居中放置
+ *                     │    │    │
+ *                     ▼    ▼    ▼
+ *                   [....xx][xxxxxx][xxx...]    每块 block::size 个元素
+ *                        ^start_       ^finish_
+ *
+ * - push_front / push_back 只在两端的块满时分配一个新块，已有元素从不移动，
+ *   元素地址在两端插入 / 删除（被删元素除外）后保持不变
+ * - 中控数组满时只搬移块指针（或在原数组内居中），均摊 O(1)
+ * - 下标访问：块号 = 偏移 >> shift，块内 = 偏移 & mask
+ * - 保留一个空闲块：队列式使用（尾进头出）时不会反复申请 / 释放块
+ * - 中间 insert / erase 移动较短的一侧，O(min(i, n - i))；
+ *   可平凡拷贝的元素按块内连续段 memmove，而不是逐个移动赋值
+ *
+ * 默认构造不分配内存；第一次插入时建立中控数组。
  */
-template <typename T>
-class Deque {
+template<typename T, typename Alloc = allocator<T>>
+class deque {
 public:
-    using value_type = T;
-    using size_type = size_t;
-    using difference_type = ptrdiff_t;
-    using reference = T&;
-    using const_reference = const T&;
-    using pointer = T*;
-    using const_pointer = const T&;
-    using iterator = DequeIterator<T>;
-    using const_iterator = DequeIterator<const T>;
-
-    // ============================================================================
-    // 构造函数
-    // ============================================================================
-
-    Deque() : data_(nullptr), capacity_(0), size_(0), head_(0), tail_(0) {}
-
-    explicit Deque(size_type count) : Deque() {
-        resize(count);
-    }
+    // ========================================================================
+    // 类型定义
+    // ========================================================================
+
+    using value_type             = T;
+    using allocator_type         = Alloc;
+    using size_type              = decltype(sizeof(0));
+    using difference_type        = decltype((T*)0 - (T*)0);
+    using reference              = T&;
+    using const_reference        = const T&;
+    using pointer                = T*;
+    using const_pointer          = const T*;
+    using iterator               = deque_iterator<T>;
+    using const_iterator         = deque_iterator<const T>;
+    using reverse_iterator_type  = reverse_iterator<iterator>;
+    using const_reverse_iterator = reverse_iterator<const_iterator>;
 
-    Deque(size_type count, const T& value) : Deque() {
-        reserve(count * 2);
-        for (size_type i = 0; i < count; ++i) {
-            push_back(value);
+private:
+    using block         = detail::deque_block<T>;
+    using map_pointer   = T**;
+    using map_allocator = typename Alloc::template rebind<T*>::other;
+
+    static constexpr size_type B            = block::size;
+    static constexpr size_type MIN_MAP_SIZE = 8;
+
+    map_pointer map_;       // 中控数组
+    size_type   map_size_;  // 中控数组长度
+    iterator    start_;     // 第一个元素
+    iterator    finish_;    // 最后一个元素之后（始终落在已分配的块内）
+    T*          spare_;     // 缓存的空闲块
+    Alloc       alloc_;
+
+    // ========================================================================
+    // 内部辅助：块与中控数组
+    // ========================================================================
+
+    T* allocate_block() {
+        if (spare_ != nullptr) {
+            T* b = spare_;
+            spare_ = nullptr;
+            return b;
         }
+        return alloc_.allocate(B);
     }
 
-    Deque(std::initializer_list<T> init) : Deque() {
-        reserve(init.size() * 2);
-        for (const auto& item : init) {
-            push_back(item);
-        }
+    void release_block(T* b) noexcept {
+        if (spare_ == nullptr) spare_ = b;
+        else alloc_.deallocate(b, B);
     }
 
-    Deque(const Deque& other) : Deque() {
-        reserve(other.capacity_);
-        for (size_type i = 0; i < other.size_; ++i) {
-            push_back(other[i]);
-        }
+    map_pointer allocate_map(size_type n) {
+        map_allocator ma(alloc_);
+        return ma.allocate(n);
     }
 
-    Deque(Deque&& other) noexcept
-        : data_(other.data_)
-        , capacity_(other.capacity_)
-        , size_(other.size_)
-        , head_(other.head_)
-        , tail_(other.tail_) {
-        other.data_ = nullptr;
-        other.capacity_ = 0;
-        other.size_ = 0;
-        other.head_ = 0;
-        other.tail_ = 0;
+    void deallocate_map(map_pointer m, size_type n) noexcept {
+        map_allocator ma(alloc_);
+        ma.deallocate(m, n);
     }
 
-    ~Deque() {
-        clear();
-        deallocate(data_, capacity_);
+    /** 建立只含一个空块的中控数组 */
+    void init_map() {
+        map_size_ = MIN_MAP_SIZE;
+        map_ = allocate_map(map_size_);
+        map_pointer mid = map_ + map_size_ / 2;
+        *mid = allocate_block();
+        // 新块居中：两端各留半块，头插、尾插都不必立刻换块
+        start_.set_node(mid);
+        start_.cur_ = start_.first_ + B / 2;
+        finish_ = start_;
     }
 
-    Deque& operator=(const Deque& other) {
-        if (this != &other) {
-            Deque tmp(other);
-            swap(tmp);
+    /**
+     * @brief 为一端新增 nodes_to_add 个块腾出中控数组位置
+     *
+     * 数组还有一半以上空闲时原地居中，否则扩大数组。只搬移块指针。
+     */
+    void reallocate_map(size_type nodes_to_add, bool add_at_front) {
+        size_type old_nodes = static_cast<size_type>(finish_.node_ - start_.node_) + 1;
+        size_type new_nodes = old_nodes + nodes_to_add;
+        map_pointer new_start;
+
+        if (map_size_ > 2 * new_nodes) {
+            new_start = map_ + (map_size_ - new_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+            if (new_start < start_.node_) {
+                for (size_type i = 0; i < old_nodes; ++i) new_start[i] = start_.node_[i];
+            } else {
+                for (size_type i = old_nodes; i-- > 0; ) new_start[i] = start_.node_[i];
+            }
+        } else {
+            size_type new_size = map_size_ + (map_size_ > nodes_to_add ? map_size_ : nodes_to_add) + 2;
+            map_pointer new_map = allocate_map(new_size);
+            new_start = new_map + (new_size - new_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+            for (size_type i = 0; i < old_nodes; ++i) new_start[i] = start_.node_[i];
+            deallocate_map(map_, map_size_);
+            map_ = new_map;
+            map_size_ = new_size;
         }
-        return *this;
+        start_.node_  = new_start;
+        finish_.node_ = new_start + old_nodes - 1;
     }
 
-    Deque& operator=(Deque&& other) noexcept {
-        if (this != &other) {
-            clear();
-            deallocate(data_, capacity_);
-
-            data_ = other.data_;
-            capacity_ = other.capacity_;
-            size_ = other.size_;
-            head_ = other.head_;
-            tail_ = other.tail_;
-
-            other.data_ = nullptr;
-            other.capacity_ = 0;
-            other.size_ = 0;
-            other.head_ = 0;
-            other.tail_ = 0;
+    void reserve_map_at_back(size_type nodes_to_add = 1) {
+        if (nodes_to_add + 1 > map_size_ - static_cast<size_type>(finish_.node_ - map_)) {
+            reallocate_map(nodes_to_add, false);
         }
-        return *this;
     }
 
-    Deque& operator=(std::initializer_list<T> init) {
-        Deque tmp(init);
-        swap(tmp);
-        return *this;
+    void reserve_map_at_front(size_type nodes_to_add = 1) {
+        if (nodes_to_add > static_cast<size_type>(start_.node_ - map_)) {
+            reallocate_map(nodes_to_add, true);
+        }
     }
 
-    // ============================================================================
-    // 元素访问
-    // ============================================================================
-
-    reference operator[](size_type index) {
-        return data_[(head_ + index) % capacity_];
+    /** 销毁 [first, last) 的元素（按块遍历） */
+    void destroy_range(iterator first, iterator last) noexcept {
+        if (is_trivially_destructible_v<T>) return;
+        for (; first != last; ++first) alloc_.destroy(first.cur_);
     }
 
-    const_reference operator[](size_type index) const {
-        return data_[(head_ + index) % capacity_];
+    /**
+     * @brief 把 [first, last) 移动赋值到 dest 开始的位置（dest 在 first 之前，从前往后）
+     *
+     * 可平凡拷贝的类型按"源块、目标块都连续"的最长段 memmove。
+     */
+    static void move_down(iterator first, iterator last, iterator dest) {
+        if constexpr (is_trivially_copyable_v<T>) {
+            difference_type rem = last - first;
+            while (rem > 0) {
+                difference_type src_room = static_cast<difference_type>(B) - (first.cur_ - first.first_);
+                difference_type dst_room = static_cast<difference_type>(B) - (dest.cur_ - dest.first_);
+                difference_type n = rem < src_room ? rem : src_room;
+                if (dst_room < n) n = dst_room;
+                memmove(static_cast<void*>(dest.cur_), static_cast<const void*>(first.cur_),
+                        static_cast<size_type>(n) * sizeof(T));
+                first += n;
+                dest += n;
+                rem -= n;
+            }
+        } else {
+            for (; first != last; ++first, ++dest) *dest = static_cast<T&&>(*first);
+        }
     }
 
-    reference at(size_type index) {
-        if (index >= size_) {
-            throw std::out_of_range("Deque index out of range");
+    /**
+     * @brief 把 [first, last) 移动赋值到以 dest_last 结尾的位置（目标在源之后，从后往前）
+     */
+    static void move_up(iterator first, iterator last, iterator dest_last) {
+        if constexpr (is_trivially_copyable_v<T>) {
+            difference_type rem = last - first;
+            while (rem > 0) {
+                difference_type src_room = last.cur_ - last.first_;
+                difference_type dst_room = dest_last.cur_ - dest_last.first_;
+                if (src_room == 0) src_room = static_cast<difference_type>(B);
+                if (dst_room == 0) dst_room = static_cast<difference_type>(B);
+                difference_type n = rem < src_room ? rem : src_room;
+                if (dst_room < n) n = dst_room;
+                last -= n;
+                dest_last -= n;
+                memmove(static_cast<void*>(dest_last.cur_), static_cast<const void*>(last.cur_),
+                        static_cast<size_type>(n) * sizeof(T));
+                rem -= n;
+            }
+        } else {
+            while (first != last) {
+                --last;
+                --dest_last;
+                *dest_last = static_cast<T&&>(*last);
+            }
         }
-        return operator[](index);
     }
 
-    const_reference at(size_type index) const {
-        if (index >= size_) {
-            throw std::out_of_range("Deque index out of range");
+    /** 销毁全部元素并释放所有块与中控数组 */
+    void release_all() noexcept {
+        if (map_ == nullptr) return;
+        destroy_range(start_, finish_);
+        for (map_pointer n = start_.node_; n <= finish_.node_; ++n) alloc_.deallocate(*n, B);
+        if (spare_ != nullptr) alloc_.deallocate(spare_, B);
+        deallocate_map(map_, map_size_);
+        map_      = nullptr;
+        map_size_ = 0;
+        start_    = iterator();
+        finish_   = iterator();
+        spare_    = nullptr;
+    }
+
+    void steal(deque& other) noexcept {
+        map_      = other.map_;
+        map_size_ = other.map_size_;
+        start_    = other.start_;
+        finish_   = other.finish_;
+        spare_    = other.spare_;
+        other.map_      = nullptr;
+        other.map_size_ = 0;
+        other.start_    = iterator();
+        other.finish_   = iterator();
+        other.spare_    = nullptr;
+    }
+
+    template<typename... Args>
+    reference emplace_back_slow(Args&&... args) {
+        if (map_ == nullptr) init_map();
+        if (finish_.cur_ != finish_.first_ + (B - 1)) {
+            alloc_.construct(finish_.cur_, static_cast<Args&&>(args)...);
+            return *finish_.cur_++;
+        }
+        // 当前块只剩最后一个槽：先备好下一块，再构造元素
+        reserve_map_at_back();
+        T* nb = allocate_block();
+        try {
+            alloc_.construct(finish_.cur_, static_cast<Args&&>(args)...);
+        } catch (...) {
+            release_block(nb);
+            throw;
         }
-        return operator[](index);
+        T* elem = finish_.cur_;
+        finish_.node_[1] = nb;
+        finish_.set_node(finish_.node_ + 1);
+        finish_.cur_ = finish_.first_;
+        return *elem;
+    }
+
+    template<typename... Args>
+    reference emplace_front_slow(Args&&... args) {
+        if (map_ == nullptr) init_map();
+        if (start_.cur_ != start_.first_) {
+            alloc_.construct(start_.cur_ - 1, static_cast<Args&&>(args)...);
+            return *--start_.cur_;
+        }
+        reserve_map_at_front();
+        T* nb = allocate_block();
+        try {
+            alloc_.construct(nb + (B - 1), static_cast<Args&&>(args)...);
+        } catch (...) {
+            release_block(nb);
+            throw;
+        }
+        start_.node_[-1] = nb;
+        start_.set_node(start_.node_ - 1);
+        start_.cur_ = start_.first_ + (B - 1);
+        return *start_.cur_;
     }
 
-    reference front() {
-        return data_[head_];
-    }
+public:
+    // ========================================================================
+    // 构造与析构
+    // ========================================================================
 
-    const_reference front() const {
-        return data_[head_];
+    deque() noexcept
+        : map_(nullptr), map_size_(0), start_(), finish_(), spare_(nullptr), alloc_() {
     }
 
-    reference back() {
-        return data_[(tail_ + capacity_ - 1) % capacity_];
+    explicit deque(const Alloc& alloc) noexcept
+        : map_(nullptr), map_size_(0), start_(), finish_(), spare_(nullptr), alloc_(alloc) {
     }
 
-    const_reference back() const {
-        return data_[(tail_ + capacity_ - 1) % capacity_];
+    explicit deque(size_type count, const Alloc& alloc = Alloc())
+        : deque(alloc) {
+        resize(count);
     }
 
-    // ============================================================================
-    // 迭代器
-    // ============================================================================
-
-    iterator begin() { return iterator(data_, head_, capacity_); }
-    iterator end() { return iterator(data_, tail_, capacity_); }
-
-    const_iterator begin() const { return const_iterator(data_, head_, capacity_); }
-    const_iterator end() const { return const_iterator(data_, tail_, capacity_); }
-
-    const_iterator cbegin() const { return const_iterator(data_, head_, capacity_); }
-    const_iterator cend() const { return const_iterator(data_, tail_, capacity_); }
-
-    // ============================================================================
-    // 容量
-    // ============================================================================
+    deque(size_type count, const T& value, const Alloc& alloc = Alloc())
+        : deque(alloc) {
+        assign(count, value);
+    }
 
-    bool empty() const { return size_ == 0; }
-    size_type size() const { return size_; }
+    deque(const deque& other)
+        : deque(other.alloc_) {
+        for (const_iterator it = other.begin(); it != other.end(); ++it) emplace_back(*it);
+    }
 
-    /**
-     * @brief 设置容量大小
-     */
-    void resize(size_type new_size) {
-        if (new_size > size_) {
-            reserve(new_size * 2);
-            while (size_ < new_size) {
-                push_back(T());
-            }
-        } else {
-            while (size_ > new_size) {
-                pop_back();
-            }
-        }
+    deque(deque&& other) noexcept
+        : map_(nullptr), map_size_(0), start_(), finish_(), spare_(nullptr),
+          alloc_(static_cast<Alloc&&>(other.alloc_)) {
+        steal(other);
     }
 
-    /**
-     * @brief 预留容量
-     */
-    void reserve(size_type new_capacity) {
-        if (new_capacity <= capacity_) {
-            return;
-        }
+    ~deque() {
+        release_all();
+    }
 
-        pointer new_data = allocate(new_capacity);
+    // ========================================================================
+    // 赋值
+    // ========================================================================
 
-        // 拷贝现有元素
-        for (size_type i = 0; i < size_; ++i) {
-            construct(new_data + i, data_[(head_ + i) % capacity_]);
+    deque& operator=(const deque& other) {
+        if (this != &other) {
+            deque tmp(other);
+            swap(tmp);
         }
+        return *this;
+    }
 
-        // 销毁旧元素
-        for (size_type i = 0; i < size_; ++i) {
-            destroy(data_[(head_ + i) % capacity_]);
+    deque& operator=(deque&& other) noexcept {
+        if (this != &other) {
+            release_all();
+            alloc_ = other.alloc_;
+            steal(other);
         }
+        return *this;
+    }
 
-        deallocate(data_, capacity_);
-
-        data_ = new_data;
-        capacity_ = new_capacity;
-        head_ = 0;
-        tail_ = size_;
+    void assign(size_type count, const T& value) {
+        clear();
+        for (size_type i = 0; i < count; ++i) emplace_back(value);
     }
 
-    // ============================================================================
-    // 修改操作
-    // ============================================================================
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+    // ========================================================================
+    // 元素访问
+    // ========================================================================
 
     /**
-     * @brief 在尾部添加元素
+     * @brief 下标访问（不检查边界）
+     * @pre pos < size()
      */
-    void push_back(const T& value) {
-        if (size_ == capacity_) {
-            reserve(capacity_ == 0 ? 4 : capacity_ * 2);
-        }
-        construct(data_ + tail_, value);
-        tail_ = (tail_ + 1) % capacity_;
-        size_++;
+    reference operator[](size_type pos) noexcept {
+        size_type off = static_cast<size_type>(start_.cur_ - start_.first_) + pos;
+        return start_.node_[off >> block::shift][off & block::mask];
     }
 
-    void push_back(T&& value) {
-        if (size_ == capacity_) {
-            reserve(capacity_ == 0 ? 4 : capacity_ * 2);
-        }
-        construct(data_ + tail_, std::move(value));
-        tail_ = (tail_ + 1) % capacity_;
-        size_++;
+    const_reference operator[](size_type pos) const noexcept {
+        size_type off = static_cast<size_type>(start_.cur_ - start_.first_) + pos;
+        return start_.node_[off >> block::shift][off & block::mask];
     }
 
     /**
-     * @brief 在头部添加元素
+     * @brief 下标访问（与 vector::at 一致，不抛异常）
+     * @pre pos < size()
      */
-    void push_front(const T& value) {
-        if (size_ == capacity_) {
-            reserve(capacity_ == 0 ? 4 : capacity_ * 2);
-        }
-        head_ = (head_ + capacity_ - 1) % capacity_;
-        construct(data_ + head_, value);
-        size_++;
+    reference at(size_type pos) noexcept { return (*this)[pos]; }
+    const_reference at(size_type pos) const noexcept { return (*this)[pos]; }
+
+    reference front() noexcept { return *start_.cur_; }
+    const_reference front() const noexcept { return *start_.cur_; }
+
+    reference back() noexcept {
+        iterator t = finish_;
+        --t;
+        return *t;
     }
 
-    void push_front(T&& value) {
-        if (size_ == capacity_) {
-            reserve(capacity_ == 0 ? 4 : capacity_ * 2);
-        }
-        head_ = (head_ + capacity_ - 1) % capacity_;
-        construct(data_ + head_, std::move(value));
-        size_++;
+    const_reference back() const noexcept {
+        const_iterator t = finish_;
+        --t;
+        return *t;
     }
 
+    // ========================================================================
+    // 迭代器
+    // ========================================================================
+
+    iterator begin() noexcept { return start_; }
+    iterator end()   noexcept { return finish_; }
+    const_iterator begin() const noexcept { return start_; }
+    const_iterator end()   const noexcept { return finish_; }
+    const_iterator cbegin() const noexcept { return start_; }
+    const_iterator cend()   const noexcept { return finish_; }
+
+    reverse_iterator_type rbegin() noexcept { return reverse_iterator_type(end()); }
+    reverse_iterator_type rend()   noexcept { return reverse_iterator_type(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend()   const noexcept { return const_reverse_iterator(begin()); }
+
+    // ========================================================================
+    // 容量
+    // ========================================================================
+
+    bool empty() const noexcept { return start_.cur_ == finish_.cur_; }
+
+    size_type size() const noexcept { return static_cast<size_type>(finish_ - start_); }
+
+    size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
+
+    /** 每块元素数（编译期常量） */
+    static constexpr size_type block_size() noexcept { return B; }
+
     /**
-     * @brief 在尾部移除元素
+     * @brief 释放缓存的空闲块
      */
-    void pop_back() {
-        if (empty()) {
-            throw std::out_of_range("Deque is empty");
+    void shrink_to_fit() noexcept {
+        if (spare_ != nullptr) {
+            alloc_.deallocate(spare_, B);
+            spare_ = nullptr;
         }
-        tail_ = (tail_ + capacity_ - 1) % capacity_;
-        destroy(data_ + tail_);
-        size_--;
     }
 
-    /**
-     * @brief 在头部移除元素
-     */
-    void pop_front() {
-        if (empty()) {
-            throw std::out_of_range("Deque is empty");
+    // ========================================================================
+    // 两端插入 / 删除
+    // ========================================================================
+
+    template<typename... Args>
+    reference emplace_back(Args&&... args) {
+        if (map_ != nullptr && finish_.cur_ != finish_.first_ + (B - 1)) {
+            alloc_.construct(finish_.cur_, static_cast<Args&&>(args)...);
+            return *finish_.cur_++;
         }
-        destroy(data_ + head_);
-        head_ = (head_ + 1) % capacity_;
-        size_--;
+        return emplace_back_slow(static_cast<Args&&>(args)...);
     }
 
-    /**
-     * @brief 清空队列
-     */
-    void clear() {
-        while (!empty()) {
-            pop_front();
+    template<typename... Args>
+    reference emplace_front(Args&&... args) {
+        if (map_ != nullptr && start_.cur_ != start_.first_) {
+            alloc_.construct(start_.cur_ - 1, static_cast<Args&&>(args)...);
+            return *--start_.cur_;
         }
+        return emplace_front_slow(static_cast<Args&&>(args)...);
     }
 
-    /**
-     * @brief 交换两个队列
-     */
-    void swap(Deque& other) noexcept {
-        std::swap(data_, other.data_);
-        std::swap(capacity_, other.capacity_);
-        std::swap(size_, other.size_);
-        std::swap(head_, other.head_);
-        std::swap(tail_, other.tail_);
-    }
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(static_cast<T&&>(value)); }
+    void push_front(const T& value) { emplace_front(value); }
+    void push_front(T&& value) { emplace_front(static_cast<T&&>(value)); }
 
     /**
-     * @brief 生成 emplace 辅助函数
+     * @brief 删除最后一个元素
+     * @pre !empty()
      */
-    template <typename... Args>
-    void emplace_back(Args&&... args) {
-        push_back(T(std::forward<Args>(args)...));
-    }
-
-    template <typename... Args>
-    void emplace_front(Args&&... args) {
-        push_front(T(std::forward<Args>(args)...));
-    }
-
-    template <typename... Args>
-    iterator emplace(const_iterator pos, Args&&... args) {
-        size_type index = pos - begin();
-        if (index == size_) {
-            emplace_back(std::forward<Args>(args)...);
-        } else if (index == 0) {
-            emplace_front(std::forward<Args>(args)...);
-        } else {
-            // 简单实现：先在头部插入，然后交换到正确位置
-            emplace_front(std::forward<Args>(args)...);
-            for (size_type i = 0; i < index; ++i) {
-                std::swap(front(), (*this)[i + 1]);
-            }
+    void pop_back() noexcept {
+        if (finish_.cur_ == finish_.first_) {
+            // 尾块已空：归还它，退回上一块
+            release_block(finish_.first_);
+            finish_.set_node(finish_.node_ - 1);
+            finish_.cur_ = finish_.first_ + B;
         }
-        return begin() + index;
+        --finish_.cur_;
+        alloc_.destroy(finish_.cur_);
     }
 
     /**
-     * @brief 删除指定位置的元素
+     * @brief 删除第一个元素
+     * @pre !empty()
      */
-    iterator erase(const_iterator pos) {
-        size_type index = pos - begin();
-
-        // 将元素向前移动
-        for (size_type i = index; i < size_ - 1; ++i) {
-            data_[(head_ + i) % capacity_] = std::move(data_[(head_ + i + 1) % capacity_]);
+    void pop_front() noexcept {
+        alloc_.destroy(start_.cur_);
+        if (++start_.cur_ == start_.first_ + B) {
+            release_block(start_.first_);
+            start_.set_node(start_.node_ + 1);
+            start_.cur_ = start_.first_;
         }
-
-        tail_ = (tail_ + capacity_ - 1) % capacity_;
-        destroy(data_ + tail_);
-        size_--;
-
-        return begin() + index;
     }
 
-    iterator erase(const_iterator first, const_iterator last) {
-        size_type first_index = first - begin();
-        size_type last_index = last - begin();
-        size_type count = last_index - first_index;
+    // ========================================================================
+    // 中间插入 / 删除（移动较短一侧）
+    // ========================================================================
 
-        // 将元素向前移动
-        for (size_type i = first_index; i < size_ - count; ++i) {
-            data_[(head_ + i) % capacity_] = std::move(data_[(head_ + i + count) % capacity_]);
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        size_type idx = static_cast<size_type>(pos - cbegin());
+        if (idx == size()) {
+            emplace_back(static_cast<Args&&>(args)...);
+            return end() - 1;
         }
-
-        // 销毁尾部元素
-        for (size_type i = 0; i < count; ++i) {
-            tail_ = (tail_ + capacity_ - 1) % capacity_;
-            destroy(data_ + tail_);
+        if (idx == 0) {
+            emplace_front(static_cast<Args&&>(args)...);
+            return begin();
         }
-        size_ -= count;
 
-        return begin() + first_index;
+        T tmp(static_cast<Args&&>(args)...);   // 参数可能引用容器内的元素，先构造
+        if (idx < size() / 2) {
+            emplace_front(static_cast<T&&>(front()));
+            iterator at_pos = begin() + static_cast<difference_type>(idx);
+            move_down(begin() + 2, at_pos + 1, begin() + 1);
+            *at_pos = static_cast<T&&>(tmp);
+            return at_pos;
+        }
+        emplace_back(static_cast<T&&>(back()));
+        iterator at_pos = begin() + static_cast<difference_type>(idx);
+        move_up(at_pos, end() - 2, end() - 1);
+        *at_pos = static_cast<T&&>(tmp);
+        return at_pos;
     }
 
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, static_cast<T&&>(value)); }
+
     /**
-     * @brief 在指定位置插入元素
+     * @brief 在 pos 前插入 count 个 value
+     *
+     * 较短一侧整体移动 count 位（一次 move_down / move_up），O(count + min(前段, 后段))。
      */
-    iterator insert(const_iterator pos, const T& value) {
-        size_type index = pos - begin();
-        if (index >= size_) {
-            push_back(value);
-            return end() - 1;
-        } else if (index == 0) {
-            push_front(value);
+    iterator insert(const_iterator pos, size_type count, const T& value) {
+        size_type idx = static_cast<size_type>(pos - cbegin());
+        if (count == 0) return begin() + static_cast<difference_type>(idx);
+        size_type n = size();
+        if (idx == n) {
+            // 两端追加不会使已有元素的引用失效，value 可以引用容器内元素
+            for (size_type i = 0; i < count; ++i) emplace_back(value);
+            return begin() + static_cast<difference_type>(idx);
+        }
+        if (idx == 0) {
+            for (size_type i = 0; i < count; ++i) emplace_front(value);
             return begin();
+        }
+
+        T tmp(value);   // 中段元素会被移动，先复制
+        const difference_type c = static_cast<difference_type>(count);
+        const difference_type k = static_cast<difference_type>(idx);
+        if (idx < n / 2) {
+            // 前段 [0, idx) 整体前移 count 位
+            if (idx >= count) {
+                // 前 count 个元素搬到新开的头部槽位（每次都取下标 count - 1 的那个）
+                for (size_type i = 0; i < count; ++i) emplace_front(static_cast<T&&>(*(begin() + (c - 1))));
+                move_down(begin() + 2 * c, begin() + c + k, begin() + c);
+                for (iterator it = begin() + k, e = it + c; it != e; ++it) *it = tmp;
+            } else {
+                for (size_type i = count - idx; i > 0; --i) emplace_front(tmp);
+                for (size_type i = 0; i < idx; ++i) emplace_front(static_cast<T&&>(*(begin() + (c - 1))));
+                for (iterator it = begin() + c, e = it + k; it != e; ++it) *it = tmp;
+            }
         } else {
-            // 先在尾部添加，然后旋转元素
-            push_back(value);
-            for (size_type i = size_ - 1; i > index; --i) {
-                std::swap((*this)[i], (*this)[i - 1]);
+            // 后段 [idx, n) 整体后移 count 位
+            size_type after = n - idx;
+            if (after >= count) {
+                for (size_type i = 0; i < count; ++i) emplace_back(static_cast<T&&>(*(end() - c)));
+                move_up(begin() + k, begin() + static_cast<difference_type>(n) - c,
+                        begin() + static_cast<difference_type>(n));
+                for (iterator it = begin() + k, e = it + c; it != e; ++it) *it = tmp;
+            } else {
+                for (size_type i = count - after; i > 0; --i) emplace_back(tmp);
+                for (size_type i = 0; i < after; ++i) {
+                    emplace_back(static_cast<T&&>(*(begin() + k + static_cast<difference_type>(i))));
+                }
+                for (iterator it = begin() + k, e = begin() + static_cast<difference_type>(n); it != e; ++it) *it = tmp;
             }
-            return begin() + index;
         }
+        return begin() + k;
     }
 
-    iterator insert(const_iterator pos, T&& value) {
-        size_type index = pos - begin();
-        if (index >= size_) {
-            push_back(std::move(value));
-            return end() - 1;
-        } else if (index == 0) {
-            push_front(std::move(value));
-            return begin();
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        size_type idx = static_cast<size_type>(first - cbegin());
+        size_type n   = static_cast<size_type>(last - first);
+        if (n == 0) return begin() + static_cast<difference_type>(idx);
+
+        size_type after = size() - idx - n;
+        if (idx < after) {
+            // 前段向后移 n 位，再从头部删除 n 个
+            move_up(begin(), begin() + static_cast<difference_type>(idx),
+                    begin() + static_cast<difference_type>(idx + n));
+            for (size_type i = 0; i < n; ++i) pop_front();
         } else {
-            push_back(std::move(value));
-            for (size_type i = size_ - 1; i > index; --i) {
-                std::swap((*this)[i], (*this)[i - 1]);
-            }
-            return begin() + index;
+            // 后段向前移 n 位，再从尾部删除 n 个
+            move_down(begin() + static_cast<difference_type>(idx + n), end(),
+                      begin() + static_cast<difference_type>(idx));
+            for (size_type i = 0; i < n; ++i) pop_back();
         }
+        return begin() + static_cast<difference_type>(idx);
     }
 
-private:
-    pointer data_;
-    size_type capacity_;
-    size_type size_;
-    size_type head_;
-    size_type tail_;
+    // ========================================================================
+    // 整体修改
+    // ========================================================================
 
-    static pointer allocate(size_type n) {
-        return static_cast<pointer>(::operator new(n * sizeof(T)));
+    /**
+     * @brief 清空元素；保留首块（作为下次插入的起点）与空闲块
+     */
+    void clear() noexcept {
+        if (map_ == nullptr) return;
+        destroy_range(start_, finish_);
+        for (map_pointer n = start_.node_ + 1; n <= finish_.node_; ++n) release_block(*n);
+        start_.cur_ = start_.first_ + B / 2;
+        finish_ = start_;
     }
 
-    static void deallocate(pointer p, size_type) {
-        ::operator delete(p);
+    void resize(size_type count) {
+        while (size() < count) emplace_back();
+        while (size() > count) pop_back();
     }
 
-    static void construct(pointer p, const T& value) {
-        ::new (static_cast<void*>(p)) T(value);
+    void resize(size_type count, const T& value) {
+        while (size() < count) emplace_back(value);
+        while (size() > count) pop_back();
     }
 
-    static void construct(pointer p, T&& value) {
-        ::new (static_cast<void*>(p)) T(std::move(value));
+    void swap(deque& other) noexcept {
+        zen::swap(map_,      other.map_);
+        zen::swap(map_size_, other.map_size_);
+        zen::swap(start_,    other.start_);
+        zen::swap(finish_,   other.finish_);
+        zen::swap(spare_,    other.spare_);
+        zen::swap(alloc_,    other.alloc_);
     }
+};
 
-    static void destroy(pointer p) {
-        p->~T();
+// ============================================================================
+// 非成员函数
+// ============================================================================
+
+template<typename T, typename A>
+void swap(deque<T, A>& a, deque<T, A>& b) noexcept {
+    a.swap(b);
+}
+
+template<typename T, typename A>
+bool operator==(const deque<T, A>& a, const deque<T, A>& b) {
+    if (a.size() != b.size()) return false;
+    auto ia = a.begin();
+    for (auto ib = b.begin(); ib != b.end(); ++ia, ++ib) {
+        if (!(*ia == *ib)) return false;
     }
-};
+    return true;
+}
+
+template<typename T, typename A>
+bool operator!=(const deque<T, A>& a, const deque<T, A>& b) {
+    return !(a == b);
+}
+
+template<typename T, typename A>
+bool operator<(const deque<T, A>& a, const deque<T, A>& b) {
+    auto ia = a.begin();
+    auto ib = b.begin();
+    for (; ia != a.end() && ib != b.end(); ++ia, ++ib) {
+        if (*ia < *ib) return true;
+        if (*ib < *ia) return false;
+    }
+    return ia == a.end() && ib != b.end();
+}
+
+template<typename T, typename A>
+bool operator>(const deque<T, A>& a, const deque<T, A>& b) { return b < a; }
+
+template<typename T, typename A>
+bool operator<=(const deque<T, A>& a, const deque<T, A>& b) { return !(b < a); }
+
+template<typename T, typename A>
+bool operator>=(const deque<T, A>& a, const deque<T, A>& b) { return !(a < b); }
+
+// 旧名称（保留兼容）
+template<typename T>
+using Deque = deque<T>;
 
-}  // namespace zen
+} // namespace zen
 
-#endif  // ZEN_CONTAINERS_DEQUE_H
+#endif // ZEN_CONTAINERS_SEQUENTIAL_DEQUE_H
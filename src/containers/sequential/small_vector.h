@@ -0,0 +1,679 @@
+#ifndef ZEN_CONTAINERS_SEQUENTIAL_SMALL_VECTOR_H
+#define ZEN_CONTAINERS_SEQUENTIAL_SMALL_VECTOR_H
+
+#include "../../base/type_traits.h"
+#include "../../memory/allocator.h"
+#include "../../memory/uninitialized.h"
+#include "../../iterators/iterator_base.h"
+#include "../../utility/swap.h"
+#include "vector.h"     // detail::vector_next_capacity
+
+namespace zen {
+
+// ============================================================================
+// small_vector - 带内联缓冲区的动态数组
+// ============================================================================
+
+/**
+ * @brief 前 N 个元素存放在对象内部、超出后才转到堆上的 vector
+ * @tparam T         元素类型
+ * @tparam N         内联容量（元素个数）
+ * @tparam Allocator 溢出到堆时使用的分配器
+ *
+ * 适合"通常很短"的临时序列（请求头列表、路由参数、标签集合等）：
+ * 元素个数不超过 N 时完全不分配内存。
+ *
+ * 核心设计：
+ * - data_ 指向 inline_ 缓冲区或堆内存，访问路径与 vector 相同（无分支）
+ * - capacity_ == N 且 data_ == inline_ 时处于内联状态
+ * - 溢出后按 vector 的增长因子扩容；shrink_to_fit 在 size() <= N 时搬回内联缓冲区
+ * - 扩容、插入、删除、拷贝使用与 vector 相同的平凡类型快速路径（memcpy / memmove）
+ *
+ * 与 vector 的差异：
+ * - 移动构造 / 移动赋值在内联状态下需要搬移元素（O(n)，n <= N）；
+ *   移动赋值时两边分配器不相等也逐个搬移（有状态分配器，如 arena_allocator）
+ * - swap 在任一方处于内联状态时逐个交换元素
+ * - sizeof(small_vector) 随 N 增长
+ *
+ * 示例：
+ * @code
+ * zen::small_vector<int, 8> v;
+ * for (int i = 0; i < 8; ++i) v.push_back(i);   // 不分配
+ * v.push_back(8);                                // 第一次分配，容量 12
+ * @endcode
+ */
+template<typename T, decltype(sizeof(0)) N, typename Allocator = allocator<T>>
+class small_vector {
+    static_assert(N > 0, "small_vector requires at least one inline element");
+
+public:
+    // ========================================================================
+    // 类型定义
+    // ========================================================================
+
+    using value_type             = T;
+    using allocator_type         = Allocator;
+    using size_type              = decltype(sizeof(0));      // size_t
+    using difference_type        = decltype((T*)0 - (T*)0); // ptrdiff_t
+    using reference              = T&;
+    using const_reference        = const T&;
+    using pointer                = T*;
+    using const_pointer          = const T*;
+
+    using iterator               = T*;
+    using const_iterator         = const T*;
+    using reverse_iterator_type  = reverse_iterator<iterator>;
+    using const_reverse_iterator = reverse_iterator<const_iterator>;
+
+    static constexpr size_type inline_capacity = N;
+
+private:
+    T*         data_;      // 当前存储（inline_ 或堆）
+    size_type  size_;      // 当前元素个数
+    size_type  capacity_;  // 当前存储的容量
+    Allocator  alloc_;     // 分配器（仅用于堆存储）
+    alignas(T) unsigned char inline_[sizeof(T) * N]; // 内联缓冲区
+
+    // ========================================================================
+    // 内部辅助
+    // ========================================================================
+
+    T* inline_data() noexcept {
+        return reinterpret_cast<T*>(inline_);
+    }
+
+    const T* inline_data() const noexcept {
+        return reinterpret_cast<const T*>(inline_);
+    }
+
+    /**
+     * @brief 释放当前存储（内联缓冲区不释放）
+     */
+    void free_storage() noexcept {
+        if (data_ != inline_data()) {
+            alloc_.deallocate(data_, capacity_);
+        }
+    }
+
+    /**
+     * @brief 回到空的内联状态（调用前元素须已销毁、堆内存须已释放）
+     */
+    void reset_inline() noexcept {
+        data_     = inline_data();
+        size_     = 0;
+        capacity_ = N;
+    }
+
+    void destroy_range(T* first, T* last) noexcept {
+        zen::destroy_range(alloc_, first, last);
+    }
+
+    /**
+     * @brief 把元素搬到容量为 new_cap 的新存储（new_cap <= N 时搬回内联缓冲区）
+     */
+    void reallocate(size_type new_cap) {
+        T* new_data = new_cap <= N ? inline_data() : alloc_.allocate(new_cap);
+        if (new_cap <= N) new_cap = N;
+        if (new_data == data_) return;
+
+        uninitialized_relocate(alloc_, data_, data_ + size_, new_data);
+        free_storage();
+
+        data_     = new_data;
+        capacity_ = new_cap;
+    }
+
+    void ensure_capacity(size_type min_cap) {
+        if (min_cap <= capacity_) return;
+        reallocate(detail::vector_next_capacity(capacity_, min_cap));
+    }
+
+    /**
+     * @brief 扩容到堆上并在 idx 处留出 count 个位置，由 fill(dest) 在新内存中构造新元素
+     *
+     * 先构造新元素再搬移旧元素：参数可以引用容器自身的元素。
+     */
+    template<typename Fill>
+    void realloc_insert(size_type idx, size_type count, Fill fill) {
+        size_type new_cap = detail::vector_next_capacity(capacity_, size_ + count);
+        T* new_data = alloc_.allocate(new_cap);
+        try {
+            fill(new_data + idx);
+        } catch (...) {
+            alloc_.deallocate(new_data, new_cap);
+            throw;
+        }
+        uninitialized_relocate(alloc_, data_, data_ + idx, new_data);
+        uninitialized_relocate(alloc_, data_ + idx, data_ + size_, new_data + idx + count);
+        free_storage();
+
+        data_     = new_data;
+        capacity_ = new_cap;
+        size_    += count;
+    }
+
+    /**
+     * @brief 容量足够时在 idx 处腾出 count 个未初始化的位置（size_ 不变）
+     */
+    void open_gap(size_type idx, size_type count) {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            relocate_overlapping(data_ + idx, data_ + size_, data_ + idx + count);
+        } else {
+            for (size_type i = size_; i-- > idx;) {
+                if (i + count >= size_) {
+                    alloc_.construct(data_ + i + count, static_cast<T&&>(data_[i]));
+                } else {
+                    data_[i + count] = static_cast<T&&>(data_[i]);
+                }
+            }
+            size_type gap_end = idx + count < size_ ? idx + count : size_;
+            destroy_range(data_ + idx, data_ + gap_end);
+        }
+    }
+
+    /**
+     * @brief open_gap 的逆操作：构造新元素失败时把尾部搬回原处
+     */
+    void close_gap(size_type idx, size_type count) noexcept {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            relocate_overlapping(data_ + idx + count, data_ + size_ + count, data_ + idx);
+        } else {
+            destroy_range(data_ + idx + count, data_ + size_ + count);
+            size_ = idx;
+        }
+    }
+
+    void fill_construct(T* p, size_type count, const T& value) {
+        size_type i = 0;
+        try {
+            for (; i < count; ++i) {
+                alloc_.construct(p + i, value);
+            }
+        } catch (...) {
+            destroy_range(p, p + i);
+            throw;
+        }
+    }
+
+    template<typename It>
+    void range_construct(T* p, It first, It last) {
+        if constexpr (is_same<remove_cv_t<remove_pointer_t<It>>, T>::value && is_pointer<It>::value) {
+            uninitialized_copy(alloc_, static_cast<const T*>(first), static_cast<const T*>(last), p);
+        } else {
+            T* d = p;
+            try {
+                for (; first != last; ++first, ++d) {
+                    alloc_.construct(d, *first);
+                }
+            } catch (...) {
+                destroy_range(p, d);
+                throw;
+            }
+        }
+    }
+
+    /**
+     * @brief 把尾部 [mid, size_) 旋转到 idx 处
+     */
+    void rotate_tail(size_type idx, size_type mid) {
+        if (idx >= mid || mid >= size_) return;
+        auto reverse = [this](size_type lo, size_type hi) {
+            while (lo + 1 < hi) {
+                zen::swap(data_[lo], data_[hi - 1]);
+                ++lo;
+                --hi;
+            }
+        };
+        reverse(idx, mid);
+        reverse(mid, size_);
+        reverse(idx, size_);
+    }
+
+    /**
+     * @brief 从 other 窃取内容：堆存储直接接管指针，内联存储搬移元素
+     */
+    void steal(small_vector& other) {
+        if (other.data_ != other.inline_data()) {
+            data_     = other.data_;
+            size_     = other.size_;
+            capacity_ = other.capacity_;
+        } else {
+            size_type n = other.size_ < N ? other.size_ : N;   // 内联状态下 size_ <= N，写明便于编译器检查边界
+            uninitialized_relocate(alloc_, other.inline_data(), other.inline_data() + n, inline_data());
+            size_ = n;
+        }
+        other.reset_inline();
+    }
+
+public:
+    // ========================================================================
+    // 构造函数
+    // ========================================================================
+
+    small_vector() noexcept
+        : data_(inline_data()), size_(0), capacity_(N), alloc_() {
+    }
+
+    explicit small_vector(const Allocator& alloc) noexcept
+        : data_(inline_data()), size_(0), capacity_(N), alloc_(alloc) {
+    }
+
+    explicit small_vector(size_type count, const T& value,
+                          const Allocator& alloc = Allocator())
+        : data_(inline_data()), size_(0), capacity_(N), alloc_(alloc) {
+        assign(count, value);
+    }
+
+    explicit small_vector(size_type count,
+                          const Allocator& alloc = Allocator())
+        : data_(inline_data()), size_(0), capacity_(N), alloc_(alloc) {
+        resize(count);
+    }
+
+    /**
+     * @brief 从迭代器区间构造
+     */
+    template<typename InputIt,
+             typename = typename enable_if<!is_integral<InputIt>::value>::type>
+    small_vector(InputIt first, InputIt last,
+                 const Allocator& alloc = Allocator())
+        : data_(inline_data()), size_(0), capacity_(N), alloc_(alloc) {
+        assign(first, last);
+    }
+
+    small_vector(const small_vector& other)
+        : data_(inline_data()), size_(0), capacity_(N), alloc_(other.alloc_) {
+        ensure_capacity(other.size_);
+        uninitialized_copy(alloc_, other.data_, other.data_ + other.size_, data_);
+        size_ = other.size_;
+    }
+
+    small_vector(small_vector&& other)
+        : data_(inline_data()), size_(0), capacity_(N), alloc_(static_cast<Allocator&&>(other.alloc_)) {
+        steal(other);
+    }
+
+    ~small_vector() {
+        destroy_range(data_, data_ + size_);
+        free_storage();
+    }
+
+    // ========================================================================
+    // 赋值运算符
+    // ========================================================================
+
+    small_vector& operator=(const small_vector& other) {
+        if (this == &other) return *this;
+
+        clear();
+        ensure_capacity(other.size_);
+        uninitialized_copy(alloc_, other.data_, other.data_ + other.size_, data_);
+        size_ = other.size_;
+        return *this;
+    }
+
+    /**
+     * @brief 移动赋值：分配器相等（或 other 处于内联状态）时接管存储，
+     *        否则逐个搬移元素到自己的存储（堆内存只能由分配它的分配器释放）
+     */
+    small_vector& operator=(small_vector&& other) {
+        if (this == &other) return *this;
+
+        if (other.is_inline() || alloc_ == other.alloc_) {
+            destroy_range(data_, data_ + size_);
+            free_storage();
+            reset_inline();
+            steal(other);
+        } else {
+            clear();
+            ensure_capacity(other.size_);
+            uninitialized_relocate(alloc_, other.data_, other.data_ + other.size_, data_);
+            size_ = other.size_;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    // ========================================================================
+    // 元素访问
+    // ========================================================================
+
+    reference operator[](size_type pos) noexcept { return data_[pos]; }
+    const_reference operator[](size_type pos) const noexcept { return data_[pos]; }
+
+    /**
+     * @brief 元素访问（与 vector 一致，不做边界检查）
+     */
+    reference at(size_type pos) noexcept { return data_[pos]; }
+    const_reference at(size_type pos) const noexcept { return data_[pos]; }
+
+    reference front() noexcept { return data_[0]; }
+    const_reference front() const noexcept { return data_[0]; }
+
+    reference back() noexcept { return data_[size_ - 1]; }
+    const_reference back() const noexcept { return data_[size_ - 1]; }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
+    // ========================================================================
+    // 迭代器
+    // ========================================================================
+
+    iterator begin() noexcept { return data_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator cbegin() const noexcept { return data_; }
+
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+    const_iterator cend() const noexcept { return data_ + size_; }
+
+    reverse_iterator_type rbegin() noexcept { return reverse_iterator_type(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    reverse_iterator_type rend() noexcept { return reverse_iterator_type(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    // ========================================================================
+    // 容量
+    // ========================================================================
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+
+    /**
+     * @brief 元素是否仍存放在内联缓冲区中
+     */
+    bool is_inline() const noexcept { return data_ == inline_data(); }
+
+    void reserve(size_type new_cap) {
+        if (new_cap > capacity_) {
+            reallocate(new_cap);
+        }
+    }
+
+    /**
+     * @brief 释放多余容量；size() <= N 时搬回内联缓冲区
+     */
+    void shrink_to_fit() {
+        if (!is_inline() && size_ < capacity_) {
+            reallocate(size_);
+        }
+    }
+
+    allocator_type get_allocator() const { return alloc_; }
+
+    // ========================================================================
+    // 修改器
+    // ========================================================================
+
+    /**
+     * @brief 清空所有元素（保留已分配的堆存储）
+     */
+    void clear() noexcept {
+        destroy_range(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(static_cast<T&&>(value));
+    }
+
+    /**
+     * @brief 在尾部原地构造元素；需要溢出到堆时参数可以引用自身元素
+     */
+    template<typename... Args>
+    reference emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            realloc_insert(size_, 1, [&](T* p) { alloc_.construct(p, static_cast<Args&&>(args)...); });
+        } else {
+            alloc_.construct(data_ + size_, static_cast<Args&&>(args)...);
+            ++size_;
+        }
+        return back();
+    }
+
+    void pop_back() noexcept {
+        --size_;
+        alloc_.destroy(data_ + size_);
+    }
+
+    /**
+     * @brief 在 pos 之前原地构造元素
+     */
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        size_type idx = static_cast<size_type>(pos - data_);
+
+        if (idx == size_) {
+            emplace_back(static_cast<Args&&>(args)...);
+        } else if (size_ == capacity_) {
+            realloc_insert(idx, 1, [&](T* p) { alloc_.construct(p, static_cast<Args&&>(args)...); });
+        } else {
+            T tmp(static_cast<Args&&>(args)...);   // 参数可能引用将被移动的元素，先构造
+            open_gap(idx, 1);
+            try {
+                alloc_.construct(data_ + idx, static_cast<T&&>(tmp));
+            } catch (...) {
+                close_gap(idx, 1);
+                throw;
+            }
+            ++size_;
+        }
+        return data_ + idx;
+    }
+
+    iterator insert(const_iterator pos, const T& value) {
+        return emplace(pos, value);
+    }
+
+    iterator insert(const_iterator pos, T&& value) {
+        return emplace(pos, static_cast<T&&>(value));
+    }
+
+    /**
+     * @brief 在 pos 之前插入 count 个 value
+     */
+    iterator insert(const_iterator pos, size_type count, const T& value) {
+        size_type idx = static_cast<size_type>(pos - data_);
+        if (count == 0) return data_ + idx;
+
+        if (size_ + count > capacity_) {
+            realloc_insert(idx, count, [&](T* p) { fill_construct(p, count, value); });
+        } else {
+            T tmp(value);
+            open_gap(idx, count);
+            try {
+                fill_construct(data_ + idx, count, tmp);
+            } catch (...) {
+                close_gap(idx, count);
+                throw;
+            }
+            size_ += count;
+        }
+        return data_ + idx;
+    }
+
+    /**
+     * @brief 在 pos 之前插入 [first, last)
+     *
+     * 可多趟遍历的区间先求出长度，至多扩容一次；单趟区间追加到尾部后旋转到位。
+     */
+    template<typename InputIt,
+             typename = typename enable_if<!is_integral<InputIt>::value>::type>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        size_type idx = static_cast<size_type>(pos - data_);
+
+        if constexpr (is_multipass_iterator<InputIt>::value) {
+            size_type count = range_length(first, last);
+            if (count == 0) return data_ + idx;
+
+            if (size_ + count > capacity_) {
+                realloc_insert(idx, count, [&](T* p) { range_construct(p, first, last); });
+            } else {
+                open_gap(idx, count);
+                try {
+                    range_construct(data_ + idx, first, last);
+                } catch (...) {
+                    close_gap(idx, count);
+                    throw;
+                }
+                size_ += count;
+            }
+        } else {
+            size_type old_size = size_;
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+            rotate_tail(idx, old_size);
+        }
+        return data_ + idx;
+    }
+
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        size_type idx_first = static_cast<size_type>(first - data_);
+        size_type idx_last  = static_cast<size_type>(last - data_);
+        size_type count     = idx_last - idx_first;
+
+        if (count == 0) return data_ + idx_first;
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            destroy_range(data_ + idx_first, data_ + idx_last);
+            relocate_overlapping(data_ + idx_last, data_ + size_, data_ + idx_first);
+        } else {
+            for (size_type i = idx_first; i + count < size_; ++i) {
+                data_[i] = static_cast<T&&>(data_[i + count]);
+            }
+            destroy_range(data_ + size_ - count, data_ + size_);
+        }
+        size_ -= count;
+        return data_ + idx_first;
+    }
+
+    void resize(size_type count) {
+        if (count > size_) {
+            ensure_capacity(count);
+            for (size_type i = size_; i < count; ++i) {
+                alloc_.construct(data_ + i);
+                ++size_;
+            }
+        } else if (count < size_) {
+            destroy_range(data_ + count, data_ + size_);
+            size_ = count;
+        }
+    }
+
+    void resize(size_type count, const T& value) {
+        if (count > size_) {
+            insert(end(), count - size_, value);
+        } else if (count < size_) {
+            destroy_range(data_ + count, data_ + size_);
+            size_ = count;
+        }
+    }
+
+    void assign(size_type count, const T& value) {
+        T tmp(value);                           // value 可能引用自身元素
+        clear();
+        reserve(count);
+        fill_construct(data_, count, tmp);
+        size_ = count;
+    }
+
+    /**
+     * @brief 用 [first, last) 替换内容；可多趟遍历时先按长度预留
+     */
+    template<typename InputIt,
+             typename = typename enable_if<!is_integral<InputIt>::value>::type>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        if constexpr (is_multipass_iterator<InputIt>::value) {
+            size_type count = range_length(first, last);
+            reserve(count);
+            range_construct(data_, first, last);
+            size_ = count;
+        } else {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+    }
+
+    /**
+     * @brief 交换内容：双方都在堆上时 O(1)，否则逐个交换元素
+     */
+    void swap(small_vector& other) {
+        if (this == &other) return;
+        if (!is_inline() && !other.is_inline()) {
+            zen::swap(data_,     other.data_);
+            zen::swap(size_,     other.size_);
+            zen::swap(capacity_, other.capacity_);
+            zen::swap(alloc_,    other.alloc_);
+            return;
+        }
+        small_vector tmp(static_cast<small_vector&&>(other));
+        other = static_cast<small_vector&&>(*this);
+        *this = static_cast<small_vector&&>(tmp);
+    }
+};
+
+// ============================================================================
+// 非成员函数
+// ============================================================================
+
+template<typename T, decltype(sizeof(0)) N, typename A>
+void swap(small_vector<T, N, A>& a, small_vector<T, N, A>& b) {
+    a.swap(b);
+}
+
+template<typename T, decltype(sizeof(0)) N, typename A>
+bool operator==(const small_vector<T, N, A>& a, const small_vector<T, N, A>& b) {
+    if (a.size() != b.size()) return false;
+    for (decltype(a.size()) i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i]) return false;
+    }
+    return true;
+}
+
+template<typename T, decltype(sizeof(0)) N, typename A>
+bool operator!=(const small_vector<T, N, A>& a, const small_vector<T, N, A>& b) {
+    return !(a == b);
+}
+
+template<typename T, decltype(sizeof(0)) N, typename A>
+bool operator<(const small_vector<T, N, A>& a, const small_vector<T, N, A>& b) {
+    decltype(a.size()) i = 0;
+    for (; i < a.size() && i < b.size(); ++i) {
+        if (a[i] < b[i]) return true;
+        if (b[i] < a[i]) return false;
+    }
+    return i == a.size() && i < b.size();
+}
+
+template<typename T, decltype(sizeof(0)) N, typename A>
+bool operator>(const small_vector<T, N, A>& a, const small_vector<T, N, A>& b) {
+    return b < a;
+}
+
+template<typename T, decltype(sizeof(0)) N, typename A>
+bool operator<=(const small_vector<T, N, A>& a, const small_vector<T, N, A>& b) {
+    return !(b < a);
+}
+
+template<typename T, decltype(sizeof(0)) N, typename A>
+bool operator>=(const small_vector<T, N, A>& a, const small_vector<T, N, A>& b) {
+    return !(a < b);
+}
+
+} // namespace zen
+
+#endif // ZEN_CONTAINERS_SEQUENTIAL_SMALL_VECTOR_H
@@ -1,10 +1,658 @@
 #ifndef ZEN_CONTAINERS_SEQUENTIAL_STRING_H
 #define ZEN_CONTAINERS_SEQUENTIAL_STRING_H
 
+#include "../../memory/allocator.h"
+#include "../../utility/string_view.h"
+#include "../../utility/hash.h"
+#include "../../utility/swap.h"
+#include <cstring>      // memcpy, memmove, memset, strlen
+#include <stdexcept>    // out_of_range, length_error
+
 namespace zen {
 
-// String container implementation
+// ============================================================================
+// string - 带短字符串优化（SSO）的字节字符串
+// ============================================================================
+
+/**
+ * @brief 拥有内存、以 '\0' 结尾的字符串
+ *
+ * sizeof(string) == 3 * sizeof(void*)（64 位下 24 字节）。
+ * 长度不超过 SSO_CAPACITY（64 位下 22）的字符串直接存放在对象内部，不分配内存。
+ *
+ * 布局（两种表示共用同一块存储）：
+ *
+ *   长串：  [ ptr_ | size_ | cap_word_ ]            cap_word_ 中带 LONG_FLAG
+ *   短串：  [ c0 c1 ... c21 '\0' | tag ]            tag = 短串长度（0 ~ 22）
+ *
+ * 最后一个字节在两种表示下重叠：短串时是长度（最高位为 0），
+ * 长串时是 cap_word_ 的某个字节，编码保证其最高位为 1，据此区分两种表示。
+ * 小端平台上该字节是 cap_word_ 的最高字节，大端平台上是最低字节。
+ *
+ * 与 string_view 互通：
+ * - string 可隐式转换为 string_view，所有查找都转发给 string_view
+ * - 可从 string_view 显式构造，可直接与 string_view / const char* 比较、拼接
+ * - hash<string> / equal_to<string> 是透明的，可用 string_view 在容器中查找
+ *
+ * 示例：
+ * @code
+ * zen::string s = "hello";          // 短串，不分配
+ * s += ", world";
+ * zen::string_view sv = s;
+ * auto pos = s.find("world");
+ * @endcode
+ */
+class string {
+public:
+    // ========================================================================
+    // 类型定义
+    // ========================================================================
+
+    using value_type             = char;
+    using size_type              = decltype(sizeof(0));
+    using difference_type        = decltype((char*)0 - (char*)0);
+    using reference              = char&;
+    using const_reference        = const char&;
+    using pointer                = char*;
+    using const_pointer          = const char*;
+    using iterator               = char*;
+    using const_iterator         = const char*;
+    using allocator_type         = allocator<char>;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    struct long_rep {
+        char*     ptr;
+        size_type size;
+        size_type cap_word;   // 编码后的容量（不含 '\0'）
+    };
+
+    static constexpr size_type REP_BYTES = sizeof(long_rep);
+    static constexpr size_type TAG_INDEX = REP_BYTES - 1;
+
+public:
+    /** 内联可存放的最大长度（另需一个 '\0' 和一个 tag 字节） */
+    static constexpr size_type SSO_CAPACITY = REP_BYTES - 2;
+
+private:
+    static constexpr unsigned char LONG_BIT = 0x80;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    static constexpr size_type encode_cap(size_type cap) noexcept { return (cap << 8) | LONG_BIT; }
+    static constexpr size_type decode_cap(size_type w) noexcept { return w >> 8; }
+#else
+    static constexpr size_type LONG_FLAG = static_cast<size_type>(LONG_BIT) << (8 * (sizeof(size_type) - 1));
+    static constexpr size_type encode_cap(size_type cap) noexcept { return cap | LONG_FLAG; }
+    static constexpr size_type decode_cap(size_type w) noexcept { return w & ~LONG_FLAG; }
+#endif
+
+    union {
+        long_rep l_;
+        char     s_[REP_BYTES];
+    };
+
+    // ========================================================================
+    // 表示切换
+    // ========================================================================
+
+    bool is_long() const noexcept {
+        return (static_cast<unsigned char>(s_[TAG_INDEX]) & LONG_BIT) != 0;
+    }
+
+    void set_short_size(size_type n) noexcept {
+        s_[n] = '\0';
+        s_[TAG_INDEX] = static_cast<char>(n);
+    }
+
+    void init_short() noexcept {
+        s_[0] = '\0';
+        s_[TAG_INDEX] = 0;
+    }
+
+    char* ptr() noexcept { return is_long() ? l_.ptr : s_; }
+    const char* ptr() const noexcept { return is_long() ? l_.ptr : s_; }
+
+    void set_size(size_type n) noexcept {
+        if (is_long()) {
+            l_.size = n;
+            l_.ptr[n] = '\0';
+        } else {
+            set_short_size(n);
+        }
+    }
+
+    static char* alloc_chars(size_type cap) {
+        if (cap > max_size()) throw std::length_error("zen::string: capacity too large");
+        return allocator<char>().allocate(cap + 1);
+    }
+
+    static void free_chars(char* p, size_type cap) noexcept {
+        allocator<char>().deallocate(p, cap + 1);
+    }
+
+    void free_long() noexcept {
+        if (is_long()) {
+            free_chars(l_.ptr, decode_cap(l_.cap_word));
+        }
+    }
+
+    /**
+     * @brief 未初始化状态下用 [s, s+n) 初始化
+     */
+    void init(const char* s, size_type n) {
+        if (n <= SSO_CAPACITY) {
+            if (n) memcpy(s_, s, n);
+            set_short_size(n);
+        } else {
+            char* p = alloc_chars(n);
+            memcpy(p, s, n);
+            p[n] = '\0';
+            l_.ptr      = p;
+            l_.size     = n;
+            l_.cap_word = encode_cap(n);
+        }
+    }
+
+    /**
+     * @brief 把容量调整为至少 new_cap，保留现有内容
+     */
+    void grow_to(size_type new_cap) {
+        size_type n = size();
+        char* p = alloc_chars(new_cap);
+        memcpy(p, ptr(), n + 1);
+        free_long();
+        l_.ptr      = p;
+        l_.size     = n;
+        l_.cap_word = encode_cap(new_cap);
+    }
+
+    /**
+     * @brief 确保能容纳 min_cap 个字符（2 倍扩容）
+     */
+    void ensure_capacity(size_type min_cap) {
+        size_type cap = capacity();
+        if (min_cap <= cap) return;
+        size_type new_cap = cap * 2;
+        if (new_cap < min_cap) new_cap = min_cap;
+        grow_to(new_cap);
+    }
+
+    static size_type check_pos(size_type pos, size_type n, const char* what) {
+        if (pos > n) throw std::out_of_range(what);
+        return pos;
+    }
+
+public:
+    // ========================================================================
+    // 构造与析构
+    // ========================================================================
+
+    string() noexcept {
+        init_short();
+    }
+
+    string(const char* s) {
+        init(s, strlen(s));
+    }
+
+    string(const char* s, size_type n) {
+        init(s, n);
+    }
+
+    /**
+     * @brief 从 string_view 构造（显式，避免意外拷贝）
+     */
+    explicit string(string_view sv) {
+        init(sv.data(), sv.size());
+    }
+
+    string(size_type n, char c) {
+        init_short();
+        append(n, c);
+    }
+
+    string(const string& other) {
+        init(other.data(), other.size());
+    }
+
+    /**
+     * @brief 移动构造：整体拷贝表示，对方回到空的短串
+     */
+    string(string&& other) noexcept {
+        memcpy(static_cast<void*>(this), static_cast<const void*>(&other), sizeof(string));
+        other.init_short();
+    }
+
+    ~string() {
+        free_long();
+    }
+
+    // ========================================================================
+    // 赋值
+    // ========================================================================
+
+    string& operator=(const string& other) {
+        if (this != &other) assign(other.data(), other.size());
+        return *this;
+    }
+
+    string& operator=(string&& other) noexcept {
+        if (this != &other) {
+            free_long();
+            memcpy(static_cast<void*>(this), static_cast<const void*>(&other), sizeof(string));
+            other.init_short();
+        }
+        return *this;
+    }
+
+    string& operator=(const char* s) { return assign(s, strlen(s)); }
+    string& operator=(string_view sv) { return assign(sv.data(), sv.size()); }
+
+    string& operator=(char c) { return assign(&c, 1); }
+
+    /**
+     * @brief 用 [s, s+n) 替换内容（s 可以指向自身）
+     */
+    string& assign(const char* s, size_type n) {
+        if (n <= capacity()) {
+            char* p = ptr();
+            if (n) memmove(p, s, n);
+            set_size(n);
+        } else {
+            string tmp(s, n);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    string& assign(string_view sv) { return assign(sv.data(), sv.size()); }
+
+    string& assign(size_type n, char c) {
+        clear();
+        return append(n, c);
+    }
+
+    // ========================================================================
+    // 元素访问
+    // ========================================================================
+
+    reference operator[](size_type pos) noexcept { return ptr()[pos]; }
+    const_reference operator[](size_type pos) const noexcept { return ptr()[pos]; }
+
+    /**
+     * @brief 带边界检查的访问
+     * @throw std::out_of_range 若 pos >= size()
+     */
+    reference at(size_type pos) {
+        if (pos >= size()) throw std::out_of_range("zen::string::at");
+        return ptr()[pos];
+    }
+
+    const_reference at(size_type pos) const {
+        if (pos >= size()) throw std::out_of_range("zen::string::at");
+        return ptr()[pos];
+    }
+
+    reference front() noexcept { return ptr()[0]; }
+    const_reference front() const noexcept { return ptr()[0]; }
+
+    reference back() noexcept { return ptr()[size() - 1]; }
+    const_reference back() const noexcept { return ptr()[size() - 1]; }
+
+    char* data() noexcept { return ptr(); }
+    const char* data() const noexcept { return ptr(); }
+    const char* c_str() const noexcept { return ptr(); }
+
+    /**
+     * @brief 隐式转换为 string_view（零拷贝）
+     */
+    operator string_view() const noexcept {
+        return string_view(data(), size());
+    }
+
+    // ========================================================================
+    // 迭代器
+    // ========================================================================
+
+    iterator begin() noexcept { return ptr(); }
+    const_iterator begin() const noexcept { return ptr(); }
+    const_iterator cbegin() const noexcept { return ptr(); }
+
+    iterator end() noexcept { return ptr() + size(); }
+    const_iterator end() const noexcept { return ptr() + size(); }
+    const_iterator cend() const noexcept { return ptr() + size(); }
+
+    // ========================================================================
+    // 容量
+    // ========================================================================
+
+    size_type size() const noexcept {
+        return is_long() ? l_.size : static_cast<size_type>(static_cast<unsigned char>(s_[TAG_INDEX]));
+    }
+
+    size_type length() const noexcept { return size(); }
+
+    /** 长串容量编码占用最高字节的一位，最大长度因此受限 */
+    static constexpr size_type max_size() noexcept { return (static_cast<size_type>(-1) >> 8) - 1; }
+    bool empty() const noexcept { return size() == 0; }
+
+    size_type capacity() const noexcept {
+        return is_long() ? decode_cap(l_.cap_word) : SSO_CAPACITY;
+    }
+
+    /**
+     * @brief 内容是否存放在对象内部（未分配内存）
+     */
+    bool is_inline() const noexcept { return !is_long(); }
+
+    void reserve(size_type new_cap) {
+        if (new_cap > capacity()) grow_to(new_cap);
+    }
+
+    /**
+     * @brief 释放多余容量；长度不超过 SSO_CAPACITY 时搬回对象内部
+     */
+    void shrink_to_fit() {
+        if (!is_long()) return;
+        size_type n = l_.size;
+        if (n <= SSO_CAPACITY) {
+            char* p = l_.ptr;
+            size_type cap = decode_cap(l_.cap_word);
+            memcpy(s_, p, n);
+            set_short_size(n);
+            free_chars(p, cap);
+        } else if (n < decode_cap(l_.cap_word)) {
+            grow_to(n);
+        }
+    }
+
+    // ========================================================================
+    // 修改器
+    // ========================================================================
+
+    /**
+     * @brief 清空内容（保留已分配的容量）
+     */
+    void clear() noexcept {
+        set_size(0);
+    }
+
+    void push_back(char c) {
+        size_type n = size();
+        ensure_capacity(n + 1);
+        ptr()[n] = c;
+        set_size(n + 1);
+    }
+
+    void pop_back() noexcept {
+        set_size(size() - 1);
+    }
+
+    /**
+     * @brief 追加 [s, s+n)（s 可以指向自身）
+     */
+    string& append(const char* s, size_type n) {
+        if (n == 0) return *this;
+        size_type old = size();
+        if (old + n > capacity()) {
+            // s 可能指向旧缓冲区：扩容前记下偏移
+            const char* base = ptr();
+            bool self = s >= base && s < base + old;
+            size_type off = static_cast<size_type>(s - base);
+            ensure_capacity(old + n);
+            if (self) s = ptr() + off;
+        }
+        memmove(ptr() + old, s, n);
+        set_size(old + n);
+        return *this;
+    }
+
+    string& append(string_view sv) { return append(sv.data(), sv.size()); }
+    string& append(const char* s) { return append(s, strlen(s)); }
+
+    string& append(size_type n, char c) {
+        size_type old = size();
+        ensure_capacity(old + n);
+        if (n) memset(ptr() + old, c, n);
+        set_size(old + n);
+        return *this;
+    }
+
+    string& operator+=(const string& s) { return append(s.data(), s.size()); }
+    string& operator+=(string_view sv) { return append(sv.data(), sv.size()); }
+    string& operator+=(const char* s) { return append(s, strlen(s)); }
+    string& operator+=(char c) { push_back(c); return *this; }
+
+    /**
+     * @brief 在 pos 处插入 sv
+     * @throw std::out_of_range 若 pos > size()
+     */
+    string& insert(size_type pos, string_view sv) {
+        size_type n = size();
+        check_pos(pos, n, "zen::string::insert");
+        if (sv.empty()) return *this;
+        string tmp;
+        if (sv.data() >= data() && sv.data() < data() + n) {   // 插入自身的片段
+            tmp.assign(sv.data(), sv.size());
+            sv = tmp;
+        }
+        ensure_capacity(n + sv.size());
+        char* p = ptr();
+        memmove(p + pos + sv.size(), p + pos, n - pos);
+        memcpy(p + pos, sv.data(), sv.size());
+        set_size(n + sv.size());
+        return *this;
+    }
+
+    string& insert(size_type pos, size_type count, char c) {
+        size_type n = size();
+        check_pos(pos, n, "zen::string::insert");
+        ensure_capacity(n + count);
+        char* p = ptr();
+        memmove(p + pos + count, p + pos, n - pos);
+        memset(p + pos, c, count);
+        set_size(n + count);
+        return *this;
+    }
+
+    /**
+     * @brief 删除从 pos 开始的 count 个字符
+     * @throw std::out_of_range 若 pos > size()
+     */
+    string& erase(size_type pos = 0, size_type count = npos) {
+        size_type n = size();
+        check_pos(pos, n, "zen::string::erase");
+        if (count > n - pos) count = n - pos;
+        char* p = ptr();
+        memmove(p + pos, p + pos + count, n - pos - count);
+        set_size(n - count);
+        return *this;
+    }
+
+    /**
+     * @brief 把 [pos, pos+count) 替换为 sv
+     */
+    string& replace(size_type pos, size_type count, string_view sv) {
+        size_type n = size();
+        check_pos(pos, n, "zen::string::replace");
+        if (count > n - pos) count = n - pos;
+        string tmp;
+        tmp.reserve(n - count + sv.size());
+        tmp.append(data(), pos);
+        tmp.append(sv);
+        tmp.append(data() + pos + count, n - pos - count);
+        swap(tmp);
+        return *this;
+    }
+
+    void resize(size_type n, char c = '\0') {
+        size_type old = size();
+        if (n > old) {
+            append(n - old, c);
+        } else {
+            set_size(n);
+        }
+    }
+
+    void swap(string& other) noexcept {
+        char tmp[sizeof(string)];
+        memcpy(tmp, static_cast<const void*>(this), sizeof(string));
+        memcpy(static_cast<void*>(this), static_cast<const void*>(&other), sizeof(string));
+        memcpy(static_cast<void*>(&other), tmp, sizeof(string));
+    }
+
+    // ========================================================================
+    // 查找与比较（转发给 string_view）
+    // ========================================================================
+
+    /**
+     * @brief 子串拷贝
+     * @throw std::out_of_range 若 pos > size()
+     */
+    string substr(size_type pos = 0, size_type count = npos) const {
+        return string(string_view(*this).substr(pos, count));
+    }
+
+    size_type find(string_view sv, size_type pos = 0) const noexcept {
+        return string_view(*this).find(sv, pos);
+    }
+
+    size_type find(char c, size_type pos = 0) const noexcept {
+        return string_view(*this).find(c, pos);
+    }
+
+    size_type rfind(string_view sv, size_type pos = npos) const noexcept {
+        return string_view(*this).rfind(sv, pos);
+    }
+
+    size_type rfind(char c, size_type pos = npos) const noexcept {
+        return string_view(*this).rfind(c, pos);
+    }
+
+    size_type find_first_of(string_view chars, size_type pos = 0) const noexcept {
+        return string_view(*this).find_first_of(chars, pos);
+    }
+
+    size_type find_first_not_of(string_view chars, size_type pos = 0) const noexcept {
+        return string_view(*this).find_first_not_of(chars, pos);
+    }
+
+    bool starts_with(string_view sv) const noexcept { return string_view(*this).starts_with(sv); }
+    bool ends_with(string_view sv) const noexcept { return string_view(*this).ends_with(sv); }
+    bool contains(string_view sv) const noexcept { return string_view(*this).contains(sv); }
+
+    int compare(string_view sv) const noexcept {
+        return string_view(*this).compare(sv);
+    }
+};
+
+// ============================================================================
+// 非成员函数
+// ============================================================================
+
+inline void swap(string& a, string& b) noexcept {
+    a.swap(b);
+}
+
+inline string operator+(const string& a, string_view b) {
+    string r;
+    r.reserve(a.size() + b.size());
+    r.append(a.data(), a.size());
+    r.append(b);
+    return r;
+}
+
+inline string operator+(string&& a, string_view b) {
+    a.append(b);
+    return static_cast<string&&>(a);
+}
+
+inline string operator+(string_view a, const string& b) {
+    string r;
+    r.reserve(a.size() + b.size());
+    r.append(a);
+    r.append(b.data(), b.size());
+    return r;
+}
+
+inline string operator+(const string& a, const string& b) {
+    return a + string_view(b);
+}
+
+inline string operator+(const string& a, const char* b) {
+    return a + string_view(b);
+}
+
+inline string operator+(const char* a, const string& b) {
+    return string_view(a) + b;
+}
+
+inline string operator+(const string& a, char c) {
+    string r(a);
+    r.push_back(c);
+    return r;
+}
+
+// 左侧为临时对象时直接在其缓冲区上追加
+inline string operator+(string&& a, const string& b) {
+    return static_cast<string&&>(a) + string_view(b);
+}
+
+inline string operator+(string&& a, const char* b) {
+    return static_cast<string&&>(a) + string_view(b);
+}
+
+inline string operator+(string&& a, char c) {
+    a.push_back(c);
+    return static_cast<string&&>(a);
+}
+
+// 比较：string 与 string / string_view / const char* 任意组合
+// （string_view 在左侧时由 string_view 的成员运算符处理，这里不再重载，
+//   否则 string_view == "literal" 会因 string 的隐式构造产生二义性）
+inline bool operator==(const string& a, const string& b) noexcept { return string_view(a) == string_view(b); }
+inline bool operator==(const string& a, string_view b) noexcept { return string_view(a) == b; }
+inline bool operator==(const string& a, const char* b) noexcept { return string_view(a) == string_view(b); }
+inline bool operator==(const char* a, const string& b) noexcept { return string_view(a) == string_view(b); }
+
+inline bool operator!=(const string& a, const string& b) noexcept { return !(a == b); }
+inline bool operator!=(const string& a, string_view b) noexcept { return !(a == b); }
+inline bool operator!=(const string& a, const char* b) noexcept { return !(a == b); }
+inline bool operator!=(const char* a, const string& b) noexcept { return !(a == b); }
+
+inline bool operator<(const string& a, const string& b) noexcept { return a.compare(b) < 0; }
+inline bool operator>(const string& a, const string& b) noexcept { return a.compare(b) > 0; }
+inline bool operator<=(const string& a, const string& b) noexcept { return a.compare(b) <= 0; }
+inline bool operator>=(const string& a, const string& b) noexcept { return a.compare(b) >= 0; }
+
+// ============================================================================
+// 哈希：与 string_view / std::string 结果一致，支持透明查找
+// ============================================================================
+
+/**
+ * @brief 平凡重定位：短串数据在对象内部但没有指向自身的指针，可按字节搬移
+ */
+template<>
+struct is_trivially_relocatable<string> {
+    static constexpr bool value = true;
+};
+
+template<> struct hash<string> : string_hash {};
+
+/**
+ * @brief 只提供 string_view 版本：string / string_view / const char* 都经由它比较，
+ *        避免 string_equal 中 std::string 重载带来的二义性
+ */
+template<>
+struct equal_to<string> {
+    using is_transparent = void;
+
+    bool operator()(string_view a, string_view b) const noexcept {
+        return string_equal()(a, b);
+    }
+};
 
 } // namespace zen
 
-#endif // ZEN_CONTAINERS_SEQUENTIAL_STRING_H
\ No newline at end of file
+#endif // ZEN_CONTAINERS_SEQUENTIAL_STRING_H
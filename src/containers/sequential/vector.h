@@ -3,11 +3,38 @@
 
 #include "../../base/type_traits.h"
 #include "../../memory/allocator.h"
+#include "../../memory/uninitialized.h"
 #include "../../iterators/iterator_base.h"
 #include "../../utility/swap.h"
 
+// 扩容倍数 = ZEN_VECTOR_GROWTH_NUM / ZEN_VECTOR_GROWTH_DEN（默认 1.5 倍）
+// 1.5 倍使释放掉的旧块之和有机会容纳后续的新块，分配器可以复用；
+// 需要更少重分配次数时可在构建时定义为 2 / 1
+#ifndef ZEN_VECTOR_GROWTH_NUM
+#define ZEN_VECTOR_GROWTH_NUM 3
+#endif
+#ifndef ZEN_VECTOR_GROWTH_DEN
+#define ZEN_VECTOR_GROWTH_DEN 2
+#endif
+
 namespace zen {
 
+namespace detail {
+
+/**
+ * @brief 按增长因子计算新容量：至少比 cap 大 1，且不小于 min_cap
+ */
+constexpr decltype(sizeof(0)) vector_next_capacity(decltype(sizeof(0)) cap,
+                                                   decltype(sizeof(0)) min_cap) noexcept {
+    static_assert(ZEN_VECTOR_GROWTH_NUM > ZEN_VECTOR_GROWTH_DEN, "growth factor must be greater than 1");
+    decltype(sizeof(0)) grown = cap / ZEN_VECTOR_GROWTH_DEN * ZEN_VECTOR_GROWTH_NUM
+                              + cap % ZEN_VECTOR_GROWTH_DEN * ZEN_VECTOR_GROWTH_NUM / ZEN_VECTOR_GROWTH_DEN;
+    if (grown <= cap) grown = cap + 1;
+    return grown < min_cap ? min_cap : grown;
+}
+
+} // namespace detail
+
 // ============================================================================
 // vector - 动态数组（连续内存）
 // ============================================================================
@@ -26,10 +53,15 @@ namespace zen {
  * - capacity_: 已分配的总容量
  *
  * 扩容策略：
- * - 容量不足时分配新内存（2 倍扩容）
- * - 将旧元素移动到新内存
+ * - 容量不足时分配新内存（默认 1.5 倍扩容，见 ZEN_VECTOR_GROWTH_NUM / DEN）
+ * - 将旧元素重定位到新内存
  * - 释放旧内存
  *
+ * 平凡类型快速路径（编译期选择，见 type_traits.h）：
+ * - is_trivially_copyable：拷贝构造 / 拷贝赋值直接 memcpy
+ * - is_trivially_relocatable：扩容 memcpy，中间插入 / 删除 memmove，不逐个移动与析构
+ * - is_trivially_destructible：clear / 析构不遍历元素
+ *
  * 内存管理：
  * - 分配器负责内存的分配/释放
  * - placement new 负责元素的构造
@@ -106,32 +138,14 @@ private:
      * @brief 销毁 [first, last) 范围内的所有元素（只调用析构，不释放内存）
      */
     void destroy_range(T* first, T* last) noexcept {
-        for (T* p = first; p != last; ++p) {
-            alloc_.destroy(p);
-        }
-    }
-
-    /**
-     * @brief 将 [src_first, src_last) 的元素移动构造到 dest 开始的位置
-     *
-     * 用于扩容时将旧元素"搬"到新内存。
-     * 移动构造后旧元素处于有效但未指定的状态，需要再显式析构。
-     */
-    void move_construct_range(T* dest, T* src_first, T* src_last) {
-        T* d = dest;
-        for (T* s = src_first; s != src_last; ++s, ++d) {
-            alloc_.construct(d, static_cast<T&&>(*s));
-        }
+        zen::destroy_range(alloc_, first, last);
     }
 
     /**
      * @brief 将 [src_first, src_last) 的元素拷贝构造到 dest 开始的位置
      */
     void copy_construct_range(T* dest, const T* src_first, const T* src_last) {
-        T* d = dest;
-        for (const T* s = src_first; s != src_last; ++s, ++d) {
-            alloc_.construct(d, *s);
-        }
+        uninitialized_copy(alloc_, src_first, src_last, dest);
     }
 
     /**
@@ -139,33 +153,26 @@ private:
      *
      * 步骤：
      * 1. 分配新内存
-     * 2. 移动旧元素到新内存
-     * 3. 析构旧元素
-     * 4. 释放旧内存
-     * 5. 更新 data_ 和 capacity_
+     * 2. 旧元素重定位到新内存（可平凡重定位时整段 memcpy）
+     * 3. 释放旧内存
+     * 4. 更新 data_ 和 capacity_
      */
     void reallocate(size_type new_cap) {
         T* new_data = alloc_memory(new_cap);
 
-        // 移动旧元素（比拷贝更高效）
-        move_construct_range(new_data, data_, data_ + size_);
-
-        // 析构旧元素
-        destroy_range(data_, data_ + size_);
+        uninitialized_relocate(alloc_, data_, data_ + size_, new_data);
 
-        // 释放旧内存
         free_memory(data_, capacity_);
 
-        // 更新指针和容量
         data_     = new_data;
         capacity_ = new_cap;
     }
 
     /**
-     * @brief 根据当前 capacity_ 计算新容量（2 倍增长）
+     * @brief 根据当前 capacity_ 计算容纳 min_cap 所需的新容量
      */
-    size_type grow_capacity() const noexcept {
-        return capacity_ == 0 ? 1 : capacity_ * 2;
+    size_type grow_capacity(size_type min_cap) const noexcept {
+        return detail::vector_next_capacity(capacity_, min_cap);
     }
 
     /**
@@ -173,11 +180,122 @@ private:
      */
     void ensure_capacity(size_type min_cap) {
         if (min_cap <= capacity_) return;
+        reallocate(grow_capacity(min_cap));
+    }
 
-        size_type new_cap = grow_capacity();
-        if (new_cap < min_cap) new_cap = min_cap;
+    /**
+     * @brief 扩容并在 idx 处留出 count 个位置，由 fill(dest) 在新内存中构造新元素
+     *
+     * 先构造新元素再搬移旧元素：参数可以引用容器自身的元素（旧内存此时仍然有效）。
+     */
+    template<typename Fill>
+    void realloc_insert(size_type idx, size_type count, Fill fill) {
+        size_type new_cap = grow_capacity(size_ + count);
+        T* new_data = alloc_memory(new_cap);
+        try {
+            fill(new_data + idx);
+        } catch (...) {
+            free_memory(new_data, new_cap);
+            throw;
+        }
+        uninitialized_relocate(alloc_, data_, data_ + idx, new_data);
+        uninitialized_relocate(alloc_, data_ + idx, data_ + size_, new_data + idx + count);
+        free_memory(data_, capacity_);
 
-        reallocate(new_cap);
+        data_     = new_data;
+        capacity_ = new_cap;
+        size_    += count;
+    }
+
+    /**
+     * @brief 容量足够时在 idx 处腾出 count 个未初始化的位置
+     *
+     * - 可平凡重定位：一次 memmove
+     * - 其他：尾部元素移动构造 / 移动赋值到后方，再析构空出来的旧对象
+     *
+     * 调用后 [idx, idx + count) 是未初始化内存，size_ 尚未更新。
+     */
+    void open_gap(size_type idx, size_type count) {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            relocate_overlapping(data_ + idx, data_ + size_, data_ + idx + count);
+        } else {
+            for (size_type i = size_; i-- > idx;) {
+                if (i + count >= size_) {
+                    alloc_.construct(data_ + i + count, static_cast<T&&>(data_[i]));
+                } else {
+                    data_[i + count] = static_cast<T&&>(data_[i]);
+                }
+            }
+            size_type gap_end = idx + count < size_ ? idx + count : size_;
+            destroy_range(data_ + idx, data_ + gap_end);
+        }
+    }
+
+    /**
+     * @brief open_gap 的逆操作：构造新元素失败时把尾部搬回原处
+     */
+    void close_gap(size_type idx, size_type count) noexcept {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            relocate_overlapping(data_ + idx + count, data_ + size_ + count, data_ + idx);
+        } else {
+            // 元素已逐个移走，无法无异常地还原；只保证不泄漏、不重复析构
+            destroy_range(data_ + idx + count, data_ + size_ + count);
+            size_ = idx;
+        }
+    }
+
+    /**
+     * @brief 在未初始化的 [p, p + count) 上构造 count 个 value；失败时回滚已构造的部分
+     */
+    void fill_construct(T* p, size_type count, const T& value) {
+        size_type i = 0;
+        try {
+            for (; i < count; ++i) {
+                alloc_.construct(p + i, value);
+            }
+        } catch (...) {
+            destroy_range(p, p + i);
+            throw;
+        }
+    }
+
+    /**
+     * @brief 在未初始化的 p 上依次构造 [first, last)；失败时回滚已构造的部分
+     *
+     * 源区间是 T 的指针且 T 可平凡拷贝时整段 memcpy。
+     */
+    template<typename It>
+    void range_construct(T* p, It first, It last) {
+        if constexpr (is_same<remove_cv_t<remove_pointer_t<It>>, T>::value && is_pointer<It>::value) {
+            uninitialized_copy(alloc_, static_cast<const T*>(first), static_cast<const T*>(last), p);
+        } else {
+            T* d = p;
+            try {
+                for (; first != last; ++first, ++d) {
+                    alloc_.construct(d, *first);
+                }
+            } catch (...) {
+                destroy_range(p, d);
+                throw;
+            }
+        }
+    }
+
+    /**
+     * @brief 把尾部 [mid, size_) 旋转到 idx 处（单趟区间插入：先追加再旋转）
+     */
+    void rotate_tail(size_type idx, size_type mid) {
+        if (idx >= mid || mid >= size_) return;
+        auto reverse = [this](size_type lo, size_type hi) {
+            while (lo + 1 < hi) {
+                zen::swap(data_[lo], data_[hi - 1]);
+                ++lo;
+                --hi;
+            }
+        };
+        reverse(idx, mid);
+        reverse(mid, size_);
+        reverse(idx, size_);
     }
 
 public:
@@ -233,6 +351,16 @@ public:
         }
     }
 
+    /**
+     * @brief 从迭代器区间构造（可多趟遍历时只分配一次）
+     */
+    template<typename InputIt,
+             typename = typename enable_if<!is_integral<InputIt>::value>::type>
+    vector(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+        : data_(nullptr), size_(0), capacity_(0), alloc_(alloc) {
+        assign(first, last);
+    }
+
     /**
      * @brief 拷贝构造
      */
@@ -472,32 +600,33 @@ public:
     /**
      * @brief 在尾部追加元素（拷贝版本）
      *
-     * 若容量不足，扩容为原来的 2 倍；
+     * 若容量不足，按增长因子扩容；
      * 在 data_[size_] 上 placement new 构造元素
      */
     void push_back(const T& value) {
-        ensure_capacity(size_ + 1);
-        alloc_.construct(data_ + size_, value);
-        ++size_;
+        emplace_back(value);
     }
 
     /**
      * @brief 在尾部追加元素（移动版本）
      */
     void push_back(T&& value) {
-        ensure_capacity(size_ + 1);
-        alloc_.construct(data_ + size_, static_cast<T&&>(value));
-        ++size_;
+        emplace_back(static_cast<T&&>(value));
     }
 
     /**
      * @brief 在尾部原地构造元素（emplace_back）
+     *
+     * 需要扩容时先在新内存中构造新元素，参数可以引用容器自身的元素。
      */
     template<typename... Args>
     reference emplace_back(Args&&... args) {
-        ensure_capacity(size_ + 1);
-        alloc_.construct(data_ + size_, static_cast<Args&&>(args)...);
-        ++size_;
+        if (size_ == capacity_) {
+            realloc_insert(size_, 1, [&](T* p) { alloc_.construct(p, static_cast<Args&&>(args)...); });
+        } else {
+            alloc_.construct(data_ + size_, static_cast<Args&&>(args)...);
+            ++size_;
+        }
         return back();
     }
 
@@ -511,61 +640,110 @@ public:
     }
 
     /**
-     * @brief 在 pos 之前插入元素（拷贝）
-     * @param pos 插入位置的迭代器
-     * @param value 要插入的值
-     * @return 指向新插入元素的迭代器
+     * @brief 在 pos 之前原地构造元素
+     * @return 指向新元素的迭代器
      *
      * 插入步骤：
-     * 1. 扩容（若需要）
-     * 2. 从 pos 开始的元素向后移动一位（为新元素腾位置）
-     * 3. 在 pos 位置构造新元素
+     * 1. 容量不足：新内存中先构造新元素，再把前后两段旧元素重定位过去
+     * 2. 容量足够：先构造临时对象（参数可能引用将被移动的元素），
+     *    腾出位置（可平凡重定位时一次 memmove），再移动构造到位
      */
-    iterator insert(const_iterator pos, const T& value) {
-        // 计算插入位置索引（扩容前保存，因为扩容会使 pos 失效）
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
         size_type idx = static_cast<size_type>(pos - data_);
 
-        ensure_capacity(size_ + 1);
-
-        // 从末尾向前移动元素，为新元素腾出空间
-        // 注意：需要从右往左移动，避免覆盖
-        if (idx < size_) {
-            // 在最后一位后面构造（相当于移动到新位置）
-            alloc_.construct(data_ + size_, static_cast<T&&>(data_[size_ - 1]));
-            // 将 [idx, size_-1) 范围内的元素向右移动一位
-            for (size_type i = size_ - 1; i > idx; --i) {
-                data_[i] = static_cast<T&&>(data_[i - 1]);
-            }
-            // 在 idx 处赋值（已构造，直接赋值）
-            data_[idx] = value;
+        if (idx == size_) {
+            emplace_back(static_cast<Args&&>(args)...);
+        } else if (size_ == capacity_) {
+            realloc_insert(idx, 1, [&](T* p) { alloc_.construct(p, static_cast<Args&&>(args)...); });
         } else {
-            // 插入到末尾
-            alloc_.construct(data_ + size_, value);
+            T tmp(static_cast<Args&&>(args)...);
+            open_gap(idx, 1);
+            try {
+                alloc_.construct(data_ + idx, static_cast<T&&>(tmp));
+            } catch (...) {
+                close_gap(idx, 1);
+                throw;
+            }
+            ++size_;
         }
-
-        ++size_;
         return data_ + idx;
     }
 
+    /**
+     * @brief 在 pos 之前插入元素（拷贝）
+     */
+    iterator insert(const_iterator pos, const T& value) {
+        return emplace(pos, value);
+    }
+
     /**
      * @brief 在 pos 之前插入元素（移动）
      */
     iterator insert(const_iterator pos, T&& value) {
+        return emplace(pos, static_cast<T&&>(value));
+    }
+
+    /**
+     * @brief 在 pos 之前插入 count 个 value
+     * @return 指向第一个新元素的迭代器
+     */
+    iterator insert(const_iterator pos, size_type count, const T& value) {
         size_type idx = static_cast<size_type>(pos - data_);
+        if (count == 0) return data_ + idx;
 
-        ensure_capacity(size_ + 1);
+        if (size_ + count > capacity_) {
+            realloc_insert(idx, count, [&](T* p) { fill_construct(p, count, value); });
+        } else {
+            T tmp(value);
+            open_gap(idx, count);
+            try {
+                fill_construct(data_ + idx, count, tmp);
+            } catch (...) {
+                close_gap(idx, count);
+                throw;
+            }
+            size_ += count;
+        }
+        return data_ + idx;
+    }
+
+    /**
+     * @brief 在 pos 之前插入 [first, last)
+     * @return 指向第一个新元素的迭代器
+     *
+     * 可多趟遍历的区间（指针、前向迭代器等）先求出长度，至多扩容一次；
+     * 单趟输入迭代器逐个追加到尾部后再旋转到位。
+     * [first, last) 不能是本容器的元素。
+     */
+    template<typename InputIt,
+             typename = typename enable_if<!is_integral<InputIt>::value>::type>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        size_type idx = static_cast<size_type>(pos - data_);
 
-        if (idx < size_) {
-            alloc_.construct(data_ + size_, static_cast<T&&>(data_[size_ - 1]));
-            for (size_type i = size_ - 1; i > idx; --i) {
-                data_[i] = static_cast<T&&>(data_[i - 1]);
+        if constexpr (is_multipass_iterator<InputIt>::value) {
+            size_type count = range_length(first, last);
+            if (count == 0) return data_ + idx;
+
+            if (size_ + count > capacity_) {
+                realloc_insert(idx, count, [&](T* p) { range_construct(p, first, last); });
+            } else {
+                open_gap(idx, count);
+                try {
+                    range_construct(data_ + idx, first, last);
+                } catch (...) {
+                    close_gap(idx, count);
+                    throw;
+                }
+                size_ += count;
             }
-            data_[idx] = static_cast<T&&>(value);
         } else {
-            alloc_.construct(data_ + size_, static_cast<T&&>(value));
+            size_type old_size = size_;
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+            rotate_tail(idx, old_size);
         }
-
-        ++size_;
         return data_ + idx;
     }
 
@@ -573,29 +751,17 @@ public:
      * @brief 删除 pos 处的元素
      * @param pos 要删除的元素位置
      * @return 指向被删除元素之后元素的迭代器
-     *
-     * 删除步骤：
-     * 1. 将 [pos+1, end) 的元素向前移动一位
-     * 2. 析构最后一个元素（已被移走）
      */
     iterator erase(const_iterator pos) {
-        size_type idx = static_cast<size_type>(pos - data_);
-
-        // 向前移动后续元素
-        for (size_type i = idx; i + 1 < size_; ++i) {
-            data_[i] = static_cast<T&&>(data_[i + 1]);
-        }
-
-        // 析构最后一个元素
-        --size_;
-        alloc_.destroy(data_ + size_);
-
-        return data_ + idx;
+        return erase(pos, pos + 1);
     }
 
     /**
      * @brief 删除 [first, last) 范围内的元素
      * @return 指向 last 原来位置的迭代器
+     *
+     * - 可平凡重定位：析构被删元素后一次 memmove 补齐
+     * - 其他：后续元素逐个移动赋值向前，再析构末尾 count 个元素
      */
     iterator erase(const_iterator first, const_iterator last) {
         size_type idx_first = static_cast<size_type>(first - data_);
@@ -604,14 +770,14 @@ public:
 
         if (count == 0) return data_ + idx_first;
 
-        // 移动后续元素填补空缺
-        for (size_type i = idx_first; i + count < size_; ++i) {
-            data_[i] = static_cast<T&&>(data_[i + count]);
-        }
-
-        // 析构末尾 count 个元素
-        for (size_type i = size_ - count; i < size_; ++i) {
-            alloc_.destroy(data_ + i);
+        if constexpr (is_trivially_relocatable_v<T>) {
+            destroy_range(data_ + idx_first, data_ + idx_last);
+            relocate_overlapping(data_ + idx_last, data_ + size_, data_ + idx_first);
+        } else {
+            for (size_type i = idx_first; i + count < size_; ++i) {
+                data_[i] = static_cast<T&&>(data_[i + count]);
+            }
+            destroy_range(data_ + size_ - count, data_ + size_);
         }
 
         size_ -= count;
@@ -642,11 +808,7 @@ public:
      */
     void resize(size_type count, const T& value) {
         if (count > size_) {
-            ensure_capacity(count);
-            for (size_type i = size_; i < count; ++i) {
-                alloc_.construct(data_ + i, value);
-            }
-            size_ = count;
+            insert(end(), count - size_, value);
         } else if (count < size_) {
             destroy_range(data_ + count, data_ + size_);
             size_ = count;
@@ -657,14 +819,41 @@ public:
      * @brief 填充 count 个 value（清空现有内容）
      */
     void assign(size_type count, const T& value) {
+        T tmp(value);                           // value 可能引用自身元素
         clear();
-        ensure_capacity(count);
-        for (size_type i = 0; i < count; ++i) {
-            alloc_.construct(data_ + i, value);
-        }
+        reserve(count);
+        fill_construct(data_, count, tmp);
         size_ = count;
     }
 
+    /**
+     * @brief 用 [first, last) 替换内容
+     *
+     * 可多趟遍历的区间先求出长度：容量不足时直接按精确长度重新分配一次，
+     * 不经过逐步扩容（旧元素已清空，无需搬移）。
+     */
+    template<typename InputIt,
+             typename = typename enable_if<!is_integral<InputIt>::value>::type>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        if constexpr (is_multipass_iterator<InputIt>::value) {
+            size_type count = range_length(first, last);
+            if (count > capacity_) {
+                free_memory(data_, capacity_);
+                data_     = nullptr;
+                capacity_ = 0;
+                data_     = alloc_memory(count);
+                capacity_ = count;
+            }
+            range_construct(data_, first, last);
+            size_ = count;
+        } else {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+    }
+
     /**
      * @brief 交换两个 vector 的内容（O(1)）
      */
@@ -733,6 +922,14 @@ bool operator>=(const vector<T, A>& a, const vector<T, A>& b) {
     return !(a < b);
 }
 
+/**
+ * @brief 使用默认（无状态）分配器的 vector 只持有指针与计数，可平凡重定位
+ */
+template<typename T>
+struct is_trivially_relocatable<vector<T, allocator<T>>> {
+    static constexpr bool value = true;
+};
+
 } // namespace zen
 
 #endif // ZEN_CONTAINERS_SEQUENTIAL_VECTOR_H
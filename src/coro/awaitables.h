@@ -0,0 +1,111 @@
+/**
+ * @file awaitables.h
+ * @brief 协程中等待 future 与事件循环定时器
+ *
+ * - co_await fut            : 等待 zen::future<T>（右值，取走结果）或 shared_future<T>
+ * - co_await sleep_for(ms)  : 在当前线程运行的事件循环上等待 ms 毫秒
+ *
+ * 等待 future 不占用线程：协程作为回调节点挂在 future 的共享状态上（节点就在协程帧里，
+ * 不额外分配），由 set_value / set_exception 的线程恢复。需要在特定线程上继续时，
+ * 之后再 co_await pool.schedule() / loop.schedule()。
+ *
+ * 事件循环的 IO 就绪等待见 event_loop::readable() / writable()。
+ */
+#ifndef ZEN_CORO_AWAITABLES_H
+#define ZEN_CORO_AWAITABLES_H
+
+#include "../base/macros.h"
+
+#if ZEN_HAS_COROUTINES
+
+#include "../threading/future/future.h"
+#include "../event/event_loop.h"
+
+#include <atomic>
+#include <coroutine>
+#include <stdexcept>
+#include <utility>
+
+namespace zen {
+namespace detail {
+
+/**
+ * @brief 等待 future 的 awaiter
+ *
+ * 回调可能在 await_suspend 注册的同时、甚至注册过程中（结果已就绪）触发。
+ * 两边各交换一次 armed：后到的一方负责恢复协程。回调先到时 await_suspend
+ * 返回 false，协程在当前线程直接继续，不会在 await_suspend 内部被恢复。
+ */
+template<typename Future>
+struct future_awaiter : future_continuation {
+    Future                  fut;
+    std::coroutine_handle<> waiting;
+    std::atomic<bool>       armed{false};
+
+    explicit future_awaiter(Future&& f) noexcept : fut(std::move(f)) {
+        fire = &on_ready;
+    }
+
+    static void on_ready(future_continuation* c) noexcept {
+        auto* self = static_cast<future_awaiter*>(c);
+        if (self->armed.exchange(true, std::memory_order_acq_rel)) {
+            self->waiting.resume();
+        }
+    }
+
+    bool await_ready() const {
+        if (!fut.valid()) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+        return fut.is_ready();
+    }
+
+    bool await_suspend(std::coroutine_handle<> h) noexcept {
+        waiting = h;
+        future_access::state(fut)->add_continuation(this);
+        return !armed.exchange(true, std::memory_order_acq_rel);
+    }
+
+    decltype(auto) await_resume() {
+        return fut.get();
+    }
+};
+
+} // namespace detail
+
+// ============================================================================
+// co_await future
+// ============================================================================
+
+template<typename T>
+detail::future_awaiter<future<T>> operator co_await(future<T>&& f) noexcept {
+    return detail::future_awaiter<future<T>>(std::move(f));
+}
+
+template<typename T>
+detail::future_awaiter<shared_future<T>> operator co_await(const shared_future<T>& f) noexcept {
+    return detail::future_awaiter<shared_future<T>>(shared_future<T>(f));
+}
+
+// ============================================================================
+// 定时器
+// ============================================================================
+
+/**
+ * @brief 在当前线程运行的事件循环上等待 ms 毫秒
+ *
+ * 只能在事件循环线程上（run() 期间）调用，否则抛出 std::logic_error。
+ */
+inline event_loop::timer_awaiter sleep_for(unsigned long long ms) {
+    event_loop* loop = event_loop::current();
+    if (!loop) {
+        throw std::logic_error("zen::sleep_for: no event_loop running on this thread");
+    }
+    return loop->sleep_for(ms);
+}
+
+} // namespace zen
+
+#endif // ZEN_HAS_COROUTINES
+
+#endif // ZEN_CORO_AWAITABLES_H
@@ -0,0 +1,56 @@
+/**
+ * @file frame_allocator.h
+ * @brief 协程帧分配
+ *
+ * 协程帧由编译器调用 promise_type::operator new / delete 分配。默认走全局 new，
+ * 每个 co_await 链上的 task 都是一次 malloc / free；短小、频繁的协程
+ * 分配开销往往超过协程体本身。
+ *
+ * promise 继承 coro_frame_allocated 后，帧从线程缓存分配器（memory/thread_cache.h）
+ * 取：同一线程上的分配 / 释放只是空闲链表的 push / pop。协程常在一个线程创建、
+ * 在另一个线程（线程池 / 事件循环）结束，跨线程释放的帧经中心转移表回到原级别，
+ * 不需要额外处理。
+ *
+ * 定义 ZEN_CORO_FRAME_POOL=0 时退回全局 new / delete（便于用内存检查工具排查）。
+ */
+#ifndef ZEN_CORO_FRAME_ALLOCATOR_H
+#define ZEN_CORO_FRAME_ALLOCATOR_H
+
+#include "../memory/thread_cache.h"
+
+#include <cstddef>
+#include <new>
+
+#ifndef ZEN_CORO_FRAME_POOL
+#define ZEN_CORO_FRAME_POOL 1
+#endif
+
+namespace zen {
+
+/**
+ * @brief promise 基类：协程帧从线程缓存分配器分配
+ *
+ * 只提供按大小释放的 operator delete，编译器总是传入帧大小，
+ * 小帧的释放不需要读取 span 头。
+ */
+struct coro_frame_allocated {
+    static void* operator new(size_t size) {
+#if ZEN_CORO_FRAME_POOL
+        return tc_malloc(size);
+#else
+        return ::operator new(size);
+#endif
+    }
+
+    static void operator delete(void* p, size_t size) noexcept {
+#if ZEN_CORO_FRAME_POOL
+        tc_free_sized(p, size);
+#else
+        ::operator delete(p, size);
+#endif
+    }
+};
+
+} // namespace zen
+
+#endif // ZEN_CORO_FRAME_ALLOCATOR_H
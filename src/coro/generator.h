@@ -0,0 +1,201 @@
+/**
+ * @file generator.h
+ * @brief C++20 同步生成器
+ *
+ * generator<T> 用 co_yield 逐个产出值，按输入迭代器的方式遍历：
+ * 每次 ++ 恢复协程执行到下一个 co_yield，产出的值不拷贝（迭代器直接引用协程内的对象）；
+ * 只有 co_yield 只读左值时拷贝一份。
+ * 协程体抛出的异常在 begin() / ++ 处重新抛出。协程帧由线程缓存分配器分配。
+ *
+ * 示例：
+ * @code
+ * zen::generator<int> iota(int n) {
+ *     for (int i = 0; i < n; ++i) co_yield i;
+ * }
+ *
+ * for (int x : iota(10)) printf("%d\n", x);
+ * @endcode
+ */
+#ifndef ZEN_CORO_GENERATOR_H
+#define ZEN_CORO_GENERATOR_H
+
+#include "../base/macros.h"
+
+#if ZEN_HAS_COROUTINES
+
+#include "frame_allocator.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace zen {
+
+template<typename T>
+class [[nodiscard]] generator {
+public:
+    using value_type = typename std::remove_cv<typename std::remove_reference<T>::type>::type;
+    using reference  = typename std::conditional<std::is_reference<T>::value, T, T&>::type;
+    using pointer    = typename std::remove_reference<reference>::type*;
+
+    struct promise_type : coro_frame_allocated {
+        pointer            current = nullptr;
+        std::exception_ptr exception;
+
+        generator get_return_object() noexcept {
+            return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        std::suspend_always final_suspend() const noexcept { return {}; }
+
+        std::suspend_always yield_value(typename std::remove_reference<reference>::type& v) noexcept {
+            current = std::addressof(v);
+            return {};
+        }
+
+        // 右值在协程挂起期间一直存活（临时对象的生命期覆盖整个 co_yield 表达式）
+        std::suspend_always yield_value(typename std::remove_reference<reference>::type&& v) noexcept {
+            current = std::addressof(v);
+            return {};
+        }
+
+        /**
+         * @brief 只读左值（co_yield 一个 const 对象）：拷贝一份放在挂起点上
+         *
+         * 迭代器得到的是可写引用，不能直接指向 const 对象；副本存放在 awaiter 里，
+         * 协程挂起期间一直有效（与 std::generator 相同）。
+         */
+        struct copied_value_awaiter {
+            value_type value;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                h.promise().current = std::addressof(value);
+            }
+            void await_resume() const noexcept {}
+        };
+
+        copied_value_awaiter yield_value(const value_type& v)
+            noexcept(std::is_nothrow_copy_constructible<value_type>::value)
+            requires (!std::is_reference<T>::value && !std::is_const<T>::value &&
+                      std::is_copy_constructible<value_type>::value)
+        {
+            return copied_value_awaiter{ v };
+        }
+
+        void return_void() const noexcept {}
+
+        void unhandled_exception() noexcept {
+            exception = std::current_exception();
+        }
+
+        // 生成器内不允许 co_await
+        template<typename U>
+        std::suspend_never await_transform(U&&) = delete;
+    };
+
+    struct sentinel {};
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = generator::value_type;
+        using reference         = generator::reference;
+        using pointer           = generator::pointer;
+
+        iterator() noexcept : handle_(nullptr) {}
+        explicit iterator(std::coroutine_handle<promise_type> h) noexcept : handle_(h) {}
+
+        reference operator*() const noexcept {
+            return static_cast<reference>(*handle_.promise().current);
+        }
+
+        pointer operator->() const noexcept {
+            return handle_.promise().current;
+        }
+
+        iterator& operator++() {
+            advance(handle_);
+            return *this;
+        }
+
+        void operator++(int) {
+            ++*this;
+        }
+
+        friend bool operator==(const iterator& it, sentinel) noexcept {
+            return !it.handle_ || it.handle_.done();
+        }
+
+        friend bool operator!=(const iterator& it, sentinel s) noexcept {
+            return !(it == s);
+        }
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    generator() noexcept : handle_(nullptr) {}
+
+    generator(generator&& other) noexcept : handle_(other.handle_) {
+        other.handle_ = nullptr;
+    }
+
+    generator& operator=(generator&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = other.handle_;
+            other.handle_ = nullptr;
+        }
+        return *this;
+    }
+
+    generator(const generator&)            = delete;
+    generator& operator=(const generator&) = delete;
+
+    ~generator() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    /**
+     * @brief 开始执行到第一个 co_yield（只能调用一次）
+     */
+    iterator begin() {
+        if (handle_) {
+            advance(handle_);
+        }
+        return iterator(handle_);
+    }
+
+    sentinel end() const noexcept {
+        return {};
+    }
+
+private:
+    explicit generator(std::coroutine_handle<promise_type> h) noexcept : handle_(h) {}
+
+    static void advance(std::coroutine_handle<promise_type> h) {
+        h.resume();
+        if (h.done() && h.promise().exception) {
+            std::rethrow_exception(std::exchange(h.promise().exception, nullptr));
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+} // namespace zen
+
+#endif // ZEN_HAS_COROUTINES
+
+#endif // ZEN_CORO_GENERATOR_H
@@ -0,0 +1,406 @@
+/**
+ * @file task.h
+ * @brief C++20 协程任务
+ *
+ * - task<T>     : 惰性启动的异步操作，co_await 时才开始执行，结果或异常交给等待者
+ * - co_spawn    : 启动一个 task，不等待结果（可先切换到指定的调度器）
+ * - to_future   : 启动一个 task，结果写入 zen::future
+ * - sync_wait   : 在当前线程阻塞等待 task 完成
+ *
+ * 实现：
+ * - task 创建后挂起在初始点；co_await 时记录等待者的句柄、在当前线程 resume task。
+ *   task 结束（final_suspend）与 await_suspend 返回各交换一次 promise 中的标志，
+ *   后到的一方负责继续等待者：task 同步完成时 await_suspend 返回 false，等待者直接继续，
+ *   循环中反复 co_await 同步完成的 task 不会让调用栈增长；task 在其他线程完成时，
+ *   由那个线程恢复等待者。
+ *   （没有用对称转移：GCC 在 -O0 / -O1 或开启 ASan 时不把它编译成尾调用，
+ *   同步完成的 co_await 每次都会压一层栈。）
+ * - 协程体抛出的异常保存在 promise 中，在等待者的 co_await 处重新抛出。
+ * - task 拥有协程帧：析构时销毁尚未执行完的帧（未启动的 task 直接丢弃）。
+ * - 协程帧由线程缓存分配器分配（frame_allocator.h）。
+ * - sync_wait 用自己的互斥锁 / 条件变量等待，结果直接从 promise 取出，不经过 future。
+ *
+ * 可等待对象（awaitables.h、event/event_loop.h、threading/pool/thread_pool.h）：
+ * - co_await pool.schedule()       : 切换到线程池的工作线程
+ * - co_await loop.readable(fd)     : 等待 fd 可读（在事件循环线程上恢复）
+ * - co_await loop.sleep_for(ms)    : 事件循环定时器
+ * - co_await some_future           : 等待 zen::future / shared_future
+ *
+ * 需要以 C++20 编译（ZEN_HAS_COROUTINES，CMake 选项 ZEN_COROUTINES）。
+ *
+ * 示例：
+ * @code
+ * zen::task<int> load(zen::thread_pool& pool, int id) {
+ *     co_await pool.schedule();          // 之后在工作线程上执行
+ *     co_return read_record(id);
+ * }
+ *
+ * zen::task<int> total(zen::thread_pool& pool) {
+ *     int a = co_await load(pool, 1);
+ *     int b = co_await load(pool, 2);
+ *     co_return a + b;
+ * }
+ *
+ * int n = zen::sync_wait(total(pool));
+ * zen::future<int> f = zen::to_future(total(pool));
+ * @endcode
+ */
+#ifndef ZEN_CORO_TASK_H
+#define ZEN_CORO_TASK_H
+
+#include "../base/macros.h"
+
+#if ZEN_HAS_COROUTINES
+
+#include "frame_allocator.h"
+#include "../threading/future/future.h"
+#include "../threading/sync/mutex.h"
+#include "../threading/sync/condition_variable.h"
+#include "../threading/sync/lock_guard.h"
+#include "../threading/sync/unique_lock.h"
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace zen {
+
+template<typename T = void>
+class task;
+
+namespace detail {
+
+// ============================================================================
+// promise
+// ============================================================================
+
+struct task_promise_base : coro_frame_allocated {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr      exception;
+    std::atomic<bool>       handoff{false};   // await_suspend 返回与 task 结束，先到的一方置位
+
+    struct final_awaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template<typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> h) noexcept {
+            task_promise_base& p = h.promise();
+            if (p.handoff.exchange(true, std::memory_order_acq_rel)) {
+                p.continuation.resume();
+            }
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    final_awaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() noexcept {
+        exception = std::current_exception();
+    }
+
+    void rethrow_if_exception() const {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+template<typename T>
+struct task_promise final : task_promise_base {
+    // 引用类型按指针保存
+    using stored_type = typename std::conditional<std::is_reference<T>::value,
+                                                  typename std::remove_reference<T>::type*,
+                                                  T>::type;
+
+    union { stored_type value; };
+    bool has_value = false;
+
+    task_promise() noexcept {}
+
+    ~task_promise() {
+        if (has_value) {
+            value.~stored_type();
+        }
+    }
+
+    task<T> get_return_object() noexcept;
+
+    template<typename U = T,
+             typename = typename std::enable_if<std::is_convertible<U&&, T>::value>::type>
+    void return_value(U&& v) {
+        if constexpr (std::is_reference<T>::value) {
+            ::new (static_cast<void*>(&value)) stored_type(std::addressof(v));
+        } else {
+            ::new (static_cast<void*>(&value)) stored_type(std::forward<U>(v));
+        }
+        has_value = true;
+    }
+
+    T result() {
+        rethrow_if_exception();
+        if constexpr (std::is_reference<T>::value) {
+            return static_cast<T>(*value);
+        } else {
+            return std::move(value);
+        }
+    }
+};
+
+template<>
+struct task_promise<void> final : task_promise_base {
+    task<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void result() {
+        rethrow_if_exception();
+    }
+};
+
+} // namespace detail
+
+// ============================================================================
+// task
+// ============================================================================
+
+/**
+ * @brief 惰性协程任务
+ *
+ * 不可拷贝，可移动。只能 co_await 一次（co_await 右值）。
+ */
+template<typename T>
+class [[nodiscard]] task {
+public:
+    using promise_type = detail::task_promise<T>;
+    using value_type   = T;
+
+    task() noexcept : handle_(nullptr) {}
+
+    explicit task(std::coroutine_handle<promise_type> h) noexcept : handle_(h) {}
+
+    task(task&& other) noexcept : handle_(other.handle_) {
+        other.handle_ = nullptr;
+    }
+
+    task& operator=(task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = other.handle_;
+            other.handle_ = nullptr;
+        }
+        return *this;
+    }
+
+    task(const task&)            = delete;
+    task& operator=(const task&) = delete;
+
+    ~task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    /**
+     * @brief 是否关联协程
+     */
+    bool valid() const noexcept {
+        return handle_ != nullptr;
+    }
+
+    /**
+     * @brief 协程是否已执行完
+     */
+    bool is_ready() const noexcept {
+        return !handle_ || handle_.done();
+    }
+
+    struct awaiter {
+        std::coroutine_handle<promise_type> handle;
+
+        bool await_ready() const noexcept {
+            return !handle || handle.done();
+        }
+
+        bool await_suspend(std::coroutine_handle<> waiting) noexcept {
+            promise_type& p = handle.promise();
+            p.continuation = waiting;
+            handle.resume();
+            return !p.handoff.exchange(true, std::memory_order_acq_rel);
+        }
+
+        T await_resume() {
+            if (!handle) {
+                throw std::future_error(std::future_errc::no_state);
+            }
+            return handle.promise().result();
+        }
+    };
+
+    struct ready_awaiter : awaiter {
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief 启动任务并等待结果
+     */
+    awaiter operator co_await() && noexcept {
+        return awaiter{ handle_ };
+    }
+
+    /**
+     * @brief 启动任务并等待其结束，不取结果（异常也不抛出）
+     *
+     * 之后仍可 co_await 这个 task 取结果（立即完成）。
+     */
+    ready_awaiter when_ready() const noexcept {
+        return ready_awaiter{ { handle_ } };
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template<typename T>
+inline task<T> task_promise<T>::get_return_object() noexcept {
+    return task<T>(std::coroutine_handle<task_promise>::from_promise(*this));
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept {
+    return task<void>(std::coroutine_handle<task_promise>::from_promise(*this));
+}
+
+// ============================================================================
+// 分离执行
+// ============================================================================
+
+/**
+ * @brief 立即开始、结束时自行销毁的协程（co_spawn / to_future 的外壳）
+ *
+ * 协程体负责处理所有异常；逃逸的异常调用 std::terminate（与 submit_void 相同）。
+ */
+struct detached_task {
+    struct promise_type : coro_frame_allocated {
+        detached_task get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+template<typename T>
+detached_task run_into_promise(task<T> t, promise<T> p) {
+    try {
+        if constexpr (std::is_void<T>::value) {
+            co_await std::move(t);
+            p.set_value();
+        } else {
+            p.set_value(co_await std::move(t));
+        }
+    } catch (...) {
+        p.set_exception(std::current_exception());
+    }
+}
+
+template<typename T>
+detached_task run_detached(task<T> t) {
+    co_await std::move(t);
+}
+
+/**
+ * @brief sync_wait 的完成通知
+ */
+struct sync_wait_event {
+    mutex              lock;
+    condition_variable cond;
+    bool               done = false;
+
+    void set() {
+        lock_guard<mutex> guard(lock);
+        done = true;
+        cond.notify_one();   // 持锁通知：等待方返回后即销毁本对象
+    }
+
+    void wait() {
+        unique_lock<mutex> guard(lock);
+        cond.wait(guard, [this] { return done; });
+    }
+};
+
+template<typename T>
+detached_task signal_when_ready(const task<T>& t, sync_wait_event& ev) {
+    co_await t.when_ready();
+    ev.set();
+}
+
+template<typename Scheduler, typename T>
+detached_task run_detached_on(Scheduler& s, task<T> t) {
+    co_await s.schedule();
+    co_await std::move(t);
+}
+
+} // namespace detail
+
+// ============================================================================
+// 启动与等待
+// ============================================================================
+
+/**
+ * @brief 在当前线程启动 t，不等待结果
+ *
+ * t 执行到第一个真正挂起的 co_await 时返回。t 抛出的异常调用 std::terminate。
+ */
+template<typename T>
+void co_spawn(task<T> t) {
+    detail::run_detached(std::move(t));
+}
+
+/**
+ * @brief 先切换到调度器（thread_pool / event_loop 等提供 schedule() 的对象）再执行 t
+ */
+template<typename Scheduler, typename T>
+void co_spawn(Scheduler& scheduler, task<T> t) {
+    detail::run_detached_on(scheduler, std::move(t));
+}
+
+/**
+ * @brief 在当前线程启动 t，结果或异常写入返回的 future（T 不能是引用）
+ */
+template<typename T>
+future<T> to_future(task<T> t) {
+    promise<T> p;
+    future<T> f = p.get_future();
+    detail::run_into_promise(std::move(t), std::move(p));
+    return f;
+}
+
+/**
+ * @brief 在当前线程启动 t 并阻塞等待结果（支持引用类型的结果）
+ *
+ * t 若需要在当前线程上运行的事件循环才能完成，会死锁。
+ */
+template<typename T>
+T sync_wait(task<T> t) {
+    if (!t.valid()) {
+        throw std::future_error(std::future_errc::no_state);
+    }
+    detail::sync_wait_event ev;
+    detail::signal_when_ready(t, ev);
+    ev.wait();
+    return std::move(t).operator co_await().await_resume();
+}
+
+} // namespace zen
+
+#endif // ZEN_HAS_COROUTINES
+
+#endif // ZEN_CORO_TASK_H
@@ -31,21 +31,43 @@
  * 
  * // 运行事件循环
  * loop.run();
+ * 
+ * // C++20：协程中等待 IO 就绪 / 定时器（见 coro/task.h）
+ * zen::task<void> echo(zen::event_loop& loop, int fd) {
+ *     char buf[4096];
+ *     for (;;) {
+ *         ssize_t n = read(fd, buf, sizeof(buf));
+ *         if (n > 0) { write(fd, buf, n); continue; }
+ *         if (n == 0 || errno != EAGAIN) break;
+ *         co_await loop.readable(fd);
+ *     }
+ *     co_await loop.sleep_for(100);
+ * }
  * @endcode
  */
 #ifndef ZEN_EVENT_EVENT_LOOP_H
 #define ZEN_EVENT_EVENT_LOOP_H
 
+#include "../base/macros.h"
 #include "../threading/sync/mutex.h"
 #include "../threading/sync/condition_variable.h"
+#include "../threading/sync/lock_guard.h"
+#include "../threading/thread/this_thread.h"
 #include "../timer/timer_manager.h"
 #include "../utility/function.h"
 #include <sys/epoll.h>
 #include <sys/eventfd.h>
 #include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <stdexcept>
 #include <vector>
 #include <map>
 
+#if ZEN_HAS_COROUTINES
+#include <coroutine>
+#endif
+
 namespace zen {
 
 // ============================================================================
@@ -69,6 +91,7 @@ public:
     using io_callback = function<void(int, uint32_t)>;
     using timer_callback = function<void()>;
     using signal_callback = function<void(int)>;
+    using task_callback = function<void()>;
 
     /**
      * @brief 构造
@@ -169,8 +192,83 @@ public:
      * @brief 从其他线程唤醒事件循环
      */
     void wakeup();
+    
+    /**
+     * @brief 投递回调，在事件循环线程上执行（线程安全）
+     */
+    void post(task_callback callback);
+    
+    /**
+     * @brief 当前线程正在运行的事件循环（不在 run() 中时为 nullptr）
+     */
+    static event_loop* current() noexcept {
+        return current_slot();
+    }
+
+#if ZEN_HAS_COROUTINES
+    // ----------------------------------------------------------------
+    // 协程等待（C++20）：须在事件循环线程上 co_await，恢复也在该线程上
+    // ----------------------------------------------------------------
+    
+    /**
+     * @brief 等待 fd 就绪
+     *
+     * co_await 的结果是实际触发的事件掩码。fd 须为非阻塞、且未被其他回调注册；
+     * 等待期间注册一次性监听，就绪后注销。注册失败时立即返回 ZEN_EVENT_ERROR。
+     */
+    struct io_awaiter {
+        event_loop* loop;
+        int         fd;
+        uint32_t    events;
+        uint32_t    revents = 0;
+        
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> h);
+        uint32_t await_resume() const noexcept { return revents; }
+    };
+    
+    /**
+     * @brief 等待定时器到期
+     */
+    struct timer_awaiter {
+        event_loop*        loop;
+        unsigned long long delay_ms;
+        
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h);
+        void await_resume() const noexcept {}
+    };
+    
+    /**
+     * @brief 切换到事件循环线程（可在任意线程 co_await）
+     */
+    struct schedule_awaiter {
+        event_loop* loop;
+        
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) {
+            loop->post([h] { h.resume(); });
+        }
+        void await_resume() const noexcept {}
+    };
+    
+    io_awaiter readable(int fd) noexcept { return io_awaiter{ this, fd, ZEN_EVENT_READ }; }
+    io_awaiter writable(int fd) noexcept { return io_awaiter{ this, fd, ZEN_EVENT_WRITE }; }
+    timer_awaiter sleep_for(unsigned long long ms) noexcept { return timer_awaiter{ this, ms }; }
+    schedule_awaiter schedule() noexcept { return schedule_awaiter{ this }; }
+#endif
 
 private:
+    static event_loop*& current_slot() noexcept {
+        static thread_local event_loop* loop = nullptr;
+        return loop;
+    }
+    
+    /**
+     * @brief 执行 post() 投递的回调
+     */
+    void run_posted();
+    
     /**
      * @brief 处理 IO 事件
      */
@@ -198,14 +296,18 @@ private:
     // 定时器管理器
     timer_manager timer_manager_;
     
-    // 定时器回调映射：timer_id -> callback
-    std::map<timer_id, timer_callback> timer_callbacks_;
+    // 定时器回调映射：timer_id -> callback（堆上分配；一次性定时器触发后释放）
+    std::map<timer_id, timer_callback*> timer_callbacks_;
+    
+    // 其他线程投递的回调
+    mutex posted_mutex_;
+    std::vector<task_callback> posted_;
     
     // 信号回调映射：signum -> callback
     std::map<int, signal_callback> signal_handlers_;
     
     // 是否停止
-    bool stopped_;
+    std::atomic<bool> stopped_;
 };
 
 // ============================================================================
@@ -227,6 +329,9 @@ inline event_loop::event_loop()
 }
 
 inline event_loop::~event_loop() {
+    for (auto& entry : timer_callbacks_) {
+        delete entry.second;
+    }
     if (wakeup_fd_ >= 0) {
         close(wakeup_fd_);
     }
@@ -236,23 +341,24 @@ inline event_loop::~event_loop() {
 }
 
 inline void event_loop::run() {
+    event_loop* outer = current_slot();
+    current_slot() = this;
     while (!stopped_) {
         // 计算下一次定时器到期时间
-        unsigned long long now = timer_manager_.time_until_next(
-            timer_manager_.pending_count() > 0 ? 0 : ~0ULL
-        );
+        unsigned long long wait_ms = timer_manager_.time_until_next(this_thread::monotonic_ms());
         
-        int timeout = static_cast<int>(now);
-        if (timeout > 10000) {
-            timeout = 10000;  // 最多等待 10 秒
-        }
+        int timeout = wait_ms > 10000 ? 10000 : static_cast<int>(wait_ms);  // 最多等待 10 秒
         
         // 处理 IO 事件
         handle_io_events(timeout);
         
         // 处理定时器事件
         handle_timer_events();
+        
+        // 处理投递的回调
+        run_posted();
     }
+    current_slot() = outer;
 }
 
 inline void event_loop::stop() {
@@ -299,38 +405,62 @@ inline bool event_loop::remove_io_event(int fd) {
 
 inline timer_id event_loop::add_timer(unsigned long long delay_ms, timer_callback callback) {
     auto wrapped_callback = [](timer_id id, void* user_data) {
-        auto* cb = static_cast<timer_callback*>(user_data);
-        if (cb) {
-            (*cb)();
+        // 一次性定时器：触发后注销并释放回调
+        auto* loop = static_cast<event_loop*>(user_data);
+        auto it = loop->timer_callbacks_.find(id);
+        if (it == loop->timer_callbacks_.end()) {
+            return;
         }
+        timer_callback* cb = it->second;
+        loop->timer_callbacks_.erase(it);
+        (*cb)();
+        delete cb;
     };
     
-    timer_id id = timer_manager_.add_once(delay_ms, wrapped_callback, new timer_callback(callback));
-    if (id != 0) {
-        timer_callbacks_[id] = std::move(callback);
+    timer_callback* cb = new timer_callback(std::move(callback));
+    timer_id id = timer_manager_.add_once(delay_ms, wrapped_callback, this);
+    if (id == 0) {
+        delete cb;
+        return 0;
     }
+    timer_callbacks_[id] = cb;
     return id;
 }
 
 inline timer_id event_loop::add_repeat_timer(unsigned long long interval_ms, timer_callback callback) {
     auto wrapped_callback = [](timer_id id, void* user_data) {
-        auto* cb = static_cast<timer_callback*>(user_data);
-        if (cb) {
-            (*cb)();
+        // 重复定时器：执行期间把回调从表中取出（置空占位），
+        // 回调内 cancel_timer 自己时只删除表项，回调返回后再释放
+        auto* loop = static_cast<event_loop*>(user_data);
+        auto it = loop->timer_callbacks_.find(id);
+        if (it == loop->timer_callbacks_.end() || !it->second) {
+            return;
+        }
+        timer_callback* cb = it->second;
+        it->second = nullptr;
+        (*cb)();
+        it = loop->timer_callbacks_.find(id);
+        if (it != loop->timer_callbacks_.end() && !it->second) {
+            it->second = cb;
+        } else {
+            delete cb;
         }
     };
     
-    timer_id id = timer_manager_.add_repeat(interval_ms, wrapped_callback, new timer_callback(callback));
-    if (id != 0) {
-        timer_callbacks_[id] = std::move(callback);
+    timer_callback* cb = new timer_callback(std::move(callback));
+    timer_id id = timer_manager_.add_repeat(interval_ms, wrapped_callback, this);
+    if (id == 0) {
+        delete cb;
+        return 0;
     }
+    timer_callbacks_[id] = cb;
     return id;
 }
 
 inline bool event_loop::cancel_timer(timer_id id) {
     auto it = timer_callbacks_.find(id);
     if (it != timer_callbacks_.end()) {
-        delete &it->second;
+        delete it->second;
         timer_callbacks_.erase(it);
     }
     return timer_manager_.cancel(id);
@@ -349,7 +479,30 @@ inline bool event_loop::remove_signal(int signum) {
 
 inline void event_loop::wakeup() {
     uint64_t value = 1;
-    write(wakeup_fd_, &value, sizeof(value));
+    ssize_t n = write(wakeup_fd_, &value, sizeof(value));
+    (void)n;  // 计数器已满（EAGAIN）时循环同样会被唤醒
+}
+
+inline void event_loop::post(task_callback callback) {
+    {
+        lock_guard<mutex> lock(posted_mutex_);
+        posted_.push_back(std::move(callback));
+    }
+    wakeup();
+}
+
+inline void event_loop::run_posted() {
+    std::vector<task_callback> batch;
+    {
+        lock_guard<mutex> lock(posted_mutex_);
+        if (posted_.empty()) {
+            return;
+        }
+        batch.swap(posted_);
+    }
+    for (auto& cb : batch) {
+        cb();
+    }
 }
 
 inline void event_loop::handle_io_events(int timeout_ms) {
@@ -375,10 +528,15 @@ inline void event_loop::handle_io_events(int timeout_ms) {
             continue;
         }
         
-        // 处理 IO 事件
+        // 处理 IO 事件：回调可能注销或替换自己的注册，先把回调移出来再调用
         auto it = io_handlers_.find(fd);
         if (it != io_handlers_.end()) {
-            it->second(fd, revents);
+            io_callback cb = std::move(it->second);
+            cb(fd, revents);
+            auto again = io_handlers_.find(fd);
+            if (again != io_handlers_.end() && !again->second) {
+                again->second = std::move(cb);
+            }
         }
     }
 }
@@ -387,6 +545,29 @@ inline void event_loop::handle_timer_events() {
     timer_manager_.tick();
 }
 
+#if ZEN_HAS_COROUTINES
+
+inline bool event_loop::io_awaiter::await_suspend(std::coroutine_handle<> h) {
+    auto on_ready = [this, h](int ready_fd, uint32_t ready_events) {
+        loop->remove_io_event(ready_fd);
+        revents = ready_events;
+        h.resume();
+    };
+    if (loop->add_io_event(fd, events, on_ready)) {
+        return true;
+    }
+    revents = ZEN_EVENT_ERROR;
+    return false;
+}
+
+inline void event_loop::timer_awaiter::await_suspend(std::coroutine_handle<> h) {
+    if (loop->add_timer(delay_ms, [h] { h.resume(); }) == 0) {
+        throw std::runtime_error("event_loop: add_timer failed");
+    }
+}
+
+#endif
+
 inline bool event_loop::create_wakeup_fd() {
     wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
     if (wakeup_fd_ < 0) {
@@ -239,6 +239,64 @@ distance(InputIt first, InputIt last) {
         typename iterator_traits<InputIt>::iterator_category{});
 }
 
+namespace detail {
+
+// 支持 last - first（指针、标准库随机访问迭代器等）
+template<typename It, typename = void>
+struct has_iterator_difference {
+    static constexpr bool value = false;
+};
+
+template<typename It>
+struct has_iterator_difference<It, decltype(static_cast<void>(*static_cast<It*>(nullptr) - *static_cast<It*>(nullptr)))> {
+    static constexpr bool value = true;
+};
+
+// 类别标签派生自 zen::forward_iterator_tag
+template<typename It, typename = void>
+struct has_forward_category {
+    static constexpr bool value = false;
+};
+
+template<typename It>
+struct has_forward_category<It, decltype(static_cast<void>(sizeof(typename It::iterator_category)))> {
+private:
+    static char test(const forward_iterator_tag*);
+    static long test(...);
+
+public:
+    static constexpr bool value =
+        sizeof(test(static_cast<typename It::iterator_category*>(nullptr))) == sizeof(char);
+};
+
+} // namespace detail
+
+/**
+ * @brief [first, last) 能否多趟遍历（从而在插入前先求出长度、一次性预留容量）
+ *
+ * 指针、zen 的前向及以上迭代器、支持 last - first 的迭代器为 true；
+ * 其余按单趟输入迭代器处理。
+ */
+template<typename It>
+struct is_multipass_iterator {
+    static constexpr bool value =
+        detail::has_iterator_difference<It>::value || detail::has_forward_category<It>::value;
+};
+
+/**
+ * @brief 多趟迭代器区间的长度（is_multipass_iterator<It>::value 为 true 时使用）
+ */
+template<typename It>
+decltype(sizeof(0)) range_length(It first, It last) {
+    if constexpr (detail::has_iterator_difference<It>::value) {
+        return static_cast<decltype(sizeof(0))>(last - first);
+    } else {
+        decltype(sizeof(0)) n = 0;
+        for (; first != last; ++first) ++n;
+        return n;
+    }
+}
+
 /**
  * @brief 返回 it 后移 n 步的迭代器（不修改 it 本身）
  */
@@ -9,10 +9,61 @@
 #define ZEN_MATH_NUMERIC_STATS_H
 
 #include "basic_math.h"
+#include "../algorithms/numeric_simd.h"
+#include "stream_stats.h"
 #include <cstddef>
+#include <type_traits>
 
 namespace zen {
 
+// float / double 的数组与连续容器（提供 data() / size()）走 numeric_simd.h 的向量内核：
+// 求和为多累加器（结果可能与逐个累加相差若干 ulp），方差为分块 Welford 一次读入；
+// 其他元素类型保持标量实现。
+// 无界数据流与多线程分别统计再合并的场景见 stream_stats.h 的累加器。
+
+namespace detail {
+
+template<typename T>
+constexpr bool stats_simd_element = std::is_same<T, float>::value || std::is_same<T, double>::value;
+
+template<typename Container, typename = void>
+struct stats_contiguous : std::false_type {};
+
+template<typename Container>
+struct stats_contiguous<Container, std::void_t<decltype(std::declval<const Container&>().data()),
+                                               decltype(std::declval<const Container&>().size())>>
+    : std::true_type {};
+
+/** 可走向量内核的容器：连续存储且元素为 float / double */
+template<typename Container>
+constexpr bool stats_simd_container =
+    stats_contiguous<Container>::value && stats_simd_element<typename Container::value_type>;
+
+/** 一次读入统计 count / mean / m2 */
+template<typename T>
+moments stats_moments(const T* p, size_t n) {
+    if constexpr (stats_simd_element<T>) {
+        return compute_moments(p, n);
+    } else {
+        moments m;
+        for (size_t i = 0; i < n; ++i) m.add(static_cast<double>(p[i]));
+        return m;
+    }
+}
+
+template<typename Container>
+moments stats_moments(const Container& c) {
+    if constexpr (stats_contiguous<Container>::value) {
+        return stats_moments(c.data(), static_cast<size_t>(c.size()));
+    } else {
+        moments m;
+        for (const auto& elem : c) m.add(static_cast<double>(elem));
+        return m;
+    }
+}
+
+} // namespace detail
+
 // ==================== 统计工具函数 ====================
 
 /**
@@ -25,11 +76,15 @@ namespace zen {
  */
 template<typename T, size_t N>
 T sum(const T (&arr)[N]) {
-    T result = 0;
-    for (size_t i = 0; i < N; ++i) {
-        result += arr[i];
+    if constexpr (detail::stats_simd_element<T>) {
+        return sum(static_cast<const T*>(arr), N);
+    } else {
+        T result = 0;
+        for (size_t i = 0; i < N; ++i) {
+            result += arr[i];
+        }
+        return result;
     }
-    return result;
 }
 
 /**
@@ -38,11 +93,15 @@ T sum(const T (&arr)[N]) {
 template<typename Container>
 auto sum(const Container& c) -> typename Container::value_type {
     using T = typename Container::value_type;
-    T result = 0;
-    for (const auto& elem : c) {
-        result += elem;
+    if constexpr (detail::stats_simd_container<Container>) {
+        return sum(c.data(), static_cast<size_t>(c.size()));
+    } else {
+        T result = 0;
+        for (const auto& elem : c) {
+            result += elem;
+        }
+        return result;
     }
-    return result;
 }
 
 /**
@@ -114,23 +173,18 @@ double harmonic_mean(const T (&arr)[N]) {
  * 
  * 公式：var = sum((xi - mean)^2) / (n - 1)
  * 
- * 使用 Welfold 算法避免数值不稳定：
- * var = var + (xi - mean_n) * (xi - mean_n+1)
- * 其中 mean_n 是前 n 个数的均值
+ * 一次读入：Welford 算法逐点更新均值与离差平方和，避免 sum(x^2) - sum(x)^2 / n 的大数相消：
+ * m2 = m2 + (xi - mean_n) * (xi - mean_n+1)
+ * 其中 mean_n 是前 n 个数的均值。float / double 按块向量化后以 Chan 公式合并各块。
  */
 template<typename T, size_t N>
 double variance(const T (&arr)[N]) {
-    if (N <= 1) return 0.0;
-    
-    double mean_val = mean(arr);
-    double sum_sq_diff = 0.0;
-    
-    for (size_t i = 0; i < N; ++i) {
-        double diff = static_cast<double>(arr[i]) - mean_val;
-        sum_sq_diff += diff * diff;
-    }
-    
-    return sum_sq_diff / (N - 1);  // 样本方差
+    return detail::stats_moments(static_cast<const T*>(arr), N).variance();  // 样本方差
+}
+
+template<typename Container>
+double variance(const Container& c) {
+    return detail::stats_moments(c).variance();
 }
 
 /**
@@ -140,17 +194,12 @@ double variance(const T (&arr)[N]) {
  */
 template<typename T, size_t N>
 double population_variance(const T (&arr)[N]) {
-    if (N == 0) return 0.0;
-    
-    double mean_val = mean(arr);
-    double sum_sq_diff = 0.0;
-    
-    for (size_t i = 0; i < N; ++i) {
-        double diff = static_cast<double>(arr[i]) - mean_val;
-        sum_sq_diff += diff * diff;
-    }
-    
-    return sum_sq_diff / N;
+    return detail::stats_moments(static_cast<const T*>(arr), N).population_variance();
+}
+
+template<typename Container>
+double population_variance(const Container& c) {
+    return detail::stats_moments(c).population_variance();
 }
 
 /**
@@ -161,6 +210,11 @@ double stddev(const T (&arr)[N]) {
     return sqrt(variance(arr));
 }
 
+template<typename Container>
+double stddev(const Container& c) {
+    return sqrt(variance(c));
+}
+
 /**
  * @brief 计算总体标准差
  */
@@ -169,6 +223,11 @@ double population_stddev(const T (&arr)[N]) {
     return sqrt(population_variance(arr));
 }
 
+template<typename Container>
+double population_stddev(const Container& c) {
+    return sqrt(population_variance(c));
+}
+
 /**
  * @brief 计算变异系数（CV）
  * 
@@ -185,10 +244,15 @@ double coefficient_of_variation(const T (&arr)[N]) {
 
 /**
  * @brief 找到最小值
+ *
+ * float / double 走向量内核，NaN 被忽略（全为 NaN 时返回 +inf）。
  */
 template<typename T, size_t N>
 T min_value(const T (&arr)[N]) {
     if (N == 0) return T();
+    if constexpr (detail::stats_simd_element<T>) {
+        return minmax_value(static_cast<const T*>(arr), N).lo;
+    }
     
     T min_val = arr[0];
     for (size_t i = 1; i < N; ++i) {
@@ -199,10 +263,15 @@ T min_value(const T (&arr)[N]) {
 
 /**
  * @brief 找到最大值
+ *
+ * float / double 走向量内核，NaN 被忽略（全为 NaN 时返回 -inf）。
  */
 template<typename T, size_t N>
 T max_value(const T (&arr)[N]) {
     if (N == 0) return T();
+    if constexpr (detail::stats_simd_element<T>) {
+        return minmax_value(static_cast<const T*>(arr), N).hi;
+    }
     
     T max_val = arr[0];
     for (size_t i = 1; i < N; ++i) {
@@ -217,6 +286,12 @@ T max_value(const T (&arr)[N]) {
 template<typename T, size_t N>
 void minmax_value(const T (&arr)[N], T& min_val, T& max_val) {
     if (N == 0) return;
+    if constexpr (detail::stats_simd_element<T>) {
+        auto r = minmax_value(static_cast<const T*>(arr), N);
+        min_val = r.lo;
+        max_val = r.hi;
+        return;
+    }
     
     min_val = max_val = arr[0];
     for (size_t i = 1; i < N; ++i) {
@@ -0,0 +1,563 @@
+/**
+ * @file stream_stats.h
+ * @brief 流式 / 可合并的统计累加器
+ *
+ * numeric_stats.h 的函数一次处理整个数组；这里的累加器面向无界数据流与多线程：
+ * 每个对象只保存固定（或对数级）大小的摘要，add() 为 O(1)（KLL 为摊还 O(1)），
+ * merge() 把另一个同类累加器并入自身。
+ *
+ * 典型用法：每个线程持有自己的累加器（不加锁），结束时依次 merge 到一个里。
+ * 累加器本身不是线程安全的，同一对象不要被多个线程同时修改。
+ *
+ * - welford_accumulator : 计数 / 均值 / 方差（Welford 更新、Chan 合并），数值稳定
+ * - minmax_accumulator  : 最小值 / 最大值（浮点忽略 NaN）
+ * - kll_sketch          : KLL 分位数草图，秩误差约 1.7 / k，空间 O(k + log(n / k))
+ * - hyperloglog         : 去重计数，2^P 个 6 位寄存器（按字节存放），相对误差约 1.04 / sqrt(2^P)
+ * - ewma                : 按样本衰减的指数加权平均（带偏差修正）
+ * - decaying_average    : 按时间半衰期衰减的加权平均与事件速率，可乱序到达
+ *
+ * 浮点数组的批量 add(p, n) 走 numeric_simd.h 的向量内核。
+ */
+
+#ifndef ZEN_MATH_STREAM_STATS_H
+#define ZEN_MATH_STREAM_STATS_H
+
+#include "../algorithms/numeric_simd.h"
+#include "../utility/hash.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zen {
+
+// ==================== 均值与方差 ====================
+
+/**
+ * @brief Welford 均值 / 方差累加器
+ *
+ * 内部保存 zen::moments（count、mean、m2）。逐个 add 为 Welford 更新，
+ * merge 为 Chan 的并行合并公式；两者都不会出现 Σx² - (Σx)²/n 的大数相消。
+ */
+class welford_accumulator {
+public:
+    void add(double x) { m_.add(x); }
+
+    /** 批量加入：float / double 先用向量内核求块内矩，再合并 */
+    template<typename T>
+    void add(const T* p, size_t n) {
+        if constexpr (std::is_same<T, double>::value || std::is_same<T, float>::value) {
+            m_.merge(compute_moments(p, n));
+        } else {
+            for (size_t i = 0; i < n; ++i) m_.add(static_cast<double>(p[i]));
+        }
+    }
+
+    void merge(const welford_accumulator& other) { m_.merge(other.m_); }
+
+    void clear() { m_ = moments(); }
+
+    size_t count() const { return m_.count; }
+    bool empty() const { return m_.count == 0; }
+    double mean() const { return m_.mean; }
+    double sum() const { return m_.mean * static_cast<double>(m_.count); }
+
+    /** 样本方差（除以 n - 1），n < 2 时为 0 */
+    double variance() const { return m_.variance(); }
+    /** 总体方差（除以 n） */
+    double population_variance() const { return m_.population_variance(); }
+    double stddev() const { return std::sqrt(variance()); }
+    double population_stddev() const { return std::sqrt(population_variance()); }
+
+    const moments& raw() const { return m_; }
+
+private:
+    moments m_;
+};
+
+// ==================== 最小值 / 最大值 ====================
+
+/**
+ * @brief 最小值 / 最大值累加器
+ * @tparam T 元素类型（需支持 <）
+ *
+ * 浮点类型忽略 NaN：count() 为加入过的样本总数（含 NaN），min() / max() 只看非 NaN 值；
+ * empty() 表示还没有有效值，此时 min() / max() 无意义。
+ */
+template<typename T>
+class minmax_accumulator {
+public:
+    void add(const T& x) {
+        ++count_;
+        if constexpr (std::is_floating_point<T>::value) {
+            if (x != x) return;
+        }
+        update(x, x);
+    }
+
+    /** 批量加入：float / double 走向量内核 */
+    void add(const T* p, size_t n) {
+        if constexpr (std::is_same<T, double>::value || std::is_same<T, float>::value) {
+            count_ += n;
+            if (n == 0) return;
+            minmax_result<T> r = minmax_value(p, n);
+            if (!(r.hi < r.lo)) update(r.lo, r.hi);  // lo > hi 表示全部为 NaN
+        } else {
+            for (size_t i = 0; i < n; ++i) add(p[i]);
+        }
+    }
+
+    void merge(const minmax_accumulator& other) {
+        count_ += other.count_;
+        if (other.valid_) update(other.lo_, other.hi_);
+    }
+
+    void clear() {
+        count_ = 0;
+        valid_ = false;
+    }
+
+    size_t count() const { return count_; }
+    bool empty() const { return !valid_; }
+    const T& min() const { return lo_; }
+    const T& max() const { return hi_; }
+
+private:
+    void update(const T& lo, const T& hi) {
+        if (!valid_) {
+            lo_ = lo;
+            hi_ = hi;
+            valid_ = true;
+            return;
+        }
+        if (lo < lo_) lo_ = lo;
+        if (hi_ < hi) hi_ = hi;
+    }
+
+    T lo_{};
+    T hi_{};
+    size_t count_ = 0;
+    bool valid_ = false;
+};
+
+// ==================== 分位数草图（KLL） ====================
+
+/**
+ * @brief KLL 分位数草图（Karnin, Lang, Liberty 2016）
+ * @tparam T 元素类型（需支持 < 与复制）
+ *
+ * 若干层"压缩器"，第 h 层的每个元素代表 2^h 个原始样本。某层装满时排序，
+ * 随机取奇数位或偶数位的一半升到上一层，另一半丢弃；每次压缩对任意秩
+ * 引入的误差期望为 0。层容量自顶向下按 2/3 递减（最低为 2），
+ * 因此总空间约 3k + O(log(n / k))。
+ *
+ * - add：摊还 O(1)（第 0 层追加，偶尔压缩）
+ * - merge：逐层拼接后压缩到容量以内，合并结果与对拼接流直接建草图同分布
+ * - quantile / rank：O(k log k)（收集所有保留元素按值排序）
+ *
+ * 最小值与最大值精确保存：quantile(0) / quantile(1) 总是精确的。
+ */
+template<typename T>
+class kll_sketch {
+public:
+    explicit kll_sketch(size_t k = 200, uint64_t seed = 0x9e3779b97f4a7c15ULL)
+        : k_(k < 8 ? 8 : k), rng_(seed ? seed : 1), levels_(1) {
+        update_limit();
+    }
+
+    void add(const T& x) {
+        if constexpr (std::is_floating_point<T>::value) {
+            if (x != x) return;
+        }
+        if (n_ == 0) {
+            lo_ = x;
+            hi_ = x;
+        } else {
+            if (x < lo_) lo_ = x;
+            if (hi_ < x) hi_ = x;
+        }
+        ++n_;
+        levels_[0].push_back(x);
+        if (++retained_ >= limit_) compress();
+    }
+
+    void merge(const kll_sketch& other) {
+        if (other.n_ == 0) return;
+        if (&other == this) {
+            // 自身合并：边读边往同一个 vector 里插入是未定义行为，先拷贝一份
+            kll_sketch copy(other);
+            merge(copy);
+            return;
+        }
+        if (n_ == 0) {
+            lo_ = other.lo_;
+            hi_ = other.hi_;
+        } else {
+            if (other.lo_ < lo_) lo_ = other.lo_;
+            if (hi_ < other.hi_) hi_ = other.hi_;
+        }
+        n_ += other.n_;
+        if (levels_.size() < other.levels_.size()) {
+            levels_.resize(other.levels_.size());
+            update_limit();
+        }
+        for (size_t h = 0; h < other.levels_.size(); ++h) {
+            std::vector<T>& dst = levels_[h];
+            const std::vector<T>& src = other.levels_[h];
+            size_t mid = dst.size();
+            dst.insert(dst.end(), src.begin(), src.end());
+            // 第 0 层无序；其余层保持有序，拼接后归并
+            if (h > 0) std::inplace_merge(dst.begin(), dst.begin() + mid, dst.end());
+            retained_ += src.size();
+        }
+        while (retained_ >= limit_) compress();
+    }
+
+    void clear() {
+        levels_.assign(1, std::vector<T>());
+        n_ = 0;
+        retained_ = 0;
+        update_limit();
+    }
+
+    /** 已加入的样本总数（精确） */
+    size_t count() const { return n_; }
+    bool empty() const { return n_ == 0; }
+    /** 当前保留的元素个数 */
+    size_t retained() const { return retained_; }
+    size_t k() const { return k_; }
+
+    const T& min() const { return lo_; }
+    const T& max() const { return hi_; }
+
+    /**
+     * @brief 近似分位数
+     * @param q 0..1；返回使累计权重首次达到 q * n 的保留元素
+     */
+    T quantile(double q) const {
+        if (n_ == 0) return T();
+        if (q <= 0) return lo_;
+        if (q >= 1) return hi_;
+        std::vector<weighted> items = sorted_items();
+        double target = q * static_cast<double>(n_);
+        uint64_t cum = 0;
+        for (const weighted& w : items) {
+            cum += w.second;
+            if (static_cast<double>(cum) >= target) return w.first;
+        }
+        return hi_;
+    }
+
+    /** 一次排序求多个分位数（qs 需升序） */
+    std::vector<T> quantiles(const std::vector<double>& qs) const {
+        std::vector<T> out;
+        out.reserve(qs.size());
+        if (n_ == 0) {
+            out.resize(qs.size());
+            return out;
+        }
+        std::vector<weighted> items = sorted_items();
+        size_t idx = 0;
+        uint64_t cum = 0;
+        for (double q : qs) {
+            if (q <= 0) {
+                out.push_back(lo_);
+            } else if (q >= 1) {
+                out.push_back(hi_);
+            } else {
+                double target = q * static_cast<double>(n_);
+                while (idx < items.size() && static_cast<double>(cum) < target) cum += items[idx++].second;
+                out.push_back(items[idx - 1].first);
+            }
+        }
+        return out;
+    }
+
+    /** 近似归一化秩：<= x 的样本比例 */
+    double rank(const T& x) const {
+        if (n_ == 0) return 0.0;
+        uint64_t below = 0;
+        for (size_t h = 0; h < levels_.size(); ++h) {
+            for (const T& v : levels_[h]) {
+                if (!(x < v)) below += uint64_t(1) << h;
+            }
+        }
+        return static_cast<double>(below) / static_cast<double>(n_);
+    }
+
+private:
+    // (值, 权重)；用 std::pair 让排序中的 swap 走 std 版本（basic_math.h 的 zen::swap 不受约束）
+    using weighted = std::pair<T, uint64_t>;
+
+    // 第 h 层容量：k * (2/3)^(层数 - 1 - h)，最低为 2
+    size_t level_capacity(size_t h) const {
+        size_t depth = levels_.size() - 1 - h;
+        double c = static_cast<double>(k_);
+        for (size_t i = 0; i < depth && c >= 2.0; ++i) c *= 2.0 / 3.0;
+        size_t cap = static_cast<size_t>(c);
+        return cap < 2 ? 2 : cap;
+    }
+
+    // 各层容量之和，只在层数变化时重新计算
+    void update_limit() {
+        limit_ = 0;
+        for (size_t h = 0; h < levels_.size(); ++h) limit_ += level_capacity(h);
+    }
+
+    bool random_bit() {
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 7;
+        rng_ ^= rng_ << 17;
+        return (rng_ >> 32) & 1;
+    }
+
+    // 压缩最低一个超出容量的层，把一半元素升到上一层
+    void compress() {
+        for (size_t h = 0; h < levels_.size(); ++h) {
+            if (levels_[h].size() < level_capacity(h)) continue;
+            if (h + 1 == levels_.size()) {
+                levels_.emplace_back();
+                update_limit();
+            }
+            std::vector<T>& cur = levels_[h];
+            if (h == 0) std::sort(cur.begin(), cur.end());
+            // 奇数个时留下第一个元素，其余成对压缩
+            size_t keep = cur.size() & 1;
+            size_t offset = keep + (random_bit() ? 1 : 0);
+            // 被选中的一半原地前移到 [keep, keep + m)，再整体追加到上一层并归并
+            size_t m = keep;
+            for (size_t i = offset; i < cur.size(); i += 2) cur[m++] = cur[i];
+            m -= keep;
+            std::vector<T>& up = levels_[h + 1];
+            size_t mid = up.size();
+            up.insert(up.end(), cur.begin() + keep, cur.begin() + keep + m);
+            std::inplace_merge(up.begin(), up.begin() + mid, up.end());
+            retained_ -= cur.size() - keep - m;
+            cur.resize(keep);
+            return;
+        }
+    }
+
+    std::vector<weighted> sorted_items() const {
+        std::vector<weighted> items;
+        items.reserve(retained_);
+        for (size_t h = 0; h < levels_.size(); ++h) {
+            for (const T& v : levels_[h]) items.emplace_back(v, uint64_t(1) << h);
+        }
+        std::sort(items.begin(), items.end(),
+                  [](const weighted& a, const weighted& b) { return a.first < b.first; });
+        return items;
+    }
+
+    size_t k_;
+    uint64_t rng_;
+    std::vector<std::vector<T>> levels_;
+    size_t n_ = 0;
+    size_t retained_ = 0;
+    size_t limit_ = 0;
+    T lo_{};
+    T hi_{};
+};
+
+// ==================== 去重计数（HyperLogLog） ====================
+
+/**
+ * @brief HyperLogLog 去重计数
+ * @tparam Precision 寄存器个数为 2^Precision（4..18），默认 12：4 KB，误差约 1.6%
+ *
+ * 64 位哈希的高 Precision 位选寄存器，其余位的前导零个数 + 1 取最大值。
+ * 估计值使用 Flajolet 等的调和平均公式，小基数时改用线性计数；
+ * 64 位哈希下无需大基数修正。merge 为逐寄存器取最大值，
+ * 与对两个流的并集直接计数的结果完全相同。
+ */
+template<unsigned Precision = 12>
+class hyperloglog {
+    static_assert(Precision >= 4 && Precision <= 18, "hyperloglog: Precision must be in [4, 18]");
+
+public:
+    static constexpr size_t register_count = size_t(1) << Precision;
+
+    hyperloglog() { clear(); }
+
+    /** 加入一个值：先用 zen::hash 求哈希，再做一次 64 位混合 */
+    template<typename T>
+    void add(const T& value) {
+        add_hash(hash_mix(static_cast<uint64_t>(hash<T>{}(value))));
+    }
+
+    /** 直接加入一个已充分混合的 64 位哈希 */
+    void add_hash(uint64_t h) {
+        size_t idx = static_cast<size_t>(h >> (64 - Precision));
+        // 低位补一个 1，保证 clz 有定义且 rank 不超过 64 - Precision + 1
+        uint64_t w = (h << Precision) | (uint64_t(1) << (Precision - 1));
+        uint8_t rank = static_cast<uint8_t>(__builtin_clzll(w) + 1);
+        if (rank > registers_[idx]) registers_[idx] = rank;
+    }
+
+    void merge(const hyperloglog& other) {
+        for (size_t i = 0; i < register_count; ++i) {
+            if (other.registers_[i] > registers_[i]) registers_[i] = other.registers_[i];
+        }
+    }
+
+    void clear() { memset(registers_, 0, sizeof(registers_)); }
+
+    /** 估计的不同元素个数 */
+    double estimate() const {
+        const double m = static_cast<double>(register_count);
+        double inv_sum = 0;
+        size_t zeros = 0;
+        for (size_t i = 0; i < register_count; ++i) {
+            inv_sum += std::ldexp(1.0, -static_cast<int>(registers_[i]));
+            zeros += registers_[i] == 0;
+        }
+        double e = alpha() * m * m / inv_sum;
+        if (e <= 2.5 * m && zeros != 0) e = m * std::log(m / static_cast<double>(zeros));
+        return e;
+    }
+
+    /** 理论相对标准误差 */
+    static double relative_error() { return 1.04 / std::sqrt(static_cast<double>(register_count)); }
+
+private:
+    static double alpha() {
+        switch (Precision) {
+            case 4: return 0.673;
+            case 5: return 0.697;
+            case 6: return 0.709;
+            default: return 0.7213 / (1.0 + 1.079 / static_cast<double>(register_count));
+        }
+    }
+
+    uint8_t registers_[register_count];
+};
+
+// ==================== 指数加权平均 ====================
+
+/**
+ * @brief 按样本衰减的指数加权移动平均
+ *
+ * 第 i 个较早的样本权重为 (1 - alpha)^i。同时维护加权和 S 与权重和 W，
+ * value() = S / W：前几个样本不会被初始值 0 拉低（即带偏差修正的 EWMA）。
+ * merge 把两个累加器的 S、W 分别相加（两条流各自按自己的样本数衰减），
+ * 要求 alpha 相同。
+ */
+class ewma {
+public:
+    explicit ewma(double alpha = 0.1) : decay_(1.0 - alpha) {}
+
+    void add(double x) {
+        sum_ = sum_ * decay_ + x;
+        weight_ = weight_ * decay_ + 1.0;
+    }
+
+    void merge(const ewma& other) {
+        sum_ += other.sum_;
+        weight_ += other.weight_;
+    }
+
+    void clear() {
+        sum_ = 0;
+        weight_ = 0;
+    }
+
+    bool empty() const { return weight_ == 0; }
+    double value() const { return weight_ > 0 ? sum_ / weight_ : 0.0; }
+    double alpha() const { return 1.0 - decay_; }
+
+private:
+    double decay_;
+    double sum_ = 0;
+    double weight_ = 0;
+};
+
+/**
+ * @brief 按时间衰减的加权平均与事件速率
+ *
+ * 时刻 t 的样本在时刻 now 的权重为 2^(-(now - t) / half_life)。内部把 S、W
+ * 换算到已见过的最晚时刻保存，较早时刻到达的样本按其年龄折算权重，
+ * 因此样本可以乱序到达；两个累加器换算到同一时刻后即可相加合并。
+ * 时间单位由调用方决定（秒、纳秒……），与 half_life 一致即可。
+ */
+class decaying_average {
+public:
+    explicit decaying_average(double half_life) : inv_half_life_(1.0 / half_life) {}
+
+    void add(double x, double t) {
+        if (weight_ == 0 || t >= last_) {
+            rescale(t);
+            sum_ += x;
+            weight_ += 1.0;
+        } else {
+            double w = std::exp2((t - last_) * inv_half_life_);
+            sum_ += w * x;
+            weight_ += w;
+        }
+    }
+
+    void merge(const decaying_average& other) {
+        if (other.weight_ == 0) return;
+        if (weight_ == 0) {
+            sum_ = other.sum_;
+            weight_ = other.weight_;
+            last_ = other.last_;
+            return;
+        }
+        double s = other.sum_, w = other.weight_;
+        if (other.last_ > last_) {
+            rescale(other.last_);
+        } else {
+            double d = std::exp2((other.last_ - last_) * inv_half_life_);
+            s *= d;
+            w *= d;
+        }
+        sum_ += s;
+        weight_ += w;
+    }
+
+    void clear() {
+        sum_ = 0;
+        weight_ = 0;
+        last_ = 0;
+    }
+
+    bool empty() const { return weight_ == 0; }
+
+    /** 加权平均值（与查询时刻无关：所有权重同比例衰减） */
+    double value() const { return weight_ > 0 ? sum_ / weight_ : 0.0; }
+
+    /** 时刻 now 的衰减后样本数 */
+    double weight(double now) const {
+        if (weight_ == 0) return 0.0;
+        return now > last_ ? weight_ * std::exp2((last_ - now) * inv_half_life_) : weight_;
+    }
+
+    /** 时刻 now 的事件速率估计（每时间单位的样本数） */
+    double rate(double now) const { return weight(now) * 0.6931471805599453 * inv_half_life_; }
+
+    double last_time() const { return last_; }
+
+private:
+    void rescale(double t) {
+        if (weight_ != 0 && t > last_) {
+            double d = std::exp2((last_ - t) * inv_half_life_);
+            sum_ *= d;
+            weight_ *= d;
+        }
+        last_ = t;
+    }
+
+    double inv_half_life_;
+    double sum_ = 0;
+    double weight_ = 0;
+    double last_ = 0;
+};
+
+} // namespace zen
+
+#endif // ZEN_MATH_STREAM_STATS_H
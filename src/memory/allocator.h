@@ -5,6 +5,16 @@
 // placement new (::new(void*)) 需要 <new> 头文件
 #include <new>
 
+// 构建时定义 ZEN_ALLOCATOR_THREAD_CACHE=1（CMake: -DZEN_THREAD_CACHING_ALLOCATOR=ON）
+// 时，allocator<T> 改用线程缓存分配器
+#ifndef ZEN_ALLOCATOR_THREAD_CACHE
+#define ZEN_ALLOCATOR_THREAD_CACHE 0
+#endif
+
+#if ZEN_ALLOCATOR_THREAD_CACHE
+#include "thread_cache.h"
+#endif
+
 namespace zen {
 
 // ============================================================================
@@ -17,6 +27,8 @@ namespace zen {
  *
  * 封装 ::operator new / ::operator delete，提供标准的分配器接口。
  * 与容器配合使用，可以替换成自定义策略（如内存池）。
+ * ZEN_ALLOCATOR_THREAD_CACHE 开启时改用 tc_malloc / tc_free_sized
+ * （对齐要求超过 16 字节的类型仍走 operator new）。
  *
  * 核心职责：
  * - allocate:   分配 n 个 T 的原始内存（不构造对象）
@@ -71,6 +83,9 @@ public:
      * 抛出 std::bad_alloc（由 operator new 触发）。
      */
     pointer allocate(size_type n) {
+#if ZEN_ALLOCATOR_THREAD_CACHE
+        if (alignof(T) <= TC_MIN_ALIGN) return static_cast<pointer>(tc_malloc(n * sizeof(T)));
+#endif
         // ::operator new 分配字节，返回 void*，强制转换为 T*
         return static_cast<pointer>(::operator new(n * sizeof(T)));
     }
@@ -78,11 +93,18 @@ public:
     /**
      * @brief 释放由 allocate 分配的内存
      * @param p 要释放的指针
-     * @param n 对象个数（与分配时一致，但此处不使用）
+     * @param n 对象个数（与分配时一致；线程缓存后端据此直接定位大小级别）
      *
      * 仅释放内存，不调用析构函数。
      */
-    void deallocate(pointer p, size_type /*n*/) noexcept {
+    void deallocate(pointer p, size_type n) noexcept {
+#if ZEN_ALLOCATOR_THREAD_CACHE
+        if (alignof(T) <= TC_MIN_ALIGN) {
+            tc_free_sized(p, n * sizeof(T));
+            return;
+        }
+#endif
+        (void)n;
         ::operator delete(p);
     }
 
@@ -0,0 +1,197 @@
+#ifndef ZEN_MEMORY_ARENA_H
+#define ZEN_MEMORY_ARENA_H
+
+#include "memory_resource.h"
+#include <cstdint>  // uintptr_t
+
+namespace zen {
+
+// ============================================================================
+// monotonic_arena - 单调增长的 bump-pointer 分配器
+// ============================================================================
+
+/**
+ * @brief 链式内存块上的 bump-pointer 分配器
+ *
+ * 分配：当前块内按对齐向后推进指针，O(1)；块用尽时向上游申请新块，
+ *       新块大小按 2 倍增长直到 16 MiB（超大请求单独开块）。
+ * 释放：deallocate 基本是空操作——只有释放的恰好是最后一次分配时才回退指针
+ *       （vector 扩容时旧缓冲常常就是最近一次分配）。
+ * reset()：把指针拨回第一块，已申请的块全部保留复用，O(1)。
+ * release()：把所有块还给上游。
+ *
+ * 典型用法是请求级生命周期：处理请求期间所有容器都从同一个 arena 分配，
+ * 请求结束时 reset() 一次性回收，不逐个析构、不逐个 free。
+ *
+ * @code
+ * zen::monotonic_arena arena(64 * 1024);
+ * zen::vector<int, zen::arena_allocator<int>> v{zen::arena_allocator<int>(&arena)};
+ * ...
+ * arena.reset();   // 前提：v 已析构或不再使用
+ * @endcode
+ *
+ * 不是线程安全的。
+ */
+class monotonic_arena : public memory_resource {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 4096;
+    static constexpr size_t MAX_BLOCK_SIZE     = 16u << 20;   ///< 块大小翻倍的上限
+
+private:
+    struct block {
+        block* next;
+        size_t size;        ///< 整块字节数（含块头）
+        bool   owned;       ///< false：用户提供的初始缓冲区，不还给上游
+    };
+
+    static constexpr size_t HEADER = (sizeof(block) + DEFAULT_ALIGN - 1) & ~(DEFAULT_ALIGN - 1);
+
+    memory_resource* upstream_;
+    block*           head_;         ///< 第一块
+    block*           cur_block_;    ///< 正在切分的块
+    char*            cur_;          ///< 下一次分配的起点
+    char*            end_;          ///< 当前块末尾
+    size_t           next_size_;    ///< 下一次向上游申请的块大小
+    size_t           allocated_;    ///< 自上次 reset 以来分配出去的字节数
+    size_t           reserved_;     ///< 从上游申请的总字节数
+
+    static char* align_up(char* p, size_t align) noexcept {
+        uintptr_t v = reinterpret_cast<uintptr_t>(p);
+        return reinterpret_cast<char*>((v + align - 1) & ~(static_cast<uintptr_t>(align) - 1));
+    }
+
+    void enter(block* b) noexcept {
+        cur_block_ = b;
+        cur_ = reinterpret_cast<char*>(b) + HEADER;
+        end_ = reinterpret_cast<char*>(b) + b->size;
+    }
+
+    /** 当前块放不下时：优先复用 reset 前留下的后续块，否则向上游申请 */
+    void* allocate_slow(size_t bytes, size_t align) {
+        size_t need = bytes + align + HEADER;
+        while (cur_block_ && cur_block_->next) {
+            enter(cur_block_->next);
+            char* p = align_up(cur_, align);
+            if (p + bytes <= end_) {
+                cur_ = p + bytes;
+                return p;
+            }
+        }
+
+        size_t size = next_size_;
+        if (size < need) size = need;
+        else if (next_size_ < MAX_BLOCK_SIZE) next_size_ *= 2;
+
+        block* b = static_cast<block*>(upstream_->allocate(size, DEFAULT_ALIGN));
+        b->next  = nullptr;
+        b->size  = size;
+        b->owned = true;
+        reserved_ += size;
+        if (cur_block_) cur_block_->next = b;
+        else head_ = b;
+        enter(b);
+
+        char* p = align_up(cur_, align);
+        cur_ = p + bytes;
+        return p;
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t align) override {
+        allocated_ += bytes;
+        char* p = align_up(cur_, align);
+        if (cur_ && p + bytes <= end_) {
+            cur_ = p + bytes;
+            return p;
+        }
+        return allocate_slow(bytes, align);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t /*align*/) override {
+        // 只回收最后一次分配
+        if (static_cast<char*>(p) + bytes == cur_) {
+            cur_ = static_cast<char*>(p);
+            allocated_ -= bytes;
+        }
+    }
+
+public:
+    /**
+     * @brief 构造一个空 arena，首次分配时申请 initial_block 字节的块
+     */
+    explicit monotonic_arena(size_t initial_block = DEFAULT_BLOCK_SIZE,
+                             memory_resource* upstream = new_delete_resource()) noexcept
+        : upstream_(upstream), head_(nullptr), cur_block_(nullptr), cur_(nullptr), end_(nullptr),
+          next_size_(initial_block < HEADER * 2 ? HEADER * 2 : initial_block),
+          allocated_(0), reserved_(0) {}
+
+    /**
+     * @brief 先使用调用者提供的缓冲区（例如栈上数组），用完再向上游申请
+     *
+     * 缓冲区的生命周期必须覆盖 arena；reset() 后会重新从它开始分配。
+     */
+    monotonic_arena(void* buffer, size_t size,
+                    memory_resource* upstream = new_delete_resource()) noexcept
+        : monotonic_arena(size * 2, upstream) {
+        char* p = align_up(static_cast<char*>(buffer), DEFAULT_ALIGN);
+        size_t usable = size - static_cast<size_t>(p - static_cast<char*>(buffer));
+        if (size >= HEADER * 2 + DEFAULT_ALIGN) {
+            block* b = reinterpret_cast<block*>(p);
+            b->next  = nullptr;
+            b->size  = usable & ~(DEFAULT_ALIGN - 1);
+            b->owned = false;
+            head_ = b;
+            enter(b);
+        }
+    }
+
+    monotonic_arena(const monotonic_arena&) = delete;
+    monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+    ~monotonic_arena() override { release(); }
+
+    /**
+     * @brief 回到第一块的起点，保留全部块供后续复用，O(1)
+     *
+     * 调用前必须保证从本 arena 分配的对象都已不再使用。
+     */
+    void reset() noexcept {
+        allocated_ = 0;
+        if (head_) enter(head_);
+    }
+
+    /**
+     * @brief 把所有块还给上游（用户提供的初始缓冲区除外）
+     */
+    void release() noexcept {
+        block* keep = nullptr;
+        block* b = head_;
+        while (b) {
+            block* nxt = b->next;
+            if (b->owned) upstream_->deallocate(b, b->size, DEFAULT_ALIGN);
+            else keep = b;
+            b = nxt;
+        }
+        reserved_ = 0;
+        allocated_ = 0;
+        head_ = cur_block_ = nullptr;
+        cur_ = end_ = nullptr;
+        if (keep) {
+            keep->next = nullptr;
+            head_ = keep;
+            enter(keep);
+        }
+    }
+
+    memory_resource* upstream() const noexcept { return upstream_; }
+
+    /** 自上次 reset 以来分配出去的字节数 */
+    size_t allocated_bytes() const noexcept { return allocated_; }
+
+    /** 从上游申请的总字节数 */
+    size_t reserved_bytes() const noexcept { return reserved_; }
+};
+
+} // namespace zen
+
+#endif // ZEN_MEMORY_ARENA_H
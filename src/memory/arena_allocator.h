@@ -0,0 +1,130 @@
+#ifndef ZEN_MEMORY_ARENA_ALLOCATOR_H
+#define ZEN_MEMORY_ARENA_ALLOCATOR_H
+
+#include "../base/type_traits.h"
+#include "memory_resource.h"
+#include "arena.h"
+#include "memory_pool.h"
+#include <new>
+
+namespace zen {
+
+// ============================================================================
+// arena_allocator - 把 memory_resource 接入容器的 Alloc 模板参数
+// ============================================================================
+
+/**
+ * @brief 从 memory_resource 分配内存的分配器
+ * @tparam T 分配的对象类型
+ *
+ * 接口与 allocator<T> 相同（rebind / allocate / deallocate / construct / destroy），
+ * 可直接用作 vector / list / map / unordered_map / deque 等容器的 Alloc 参数。
+ * 分配器本身只是一个指针，拷贝和 rebind 都指向同一个资源；
+ * 容器内部 rebind 出的节点分配器、桶数组分配器因此共享同一个 arena。
+ *
+ * 默认构造时使用 new_delete_resource()。
+ *
+ * @code
+ * zen::monotonic_arena arena;
+ * zen::arena_allocator<int> a(&arena);
+ * zen::vector<int, zen::arena_allocator<int>> v(a);
+ * zen::map<int, int, zen::less<int>, zen::arena_allocator<zen::pair<const int, int>>> m(a);
+ * @endcode
+ */
+template<typename T>
+class arena_allocator {
+public:
+    // ========================================================================
+    // 标准类型定义
+    // ========================================================================
+
+    using value_type      = T;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = decltype(sizeof(0));
+    using difference_type = decltype((T*)0 - (T*)0);
+
+    template<typename U>
+    struct rebind {
+        using other = arena_allocator<U>;
+    };
+
+private:
+    template<typename U> friend class arena_allocator;
+
+    memory_resource* res_;
+
+public:
+    // ========================================================================
+    // 构造
+    // ========================================================================
+
+    arena_allocator() noexcept : res_(new_delete_resource()) {}
+
+    /** 隐式转换：允许直接把 &arena 传给容器构造函数 */
+    arena_allocator(memory_resource* r) noexcept : res_(r) {}
+
+    arena_allocator(const arena_allocator&) noexcept = default;
+    arena_allocator& operator=(const arena_allocator&) noexcept = default;
+
+    // 跨类型拷贝构造（rebind 使用）
+    template<typename U>
+    arena_allocator(const arena_allocator<U>& other) noexcept : res_(other.res_) {}
+
+    // ========================================================================
+    // 内存分配
+    // ========================================================================
+
+    pointer allocate(size_type n) {
+        return static_cast<pointer>(res_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(pointer p, size_type n) noexcept {
+        res_->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    // ========================================================================
+    // 对象构造与析构
+    // ========================================================================
+
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        ::new(static_cast<void*>(p)) U(static_cast<Args&&>(args)...);
+    }
+
+    template<typename U>
+    void destroy(U* p) noexcept {
+        p->~U();
+    }
+
+    // ========================================================================
+    // 辅助查询
+    // ========================================================================
+
+    size_type max_size() const noexcept {
+        return static_cast<size_type>(-1) / sizeof(T);
+    }
+
+    /** 底层内存资源 */
+    memory_resource* resource() const noexcept { return res_; }
+};
+
+// ============================================================================
+// 比较运算符：指向同一资源（或资源 is_equal）即相等
+// ============================================================================
+
+template<typename T, typename U>
+inline bool operator==(const arena_allocator<T>& a, const arena_allocator<U>& b) noexcept {
+    return a.resource()->is_equal(*b.resource());
+}
+
+template<typename T, typename U>
+inline bool operator!=(const arena_allocator<T>& a, const arena_allocator<U>& b) noexcept {
+    return !(a == b);
+}
+
+} // namespace zen
+
+#endif // ZEN_MEMORY_ARENA_ALLOCATOR_H
@@ -0,0 +1,230 @@
+#ifndef ZEN_MEMORY_ATOMIC_SHARED_PTR_H
+#define ZEN_MEMORY_ATOMIC_SHARED_PTR_H
+
+#include "shared_ptr.h"
+#include <atomic>
+#include <cstdint>
+
+namespace zen {
+
+// ============================================================================
+// atomic_shared_ptr - 可被多个线程并发读写的 shared_ptr 槽位
+// ============================================================================
+
+/**
+ * @brief 无锁发布 / 读取 shared_ptr 快照
+ * @tparam T 对象类型
+ *
+ * 典型用法：配置、路由表等"多读少写"的只读快照。
+ * 写者构造新快照后 store()，读者 load() 得到一个独立持有的 shared_ptr，
+ * 旧快照在最后一个读者释放后自动销毁。
+ *
+ * 实现（分离引用计数）：
+ * - 每次 store 把 shared_ptr 放进一个新分配的 box，槽位是一个 64 位字：
+ *   低 48 位是 box 指针，高 16 位是"借用计数"
+ * - load：fetch_add 借用计数（一条原子指令即可保护 box 不被释放）→
+ *   拷贝 box 里的 shared_ptr → CAS 归还借用；若 box 已被换下，
+ *   借用已由写者结算到 box 的计数上，改为对 box 计数减一
+ * - box 的计数初始为一个大偏置值，写者换下 box 后减去 (偏置 - 借用数)，
+ *   因此无论读者归还与写者结算谁先发生，计数都不会提前归零
+ * - box 每次 store 都重新分配，同一地址不会在读者借用期间重新出现，没有 ABA
+ *
+ * load / store / exchange / compare_exchange 都不加锁；
+ * 同时处于借用窗口内的读者不能超过 65535 个。
+ * 始终使用原子引用计数（与 ZEN_SHARED_PTR_SINGLE_THREADED 无关）。
+ *
+ * @code
+ * zen::atomic_shared_ptr<config> current(zen::make_shared<config>(load_config()));
+ * // 读线程
+ * auto cfg = current.load();
+ * // 写线程
+ * current.store(zen::make_shared<config>(reload_config()));
+ * @endcode
+ */
+template<typename T>
+class atomic_shared_ptr {
+public:
+    using value_type = basic_shared_ptr<T, atomic_ref_count>;
+
+private:
+    static_assert(sizeof(void*) == 8, "atomic_shared_ptr requires 64-bit pointers");
+
+    static constexpr uint64_t BORROW   = uint64_t(1) << 48;
+    static constexpr uint64_t PTR_MASK = BORROW - 1;
+    static constexpr int64_t  BIAS     = int64_t(1) << 40;
+
+    struct box {
+        value_type           sp;
+        std::atomic<int64_t> refs;
+
+        explicit box(value_type&& v) noexcept
+            : sp(static_cast<value_type&&>(v)), refs(BIAS) {
+        }
+    };
+
+    std::atomic<uint64_t> word_;
+
+    static box* box_of(uint64_t w) noexcept {
+        return reinterpret_cast<box*>(static_cast<uintptr_t>(w & PTR_MASK));
+    }
+
+    static uint64_t pack(box* b) noexcept {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(b));
+    }
+
+    static uint64_t borrowed(uint64_t w) noexcept {
+        return w >> 48;
+    }
+
+    /** box 计数减 delta，归零时释放 */
+    static void settle(box* b, int64_t delta) noexcept {
+        if (b->refs.fetch_sub(delta, std::memory_order_acq_rel) == delta) {
+            delete b;
+        }
+    }
+
+    /** 登记一次借用，返回包含本次借用的槽位值 */
+    uint64_t borrow() noexcept {
+        return word_.fetch_add(BORROW, std::memory_order_acquire) + BORROW;
+    }
+
+    /** 归还借用；box 已被换下时借用已计入 box 计数，改为对其减一 */
+    void give_back(uint64_t w) noexcept {
+        box* b = box_of(w);
+        uint64_t cur = w;
+        while (box_of(cur) == b) {
+            if (word_.compare_exchange_weak(cur, cur - BORROW,
+                                            std::memory_order_release, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+        if (b != nullptr) settle(b, 1);
+    }
+
+    /** 写者换下旧 box 后结算：偏置换成实际借用数 */
+    static void retire(uint64_t old, int64_t extra_release) noexcept {
+        box* b = box_of(old);
+        if (b != nullptr) {
+            settle(b, BIAS - static_cast<int64_t>(borrowed(old)) + extra_release);
+        }
+    }
+
+    static box* make_box(value_type&& v) {
+        return new box(static_cast<value_type&&>(v));
+    }
+
+public:
+    // ========================================================================
+    // 构造与析构
+    // ========================================================================
+
+    atomic_shared_ptr() noexcept : word_(0) {}
+
+    explicit atomic_shared_ptr(value_type v) : word_(pack(make_box(static_cast<value_type&&>(v)))) {}
+
+    atomic_shared_ptr(const atomic_shared_ptr&) = delete;
+    atomic_shared_ptr& operator=(const atomic_shared_ptr&) = delete;
+
+    /**
+     * @brief 析构（此时不应再有并发访问）
+     */
+    ~atomic_shared_ptr() noexcept {
+        retire(word_.load(std::memory_order_acquire), 0);
+    }
+
+    // ========================================================================
+    // 原子操作
+    // ========================================================================
+
+    /**
+     * @brief 读取当前快照（返回的 shared_ptr 独立持有对象）
+     */
+    value_type load() const noexcept {
+        atomic_shared_ptr* self = const_cast<atomic_shared_ptr*>(this);
+        uint64_t w = self->borrow();
+        box* b = box_of(w);
+        value_type r;
+        if (b != nullptr) r = b->sp;
+        self->give_back(w);
+        return r;
+    }
+
+    /**
+     * @brief 发布新快照，返回旧快照
+     */
+    value_type exchange(value_type desired) {
+        box* nb = make_box(static_cast<value_type&&>(desired));
+        uint64_t old = word_.load(std::memory_order_relaxed);
+        while (!word_.compare_exchange_weak(old, pack(nb),
+                                            std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        }
+        value_type r;
+        if (box* b = box_of(old)) r = b->sp;   // 结算前拷贝，此时 box 仍被偏置保护
+        retire(old, 0);
+        return r;
+    }
+
+    /**
+     * @brief 发布新快照
+     */
+    void store(value_type desired) {
+        exchange(static_cast<value_type&&>(desired));
+    }
+
+    /**
+     * @brief 当前值与 expected 指向同一对象（且共享控制块）时替换为 desired
+     * @return 成功返回 true；失败时 expected 更新为当前值
+     */
+    bool compare_exchange_strong(value_type& expected, value_type desired) {
+        box* nb = make_box(static_cast<value_type&&>(desired));
+        for (;;) {
+            uint64_t w = borrow();
+            box* b = box_of(w);
+            bool same = b != nullptr
+                ? (b->sp.get() == expected.get() && b->sp.owner_equal(expected))
+                : expected.get() == nullptr && expected.use_count() == 0;
+            if (!same) {
+                expected = b != nullptr ? b->sp : value_type();
+                give_back(w);
+                delete nb;
+                return false;
+            }
+            uint64_t cur = w;
+            while (box_of(cur) == b) {
+                if (word_.compare_exchange_weak(cur, pack(nb),
+                                                std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                    // cur 中的借用数包含自己的那一次，结算时一并归还
+                    retire(cur, 1);
+                    return true;
+                }
+            }
+            // 槽位已被别人换掉：自己的借用已计入旧 box，归还后重试
+            if (b != nullptr) settle(b, 1);
+        }
+    }
+
+    bool compare_exchange_weak(value_type& expected, value_type desired) {
+        return compare_exchange_strong(expected, static_cast<value_type&&>(desired));
+    }
+
+    bool is_lock_free() const noexcept {
+        return word_.is_lock_free();
+    }
+
+    // ========================================================================
+    // 便捷运算符
+    // ========================================================================
+
+    operator value_type() const noexcept {
+        return load();
+    }
+
+    atomic_shared_ptr& operator=(value_type desired) {
+        store(static_cast<value_type&&>(desired));
+        return *this;
+    }
+};
+
+} // namespace zen
+
+#endif // ZEN_MEMORY_ATOMIC_SHARED_PTR_H
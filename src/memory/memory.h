@@ -1,5 +1,21 @@
-#pragma once
+#ifndef ZEN_MEMORY_MEMORY_H
+#define ZEN_MEMORY_MEMORY_H
 
-namespace zen {
+// 内存子系统
+// - allocator<T>          ：::operator new / delete 的薄封装（容器默认）
+// - memory_resource       ：多态内存资源接口，new_delete_resource() 为全局堆
+// - monotonic_arena       ：bump-pointer 链式块，O(1) reset
+// - pool_resource         ：按大小分级的定长块池
+// - arena_allocator<T>    ：把任意 memory_resource 接入容器的 Alloc 参数
+// - node_pool<T>          ：节点式容器内部使用的 slab 节点池
+// - tc_malloc / tc_free   ：线程缓存分配器（可作为 allocator<T> 的构建期后端）
 
-} // namespace zen
+#include "allocator.h"
+#include "memory_resource.h"
+#include "arena.h"
+#include "memory_pool.h"
+#include "arena_allocator.h"
+#include "node_pool.h"
+#include "thread_cache.h"
+
+#endif // ZEN_MEMORY_MEMORY_H
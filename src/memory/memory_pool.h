@@ -1,5 +1,182 @@
-#pragma once
+#ifndef ZEN_MEMORY_MEMORY_POOL_H
+#define ZEN_MEMORY_MEMORY_POOL_H
+
+#include "memory_resource.h"
 
 namespace zen {
 
+// ============================================================================
+// pool_resource - 按大小分级的定长块内存池
+// ============================================================================
+
+/**
+ * @brief pool_resource 的配置
+ */
+struct pool_options {
+    size_t max_blocks_per_chunk        = 256;   ///< 单个 slab 最多切出的块数
+    size_t largest_required_pool_block = 4096;  ///< 超过此大小的请求直接转给上游
+};
+
+/**
+ * @brief 按大小分级的内存池
+ *
+ * 大小分级：8、16、32 … largest_required_pool_block（2 的幂）。
+ * 每一级维护一个空闲链表，空闲时由上游批量申请一个 slab 再切成等长块，
+ * slab 中的块数从 8 开始翻倍，上限 max_blocks_per_chunk。
+ *
+ * - allocate / deallocate：定位级别后对空闲链表 push / pop，O(1)
+ * - 超过最大级别或对齐要求超过 max_align_t 的请求直接转给上游
+ * - release()：把所有 slab 还给上游；析构时自动调用
+ *
+ * 上游可以是 monotonic_arena：整个请求的小对象都从池中复用，
+ * 请求结束时 arena reset 一次即可。
+ *
+ * 不是线程安全的。
+ */
+class pool_resource : public memory_resource {
+private:
+    static constexpr size_t MIN_BLOCK   = 8;
+    static constexpr size_t MAX_CLASSES = 24;
+    static constexpr size_t FIRST_CHUNK = 8;
+
+    struct free_block { free_block* next; };
+
+    struct chunk {
+        chunk* next;
+        size_t bytes;           ///< 整个 slab 字节数（含头）
+    };
+
+    static constexpr size_t CHUNK_HEADER = (sizeof(chunk) + DEFAULT_ALIGN - 1) & ~(DEFAULT_ALIGN - 1);
+
+    struct size_class {
+        free_block* free;
+        size_t      next_blocks;    ///< 下一个 slab 的块数
+    };
+
+    memory_resource* upstream_;
+    pool_options     opts_;
+    size_t           num_classes_;
+    size_class       classes_[MAX_CLASSES];
+    chunk*           chunks_;       ///< 所有 slab（不分级别）
+    size_t           reserved_;
+
+    /** 请求大小 → 级别下标 */
+    static size_t class_index(size_t bytes) noexcept {
+        if (bytes <= MIN_BLOCK) return 0;
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(64 - __builtin_clzll(static_cast<unsigned long long>(bytes - 1))) - 3;
+#else
+        size_t idx = 0;
+        size_t s = MIN_BLOCK;
+        while (s < bytes) {
+            s <<= 1;
+            ++idx;
+        }
+        return idx;
+#endif
+    }
+
+    static size_t class_size(size_t idx) noexcept { return MIN_BLOCK << idx; }
+
+    /** 给级别 idx 补一个 slab，并把切出的块串进空闲链表 */
+    void refill(size_t idx) {
+        size_class& c = classes_[idx];
+        size_t bsize  = class_size(idx);
+        size_t n      = c.next_blocks;
+        size_t bytes  = CHUNK_HEADER + n * bsize;
+
+        chunk* ch = static_cast<chunk*>(upstream_->allocate(bytes, DEFAULT_ALIGN));
+        ch->next  = chunks_;
+        ch->bytes = bytes;
+        chunks_   = ch;
+        reserved_ += bytes;
+
+        char* base = reinterpret_cast<char*>(ch) + CHUNK_HEADER;
+        for (size_t i = n; i-- > 0; ) {
+            free_block* b = reinterpret_cast<free_block*>(base + i * bsize);
+            b->next = c.free;
+            c.free  = b;
+        }
+        if (c.next_blocks < opts_.max_blocks_per_chunk) c.next_blocks *= 2;
+    }
+
+    bool pooled(size_t bytes, size_t align) const noexcept {
+        return bytes <= opts_.largest_required_pool_block && align <= DEFAULT_ALIGN;
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t align) override {
+        if (!pooled(bytes, align)) return upstream_->allocate(bytes, align);
+        if (bytes < align) bytes = align;   // 块按自身大小对齐
+        size_t idx = class_index(bytes);
+        size_class& c = classes_[idx];
+        if (!c.free) refill(idx);
+        free_block* b = c.free;
+        c.free = b->next;
+        return b;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        if (!pooled(bytes, align)) {
+            upstream_->deallocate(p, bytes, align);
+            return;
+        }
+        if (bytes < align) bytes = align;
+        size_class& c = classes_[class_index(bytes)];
+        free_block* b = static_cast<free_block*>(p);
+        b->next = c.free;
+        c.free  = b;
+    }
+
+public:
+    explicit pool_resource(const pool_options& opts = pool_options(),
+                           memory_resource* upstream = new_delete_resource()) noexcept
+        : upstream_(upstream), opts_(opts), num_classes_(0), chunks_(nullptr), reserved_(0) {
+        if (opts_.max_blocks_per_chunk < FIRST_CHUNK) opts_.max_blocks_per_chunk = FIRST_CHUNK;
+        if (opts_.largest_required_pool_block < MIN_BLOCK) opts_.largest_required_pool_block = MIN_BLOCK;
+        if (opts_.largest_required_pool_block > class_size(MAX_CLASSES - 1)) {
+            opts_.largest_required_pool_block = class_size(MAX_CLASSES - 1);
+        }
+        num_classes_ = class_index(opts_.largest_required_pool_block) + 1;
+        // 最大级别向上取整到 2 的幂，保证 pooled() 判定与级别一致
+        opts_.largest_required_pool_block = class_size(num_classes_ - 1);
+        for (size_t i = 0; i < MAX_CLASSES; ++i) {
+            classes_[i].free        = nullptr;
+            classes_[i].next_blocks = FIRST_CHUNK;
+        }
+    }
+
+    explicit pool_resource(memory_resource* upstream) noexcept
+        : pool_resource(pool_options(), upstream) {}
+
+    pool_resource(const pool_resource&) = delete;
+    pool_resource& operator=(const pool_resource&) = delete;
+
+    ~pool_resource() override { release(); }
+
+    /**
+     * @brief 把所有 slab 还给上游（池中对象全部失效）
+     */
+    void release() noexcept {
+        while (chunks_) {
+            chunk* nxt = chunks_->next;
+            upstream_->deallocate(chunks_, chunks_->bytes, DEFAULT_ALIGN);
+            chunks_ = nxt;
+        }
+        for (size_t i = 0; i < MAX_CLASSES; ++i) {
+            classes_[i].free        = nullptr;
+            classes_[i].next_blocks = FIRST_CHUNK;
+        }
+        reserved_ = 0;
+    }
+
+    memory_resource*    upstream() const noexcept { return upstream_; }
+    const pool_options& options()  const noexcept { return opts_; }
+
+    /** 从上游申请的 slab 总字节数（不含直通上游的大块） */
+    size_t reserved_bytes() const noexcept { return reserved_; }
+};
+
 } // namespace zen
+
+#endif // ZEN_MEMORY_MEMORY_POOL_H
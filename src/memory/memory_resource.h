@@ -0,0 +1,99 @@
+#ifndef ZEN_MEMORY_MEMORY_RESOURCE_H
+#define ZEN_MEMORY_MEMORY_RESOURCE_H
+
+#include "../base/type_traits.h"
+#include <cstddef>  // max_align_t
+#include <new>
+
+namespace zen {
+
+// ============================================================================
+// memory_resource - 内存资源抽象
+// ============================================================================
+
+/**
+ * @brief 多态内存资源（与 std::pmr::memory_resource 同构）
+ *
+ * monotonic_arena / pool_resource 等具体资源都派生自它，
+ * arena_allocator<T> 只持有一个 memory_resource*，
+ * 因此同一容器类型可以在运行时切换底层策略，也可以把资源层层叠加
+ * （例如 pool_resource 的上游是 monotonic_arena）。
+ */
+class memory_resource {
+public:
+    static constexpr size_t DEFAULT_ALIGN = alignof(max_align_t);
+
+    virtual ~memory_resource() = default;
+
+    /**
+     * @brief 分配 bytes 字节，起始地址按 align 对齐
+     */
+    void* allocate(size_t bytes, size_t align = DEFAULT_ALIGN) {
+        return do_allocate(bytes, align);
+    }
+
+    /**
+     * @brief 归还由 allocate 得到的内存，bytes / align 必须与分配时一致
+     */
+    void deallocate(void* p, size_t bytes, size_t align = DEFAULT_ALIGN) {
+        do_deallocate(p, bytes, align);
+    }
+
+    /**
+     * @brief 一个资源分配的内存能否由另一个释放
+     */
+    bool is_equal(const memory_resource& other) const noexcept {
+        return this == &other || do_is_equal(other);
+    }
+
+protected:
+    virtual void* do_allocate(size_t bytes, size_t align) = 0;
+    virtual void  do_deallocate(void* p, size_t bytes, size_t align) = 0;
+    virtual bool  do_is_equal(const memory_resource& other) const noexcept { return this == &other; }
+};
+
+inline bool operator==(const memory_resource& a, const memory_resource& b) noexcept {
+    return a.is_equal(b);
+}
+
+inline bool operator!=(const memory_resource& a, const memory_resource& b) noexcept {
+    return !a.is_equal(b);
+}
+
+// ============================================================================
+// new_delete_resource - 直接转发给全局 operator new / delete
+// ============================================================================
+
+namespace detail {
+
+class new_delete_resource_impl : public memory_resource {
+protected:
+    void* do_allocate(size_t bytes, size_t align) override {
+        if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return ::operator new(bytes, std::align_val_t(align));
+        }
+        return ::operator new(bytes);
+    }
+
+    void do_deallocate(void* p, size_t /*bytes*/, size_t align) override {
+        if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(p, std::align_val_t(align));
+            return;
+        }
+        ::operator delete(p);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief 全局堆资源（进程内唯一），也是其他资源默认的上游
+ */
+inline memory_resource* new_delete_resource() noexcept {
+    static detail::new_delete_resource_impl instance;
+    return &instance;
+}
+
+} // namespace zen
+
+#endif // ZEN_MEMORY_MEMORY_RESOURCE_H
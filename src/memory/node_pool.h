@@ -0,0 +1,205 @@
+#ifndef ZEN_MEMORY_NODE_POOL_H
+#define ZEN_MEMORY_NODE_POOL_H
+
+#include "../base/type_traits.h"
+#include "allocator.h"
+#include <atomic>
+
+namespace zen {
+
+// ============================================================================
+// node_pool - 定长节点的分块（slab）分配器
+// ============================================================================
+
+/**
+ * @brief 为节点式容器（红黑树等）批量分配定长节点
+ * @tparam T     节点类型（只分配原始内存，不构造）
+ * @tparam Alloc 底层分配器，用于申请整块内存
+ *
+ * 分配策略：
+ * - 节点按块（chunk）申请：首块 16 个，之后每块翻倍，上限 1024 个
+ * - 块内按指针递增切分；释放的节点压入单链表空闲列表，优先复用
+ * - release_all() 一次性归还所有块，O(块数)，无需逐个释放节点
+ *
+ * 生命周期：
+ * 池对象本身通过 create() 在堆上创建并带引用计数。容器持有一个引用，
+ * 容器取出的节点句柄（node handle）再各持一个引用——
+ * 这样即使容器先析构，句柄里的节点内存依然有效。
+ *
+ * 节点插入另一个容器时不复制：目标池 adopt() 来源池，持有它一个引用直到
+ * 目标池 release_all() / 析构，被接收的节点随后与本池节点一样释放进本池空闲列表。
+ *
+ * 分配与释放不是线程安全的，与所属容器的并发约束相同；引用计数是原子的，
+ * 因为 adopt() 之后来源池会被两个可能在不同线程使用的容器共同持有。
+ */
+template<typename T, typename Alloc = allocator<T>>
+class node_pool {
+private:
+    union slot;
+
+    struct chunk_header {
+        slot*       next_chunk;
+        size_t      count;      ///< 本块槽位数（含头部占用的 1 个）
+    };
+
+    struct adopted_link {
+        slot*       next;
+        node_pool*  pool;
+    };
+
+    union slot {
+        slot*         next;     ///< 空闲时：空闲链表指针
+        chunk_header  header;   ///< 每块第 0 个槽位：块链表头
+        adopted_link  adopted;  ///< 被接收的其他池（占用本池一个槽位）
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    using slot_alloc = typename Alloc::template rebind<slot>::other;
+    using self_alloc = typename Alloc::template rebind<node_pool>::other;
+
+    static constexpr size_t FIRST_CHUNK = 16;
+    static constexpr size_t MAX_CHUNK   = 1024;
+
+    slot*               chunks_;     ///< 块链表
+    slot*               free_;       ///< 空闲节点链表
+    slot*               adopted_;    ///< 被接收的其他池
+    slot*               cur_;        ///< 当前块中下一个未切分的槽位
+    slot*               end_;        ///< 当前块末尾
+    size_t              next_count_; ///< 下一块的槽位数
+    size_t              capacity_;   ///< 所有块可用槽位总数
+    std::atomic<size_t> refs_;
+    slot_alloc          alloc_;
+
+    explicit node_pool(const Alloc& a)
+        : chunks_(nullptr), free_(nullptr), adopted_(nullptr), cur_(nullptr), end_(nullptr),
+          next_count_(FIRST_CHUNK + 1), capacity_(0), refs_(1), alloc_(a) {}
+
+    ~node_pool() { release_all(); }
+
+    void grow() {
+        size_t n = next_count_;
+        slot* c = alloc_.allocate(n);
+        c->header.next_chunk = chunks_;
+        c->header.count      = n;
+        chunks_ = c;
+        cur_    = c + 1;
+        end_    = c + n;
+        capacity_ += n - 1;
+        if (next_count_ - 1 < MAX_CHUNK) next_count_ = (next_count_ - 1) * 2 + 1;
+    }
+
+public:
+    node_pool(const node_pool&) = delete;
+    node_pool& operator=(const node_pool&) = delete;
+
+    // -------------------------------------------------------------------------
+    // 创建与引用计数
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief 在堆上创建一个池，初始引用计数为 1
+     */
+    static node_pool* create(const Alloc& a = Alloc()) {
+        self_alloc sa(a);
+        node_pool* p = sa.allocate(1);
+        ::new(static_cast<void*>(p)) node_pool(a);
+        return p;
+    }
+
+    void add_ref() noexcept { refs_.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief 减少一个引用；降为 0 时归还全部块并销毁池本身
+     */
+    static void unref(node_pool* p) noexcept {
+        if (!p || p->refs_.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        self_alloc sa(p->alloc_);
+        p->~node_pool();
+        sa.deallocate(p, 1);
+    }
+
+    /** 是否还有其他持有者（如未归还的节点句柄） */
+    bool shared() const noexcept { return refs_.load(std::memory_order_acquire) > 1; }
+
+    /**
+     * @brief 接收 other 分配的节点
+     *
+     * 本池持有 other 一个引用（同一个 other 只记一次），直到 release_all() / 析构；
+     * 在此之前 other 的节点可以交给本池 deallocate()。
+     */
+    void adopt(node_pool* other) {
+        if (other == this) return;
+        for (slot* a = adopted_; a; a = a->adopted.next) {
+            if (a->adopted.pool == other) return;
+        }
+        slot* a = reinterpret_cast<slot*>(allocate());
+        a->adopted.next = adopted_;
+        a->adopted.pool = other;
+        adopted_ = a;
+        other->add_ref();
+    }
+
+    /** 节点分配器（用于在池中的节点上构造 / 析构对象） */
+    Alloc get_allocator() const noexcept { return Alloc(alloc_); }
+
+    // -------------------------------------------------------------------------
+    // 分配与释放
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief 取一个节点大小的原始内存
+     */
+    T* allocate() {
+        slot* s = free_;
+        if (s) {
+            free_ = s->next;
+        } else {
+            if (cur_ == end_) grow();
+            s = cur_++;
+        }
+        return reinterpret_cast<T*>(s->storage);
+    }
+
+    /**
+     * @brief 把节点内存放回空闲列表（调用者负责先析构对象）
+     */
+    void deallocate(T* p) noexcept {
+        slot* s = reinterpret_cast<slot*>(p);
+        s->next = free_;
+        free_ = s;
+    }
+
+    /**
+     * @brief 一次性归还所有块
+     *
+     * 调用前必须保证池中不再有存活对象（或者它们无需析构）。
+     * 同时放开 adopt() 接收的池。
+     */
+    void release_all() noexcept {
+        for (slot* a = adopted_; a; ) {
+            slot* nxt = a->adopted.next;
+            unref(a->adopted.pool);
+            a = nxt;
+        }
+        adopted_ = nullptr;
+        while (chunks_) {
+            slot* nxt = chunks_->header.next_chunk;
+            alloc_.deallocate(chunks_, chunks_->header.count);
+            chunks_ = nxt;
+        }
+        free_ = cur_ = end_ = nullptr;
+        next_count_ = FIRST_CHUNK + 1;
+        capacity_ = 0;
+    }
+
+    // -------------------------------------------------------------------------
+    // 统计
+    // -------------------------------------------------------------------------
+
+    /** 已申请的槽位总数（含空闲） */
+    size_t capacity() const noexcept { return capacity_; }
+};
+
+} // namespace zen
+
+#endif // ZEN_MEMORY_NODE_POOL_H
@@ -3,6 +3,7 @@
 
 #include "../base/type_traits.h"
 #include "../utility/swap.h"
+#include <atomic>
 // placement new 需要 <new>
 #include <new>
 
@@ -22,12 +23,87 @@ struct shared_default_delete {
     }
 };
 
+// ============================================================================
+// 引用计数策略
+// ============================================================================
+
+/**
+ * @brief 原子引用计数（默认）
+ *
+ * - 增加：relaxed —— 持有者已经拥有一个引用，新增引用不需要同步任何数据
+ * - 减少：acq_rel —— release 保证本线程对对象的写入先于析构，
+ *         acquire 保证最后一个持有者看到其他线程的全部写入后再析构
+ * - 弱引用升级：CAS 循环，计数为 0 时失败
+ */
+struct atomic_ref_count {
+    using count_type = std::atomic<long>;
+
+    static void increment(count_type& c) noexcept {
+        c.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void add(count_type& c, long n) noexcept {
+        c.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /** 返回减少后的计数 */
+    static long decrement(count_type& c) noexcept {
+        return c.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    }
+
+    static bool increment_if_nonzero(count_type& c) noexcept {
+        long n = c.load(std::memory_order_relaxed);
+        while (n != 0) {
+            if (c.compare_exchange_weak(n, n + 1, std::memory_order_relaxed, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static long load(const count_type& c) noexcept {
+        return c.load(std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief 非原子引用计数：只在单线程内共享的对象，省去原子指令
+ */
+struct single_thread_ref_count {
+    using count_type = long;
+
+    static void increment(count_type& c) noexcept { ++c; }
+    static void add(count_type& c, long n) noexcept { c += n; }
+    static long decrement(count_type& c) noexcept { return --c; }
+
+    static bool increment_if_nonzero(count_type& c) noexcept {
+        if (c == 0) return false;
+        ++c;
+        return true;
+    }
+
+    static long load(const count_type& c) noexcept { return c; }
+};
+
+// 构建时定义 ZEN_SHARED_PTR_SINGLE_THREADED 可把 shared_ptr / weak_ptr 的默认策略
+// 切换为非原子计数（整个程序只有一个线程时使用）
+#ifdef ZEN_SHARED_PTR_SINGLE_THREADED
+using default_ref_count = single_thread_ref_count;
+#else
+using default_ref_count = atomic_ref_count;
+#endif
+
 // forward declaration
-template<typename T>
-class weak_ptr;
+template<typename T, typename RefCount>
+class basic_weak_ptr;
 
-template<typename T>
-class shared_ptr;
+template<typename T, typename RefCount>
+class basic_shared_ptr;
+
+namespace detail {
+template<typename T, typename RefCount>
+struct shared_ptr_access;
+} // namespace detail
 
 // ============================================================================
 // control_block - 引用计数控制块
@@ -35,6 +111,7 @@ class shared_ptr;
 
 /**
  * @brief 共享引用计数控制块（基类）
+ * @tparam RefCount 引用计数策略
  *
  * 控制块与托管对象分离，生命周期独立。
  * 当 shared_count 降为 0 时销毁对象，但控制块本身保留到
@@ -50,15 +127,18 @@ class shared_ptr;
  *                   └─────────────────────────────────────────┘  │
  *   T* ptr ─────────────────────────────────────────────────────>│  托管对象
  */
-struct control_block {
-    long shared_count; // 强引用计数（shared_ptr 数量）
-    long weak_count;   // 弱引用计数（weak_ptr 数量，初始为 1，代表强引用组）
+template<typename RefCount>
+struct basic_control_block {
+    using count_type = typename RefCount::count_type;
 
-    control_block() noexcept
+    count_type shared_count; // 强引用计数（shared_ptr 数量）
+    count_type weak_count;   // 弱引用计数（weak_ptr 数量，初始为 1，代表强引用组）
+
+    basic_control_block() noexcept
         : shared_count(1), weak_count(1) {
     }
 
-    virtual ~control_block() noexcept = default;
+    virtual ~basic_control_block() noexcept = default;
 
     /**
      * @brief 销毁托管的对象（shared_count 降为 0 时调用）
@@ -80,15 +160,22 @@ struct control_block {
      * @brief 增加强引用
      */
     void add_ref() noexcept {
-        ++shared_count;
+        RefCount::increment(shared_count);
         // weak_count 不需要递增，因为强引用组已经持有 1 个弱引用
     }
 
     /**
-     * @brief 减少强引用，返回新计数
+     * @brief 一次增加 n 个强引用（atomic_shared_ptr 结算读者借用的引用）
+     */
+    void add_ref(long n) noexcept {
+        RefCount::add(shared_count, n);
+    }
+
+    /**
+     * @brief 减少强引用
      */
     void release_ref() noexcept {
-        if (--shared_count == 0) {
+        if (RefCount::decrement(shared_count) == 0) {
             // 强引用归零，销毁对象
             destroy_object();
             // 释放之前强引用组持有的那 1 个弱引用
@@ -100,14 +187,14 @@ struct control_block {
      * @brief 增加弱引用
      */
     void add_weak() noexcept {
-        ++weak_count;
+        RefCount::increment(weak_count);
     }
 
     /**
      * @brief 减少弱引用
      */
     void release_weak() noexcept {
-        if (--weak_count == 0) {
+        if (RefCount::decrement(weak_count) == 0) {
             // 没有任何引用，释放控制块
             destroy_block();
         }
@@ -115,17 +202,50 @@ struct control_block {
 
     /**
      * @brief 尝试将弱引用升级为强引用（lock() 使用）
-     * @return 升级成功返回 true
+     * @return 升级成功返回 true；对象已销毁返回 false
      */
     bool try_add_ref() noexcept {
-        if (shared_count == 0) {
-            return false; // 对象已销毁
-        }
-        ++shared_count;
-        return true;
+        return RefCount::increment_if_nonzero(shared_count);
+    }
+
+    /**
+     * @brief 当前强引用计数（多线程下只是瞬时值）
+     */
+    long use_count() const noexcept {
+        return RefCount::load(shared_count);
     }
 };
 
+using control_block = basic_control_block<default_ref_count>;
+
+namespace detail {
+
+/**
+ * @brief 按 Block 的对齐分配 / 释放控制块内存
+ *
+ * ::operator new(size) 只保证 __STDCPP_DEFAULT_NEW_ALIGNMENT__；
+ * 内嵌过对齐对象（如 alignas(64)）的控制块要用带 align_val_t 的版本。
+ */
+template<typename Block>
+void* allocate_block() {
+    if constexpr (alignof(Block) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return ::operator new(sizeof(Block), std::align_val_t{alignof(Block)});
+    } else {
+        return ::operator new(sizeof(Block));
+    }
+}
+
+template<typename Block>
+void deallocate_block(void* p) noexcept {
+    if constexpr (alignof(Block) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(p, std::align_val_t{alignof(Block)});
+    } else {
+        ::operator delete(p);
+    }
+}
+
+} // namespace detail
+
 // ============================================================================
 // control_block_impl - 带删除器的具体控制块
 // ============================================================================
@@ -134,14 +254,15 @@ struct control_block {
  * @brief 持有托管指针和自定义删除器的控制块实现
  * @tparam T 托管对象类型
  * @tparam Deleter 删除器类型
+ * @tparam RefCount 引用计数策略
  */
-template<typename T, typename Deleter>
-struct control_block_impl : control_block {
+template<typename T, typename Deleter, typename RefCount = default_ref_count>
+struct control_block_impl : basic_control_block<RefCount> {
     T*      ptr_;     // 托管的原始指针
     Deleter deleter_; // 删除器
 
     control_block_impl(T* p, Deleter d) noexcept
-        : control_block(), ptr_(p), deleter_(static_cast<Deleter&&>(d)) {
+        : basic_control_block<RefCount>(), ptr_(p), deleter_(static_cast<Deleter&&>(d)) {
     }
 
     void destroy_object() noexcept override {
@@ -154,17 +275,55 @@ struct control_block_impl : control_block {
     void destroy_block() noexcept override {
         // 调用自身析构函数，然后释放内存
         this->~control_block_impl();
-        ::operator delete(this);
+        detail::deallocate_block<control_block_impl>(this);
+    }
+};
+
+// ============================================================================
+// control_block_inplace - 控制块与对象合并（make_shared 使用）
+// ============================================================================
+
+/**
+ * @brief 控制块与对象合并的版本（减少一次内存分配）
+ * @tparam T 对象类型
+ * @tparam RefCount 引用计数策略
+ *
+ * 对象紧跟在计数之后，解引用与计数操作落在相邻的缓存行里。
+ */
+template<typename T, typename RefCount = default_ref_count>
+struct control_block_inplace : basic_control_block<RefCount> {
+    // 使用对齐存储，避免直接构造
+    alignas(T) char storage_[sizeof(T)];
+
+    template<typename... Args>
+    explicit control_block_inplace(Args&&... args)
+        : basic_control_block<RefCount>() {
+        ::new(static_cast<void*>(storage_)) T(static_cast<Args&&>(args)...);
+    }
+
+    T* get() noexcept {
+        return reinterpret_cast<T*>(storage_);
+    }
+
+    void destroy_object() noexcept override {
+        // 显式调用析构函数，不释放内存
+        reinterpret_cast<T*>(storage_)->~T();
+    }
+
+    void destroy_block() noexcept override {
+        this->~control_block_inplace();
+        detail::deallocate_block<control_block_inplace>(this);
     }
 };
 
 // ============================================================================
-// shared_ptr - 共享所有权智能指针
+// basic_shared_ptr - 共享所有权智能指针
 // ============================================================================
 
 /**
  * @brief 共享所有权智能指针
  * @tparam T 托管的对象类型
+ * @tparam RefCount 引用计数策略（atomic_ref_count / single_thread_ref_count）
  *
  * shared_ptr 通过引用计数实现多个所有者共享同一个对象。
  * 当最后一个 shared_ptr 销毁时，托管对象才被删除。
@@ -172,10 +331,15 @@ struct control_block_impl : control_block {
  * 核心特性：
  * - 共享所有权：可以拷贝，多个 shared_ptr 指向同一对象
  * - 引用计数：使用控制块追踪共有者数量
- * - 线程安全的引用计数（当前为非原子实现，适合单线程）
+ * - 默认原子引用计数：不同线程可以各自拷贝 / 析构指向同一对象的 shared_ptr
+ *   （同一个 shared_ptr 实例的并发读写仍需 atomic_shared_ptr）
  * - 支持自定义删除器
  * - 配合 weak_ptr 解决循环引用
  *
+ * 常用别名：
+ * - shared_ptr<T>        ：default_ref_count（默认原子）
+ * - local_shared_ptr<T>  ：single_thread_ref_count，不跨线程共享时使用
+ *
  * 内存布局：
  *   shared_ptr = { ptr_, ctrl_ }
  *   ctrl_ → control_block { shared_count, weak_count, ... }
@@ -189,30 +353,23 @@ struct control_block_impl : control_block {
  * // sp2 析构时引用计数降为 0，对象被删除
  * @endcode
  */
-template<typename T>
-class shared_ptr {
+template<typename T, typename RefCount>
+class basic_shared_ptr {
 private:
-    T*             ptr_;  // 指向托管对象（可能与 ctrl_ 分离）
-    control_block* ctrl_; // 指向控制块
-
-    // 私有构造标记，用于 make_shared 等内部使用
-    struct make_shared_tag {};
+    using block_type = basic_control_block<RefCount>;
 
-    // weak_ptr::lock() 和 make_shared 使用此私有构造
-    shared_ptr(T* p, control_block* ctrl, make_shared_tag) noexcept
-        : ptr_(p), ctrl_(ctrl) {
-    }
+    T*          ptr_;  // 指向托管对象（可能与 ctrl_ 分离）
+    block_type* ctrl_; // 指向控制块
 
-    // 保留原始私有构造（weak_ptr::lock 使用）
-    shared_ptr(T* p, control_block* ctrl) noexcept
+    // 接管一个已计入的强引用（weak_ptr::lock、make_shared、atomic_shared_ptr 使用）
+    basic_shared_ptr(T* p, block_type* ctrl) noexcept
         : ptr_(p), ctrl_(ctrl) {
     }
 
-    friend class weak_ptr<T>;
+    friend class basic_weak_ptr<T, RefCount>;
     // 允许不同 T 的 shared_ptr 互相访问（类型转换使用）
-    template<typename U> friend class shared_ptr;
-    // make_shared 需要访问私有构造
-    template<typename U, typename... A> friend shared_ptr<U> make_shared(A&&...);
+    template<typename U, typename R> friend class basic_shared_ptr;
+    friend struct detail::shared_ptr_access<T, RefCount>;
 
 public:
     // ========================================================================
@@ -220,6 +377,7 @@ public:
     // ========================================================================
 
     using element_type = T;
+    using ref_count    = RefCount;
 
     // ========================================================================
     // 构造函数
@@ -228,14 +386,14 @@ public:
     /**
      * @brief 默认构造：空指针
      */
-    constexpr shared_ptr() noexcept
+    constexpr basic_shared_ptr() noexcept
         : ptr_(nullptr), ctrl_(nullptr) {
     }
 
     /**
      * @brief 从 nullptr 构造
      */
-    constexpr shared_ptr(decltype(nullptr)) noexcept
+    constexpr basic_shared_ptr(decltype(nullptr)) noexcept
         : ptr_(nullptr), ctrl_(nullptr) {
     }
 
@@ -245,37 +403,33 @@ public:
      *
      * 分配控制块，初始引用计数 = 1。
      */
-    explicit shared_ptr(T* p)
-        : ptr_(p), ctrl_(nullptr) {
-        if (p != nullptr) {
-            // 创建持有 shared_default_delete 的控制块
-            auto* cb = static_cast<control_block_impl<T, shared_default_delete<T>>*>(
-                ::operator new(sizeof(control_block_impl<T, shared_default_delete<T>>))
-            );
-            ::new(cb) control_block_impl<T, shared_default_delete<T>>(p, shared_default_delete<T>{});
-            ctrl_ = cb;
-        }
+    explicit basic_shared_ptr(T* p)
+        : basic_shared_ptr(p, shared_default_delete<T>{}) {
     }
 
     /**
      * @brief 从原始指针和自定义删除器构造
      */
     template<typename Deleter>
-    shared_ptr(T* p, Deleter d)
+    basic_shared_ptr(T* p, Deleter d)
         : ptr_(p), ctrl_(nullptr) {
         if (p != nullptr) {
-            auto* cb = static_cast<control_block_impl<T, Deleter>*>(
-                ::operator new(sizeof(control_block_impl<T, Deleter>))
-            );
-            ::new(cb) control_block_impl<T, Deleter>(p, static_cast<Deleter&&>(d));
-            ctrl_ = cb;
+            using impl = control_block_impl<T, Deleter, RefCount>;
+            void* mem;
+            try {
+                mem = detail::allocate_block<impl>();
+            } catch (...) {
+                d(p);       // 与标准一致：控制块分配失败时删除 p
+                throw;
+            }
+            ctrl_ = ::new(mem) impl(p, static_cast<Deleter&&>(d));
         }
     }
 
     /**
      * @brief 拷贝构造：共享所有权（增加引用计数）
      */
-    shared_ptr(const shared_ptr& other) noexcept
+    basic_shared_ptr(const basic_shared_ptr& other) noexcept
         : ptr_(other.ptr_), ctrl_(other.ctrl_) {
         if (ctrl_ != nullptr) {
             ctrl_->add_ref();
@@ -286,7 +440,7 @@ public:
      * @brief 从兼容类型的 shared_ptr 拷贝构造（向上转型）
      */
     template<typename U>
-    shared_ptr(const shared_ptr<U>& other) noexcept
+    basic_shared_ptr(const basic_shared_ptr<U, RefCount>& other) noexcept
         : ptr_(other.ptr_), ctrl_(other.ctrl_) {
         if (ctrl_ != nullptr) {
             ctrl_->add_ref();
@@ -296,7 +450,7 @@ public:
     /**
      * @brief 移动构造：转移所有权（不改变引用计数）
      */
-    shared_ptr(shared_ptr&& other) noexcept
+    basic_shared_ptr(basic_shared_ptr&& other) noexcept
         : ptr_(other.ptr_), ctrl_(other.ctrl_) {
         other.ptr_  = nullptr;
         other.ctrl_ = nullptr;
@@ -306,7 +460,7 @@ public:
      * @brief 从兼容类型的 shared_ptr 移动构造
      */
     template<typename U>
-    shared_ptr(shared_ptr<U>&& other) noexcept
+    basic_shared_ptr(basic_shared_ptr<U, RefCount>&& other) noexcept
         : ptr_(other.ptr_), ctrl_(other.ctrl_) {
         other.ptr_  = nullptr;
         other.ctrl_ = nullptr;
@@ -317,7 +471,7 @@ public:
      *
      * 如果计数归零，销毁托管对象
      */
-    ~shared_ptr() noexcept {
+    ~basic_shared_ptr() noexcept {
         if (ctrl_ != nullptr) {
             ctrl_->release_ref();
         }
@@ -330,9 +484,9 @@ public:
     /**
      * @brief 拷贝赋值
      */
-    shared_ptr& operator=(const shared_ptr& other) noexcept {
+    basic_shared_ptr& operator=(const basic_shared_ptr& other) noexcept {
         // copy-and-swap 保证异常安全和自赋值安全
-        shared_ptr tmp(other);
+        basic_shared_ptr tmp(other);
         swap(tmp);
         return *this;
     }
@@ -340,8 +494,8 @@ public:
     /**
      * @brief 移动赋值
      */
-    shared_ptr& operator=(shared_ptr&& other) noexcept {
-        shared_ptr tmp(static_cast<shared_ptr&&>(other));
+    basic_shared_ptr& operator=(basic_shared_ptr&& other) noexcept {
+        basic_shared_ptr tmp(static_cast<basic_shared_ptr&&>(other));
         swap(tmp);
         return *this;
     }
@@ -349,7 +503,7 @@ public:
     /**
      * @brief 赋值 nullptr（相当于 reset()）
      */
-    shared_ptr& operator=(decltype(nullptr)) noexcept {
+    basic_shared_ptr& operator=(decltype(nullptr)) noexcept {
         reset();
         return *this;
     }
@@ -364,7 +518,7 @@ public:
      * 释放当前持有的对象，引用计数减一
      */
     void reset() noexcept {
-        shared_ptr tmp;
+        basic_shared_ptr tmp;
         swap(tmp);
     }
 
@@ -373,14 +527,14 @@ public:
      * @param p 新托管的指针
      */
     void reset(T* p) {
-        shared_ptr tmp(p);
+        basic_shared_ptr tmp(p);
         swap(tmp);
     }
 
     /**
      * @brief 交换两个 shared_ptr
      */
-    void swap(shared_ptr& other) noexcept {
+    void swap(basic_shared_ptr& other) noexcept {
         zen::swap(ptr_,  other.ptr_);
         zen::swap(ctrl_, other.ctrl_);
     }
@@ -422,10 +576,10 @@ public:
     /**
      * @brief 返回当前强引用计数
      *
-     * 注意：线程不安全的读取，仅用于调试或测试
+     * 注意：多线程下只是瞬时值，仅用于调试或测试
      */
     long use_count() const noexcept {
-        return ctrl_ != nullptr ? ctrl_->shared_count : 0L;
+        return ctrl_ != nullptr ? ctrl_->use_count() : 0L;
     }
 
     /**
@@ -434,42 +588,68 @@ public:
     bool unique() const noexcept {
         return use_count() == 1L;
     }
+
+    /**
+     * @brief 是否与 other 共享同一个控制块
+     */
+    template<typename U>
+    bool owner_equal(const basic_shared_ptr<U, RefCount>& other) const noexcept {
+        return ctrl_ == other.ctrl_;
+    }
 };
 
-// ============================================================================
-// make_shared - 推荐的创建方式（对象和控制块一次性分配）
-// ============================================================================
+template<typename T>
+using shared_ptr = basic_shared_ptr<T, default_ref_count>;
 
-/**
- * @brief 控制块与对象合并的版本（减少一次内存分配）
- * @tparam T 对象类型
- */
 template<typename T>
-struct control_block_inplace : control_block {
-    // 使用对齐存储，避免直接构造
-    alignas(T) char storage_[sizeof(T)];
+using local_shared_ptr = basic_shared_ptr<T, single_thread_ref_count>;
 
-    template<typename... Args>
-    explicit control_block_inplace(Args&&... args)
-        : control_block() {
-        ::new(storage_) T(static_cast<Args&&>(args)...);
-    }
+namespace detail {
 
-    T* get() noexcept {
-        return reinterpret_cast<T*>(storage_);
-    }
+/**
+ * @brief 库内部访问 basic_shared_ptr 私有成员的入口
+ */
+template<typename T, typename RefCount>
+struct shared_ptr_access {
+    using pointer_type = basic_shared_ptr<T, RefCount>;
+    using block_type   = basic_control_block<RefCount>;
 
-    void destroy_object() noexcept override {
-        // 显式调用析构函数，不释放内存
-        reinterpret_cast<T*>(storage_)->~T();
-    }
+    /** 接管 ctrl 上一个已计入的强引用 */
+    static pointer_type adopt(T* p, block_type* ctrl) noexcept { return pointer_type(p, ctrl); }
 
-    void destroy_block() noexcept override {
-        this->~control_block_inplace();
-        ::operator delete(this);
+    /** 放弃所有权但不减少计数（引用转交给调用者） */
+    static void detach(pointer_type& sp, T** p, block_type** ctrl) noexcept {
+        *p = sp.ptr_;
+        *ctrl = sp.ctrl_;
+        sp.ptr_ = nullptr;
+        sp.ctrl_ = nullptr;
     }
+
+    static T*          get(const pointer_type& sp) noexcept  { return sp.ptr_; }
+    static block_type* block(const pointer_type& sp) noexcept { return sp.ctrl_; }
 };
 
+template<typename T, typename RefCount, typename... Args>
+basic_shared_ptr<T, RefCount> make_shared_with(Args&&... args) {
+    using block = control_block_inplace<T, RefCount>;
+    // 一次分配控制块（内嵌对象）
+    void* mem = allocate_block<block>();
+    block* cb;
+    try {
+        cb = ::new(mem) block(static_cast<Args&&>(args)...);
+    } catch (...) {
+        deallocate_block<block>(mem);
+        throw;
+    }
+    return shared_ptr_access<T, RefCount>::adopt(cb->get(), cb);
+}
+
+} // namespace detail
+
+// ============================================================================
+// make_shared - 推荐的创建方式（对象和控制块一次性分配）
+// ============================================================================
+
 /**
  * @brief 一次内存分配同时创建对象和控制块
  * @tparam T 对象类型
@@ -488,50 +668,59 @@ struct control_block_inplace : control_block {
  */
 template<typename T, typename... Args>
 shared_ptr<T> make_shared(Args&&... args) {
-    // 一次分配控制块（内嵌对象）
-    auto* cb = static_cast<control_block_inplace<T>*>(
-        ::operator new(sizeof(control_block_inplace<T>))
-    );
-    ::new(cb) control_block_inplace<T>(static_cast<Args&&>(args)...);
+    return detail::make_shared_with<T, default_ref_count>(static_cast<Args&&>(args)...);
+}
 
-    // 使用带 tag 的私有构造，避免与 Deleter 构造函数的歧义
-    return shared_ptr<T>(cb->get(), cb, typename shared_ptr<T>::make_shared_tag{});
+/**
+ * @brief make_shared 的非原子计数版本
+ */
+template<typename T, typename... Args>
+local_shared_ptr<T> make_local_shared(Args&&... args) {
+    return detail::make_shared_with<T, single_thread_ref_count>(static_cast<Args&&>(args)...);
 }
 
 // ============================================================================
 // 比较运算符
 // ============================================================================
 
-template<typename T, typename U>
-bool operator==(const shared_ptr<T>& a, const shared_ptr<U>& b) noexcept {
+template<typename T, typename U, typename R>
+bool operator==(const basic_shared_ptr<T, R>& a, const basic_shared_ptr<U, R>& b) noexcept {
     return a.get() == b.get();
 }
 
-template<typename T, typename U>
-bool operator!=(const shared_ptr<T>& a, const shared_ptr<U>& b) noexcept {
+template<typename T, typename U, typename R>
+bool operator!=(const basic_shared_ptr<T, R>& a, const basic_shared_ptr<U, R>& b) noexcept {
     return a.get() != b.get();
 }
 
-template<typename T>
-bool operator==(const shared_ptr<T>& a, decltype(nullptr)) noexcept {
+template<typename T, typename R>
+bool operator==(const basic_shared_ptr<T, R>& a, decltype(nullptr)) noexcept {
     return a.get() == nullptr;
 }
 
-template<typename T>
-bool operator==(decltype(nullptr), const shared_ptr<T>& a) noexcept {
+template<typename T, typename R>
+bool operator==(decltype(nullptr), const basic_shared_ptr<T, R>& a) noexcept {
     return a.get() == nullptr;
 }
 
-template<typename T>
-bool operator!=(const shared_ptr<T>& a, decltype(nullptr)) noexcept {
+template<typename T, typename R>
+bool operator!=(const basic_shared_ptr<T, R>& a, decltype(nullptr)) noexcept {
     return a.get() != nullptr;
 }
 
-template<typename T>
-bool operator!=(decltype(nullptr), const shared_ptr<T>& a) noexcept {
+template<typename T, typename R>
+bool operator!=(decltype(nullptr), const basic_shared_ptr<T, R>& a) noexcept {
     return a.get() != nullptr;
 }
 
+/**
+ * @brief 平凡重定位：{ ptr_, ctrl_ } 按字节搬移即可，不需要改动引用计数
+ */
+template<typename T, typename R>
+struct is_trivially_relocatable<basic_shared_ptr<T, R>> {
+    static constexpr bool value = true;
+};
+
 } // namespace zen
 
 #endif // ZEN_MEMORY_SHARED_PTR_H
@@ -1,5 +1,15 @@
-#pragma once
+#ifndef ZEN_MEMORY_SMART_PTR_H
+#define ZEN_MEMORY_SMART_PTR_H
 
-namespace zen {
+// 智能指针
+// - unique_ptr<T, D>        ：独占所有权
+// - shared_ptr / weak_ptr   ：原子引用计数的共享所有权
+// - local_shared_ptr / local_weak_ptr：非原子计数版本（单线程内共享）
+// - atomic_shared_ptr<T>    ：多线程并发发布 / 读取 shared_ptr 快照
 
-} // namespace zen
+#include "unique_ptr.h"
+#include "shared_ptr.h"
+#include "weak_ptr.h"
+#include "atomic_shared_ptr.h"
+
+#endif // ZEN_MEMORY_SMART_PTR_H
@@ -0,0 +1,555 @@
+#ifndef ZEN_MEMORY_THREAD_CACHE_H
+#define ZEN_MEMORY_THREAD_CACHE_H
+
+#include "../base/type_traits.h"
+#include "memory_resource.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define ZEN_TC_HAVE_MMAP 1
+#else
+#define ZEN_TC_HAVE_MMAP 0
+#endif
+
+namespace zen {
+
+// ============================================================================
+// 线程缓存分配器（thread-caching allocator）
+//
+// 三层结构：
+//   1. 线程缓存：每个线程每个大小级别一条空闲链表，分配 / 释放只做链表 push / pop，
+//      不加锁、不做原子操作
+//   2. 中心转移表：每个级别一个无锁栈，元素是"一批"对象（batch）；
+//      线程缓存空了就整批取，攒多了就整批还，跨线程释放的对象也经由这里流转
+//   3. 页堆：以 64 MiB 为单位 mmap 地址空间，切成 256 KiB、按 256 KiB 对齐的 span；
+//      每个 span 只服务一个级别，span 头记录级别，因此 tc_free(p) 只需把
+//      p 向下对齐到 span 边界即可找到级别
+//
+// 大于 32 KiB 的请求单独 mmap（同样带对齐的头部），释放时直接 munmap。
+// span 一经切分就不再归还操作系统。
+//
+// 构建时开启 ZEN_ALLOCATOR_THREAD_CACHE（CMake 选项同名）后，
+// zen::allocator<T> 的默认后端切换为本分配器。
+// ============================================================================
+
+static constexpr size_t TC_SPAN_SIZE   = 256 * 1024;         ///< span 大小与对齐
+static constexpr size_t TC_REGION_SIZE = 64 * 1024 * 1024;   ///< 页堆每次向系统申请的地址空间
+static constexpr size_t TC_MAX_SMALL   = 32 * 1024;          ///< 走线程缓存的最大请求
+static constexpr size_t TC_MIN_ALIGN   = 16;                 ///< 所有返回地址至少 16 字节对齐
+static constexpr size_t TC_NUM_CLASSES = 40;
+
+namespace detail {
+
+// ----------------------------------------------------------------------------
+// 大小级别
+//   16 ~ 128：步长 16（8 级）
+//   128 ~ 32K：每个 2 的幂区间再分 4 级（32 级），内部碎片不超过 25%
+// ----------------------------------------------------------------------------
+
+inline unsigned tc_log2(size_t v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(static_cast<unsigned long long>(v)));
+#else
+    unsigned r = 0;
+    while (v >>= 1) ++r;
+    return r;
+#endif
+}
+
+inline size_t tc_class_index(size_t size) noexcept {
+    if (size <= 128) return size == 0 ? 0 : (size + 15) / 16 - 1;
+    unsigned lg = tc_log2(size - 1);
+    return 8 + (lg - 7) * 4 + ((size - 1) >> (lg - 2)) - 4;
+}
+
+inline constexpr size_t tc_class_size(size_t idx) noexcept {
+    return idx < 8 ? (idx + 1) * 16
+                   : (size_t(1) << (7 + (idx - 8) / 4)) +
+                     ((idx - 8) % 4 + 1) * (size_t(1) << (5 + (idx - 8) / 4));
+}
+
+/** 线程缓存与中心表之间一次转移的对象数 */
+inline constexpr uint32_t tc_batch_size(size_t idx) noexcept {
+    return tc_class_size(idx) >= 16384 ? 2
+         : 32768 / tc_class_size(idx) > 64 ? 64
+         : static_cast<uint32_t>(32768 / tc_class_size(idx));
+}
+
+// ----------------------------------------------------------------------------
+// span 头（位于每个 span / 大对象映射的起始处）
+// ----------------------------------------------------------------------------
+
+static constexpr uint32_t TC_HUGE_CLASS = 0xFFFFu;
+static constexpr size_t   TC_HEADER     = 64;
+
+struct tc_span {
+    uint32_t size_class;    ///< 级别下标；大对象为 TC_HUGE_CLASS
+    uint32_t reserved;
+    size_t   map_bytes;     ///< 大对象：整个映射的字节数
+    void*    map_base;      ///< 大对象：mmap 返回的地址（munmap 用）
+};
+
+inline tc_span* tc_span_of(const void* p) noexcept {
+    return reinterpret_cast<tc_span*>(reinterpret_cast<uintptr_t>(p) & ~(uintptr_t(TC_SPAN_SIZE) - 1));
+}
+
+// ----------------------------------------------------------------------------
+// 系统内存
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief 申请 bytes 字节、按 TC_SPAN_SIZE 对齐的内存
+ * @param base 输出：实际映射的起始地址与长度（用于释放）
+ */
+inline void* tc_map_aligned(size_t bytes, void** base, size_t* base_len) {
+#if ZEN_TC_HAVE_MMAP
+    size_t len = bytes + TC_SPAN_SIZE;
+    void* m = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (m == MAP_FAILED) throw std::bad_alloc();
+    uintptr_t start   = reinterpret_cast<uintptr_t>(m);
+    uintptr_t aligned = (start + TC_SPAN_SIZE - 1) & ~(uintptr_t(TC_SPAN_SIZE) - 1);
+    // 裁掉首尾多余部分
+    if (aligned > start) ::munmap(m, aligned - start);
+    uintptr_t tail = start + len - (aligned + bytes);
+    if (tail) ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+    *base = reinterpret_cast<void*>(aligned);
+    *base_len = bytes;
+    return reinterpret_cast<void*>(aligned);
+#else
+    void* p = ::operator new(bytes, std::align_val_t(TC_SPAN_SIZE));
+    *base = p;
+    *base_len = bytes;
+    return p;
+#endif
+}
+
+inline void tc_unmap(void* base, size_t len) noexcept {
+#if ZEN_TC_HAVE_MMAP
+    ::munmap(base, len);
+#else
+    (void)len;
+    ::operator delete(base, std::align_val_t(TC_SPAN_SIZE));
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// 统计
+// ----------------------------------------------------------------------------
+
+struct tc_global_stats {
+    std::atomic<int64_t>  bytes_in_use{0};
+    std::atomic<uint64_t> span_bytes{0};
+    std::atomic<uint64_t> huge_bytes{0};
+    std::atomic<uint64_t> hits[TC_NUM_CLASSES];
+    std::atomic<uint64_t> misses[TC_NUM_CLASSES];
+
+    tc_global_stats() noexcept {
+        for (size_t i = 0; i < TC_NUM_CLASSES; ++i) {
+            hits[i].store(0, std::memory_order_relaxed);
+            misses[i].store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+inline tc_global_stats& tc_stats_global() noexcept {
+    static tc_global_stats s;
+    return s;
+}
+
+// ----------------------------------------------------------------------------
+// 页堆：切分 span（慢路径，全局互斥锁）
+// ----------------------------------------------------------------------------
+
+class tc_page_heap {
+public:
+    void* new_span(uint32_t cls) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (cur_ == end_) {
+            void* base;
+            size_t len;
+            cur_ = static_cast<char*>(tc_map_aligned(TC_REGION_SIZE, &base, &len));
+            end_ = cur_ + TC_REGION_SIZE;
+        }
+        tc_span* s = reinterpret_cast<tc_span*>(cur_);
+        cur_ += TC_SPAN_SIZE;
+        s->size_class = cls;
+        s->map_bytes  = 0;
+        s->map_base   = nullptr;
+        tc_stats_global().span_bytes.fetch_add(TC_SPAN_SIZE, std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    std::mutex mtx_;
+    char*      cur_ = nullptr;
+    char*      end_ = nullptr;
+};
+
+// ----------------------------------------------------------------------------
+// 中心转移表：每级一个 Treiber 栈，元素为一批对象
+//
+// 一批对象用对象首字串成链表；批首对象的第二个字记录"下一批"指针与本批个数。
+// 栈顶是带 16 位版本号的指针（x86-64 / AArch64 用户态地址不超过 48 位），
+// 防止 ABA；span 内存永不归还系统，因此读取已被他人弹出的批首是安全的。
+// ----------------------------------------------------------------------------
+
+struct tc_object {
+    tc_object* next;        ///< 批内链表
+    uint64_t   batch_link;  ///< 仅批首有效：下一批指针（低 48 位）| 本批个数（高 16 位）
+};
+
+inline uint64_t tc_pack(const void* p, uint64_t hi16) noexcept {
+    return (reinterpret_cast<uint64_t>(p) & 0x0000FFFFFFFFFFFFULL) | (hi16 << 48);
+}
+inline tc_object* tc_unpack_ptr(uint64_t v) noexcept {
+    return reinterpret_cast<tc_object*>(static_cast<uintptr_t>(v & 0x0000FFFFFFFFFFFFULL));
+}
+inline uint32_t tc_unpack_hi(uint64_t v) noexcept { return static_cast<uint32_t>(v >> 48); }
+
+class tc_central {
+public:
+    /** 压入一批（head 起 count 个对象，已串好） */
+    void push(tc_object* head, uint32_t count) noexcept {
+        uint64_t old = top_.load(std::memory_order_relaxed);
+        for (;;) {
+            __atomic_store_n(&head->batch_link, tc_pack(tc_unpack_ptr(old), count), __ATOMIC_RELAXED);
+            uint64_t nv = tc_pack(head, tc_unpack_hi(old) + 1);
+            if (top_.compare_exchange_weak(old, nv, std::memory_order_release, std::memory_order_relaxed)) return;
+        }
+    }
+
+    /** 弹出一批；返回批首并写出个数，空时返回 nullptr */
+    tc_object* pop(uint32_t* count) noexcept {
+        uint64_t old = top_.load(std::memory_order_acquire);
+        for (;;) {
+            tc_object* head = tc_unpack_ptr(old);
+            if (!head) return nullptr;
+            uint64_t link = __atomic_load_n(&head->batch_link, __ATOMIC_RELAXED);
+            uint64_t nv = tc_pack(tc_unpack_ptr(link), tc_unpack_hi(old) + 1);
+            if (top_.compare_exchange_weak(old, nv, std::memory_order_acquire, std::memory_order_acquire)) {
+                *count = tc_unpack_hi(link);
+                return head;
+            }
+        }
+    }
+
+    /** 转移表为空时从 span 切出新的一批（慢路径，按级别加锁） */
+    tc_object* carve(uint32_t cls, uint32_t n, tc_page_heap& heap, uint32_t* count) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        size_t sz = tc_class_size(cls);
+        tc_object* head = nullptr;
+        tc_object** tail = &head;
+        uint32_t got = 0;
+        while (got < n) {
+            if (cur_ + sz > end_) {
+                char* s = static_cast<char*>(heap.new_span(cls));
+                cur_ = s + TC_HEADER;
+                end_ = s + TC_SPAN_SIZE;
+            }
+            tc_object* o = reinterpret_cast<tc_object*>(cur_);
+            cur_ += sz;
+            *tail = o;
+            tail = &o->next;
+            ++got;
+        }
+        *tail = nullptr;
+        *count = got;
+        return head;
+    }
+
+private:
+    alignas(64) std::atomic<uint64_t> top_{0};
+    std::mutex mtx_;
+    char*      cur_ = nullptr;
+    char*      end_ = nullptr;
+};
+
+struct tc_globals {
+    tc_page_heap heap;
+    tc_central   central[TC_NUM_CLASSES];
+};
+
+inline tc_globals& tc_global() {
+    static tc_globals* g = new tc_globals();   // 永不析构：线程退出时可能仍在释放内存
+    return *g;
+}
+
+// ----------------------------------------------------------------------------
+// 线程缓存
+// ----------------------------------------------------------------------------
+
+struct tc_class_cache {
+    tc_object* head;
+    uint32_t   count;
+    uint32_t   hits;        ///< 自上次汇总以来命中线程缓存的次数
+    uint32_t   misses;
+};
+
+/**
+ * 线程缓存本身是平凡类型的 thread_local（零初始化、无析构守卫开销），
+ * 线程退出时由另一个 thread_local 守卫对象负责归还。
+ */
+struct tc_thread_cache {
+    tc_class_cache cls[TC_NUM_CLASSES];
+    int64_t        bytes_delta;     ///< 未汇总到全局的 bytes_in_use 变化
+    int            state;           ///< 0 未初始化，1 可用，2 已销毁
+};
+
+inline thread_local tc_thread_cache tc_tls;
+
+inline void tc_flush_stats(tc_thread_cache& tc) noexcept {
+    tc_global_stats& gs = tc_stats_global();
+    if (tc.bytes_delta) {
+        gs.bytes_in_use.fetch_add(tc.bytes_delta, std::memory_order_relaxed);
+        tc.bytes_delta = 0;
+    }
+    for (size_t i = 0; i < TC_NUM_CLASSES; ++i) {
+        tc_class_cache& c = tc.cls[i];
+        if (c.hits)   { gs.hits[i].fetch_add(c.hits, std::memory_order_relaxed);     c.hits = 0; }
+        if (c.misses) { gs.misses[i].fetch_add(c.misses, std::memory_order_relaxed); c.misses = 0; }
+    }
+}
+
+/** 把一个级别的线程缓存中的前 n 个对象作为一批还给中心表 */
+inline void tc_release_batch(tc_class_cache& c, uint32_t cls, uint32_t n) noexcept {
+    tc_object* head = c.head;
+    tc_object* last = head;
+    for (uint32_t i = 1; i < n; ++i) last = last->next;
+    c.head = last->next;
+    last->next = nullptr;
+    c.count -= n;
+    tc_global().central[cls].push(head, n);
+}
+
+inline void tc_thread_exit(tc_thread_cache& tc) noexcept {
+    for (uint32_t i = 0; i < TC_NUM_CLASSES; ++i) {
+        tc_class_cache& c = tc.cls[i];
+        if (c.count) tc_release_batch(c, i, c.count);
+    }
+    tc_flush_stats(tc);
+    tc.state = 2;
+}
+
+struct tc_exit_guard {
+    ~tc_exit_guard() { tc_thread_exit(tc_tls); }
+};
+
+inline void tc_thread_init(tc_thread_cache& tc) {
+    static thread_local tc_exit_guard guard;
+    (void)&guard;
+    tc.state = 1;
+}
+
+/** 线程缓存为空：从中心表取一批，不够就切新 span */
+inline void* tc_refill(tc_thread_cache& tc, uint32_t cls) {
+    tc_globals& g = tc_global();
+    uint32_t n = 0;
+    tc_object* head = g.central[cls].pop(&n);
+    if (!head) head = g.central[cls].carve(cls, tc_batch_size(cls), g.heap, &n);
+
+    tc_class_cache& c = tc.cls[cls];
+    ++c.misses;
+    c.head  = head->next;
+    c.count = n - 1;
+    tc_flush_stats(tc);
+    return head;
+}
+
+/** 线程缓存已销毁（线程退出阶段）时的分配：直接和中心表交换 */
+inline void* tc_alloc_no_cache(uint32_t cls) {
+    tc_globals& g = tc_global();
+    uint32_t n = 0;
+    tc_object* head = g.central[cls].pop(&n);
+    if (!head) head = g.central[cls].carve(cls, tc_batch_size(cls), g.heap, &n);
+    if (n > 1) g.central[cls].push(head->next, n - 1);
+    tc_stats_global().bytes_in_use.fetch_add(static_cast<int64_t>(tc_class_size(cls)), std::memory_order_relaxed);
+    return head;
+}
+
+inline void* tc_alloc_huge(size_t size) {
+    size_t bytes = (size + TC_HEADER + 4095) & ~size_t(4095);
+    void* base;
+    size_t len;
+    tc_span* s = static_cast<tc_span*>(tc_map_aligned(bytes, &base, &len));
+    s->size_class = TC_HUGE_CLASS;
+    s->map_bytes  = len;
+    s->map_base   = base;
+    tc_global_stats& gs = tc_stats_global();
+    gs.huge_bytes.fetch_add(len, std::memory_order_relaxed);
+    gs.bytes_in_use.fetch_add(static_cast<int64_t>(len), std::memory_order_relaxed);
+    return reinterpret_cast<char*>(s) + TC_HEADER;
+}
+
+inline void tc_free_huge(tc_span* s) noexcept {
+    tc_global_stats& gs = tc_stats_global();
+    gs.huge_bytes.fetch_sub(s->map_bytes, std::memory_order_relaxed);
+    gs.bytes_in_use.fetch_sub(static_cast<int64_t>(s->map_bytes), std::memory_order_relaxed);
+    tc_unmap(s->map_base, s->map_bytes);
+}
+
+inline void tc_free_class(void* p, uint32_t cls) noexcept {
+    tc_thread_cache& tc = tc_tls;
+    tc_object* o = static_cast<tc_object*>(p);
+    if (tc.state != 1) {
+        if (tc.state == 2) {
+            // 线程缓存已销毁：单个对象作为一批直接还给中心表
+            o->next = nullptr;
+            tc_global().central[cls].push(o, 1);
+            tc_stats_global().bytes_in_use.fetch_sub(static_cast<int64_t>(tc_class_size(cls)), std::memory_order_relaxed);
+            return;
+        }
+        tc_thread_init(tc);     // 只释放不分配的线程（如生产者-消费者中的消费者）也建立缓存
+    }
+    tc_class_cache& c = tc.cls[cls];
+    o->next = c.head;
+    c.head = o;
+    tc.bytes_delta -= static_cast<int64_t>(tc_class_size(cls));
+    uint32_t batch = tc_batch_size(cls);
+    if (++c.count > 2 * batch) {
+        tc_release_batch(c, cls, batch);
+        tc_flush_stats(tc);
+    }
+}
+
+} // namespace detail
+
+// ============================================================================
+// 公共接口
+// ============================================================================
+
+/**
+ * @brief 分配 size 字节（16 字节对齐），失败抛 std::bad_alloc
+ */
+inline void* tc_malloc(size_t size) {
+    using namespace detail;
+    if (size > TC_MAX_SMALL) return tc_alloc_huge(size);
+    uint32_t cls = static_cast<uint32_t>(tc_class_index(size));
+    tc_thread_cache& tc = tc_tls;
+    if (tc.state != 1) {
+        if (tc.state == 2) return tc_alloc_no_cache(cls);
+        tc_thread_init(tc);
+    }
+    tc_class_cache& c = tc.cls[cls];
+    tc.bytes_delta += static_cast<int64_t>(tc_class_size(cls));
+    tc_object* o = c.head;
+    if (o) {
+        c.head = o->next;
+        --c.count;
+        ++c.hits;
+        return o;
+    }
+    return tc_refill(tc, cls);
+}
+
+/**
+ * @brief 释放 tc_malloc 得到的内存（通过 span 头查找大小级别）
+ */
+inline void tc_free(void* p) noexcept {
+    using namespace detail;
+    if (!p) return;
+    tc_span* s = tc_span_of(p);
+    if (s->size_class == TC_HUGE_CLASS) tc_free_huge(s);
+    else tc_free_class(p, s->size_class);
+}
+
+/**
+ * @brief 已知分配大小时的释放：小对象无需读取 span 头
+ */
+inline void tc_free_sized(void* p, size_t size) noexcept {
+    using namespace detail;
+    if (!p) return;
+    if (size > TC_MAX_SMALL) tc_free_huge(tc_span_of(p));
+    else tc_free_class(p, static_cast<uint32_t>(tc_class_index(size)));
+}
+
+/**
+ * @brief p 实际可用的字节数（级别大小）
+ */
+inline size_t tc_usable_size(const void* p) noexcept {
+    using namespace detail;
+    tc_span* s = tc_span_of(p);
+    if (s->size_class == TC_HUGE_CLASS) return s->map_bytes - TC_HEADER;
+    return tc_class_size(s->size_class);
+}
+
+/**
+ * @brief 分配器统计快照
+ *
+ * 各线程的计数在慢路径（批量转移）和线程退出时汇总到全局，
+ * 因此是近似值；调用 tc_flush_thread_stats() 可先汇总当前线程。
+ */
+struct tc_stats {
+    int64_t  bytes_in_use;      ///< 已分配未释放的字节数（按级别大小计）
+    uint64_t span_bytes;        ///< 小对象 span 占用的地址空间
+    uint64_t huge_bytes;        ///< 大对象映射的字节数
+
+    struct class_info {
+        size_t   size;
+        uint64_t hits;          ///< 由线程缓存直接满足的分配次数
+        uint64_t misses;        ///< 需要访问中心表的次数
+
+        double hit_rate() const noexcept {
+            uint64_t total = hits + misses;
+            return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+        }
+    } classes[TC_NUM_CLASSES];
+};
+
+inline void tc_flush_thread_stats() noexcept {
+    if (detail::tc_tls.state == 1) detail::tc_flush_stats(detail::tc_tls);
+}
+
+inline tc_stats tc_get_stats() noexcept {
+    detail::tc_global_stats& gs = detail::tc_stats_global();
+    tc_stats s;
+    s.bytes_in_use = gs.bytes_in_use.load(std::memory_order_relaxed);
+    s.span_bytes   = gs.span_bytes.load(std::memory_order_relaxed);
+    s.huge_bytes   = gs.huge_bytes.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < TC_NUM_CLASSES; ++i) {
+        s.classes[i].size   = detail::tc_class_size(i);
+        s.classes[i].hits   = gs.hits[i].load(std::memory_order_relaxed);
+        s.classes[i].misses = gs.misses[i].load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+// ============================================================================
+// memory_resource 适配
+// ============================================================================
+
+namespace detail {
+
+class tc_resource_impl : public memory_resource {
+protected:
+    void* do_allocate(size_t bytes, size_t align) override {
+        if (align > TC_MIN_ALIGN) return new_delete_resource()->allocate(bytes, align);
+        return tc_malloc(bytes);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        if (align > TC_MIN_ALIGN) {
+            new_delete_resource()->deallocate(p, bytes, align);
+            return;
+        }
+        tc_free_sized(p, bytes);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief 以线程缓存分配器为后端的 memory_resource（可作为 arena / pool 的上游）
+ */
+inline memory_resource* thread_caching_resource() noexcept {
+    static detail::tc_resource_impl instance;
+    return &instance;
+}
+
+} // namespace zen
+
+#endif // ZEN_MEMORY_THREAD_CACHE_H
@@ -0,0 +1,86 @@
+#ifndef ZEN_MEMORY_UNINITIALIZED_H
+#define ZEN_MEMORY_UNINITIALIZED_H
+
+#include "../base/type_traits.h"
+#include <cstring>      // memcpy, memmove
+
+namespace zen {
+
+// ============================================================================
+// 未初始化内存上的批量构造 / 重定位 / 销毁
+// ============================================================================
+//
+// 供连续存储的容器（vector、small_vector）在扩容、拷贝、插入删除时使用：
+// - 可平凡拷贝的类型：拷贝直接 memcpy
+// - 可平凡重定位的类型：搬移（移动构造 + 析构旧对象）直接 memcpy / memmove
+// - 可平凡析构的类型：销毁不做任何事
+// 其余类型逐个经由分配器 construct / destroy。
+// ============================================================================
+
+/**
+ * @brief 销毁 [first, last) 的元素（只调用析构，不释放内存）
+ */
+template<typename Alloc, typename T>
+void destroy_range(Alloc& alloc, T* first, T* last) noexcept {
+    if constexpr (!is_trivially_destructible_v<T>) {
+        for (T* p = first; p != last; ++p) {
+            alloc.destroy(p);
+        }
+    }
+}
+
+/**
+ * @brief 把 [first, last) 拷贝构造到未初始化的 dest（两段内存不重叠）
+ */
+template<typename Alloc, typename T>
+void uninitialized_copy(Alloc& alloc, const T* first, const T* last, T* dest) {
+    if constexpr (is_trivially_copyable_v<T>) {
+        if (first != last) {
+            memcpy(static_cast<void*>(dest), static_cast<const void*>(first),
+                   static_cast<decltype(sizeof(0))>(last - first) * sizeof(T));
+        }
+    } else {
+        for (; first != last; ++first, ++dest) {
+            alloc.construct(dest, *first);
+        }
+    }
+}
+
+/**
+ * @brief 把 [first, last) 重定位到未初始化的 dest（两段内存不重叠）
+ *
+ * 完成后 dest 中是原来的元素，[first, last) 变为未初始化内存（已析构）。
+ * 非平凡重定位的类型先全部移动构造、再统一析构旧对象。
+ */
+template<typename Alloc, typename T>
+void uninitialized_relocate(Alloc& alloc, T* first, T* last, T* dest) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (first != last) {
+            memcpy(static_cast<void*>(dest), static_cast<const void*>(first),
+                   static_cast<decltype(sizeof(0))>(last - first) * sizeof(T));
+        }
+    } else {
+        T* d = dest;
+        for (T* s = first; s != last; ++s, ++d) {
+            alloc.construct(d, static_cast<T&&>(*s));
+        }
+        destroy_range(alloc, first, last);
+    }
+}
+
+/**
+ * @brief 在同一块存储内把 [first, last) 重定位到 dest（可重叠）
+ * @pre is_trivially_relocatable_v<T>
+ */
+template<typename T>
+void relocate_overlapping(T* first, T* last, T* dest) noexcept {
+    static_assert(is_trivially_relocatable_v<T>, "byte-wise relocation requires a trivially relocatable type");
+    if (first != last && first != dest) {
+        memmove(static_cast<void*>(dest), static_cast<const void*>(first),
+                static_cast<decltype(sizeof(0))>(last - first) * sizeof(T));
+    }
+}
+
+} // namespace zen
+
+#endif // ZEN_MEMORY_UNINITIALIZED_H
@@ -657,6 +657,20 @@ bool operator>=(nullptr_t, const unique_ptr<T, D>& x) noexcept {
 template<typename T, typename D = default_delete<T>>
 using unique_ptr_t = unique_ptr<T, D>;
 
+// ============================================================================
+// 平凡重定位：只持有一个指针（默认删除器为空类），可按字节搬移
+// ============================================================================
+
+template<typename T>
+struct is_trivially_relocatable<unique_ptr<T, default_delete<T>>> {
+    static constexpr bool value = true;
+};
+
+template<typename T>
+struct is_trivially_relocatable<unique_ptr<T[], default_delete<T[]>>> {
+    static constexpr bool value = true;
+};
+
 } // namespace zen
 
 #endif // ZEN_MEMORY_UNIQUE_PTR_H
\ No newline at end of file
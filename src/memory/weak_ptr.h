@@ -12,6 +12,7 @@ namespace zen {
 /**
  * @brief 弱引用智能指针（不影响对象生命周期）
  * @tparam T 托管对象的类型
+ * @tparam RefCount 引用计数策略，与对应的 basic_shared_ptr 一致
  *
  * weak_ptr 持有对 shared_ptr 托管对象的弱引用。
  * 它不增加强引用计数，因此不会阻止对象被销毁。
@@ -38,11 +39,14 @@ namespace zen {
  * b->prev = a;  // 使用 weak_ptr，不会循环引用
  * @endcode
  */
-template<typename T>
-class weak_ptr {
+template<typename T, typename RefCount>
+class basic_weak_ptr {
 private:
-    T*             ptr_;  // 指向托管对象（不保证有效）
-    control_block* ctrl_; // 指向控制块
+    using shared_type = basic_shared_ptr<T, RefCount>;
+    using block_type  = basic_control_block<RefCount>;
+
+    T*          ptr_;  // 指向托管对象（不保证有效）
+    block_type* ctrl_; // 指向控制块
 
 public:
     // ========================================================================
@@ -52,7 +56,7 @@ public:
     /**
      * @brief 默认构造：空弱指针
      */
-    constexpr weak_ptr() noexcept
+    constexpr basic_weak_ptr() noexcept
         : ptr_(nullptr), ctrl_(nullptr) {
     }
 
@@ -62,7 +66,7 @@ public:
      *
      * 增加控制块的弱引用计数，不影响强引用计数。
      */
-    weak_ptr(const shared_ptr<T>& sp) noexcept
+    basic_weak_ptr(const shared_type& sp) noexcept
         : ptr_(sp.ptr_), ctrl_(sp.ctrl_) {
         if (ctrl_ != nullptr) {
             ctrl_->add_weak();
@@ -72,7 +76,7 @@ public:
     /**
      * @brief 拷贝构造
      */
-    weak_ptr(const weak_ptr& other) noexcept
+    basic_weak_ptr(const basic_weak_ptr& other) noexcept
         : ptr_(other.ptr_), ctrl_(other.ctrl_) {
         if (ctrl_ != nullptr) {
             ctrl_->add_weak();
@@ -82,7 +86,7 @@ public:
     /**
      * @brief 移动构造（转移弱引用，不改变计数）
      */
-    weak_ptr(weak_ptr&& other) noexcept
+    basic_weak_ptr(basic_weak_ptr&& other) noexcept
         : ptr_(other.ptr_), ctrl_(other.ctrl_) {
         other.ptr_  = nullptr;
         other.ctrl_ = nullptr;
@@ -93,7 +97,7 @@ public:
      *
      * 若弱引用归零，控制块内存被释放（对象可能已提前销毁）
      */
-    ~weak_ptr() noexcept {
+    ~basic_weak_ptr() noexcept {
         if (ctrl_ != nullptr) {
             ctrl_->release_weak();
         }
@@ -106,8 +110,8 @@ public:
     /**
      * @brief 从 shared_ptr 赋值
      */
-    weak_ptr& operator=(const shared_ptr<T>& sp) noexcept {
-        weak_ptr tmp(sp);
+    basic_weak_ptr& operator=(const shared_type& sp) noexcept {
+        basic_weak_ptr tmp(sp);
         swap(tmp);
         return *this;
     }
@@ -115,8 +119,8 @@ public:
     /**
      * @brief 拷贝赋值
      */
-    weak_ptr& operator=(const weak_ptr& other) noexcept {
-        weak_ptr tmp(other);
+    basic_weak_ptr& operator=(const basic_weak_ptr& other) noexcept {
+        basic_weak_ptr tmp(other);
         swap(tmp);
         return *this;
     }
@@ -124,8 +128,8 @@ public:
     /**
      * @brief 移动赋值
      */
-    weak_ptr& operator=(weak_ptr&& other) noexcept {
-        weak_ptr tmp(static_cast<weak_ptr&&>(other));
+    basic_weak_ptr& operator=(basic_weak_ptr&& other) noexcept {
+        basic_weak_ptr tmp(static_cast<basic_weak_ptr&&>(other));
         swap(tmp);
         return *this;
     }
@@ -138,14 +142,14 @@ public:
      * @brief 重置为空弱引用
      */
     void reset() noexcept {
-        weak_ptr tmp;
+        basic_weak_ptr tmp;
         swap(tmp);
     }
 
     /**
      * @brief 交换两个 weak_ptr
      */
-    void swap(weak_ptr& other) noexcept {
+    void swap(basic_weak_ptr& other) noexcept {
         zen::swap(ptr_,  other.ptr_);
         zen::swap(ctrl_, other.ctrl_);
     }
@@ -158,7 +162,7 @@ public:
      * @brief 返回当前强引用计数（即观察的对象被多少 shared_ptr 持有）
      */
     long use_count() const noexcept {
-        return ctrl_ != nullptr ? ctrl_->shared_count : 0L;
+        return ctrl_ != nullptr ? ctrl_->use_count() : 0L;
     }
 
     /**
@@ -183,13 +187,14 @@ public:
      * // 若 lock() 返回空，说明对象已被销毁
      * @endcode
      */
-    shared_ptr<T> lock() const noexcept {
+    shared_type lock() const noexcept {
+        // 原子策略下用 CAS 升级：计数为 0 时不会"复活"已销毁的对象
         if (ctrl_ == nullptr || !ctrl_->try_add_ref()) {
-            return shared_ptr<T>(); // 返回空 shared_ptr
+            return shared_type(); // 返回空 shared_ptr
         }
         // 成功增加强引用，构造 shared_ptr
         // 使用友元访问私有构造函数
-        return shared_ptr<T>(ptr_, ctrl_);
+        return shared_type(ptr_, ctrl_);
     }
 };
 
@@ -197,11 +202,22 @@ public:
 // 非成员 swap
 // ============================================================================
 
-template<typename T>
-void swap(weak_ptr<T>& a, weak_ptr<T>& b) noexcept {
+template<typename T, typename R>
+void swap(basic_weak_ptr<T, R>& a, basic_weak_ptr<T, R>& b) noexcept {
     a.swap(b);
 }
 
+template<typename T, typename R>
+struct is_trivially_relocatable<basic_weak_ptr<T, R>> {
+    static constexpr bool value = true;
+};
+
+template<typename T>
+using weak_ptr = basic_weak_ptr<T, default_ref_count>;
+
+template<typename T>
+using local_weak_ptr = basic_weak_ptr<T, single_thread_ref_count>;
+
 } // namespace zen
 
 #endif // ZEN_MEMORY_WEAK_PTR_H
@@ -8,12 +8,16 @@
  * - future       : 获取异步任务的结果或异常
  * - packaged_task: 打包任务，便于异步执行
  * - shared_future: 多个 future 共享同一结果
+ * - then / when_all / when_any / make_ready_future : 组合异步结果，不占用等待线程
  * 
  * 特性：
  * - 支持任意类型的返回值
  * - 支持异常传播
  * - 支持超时等待
  * - shared_future 可拷贝，future 不可拷贝
+ * - 共享状态无锁：一个原子状态字兼回调链表头，set_value 不加锁；
+ *   只有真正阻塞等待的线程才使用等待者的互斥锁与条件变量（每个状态一个，
+ *   反复超时等待不会累积分配）
  * 
  * 示例：
  * @code
@@ -31,6 +35,14 @@
  * zen::future<int> f = task.get_future();
  * std::thread(std::move(task)).detach();
  * std::cout << f.get() << std::endl;
+ * 
+ * // 续接与组合
+ * zen::future<std::string> s = pool.submit(load, id)
+ *     .then(pool, [](Record r) { return render(r); });
+ * auto both = zen::when_all(pool.submit(a), pool.submit(b))
+ *     .then([](std::tuple<zen::future<int>, zen::future<int>> t) {
+ *         return std::get<0>(t).get() + std::get<1>(t).get();
+ *     });
  * @endcode
  */
 #ifndef ZEN_THREADING_FUTURE_FUTURE_H
@@ -44,12 +56,100 @@
 #include "../../base/type_traits.h"
 #include "../thread/thread.h"
 
+#include <atomic>
+#include <chrono>
 #include <stdexcept>
 #include <exception>
+#include <functional>  // std::invoke
+#include <future>      // std::future_error / std::future_errc
+#include <iterator>
 #include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace zen {
 
+template<typename T> class future;
+template<typename T> class shared_future;
+template<typename T> class promise;
+
+// ============================================================================
+// then() 的结果类型
+// ============================================================================
+
+namespace detail {
+
+template<typename T>
+struct unwrap_future { using type = T; };
+
+template<typename U>
+struct unwrap_future<future<U>> { using type = U; };
+
+template<typename T>
+struct is_future : std::false_type {};
+
+template<typename U>
+struct is_future<future<U>> : std::true_type {};
+
+template<typename U>
+struct is_future<shared_future<U>> : std::true_type {};
+
+template<typename F, typename Arg>
+struct value_invoke { using type = typename std::invoke_result<F, Arg>::type; };
+
+template<typename F>
+struct value_invoke<F, void> { using type = typename std::invoke_result<F>::type; };
+
+// 回调按值接收结果时的参数类型
+template<typename Source>
+struct then_value_arg;
+
+template<typename T>
+struct then_value_arg<future<T>> { using type = T; };
+
+template<typename T>
+struct then_value_arg<shared_future<T>> { using type = const T&; };
+
+template<>
+struct then_value_arg<shared_future<void>> { using type = void; };
+
+/**
+ * @brief then(f) 的回调形态与结果类型
+ *
+ * f 能以 Source（future / shared_future）调用时传入 Source，否则传入结果值；
+ * f 返回 future<U> 时结果展开为 U。
+ */
+template<typename Source, typename F>
+struct then_traits {
+    using fn_type = typename std::decay<F>::type;
+    static constexpr bool takes_source = std::is_invocable<fn_type, Source>::value;
+    using raw = typename std::conditional<takes_source,
+                                          std::invoke_result<fn_type, Source>,
+                                          value_invoke<fn_type, typename then_value_arg<Source>::type>
+                                         >::type::type;
+    using result = typename unwrap_future<typename std::decay<raw>::type>::type;
+};
+
+template<typename Source, typename F>
+using then_result_t = typename then_traits<Source, F>::result;
+
+} // namespace detail
+
+namespace detail {
+
+/**
+ * @brief 把 chrono 时长换算成 condition_variable::wait_for 使用的毫秒数
+ */
+template<typename Rep, typename Period>
+inline unsigned long to_wait_ms(const std::chrono::duration<Rep, Period>& d) {
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+    return ms > 0 ? static_cast<unsigned long>(ms) : 0UL;
+}
+
+} // namespace detail
+
 // ============================================================================
 // future_state：存储异步结果或异常
 // ============================================================================
@@ -57,203 +157,325 @@ namespace zen {
 namespace detail {
 
 /**
- * @brief 异步结果状态
- * 
- * 存储计算结果或异常，线程安全。
+ * @brief 结果就绪时要执行的回调（侵入式链表节点）
+ *
+ * fire 执行回调并释放节点。then() / when_all() / 阻塞等待都以节点形式挂在状态上。
  */
-template<typename T>
-class future_state {
-public:
-    future_state() : ready_(false) {}
-    
-    /**
-     * @brief 设置值
-     */
-    void set_value(const T& value) {
-        lock_guard<mutex> lock(mutex_);
-        if (ready_) {
-            throw std::future_error(std::future_errc::promise_already_satisfied);
-        }
-        value_ = value;
-        ready_ = true;
-        cond_.notify_all();
+struct future_continuation {
+    future_continuation* next = nullptr;
+    void (*fire)(future_continuation*) noexcept = nullptr;
+};
+
+template<typename F>
+struct future_continuation_impl final : future_continuation {
+    F fn;
+
+    explicit future_continuation_impl(F&& f) : fn(std::move(f)) { fire = &run; }
+
+    static void run(future_continuation* c) noexcept {
+        auto* self = static_cast<future_continuation_impl*>(c);
+        self->fn();
+        delete self;
     }
-    
-    void set_value(T&& value) {
-        lock_guard<mutex> lock(mutex_);
-        if (ready_) {
-            throw std::future_error(std::future_errc::promise_already_satisfied);
-        }
-        value_ = std::move(value);
-        ready_ = true;
-        cond_.notify_all();
+};
+
+template<typename F>
+future_continuation* make_continuation(F&& f) {
+    using fn_type = typename std::decay<F>::type;
+    return new future_continuation_impl<fn_type>(fn_type(std::forward<F>(f)));
+}
+
+// 状态字取这个地址表示"已就绪"（不会被解引用）
+inline future_continuation future_ready_sentinel;
+
+/**
+ * @brief 阻塞等待者：挂在回调链表上，被唤醒时通知所有等待的线程
+ *
+ * 每个状态最多一个，由第一次阻塞等待创建、状态析构时释放；之后的等待
+ * （包括超时返回后重新等待）都复用它，不再分配，也不会在链表上堆积节点。
+ * 锁和条件变量只属于等待者，set_value 不需要获取状态上的锁。
+ */
+struct future_waiter final : future_continuation {
+    mutex              lock;
+    condition_variable cond;
+    bool               done = false;
+
+    future_waiter() { fire = &run; }
+
+    static void run(future_continuation* c) noexcept {
+        auto* self = static_cast<future_waiter*>(c);
+        lock_guard<mutex> guard(self->lock);
+        self->done = true;
+        self->cond.notify_all();
     }
-    
+};
+
+/**
+ * @brief 异步结果状态的公共部分
+ *
+ * 无锁实现：
+ * - head_ 是状态字兼回调链表头：nullptr 表示未就绪且无回调，
+ *   &future_ready_sentinel 表示已就绪，其他值是待执行回调链表
+ * - 设置结果：先用 claimed_ 抢占写权（保证只设置一次），写入值或异常，
+ *   再把 head_ 原子交换为"已就绪"，依次执行交换出来的回调
+ * - 添加回调：CAS 压入链表；发现已就绪则在当前线程立即执行
+ * - 阻塞等待只在结果未就绪时发生，第一次等待把共用的等待者节点挂进链表
+ */
+class future_state_base {
+public:
+    future_state_base() = default;
+    virtual ~future_state_base() {
+        delete waiter_.load(std::memory_order_acquire);
+    }
+
+    future_state_base(const future_state_base&)            = delete;
+    future_state_base& operator=(const future_state_base&) = delete;
+
     /**
      * @brief 设置异常
      */
     void set_exception(std::exception_ptr ex) {
-        lock_guard<mutex> lock(mutex_);
-        if (ready_) {
-            throw std::future_error(std::future_errc::promise_already_satisfied);
-        }
+        claim();
         exception_ = ex;
-        ready_ = true;
-        cond_.notify_all();
+        complete();
     }
-    
+
     /**
-     * @brief 获取值（阻塞直到就绪）
+     * @brief 结果已设置（或正在设置）
      */
-    T get() {
-        unique_lock<mutex> lock(mutex_);
-        cond_.wait(lock, [this] { return ready_; });
-        
-        if (exception_) {
-            std::rethrow_exception(exception_);
+    bool satisfied() const noexcept {
+        return claimed_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 检查是否就绪
+     */
+    bool is_ready() const noexcept {
+        return head_.load(std::memory_order_acquire) == &future_ready_sentinel;
+    }
+
+    /**
+     * @brief 结果就绪时执行 c（已就绪则在当前线程立即执行）
+     */
+    void add_continuation(future_continuation* c) const noexcept {
+        future_continuation* h = head_.load(std::memory_order_acquire);
+        while (h != &future_ready_sentinel) {
+            c->next = h;
+            if (head_.compare_exchange_weak(h, c, std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+                return;
+            }
         }
-        
-        return std::move(*value_);
+        c->next = nullptr;
+        c->fire(c);
     }
-    
+
     /**
      * @brief 等待就绪
      */
     void wait() const {
-        unique_lock<mutex> lock(mutex_);
-        cond_.wait(lock, [this] { return ready_; });
+        if (is_ready()) return;
+        future_waiter* w = acquire_waiter();
+        unique_lock<mutex> lock(w->lock);
+        w->cond.wait(lock, [w] { return w->done; });
     }
-    
+
     /**
      * @brief 超时等待
+     *
+     * 超时为零（或负）时只检查一次是否就绪，不挂等待者。
      */
     template<typename Rep, typename Period>
     bool wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
-        unique_lock<mutex> lock(mutex_);
-        return cond_.wait_for(lock, timeout, [this] { return ready_; });
-    }
-    
-    /**
-     * @brief 检查是否就绪
-     */
-    bool is_ready() const {
-        lock_guard<mutex> lock(mutex_);
-        return ready_;
+        if (is_ready()) return true;
+        unsigned long ms = to_wait_ms(timeout);
+        if (ms == 0) return is_ready();
+        future_waiter* w = acquire_waiter();
+        unique_lock<mutex> lock(w->lock);
+        return w->cond.wait_for(lock, ms, [w] { return w->done; });
     }
-    
+
     /**
-     * @brief 增加引用计数（用于 shared_future）
+     * @brief 增加引用计数（用于 shared_future 与回调）
      */
     void add_ref() {
-        lock_guard<mutex> lock(ref_mutex_);
-        ++ref_count_;
+        ref_count_.fetch_add(1, std::memory_order_relaxed);
     }
-    
+
     /**
      * @brief 减少引用计数
      */
     void release() {
-        lock_guard<mutex> lock(ref_mutex_);
-        if (--ref_count_ == 0) {
+        if (ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
             delete this;
         }
     }
-    
+
     /**
      * @brief 获取引用计数
      */
     int ref_count() const {
-        lock_guard<mutex> lock(ref_mutex_);
-        return ref_count_;
+        return ref_count_.load(std::memory_order_relaxed);
     }
 
-private:
-    mutable mutex mutex_;
-    mutable condition_variable cond_;
-    optional<T> value_;
-    std::exception_ptr exception_;
-    bool ready_;
-    
-    // shared_future 引用计数
-    mutable mutex ref_mutex_;
-    int ref_count_{1};
-};
-
-// void 特化
-template<>
-class future_state<void> {
-public:
-    future_state() : ready_(false) {}
-    
-    void set_value() {
-        lock_guard<mutex> lock(mutex_);
-        if (ready_) {
+protected:
+    /**
+     * @brief 抢占写权：已有结果时抛出 promise_already_satisfied
+     */
+    void claim() {
+        if (claimed_.exchange(true, std::memory_order_acq_rel)) {
             throw std::future_error(std::future_errc::promise_already_satisfied);
         }
-        ready_ = true;
-        cond_.notify_all();
     }
-    
-    void set_exception(std::exception_ptr ex) {
-        lock_guard<mutex> lock(mutex_);
-        if (ready_) {
-            throw std::future_error(std::future_errc::promise_already_satisfied);
+
+    /**
+     * @brief 写入结果失败（值的构造抛出异常）时交还写权
+     */
+    void unclaim() noexcept {
+        claimed_.store(false, std::memory_order_release);
+    }
+
+    /**
+     * @brief 发布结果并按注册顺序执行回调
+     */
+    void complete() noexcept {
+        future_continuation* list = head_.exchange(&future_ready_sentinel, std::memory_order_acq_rel);
+        // 链表是后进先出，反转后按注册顺序执行
+        future_continuation* ordered = nullptr;
+        while (list) {
+            future_continuation* next = list->next;
+            list->next = ordered;
+            ordered = list;
+            list = next;
+        }
+        while (ordered) {
+            future_continuation* next = ordered->next;
+            ordered->fire(ordered);
+            ordered = next;
         }
-        exception_ = ex;
-        ready_ = true;
-        cond_.notify_all();
     }
-    
-    void get() {
-        unique_lock<mutex> lock(mutex_);
-        cond_.wait(lock, [this] { return ready_; });
-        
+
+    void rethrow_if_exception() const {
         if (exception_) {
             std::rethrow_exception(exception_);
         }
     }
-    
-    void wait() const {
-        unique_lock<mutex> lock(mutex_);
-        cond_.wait(lock, [this] { return ready_; });
-    }
-    
-    template<typename Rep, typename Period>
-    bool wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
-        unique_lock<mutex> lock(mutex_);
-        return cond_.wait_for(lock, timeout, [this] { return ready_; });
+
+    std::exception_ptr exception_;
+
+private:
+    /**
+     * @brief 取得本状态共用的等待者，第一次调用时创建并挂进链表
+     *
+     * 并发创建时只有一个胜出，其余的直接删除（尚未挂进链表）。
+     */
+    future_waiter* acquire_waiter() const {
+        future_waiter* w = waiter_.load(std::memory_order_acquire);
+        if (w) return w;
+        future_waiter* fresh = new future_waiter();
+        if (!waiter_.compare_exchange_strong(w, fresh, std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+            delete fresh;
+            return w;
+        }
+        add_continuation(fresh);
+        return fresh;
     }
-    
-    bool is_ready() const {
-        lock_guard<mutex> lock(mutex_);
-        return ready_;
+
+    mutable std::atomic<future_continuation*> head_{nullptr};
+    mutable std::atomic<future_waiter*>       waiter_{nullptr};
+    std::atomic<bool> claimed_{false};
+
+    // promise / future / shared_future / 回调共同持有的引用计数
+    std::atomic<int> ref_count_{1};
+};
+
+/**
+ * @brief 异步结果状态
+ * 
+ * 存储计算结果或异常，线程安全。
+ */
+template<typename T>
+class future_state : public future_state_base {
+public:
+    /**
+     * @brief 设置值
+     */
+    void set_value(const T& value) {
+        claim();
+        try {
+            value_ = value;
+        } catch (...) {
+            unclaim();
+            throw;
+        }
+        complete();
     }
     
-    void add_ref() {
-        lock_guard<mutex> lock(ref_mutex_);
-        ++ref_count_;
+    void set_value(T&& value) {
+        claim();
+        try {
+            value_ = std::move(value);
+        } catch (...) {
+            unclaim();
+            throw;
+        }
+        complete();
     }
     
-    void release() {
-        lock_guard<mutex> lock(ref_mutex_);
-        if (--ref_count_ == 0) {
-            delete this;
-        }
+    /**
+     * @brief 获取值（阻塞直到就绪）
+     */
+    T get() {
+        wait();
+        rethrow_if_exception();
+        return std::move(*value_);
     }
     
-    int ref_count() const {
-        lock_guard<mutex> lock(ref_mutex_);
-        return ref_count_;
+    /**
+     * @brief 获取值的引用（阻塞直到就绪，shared_future 使用，不移走结果）
+     */
+    const T& get_ref() {
+        wait();
+        rethrow_if_exception();
+        return *value_;
     }
 
 private:
-    mutable mutex mutex_;
-    mutable condition_variable cond_;
-    std::exception_ptr exception_;
-    bool ready_;
+    optional<T> value_;
+};
+
+// void 特化
+template<>
+class future_state<void> : public future_state_base {
+public:
+    void set_value() {
+        claim();
+        complete();
+    }
     
-    mutable mutex ref_mutex_;
-    int ref_count_{1};
+    void get() {
+        wait();
+        rethrow_if_exception();
+    }
+};
+
+/**
+ * @brief 组合子（then / when_all / when_any）访问 future 内部状态
+ */
+struct future_access {
+    template<typename Future>
+    static auto* state(const Future& f) noexcept { return f.state_; }
+
+    template<typename Future>
+    static auto* detach(Future& f) noexcept {
+        auto* s = f.state_;
+        f.state_ = nullptr;
+        return s;
+    }
+
+    template<typename Future, typename State>
+    static Future adopt(State* s) noexcept { return Future(s); }
 };
 
 } // namespace detail
@@ -354,11 +576,32 @@ public:
         return shared_future<T>(state_);
     }
 
+    /**
+     * @brief 结果就绪后在执行器 ex 上执行 f，返回 f 的结果
+     *
+     * - f 接受 future（自己处理异常）或结果值（异常直接传给返回的 future，f 不执行）
+     * - f 返回 future<U> 时返回 future<U>（自动展开）
+     * - ex 提供 execute(fn) 或 submit_void(fn)（如 thread_pool），或本身可调用；
+     *   须在回调执行前保持有效
+     * - 调用后本 future 失效
+     *
+     * 泛型 lambda 请写明参数类型，否则总被当作接受 future 的形态。
+     */
+    template<typename Executor, typename F>
+    auto then(Executor& ex, F&& f) -> future<detail::then_result_t<future<T>, F>>;
+    
+    /**
+     * @brief 同 then(ex, f)，f 在设置结果的线程上执行（已就绪则在当前线程立即执行）
+     */
+    template<typename F>
+    auto then(F&& f) -> future<detail::then_result_t<future<T>, F>>;
+
 private:
     template<typename>
     friend class promise;
     template<typename>
     friend class packaged_task;
+    friend struct detail::future_access;
     
     explicit future(detail::future_state<T>* state) : state_(state) {}
     
@@ -425,19 +668,34 @@ public:
         return state_ != nullptr;
     }
     
-    shared_future<void> share() {
-        if (!state_) {
-            throw std::future_error(std::future_errc::no_state);
-        }
-        state_->add_ref();
-        return shared_future<void>(state_);
-    }
+    shared_future<void> share();
+    
+    /**
+     * @brief 结果就绪后在执行器 ex 上执行 f，返回 f 的结果
+     *
+     * - f 接受 future（自己处理异常）或结果值（异常直接传给返回的 future，f 不执行）
+     * - f 返回 future<U> 时返回 future<U>（自动展开）
+     * - ex 提供 execute(fn) 或 submit_void(fn)（如 thread_pool），或本身可调用；
+     *   须在回调执行前保持有效
+     * - 调用后本 future 失效
+     *
+     * 泛型 lambda 请写明参数类型，否则总被当作接受 future 的形态。
+     */
+    template<typename Executor, typename F>
+    auto then(Executor& ex, F&& f) -> future<detail::then_result_t<future<void>, F>>;
+    
+    /**
+     * @brief 同 then(ex, f)，f 在设置结果的线程上执行（已就绪则在当前线程立即执行）
+     */
+    template<typename F>
+    auto then(F&& f) -> future<detail::then_result_t<future<void>, F>>;
 
 private:
     template<typename>
     friend class promise;
     template<typename>
     friend class packaged_task;
+    friend struct detail::future_access;
     
     explicit future(detail::future_state<void>* state) : state_(state) {}
     
@@ -502,7 +760,7 @@ public:
         if (!state_) {
             throw std::future_error(std::future_errc::no_state);
         }
-        return state_->get();
+        return state_->get_ref();
     }
     
     void wait() const {
@@ -528,15 +786,114 @@ public:
         return state_ != nullptr;
     }
 
+    /**
+     * @brief 结果就绪后在执行器 ex 上执行 f（见 future::then），本对象保持有效
+     *
+     * f 接受 shared_future 或结果的 const 引用；同一结果可挂多个回调。
+     */
+    template<typename Executor, typename F>
+    auto then(Executor& ex, F&& f) const -> future<detail::then_result_t<shared_future<T>, F>>;
+    
+    template<typename F>
+    auto then(F&& f) const -> future<detail::then_result_t<shared_future<T>, F>>;
+
 private:
     template<typename>
     friend class future;
+    friend struct detail::future_access;
     
     explicit shared_future(detail::future_state<T>* state) : state_(state) {}
     
     detail::future_state<T>* state_;
 };
 
+// void 特化
+template<>
+class shared_future<void> {
+public:
+    shared_future() noexcept : state_(nullptr) {}
+    
+    shared_future(const shared_future& other) noexcept : state_(other.state_) {
+        if (state_) {
+            state_->add_ref();
+        }
+    }
+    
+    shared_future(shared_future&& other) noexcept : state_(other.state_) {
+        other.state_ = nullptr;
+    }
+    
+    ~shared_future() {
+        if (state_) {
+            state_->release();
+        }
+    }
+    
+    shared_future& operator=(shared_future other) noexcept {
+        detail::future_state<void>* tmp = state_;
+        state_ = other.state_;
+        other.state_ = tmp;
+        return *this;
+    }
+    
+    void get() const {
+        if (!state_) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+        state_->get();
+    }
+    
+    void wait() const {
+        if (!state_) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+        state_->wait();
+    }
+    
+    template<typename Rep, typename Period>
+    bool wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+        if (!state_) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+        return state_->wait_for(timeout);
+    }
+    
+    bool is_ready() const {
+        return state_ ? state_->is_ready() : false;
+    }
+    
+    bool valid() const noexcept {
+        return state_ != nullptr;
+    }
+
+    /**
+     * @brief 结果就绪后在执行器 ex 上执行 f（见 future::then），本对象保持有效
+     *
+     * f 接受 shared_future 或结果的 const 引用；同一结果可挂多个回调。
+     */
+    template<typename Executor, typename F>
+    auto then(Executor& ex, F&& f) const -> future<detail::then_result_t<shared_future<void>, F>>;
+    
+    template<typename F>
+    auto then(F&& f) const -> future<detail::then_result_t<shared_future<void>, F>>;
+
+private:
+    friend class future<void>;
+    friend struct detail::future_access;
+    
+    explicit shared_future(detail::future_state<void>* state) : state_(state) {}
+    
+    detail::future_state<void>* state_;
+};
+
+inline shared_future<void> future<void>::share() {
+    if (!state_) {
+        throw std::future_error(std::future_errc::no_state);
+    }
+    state_->add_ref();
+    return shared_future<void>(state_);
+}
+
 // ============================================================================
 // promise
 // ============================================================================
@@ -552,16 +909,16 @@ class promise {
 public:
     promise() : state_(new detail::future_state<T>()) {}
     
-    promise(promise&& other) noexcept : state_(other.state_) {
+    promise(promise&& other) noexcept
+        : state_(other.state_), future_obtained_(other.future_obtained_) {
         other.state_ = nullptr;
     }
     
     promise& operator=(promise&& other) noexcept {
         if (this != &other) {
-            if (state_) {
-                delete state_;
-            }
+            promise old(std::move(*this));   // 旧状态走析构路径（broken_promise + release）
             state_ = other.state_;
+            future_obtained_ = other.future_obtained_;
             other.state_ = nullptr;
         }
         return *this;
@@ -573,7 +930,7 @@ public:
     ~promise() {
         if (state_) {
             // 如果未设置结果，设置一个异常
-            if (!state_->is_ready()) {
+            if (!state_->satisfied()) {
                 try {
                     throw std::future_error(std::future_errc::broken_promise);
                 } catch (...) {
@@ -619,6 +976,7 @@ public:
             throw std::future_error(std::future_errc::future_already_retrieved);
         }
         future_obtained_ = true;
+        state_->add_ref();   // promise 与 future 各持有一份引用
         return future<T>(state_);
     }
 
@@ -633,16 +991,16 @@ class promise<void> {
 public:
     promise() : state_(new detail::future_state<void>()) {}
     
-    promise(promise&& other) noexcept : state_(other.state_) {
+    promise(promise&& other) noexcept
+        : state_(other.state_), future_obtained_(other.future_obtained_) {
         other.state_ = nullptr;
     }
     
     promise& operator=(promise&& other) noexcept {
         if (this != &other) {
-            if (state_) {
-                delete state_;
-            }
+            promise old(std::move(*this));   // 旧状态走析构路径（broken_promise + release）
             state_ = other.state_;
+            future_obtained_ = other.future_obtained_;
             other.state_ = nullptr;
         }
         return *this;
@@ -653,7 +1011,7 @@ public:
     
     ~promise() {
         if (state_) {
-            if (!state_->is_ready()) {
+            if (!state_->satisfied()) {
                 try {
                     throw std::future_error(std::future_errc::broken_promise);
                 } catch (...) {
@@ -683,6 +1041,7 @@ public:
             throw std::future_error(std::future_errc::future_already_retrieved);
         }
         future_obtained_ = true;
+        state_->add_ref();
         return future<void>(state_);
     }
 
@@ -707,23 +1066,27 @@ class packaged_task;  // 前置声明
 template<typename R, typename... Args>
 class packaged_task<R(Args...)> {
 public:
-    packaged_task() noexcept : state_(nullptr) {}
+    packaged_task() noexcept : func_(nullptr), valid_(false) {}
     
     template<typename F>
-    explicit packaged_task(F&& f) 
-        : state_(new detail::packaged_task_state_impl<F>(std::forward<F>(f))) {}
+    explicit packaged_task(F&& f)
+        : func_(new callable_impl<typename std::decay<F>::type>(std::forward<F>(f)))
+        , valid_(true) {}
     
-    packaged_task(packaged_task&& other) noexcept : state_(other.state_) {
-        other.state_ = nullptr;
+    packaged_task(packaged_task&& other) noexcept
+        : func_(other.func_), promise_(std::move(other.promise_)), valid_(other.valid_) {
+        other.func_  = nullptr;
+        other.valid_ = false;
     }
     
     packaged_task& operator=(packaged_task&& other) noexcept {
         if (this != &other) {
-            if (state_) {
-                delete state_;
-            }
-            state_ = other.state_;
-            other.state_ = nullptr;
+            delete func_;
+            func_    = other.func_;
+            promise_ = std::move(other.promise_);
+            valid_   = other.valid_;
+            other.func_  = nullptr;
+            other.valid_ = false;
         }
         return *this;
     }
@@ -732,80 +1095,481 @@ public:
     packaged_task& operator=(const packaged_task&) = delete;
     
     ~packaged_task() {
-        if (state_) {
-            state_->release();
-        }
+        delete func_;
     }
     
     /**
-     * @brief 执行任务
+     * @brief 执行任务，结果或异常写入关联的 future
      */
     void operator()(Args... args) {
-        if (!state_) {
+        if (!valid_) {
             throw std::future_error(std::future_errc::no_state);
         }
-        state_->invoke(args...);
+        try {
+            if constexpr (std::is_void<R>::value) {
+                func_->invoke(std::forward<Args>(args)...);
+                promise_.set_value();
+            } else {
+                promise_.set_value(func_->invoke(std::forward<Args>(args)...));
+            }
+        } catch (...) {
+            promise_.set_exception(std::current_exception());
+        }
     }
     
     /**
      * @brief 获取关联的 future
      */
     future<R> get_future() {
-        if (!state_ || future_obtained_) {
-            throw std::future_error(std::future_errc::future_already_retrieved);
+        if (!valid_) {
+            throw std::future_error(std::future_errc::no_state);
         }
-        future_obtained_ = true;
-        return future<R>(state_);
+        return promise_.get_future();
     }
     
     /**
      * @brief 检查是否有效
      */
     bool valid() const noexcept {
-        return state_ != nullptr;
+        return valid_;
     }
 
 private:
-    struct packaged_task_state_base {
-        virtual ~packaged_task_state_base() = default;
-        virtual void invoke(Args...) = 0;
-        virtual detail::future_state<R>* get_future_state() = 0;
-        virtual void add_ref() = 0;
-        virtual void release() = 0;
+    struct callable_base {
+        virtual ~callable_base() = default;
+        virtual R invoke(Args&&... args) = 0;
     };
     
     template<typename F>
-    struct packaged_task_state_impl : packaged_task_state_base {
+    struct callable_impl : callable_base {
         F func_;
-        detail::future_state<R> future_state_;
-        int ref_count_{1};
         
-        explicit packaged_task_state_impl(F&& f) : func_(std::forward<F>(f)) {}
+        template<typename G>
+        explicit callable_impl(G&& g) : func_(std::forward<G>(g)) {}
         
-        void invoke(Args... args) override {
+        R invoke(Args&&... args) override {
+            return func_(std::forward<Args>(args)...);
+        }
+    };
+    
+    callable_base* func_;
+    promise<R>     promise_;
+    bool           valid_;
+};
+
+// ============================================================================
+// 执行器与 then
+// ============================================================================
+
+/**
+ * @brief 在调用线程上直接执行的执行器
+ */
+struct inline_executor {
+    template<typename F>
+    void execute(F&& f) const {
+        std::forward<F>(f)();
+    }
+};
+
+namespace detail {
+
+template<typename Ex, typename Fn, typename = void>
+struct has_execute : std::false_type {};
+
+template<typename Ex, typename Fn>
+struct has_execute<Ex, Fn, std::void_t<decltype(std::declval<Ex&>().execute(std::declval<Fn>()))>>
+    : std::true_type {};
+
+template<typename Ex, typename Fn, typename = void>
+struct has_submit_void : std::false_type {};
+
+template<typename Ex, typename Fn>
+struct has_submit_void<Ex, Fn, std::void_t<decltype(std::declval<Ex&>().submit_void(std::declval<Fn>()))>>
+    : std::true_type {};
+
+/**
+ * @brief 把 fn 交给执行器：execute(fn) → submit_void(fn) → ex(fn)
+ */
+template<typename Ex, typename Fn>
+void execute_on(Ex& ex, Fn&& fn) {
+    if constexpr (has_execute<Ex, Fn>::value) {
+        ex.execute(std::forward<Fn>(fn));
+    } else if constexpr (has_submit_void<Ex, Fn>::value) {
+        ex.submit_void(std::forward<Fn>(fn));
+    } else {
+        ex(std::forward<Fn>(fn));
+    }
+}
+
+inline inline_executor& default_then_executor() noexcept {
+    static inline_executor ex;
+    return ex;
+}
+
+template<typename R, typename Body>
+void fulfil_promise(promise<R>& p, Body&& body) noexcept;
+
+/**
+ * @brief inner 就绪后把它的结果转交给 p（then 回调返回 future 时展开用）
+ */
+template<typename U>
+void forward_future(future<U>&& inner, promise<U>& p) {
+    if (!inner.valid()) {
+        throw std::future_error(std::future_errc::broken_promise);
+    }
+    future_state<U>* s = future_access::detach(inner);
+    s->add_continuation(make_continuation([s, p = std::move(p)]() mutable {
+        future<U> done = future_access::adopt<future<U>>(s);
+        fulfil_promise(p, [&done] { return done.get(); });
+    }));
+}
+
+/**
+ * @brief 执行 body，把结果或异常写入 p
+ */
+template<typename R, typename Body>
+void fulfil_promise(promise<R>& p, Body&& body) noexcept {
+    using raw = decltype(body());
+    try {
+        if constexpr (is_future<typename std::decay<raw>::type>::value) {
+            forward_future(body(), p);
+        } else if constexpr (std::is_void<raw>::value) {
+            body();
+            p.set_value();
+        } else {
+            p.set_value(body());
+        }
+    } catch (...) {
+        try {
+            p.set_exception(std::current_exception());
+        } catch (...) {
+            // p 已移交给内层 future 的回调，由它负责（失败时为 broken_promise）
+        }
+    }
+}
+
+/**
+ * @brief 以 then_traits 选定的形态调用 then 的回调
+ */
+template<typename Source, typename Fn>
+auto invoke_then(Fn& fn, Source& src) {
+    if constexpr (then_traits<Source, Fn>::takes_source) {
+        return std::invoke(std::move(fn), std::move(src));
+    } else if constexpr (std::is_void<typename then_value_arg<Source>::type>::value) {
+        src.get();
+        return std::invoke(std::move(fn));
+    } else {
+        return std::invoke(std::move(fn), src.get());
+    }
+}
+
+/**
+ * @brief then 的公共实现：在 src 的状态上挂一个回调，就绪时把任务交给执行器
+ *
+ * 回调持有 src（即持有状态的一份引用），任务执行完才释放。
+ */
+template<typename Source, typename Executor, typename F>
+future<then_result_t<Source, F>> attach_then(Source src, Executor& ex, F&& f) {
+    using result_type = then_result_t<Source, F>;
+    using fn_type     = typename std::decay<F>::type;
+
+    promise<result_type> p;
+    future<result_type> out = p.get_future();
+    auto* state = future_access::state(src);
+    state->add_continuation(make_continuation(
+        [src = std::move(src), exec = &ex, fn = fn_type(std::forward<F>(f)), p = std::move(p)]() mutable {
+            auto task = [src = std::move(src), fn = std::move(fn), p = std::move(p)]() mutable {
+                fulfil_promise(p, [&] { return invoke_then(fn, src); });
+            };
             try {
-                future_state_.set_value(func_(args...));
+                execute_on(*exec, std::move(task));
             } catch (...) {
-                future_state_.set_exception(std::current_exception());
+                // 执行器拒绝任务：promise 随任务析构，返回的 future 得到 broken_promise
             }
+        }));
+    return out;
+}
+
+} // namespace detail
+
+template<typename T>
+template<typename Executor, typename F>
+auto future<T>::then(Executor& ex, F&& f) -> future<detail::then_result_t<future<T>, F>> {
+    if (!state_) {
+        throw std::future_error(std::future_errc::no_state);
+    }
+    return detail::attach_then(std::move(*this), ex, std::forward<F>(f));
+}
+
+template<typename T>
+template<typename F>
+auto future<T>::then(F&& f) -> future<detail::then_result_t<future<T>, F>> {
+    return then(detail::default_then_executor(), std::forward<F>(f));
+}
+
+template<typename Executor, typename F>
+auto future<void>::then(Executor& ex, F&& f) -> future<detail::then_result_t<future<void>, F>> {
+    if (!state_) {
+        throw std::future_error(std::future_errc::no_state);
+    }
+    return detail::attach_then(std::move(*this), ex, std::forward<F>(f));
+}
+
+template<typename F>
+auto future<void>::then(F&& f) -> future<detail::then_result_t<future<void>, F>> {
+    return then(detail::default_then_executor(), std::forward<F>(f));
+}
+
+template<typename T>
+template<typename Executor, typename F>
+auto shared_future<T>::then(Executor& ex, F&& f) const
+    -> future<detail::then_result_t<shared_future<T>, F>>
+{
+    if (!state_) {
+        throw std::future_error(std::future_errc::no_state);
+    }
+    return detail::attach_then(shared_future<T>(*this), ex, std::forward<F>(f));
+}
+
+template<typename T>
+template<typename F>
+auto shared_future<T>::then(F&& f) const -> future<detail::then_result_t<shared_future<T>, F>> {
+    return then(detail::default_then_executor(), std::forward<F>(f));
+}
+
+template<typename Executor, typename F>
+auto shared_future<void>::then(Executor& ex, F&& f) const
+    -> future<detail::then_result_t<shared_future<void>, F>>
+{
+    if (!state_) {
+        throw std::future_error(std::future_errc::no_state);
+    }
+    return detail::attach_then(shared_future<void>(*this), ex, std::forward<F>(f));
+}
+
+template<typename F>
+auto shared_future<void>::then(F&& f) const -> future<detail::then_result_t<shared_future<void>, F>> {
+    return then(detail::default_then_executor(), std::forward<F>(f));
+}
+
+// ============================================================================
+// make_ready_future / make_exceptional_future
+// ============================================================================
+
+/**
+ * @brief 已就绪、值为 value 的 future
+ */
+template<typename T>
+future<typename std::decay<T>::type> make_ready_future(T&& value) {
+    promise<typename std::decay<T>::type> p;
+    p.set_value(std::forward<T>(value));
+    return p.get_future();
+}
+
+inline future<void> make_ready_future() {
+    promise<void> p;
+    p.set_value();
+    return p.get_future();
+}
+
+/**
+ * @brief 已就绪、持有异常 ex 的 future
+ */
+template<typename T>
+future<T> make_exceptional_future(std::exception_ptr ex) {
+    promise<T> p;
+    p.set_exception(ex);
+    return p.get_future();
+}
+
+// ============================================================================
+// when_all / when_any
+// ============================================================================
+
+/**
+ * @brief when_any 的结果：先就绪的下标与全部输入
+ *
+ * 输入为空时 index 为 static_cast<size_t>(-1)。
+ */
+template<typename Sequence>
+struct when_any_result {
+    size_t   index;
+    Sequence futures;
+};
+
+namespace detail {
+
+/**
+ * @brief f 就绪时调用 arrive()；f 无效时视为已就绪
+ */
+template<typename Future, typename Arrive>
+void on_ready(const Future& f, Arrive&& arrive) {
+    auto* s = future_access::state(f);
+    if (!s) {
+        arrive();
+        return;
+    }
+    s->add_continuation(make_continuation(std::forward<Arrive>(arrive)));
+}
+
+template<typename Tuple, typename F, size_t... I>
+void for_each_indexed(Tuple& t, F&& f, std::index_sequence<I...>) {
+    (f(std::get<I>(t), I), ...);
+}
+
+template<typename Sequence, typename F>
+void for_each_indexed(std::vector<Sequence>& v, F&& f) {
+    for (size_t i = 0; i < v.size(); ++i) f(v[i], i);
+}
+
+template<typename... Ts, typename F>
+void for_each_indexed(std::tuple<Ts...>& t, F&& f) {
+    for_each_indexed(t, std::forward<F>(f), std::index_sequence_for<Ts...>{});
+}
+
+/**
+ * @brief when_all 的共享上下文
+ *
+ * remaining 初值为输入个数 + 1：挂回调的线程也算一份，挂完之前结果不会被移走。
+ */
+template<typename Sequence>
+struct when_all_context {
+    Sequence              futures;
+    promise<Sequence>     done;
+    std::atomic<size_t>   remaining;
+
+    when_all_context(Sequence&& seq, size_t n) : futures(std::move(seq)), remaining(n + 1) {}
+
+    void arrive() noexcept {
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            done.set_value(std::move(futures));
+            delete this;
         }
-        
-        detail::future_state<R>* get_future_state() override {
-            return &future_state_;
-        }
-        
-        void add_ref() override { ++ref_count_; }
-        void release() override {
-            if (--ref_count_ == 0) {
-                delete this;
-            }
+    }
+};
+
+template<typename Sequence>
+future<Sequence> start_when_all(Sequence&& seq, size_t n) {
+    auto* ctx = new when_all_context<Sequence>(std::move(seq), n);
+    future<Sequence> out = ctx->done.get_future();
+    for_each_indexed(ctx->futures, [ctx](auto& f, size_t) {
+        on_ready(f, [ctx] { ctx->arrive(); });
+    });
+    ctx->arrive();
+    return out;
+}
+
+/**
+ * @brief when_any 的共享上下文
+ *
+ * - index：第一个就绪的输入（CAS 决出）
+ * - gate：胜出者与挂回调的线程各减一，减到 0 的一方设置结果，
+ *   保证结果里的 future 不会在挂回调途中被移走
+ * - refs：每个回调与挂回调的线程各一份，最后一个释放上下文
+ */
+template<typename Sequence>
+struct when_any_context {
+    static constexpr size_t no_index = static_cast<size_t>(-1);
+
+    Sequence                             futures;
+    promise<when_any_result<Sequence>>   done;
+    std::atomic<size_t>                  index{no_index};
+    std::atomic<int>                     gate{2};
+    std::atomic<size_t>                  refs;
+
+    when_any_context(Sequence&& seq, size_t n) : futures(std::move(seq)), refs(n + 1) {
+        if (n == 0) gate.store(1, std::memory_order_relaxed);
+    }
+
+    void pass_gate() noexcept {
+        if (gate.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            done.set_value(when_any_result<Sequence>{ index.load(std::memory_order_acquire),
+                                                      std::move(futures) });
         }
-    };
-    
-    packaged_task_state_base* state_;
-    bool future_obtained_{false};
+    }
+
+    void arrive(size_t i) noexcept {
+        size_t expected = no_index;
+        if (index.compare_exchange_strong(expected, i, std::memory_order_acq_rel)) pass_gate();
+        drop();
+    }
+
+    void drop() noexcept {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+    }
 };
 
+template<typename Sequence>
+future<when_any_result<Sequence>> start_when_any(Sequence&& seq, size_t n) {
+    auto* ctx = new when_any_context<Sequence>(std::move(seq), n);
+    future<when_any_result<Sequence>> out = ctx->done.get_future();
+    for_each_indexed(ctx->futures, [ctx](auto& f, size_t i) {
+        on_ready(f, [ctx, i] { ctx->arrive(i); });
+    });
+    ctx->pass_gate();
+    ctx->drop();
+    return out;
+}
+
+/**
+ * @brief 区间输入：future 移动进结果，shared_future 拷贝
+ */
+template<typename Value, typename InputIt>
+std::vector<Value> take_range(InputIt first, InputIt last) {
+    if constexpr (std::is_copy_constructible<Value>::value) {
+        return std::vector<Value>(first, last);
+    } else {
+        return std::vector<Value>(std::make_move_iterator(first), std::make_move_iterator(last));
+    }
+}
+
+template<typename It>
+using when_range_enable = typename std::enable_if<
+    !is_future<typename std::decay<It>::type>::value,
+    typename std::iterator_traits<It>::value_type>::type;
+
+} // namespace detail
+
+/**
+ * @brief 全部就绪时就绪，结果为输入的 future（已就绪，可直接 get）
+ *
+ * future 须以右值传入，shared_future 可拷贝传入。任何输入出错不会提前结束，
+ * 异常在对应元素 get() 时抛出。不阻塞任何线程。
+ */
+template<typename... Futures>
+auto when_all(Futures&&... fs) -> future<std::tuple<typename std::decay<Futures>::type...>> {
+    using sequence = std::tuple<typename std::decay<Futures>::type...>;
+    return detail::start_when_all(sequence(std::forward<Futures>(fs)...), sizeof...(Futures));
+}
+
+/**
+ * @brief 区间版本：future 被移动进结果 vector，shared_future 被拷贝
+ */
+template<typename InputIt, typename Value = detail::when_range_enable<InputIt>>
+auto when_all(InputIt first, InputIt last) -> future<std::vector<Value>> {
+    std::vector<Value> seq = detail::take_range<Value>(first, last);
+    size_t n = seq.size();
+    return detail::start_when_all(std::move(seq), n);
+}
+
+/**
+ * @brief 任一输入就绪时就绪，结果带胜出者下标与全部输入
+ */
+template<typename... Futures>
+auto when_any(Futures&&... fs)
+    -> future<when_any_result<std::tuple<typename std::decay<Futures>::type...>>>
+{
+    using sequence = std::tuple<typename std::decay<Futures>::type...>;
+    return detail::start_when_any(sequence(std::forward<Futures>(fs)...), sizeof...(Futures));
+}
+
+template<typename InputIt, typename Value = detail::when_range_enable<InputIt>>
+auto when_any(InputIt first, InputIt last) -> future<when_any_result<std::vector<Value>>> {
+    std::vector<Value> seq = detail::take_range<Value>(first, last);
+    size_t n = seq.size();
+    return detail::start_when_any(std::move(seq), n);
+}
+
 } // namespace zen
 
 #endif // ZEN_THREADING_FUTURE_FUTURE_H
@@ -0,0 +1,312 @@
+/**
+ * @file pool_options.h
+ * @brief 线程池配置、优先级与运行指标
+ *
+ * - task_priority        : 任务优先级（high / normal / background 三条通道）
+ * - thread_pool_options  : 构造参数（名字、线程数、CPU / NUMA 绑定、自旋、延迟统计）
+ * - thread_pool_metrics  : metrics() 返回的快照（各通道队列深度、提交 / 完成 / 窃取计数、
+ *                          提交到开始执行的延迟分布）
+ *
+ * 平台相关部分（CPU 绑定、线程命名、NUMA 节点的 CPU 列表）在 detail 中：
+ * Linux 用 pthread_setaffinity_np / pthread_setname_np 与 sysfs，
+ * Windows 用 SetThreadAffinityMask，其他平台退化为空操作。
+ */
+#ifndef ZEN_THREADING_POOL_POOL_OPTIONS_H
+#define ZEN_THREADING_POOL_POOL_OPTIONS_H
+
+#include "../thread/thread.h"   // ZEN_OS_WINDOWS / ZEN_OS_POSIX
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#  include <sched.h>
+#endif
+
+namespace zen {
+
+// ============================================================================
+// 优先级
+// ============================================================================
+
+/**
+ * @brief 任务优先级
+ *
+ * - high       : 工作线程每次取任务时先看这条通道，排在本地队列之前
+ * - normal     : 默认；工作线程内提交的进本地队列，可被窃取
+ * - background : 只有本地队列、注入队列和窃取都取不到任务时才执行
+ *
+ * 调度不抢占：已经开始执行的任务不会被高优先级任务打断。
+ * 持续满载时 background 任务可能一直得不到执行。
+ */
+enum class task_priority : uint8_t {
+    high       = 0,
+    normal     = 1,
+    background = 2
+};
+
+constexpr size_t task_priority_count = 3;
+
+// ============================================================================
+// 配置
+// ============================================================================
+
+/**
+ * @brief 线程池构造参数
+ *
+ * 名字非空的池登记在 thread_pool_registry 中：可以按名字预先配置
+ * （构造时覆盖这里的参数），也可以统一遍历、采集指标。
+ */
+struct thread_pool_options {
+    std::string      name;                  ///< 池名：线程名前缀与注册表键，空则不登记
+    size_t           threads       = 0;     ///< 工作线程数，0 表示 CPU 集合大小（未绑定时为 CPU 核心数）
+    std::vector<int> cpus;                  ///< 绑定的 CPU 编号；为空且 numa_node >= 0 时取该节点的 CPU
+    int              numa_node     = -1;    ///< NUMA 节点编号，-1 表示不按节点绑定
+    bool             pin_each      = true;  ///< true：第 i 个线程绑定 cpus[i % n]；false：所有线程共享整个集合
+    int              spin          = -1;    ///< 空闲时自旋的轮数上限，-1 自动（单核 0，多核 64）
+    bool             track_latency = false; ///< 记录提交到开始执行的延迟（每个任务两次读时钟）
+};
+
+// ============================================================================
+// 指标
+// ============================================================================
+
+/**
+ * @brief 一条通道的排队延迟（提交到开始执行，纳秒）
+ *
+ * 分位数来自以 2 为底的对数直方图，桶内线性插值，误差在 2 倍以内。
+ */
+struct task_latency {
+    uint64_t count   = 0;
+    double   mean_ns = 0;
+    uint64_t max_ns  = 0;
+    uint64_t p50_ns  = 0;
+    uint64_t p90_ns  = 0;
+    uint64_t p99_ns  = 0;
+};
+
+/**
+ * @brief thread_pool::metrics() 的快照
+ *
+ * 各字段分别读取，并发执行时彼此之间不保证一致。
+ */
+struct thread_pool_metrics {
+    std::string  name;
+    size_t       threads = 0;
+    size_t       queued[task_priority_count]    = {};  ///< 各通道排队中的任务（近似）
+    size_t       pending = 0;                          ///< 已提交、尚未执行完的任务
+    uint64_t     submitted[task_priority_count] = {};
+    uint64_t     completed = 0;
+    uint64_t     stolen    = 0;                        ///< 从其他线程队列窃取到的任务
+    uint64_t     parks     = 0;                        ///< 工作线程挂起次数
+    task_latency latency[task_priority_count];         ///< 需 track_latency
+
+    size_t queued_total() const noexcept {
+        return queued[0] + queued[1] + queued[2];
+    }
+};
+
+namespace detail {
+
+// ============================================================================
+// 计数器
+// ============================================================================
+
+inline uint64_t pool_clock_ns() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief 递增计数器
+ *
+ * exclusive 为 true 时只有一个线程写（工作线程自己的计数器），
+ * 用读 + 写代替原子读改写，热路径上没有 lock 前缀指令。
+ */
+inline void stat_add(std::atomic<uint64_t>& c, uint64_t d, bool exclusive) noexcept {
+    if (exclusive) {
+        c.store(c.load(std::memory_order_relaxed) + d, std::memory_order_relaxed);
+    } else {
+        c.fetch_add(d, std::memory_order_relaxed);
+    }
+}
+
+inline void stat_max(std::atomic<uint64_t>& c, uint64_t v, bool exclusive) noexcept {
+    uint64_t cur = c.load(std::memory_order_relaxed);
+    if (exclusive) {
+        if (v > cur) c.store(v, std::memory_order_relaxed);
+        return;
+    }
+    while (v > cur && !c.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+}
+
+/**
+ * @brief 一组调度计数器
+ *
+ * 每个工作线程一份（只有自己写），池外线程协助执行任务时共用一份（原子读改写）。
+ */
+struct pool_counters {
+    static constexpr size_t latency_buckets = 48;   // 桶 b 覆盖 [2^(b-1), 2^b) ns
+
+    std::atomic<uint64_t> spawned{0};    // 压入本地队列的 normal 任务
+    std::atomic<uint64_t> executed{0};
+    std::atomic<uint64_t> stolen{0};
+    std::atomic<uint64_t> parks{0};
+    std::atomic<uint64_t> latency_sum[task_priority_count] = {};
+    std::atomic<uint64_t> latency_max[task_priority_count] = {};
+    std::atomic<uint64_t> latency_hist[task_priority_count][latency_buckets] = {};
+
+    static size_t bucket_of(uint64_t ns) noexcept {
+        size_t b = 0;
+#if defined(__GNUC__) || defined(__clang__)
+        if (ns) b = 64 - static_cast<size_t>(__builtin_clzll(ns));
+#else
+        while (ns) { ns >>= 1; ++b; }
+#endif
+        return b < latency_buckets ? b : latency_buckets - 1;
+    }
+
+    void record_latency(size_t lane, uint64_t ns, bool exclusive) noexcept {
+        stat_add(latency_hist[lane][bucket_of(ns)], 1, exclusive);
+        stat_add(latency_sum[lane], ns, exclusive);
+        stat_max(latency_max[lane], ns, exclusive);
+    }
+};
+
+/**
+ * @brief 汇总多份计数器中某条通道的延迟
+ */
+inline task_latency summarize_latency(const pool_counters* const* parts, size_t n, size_t lane) {
+    uint64_t hist[pool_counters::latency_buckets] = {};
+    uint64_t sum = 0;
+    task_latency out;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t b = 0; b < pool_counters::latency_buckets; ++b) {
+            hist[b] += parts[i]->latency_hist[lane][b].load(std::memory_order_relaxed);
+        }
+        sum += parts[i]->latency_sum[lane].load(std::memory_order_relaxed);
+        uint64_t m = parts[i]->latency_max[lane].load(std::memory_order_relaxed);
+        if (m > out.max_ns) out.max_ns = m;
+    }
+    for (uint64_t h : hist) out.count += h;
+    if (out.count == 0) return out;
+    out.mean_ns = static_cast<double>(sum) / static_cast<double>(out.count);
+
+    auto quantile = [&](double q) -> uint64_t {
+        double target = q * static_cast<double>(out.count);
+        uint64_t before = 0;
+        for (size_t b = 0; b < pool_counters::latency_buckets; ++b) {
+            if (hist[b] == 0) continue;
+            if (static_cast<double>(before + hist[b]) >= target) {
+                double lo = b == 0 ? 0.0 : static_cast<double>(1ULL << (b - 1));
+                double hi = b == 0 ? 1.0 : static_cast<double>(1ULL << b);
+                double frac = (target - static_cast<double>(before)) / static_cast<double>(hist[b]);
+                uint64_t v = static_cast<uint64_t>(lo + frac * (hi - lo));
+                return v < out.max_ns ? v : out.max_ns;
+            }
+            before += hist[b];
+        }
+        return out.max_ns;
+    };
+    out.p50_ns = quantile(0.50);
+    out.p90_ns = quantile(0.90);
+    out.p99_ns = quantile(0.99);
+    return out;
+}
+
+// ============================================================================
+// 平台相关：CPU 集合、绑定、命名
+// ============================================================================
+
+/**
+ * @brief 解析 Linux cpulist 格式（如 "0-3,8,10-11"）
+ */
+inline std::vector<int> parse_cpu_list(const char* s) {
+    std::vector<int> cpus;
+    while (*s) {
+        while (*s == ',' || *s == ' ' || *s == '\n') ++s;
+        if (*s < '0' || *s > '9') break;
+        int lo = 0;
+        while (*s >= '0' && *s <= '9') lo = lo * 10 + (*s++ - '0');
+        int hi = lo;
+        if (*s == '-') {
+            ++s;
+            hi = 0;
+            while (*s >= '0' && *s <= '9') hi = hi * 10 + (*s++ - '0');
+        }
+        for (int c = lo; c <= hi; ++c) cpus.push_back(c);
+    }
+    return cpus;
+}
+
+/**
+ * @brief NUMA 节点上的 CPU 编号（读取失败或非 Linux 时返回空）
+ */
+inline std::vector<int> numa_node_cpus(int node) {
+#if defined(__linux__)
+    char path[96];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+    FILE* f = fopen(path, "r");
+    if (!f) return {};
+    char buf[1024];
+    size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[n] = '\0';
+    return parse_cpu_list(buf);
+#else
+    (void)node;
+    return {};
+#endif
+}
+
+/**
+ * @brief 把当前线程绑定到给定 CPU 集合
+ * @return 平台不支持或系统调用失败时返回 false
+ */
+inline bool pin_current_thread(const int* cpus, size_t n) {
+    if (n == 0) return false;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (size_t i = 0; i < n; ++i) {
+        if (cpus[i] >= 0 && cpus[i] < CPU_SETSIZE) CPU_SET(cpus[i], &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(ZEN_OS_WINDOWS)
+    DWORD_PTR mask = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (cpus[i] >= 0 && cpus[i] < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+            mask |= static_cast<DWORD_PTR>(1) << cpus[i];
+        }
+    }
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+/**
+ * @brief 设置当前线程名（Linux 上最长 15 个字符，超出部分截断）
+ */
+inline void set_current_thread_name(const std::string& name) {
+#if defined(__linux__)
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%s", name.c_str());
+    pthread_setname_np(pthread_self(), buf);
+#elif defined(__APPLE__)
+    pthread_setname_np(name.c_str());
+#else
+    (void)name;
+#endif
+}
+
+} // namespace detail
+} // namespace zen
+
+#endif // ZEN_THREADING_POOL_POOL_OPTIONS_H
@@ -1,60 +1,356 @@
 /**
  * @file thread_pool.h
- * @brief 线程池实现
- * 
+ * @brief 线程池实现（工作窃取调度）
+ *
  * 线程池用于管理和复用线程，避免频繁创建销毁线程的开销：
- * 
- * - thread_pool   : 固定大小线程池，支持任务提交和异步执行
- * - 任务队列      : 使用条件变量和互斥锁实现的任务队列
- * 
+ *
+ * - thread_pool           : 固定大小线程池，支持任务提交和异步执行
+ * - thread_pool_registry  : 具名线程池的登记表（统一配置、遍历、采集指标）
+ *
+ * 库里只有这一个调度器实现；pool/thread_pool.h 是旧接口的兼容头文件。
+ *
+ * 调度结构：
+ * - 每个工作线程一个 Chase–Lev 双端队列（work_stealing_deque.h）：
+ *   工作线程内提交的任务压入自己队列的底部，自己从底部取（LIFO），
+ *   空闲线程从别人队列的顶部偷（FIFO）。fork/join 式的递归任务基本不碰共享状态。
+ * - 每个优先级一个全局通道（侵入式链表 + 互斥锁）：池外线程提交的任务、
+ *   以及任何线程提交的 high / background 任务进入这里。
+ *   normal 通道由空闲的工作线程一次取走一批，除第一个外放进自己的队列供其他线程窃取，
+ *   外部大量提交时锁的持有次数远少于任务数。
+ * - 工作线程取任务的顺序：high 通道 → 本地队列 → normal 通道 → 窃取 → background 通道。
+ *   忙碌时每次多出的开销只是读一次 high 通道的长度。
+ * - 空闲线程先自旋若干轮（pause / yield）再挂起；提交任务时只有存在挂起线程
+ *   才去加锁唤醒，忙碌时的提交路径没有系统调用。
+ *
+ * 任务：
+ * - 每个任务一次堆分配，可调用对象与参数直接移动进任务节点（允许只可移动的类型）
+ * - submit() 返回 future；submit_void() 不返回结果，任务不得抛出异常
+ *   （与 std::thread 相同，抛出即 std::terminate）
+ * - 两者都可在第一个参数传 task_priority 指定优先级
+ * - C++20 协程中 co_await pool.schedule() 切换到工作线程继续执行（coro/task.h）
+ * - 在池内等待其他任务时用 wait_until() / wait()：等待期间执行池中的任务，
+ *   所有工作线程都在等待子任务时也不会死锁。任务内的 wait() 不等调用者
+ *   自己所在的任务，只等其余任务（包括其他线程上仍在运行的）完成
+ *
+ * 配置与观测（pool_options.h）：
+ * - 线程名、CPU 列表或 NUMA 节点绑定、自旋轮数、是否统计排队延迟
+ * - metrics()：各通道队列深度、提交 / 完成 / 窃取 / 挂起计数、排队延迟分位数。
+ *   计数器每个工作线程一份，只有自己写，读取时汇总
+ *
  * 特性：
  * - 固定线程数量（构造时指定）
  * - 支持任意可调用对象作为任务
  * - 支持 lambda、函数指针、函数对象
  * - RAII 管理，析构时自动等待所有任务完成
- * 
+ *
  * 示例：
  * @code
  * zen::thread_pool pool(4);  // 4 个工作线程
- * 
+ *
  * // 提交任务
  * auto result1 = pool.submit([]{ return 42; });
  * auto result2 = pool.submit([](int x){ return x * 2; }, 21);
- * 
+ *
  * // 获取结果
  * std::cout << result1.get() << std::endl;  // 42
  * std::cout << result2.get() << std::endl;  // 42
- * 
- * // void 任务
- * pool.submit([]{ std::cout << "Hello from thread!\n"; });
+ *
+ * // 优先级
+ * pool.submit_void(zen::task_priority::background, [] { compact_cache(); });
+ * pool.submit(zen::task_priority::high, [] { return handle_request(); });
+ *
+ * // 具名、绑定到 NUMA 节点 1、统计延迟
+ * zen::thread_pool_options opts;
+ * opts.name = "io";
+ * opts.numa_node = 1;
+ * opts.track_latency = true;
+ * zen::thread_pool io(opts);
+ * zen::thread_pool_metrics m = io.metrics();
+ *
+ * // fork/join：在池内递归派生任务，等待时帮忙执行
+ * long fib(zen::thread_pool& pool, int n) {
+ *     if (n < 20) return fib_serial(n);
+ *     std::atomic<bool> done{false};
+ *     long a = 0;
+ *     pool.submit_void([&] { a = fib(pool, n - 1); done.store(true, std::memory_order_release); });
+ *     long b = fib(pool, n - 2);
+ *     pool.wait_until([&] { return done.load(std::memory_order_acquire); });
+ *     return a + b;
+ * }
  * @endcode
  */
 #ifndef ZEN_THREADING_POOL_THREAD_POOL_H
 #define ZEN_THREADING_POOL_THREAD_POOL_H
 
+#include "../../base/macros.h"
+#include "work_stealing_deque.h"
+#include "pool_options.h"
 #include "../thread/thread.h"
+#include "../thread/this_thread.h"
 #include "../sync/mutex.h"
 #include "../sync/condition_variable.h"
+#include "../sync/unique_lock.h"
+#include "../sync/lock_guard.h"
+#include "../sync/spinlock.h"          // detail::cpu_relax
 #include "../future/future.h"
-#include "../../utility/function.h"
-#include "../../containers/sequential/queue.h"
+#include "../../containers/sequential/vector.h"
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if ZEN_HAS_COROUTINES
+#include <coroutine>
+#endif
+
 namespace zen {
 
+class thread_pool;
+
+namespace detail {
+
+// ============================================================================
+// 任务节点
+// ============================================================================
+
+/**
+ * @brief 类型擦除的任务节点
+ *
+ * next 供全局通道串成链表；execute 执行任务并释放节点。
+ * enqueued_ns 只在统计延迟时写入（0 表示未记录）。
+ */
+struct pool_task {
+    pool_task* next = nullptr;
+    void (*execute)(pool_task*) noexcept = nullptr;
+    uint64_t enqueued_ns = 0;
+    uint8_t  lane = static_cast<uint8_t>(task_priority::normal);
+};
+
+template<typename F>
+struct pool_task_impl final : pool_task {
+    F fn;
+
+    explicit pool_task_impl(F&& f) : fn(std::move(f)) { execute = &run; }
+
+    static void run(pool_task* t) noexcept {
+        auto* self = static_cast<pool_task_impl*>(t);
+        self->fn();
+        delete self;
+    }
+};
+
+template<typename F>
+pool_task* make_pool_task(F&& f) {
+    using fn_type = typename std::decay<F>::type;
+    return new pool_task_impl<fn_type>(fn_type(std::forward<F>(f)));
+}
+
+/**
+ * @brief 全局任务通道：侵入式 FIFO 链表 + 互斥锁
+ *
+ * size 在锁外读取，用于快速判断是否为空。
+ */
+struct alignas(64) pool_lane {
+    mutex                 lock;
+    pool_task*            head = nullptr;
+    pool_task*            tail = nullptr;
+    std::atomic<uint64_t> pushed{0};      // 只在持锁时写
+    alignas(64) std::atomic<size_t> size{0};
+
+    void push(pool_task* task) {
+        lock_guard<mutex> guard(lock);
+        if (tail) {
+            tail->next = task;
+        } else {
+            head = task;
+        }
+        tail = task;
+        pushed.store(pushed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        size.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 取至多 max 个任务，返回链表头（以 nullptr 结尾）
+     */
+    pool_task* take(size_t max) {
+        if (size.load(std::memory_order_relaxed) == 0) return nullptr;
+        lock_guard<mutex> guard(lock);
+        pool_task* first = head;
+        if (!first) return nullptr;
+        pool_task* last = first;
+        size_t taken = 1;
+        while (taken < max && last->next) {
+            last = last->next;
+            ++taken;
+        }
+        head = last->next;
+        if (!head) tail = nullptr;
+        last->next = nullptr;
+        size.fetch_sub(taken, std::memory_order_relaxed);
+        return first;
+    }
+};
+
+/**
+ * @brief 工作线程状态（每个独占缓存行）
+ */
+struct alignas(64) pool_worker {
+    work_stealing_deque<pool_task*> deque;
+    thread_pool*                    owner = nullptr;
+    size_t                          index = 0;
+    uint64_t                        rng   = 0;   // 选择窃取对象
+    pool_counters                   stats;       // 只有本线程写
+
+    size_t next_victim(size_t n) noexcept {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        return static_cast<size_t>(rng % n);
+    }
+};
+
+/**
+ * @brief 当前线程所属的工作线程（池外线程为 nullptr）
+ */
+inline pool_worker*& current_pool_worker() noexcept {
+    static thread_local pool_worker* w = nullptr;
+    return w;
+}
+
+/**
+ * @brief 当前线程上正在执行的任务（栈，任务内 wait() 时嵌套）
+ *
+ * wait() 据此扣除调用者自己所在的任务：它们要等 wait() 返回才会完成。
+ */
+struct running_task_frame {
+    const void*         pool;
+    running_task_frame* prev;
+};
+
+inline running_task_frame*& current_task_frame() noexcept {
+    static thread_local running_task_frame* top = nullptr;
+    return top;
+}
+
+} // namespace detail
+
+// ============================================================================
+// thread_pool_registry
+// ============================================================================
+
+/**
+ * @brief 具名线程池登记表（进程内唯一）
+ *
+ * - configure(name, opts) 预先给某个名字指定参数：之后以该名字构造的池
+ *   用这里的参数代替构造时传入的参数，部署时可在一处集中调整各个池
+ * - 名字非空的池构造时自动登记、析构时注销；for_each / snapshot 遍历当前存活的池
+ *
+ * for_each 的回调在持有登记表锁时执行，不能在回调里构造或析构具名线程池。
+ */
+class thread_pool_registry {
+public:
+    static thread_pool_registry& instance() {
+        static thread_pool_registry registry;
+        return registry;
+    }
+
+    /**
+     * @brief 为名字 name 指定参数（opts.name 被忽略），覆盖之前的配置
+     */
+    void configure(const std::string& name, const thread_pool_options& opts) {
+        lock_guard<mutex> lock(mutex_);
+        for (auto& c : configs_) {
+            if (c.first == name) {
+                c.second = opts;
+                c.second.name = name;
+                return;
+            }
+        }
+        configs_.emplace_back(name, opts);
+        configs_.back().second.name = name;
+    }
+
+    /**
+     * @brief 取出名字 name 的配置
+     * @return 没有配置时返回 false，out 不变
+     */
+    bool configuration(const std::string& name, thread_pool_options& out) const {
+        lock_guard<mutex> lock(mutex_);
+        for (const auto& c : configs_) {
+            if (c.first == name) {
+                out = c.second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 对每个存活的具名池调用 f(thread_pool&)
+     */
+    template<typename F>
+    void for_each(F&& f) {
+        lock_guard<mutex> lock(mutex_);
+        for (thread_pool* p : pools_) f(*p);
+    }
+
+    /**
+     * @brief 所有存活的具名池的指标
+     */
+    std::vector<thread_pool_metrics> snapshot();
+
+    /**
+     * @brief 存活的具名池个数
+     */
+    size_t size() const {
+        lock_guard<mutex> lock(mutex_);
+        return pools_.size();
+    }
+
+private:
+    friend class thread_pool;
+
+    thread_pool_registry() = default;
+
+    void attach(thread_pool* p) {
+        lock_guard<mutex> lock(mutex_);
+        pools_.push_back(p);
+    }
+
+    void detach(thread_pool* p) {
+        lock_guard<mutex> lock(mutex_);
+        for (size_t i = 0; i < pools_.size(); ++i) {
+            if (pools_[i] == p) {
+                pools_.erase(pools_.begin() + static_cast<std::ptrdiff_t>(i));
+                return;
+            }
+        }
+    }
+
+    mutable mutex mutex_;
+    std::vector<std::pair<std::string, thread_pool_options>> configs_;
+    std::vector<thread_pool*> pools_;
+};
+
 // ============================================================================
 // thread_pool
 // ============================================================================
 
 /**
- * @brief 固定大小线程池
- * 
+ * @brief 固定大小、工作窃取的线程池
+ *
  * 工作原理：
- * 1. 构造时创建指定数量的工作线程
- * 2. 工作线程从任务队列中取出任务执行
- * 3. 主线程通过 submit() 提交任务到队列
- * 4. 析构时等待所有任务完成
+ * 1. 构造时创建指定数量的工作线程，每个线程一个本地双端队列，按配置绑定 CPU、设置线程名
+ * 2. 工作线程依次尝试：high 通道 → 本地队列底部 → normal 通道（批量）→
+ *    随机窃取其他线程 → background 通道
+ * 3. 都取不到时自旋一段时间后挂起，有新任务时被唤醒
+ * 4. 析构（或 shutdown()）时等待所有任务（包括任务中派生的任务）完成
  */
 class thread_pool {
 public:
@@ -63,43 +359,79 @@ public:
      * @param num_threads 工作线程数量（默认为 CPU 核心数）
      */
     explicit thread_pool(size_t num_threads = 0)
-        : stop_(false)
+        : thread_pool(options_with_threads(num_threads)) {}
+
+    /**
+     * @brief 按配置构造线程池
+     *
+     * opts.name 非空且登记表中有该名字的配置时，使用登记表中的配置。
+     */
+    explicit thread_pool(const thread_pool_options& opts)
+        : options_(opts)
     {
+        if (!options_.name.empty()) {
+            thread_pool_registry::instance().configuration(options_.name, options_);
+        }
+        if (options_.cpus.empty() && options_.numa_node >= 0) {
+            options_.cpus = detail::numa_node_cpus(options_.numa_node);
+        }
+
+        size_t num_threads = options_.threads;
+        if (num_threads == 0) num_threads = options_.cpus.size();
         if (num_threads == 0) {
             num_threads = static_cast<size_t>(thread::hardware_concurrency());
         }
-        
+        if (num_threads == 0) num_threads = 1;
+        options_.threads = num_threads;
+
+        // 单核机器上自旋只会抢走要执行任务的线程的时间片
+        if (options_.spin >= 0) {
+            spin_limit_ = static_cast<unsigned>(options_.spin);
+        } else {
+            spin_limit_ = thread::hardware_concurrency() > 1 ? 64 : 0;
+        }
+        track_latency_.store(options_.track_latency, std::memory_order_relaxed);
+
+        worker_count_ = num_threads;
+        worker_state_.reset(new detail::pool_worker[num_threads]);
+        for (size_t i = 0; i < num_threads; ++i) {
+            worker_state_[i].owner = this;
+            worker_state_[i].index = i;
+            worker_state_[i].rng   = 0x9e3779b97f4a7c15ULL * (i + 1);
+        }
+
         // 创建工作线程
         workers_.reserve(num_threads);
         for (size_t i = 0; i < num_threads; ++i) {
-            workers_.emplace_back([this] { worker_thread(); });
+            workers_.emplace_back([this, i] { worker_thread(i); });
+        }
+
+        if (!options_.name.empty()) {
+            thread_pool_registry::instance().attach(this);
         }
     }
-    
+
     /**
      * @brief 析构：等待所有任务完成
      */
     ~thread_pool() {
-        {
-            lock_guard<mutex> lock(queue_mutex_);
-            stop_ = true;
-        }
-        condition_.notify_all();
-        
-        for (auto& worker : workers_) {
-            worker.join();
+        if (!options_.name.empty()) {
+            thread_pool_registry::instance().detach(this);
         }
+        shutdown();
     }
-    
+
     // 不可拷贝、不可移动
     thread_pool(const thread_pool&)            = delete;
     thread_pool& operator=(const thread_pool&) = delete;
     thread_pool(thread_pool&&)                 = delete;
     thread_pool& operator=(thread_pool&&)      = delete;
-    
+
     /**
      * @brief 提交任务（返回 future 用于获取结果）
-     * 
+     *
+     * f 与 args 按值（移动）保存进任务节点，执行时以右值传给 f。
+     *
      * @tparam F 任务类型（函数、lambda、函数对象）
      * @tparam Args 参数类型
      * @param f 任务
@@ -107,112 +439,578 @@ public:
      * @return future 任务结果
      */
     template<typename F, typename... Args>
-    auto submit(F&& f, Args&&... args) 
-        -> future<typename std::result_of<F(Args...)>::type>
+    auto submit(F&& f, Args&&... args)
+        -> future<typename std::invoke_result<typename std::decay<F>::type,
+                                              typename std::decay<Args>::type...>::type>
     {
-        using result_type = typename std::result_of<F(Args...)>::type;
-        
-        // 创建 packaged_task
-        packaged_task<result_type()> task(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
-        
-        // 获取 future
-        future<result_type> result = task.get_future();
-        
-        {
-            lock_guard<mutex> lock(queue_mutex_);
-            
-            if (stop_) {
-                throw std::runtime_error("submit on stopped thread_pool");
+        return submit(task_priority::normal, std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 按优先级提交任务
+     */
+    template<typename F, typename... Args>
+    auto submit(task_priority priority, F&& f, Args&&... args)
+        -> future<typename std::invoke_result<typename std::decay<F>::type,
+                                              typename std::decay<Args>::type...>::type>
+    {
+        using result_type = typename std::invoke_result<typename std::decay<F>::type,
+                                                        typename std::decay<Args>::type...>::type;
+
+        promise<result_type> p;
+        future<result_type> result = p.get_future();
+
+        spawn(priority, [p = std::move(p), fn = std::forward<F>(f),
+                         bound = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+            try {
+                if constexpr (std::is_void<result_type>::value) {
+                    std::apply(std::move(fn), std::move(bound));
+                    p.set_value();
+                } else {
+                    p.set_value(std::apply(std::move(fn), std::move(bound)));
+                }
+            } catch (...) {
+                p.set_exception(std::current_exception());
             }
-            
-            // 将任务加入队列
-            tasks_.emplace([task]() mutable { task(); });
-        }
-        
-        // 唤醒一个工作线程
-        condition_.notify_one();
+        });
         return result;
     }
-    
+
     /**
-     * @brief 提交无返回值任务
+     * @brief 提交无返回值任务（不分配 future 状态）
+     *
+     * 任务不得抛出异常。
      */
     template<typename F, typename... Args>
-    void submit_void(F&& f, Args&&... args) {
-        {
-            lock_guard<mutex> lock(queue_mutex_);
-            
-            if (stop_) {
-                throw std::runtime_error("submit on stopped thread_pool");
-            }
-            
-            tasks_.emplace([f, args...]() mutable {
-                f(args...);
+    auto submit_void(F&& f, Args&&... args)
+        -> typename std::enable_if<!std::is_same<typename std::decay<F>::type, task_priority>::value>::type
+    {
+        submit_void(task_priority::normal, std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 按优先级提交无返回值任务
+     */
+    template<typename F, typename... Args>
+    void submit_void(task_priority priority, F&& f, Args&&... args) {
+        if constexpr (sizeof...(Args) == 0) {
+            spawn(priority, std::forward<F>(f));
+        } else {
+            spawn(priority, [fn = std::forward<F>(f),
+                             bound = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+                std::apply(std::move(fn), std::move(bound));
             });
         }
-        
-        condition_.notify_one();
     }
-    
+
+    /**
+     * @brief 提交无返回值任务，不抛出异常（旧 pool/thread_pool.h 的 submit）
+     * @return 已入队返回 true；池已 shutdown（池外提交）或分配失败返回 false
+     *
+     * 任务不得抛出异常。
+     */
+    template<typename F, typename... Args>
+    bool try_submit(F&& f, Args&&... args) noexcept {
+        try {
+            submit_void(task_priority::normal, std::forward<F>(f), std::forward<Args>(args)...);
+        } catch (...) {
+            return false;
+        }
+        return true;
+    }
+
     /**
      * @brief 获取工作线程数量
      */
     size_t size() const noexcept {
-        return workers_.size();
+        return worker_count_;
+    }
+
+    /**
+     * @brief 获取工作线程数量（同 size()）
+     */
+    size_t thread_count() const noexcept {
+        return worker_count_;
     }
-    
+
     /**
-     * @brief 等待所有任务完成
+     * @brief 池名（未命名时为空）
+     */
+    const std::string& name() const noexcept {
+        return options_.name;
+    }
+
+    /**
+     * @brief 生效的配置（线程数、CPU 列表已解析）
+     */
+    const thread_pool_options& options() const noexcept {
+        return options_;
+    }
+
+    /**
+     * @brief 已提交但尚未执行完的任务数
+     */
+    size_t pending() const noexcept {
+        return pending_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 排队中、尚未开始执行的任务数（近似）
+     */
+    size_t pending_tasks() const noexcept {
+        size_t n = 0;
+        for (const auto& lane : lanes_) n += lane.size.load(std::memory_order_relaxed);
+        for (size_t v = 0; v < worker_count_; ++v) n += worker_state_[v].deque.size_hint();
+        return n;
+    }
+
+    /**
+     * @brief 当前线程是否为本池的工作线程
+     */
+    bool in_worker() const noexcept {
+        detail::pool_worker* w = detail::current_pool_worker();
+        return w && w->owner == this;
+    }
+
+    /**
+     * @brief 运行中开关排队延迟统计（只影响之后提交的任务）
+     */
+    void track_latency(bool on) noexcept {
+        track_latency_.store(on, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 调度指标快照
+     */
+    thread_pool_metrics metrics() const {
+        thread_pool_metrics m;
+        m.name    = options_.name;
+        m.threads = worker_count_;
+        for (size_t l = 0; l < task_priority_count; ++l) {
+            m.queued[l]    = lanes_[l].size.load(std::memory_order_relaxed);
+            m.submitted[l] = lanes_[l].pushed.load(std::memory_order_relaxed);
+        }
+        m.pending = pending_.load(std::memory_order_relaxed);
+
+        std::vector<const detail::pool_counters*> parts;
+        parts.reserve(worker_count_ + 1);
+        parts.push_back(&external_stats_);
+        for (size_t v = 0; v < worker_count_; ++v) {
+            m.queued[lane_index(task_priority::normal)] += worker_state_[v].deque.size_hint();
+            parts.push_back(&worker_state_[v].stats);
+        }
+        for (const detail::pool_counters* c : parts) {
+            m.submitted[lane_index(task_priority::normal)] += c->spawned.load(std::memory_order_relaxed);
+            m.completed += c->executed.load(std::memory_order_relaxed);
+            m.stolen    += c->stolen.load(std::memory_order_relaxed);
+            m.parks     += c->parks.load(std::memory_order_relaxed);
+        }
+        for (size_t l = 0; l < task_priority_count; ++l) {
+            m.latency[l] = detail::summarize_latency(parts.data(), parts.size(), l);
+        }
+        return m;
+    }
+
+    /**
+     * @brief 取一个任务在当前线程执行
+     * @return 没有可执行的任务时返回 false
+     */
+    bool try_run_one() {
+        detail::pool_worker* self = local_worker();
+        detail::pool_task* task = self ? find_task(*self) : find_task_external();
+        if (!task) return false;
+        run_task(task, self);
+        return true;
+    }
+
+    /**
+     * @brief 等待 ready() 为真，期间执行池中的任务
+     *
+     * 用于在池内等待子任务（fork/join）：等待的线程自己也在执行任务，
+     * 不会因为所有工作线程都在等待而死锁。没有任务可做时自旋 / 让出 CPU，
+     * 不会挂起，适合等待时间较短的场合。
+     */
+    template<typename Pred>
+    void wait_until(Pred ready) {
+        unsigned idle = 0;
+        while (!ready()) {
+            if (try_run_one()) {
+                idle = 0;
+            } else {
+                backoff(idle++);
+            }
+        }
+    }
+
+    /**
+     * @brief 等待所有已提交的任务（包括它们派生的任务）完成
+     *
+     * 调用线程协助执行任务；没有可执行任务而仍有任务在运行时挂起，
+     * 由最后一个完成的任务唤醒。
+     * 在本池的任务内调用时不计调用者自己所在的任务（含嵌套），
+     * 等到只剩它们时返回；此时不挂起，与 wait_until() 一样自旋等待。
+     * 不同线程上的两个任务同时 wait() 会互相等待，仍然死锁。
      */
     void wait() {
-        // 简化实现：只等待所有线程空闲
-        // 实际应用中需要更复杂的任务计数机制
+        const size_t self = running_depth();
+        if (self != 0) {
+            wait_until([this, self] {
+                return pending_.load(std::memory_order_acquire) <= self;
+            });
+            return;
+        }
+        unsigned idle = 0;
+        while (pending_.load(std::memory_order_acquire) != 0) {
+            if (try_run_one()) {
+                idle = 0;
+                continue;
+            }
+            if (idle < idle_spins) {
+                backoff(idle++);
+                continue;
+            }
+            unique_lock<mutex> lock(idle_mutex_);
+            idle_waiters_.fetch_add(1, std::memory_order_seq_cst);
+            if (pending_.load(std::memory_order_seq_cst) != 0) {
+                // 超时兜底：任务可能全在其他线程的本地队列里，需要重新尝试窃取
+                idle_cond_.wait_for(lock, 1, [this] {
+                    return pending_.load(std::memory_order_acquire) == 0;
+                });
+            }
+            idle_waiters_.fetch_sub(1, std::memory_order_relaxed);
+            idle = 0;
+        }
+    }
+
+    /**
+     * @brief 停止接受池外提交，等待所有任务完成后结束工作线程
+     *
+     * 排空期间任务内部仍可派生新任务；之后池外的 submit 抛出 std::runtime_error。
+     * 重复调用无操作。只能由池的拥有者调用，不能在工作线程内调用。
+     */
+    void shutdown() {
+        if (joined_) return;
+        accepting_.store(false, std::memory_order_relaxed);
+        wait();
+        {
+            lock_guard<mutex> lock(park_mutex_);
+            stop_.store(true, std::memory_order_relaxed);
+        }
+        park_cond_.notify_all();
+
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+        joined_ = true;
     }
 
+#if ZEN_HAS_COROUTINES
+    /**
+     * @brief co_await pool.schedule()：把协程的后续部分作为任务提交到池中
+     *
+     * 挂起后由工作线程恢复，调度开销与一次 submit_void 相同。
+     * 池已 shutdown 时 co_await 抛出 std::runtime_error（协程未挂起）。
+     */
+    struct schedule_awaiter {
+        thread_pool*  pool;
+        task_priority priority;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) {
+            pool->submit_void(priority, [h] { h.resume(); });
+        }
+        void await_resume() const noexcept {}
+    };
+
+    schedule_awaiter schedule(task_priority priority = task_priority::normal) noexcept {
+        return schedule_awaiter{ this, priority };
+    }
+#endif
+
 private:
+    static constexpr unsigned idle_spins = 128;
+    static constexpr size_t   inject_batch = 32;
+
+    static constexpr size_t lane_index(task_priority p) noexcept {
+        return static_cast<size_t>(p);
+    }
+
+    static thread_pool_options options_with_threads(size_t n) {
+        thread_pool_options o;
+        o.threads = n;
+        return o;
+    }
+
+    detail::pool_worker* local_worker() const noexcept {
+        detail::pool_worker* w = detail::current_pool_worker();
+        return (w && w->owner == this) ? w : nullptr;
+    }
+
+    void backoff(unsigned round) const noexcept {
+        if (round < spin_limit_) {
+            for (unsigned i = 0; i < (1u << (round < 6 ? round : 6)); ++i) detail::cpu_relax();
+        } else {
+            this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief normal 任务在工作线程内进本地队列，其余进对应的全局通道；必要时唤醒一个线程
+     */
+    template<typename F>
+    void spawn(task_priority priority, F&& f) {
+        detail::pool_worker* self = local_worker();
+        if (!self && !accepting_.load(std::memory_order_relaxed)) {
+            throw std::runtime_error("submit on stopped thread_pool");
+        }
+        detail::pool_task* task = detail::make_pool_task(std::forward<F>(f));
+        task->lane = static_cast<uint8_t>(priority);
+        if (track_latency_.load(std::memory_order_relaxed)) {
+            task->enqueued_ns = detail::pool_clock_ns();
+        }
+        pending_.fetch_add(1, std::memory_order_relaxed);
+
+        if (self && priority == task_priority::normal) {
+            self->deque.push(task);
+            detail::stat_add(self->stats.spawned, 1, true);
+        } else {
+            lanes_[lane_index(priority)].push(task);
+        }
+        wake_one();
+    }
+
+    /**
+     * @brief 有挂起的工作线程时唤醒一个
+     *
+     * 与 park() 构成 Dekker 式握手：这里先发布任务再读 sleepers_，
+     * park() 先增加 sleepers_ 再检查队列，两侧都有 seq_cst 屏障，
+     * 因此不会出现"任务已入队而所有线程都睡着"的情况。
+     */
+    void wake_one() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_relaxed) == 0) return;
+        {
+            lock_guard<mutex> lock(park_mutex_);
+            if (wake_tokens_ < sleepers_.load(std::memory_order_relaxed)) ++wake_tokens_;
+        }
+        park_cond_.notify_one();
+    }
+
+    /**
+     * @brief 从 normal 通道取一批任务：返回第一个，其余压入 self 的本地队列
+     */
+    detail::pool_task* take_injected(detail::pool_worker* self) {
+        detail::pool_lane& lane = lanes_[lane_index(task_priority::normal)];
+        size_t take = 1;
+        if (self) {
+            // 按线程数均分，避免一个线程把队列全部拿走
+            size_t share = lane.size.load(std::memory_order_relaxed) / worker_count_ + 1;
+            take = share < inject_batch ? share : inject_batch;
+        }
+        detail::pool_task* first = lane.take(take);
+        if (!first) return nullptr;
+        detail::pool_task* rest = first->next;
+        first->next = nullptr;
+        if (self && rest) {
+            while (rest) {
+                detail::pool_task* next = rest->next;
+                rest->next = nullptr;
+                self->deque.push(rest);
+                rest = next;
+            }
+            wake_one();
+        }
+        return first;
+    }
+
+    detail::pool_task* take_one(task_priority priority) {
+        return lanes_[lane_index(priority)].take(1);
+    }
+
+    detail::pool_task* steal_from_others(detail::pool_worker& self) {
+        size_t n = worker_count_;
+        if (n <= 1) return nullptr;
+        size_t start = self.next_victim(n);
+        detail::pool_task* task = nullptr;
+        for (size_t k = 0; k < n; ++k) {
+            size_t v = start + k;
+            if (v >= n) v -= n;
+            if (v == self.index) continue;
+            if (worker_state_[v].deque.steal(task)) {
+                detail::stat_add(self.stats.stolen, 1, true);
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    detail::pool_task* find_task(detail::pool_worker& self) {
+        detail::pool_task* task = nullptr;
+        if ((task = take_one(task_priority::high))) return task;
+        if (self.deque.pop(task)) return task;
+        if ((task = take_injected(&self))) return task;
+        if ((task = steal_from_others(self))) return task;
+        return take_one(task_priority::background);
+    }
+
+    // 池外线程（wait / wait_until 协助执行）：high → normal → 窃取 → background
+    detail::pool_task* find_task_external() {
+        if (detail::pool_task* task = take_one(task_priority::high)) return task;
+        if (detail::pool_task* task = take_injected(nullptr)) return task;
+        size_t n = worker_count_;
+        detail::pool_task* task = nullptr;
+        for (size_t v = 0; v < n; ++v) {
+            if (worker_state_[v].deque.steal(task)) {
+                detail::stat_add(external_stats_.stolen, 1, false);
+                return task;
+            }
+        }
+        return take_one(task_priority::background);
+    }
+
+    /**
+     * @brief 当前线程上正在执行的本池任务数
+     */
+    size_t running_depth() const noexcept {
+        size_t n = 0;
+        for (auto* f = detail::current_task_frame(); f; f = f->prev) {
+            if (f->pool == this) ++n;
+        }
+        return n;
+    }
+
+    bool has_visible_work() const noexcept {
+        for (const auto& lane : lanes_) {
+            if (lane.size.load(std::memory_order_relaxed) != 0) return true;
+        }
+        for (size_t v = 0; v < worker_count_; ++v) {
+            if (!worker_state_[v].deque.empty_hint()) return true;
+        }
+        return false;
+    }
+
+    void run_task(detail::pool_task* task, detail::pool_worker* self) {
+        detail::pool_counters& stats = self ? self->stats : external_stats_;
+        const bool exclusive = self != nullptr;
+        if (task->enqueued_ns != 0) {
+            uint64_t now = detail::pool_clock_ns();
+            uint64_t waited = now > task->enqueued_ns ? now - task->enqueued_ns : 0;
+            stats.record_latency(task->lane, waited, exclusive);
+        }
+        detail::running_task_frame frame{ this, detail::current_task_frame() };
+        detail::current_task_frame() = &frame;
+        task->execute(task);
+        detail::current_task_frame() = frame.prev;
+        detail::stat_add(stats.executed, 1, exclusive);
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (idle_waiters_.load(std::memory_order_relaxed) != 0) {
+                lock_guard<mutex> lock(idle_mutex_);
+                idle_cond_.notify_all();
+            }
+        }
+    }
+
+    /**
+     * @brief 挂起当前工作线程直到被唤醒或停止
+     * @return 线程池停止时返回 false
+     */
+    bool park(detail::pool_worker& self) {
+        unique_lock<mutex> lock(park_mutex_);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!stop_.load(std::memory_order_relaxed) && !has_visible_work()) {
+            detail::stat_add(self.stats.parks, 1, true);
+            park_cond_.wait(lock, [this] {
+                return wake_tokens_ > 0 || stop_.load(std::memory_order_relaxed);
+            });
+            if (wake_tokens_ > 0) --wake_tokens_;
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        return !stop_.load(std::memory_order_relaxed) || has_visible_work();
+    }
+
+    /**
+     * @brief 按配置绑定 CPU、设置线程名
+     */
+    void setup_worker_thread(size_t index) {
+        const std::vector<int>& cpus = options_.cpus;
+        if (!cpus.empty()) {
+            if (options_.pin_each) {
+                detail::pin_current_thread(&cpus[index % cpus.size()], 1);
+            } else {
+                detail::pin_current_thread(cpus.data(), cpus.size());
+            }
+        }
+        if (!options_.name.empty()) {
+            detail::set_current_thread_name(options_.name + "-" + std::to_string(index));
+        }
+    }
+
     /**
      * @brief 工作线程函数
      */
-    void worker_thread() {
+    void worker_thread(size_t index) {
+        setup_worker_thread(index);
+        detail::pool_worker& self = worker_state_[index];
+        detail::current_pool_worker() = &self;
+
+        unsigned idle = 0;
         while (true) {
-            function<void()> task;
-            
-            {
-                unique_lock<mutex> lock(queue_mutex_);
-                
-                // 等待任务或停止信号
-                condition_.wait(lock, [this] { 
-                    return stop_ || !tasks_.empty(); 
-                });
-                
-                if (stop_ && tasks_.empty()) {
-                    return;  // 退出线程
-                }
-                
-                // 取出任务
-                task = std::move(tasks_.front());
-                tasks_.pop();
+            if (detail::pool_task* task = find_task(self)) {
+                run_task(task, &self);
+                idle = 0;
+                continue;
+            }
+            if (idle < idle_spins) {
+                backoff(idle++);
+                continue;
             }
-            
-            // 执行任务（不持有锁）
-            task();
+            idle = 0;
+            if (!park(self)) break;  // 停止且没有剩余任务
         }
+        detail::current_pool_worker() = nullptr;
     }
-    
+
+    thread_pool_options options_;
+
     // 工作线程
     vector<thread> workers_;
-    
-    // 任务队列
-    queue<function<void()>> tasks_;
-    
-    // 同步原语
-    mutable mutex queue_mutex_;
-    condition_variable condition_;
-    bool stop_;
+    std::unique_ptr<detail::pool_worker[]> worker_state_;
+    size_t worker_count_ = 0;
+    unsigned spin_limit_ = 0;
+    bool joined_ = false;
+    std::atomic<bool> accepting_{true};
+    std::atomic<bool> track_latency_{false};
+
+    // 全局通道（池外提交、high / background 任务），下标为 task_priority
+    detail::pool_lane lanes_[task_priority_count];
+
+    // 池外线程协助执行任务时的计数
+    detail::pool_counters external_stats_;
+
+    // 未完成任务数（wait() 与析构使用）
+    alignas(64) std::atomic<size_t> pending_{0};
+
+    // 挂起 / 唤醒
+    alignas(64) std::atomic<unsigned> sleepers_{0};
+    mutex park_mutex_;
+    condition_variable park_cond_;
+    unsigned wake_tokens_ = 0;
+    std::atomic<bool> stop_{false};
+
+    // wait() 挂起
+    std::atomic<unsigned> idle_waiters_{0};
+    mutex idle_mutex_;
+    condition_variable idle_cond_;
 };
 
+inline std::vector<thread_pool_metrics> thread_pool_registry::snapshot() {
+    std::vector<thread_pool_metrics> out;
+    for_each([&out](thread_pool& p) { out.push_back(p.metrics()); });
+    return out;
+}
+
 } // namespace zen
 
 #endif // ZEN_THREADING_POOL_THREAD_POOL_H
@@ -0,0 +1,153 @@
+/**
+ * @file work_stealing_deque.h
+ * @brief Chase–Lev 工作窃取双端队列
+ *
+ * 每个工作线程拥有一个队列：
+ * - 所有者在底部 push / pop（LIFO，刚派生的任务数据还在缓存里）
+ * - 其他线程在顶部 steal（FIFO，偷走最早、通常也是最大的任务）
+ *
+ * 所有者的 push 无原子读改写；pop 只在队列剩最后一个元素、可能与窃取者
+ * 竞争时做一次 CAS；steal 做一次 CAS。内存序按 Lê、Pop、Cohen、Nardelli
+ * 《Correct and Efficient Work-Stealing for Weak Memory Models》（PPoPP 2013）。
+ *
+ * 环形缓冲区写满时容量翻倍。旧缓冲区可能仍被并发的 steal 读取，因此不立即
+ * 释放，而是挂在新缓冲区上，随队列一起析构（总占用不超过当前容量的 2 倍）。
+ *
+ * 元素类型 T 须可平凡复制且能放进 std::atomic（通常是任务指针）。
+ */
+#ifndef ZEN_THREADING_POOL_WORK_STEALING_DEQUE_H
+#define ZEN_THREADING_POOL_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace zen {
+
+template<typename T>
+class work_stealing_deque {
+public:
+    /**
+     * @param capacity 初始容量（向上取整为 2 的幂）
+     */
+    explicit work_stealing_deque(size_t capacity = 256) {
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        ring_.store(new ring(static_cast<int64_t>(cap), nullptr), std::memory_order_relaxed);
+    }
+
+    ~work_stealing_deque() {
+        ring* r = ring_.load(std::memory_order_relaxed);
+        while (r) {
+            ring* prev = r->prev;
+            delete r;
+            r = prev;
+        }
+    }
+
+    work_stealing_deque(const work_stealing_deque&)            = delete;
+    work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+    /**
+     * @brief 所有者线程：压入底部
+     */
+    void push(T item) {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_acquire);
+        ring* r = ring_.load(std::memory_order_relaxed);
+        if (b - t > r->capacity - 1) {
+            r = r->grow(t, b);
+            ring_.store(r, std::memory_order_release);
+        }
+        r->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 所有者线程：从底部弹出
+     * @return 队列为空（或最后一个元素被窃取）时返回 false
+     */
+    bool pop(T& out) {
+        int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        ring* r = ring_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        out = r->get(b);
+        if (t == b) {
+            // 最后一个元素：与窃取者竞争 top
+            bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                    std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 任意线程：从顶部窃取
+     * @return 队列为空或与其他线程竞争失败时返回 false
+     */
+    bool steal(T& out) {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) return false;
+        ring* r = ring_.load(std::memory_order_acquire);
+        T item = r->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return false;
+        }
+        out = item;
+        return true;
+    }
+
+    /**
+     * @brief 近似元素个数（并发修改时只作提示）
+     */
+    size_t size_hint() const noexcept {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+    bool empty_hint() const noexcept { return size_hint() == 0; }
+
+private:
+    struct ring {
+        int64_t          capacity;
+        int64_t          mask;
+        std::atomic<T>*  slots;
+        ring*            prev;   // 扩容前的缓冲区，延迟到析构时释放
+
+        ring(int64_t cap, ring* previous)
+            : capacity(cap), mask(cap - 1), slots(new std::atomic<T>[static_cast<size_t>(cap)]), prev(previous) {}
+
+        ~ring() { delete[] slots; }
+
+        // 槽位用 release / acquire：任务内容随指针一起发布（x86 上与 relaxed 同为普通 mov）
+        T get(int64_t i) const noexcept { return slots[i & mask].load(std::memory_order_acquire); }
+        void put(int64_t i, T v) noexcept { slots[i & mask].store(v, std::memory_order_release); }
+
+        ring* grow(int64_t t, int64_t b) {
+            ring* bigger = new ring(capacity * 2, this);
+            for (int64_t i = t; i < b; ++i) bigger->put(i, get(i));
+            return bigger;
+        }
+    };
+
+    // top 由窃取者修改，bottom 只由所有者修改：分别放在不同缓存行
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    alignas(64) std::atomic<ring*>   ring_{nullptr};
+};
+
+} // namespace zen
+
+#endif // ZEN_THREADING_POOL_WORK_STEALING_DEQUE_H
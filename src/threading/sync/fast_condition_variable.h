@@ -0,0 +1,150 @@
+/**
+ * @file fast_condition_variable.h
+ * @brief 与 fast_mutex 配合的条件变量（事件计数 + futex）
+ *
+ * 结构：一个事件计数（epoch）加一个等待者计数。
+ * - wait：持锁读取 epoch，登记为等待者，释放锁后在 epoch 上 futex 挂起；
+ *   只要通知发生在读取之后，epoch 就已改变，futex_wait 立即返回，不会丢失通知
+ * - notify_one / notify_all：没有等待者时只是一次原子读，不进入内核；
+ *   否则递增 epoch 再唤醒
+ * - notify_all 不把所有等待者都唤醒去争抢同一把锁（抢不到的马上又睡回去）：
+ *   Linux 上用 FUTEX_CMP_REQUEUE 只唤醒一个，其余直接转移到 fast_mutex 的等待队列上，
+ *   之后随着锁的释放逐个醒来。其他平台退化为全部唤醒
+ *
+ * 与 std::condition_variable 相同：可能虚假唤醒，等待条件应放在谓词里；
+ * 同一时刻的所有等待者必须使用同一个 fast_mutex。
+ *
+ * 示例：
+ * @code
+ * zen::fast_mutex m;
+ * zen::fast_condition_variable cv;
+ * bool ready = false;
+ *
+ * // 消费者
+ * zen::unique_lock<zen::fast_mutex> ul(m);
+ * cv.wait(ul, [&]{ return ready; });
+ *
+ * // 生产者
+ * {
+ *     zen::lock_guard<zen::fast_mutex> lg(m);
+ *     ready = true;
+ * }
+ * cv.notify_one();
+ * @endcode
+ */
+#ifndef ZEN_THREADING_SYNC_FAST_CONDITION_VARIABLE_H
+#define ZEN_THREADING_SYNC_FAST_CONDITION_VARIABLE_H
+
+#include "fast_mutex.h"
+#include "lock_guard.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace zen {
+
+// ============================================================================
+// fast_condition_variable
+// ============================================================================
+
+class fast_condition_variable {
+public:
+    fast_condition_variable() noexcept : epoch_(0), waiters_(0), mutex_(nullptr) {}
+
+    fast_condition_variable(const fast_condition_variable&)            = delete;
+    fast_condition_variable& operator=(const fast_condition_variable&) = delete;
+
+    // ---- 通知 ----
+
+    /**
+     * @brief 唤醒一个等待线程
+     */
+    void notify_one() noexcept {
+        if (waiters_.load(std::memory_order_seq_cst) == 0) return;
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        detail::futex_wake(&epoch_, 1);
+    }
+
+    /**
+     * @brief 唤醒所有等待线程（Linux 上只唤醒一个，其余转移到锁上排队）
+     */
+    void notify_all() noexcept {
+        if (waiters_.load(std::memory_order_seq_cst) == 0) return;
+        uint32_t epoch = epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+        fast_mutex* m = mutex_.load(std::memory_order_relaxed);
+        if (!m || !detail::futex_requeue(&epoch_, epoch, 1, &m->state_)) {
+            detail::futex_wake_all(&epoch_);
+        }
+    }
+
+    // ---- 等待 ----
+
+    /**
+     * @brief 等待通知
+     *
+     * 原子地释放 lock 持有的锁并挂起；返回前重新持有锁。
+     */
+    void wait(unique_lock<fast_mutex>& lock) noexcept {
+        wait_impl(*lock.mutex(), -1);
+    }
+
+    /**
+     * @brief 带谓词的等待（防止虚假唤醒）
+     */
+    template<typename Predicate>
+    void wait(unique_lock<fast_mutex>& lock, Predicate pred) {
+        while (!pred()) {
+            wait(lock);
+        }
+    }
+
+    /**
+     * @brief 超时等待
+     * @param timeout_ms 超时时间（毫秒）
+     * @return 超时返回 false，被唤醒（或虚假唤醒）返回 true
+     */
+    bool wait_for(unique_lock<fast_mutex>& lock, unsigned long timeout_ms) noexcept {
+        return wait_impl(*lock.mutex(), static_cast<long>(timeout_ms));
+    }
+
+    /**
+     * @brief 带谓词的超时等待
+     *
+     * 超时时间从调用时算起（虚假唤醒不会重新计时）。
+     * @return 条件满足返回 true，超时返回 false
+     */
+    template<typename Predicate>
+    bool wait_for(unique_lock<fast_mutex>& lock, unsigned long timeout_ms, Predicate pred) {
+        using clock = std::chrono::steady_clock;
+        const clock::time_point deadline = clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (!pred()) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now()).count();
+            if (left <= 0 || !wait_impl(*lock.mutex(), static_cast<long>(left))) {
+                return pred();
+            }
+        }
+        return true;
+    }
+
+private:
+    bool wait_impl(fast_mutex& m, long timeout_ms) noexcept {
+        mutex_.store(&m, std::memory_order_relaxed);
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        uint32_t epoch = epoch_.load(std::memory_order_seq_cst);
+        m.unlock();
+        bool woken = detail::futex_wait(&epoch_, epoch, timeout_ms);
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        // 可能已被 notify_all 转移到锁上：按"有人等待"的方式加锁，unlock 时继续唤醒下一个
+        m.lock_contended();
+        return woken;
+    }
+
+    std::atomic<uint32_t>    epoch_;
+    std::atomic<uint32_t>    waiters_;
+    std::atomic<fast_mutex*> mutex_;
+};
+
+} // namespace zen
+
+#endif // ZEN_THREADING_SYNC_FAST_CONDITION_VARIABLE_H
@@ -0,0 +1,184 @@
+/**
+ * @file futex.h
+ * @brief 按地址等待 / 唤醒（futex 封装）
+ *
+ * fast_mutex / fast_condition_variable 的底层原语：线程在一个 32 位原子变量上挂起，
+ * 直到其他线程修改它并唤醒。"值仍等于 expected 才挂起"由内核（或下面的散列表锁）
+ * 原子地检查，修改后再唤醒不会丢失通知。
+ *
+ * - Linux    : futex(2)，FUTEX_PRIVATE_FLAG（只在进程内共享）；
+ *              支持 FUTEX_CMP_REQUEUE，把等待者直接转移到另一个地址上
+ * - Windows  : WaitOnAddress / WakeByAddressSingle / WakeByAddressAll（Windows 8+）
+ * - 其他 POSIX: 按地址散列到 64 组 pthread 互斥锁 + 条件变量；唤醒时广播整组，
+ *              同组其他地址的等待者会被虚假唤醒（调用方本来就要重新检查）
+ *
+ * 只提供 detail 接口，不直接面向使用者。
+ */
+#ifndef ZEN_THREADING_SYNC_FUTEX_H
+#define ZEN_THREADING_SYNC_FUTEX_H
+
+#include "mutex.h"   // ZEN_OS_WINDOWS / ZEN_OS_POSIX
+#include "../thread/thread.h"
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+
+#if defined(__linux__)
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  define ZEN_HAVE_FUTEX 1
+#elif defined(ZEN_OS_WINDOWS)
+#  include <synchapi.h>
+#  if defined(_MSC_VER)
+#    pragma comment(lib, "Synchronization.lib")
+#  endif
+#endif
+
+namespace zen {
+namespace detail {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+
+inline uint32_t* futex_addr(std::atomic<uint32_t>* word) noexcept {
+    return reinterpret_cast<uint32_t*>(word);
+}
+
+/**
+ * @brief 是否值得自旋等待（单核上自旋只会推迟持锁线程的执行）
+ */
+inline bool spin_worthwhile() noexcept {
+    static const bool multi = thread::hardware_concurrency() > 1;
+    return multi;
+}
+
+#if defined(ZEN_HAVE_FUTEX)
+
+inline long futex_call(std::atomic<uint32_t>* word, int op, uint32_t val,
+                       const struct timespec* ts, std::atomic<uint32_t>* word2, uint32_t val3) noexcept {
+    return syscall(SYS_futex, futex_addr(word), op | FUTEX_PRIVATE_FLAG, val, ts,
+                   word2 ? futex_addr(word2) : nullptr, val3);
+}
+
+/**
+ * @brief *word == expected 时挂起，直到被唤醒、超时或虚假唤醒
+ * @param timeout_ms 为负表示不超时
+ * @return 超时返回 false，其余（被唤醒、值已改变、被信号打断）返回 true
+ */
+inline bool futex_wait(std::atomic<uint32_t>* word, uint32_t expected, long timeout_ms = -1) noexcept {
+    struct timespec ts;
+    struct timespec* pts = nullptr;
+    if (timeout_ms >= 0) {
+        ts.tv_sec  = timeout_ms / 1000;
+        ts.tv_nsec = (timeout_ms % 1000) * 1000000L;
+        pts = &ts;
+    }
+    if (futex_call(word, FUTEX_WAIT, expected, pts, nullptr, 0) == 0) return true;
+    return errno != ETIMEDOUT;
+}
+
+inline void futex_wake(std::atomic<uint32_t>* word, int count) noexcept {
+    futex_call(word, FUTEX_WAKE, static_cast<uint32_t>(count), nullptr, nullptr, 0);
+}
+
+inline void futex_wake_all(std::atomic<uint32_t>* word) noexcept {
+    futex_wake(word, INT_MAX);
+}
+
+/**
+ * @brief *word == expected 时唤醒 wake 个等待者，其余转移到 target 上等待
+ * @return 平台不支持或值已改变时返回 false（调用方改用 futex_wake_all）
+ */
+inline bool futex_requeue(std::atomic<uint32_t>* word, uint32_t expected, int wake,
+                          std::atomic<uint32_t>* target) noexcept {
+    // FUTEX_CMP_REQUEUE 的第四个参数是转移数量上限（借用 timeout 参数位置传递）
+    long r = syscall(SYS_futex, futex_addr(word), FUTEX_CMP_REQUEUE | FUTEX_PRIVATE_FLAG, wake,
+                     reinterpret_cast<const struct timespec*>(static_cast<uintptr_t>(INT_MAX)),
+                     futex_addr(target), expected);
+    return r >= 0;
+}
+
+#elif defined(ZEN_OS_WINDOWS)
+
+inline bool futex_wait(std::atomic<uint32_t>* word, uint32_t expected, long timeout_ms = -1) noexcept {
+    DWORD ms = timeout_ms < 0 ? INFINITE : static_cast<DWORD>(timeout_ms);
+    if (WaitOnAddress(futex_addr(word), &expected, sizeof(uint32_t), ms)) return true;
+    return GetLastError() != ERROR_TIMEOUT;
+}
+
+inline void futex_wake(std::atomic<uint32_t>* word, int count) noexcept {
+    if (count == 1) {
+        WakeByAddressSingle(futex_addr(word));
+    } else {
+        WakeByAddressAll(futex_addr(word));
+    }
+}
+
+inline void futex_wake_all(std::atomic<uint32_t>* word) noexcept {
+    WakeByAddressAll(futex_addr(word));
+}
+
+inline bool futex_requeue(std::atomic<uint32_t>*, uint32_t, int, std::atomic<uint32_t>*) noexcept {
+    return false;
+}
+
+#else
+
+struct futex_bucket {
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t  cond = PTHREAD_COND_INITIALIZER;
+};
+
+inline futex_bucket& futex_bucket_of(const void* addr) noexcept {
+    static futex_bucket table[64];
+    uintptr_t h = reinterpret_cast<uintptr_t>(addr);
+    h ^= h >> 17;
+    return table[(h >> 2) & 63];
+}
+
+inline bool futex_wait(std::atomic<uint32_t>* word, uint32_t expected, long timeout_ms = -1) noexcept {
+    futex_bucket& b = futex_bucket_of(word);
+    bool woken = true;
+    pthread_mutex_lock(&b.lock);
+    if (word->load(std::memory_order_relaxed) == expected) {
+        if (timeout_ms < 0) {
+            pthread_cond_wait(&b.cond, &b.lock);
+        } else {
+            struct timespec ts;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            ts.tv_sec  += timeout_ms / 1000;
+            ts.tv_nsec += (timeout_ms % 1000) * 1000000L;
+            if (ts.tv_nsec >= 1000000000L) {
+                ++ts.tv_sec;
+                ts.tv_nsec -= 1000000000L;
+            }
+            woken = pthread_cond_timedwait(&b.cond, &b.lock, &ts) != ETIMEDOUT;
+        }
+    }
+    pthread_mutex_unlock(&b.lock);
+    return woken;
+}
+
+inline void futex_wake(std::atomic<uint32_t>* word, int) noexcept {
+    futex_bucket& b = futex_bucket_of(word);
+    pthread_mutex_lock(&b.lock);
+    pthread_cond_broadcast(&b.cond);
+    pthread_mutex_unlock(&b.lock);
+}
+
+inline void futex_wake_all(std::atomic<uint32_t>* word) noexcept {
+    futex_wake(word, INT_MAX);
+}
+
+inline bool futex_requeue(std::atomic<uint32_t>*, uint32_t, int, std::atomic<uint32_t>*) noexcept {
+    return false;
+}
+
+#endif
+
+} // namespace detail
+} // namespace zen
+
+#endif // ZEN_THREADING_SYNC_FUTEX_H
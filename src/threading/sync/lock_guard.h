@@ -225,6 +225,14 @@ public:
         return m;
     }
     
+    /**
+     * @brief 交换两个 unique_lock 管理的 mutex 与持有状态
+     */
+    void swap(unique_lock& other) noexcept {
+        Mutex* m = mutex_;  mutex_ = other.mutex_;  other.mutex_ = m;
+        bool   o = owns_;   owns_  = other.owns_;   other.owns_  = o;
+    }
+    
     // ---- 状态查询 ----
     
     Mutex* mutex() const noexcept { return mutex_; }
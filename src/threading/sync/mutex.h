@@ -10,6 +10,8 @@
  * - timed_mutex    : 带超时的互斥锁
  * 
  * 遵守 BasicLockable 概念（提供 lock() / unlock()）。
+ * 
+ * 竞争频繁、临界区很短的场合可改用 fast_mutex.h（futex，先自旋再挂起）。
  */
 #ifndef ZEN_THREADING_SYNC_MUTEX_H
 #define ZEN_THREADING_SYNC_MUTEX_H
@@ -3,25 +3,36 @@
  * @brief 自旋锁实现
  * 
  * 基于原子操作的自旋锁，适合锁持有时间极短的场景：
- * - spinlock    : 基于 CAS（Compare-And-Swap）的自旋锁
+ * - spinlock    : TTAS（Test-and-Test-And-Set）自旋锁
  * - ticket_lock : 基于 ticket 算法的公平自旋锁（先到先得）
  * 
  * 设计原则：
- * - 无系统调用，开销极低
- * - 自旋等待（busy-wait），适合微秒级临界区
- * - 不适合长时间持有锁的场景（会浪费 CPU）
- * 
- * 编译器 barrier：使用 __asm__ volatile("" ::: "memory") 阻止指令重排
+ * - 无竞争时无系统调用，开销极低
+ * - 竞争时指数退避：两次尝试之间的 pause 次数按 1, 2, 4 … 64 增长，
+ *   减少对锁所在缓存行的争抢
+ * - 自旋有上限：累计若干轮仍未拿到锁就改为让出 CPU（sched_yield），
+ *   线程数多于核数时持锁线程可能正被换出，一直空转只会拖慢它
+ * - 不适合长时间持有锁的场景（需要挂起等待的用 fast_mutex）
  */
 #ifndef ZEN_THREADING_SYNC_SPINLOCK_H
 #define ZEN_THREADING_SYNC_SPINLOCK_H
 
+#include <atomic>
 #include <cstdint>
 
+#if defined(_WIN32) || defined(_WIN64)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <sched.h>
+#endif
+
 namespace zen {
 
 // ============================================================================
-// 原子操作原语（手工封装，不依赖 <atomic>）
+// CPU 原语与退避
 // ============================================================================
 
 namespace detail {
@@ -70,58 +81,48 @@ inline void cpu_relax() noexcept {
 }
 
 /**
- * @brief CAS：比较并交换（返回旧值是否等于期望值）
- * @param ptr      目标地址
- * @param expected 期望旧值
- * @param desired  新值
- * @return 交换成功（旧值 == expected）返回 true
+ * @brief 让出 CPU，由调度器选择其他就绪线程
  */
-inline bool cas(volatile int* ptr, int expected, int desired) noexcept {
-#if defined(__GNUC__) || defined(__clang__)
-    return __sync_bool_compare_and_swap(ptr, expected, desired);
-#elif defined(_MSC_VER)
-    return InterlockedCompareExchange(reinterpret_cast<volatile LONG*>(ptr),
-                                      desired, expected) == expected;
+inline void yield_thread() noexcept {
+#if defined(_WIN32) || defined(_WIN64)
+    SwitchToThread();
 #else
-    // fallback：不安全，仅用于单线程测试
-    if (*ptr == expected) { *ptr = desired; return true; }
-    return false;
+    sched_yield();
 #endif
 }
 
 /**
- * @brief 原子加法（返回旧值）
+ * @brief 自旋等待的退避策略
+ *
+ * 每次 pause() 执行的 pause 指令数翻倍（1 到 max_delay），
+ * 调用 yield_after 次以后每次改为让出 CPU。
  */
-inline int atomic_fetch_add(volatile int* ptr, int val) noexcept {
-#if defined(__GNUC__) || defined(__clang__)
-    return __sync_fetch_and_add(ptr, val);
-#elif defined(_MSC_VER)
-    return InterlockedExchangeAdd(reinterpret_cast<volatile LONG*>(ptr), val);
-#else
-    int old = *ptr;
-    *ptr += val;
-    return old;
-#endif
-}
+class spin_backoff {
+public:
+    static constexpr unsigned max_delay   = 64;
+    static constexpr unsigned yield_after = 16;   // 约 1000 个 pause 指令
 
-/**
- * @brief 原子读取
- */
-inline int atomic_load(const volatile int* ptr) noexcept {
-    compiler_barrier();
-    int val = *ptr;
-    compiler_barrier();
-    return val;
-}
+    void pause() noexcept {
+        if (rounds_ < yield_after) {
+            for (unsigned i = 0; i < delay_; ++i) {
+                cpu_relax();
+            }
+            if (delay_ < max_delay) delay_ <<= 1;
+            ++rounds_;
+        } else {
+            yield_thread();
+        }
+    }
 
-/**
- * @brief 原子写入
- */
-inline void atomic_store(volatile int* ptr, int val) noexcept {
-    compiler_barrier();
-    *ptr = val;
-    compiler_barrier();
-}
+    void reset() noexcept {
+        delay_  = 1;
+        rounds_ = 0;
+    }
+
+private:
+    unsigned delay_  = 1;
+    unsigned rounds_ = 0;
+};
 
 } // namespace detail
 
@@ -130,14 +131,16 @@ inline void atomic_store(volatile int* ptr, int val) noexcept {
 // ============================================================================
 
 /**
- * @brief TAS（Test-And-Set）自旋锁
+ * @brief TTAS（Test-and-Test-And-Set）自旋锁
  * 
  * 满足 Mutex 概念（BasicLockable），可与 lock_guard/unique_lock 配合使用。
  * 
- * 内部使用 CAS 原子操作：
  * - locked_ == 0 表示空闲
  * - locked_ == 1 表示被持有
  * 
+ * 等待时只读取锁字（不写缓存行），看到空闲再尝试 exchange；
+ * 两次尝试之间指数退避，自旋一定轮数后让出 CPU。
+ * 
  * 注意：非公平锁，在高竞争下可能出现饥饿。
  * 若需要公平性，使用 ticket_lock。
  * 
@@ -157,20 +160,20 @@ public:
     spinlock& operator=(const spinlock&) = delete;
     
     /**
-     * @brief 自旋等待直到获取锁
-     * 
-     * 先使用 load 检查（快路径），减少对总线的占用（TTAS 优化）。
+     * @brief 获取锁（先自旋退避，超过上限后让出 CPU）
      */
     void lock() noexcept {
+        // 快速路径：无竞争时一次 exchange
+        if (locked_.exchange(1, std::memory_order_acquire) == 0) {
+            return;
+        }
+        detail::spin_backoff backoff;
         while (true) {
-            // 快速路径：如果锁空闲，尝试 CAS 获取
-            if (detail::atomic_load(&locked_) == 0 &&
-                detail::cas(&locked_, 0, 1)) {
-                return;
+            while (locked_.load(std::memory_order_relaxed) != 0) {
+                backoff.pause();
             }
-            // 锁被占用，自旋等待
-            while (detail::atomic_load(&locked_) != 0) {
-                detail::cpu_relax();
+            if (locked_.exchange(1, std::memory_order_acquire) == 0) {
+                return;
             }
         }
     }
@@ -180,29 +183,28 @@ public:
      * @return 成功获取返回 true，已被占用返回 false
      */
     bool try_lock() noexcept {
-        return detail::atomic_load(&locked_) == 0 &&
-               detail::cas(&locked_, 0, 1);
+        return locked_.load(std::memory_order_relaxed) == 0 &&
+               locked_.exchange(1, std::memory_order_acquire) == 0;
     }
     
     /**
      * @brief 释放锁
      */
     void unlock() noexcept {
-        detail::memory_fence();
-        detail::atomic_store(&locked_, 0);
+        locked_.store(0, std::memory_order_release);
     }
     
     /**
-     * @brief 是否被锁定（非原子，仅供诊断）
+     * @brief 是否被锁定（仅供诊断）
      */
     bool is_locked() const noexcept {
-        return detail::atomic_load(&locked_) != 0;
+        return locked_.load(std::memory_order_relaxed) != 0;
     }
 
 private:
-    volatile int locked_;
+    std::atomic<int> locked_;
     // 填充到 64 字节，避免 false sharing
-    char padding_[64 - sizeof(int)];
+    char padding_[64 - sizeof(std::atomic<int>)];
 };
 
 // ============================================================================
@@ -219,7 +221,9 @@ private:
  * 
  * 优点：严格 FIFO，无饥饿
  * 缺点：在多核高竞争下，所有等待者都在轮询 serving，
- *        可能导致缓存行 bouncing（MCS Lock 可解决此问题）
+ *        可能导致缓存行 bouncing（MCS Lock 可解决此问题）；
+ *        线程数多于核数时，下一个该拿锁的线程被换出会让后面所有人一起等待，
+ *        此时应改用 fast_mutex
  */
 class ticket_lock {
 public:
@@ -229,15 +233,32 @@ public:
     ticket_lock& operator=(const ticket_lock&) = delete;
     
     /**
-     * @brief 获取 ticket 并自旋等待轮到自己
+     * @brief 获取 ticket 并等待轮到自己
+     *
+     * 按前面还有几个等待者成比例退避（每人约 pause_per_waiter 个 pause），
+     * 自旋累计超过上限后让出 CPU。
      */
     void lock() noexcept {
         // 原子获取 ticket
-        int my_ticket = detail::atomic_fetch_add(&next_ticket_, 1);
+        unsigned my_ticket = next_ticket_.fetch_add(1, std::memory_order_relaxed);
         
-        // 等待 serving 达到我的 ticket
-        while (detail::atomic_load(&serving_) != my_ticket) {
-            detail::cpu_relax();
+        unsigned rounds = 0;
+        while (true) {
+            unsigned serving = serving_.load(std::memory_order_acquire);
+            if (serving == my_ticket) {
+                return;
+            }
+            if (rounds < detail::spin_backoff::yield_after) {
+                unsigned ahead = my_ticket - serving;
+                unsigned n = ahead * pause_per_waiter;
+                if (n > max_pause) n = max_pause;
+                for (unsigned i = 0; i < n; ++i) {
+                    detail::cpu_relax();
+                }
+                ++rounds;
+            } else {
+                detail::yield_thread();
+            }
         }
     }
     
@@ -245,26 +266,28 @@ public:
      * @brief 尝试获取锁（当且仅当没有其他等待者时成功）
      */
     bool try_lock() noexcept {
-        int ticket  = detail::atomic_load(&next_ticket_);
-        int serving = detail::atomic_load(&serving_);
-        if (ticket == serving) {
-            return detail::cas(&next_ticket_, ticket, ticket + 1);
-        }
-        return false;
+        unsigned serving = serving_.load(std::memory_order_acquire);
+        unsigned ticket  = serving;
+        return next_ticket_.compare_exchange_strong(ticket, serving + 1,
+                                                    std::memory_order_acquire,
+                                                    std::memory_order_relaxed);
     }
     
     /**
      * @brief 释放锁，通知下一个等待者
      */
     void unlock() noexcept {
-        detail::memory_fence();
-        detail::atomic_fetch_add(&serving_, 1);
+        // 只有持锁线程写 serving_
+        serving_.store(serving_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
     }
 
 private:
-    volatile int next_ticket_;
-    volatile int serving_;
-    char padding_[64 - 2 * sizeof(int)];
+    static constexpr unsigned pause_per_waiter = 16;
+    static constexpr unsigned max_pause        = 1024;
+
+    std::atomic<unsigned> next_ticket_;
+    std::atomic<unsigned> serving_;
+    char padding_[64 - 2 * sizeof(std::atomic<unsigned>)];
 };
 
 } // namespace zen
@@ -120,31 +120,37 @@ public:
     int tick() noexcept {
         unsigned long long now = this_thread::monotonic_ms();
 
-        // 弹出到期条目（加锁）
+        // 分批弹出到期条目，一批装满就再取一批，直到没有到期的
         static const int MAX_BATCH = 32;
         timer_entry fired[MAX_BATCH];
+        int total = 0;
         int count = 0;
-        {
-            lock_guard<mutex> lk(mtx_);
-            count = queue_.pop_expired(now, fired, MAX_BATCH);
-        }
-
-        // 执行回调（不持锁，允许回调内部 add_once 等操作）
-        for (int i = 0; i < count; ++i) {
-            if (fired[i].callback) {
-                fired[i].callback(fired[i].id, fired[i].user_data);
-            }
-            // 若是重复定时器，重新入队
-            if (fired[i].type == timer_type::REPEAT) {
+        do {
+            {
                 lock_guard<mutex> lk(mtx_);
-                timer_entry re = fired[i];
-                re.expire_ms = now + re.interval_ms;
-                re.cancelled = false;
-                queue_.push(re);
+                count = queue_.pop_expired(now, fired, MAX_BATCH);
+                // 整批的重复定时器先重新入队再执行任何回调：
+                // 回调内 cancel 本批中的重复定时器（包括自己）时能在队列中找到它
+                for (int i = 0; i < count; ++i) {
+                    if (fired[i].type == timer_type::REPEAT) {
+                        timer_entry re = fired[i];
+                        re.expire_ms = now + re.interval_ms;
+                        re.cancelled = false;
+                        queue_.push(re);
+                    }
+                }
             }
-        }
 
-        return count;
+            // 执行回调（不持锁，允许回调内部 add_once 等操作）
+            for (int i = 0; i < count; ++i) {
+                if (fired[i].callback) {
+                    fired[i].callback(fired[i].id, fired[i].user_data);
+                }
+            }
+            total += count;
+        } while (count == MAX_BATCH);
+
+        return total;
     }
 
     /**
@@ -4,7 +4,7 @@
  *
  * 按到期时间排序的最小堆（min-heap），支持：
  *   - push(entry)       : 插入新定时器，O(log n)
- *   - pop_expired(now)  : 弹出所有已到期的定时器，O(k log n)
+ *   - pop_expired(now)  : 弹出已到期的定时器（最多 out_max 个），O(k log n)
  *   - cancel(id)        : 惰性取消（标记 cancelled，堆中仍保留直到弹出时跳过）
  *   - size() / empty()
  *
@@ -41,22 +41,20 @@ public:
     }
 
     /**
-     * @brief 弹出所有 expire_ms <= now 的定时器（已取消的跳过）
+     * @brief 弹出 expire_ms <= now 的定时器（已取消的跳过），最多 out_max 个
      * @param now        当前单调毫秒
      * @param out        输出数组
-     * @param out_max    out 数组最大容量
+     * @param out_max    out 数组最大容量；装满后停止，其余到期条目留在堆中
      * @return 实际弹出的有效（未取消）定时器数量
      */
     int pop_expired(unsigned long long now,
                     timer_entry* out, int out_max) noexcept {
         int count = 0;
-        while (size_ > 0 && heap_[0].expire_ms <= now) {
+        while (count < out_max && size_ > 0 && heap_[0].expire_ms <= now) {
             timer_entry top = heap_[0];
             remove_top();
             if (top.cancelled) continue;  // 惰性取消：跳过
-            if (count < out_max) {
-                out[count++] = top;
-            }
+            out[count++] = top;
         }
         return count;
     }
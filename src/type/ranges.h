@@ -1,84 +1,134 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <iterator>
 #include <functional>
-#include <vector>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace zen {
 
 /**
  * @brief 范围适配器工具类
  * 对标C++20 <ranges>，简化迭代器遍历、筛选、转换
+ *
+ * 所有视图都是惰性的：构造视图只保存底层范围和参数，不分配内存、不复制元素，
+ * 元素在迭代时才逐个计算。视图可以用 | 组合成管道：
+ *
+ *   for (auto [i, x] : v | filter(is_odd) | transform(square) | take(10) | enumerate) ...
+ *
+ * 提供的适配器：
+ * - filter(pred)      : 只保留满足 pred 的元素
+ * - transform(f)      : 逐元素 f(x)，保持底层迭代器类别（随机访问仍是随机访问）
+ * - take(n) / drop(n) : 前 n 个 / 跳过前 n 个
+ * - chunk(n)          : 每 n 个元素一组，元素是 range_view
+ * - stride(n)         : 每隔 n 个取一个
+ * - enumerate         : 元素为 {index, value}，可用结构化绑定
+ * - zip(a, b, ...)    : 并行迭代多个范围，长度取最短者，元素为引用的 tuple
+ * - join              : 把范围的范围展平
+ *
+ * 生命周期：左值容器按引用包装（range_view），右值容器被移动进视图
+ * （owning_view）。视图的迭代器可能指向视图内部保存的谓词/函数，
+ * 因此迭代器不能比产生它的视图活得更久——与标准库相同。
  */
 namespace ranges {
 
+// ============================================================================
+// 基础设施
+// ============================================================================
+
 /**
- * @brief 范围包装类
- * 用于包装可迭代对象，提供链式调用的范围操作
- * @tparam Iterator 迭代器类型
+ * @brief 所有视图的标记基类
  */
-template <typename Iterator>
-class range_view {
-public:
-    using value_type = typename std::iterator_traits<Iterator>::value_type;
-    using reference = typename std::iterator_traits<Iterator>::reference;
-    using pointer = typename std::iterator_traits<Iterator>::pointer;
-    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
-    using iterator_category = typename std::iterator_traits<Iterator>::iterator_category;
+struct view_base {};
 
-    /**
-     * @brief 构造函数
-     * @param begin 起始迭代器
-     * @param end 结束迭代器
-     */
-    range_view(Iterator begin, Iterator end) : begin_(begin), end_(end) {}
+template <typename R>
+using iterator_t = decltype(std::begin(std::declval<R&>()));
 
-    /**
-     * @brief 获取起始迭代器
-     * @return 起始迭代器
-     */
-    Iterator begin() const { return begin_; }
+template <typename R>
+using range_reference_t = typename std::iterator_traits<iterator_t<R>>::reference;
+
+template <typename R>
+using range_difference_t = typename std::iterator_traits<iterator_t<R>>::difference_type;
+
+template <typename It>
+inline constexpr bool is_random_access_iterator_v = std::is_base_of_v<
+    std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
+template <typename It>
+inline constexpr bool is_bidirectional_iterator_v = std::is_base_of_v<
+    std::bidirectional_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
 
+namespace detail {
+
+template <typename T>
+using uncvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+/**
+ * @brief 把 it 向 end 方向前进至多 n 步，返回实际前进的步数
+ *
+ * 随机访问迭代器 O(1)，其余逐步前进并在 end 处停下。
+ */
+template <typename It, typename Diff>
+Diff bounded_advance(It& it, Diff n, const It& end) {
+    if constexpr (is_random_access_iterator_v<It>) {
+        Diff left = static_cast<Diff>(end - it);
+        if (n > left) n = left;
+        it += n;
+        return n;
+    } else {
+        Diff moved = 0;
+        for (; moved < n && it != end; ++moved) ++it;
+        return moved;
+    }
+}
+
+// 迭代器类别取底层类别与上限中较弱的一个
+template <typename It, typename Cap>
+using capped_category_t = std::conditional_t<
+    std::is_base_of_v<Cap, typename std::iterator_traits<It>::iterator_category>,
+    Cap, typename std::iterator_traits<It>::iterator_category>;
+
+// operator-> 的代理：引用是纯右值时保存一份临时值
+template <typename T>
+struct arrow_proxy {
+    T value;
+    T* operator->() { return &value; }
+};
+
+} // namespace detail
+
+template <typename T>
+inline constexpr bool is_view_v = std::is_base_of_v<view_base, detail::uncvref_t<T>>;
+
+/**
+ * @brief 视图的公共接口（CRTP）：由 begin()/end() 派生出便捷操作
+ */
+template <typename Derived>
+class view_interface : public view_base {
+public:
     /**
-     * @brief 获取结束迭代器
-     * @return 结束迭代器
+     * @brief 判断范围是否为空
+     * @return 是否为空
      */
-    Iterator end() const { return end_; }
+    bool empty() const { return derived().begin() == derived().end(); }
+
+    explicit operator bool() const { return !empty(); }
 
     /**
-     * @brief 筛选操作
-     * @tparam Predicate 谓词类型
-     * @param pred 筛选条件
-     * @return 筛选后的范围视图
+     * @brief 统计元素总个数（非随机访问迭代器为 O(n)）
+     * @return 元素总个数
      */
-    template <typename Predicate>
-    range_view filter(Predicate pred) const {
-        // 这里简化实现，实际应该返回一个延迟计算的视图
-        std::vector<value_type> result;
-        for (auto it = begin_; it != end_; ++it) {
-            if (pred(*it)) {
-                result.push_back(*it);
-            }
-        }
-        return range_view(result.begin(), result.end());
+    size_t size() const {
+        return static_cast<size_t>(std::distance(derived().begin(), derived().end()));
     }
 
     /**
-     * @brief 转换操作
-     * @tparam Transformer 转换函数类型
-     * @param transform 转换函数
-     * @return 转换后的范围视图
+     * @brief 第一个元素（范围不得为空）
      */
-    template <typename Transformer>
-    auto transform(Transformer transform) const {
-        using result_type = decltype(transform(*begin_));
-        std::vector<result_type> result;
-        for (auto it = begin_; it != end_; ++it) {
-            result.push_back(transform(*it));
-        }
-        return range_view<typename std::vector<result_type>::iterator>(result.begin(), result.end());
-    }
+    decltype(auto) front() const { return *derived().begin(); }
 
     /**
      * @brief 遍历操作
@@ -87,7 +137,7 @@ public:
      */
     template <typename Func>
     void for_each(Func func) const {
-        for (auto it = begin_; it != end_; ++it) {
+        for (auto it = derived().begin(), last = derived().end(); it != last; ++it) {
             func(*it);
         }
     }
@@ -101,7 +151,7 @@ public:
     template <typename Predicate>
     size_t count_if(Predicate pred) const {
         size_t count = 0;
-        for (auto it = begin_; it != end_; ++it) {
+        for (auto it = derived().begin(), last = derived().end(); it != last; ++it) {
             if (pred(*it)) {
                 ++count;
             }
@@ -110,26 +160,866 @@ public:
     }
 
     /**
-     * @brief 统计元素总个数
-     * @return 元素总个数
+     * @brief 把元素复制到指定容器（唯一会分配内存的操作）
+     * @tparam Container 目标容器类型，需支持 push_back
      */
-    size_t size() const {
-        return std::distance(begin_, end_);
+    template <typename Container>
+    Container to() const {
+        Container c;
+        for (auto it = derived().begin(), last = derived().end(); it != last; ++it) {
+            c.push_back(*it);
+        }
+        return c;
     }
 
+    // 链式调用形式，与 | 管道等价；定义在各视图类型之后
+    template <typename Predicate> auto filter(Predicate pred) const;
+    template <typename Transformer> auto transform(Transformer transform) const;
+
+private:
+    const Derived& derived() const { return static_cast<const Derived&>(*this); }
+};
+
+// ============================================================================
+// range_view / owning_view：把容器包装为视图
+// ============================================================================
+
+/**
+ * @brief 范围包装类
+ * 用于包装可迭代对象，提供链式调用的范围操作
+ * 只保存一对迭代器，不拥有元素；复制开销与两个迭代器相同。
+ * @tparam Iterator 迭代器类型
+ */
+template <typename Iterator>
+class range_view : public view_interface<range_view<Iterator>> {
+public:
+    using iterator = Iterator;
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+    using reference = typename std::iterator_traits<Iterator>::reference;
+    using pointer = typename std::iterator_traits<Iterator>::pointer;
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+    using iterator_category = typename std::iterator_traits<Iterator>::iterator_category;
+
+    range_view() = default;
+
     /**
-     * @brief 判断范围是否为空
-     * @return 是否为空
+     * @brief 构造函数
+     * @param begin 起始迭代器
+     * @param end 结束迭代器
+     */
+    range_view(Iterator begin, Iterator end) : begin_(begin), end_(end) {}
+
+    /**
+     * @brief 获取起始迭代器
+     * @return 起始迭代器
      */
-    bool empty() const {
-        return begin_ == end_;
+    Iterator begin() const { return begin_; }
+
+    /**
+     * @brief 获取结束迭代器
+     * @return 结束迭代器
+     */
+    Iterator end() const { return end_; }
+
+private:
+    Iterator begin_{};
+    Iterator end_{};
+};
+
+/**
+ * @brief 迭代器不依赖视图对象本身存活的视图（可以安全地从临时视图取迭代器）
+ */
+template <typename T> struct is_borrowed_view { static constexpr bool value = false; };
+template <typename It> struct is_borrowed_view<range_view<It>> { static constexpr bool value = true; };
+
+/**
+ * @brief 拥有容器的视图：管道左侧是右值容器时，把容器移动进来保证元素存活
+ * @tparam Container 容器类型
+ */
+template <typename Container>
+class owning_view : public view_interface<owning_view<Container>> {
+public:
+    explicit owning_view(Container&& c) : c_(std::move(c)) {}
+
+    auto begin() const { return std::begin(c_); }
+    auto end() const { return std::end(c_); }
+
+private:
+    Container c_;
+};
+
+/**
+ * @brief 把任意可迭代对象转换为视图
+ *
+ * 视图原样复制；左值容器包装为 range_view；右值容器移动进 owning_view。
+ */
+template <typename Range>
+auto all(Range&& range) {
+    if constexpr (is_view_v<Range>) {
+        return detail::uncvref_t<Range>(std::forward<Range>(range));
+    } else if constexpr (std::is_lvalue_reference_v<Range>) {
+        using It = decltype(std::begin(range));
+        return range_view<It>(std::begin(range), std::end(range));
+    } else {
+        return owning_view<detail::uncvref_t<Range>>(std::move(range));
+    }
+}
+
+template <typename Range>
+using all_t = decltype(all(std::declval<Range>()));
+
+// ============================================================================
+// filter_view
+// ============================================================================
+
+/**
+ * @brief 只保留满足谓词的元素
+ *
+ * 前向迭代器；begin() 每次调用都会从头查找第一个满足条件的元素。
+ */
+template <typename View, typename Predicate>
+class filter_view : public view_interface<filter_view<View, Predicate>> {
+    using base_iterator = iterator_t<const View>;
+
+public:
+    class iterator {
+    public:
+        using iterator_category = detail::capped_category_t<base_iterator, std::forward_iterator_tag>;
+        using value_type = typename std::iterator_traits<base_iterator>::value_type;
+        using difference_type = typename std::iterator_traits<base_iterator>::difference_type;
+        using reference = typename std::iterator_traits<base_iterator>::reference;
+        using pointer = typename std::iterator_traits<base_iterator>::pointer;
+
+        iterator() = default;
+        iterator(base_iterator cur, base_iterator end, const Predicate* pred)
+            : cur_(cur), end_(end), pred_(pred) {
+            satisfy();
+        }
+
+        reference operator*() const { return *cur_; }
+        base_iterator operator->() const { return cur_; }
+
+        iterator& operator++() {
+            ++cur_;
+            satisfy();
+            return *this;
+        }
+        iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.cur_ == b.cur_; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return a.cur_ != b.cur_; }
+
+        base_iterator base() const { return cur_; }
+
+    private:
+        void satisfy() {
+            while (cur_ != end_ && !(*pred_)(*cur_)) ++cur_;
+        }
+
+        base_iterator    cur_{};
+        base_iterator    end_{};
+        const Predicate* pred_ = nullptr;
+    };
+
+    filter_view(View base, Predicate pred) : base_(std::move(base)), pred_(std::move(pred)) {}
+
+    iterator begin() const { return iterator(std::begin(base_), std::end(base_), &pred_); }
+    iterator end() const { return iterator(std::end(base_), std::end(base_), &pred_); }
+
+private:
+    View      base_;
+    Predicate pred_;
+};
+
+// ============================================================================
+// transform_view
+// ============================================================================
+
+/**
+ * @brief 逐元素变换：元素为 f(x)
+ *
+ * 迭代器类别与底层相同（最高随机访问），因此 take/drop/size 在随机访问
+ * 底层上仍是 O(1)。f 必须可以通过 const 引用调用。
+ */
+template <typename View, typename Transformer>
+class transform_view : public view_interface<transform_view<View, Transformer>> {
+    using base_iterator = iterator_t<const View>;
+    using base_reference = typename std::iterator_traits<base_iterator>::reference;
+
+public:
+    class iterator {
+    public:
+        using iterator_category = detail::capped_category_t<base_iterator, std::random_access_iterator_tag>;
+        using reference = std::invoke_result_t<const Transformer&, base_reference>;
+        using value_type = detail::uncvref_t<reference>;
+        using difference_type = typename std::iterator_traits<base_iterator>::difference_type;
+        using pointer = void;
+
+        iterator() = default;
+        iterator(base_iterator cur, const Transformer* f) : cur_(cur), f_(f) {}
+
+        reference operator*() const { return std::invoke(*f_, *cur_); }
+        reference operator[](difference_type n) const { return std::invoke(*f_, cur_[n]); }
+
+        iterator& operator++() { ++cur_; return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++cur_; return tmp; }
+        iterator& operator--() { --cur_; return *this; }
+        iterator operator--(int) { iterator tmp = *this; --cur_; return tmp; }
+        iterator& operator+=(difference_type n) { cur_ += n; return *this; }
+        iterator& operator-=(difference_type n) { cur_ -= n; return *this; }
+
+        friend iterator operator+(iterator it, difference_type n) { it.cur_ += n; return it; }
+        friend iterator operator+(difference_type n, iterator it) { it.cur_ += n; return it; }
+        friend iterator operator-(iterator it, difference_type n) { it.cur_ -= n; return it; }
+        friend difference_type operator-(const iterator& a, const iterator& b) { return a.cur_ - b.cur_; }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.cur_ == b.cur_; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return a.cur_ != b.cur_; }
+        friend bool operator<(const iterator& a, const iterator& b) { return a.cur_ < b.cur_; }
+        friend bool operator>(const iterator& a, const iterator& b) { return b.cur_ < a.cur_; }
+        friend bool operator<=(const iterator& a, const iterator& b) { return !(b.cur_ < a.cur_); }
+        friend bool operator>=(const iterator& a, const iterator& b) { return !(a.cur_ < b.cur_); }
+
+        base_iterator base() const { return cur_; }
+
+    private:
+        base_iterator      cur_{};
+        const Transformer* f_ = nullptr;
+    };
+
+    transform_view(View base, Transformer f) : base_(std::move(base)), f_(std::move(f)) {}
+
+    iterator begin() const { return iterator(std::begin(base_), &f_); }
+    iterator end() const { return iterator(std::end(base_), &f_); }
+
+private:
+    View        base_;
+    Transformer f_;
+};
+
+// ============================================================================
+// take_view / drop_view
+// ============================================================================
+
+/**
+ * @brief 前 n 个元素（不足 n 个时取全部）
+ *
+ * 随机访问底层直接返回底层迭代器，循环与手写的下标循环相同；
+ * 其余底层使用带剩余计数的迭代器，到达 n 个或底层结束时等于 end()。
+ */
+template <typename View>
+class take_view : public view_interface<take_view<View>> {
+    using base_iterator = iterator_t<const View>;
+    using difference_type = typename std::iterator_traits<base_iterator>::difference_type;
+
+public:
+    class counted_iterator {
+    public:
+        using iterator_category = detail::capped_category_t<base_iterator, std::forward_iterator_tag>;
+        using value_type = typename std::iterator_traits<base_iterator>::value_type;
+        using difference_type = typename std::iterator_traits<base_iterator>::difference_type;
+        using reference = typename std::iterator_traits<base_iterator>::reference;
+        using pointer = typename std::iterator_traits<base_iterator>::pointer;
+
+        counted_iterator() = default;
+        counted_iterator(base_iterator cur, difference_type left) : cur_(cur), left_(left) {}
+
+        reference operator*() const { return *cur_; }
+        base_iterator operator->() const { return cur_; }
+
+        counted_iterator& operator++() { ++cur_; --left_; return *this; }
+        counted_iterator operator++(int) { counted_iterator tmp = *this; ++*this; return tmp; }
+
+        // 剩余计数相同（同一位置或都已取满）或底层位置相同（底层已结束）即相等
+        friend bool operator==(const counted_iterator& a, const counted_iterator& b) {
+            return a.left_ == b.left_ || a.cur_ == b.cur_;
+        }
+        friend bool operator!=(const counted_iterator& a, const counted_iterator& b) { return !(a == b); }
+
+        base_iterator base() const { return cur_; }
+
+    private:
+        base_iterator   cur_{};
+        difference_type left_ = 0;
+    };
+
+    using iterator = std::conditional_t<is_random_access_iterator_v<base_iterator>,
+                                        base_iterator, counted_iterator>;
+
+    take_view(View base, difference_type n) : base_(std::move(base)), n_(n < 0 ? 0 : n) {}
+
+    iterator begin() const {
+        if constexpr (is_random_access_iterator_v<base_iterator>) {
+            return std::begin(base_);
+        } else {
+            return counted_iterator(std::begin(base_), n_);
+        }
+    }
+
+    iterator end() const {
+        if constexpr (is_random_access_iterator_v<base_iterator>) {
+            base_iterator it = std::begin(base_);
+            detail::bounded_advance(it, n_, base_iterator(std::end(base_)));
+            return it;
+        } else {
+            return counted_iterator(std::end(base_), 0);
+        }
+    }
+
+private:
+    View            base_;
+    difference_type n_;
+};
+
+/**
+ * @brief 跳过前 n 个元素
+ *
+ * 迭代器就是底层迭代器；begin() 对非随机访问底层为 O(n)。
+ */
+template <typename View>
+class drop_view : public view_interface<drop_view<View>> {
+    using base_iterator = iterator_t<const View>;
+    using difference_type = typename std::iterator_traits<base_iterator>::difference_type;
+
+public:
+    using iterator = base_iterator;
+
+    drop_view(View base, difference_type n) : base_(std::move(base)), n_(n < 0 ? 0 : n) {}
+
+    iterator begin() const {
+        base_iterator it = std::begin(base_);
+        detail::bounded_advance(it, n_, base_iterator(std::end(base_)));
+        return it;
+    }
+
+    iterator end() const { return std::end(base_); }
+
+private:
+    View            base_;
+    difference_type n_;
+};
+
+// ============================================================================
+// chunk_view / stride_view
+// ============================================================================
+
+/**
+ * @brief 每 n 个元素一组；最后一组可能不足 n 个
+ *
+ * 元素是指向底层的 range_view，不复制元素。
+ */
+template <typename View>
+class chunk_view : public view_interface<chunk_view<View>> {
+    using base_iterator = iterator_t<const View>;
+
+public:
+    using difference_type = typename std::iterator_traits<base_iterator>::difference_type;
+
+    class iterator {
+    public:
+        using iterator_category = detail::capped_category_t<base_iterator, std::forward_iterator_tag>;
+        using value_type = range_view<base_iterator>;
+        using difference_type = typename std::iterator_traits<base_iterator>::difference_type;
+        using reference = value_type;
+        using pointer = void;
+
+        iterator() = default;
+        iterator(base_iterator cur, base_iterator end, difference_type n)
+            : cur_(cur), next_(cur), end_(end), n_(n) {
+            detail::bounded_advance(next_, n_, end_);
+        }
+
+        reference operator*() const { return value_type(cur_, next_); }
+        detail::arrow_proxy<value_type> operator->() const { return {**this}; }
+
+        iterator& operator++() {
+            cur_ = next_;
+            detail::bounded_advance(next_, n_, end_);
+            return *this;
+        }
+        iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.cur_ == b.cur_; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return a.cur_ != b.cur_; }
+
+    private:
+        base_iterator   cur_{};
+        base_iterator   next_{};
+        base_iterator   end_{};
+        difference_type n_ = 1;
+    };
+
+    chunk_view(View base, difference_type n) : base_(std::move(base)), n_(n < 1 ? 1 : n) {}
+
+    iterator begin() const { return iterator(std::begin(base_), std::end(base_), n_); }
+    iterator end() const { return iterator(std::end(base_), std::end(base_), n_); }
+
+private:
+    View            base_;
+    difference_type n_;
+};
+
+/**
+ * @brief 从第一个元素开始每隔 n 个取一个
+ *
+ * 随机访问底层用「起点 + 下标」表示位置，end() 的下标向上取整到 n 的倍数，
+ * 因此循环就是 for (i = 0; i != end; i += n)，不会构造越界迭代器；
+ * 其余底层逐步前进并在 end 处停下。
+ */
+template <typename View>
+class stride_view : public view_interface<stride_view<View>> {
+    using base_iterator = iterator_t<const View>;
+
+public:
+    using difference_type = typename std::iterator_traits<base_iterator>::difference_type;
+
+    class indexed_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename std::iterator_traits<base_iterator>::value_type;
+        using difference_type = typename std::iterator_traits<base_iterator>::difference_type;
+        using reference = typename std::iterator_traits<base_iterator>::reference;
+        using pointer = typename std::iterator_traits<base_iterator>::pointer;
+
+        indexed_iterator() = default;
+        indexed_iterator(base_iterator first, difference_type index, difference_type step)
+            : first_(first), index_(index), step_(step) {}
+
+        reference operator*() const { return first_[index_]; }
+        base_iterator operator->() const { return first_ + index_; }
+
+        indexed_iterator& operator++() { index_ += step_; return *this; }
+        indexed_iterator operator++(int) { indexed_iterator tmp = *this; index_ += step_; return tmp; }
+
+        friend bool operator==(const indexed_iterator& a, const indexed_iterator& b) { return a.index_ == b.index_; }
+        friend bool operator!=(const indexed_iterator& a, const indexed_iterator& b) { return a.index_ != b.index_; }
+
+        base_iterator base() const { return first_ + index_; }
+
+    private:
+        base_iterator   first_{};
+        difference_type index_ = 0;
+        difference_type step_ = 1;
+    };
+
+    class stepping_iterator {
+    public:
+        using iterator_category = detail::capped_category_t<base_iterator, std::forward_iterator_tag>;
+        using value_type = typename std::iterator_traits<base_iterator>::value_type;
+        using difference_type = typename std::iterator_traits<base_iterator>::difference_type;
+        using reference = typename std::iterator_traits<base_iterator>::reference;
+        using pointer = typename std::iterator_traits<base_iterator>::pointer;
+
+        stepping_iterator() = default;
+        stepping_iterator(base_iterator cur, base_iterator end, difference_type step)
+            : cur_(cur), end_(end), step_(step) {}
+
+        reference operator*() const { return *cur_; }
+        base_iterator operator->() const { return cur_; }
+
+        stepping_iterator& operator++() {
+            detail::bounded_advance(cur_, step_, end_);
+            return *this;
+        }
+        stepping_iterator operator++(int) { stepping_iterator tmp = *this; ++*this; return tmp; }
+
+        friend bool operator==(const stepping_iterator& a, const stepping_iterator& b) { return a.cur_ == b.cur_; }
+        friend bool operator!=(const stepping_iterator& a, const stepping_iterator& b) { return a.cur_ != b.cur_; }
+
+        base_iterator base() const { return cur_; }
+
+    private:
+        base_iterator   cur_{};
+        base_iterator   end_{};
+        difference_type step_ = 1;
+    };
+
+    using iterator = std::conditional_t<is_random_access_iterator_v<base_iterator>,
+                                        indexed_iterator, stepping_iterator>;
+
+    stride_view(View base, difference_type n) : base_(std::move(base)), n_(n < 1 ? 1 : n) {}
+
+    iterator begin() const {
+        if constexpr (is_random_access_iterator_v<base_iterator>) {
+            return indexed_iterator(std::begin(base_), 0, n_);
+        } else {
+            return stepping_iterator(std::begin(base_), std::end(base_), n_);
+        }
+    }
+
+    iterator end() const {
+        if constexpr (is_random_access_iterator_v<base_iterator>) {
+            difference_type size = std::end(base_) - std::begin(base_);
+            return indexed_iterator(std::begin(base_), (size + n_ - 1) / n_ * n_, n_);
+        } else {
+            return stepping_iterator(std::end(base_), std::end(base_), n_);
+        }
     }
 
 private:
-    Iterator begin_;
-    Iterator end_;
+    View            base_;
+    difference_type n_;
+};
+
+// ============================================================================
+// enumerate_view / zip_view
+// ============================================================================
+
+/**
+ * @brief enumerate 的元素：下标与底层元素的引用
+ *
+ *   for (auto [i, x] : v | enumerate) x += i;   // x 是底层元素的引用
+ */
+template <typename Reference>
+struct enumerate_element {
+    size_t    index;
+    Reference value;
 };
 
+/**
+ * @brief 给每个元素附上从 0 开始的下标
+ */
+template <typename View>
+class enumerate_view : public view_interface<enumerate_view<View>> {
+    using base_iterator = iterator_t<const View>;
+
+public:
+    class iterator {
+    public:
+        using iterator_category = detail::capped_category_t<base_iterator, std::forward_iterator_tag>;
+        using reference = enumerate_element<typename std::iterator_traits<base_iterator>::reference>;
+        using value_type = reference;
+        using difference_type = typename std::iterator_traits<base_iterator>::difference_type;
+        using pointer = void;
+
+        iterator() = default;
+        iterator(base_iterator cur, size_t index) : cur_(cur), index_(index) {}
+
+        reference operator*() const { return reference{index_, *cur_}; }
+
+        iterator& operator++() { ++cur_; ++index_; return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.cur_ == b.cur_; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return a.cur_ != b.cur_; }
+
+        base_iterator base() const { return cur_; }
+        size_t index() const { return index_; }
+
+    private:
+        base_iterator cur_{};
+        size_t        index_ = 0;
+    };
+
+    explicit enumerate_view(View base) : base_(std::move(base)) {}
+
+    iterator begin() const { return iterator(std::begin(base_), 0); }
+    // end 的下标不参与比较
+    iterator end() const { return iterator(std::end(base_), 0); }
+
+private:
+    View base_;
+};
+
+/**
+ * @brief 并行迭代多个范围，长度取最短者
+ *
+ * 元素是各底层元素引用组成的 std::tuple，可用结构化绑定：
+ *   for (auto [a, b] : zip(xs, ys)) a += b;
+ *
+ * 全部底层都是随机访问时，end() 的每个分量都是 begin + 最短长度，
+ * 相等比较只看第一个分量；否则任一分量到达末尾即结束。
+ */
+template <typename... Views>
+class zip_view : public view_interface<zip_view<Views...>> {
+    static_assert(sizeof...(Views) > 0, "zip needs at least one range");
+
+    using iterators = std::tuple<iterator_t<const Views>...>;
+
+    static constexpr bool all_random_access = (is_random_access_iterator_v<iterator_t<const Views>> && ...);
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using reference = std::tuple<typename std::iterator_traits<iterator_t<const Views>>::reference...>;
+        using value_type = std::tuple<typename std::iterator_traits<iterator_t<const Views>>::value_type...>;
+        using difference_type = std::common_type_t<range_difference_t<const Views>...>;
+        using pointer = void;
+
+        iterator() = default;
+        explicit iterator(iterators its) : its_(std::move(its)) {}
+
+        reference operator*() const {
+            return std::apply([](const auto&... it) { return reference(*it...); }, its_);
+        }
+
+        iterator& operator++() {
+            std::apply([](auto&... it) { (++it, ...); }, its_);
+            return *this;
+        }
+        iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+        // 非随机访问时任一分量相等即视为相等：最短的范围结束时整个 zip 结束
+        friend bool operator==(const iterator& a, const iterator& b) {
+            if constexpr (all_random_access) {
+                return std::get<0>(a.its_) == std::get<0>(b.its_);
+            } else {
+                return a.any_equal(b, std::index_sequence_for<Views...>{});
+            }
+        }
+        friend bool operator!=(const iterator& a, const iterator& b) { return !(a == b); }
+
+    private:
+        template <size_t... I>
+        bool any_equal(const iterator& other, std::index_sequence<I...>) const {
+            return ((std::get<I>(its_) == std::get<I>(other.its_)) || ...);
+        }
+
+        iterators its_{};
+    };
+
+    explicit zip_view(Views... views) : views_(std::move(views)...) {}
+
+    iterator begin() const {
+        return iterator(std::apply([](const auto&... v) { return iterators(std::begin(v)...); }, views_));
+    }
+
+    iterator end() const {
+        if constexpr (all_random_access) {
+            return iterator(std::apply([](const auto&... v) {
+                auto n = std::min({static_cast<std::ptrdiff_t>(std::end(v) - std::begin(v))...});
+                return iterators((std::begin(v) + n)...);
+            }, views_));
+        } else {
+            return iterator(std::apply([](const auto&... v) { return iterators(std::end(v)...); }, views_));
+        }
+    }
+
+private:
+    std::tuple<Views...> views_;
+};
+
+// ============================================================================
+// join_view
+// ============================================================================
+
+/**
+ * @brief 把范围的范围展平为一个范围，空的内层范围被跳过
+ *
+ * 外层元素必须是左值引用（例如 vector<vector<T>>），或是迭代器不依赖
+ * 自身存活的视图（例如 chunk 产生的 range_view）。
+ */
+template <typename View>
+class join_view : public view_interface<join_view<View>> {
+    using outer_iterator = iterator_t<const View>;
+    using outer_reference = typename std::iterator_traits<outer_iterator>::reference;
+    using inner_range = std::remove_reference_t<outer_reference>;
+    using inner_iterator = iterator_t<inner_range>;
+
+    static_assert(std::is_lvalue_reference_v<outer_reference> ||
+                  is_borrowed_view<detail::uncvref_t<outer_reference>>::value,
+                  "join requires inner ranges that outlive the dereferenced outer iterator");
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename std::iterator_traits<inner_iterator>::value_type;
+        using difference_type = typename std::iterator_traits<inner_iterator>::difference_type;
+        using reference = typename std::iterator_traits<inner_iterator>::reference;
+        using pointer = typename std::iterator_traits<inner_iterator>::pointer;
+
+        iterator() = default;
+        iterator(outer_iterator outer, outer_iterator outer_end)
+            : outer_(outer), outer_end_(outer_end) {
+            satisfy();
+        }
+
+        reference operator*() const { return *inner_; }
+        inner_iterator operator->() const { return inner_; }
+
+        iterator& operator++() {
+            if (++inner_ == inner_end_) {
+                ++outer_;
+                satisfy();
+            }
+            return *this;
+        }
+        iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+
+        friend bool operator==(const iterator& a, const iterator& b) {
+            return a.outer_ == b.outer_ && (a.outer_ == a.outer_end_ || a.inner_ == b.inner_);
+        }
+        friend bool operator!=(const iterator& a, const iterator& b) { return !(a == b); }
+
+    private:
+        // 定位到下一个非空内层范围的开头
+        void satisfy() {
+            for (; outer_ != outer_end_; ++outer_) {
+                auto&& inner = *outer_;
+                inner_ = std::begin(inner);
+                inner_end_ = std::end(inner);
+                if (inner_ != inner_end_) return;
+            }
+        }
+
+        outer_iterator outer_{};
+        outer_iterator outer_end_{};
+        inner_iterator inner_{};
+        inner_iterator inner_end_{};
+    };
+
+    explicit join_view(View base) : base_(std::move(base)) {}
+
+    iterator begin() const { return iterator(std::begin(base_), std::end(base_)); }
+    iterator end() const { return iterator(std::end(base_), std::end(base_)); }
+
+private:
+    View base_;
+};
+
+// view_interface 的链式调用
+template <typename Derived>
+template <typename Predicate>
+auto view_interface<Derived>::filter(Predicate pred) const {
+    return filter_view<Derived, Predicate>(derived(), std::move(pred));
+}
+
+template <typename Derived>
+template <typename Transformer>
+auto view_interface<Derived>::transform(Transformer transform) const {
+    return transform_view<Derived, Transformer>(derived(), std::move(transform));
+}
+
+// ============================================================================
+// 管道适配器：range | adaptor
+// ============================================================================
+
+/**
+ * @brief 适配器闭包：保存参数，作用于范围时构造对应视图
+ *
+ * range | a 等价于 a(range)；两个闭包 a | b 组合成新的闭包。
+ */
+template <typename Fn>
+struct adaptor_closure {
+    Fn fn;
+
+    template <typename Range>
+    auto operator()(Range&& range) const { return fn(all(std::forward<Range>(range))); }
+};
+
+template <typename T> struct is_adaptor_closure { static constexpr bool value = false; };
+template <typename Fn> struct is_adaptor_closure<adaptor_closure<Fn>> { static constexpr bool value = true; };
+
+template <typename Fn>
+adaptor_closure<Fn> make_adaptor_closure(Fn fn) { return adaptor_closure<Fn>{std::move(fn)}; }
+
+template <typename Range, typename Fn,
+          typename = std::enable_if_t<!is_adaptor_closure<detail::uncvref_t<Range>>::value>>
+auto operator|(Range&& range, const adaptor_closure<Fn>& a) {
+    return a(std::forward<Range>(range));
+}
+
+template <typename F1, typename F2>
+auto operator|(adaptor_closure<F1> a, adaptor_closure<F2> b) {
+    return make_adaptor_closure([a = std::move(a), b = std::move(b)](auto view) {
+        return b(a(std::move(view)));
+    });
+}
+
+/**
+ * @brief 筛选适配器：range | filter(pred)
+ */
+template <typename Predicate>
+auto filter(Predicate pred) {
+    return make_adaptor_closure([pred = std::move(pred)](auto view) {
+        return filter_view<decltype(view), Predicate>(std::move(view), pred);
+    });
+}
+
+/**
+ * @brief 转换适配器：range | transform(f)
+ */
+template <typename Transformer>
+auto transform(Transformer f) {
+    return make_adaptor_closure([f = std::move(f)](auto view) {
+        return transform_view<decltype(view), Transformer>(std::move(view), f);
+    });
+}
+
+/**
+ * @brief 取前 n 个：range | take(n)
+ */
+inline auto take(std::ptrdiff_t n) {
+    return make_adaptor_closure([n](auto view) {
+        return take_view<decltype(view)>(std::move(view), n);
+    });
+}
+
+/**
+ * @brief 跳过前 n 个：range | drop(n)
+ */
+inline auto drop(std::ptrdiff_t n) {
+    return make_adaptor_closure([n](auto view) {
+        return drop_view<decltype(view)>(std::move(view), n);
+    });
+}
+
+/**
+ * @brief 每 n 个一组：range | chunk(n)
+ */
+inline auto chunk(std::ptrdiff_t n) {
+    return make_adaptor_closure([n](auto view) {
+        return chunk_view<decltype(view)>(std::move(view), n);
+    });
+}
+
+/**
+ * @brief 每隔 n 个取一个：range | stride(n)
+ */
+inline auto stride(std::ptrdiff_t n) {
+    return make_adaptor_closure([n](auto view) {
+        return stride_view<decltype(view)>(std::move(view), n);
+    });
+}
+
+namespace detail {
+
+struct enumerate_fn {
+    template <typename View>
+    auto operator()(View view) const { return enumerate_view<View>(std::move(view)); }
+};
+
+struct join_fn {
+    template <typename View>
+    auto operator()(View view) const { return join_view<View>(std::move(view)); }
+};
+
+} // namespace detail
+
+/**
+ * @brief 附加下标：range | enumerate 或 enumerate(range)
+ */
+inline constexpr adaptor_closure<detail::enumerate_fn> enumerate{};
+
+/**
+ * @brief 展平：range | join 或 join(range)
+ */
+inline constexpr adaptor_closure<detail::join_fn> join{};
+
+/**
+ * @brief 并行迭代多个范围：zip(a, b, ...)
+ */
+template <typename... Ranges>
+auto zip(Ranges&&... ranges) {
+    return zip_view<all_t<Ranges>...>(all(std::forward<Ranges>(ranges))...);
+}
+
+// ============================================================================
+// 函数形式
+// ============================================================================
+
 /**
  * @brief 创建范围视图
  * @tparam Range 可迭代类型
@@ -170,24 +1060,11 @@ range_view<T*> view(T (&arr)[N]) {
  * @tparam Predicate 谓词类型
  * @param range 可迭代对象
  * @param pred 筛选条件
- * @return 筛选后的范围视图
+ * @return 惰性筛选视图
  */
 template <typename Range, typename Predicate>
-auto filter(Range& range, Predicate pred) -> decltype(view(range).filter(pred)) {
-    return view(range).filter(pred);
-}
-
-/**
- * @brief 筛选函数（常量版本）
- * @tparam Range 可迭代类型
- * @tparam Predicate 谓词类型
- * @param range 可迭代对象
- * @param pred 筛选条件
- * @return 筛选后的范围视图
- */
-template <typename Range, typename Predicate>
-auto filter(const Range& range, Predicate pred) -> decltype(view(range).filter(pred)) {
-    return view(range).filter(pred);
+auto filter(Range&& range, Predicate pred) {
+    return std::forward<Range>(range) | filter(std::move(pred));
 }
 
 /**
@@ -196,24 +1073,11 @@ auto filter(const Range& range, Predicate pred) -> decltype(view(range).filter(p
  * @tparam Transformer 转换函数类型
  * @param range 可迭代对象
  * @param transform 转换函数
- * @return 转换后的范围视图
- */
-template <typename Range, typename Transformer>
-auto transform(Range& range, Transformer transform) -> decltype(view(range).transform(transform)) {
-    return view(range).transform(transform);
-}
-
-/**
- * @brief 转换函数（常量版本）
- * @tparam Range 可迭代类型
- * @tparam Transformer 转换函数类型
- * @param range 可迭代对象
- * @param transform 转换函数
- * @return 转换后的范围视图
+ * @return 惰性转换视图
  */
 template <typename Range, typename Transformer>
-auto transform(const Range& range, Transformer transform) -> decltype(view(range).transform(transform)) {
-    return view(range).transform(transform);
+auto transform(Range&& range, Transformer transform) {
+    return std::forward<Range>(range) | ranges::transform(std::move(transform));
 }
 
 /**
@@ -224,20 +1088,10 @@ auto transform(const Range& range, Transformer transform) -> decltype(view(range
  * @param func 遍历函数
  */
 template <typename Range, typename Func>
-void for_each(Range& range, Func func) {
-    view(range).for_each(func);
-}
-
-/**
- * @brief 遍历函数（常量版本）
- * @tparam Range 可迭代类型
- * @tparam Func 函数类型
- * @param range 可迭代对象
- * @param func 遍历函数
- */
-template <typename Range, typename Func>
-void for_each(const Range& range, Func func) {
-    view(range).for_each(func);
+void for_each(Range&& range, Func func) {
+    for (auto&& x : range) {
+        func(x);
+    }
 }
 
 } // namespace ranges
@@ -30,6 +30,7 @@
 #ifndef ZEN_UTILITY_FUNCTION_H
 #define ZEN_UTILITY_FUNCTION_H
 
+#include <functional>  // std::bad_function_call
 #include <utility>
 #include <memory>
 
@@ -49,7 +50,6 @@ public:
     virtual ~function_base() = default;
     virtual R invoke(Args... args) = 0;
     virtual function_base* clone() const = 0;
-    virtual void move_to(function_base* other) = 0;
 };
 
 /**
@@ -61,7 +61,8 @@ class function_impl;
 template<typename F, typename R, typename... Args>
 class function_impl<F, R(Args...)> : public function_base<R(Args...)> {
 public:
-    explicit function_impl(F&& f) : func_(std::forward<F>(f)) {}
+    template<typename G>
+    explicit function_impl(G&& g) : func_(std::forward<G>(g)) {}
     
     R invoke(Args... args) override {
         return func_(args...);
@@ -71,10 +72,6 @@ public:
         return new function_impl<F, R(Args...)>(func_);
     }
     
-    void move_to(function_base<R(Args...)>* other) override {
-        static_cast<function_impl*>(other)->func_ = std::move(func_);
-    }
-    
 private:
     F func_;
 };
@@ -0,0 +1,273 @@
+#ifndef ZEN_UTILITY_HASH_H
+#define ZEN_UTILITY_HASH_H
+
+#include "../base/type_traits.h"
+#include "string_view.h"
+#include <cstdint>  // uint64_t / uintptr_t
+#include <cstring>  // memcpy
+#include <string>
+
+namespace zen {
+
+// ============================================================================
+// 哈希子系统
+//
+// 所有哈希容器（unordered_map / flat_hash_map / ...）共用这里的 hash<Key>：
+// - 整数 / 指针 / 浮点：一次 multiply-xorshift 混合，O(1)，不逐字节处理
+// - 字符串 / 字节区间：wyhash 风格，每步读取 8 字节字并做 64x64→128 乘法折叠
+// - hash<std::string> / hash<string_view> 与 equal_to 的对应特化都是"透明"的
+//   （带 is_transparent），容器可以直接用 string_view / const char* 查找
+//   std::string 键，不构造临时字符串
+// ============================================================================
+
+namespace detail {
+
+static constexpr uint64_t HASH_SECRET0 = 0xa0761d6478bd642fULL;
+static constexpr uint64_t HASH_SECRET1 = 0xe7037ed1a0b428dbULL;
+static constexpr uint64_t HASH_SECRET2 = 0x8ebc6af09c88c6e3ULL;
+static constexpr uint64_t HASH_SECRET3 = 0x589965cc75374cc3ULL;
+
+/** 64x64 → 128 位乘法，返回 高64 ^ 低64 */
+inline uint64_t hash_mum(uint64_t a, uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+    uint64_t ha = a >> 32, hb = b >> 32, la = a & 0xFFFFFFFFu, lb = b & 0xFFFFFFFFu;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t  = rl + (rm0 << 32);
+    uint64_t c  = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    return lo ^ hi;
+#endif
+}
+
+inline uint64_t hash_read64(const unsigned char* p) noexcept {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+inline uint64_t hash_read32(const unsigned char* p) noexcept {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+} // namespace detail
+
+/**
+ * @brief 64 位整数混合（multiply-xorshift，两轮）
+ *
+ * 每一位输入都会影响每一位输出，适合直接取低位或高位做桶下标。
+ */
+inline constexpr uint64_t hash_mix(uint64_t x) noexcept {
+    x ^= x >> 32;
+    x *= 0xd6e8feb86659fd93ULL;
+    x ^= x >> 32;
+    x *= 0xd6e8feb86659fd93ULL;
+    x ^= x >> 32;
+    return x;
+}
+
+/**
+ * @brief 对任意字节区间求哈希（wyhash 风格）
+ * @param data 起始地址
+ * @param len  字节数
+ * @param seed 种子（默认 0）
+ *
+ * - len <= 16：最多 4 次重叠读取，无循环
+ * - len >  16：每轮读取两个 8 字节字做一次乘法折叠；
+ *              超过 48 字节时三路并行，隐藏乘法延迟
+ */
+inline uint64_t hash_bytes(const void* data, size_t len, uint64_t seed = 0) noexcept {
+    using namespace detail;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    seed ^= hash_mum(seed ^ HASH_SECRET0, HASH_SECRET1);
+    uint64_t a, b;
+    if (len <= 16) {
+        if (len >= 4) {
+            size_t off = (len >> 3) << 2;
+            a = (hash_read32(p) << 32) | hash_read32(p + off);
+            b = (hash_read32(p + len - 4) << 32) | hash_read32(p + len - 4 - off);
+        } else if (len > 0) {
+            a = (static_cast<uint64_t>(p[0]) << 16) |
+                (static_cast<uint64_t>(p[len >> 1]) << 8) | p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t s1 = seed, s2 = seed;
+            do {
+                seed = hash_mum(hash_read64(p)      ^ HASH_SECRET1, hash_read64(p + 8)  ^ seed);
+                s1   = hash_mum(hash_read64(p + 16) ^ HASH_SECRET2, hash_read64(p + 24) ^ s1);
+                s2   = hash_mum(hash_read64(p + 32) ^ HASH_SECRET3, hash_read64(p + 40) ^ s2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= s1 ^ s2;
+        }
+        while (i > 16) {
+            seed = hash_mum(hash_read64(p) ^ HASH_SECRET1, hash_read64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = hash_read64(p + i - 16);
+        b = hash_read64(p + i - 8);
+    }
+    return hash_mum(HASH_SECRET1 ^ len, hash_mum(a ^ HASH_SECRET1, b ^ seed));
+}
+
+/**
+ * @brief FNV-1a（逐字节，结果与平台无关）
+ *
+ * 速度远低于 hash_bytes，仅用于需要跨版本稳定的持久化哈希。
+ */
+inline constexpr uint64_t fnv1a_bytes(const unsigned char* p, size_t len) noexcept {
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/**
+ * @brief 组合两个哈希值（用于 pair / 结构体等复合键）
+ */
+inline constexpr size_t hash_combine(size_t seed, size_t h) noexcept {
+    return static_cast<size_t>(hash_mix(static_cast<uint64_t>(seed) ^ (static_cast<uint64_t>(h) + 0x9E3779B97F4A7C15ULL)));
+}
+
+// ============================================================================
+// hash<Key>
+// ============================================================================
+
+template<typename Key>
+struct hash;
+
+template<typename T>
+struct integral_hash {
+    size_t operator()(T v) const noexcept {
+        return static_cast<size_t>(hash_mix(static_cast<uint64_t>(v)));
+    }
+};
+
+template<typename T>
+struct float_hash {
+    size_t operator()(T v) const noexcept {
+        if (v == T(0)) return static_cast<size_t>(hash_mix(0));   // +0.0 与 -0.0 相等，哈希也必须相等
+        uint64_t bits = 0;
+        memcpy(&bits, &v, sizeof(T) < sizeof(bits) ? sizeof(T) : sizeof(bits));
+        return static_cast<size_t>(hash_mix(bits));
+    }
+};
+
+template<> struct hash<bool>               : integral_hash<bool>               {};
+template<> struct hash<char>               : integral_hash<char>               {};
+template<> struct hash<signed char>        : integral_hash<signed char>        {};
+template<> struct hash<unsigned char>      : integral_hash<unsigned char>      {};
+template<> struct hash<wchar_t>            : integral_hash<wchar_t>            {};
+template<> struct hash<char16_t>           : integral_hash<char16_t>           {};
+template<> struct hash<char32_t>           : integral_hash<char32_t>           {};
+template<> struct hash<short>              : integral_hash<short>              {};
+template<> struct hash<unsigned short>     : integral_hash<unsigned short>     {};
+template<> struct hash<int>                : integral_hash<int>                {};
+template<> struct hash<unsigned int>       : integral_hash<unsigned int>       {};
+template<> struct hash<long>               : integral_hash<long>               {};
+template<> struct hash<unsigned long>      : integral_hash<unsigned long>      {};
+template<> struct hash<long long>          : integral_hash<long long>          {};
+template<> struct hash<unsigned long long> : integral_hash<unsigned long long> {};
+template<> struct hash<float>              : float_hash<float>                 {};
+template<> struct hash<double>             : float_hash<double>                {};
+
+template<typename T>
+struct hash<T*> {
+    size_t operator()(T* p) const noexcept {
+        return static_cast<size_t>(hash_mix(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p))));
+    }
+};
+
+/**
+ * @brief 字符串哈希（透明）：std::string / string_view / const char* 得到相同结果
+ */
+struct string_hash {
+    using is_transparent = void;
+
+    size_t operator()(string_view s) const noexcept {
+        return static_cast<size_t>(hash_bytes(s.data(), s.size()));
+    }
+    size_t operator()(const std::string& s) const noexcept {
+        return static_cast<size_t>(hash_bytes(s.data(), s.size()));
+    }
+    size_t operator()(const char* s) const noexcept {
+        return operator()(string_view(s));
+    }
+};
+
+template<> struct hash<std::string> : string_hash {};
+template<> struct hash<string_view> : string_hash {};
+
+// ============================================================================
+// 键相等比较器
+// ============================================================================
+
+template<typename T>
+struct equal_to {
+    constexpr bool operator()(const T& a, const T& b) const noexcept {
+        return a == b;
+    }
+};
+
+/**
+ * @brief 字符串相等（透明）：任意组合的 std::string / string_view / const char* 直接比较字节
+ */
+struct string_equal {
+    using is_transparent = void;
+
+    bool operator()(string_view a, string_view b) const noexcept {
+        return a.size() == b.size() && (a.size() == 0 || memcmp(a.data(), b.data(), a.size()) == 0);
+    }
+    bool operator()(const std::string& a, const std::string& b) const noexcept { return a == b; }
+    bool operator()(const std::string& a, string_view b) const noexcept {
+        return operator()(string_view(a.data(), a.size()), b);
+    }
+    bool operator()(string_view a, const std::string& b) const noexcept {
+        return operator()(a, string_view(b.data(), b.size()));
+    }
+    bool operator()(const std::string& a, const char* b) const noexcept {
+        return operator()(string_view(a.data(), a.size()), string_view(b));
+    }
+};
+
+template<> struct equal_to<std::string> : string_equal {};
+template<> struct equal_to<string_view> : string_equal {};
+
+// ============================================================================
+// 透明查找检测
+// ============================================================================
+
+template<typename T, typename = void>
+struct is_transparent {
+    static constexpr bool value = false;
+};
+
+template<typename T>
+struct is_transparent<T, decltype(static_cast<void>(sizeof(typename T::is_transparent*)))> {
+    static constexpr bool value = true;
+};
+
+/**
+ * @brief Hash 与 KeyEqual 都声明 is_transparent 时，容器开放 find(const K&) 等异构查找
+ */
+template<typename Hash, typename KeyEqual>
+constexpr bool is_transparent_lookup_v = is_transparent<Hash>::value && is_transparent<KeyEqual>::value;
+
+} // namespace zen
+
+#endif // ZEN_UTILITY_HASH_H
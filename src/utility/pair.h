@@ -224,6 +224,17 @@ make_pair(T1&& x, T2&& y) {
     );
 }
 
+// ============================================================================
+// unit_t - 空占位类型
+// ============================================================================
+
+/**
+ * @brief 不携带任何数据的空结构体
+ *
+ * set / unordered_set 等"只有键"的容器用 map<Key, unit_t> 复用映射实现。
+ */
+struct unit_t {};
+
 // ============================================================================
 // 结构化绑定支持（C++17）
 // ============================================================================
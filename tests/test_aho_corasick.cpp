@@ -0,0 +1,284 @@
+// test_aho_corasick.cpp
+// 测试 algorithms/aho_corasick.h：
+// 全部匹配与逐模式暴力搜索比对（小字母表、重叠、重复模式），最左最长匹配与
+// 贪心参考实现比对，忽略大小写，随机分块流式扫描与一次性扫描一致，
+// 稠密表预算为 0（几乎全部稀疏状态）与全稠密结果一致，回调提前停止
+
+#include "../src/algorithms/aho_corasick.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <cassert>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+using namespace zen;
+using match = aho_corasick_match;
+
+static uint64_t rng_state = 88172645463325252ULL;
+static uint64_t rnd() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static std::string random_text(size_t n, int alphabet) {
+    std::string s(n, 'a');
+    for (auto& c : s) c = static_cast<char>('a' + rnd() % static_cast<uint64_t>(alphabet));
+    return s;
+}
+
+static std::vector<std::string> random_patterns(size_t count, size_t max_len, int alphabet) {
+    std::vector<std::string> pats;
+    for (size_t i = 0; i < count; ++i) pats.push_back(random_text(1 + rnd() % max_len, alphabet));
+    return pats;
+}
+
+static char lower(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c | 0x20) : c; }
+
+static bool equal_at(const std::string& text, size_t pos, const std::string& pat, bool icase) {
+    for (size_t k = 0; k < pat.size(); ++k) {
+        char a = text[pos + k], b = pat[k];
+        if (icase ? lower(a) != lower(b) : a != b) return false;
+    }
+    return true;
+}
+
+// 暴力参考：所有匹配，按 (end, 长度降序, 模式编号) 排序
+static std::vector<match> brute_all(const std::string& text, const std::vector<std::string>& pats,
+                                    bool icase = false) {
+    std::vector<match> r;
+    for (size_t p = 0; p < pats.size(); ++p) {
+        if (pats[p].empty()) continue;
+        for (size_t i = 0; i + pats[p].size() <= text.size(); ++i) {
+            if (equal_at(text, i, pats[p], icase)) r.push_back(match{p, i, i + pats[p].size()});
+        }
+    }
+    return r;
+}
+
+static void sort_matches(std::vector<match>& v) {
+    std::sort(v.begin(), v.end(), [](const match& a, const match& b) {
+        if (a.end != b.end) return a.end < b.end;
+        if (a.begin != b.begin) return a.begin < b.begin;
+        return a.pattern < b.pattern;
+    });
+}
+
+// 贪心参考：每次取起点最小、其次最长的匹配，然后跳到其终点之后
+static std::vector<std::pair<size_t, size_t>> brute_leftmost_longest(const std::string& text,
+                                                                     const std::vector<std::string>& pats) {
+    std::vector<std::pair<size_t, size_t>> r;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t best_begin = text.size(), best_len = 0;
+        for (const auto& p : pats) {
+            if (p.empty()) continue;
+            for (size_t i = pos; i + p.size() <= text.size() && i <= best_begin; ++i) {
+                if (equal_at(text, i, p, false)) {
+                    if (i < best_begin || p.size() > best_len) { best_begin = i; best_len = p.size(); }
+                    break;
+                }
+            }
+        }
+        if (best_len == 0) break;
+        r.push_back({best_begin, best_begin + best_len});
+        pos = best_begin + best_len;
+    }
+    return r;
+}
+
+static std::vector<std::pair<size_t, size_t>> spans(const std::vector<match>& v) {
+    std::vector<std::pair<size_t, size_t>> r;
+    for (const auto& m : v) r.push_back({m.begin, m.end});
+    return r;
+}
+
+void test_basic() {
+    printf("test_basic...\n");
+    aho_corasick ac = { "he", "she", "his", "hers" };
+    ASSERT_EQ(ac.pattern_count(), 4u);
+    std::vector<match> m = ac.find_all("ushers");
+    ASSERT_EQ(m.size(), 3u);
+    ASSERT_TRUE(m[0] == (match{1, 1, 4}));   // she
+    ASSERT_TRUE(m[1] == (match{0, 2, 4}));   // he
+    ASSERT_TRUE(m[2] == (match{3, 2, 6}));   // hers
+    ASSERT_TRUE(ac.contains_any("this"));
+    ASSERT_FALSE(ac.contains_any("xyz"));
+    ASSERT_TRUE(ac.find_all("").empty());
+
+    std::vector<std::string> none;
+    aho_corasick empty(none);
+    ASSERT_TRUE(empty.find_all("anything").empty());
+    ASSERT_EQ(empty.state_count(), 1u);
+
+    // 空模式被忽略，重复模式各自报告
+    aho_corasick dup = { "ab", "", "ab", "b" };
+    m = dup.find_all("xab");
+    ASSERT_EQ(m.size(), 3u);
+    ASSERT_TRUE(m[0] == (match{0, 1, 3}));
+    ASSERT_TRUE(m[1] == (match{2, 1, 3}));
+    ASSERT_TRUE(m[2] == (match{3, 2, 3}));
+}
+
+void test_random_all() {
+    printf("test_random_all...\n");
+    for (int round = 0; round < 400; ++round) {
+        int alphabet = 2 + static_cast<int>(rnd() % 4);
+        std::vector<std::string> pats = random_patterns(1 + rnd() % 20, 1 + rnd() % 6, alphabet);
+        std::string text = random_text(rnd() % 300, alphabet + 1);
+        aho_corasick ac(pats);
+        std::vector<match> got = ac.find_all(text);
+        std::vector<match> expect = brute_all(text, pats);
+        sort_matches(got);
+        sort_matches(expect);
+        ASSERT_TRUE(got == expect);
+    }
+}
+
+void test_leftmost_longest() {
+    printf("test_leftmost_longest...\n");
+    aho_corasick ac = { "ab", "c", "abcx" };
+    std::vector<match> m = ac.find_leftmost_longest("abcy");
+    ASSERT_EQ(m.size(), 2u);
+    ASSERT_TRUE(m[0] == (match{0, 0, 2}));
+    ASSERT_TRUE(m[1] == (match{1, 2, 3}));
+
+    aho_corasick kw = { "New", "New York", "York City" };
+    m = kw.find_leftmost_longest("New York City");
+    ASSERT_EQ(m.size(), 1u);
+    ASSERT_TRUE(m[0] == (match{1, 0, 8}));
+
+    for (int round = 0; round < 600; ++round) {
+        int alphabet = 2 + static_cast<int>(rnd() % 3);
+        std::vector<std::string> pats = random_patterns(1 + rnd() % 10, 1 + rnd() % 6, alphabet);
+        std::string text = random_text(rnd() % 200, alphabet);
+        aho_corasick ac2(pats);
+        std::vector<match> got = ac2.find_leftmost_longest(text);
+        ASSERT_TRUE(spans(got) == brute_leftmost_longest(text, pats));
+        for (const auto& g : got) ASSERT_EQ(text.substr(g.begin, g.length()), pats[g.pattern]);
+    }
+}
+
+void test_case_insensitive() {
+    printf("test_case_insensitive...\n");
+    aho_corasick::options opts;
+    opts.case_insensitive = true;
+    std::vector<std::string> pats = { "Error", "WARN", "timeout" };
+    aho_corasick ac(pats, opts);
+    ASSERT_TRUE(ac.case_insensitive());
+    std::vector<match> m = ac.find_all("eRRoR: TimeOut, warn");
+    ASSERT_EQ(m.size(), 3u);
+    ASSERT_EQ(m[0].pattern, 0u);
+    ASSERT_EQ(m[1].pattern, 2u);
+    ASSERT_EQ(m[2].pattern, 1u);
+
+    aho_corasick strict(pats);
+    ASSERT_TRUE(strict.find_all("eRRoR: TimeOut, warn").empty());
+
+    for (int round = 0; round < 200; ++round) {
+        std::vector<std::string> ps = random_patterns(1 + rnd() % 8, 4, 3);
+        for (auto& p : ps) for (auto& c : p) if (rnd() & 1) c = static_cast<char>(c - 32);
+        std::string text = random_text(rnd() % 200, 3);
+        for (auto& c : text) if (rnd() & 1) c = static_cast<char>(c - 32);
+        aho_corasick ic(ps, opts);
+        std::vector<match> got = ic.find_all(text), expect = brute_all(text, ps, true);
+        sort_matches(got);
+        sort_matches(expect);
+        ASSERT_TRUE(got == expect);
+    }
+}
+
+void test_stream() {
+    printf("test_stream...\n");
+    for (int round = 0; round < 300; ++round) {
+        std::vector<std::string> pats = random_patterns(1 + rnd() % 12, 1 + rnd() % 8, 3);
+        std::string text = random_text(rnd() % 400, 3);
+        aho_corasick ac(pats);
+        for (auto kind : { aho_corasick::match_kind::all, aho_corasick::match_kind::leftmost_longest }) {
+            std::vector<match> whole;
+            ac.for_each_match(text, [&](const match& m) { whole.push_back(m); }, kind);
+
+            std::vector<match> pieces;
+            auto sink = [&](const match& m) { pieces.push_back(m); };
+            aho_corasick::stream st(ac, kind);
+            size_t pos = 0;
+            while (pos < text.size()) {
+                size_t len = std::min<size_t>(rnd() % 9, text.size() - pos);   // 允许空块
+                st.feed(std::string_view(text).substr(pos, len), sink);
+                pos += len;
+            }
+            st.finish(sink);
+            ASSERT_EQ(st.offset(), text.size());
+            ASSERT_TRUE(pieces == whole);
+
+            st.reset();
+            pieces.clear();
+            st.feed(text, sink);
+            st.finish(sink);
+            ASSERT_TRUE(pieces == whole);
+        }
+    }
+}
+
+void test_sparse_states() {
+    printf("test_sparse_states...\n");
+    aho_corasick::options sparse;
+    sparse.dense_table_bytes = 0;
+    aho_corasick::options mid;
+    mid.dense_table_bytes = 600;
+    for (int round = 0; round < 200; ++round) {
+        std::vector<std::string> pats = random_patterns(1 + rnd() % 30, 1 + rnd() % 10, 4);
+        std::string text = random_text(rnd() % 500, 5);
+        aho_corasick dense(pats), s0(pats, sparse), s1(pats, mid);
+        ASSERT_EQ(dense.dense_state_count(), dense.state_count());
+        ASSERT_EQ(s0.dense_state_count(), 1u);
+        ASSERT_TRUE(s0.find_all(text) == dense.find_all(text));
+        ASSERT_TRUE(s1.find_all(text) == dense.find_all(text));
+        ASSERT_TRUE(s0.find_leftmost_longest(text) == dense.find_leftmost_longest(text));
+    }
+}
+
+void test_early_stop() {
+    printf("test_early_stop...\n");
+    aho_corasick ac = { "a", "aa" };
+    std::string text(100, 'a');
+    size_t seen = 0;
+    ac.for_each_match(text, [&seen](const match&) { return ++seen < 5; });
+    ASSERT_EQ(seen, 5u);
+
+    seen = 0;
+    aho_corasick::stream st(ac, aho_corasick::match_kind::leftmost_longest);
+    auto stop_at_two = [&seen](const match&) { return ++seen < 2; };
+    st.feed(text, stop_at_two);
+    st.feed(text, stop_at_two);
+    st.finish(stop_at_two);
+    ASSERT_EQ(seen, 2u);
+}
+
+int main() {
+    printf("=== aho_corasick Tests ===\n\n");
+
+    test_basic();
+    test_random_all();
+    test_leftmost_longest();
+    test_case_insensitive();
+    test_stream();
+    test_sparse_states();
+    test_early_stop();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
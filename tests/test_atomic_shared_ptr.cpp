@@ -0,0 +1,259 @@
+// test_atomic_shared_ptr.cpp
+// 测试 shared_ptr 的原子引用计数、单线程策略、make_shared 单次分配，
+// 以及 atomic_shared_ptr 的并发发布 / 读取
+
+#include "../src/memory/smart_ptr.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <cassert>
+#include <atomic>
+#include <new>
+#include <thread>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+// 统计全局 operator new 调用次数
+static std::atomic<long> g_news{0};
+
+void* operator new(size_t n) {
+    g_news.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+using namespace zen;
+
+struct tracked {
+    static std::atomic<int> alive;
+    int value;
+    explicit tracked(int v) : value(v) { alive.fetch_add(1); }
+    ~tracked() { alive.fetch_sub(1); }
+};
+std::atomic<int> tracked::alive{0};
+
+struct base_obj { virtual ~base_obj() = default; int b = 1; };
+struct derived_obj : base_obj { int d = 2; };
+
+// ===========================================================================
+// 单线程语义
+// ===========================================================================
+
+void test_make_shared_single_allocation() {
+    printf("test_make_shared_single_allocation...\n");
+    long before = g_news.load();
+    {
+        auto sp = make_shared<tracked>(7);
+        ASSERT_EQ(g_news.load() - before, 1);       // 对象与控制块一次分配
+        ASSERT_EQ(sp->value, 7);
+        ASSERT_EQ(tracked::alive.load(), 1);
+        weak_ptr<tracked> wp = sp;
+        sp.reset();
+        ASSERT_EQ(tracked::alive.load(), 0);        // 强引用归零即析构
+        ASSERT_TRUE(wp.expired());
+        ASSERT_FALSE(wp.lock());
+    }
+
+    before = g_news.load();
+    shared_ptr<tracked> sp2(new tracked(1));
+    ASSERT_EQ(g_news.load() - before, 2);           // 对象 + 独立控制块
+}
+
+struct alignas(64) wide_obj {
+    char bytes[8];
+    int  v;
+    explicit wide_obj(int x) : v(x) {}
+};
+
+void test_make_shared_over_aligned() {
+    printf("test_make_shared_over_aligned...\n");
+    // 控制块内嵌过对齐对象：对象地址满足 alignof(T)
+    std::vector<shared_ptr<wide_obj>> keep;
+    for (int i = 0; i < 64; ++i) {
+        keep.push_back(make_shared<wide_obj>(i));
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(keep.back().get()) % alignof(wide_obj), 0u);
+        ASSERT_EQ(keep.back()->v, i);
+    }
+    weak_ptr<wide_obj> wp = keep[0];
+    keep.clear();
+    ASSERT_TRUE(wp.expired());
+}
+
+void test_conversions_and_deleter() {
+    printf("test_conversions_and_deleter...\n");
+    shared_ptr<derived_obj> d = make_shared<derived_obj>();
+    shared_ptr<base_obj> b = d;
+    ASSERT_EQ(b.use_count(), 2);
+    ASSERT_TRUE(b.owner_equal(d));
+    ASSERT_EQ(b->b, 1);
+
+    static int deleted = 0;
+    {
+        shared_ptr<int> p(new int(3), [](int* x) { ++deleted; delete x; });
+        shared_ptr<int> q = p;
+    }
+    ASSERT_EQ(deleted, 1);
+}
+
+void test_local_policy() {
+    printf("test_local_policy...\n");
+    static_assert(sizeof(single_thread_ref_count::count_type) == sizeof(long), "plain counter");
+    auto sp = make_local_shared<tracked>(5);
+    local_shared_ptr<tracked> sp2 = sp;
+    ASSERT_EQ(sp.use_count(), 2);
+    local_weak_ptr<tracked> wp = sp;
+    ASSERT_EQ(wp.lock()->value, 5);
+    sp.reset();
+    sp2.reset();
+    ASSERT_TRUE(wp.expired());
+    ASSERT_EQ(tracked::alive.load(), 0);
+}
+
+// ===========================================================================
+// 多线程引用计数
+// ===========================================================================
+
+void test_concurrent_copies() {
+    printf("test_concurrent_copies...\n");
+    {
+        auto sp = make_shared<tracked>(42);
+        std::vector<std::thread> ts;
+        for (int t = 0; t < 8; ++t) {
+            ts.emplace_back([sp] {
+                for (int i = 0; i < 100000; ++i) {
+                    shared_ptr<tracked> c = sp;
+                    ASSERT_EQ(c->value, 42);
+                }
+            });
+        }
+        for (auto& th : ts) th.join();
+        ASSERT_EQ(sp.use_count(), 1);
+    }
+    ASSERT_EQ(tracked::alive.load(), 0);
+}
+
+void test_concurrent_weak_lock() {
+    printf("test_concurrent_weak_lock...\n");
+    for (int round = 0; round < 200; ++round) {
+        auto sp = make_shared<tracked>(round);
+        weak_ptr<tracked> wp = sp;
+        std::atomic<bool> go{false};
+        std::thread reader([&] {
+            while (!go.load()) {}
+            for (int i = 0; i < 1000; ++i) {
+                if (auto l = wp.lock()) ASSERT_EQ(l->value, round);
+            }
+        });
+        go.store(true);
+        sp.reset();                                 // 与 lock() 竞争：不会复活已销毁的对象
+        reader.join();
+        ASSERT_TRUE(wp.expired());
+    }
+}
+
+// ===========================================================================
+// atomic_shared_ptr
+// ===========================================================================
+
+void test_atomic_basic() {
+    printf("test_atomic_basic...\n");
+    atomic_shared_ptr<int> a;
+    ASSERT_FALSE(a.load());
+    ASSERT_TRUE(a.is_lock_free());
+
+    auto one = make_shared<int>(1);
+    a.store(one);
+    ASSERT_EQ(*a.load(), 1);
+    ASSERT_EQ(one.use_count(), 2);                  // one + 槽位
+
+    shared_ptr<int> old = a.exchange(make_shared<int>(2));
+    ASSERT_EQ(old, one);
+    ASSERT_EQ(*a.load(), 2);
+
+    shared_ptr<int> expected = one;
+    ASSERT_FALSE(a.compare_exchange_strong(expected, make_shared<int>(3)));
+    ASSERT_EQ(*expected, 2);
+    ASSERT_TRUE(a.compare_exchange_strong(expected, make_shared<int>(3)));
+    ASSERT_EQ(*a.load(), 3);
+
+    a = nullptr;
+    ASSERT_FALSE(a.load());
+    expected = nullptr;
+    ASSERT_TRUE(a.compare_exchange_strong(expected, one));
+    ASSERT_EQ(a.load(), one);
+}
+
+struct snapshot {
+    static std::atomic<int> alive;
+    long version;
+    long check;
+    explicit snapshot(long v) : version(v), check(v * 31) { alive.fetch_add(1); }
+    ~snapshot() { alive.fetch_sub(1); check = -1; }
+};
+std::atomic<int> snapshot::alive{0};
+
+void test_atomic_publish_read() {
+    printf("test_atomic_publish_read...\n");
+    {
+        atomic_shared_ptr<snapshot> current(make_shared<snapshot>(0));
+        std::atomic<bool> stop{false};
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 4; ++r) {
+            readers.emplace_back([&] {
+                long last = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    shared_ptr<snapshot> s = current.load();
+                    ASSERT_EQ(s->check, s->version * 31);   // 快照仍然有效
+                    ASSERT_TRUE(s->version >= last);        // 单写者：版本单调
+                    last = s->version;
+                }
+            });
+        }
+        std::thread writer([&] {
+            for (long v = 1; v <= 20000; ++v) current.store(make_shared<snapshot>(v));
+        });
+        std::thread cas_writer([&] {
+            for (int i = 0; i < 2000; ++i) {
+                shared_ptr<snapshot> e = current.load();
+                current.compare_exchange_strong(e, e);      // 替换为同一对象：版本不变
+            }
+        });
+        writer.join();
+        cas_writer.join();
+        stop.store(true);
+        for (auto& th : readers) th.join();
+        ASSERT_EQ(current.load()->version, 20000);
+        ASSERT_EQ(snapshot::alive.load(), 1);
+    }
+    ASSERT_EQ(snapshot::alive.load(), 0);
+}
+
+int main() {
+    printf("=== atomic shared_ptr Tests ===\n\n");
+
+    test_make_shared_single_allocation();
+    test_make_shared_over_aligned();
+    test_conversions_and_deleter();
+    test_local_policy();
+
+    test_concurrent_copies();
+    test_concurrent_weak_lock();
+
+    test_atomic_basic();
+    test_atomic_publish_read();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
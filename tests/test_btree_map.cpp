@@ -0,0 +1,288 @@
+// test_btree_map.cpp
+// 测试 btree_map / btree_set（B+ 树：分裂、借位 / 合并、批量构建、区间查找）
+
+#include "../src/containers/associative/btree_map.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <cassert>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+using namespace zen;
+
+// 线性同余，生成可复现的打乱顺序
+static unsigned next_rand(unsigned& s) { s = s * 1103515245u + 12345u; return s >> 8; }
+
+template<typename Map>
+static bool is_sorted_unique(const Map& m) {
+    size_t n = 0;
+    auto it = m.begin();
+    if (it == m.end()) return m.size() == 0;
+    auto prev = it->first;
+    for (++it, ++n; it != m.end(); ++it, ++n) {
+        if (!(prev < it->first)) return false;
+        prev = it->first;
+    }
+    return n == m.size();
+}
+
+// ===========================================================================
+// btree_map 测试
+// ===========================================================================
+
+void test_btree_empty() {
+    printf("test_btree_empty...\n");
+    btree_map<int, int> m;
+    ASSERT_TRUE(m.empty());
+    ASSERT_TRUE(m.begin() == m.end());
+    ASSERT_TRUE(m.find(1) == m.end());
+    ASSERT_TRUE(m.lower_bound(1) == m.end());
+    ASSERT_EQ(m.erase(1), 0u);
+}
+
+void test_btree_insert_find() {
+    printf("test_btree_insert_find...\n");
+    btree_map<int, std::string> m;
+    auto r1 = m.insert({1, std::string("one")});
+    ASSERT_TRUE(r1.second);
+    auto r2 = m.insert({1, std::string("ONE")});
+    ASSERT_FALSE(r2.second);
+    ASSERT_EQ(r2.first->second, "one");
+
+    m[2] = "two";
+    m.emplace(3, std::string("three"));
+    ASSERT_EQ(m.size(), 3u);
+    ASSERT_EQ(m.at(2), "two");
+    ASSERT_TRUE(m.contains(3));
+    ASSERT_FALSE(m.contains(4));
+    ASSERT_EQ(m.count(1), 1u);
+}
+
+void test_btree_random_insert_erase() {
+    printf("test_btree_random_insert_erase...\n");
+    const int N = 20000;
+    std::vector<int> keys(N);
+    for (int i = 0; i < N; ++i) keys[i] = i;
+    unsigned s = 7;
+    for (int i = N - 1; i > 0; --i) { int j = next_rand(s) % (i + 1); int t = keys[i]; keys[i] = keys[j]; keys[j] = t; }
+
+    btree_map<int, std::string> m;
+    for (int k : keys) ASSERT_TRUE(m.insert({k, std::to_string(k)}).second);
+    ASSERT_EQ(m.size(), static_cast<size_t>(N));
+    ASSERT_TRUE(is_sorted_unique(m));
+    for (int i = 0; i < N; ++i) ASSERT_EQ(m.at(i), std::to_string(i));
+
+    // 乱序删除 3/4，触发借位与合并
+    for (int i = 0; i < N * 3 / 4; ++i) ASSERT_EQ(m.erase(keys[i]), 1u);
+    ASSERT_EQ(m.size(), static_cast<size_t>(N / 4));
+    ASSERT_TRUE(is_sorted_unique(m));
+    for (int i = N * 3 / 4; i < N; ++i) ASSERT_TRUE(m.contains(keys[i]));
+    for (int i = 0; i < N * 3 / 4; ++i) ASSERT_FALSE(m.contains(keys[i]));
+
+    for (int i = N * 3 / 4; i < N; ++i) m.erase(keys[i]);
+    ASSERT_TRUE(m.empty());
+    ASSERT_TRUE(m.begin() == m.end());
+    m[1] = "again";
+    ASSERT_EQ(m.size(), 1u);
+}
+
+void test_btree_erase_iterator() {
+    printf("test_btree_erase_iterator...\n");
+    btree_map<int, int> m;
+    for (int i = 0; i < 5000; ++i) m[i] = i;
+    // 边遍历边删除：返回的迭代器必须指向后继
+    int expect = 0;
+    for (auto it = m.begin(); it != m.end(); ) {
+        ASSERT_EQ(it->first, expect);
+        if (it->first % 3 != 0) it = m.erase(it);
+        else ++it;
+        ++expect;
+    }
+    ASSERT_EQ(expect, 5000);
+    ASSERT_EQ(m.size(), 1667u);
+    for (auto& kv : m) ASSERT_EQ(kv.first % 3, 0);
+    ASSERT_TRUE(is_sorted_unique(m));
+
+    // 区间删除
+    auto first = m.lower_bound(300);
+    auto last  = m.lower_bound(600);
+    auto it = m.erase(first, last);
+    ASSERT_EQ(it->first, 600);
+    ASSERT_FALSE(m.contains(300));
+    ASSERT_TRUE(m.contains(297));
+}
+
+void test_btree_bounds_and_reverse() {
+    printf("test_btree_bounds_and_reverse...\n");
+    btree_map<int, int> m;
+    for (int i = 0; i < 1000; ++i) m[i * 2] = i;
+
+    ASSERT_EQ(m.lower_bound(10)->first, 10);
+    ASSERT_EQ(m.lower_bound(11)->first, 12);
+    ASSERT_EQ(m.upper_bound(10)->first, 12);
+    ASSERT_TRUE(m.lower_bound(1999) == m.end());
+    ASSERT_EQ(m.lower_bound(-5)->first, 0);
+
+    auto range = m.equal_range(100);
+    ASSERT_EQ(range.first->first, 100);
+    ASSERT_EQ(range.second->first, 102);
+
+    // 区间扫描
+    int sum = 0;
+    for (auto it = m.lower_bound(100); it != m.upper_bound(200); ++it) sum += it->second;
+    ASSERT_EQ(sum, (50 + 100) * 51 / 2);
+
+    // 反向遍历
+    auto it = m.end();
+    int k = 1998;
+    while (it != m.begin()) {
+        --it;
+        ASSERT_EQ(it->first, k);
+        k -= 2;
+    }
+    ASSERT_EQ(k, -2);
+
+    const btree_map<int, int>& cm = m;
+    ASSERT_EQ(cm.find(40)->second, 20);
+    ASSERT_EQ(cm.upper_bound(40)->first, 42);
+}
+
+void test_btree_bulk_load() {
+    printf("test_btree_bulk_load...\n");
+    for (int n : {0, 1, 5, 100, 1000, 54321}) {
+        std::vector<pair<int, int>> sorted;
+        for (int i = 0; i < n; ++i) sorted.push_back(pair<int, int>(i * 3, i));
+        btree_map<int, int> m(sorted_unique, sorted.begin(), sorted.end());
+        ASSERT_EQ(m.size(), static_cast<size_t>(n));
+        ASSERT_TRUE(is_sorted_unique(m));
+        for (int i = 0; i < n; i += 7) ASSERT_EQ(m.at(i * 3), i);
+
+        // 批量构建后仍可正常增删
+        for (int i = 0; i < n; i += 2) m.erase(i * 3);
+        for (int i = 0; i < n; i += 5) m[i * 3 + 1] = -i;
+        ASSERT_TRUE(is_sorted_unique(m));
+    }
+}
+
+// 单趟输入迭代器：只能遍历一次，复制后共享同一游标
+struct single_pass_iter {
+    using iterator_category = input_iterator_tag;
+    using value_type        = pair<int, int>;
+    using difference_type   = long;
+    using pointer           = const value_type*;
+    using reference         = const value_type&;
+
+    int* cur;
+    int  end;
+    value_type v;
+
+    single_pass_iter(int* c, int e) : cur(c), end(e), v(*c * 2, *c) {}
+    const value_type& operator*() { v = value_type(*cur * 2, *cur); return v; }
+    single_pass_iter& operator++() { ++*cur; return *this; }
+    bool operator!=(const single_pass_iter& o) const { return *cur != o.end; }
+};
+
+void test_btree_bulk_load_single_pass() {
+    printf("test_btree_bulk_load_single_pass...\n");
+    int cursor = 0;
+    btree_map<int, int> m(sorted_unique, single_pass_iter(&cursor, 0), single_pass_iter(&cursor, 3000));
+    ASSERT_EQ(m.size(), 3000u);
+    ASSERT_TRUE(is_sorted_unique(m));
+    ASSERT_EQ(m.at(4000), 2000);
+
+    cursor = 10;
+    m.assign_sorted(single_pass_iter(&cursor, 0), single_pass_iter(&cursor, 20));
+    ASSERT_EQ(m.size(), 10u);
+    ASSERT_EQ(m.begin()->first, 20);
+}
+
+// 统计默认构造次数
+struct counted {
+    static int ctor;
+    int v;
+    counted() : v(0) { ++ctor; }
+    counted(int x) : v(x) {}
+};
+int counted::ctor = 0;
+
+void test_btree_subscript_existing() {
+    printf("test_btree_subscript_existing...\n");
+    btree_map<int, counted> m;
+    m.insert(pair<const int, counted>(1, counted(5)));
+    counted::ctor = 0;
+    ASSERT_EQ(m[1].v, 5);
+    ASSERT_EQ(counted::ctor, 0);   // 键已存在：不构造临时值
+    ASSERT_EQ(m[2].v, 0);
+    ASSERT_EQ(counted::ctor, 1);
+}
+
+void test_btree_copy_move() {
+    printf("test_btree_copy_move...\n");
+    btree_map<std::string, int> a;
+    for (int i = 0; i < 500; ++i) a[std::to_string(i)] = i;
+
+    btree_map<std::string, int> b(a);
+    ASSERT_EQ(b.size(), 500u);
+    ASSERT_EQ(b["123"], 123);
+
+    btree_map<std::string, int> c(zen::move(a));
+    ASSERT_EQ(c.size(), 500u);
+    ASSERT_TRUE(a.empty());
+    a = c;
+    ASSERT_EQ(a.size(), 500u);
+    c.clear();
+    ASSERT_TRUE(c.begin() == c.end());
+    b = zen::move(a);
+    ASSERT_EQ(b["499"], 499);
+}
+
+// ===========================================================================
+// btree_set 测试
+// ===========================================================================
+
+void test_btree_set() {
+    printf("test_btree_set...\n");
+    btree_set<int> s;
+    for (int i = 0; i < 3000; ++i) s.insert((i * 7919) % 3001);
+    ASSERT_EQ(s.size(), 3000u);
+    ASSERT_FALSE(s.insert(5).second);
+    int prev = -1;
+    for (int k : s) { ASSERT_TRUE(k > prev); prev = k; }
+    ASSERT_EQ(s.erase(5), 1u);
+    ASSERT_FALSE(s.contains(5));
+    ASSERT_EQ(*s.lower_bound(5), 6);
+
+    int sorted[] = {1, 2, 3, 5, 8, 13};
+    btree_set<int> f(sorted_unique, sorted, sorted + 6);
+    ASSERT_EQ(f.size(), 6u);
+    ASSERT_TRUE(f.contains(13));
+}
+
+int main() {
+    printf("=== btree_map / btree_set Tests ===\n\n");
+
+    test_btree_empty();
+    test_btree_insert_find();
+    test_btree_random_insert_erase();
+    test_btree_erase_iterator();
+    test_btree_bounds_and_reverse();
+    test_btree_bulk_load();
+    test_btree_bulk_load_single_pass();
+    test_btree_subscript_existing();
+    test_btree_copy_move();
+
+    test_btree_set();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,469 @@
+// test_coro.cpp
+// 测试 C++20 协程（coro/）：task 的惰性启动、链式 co_await、异常传播、
+// 大量同步完成的 co_await 不耗栈；generator（含 co_yield 只读左值）；co_await pool.schedule()；
+// co_await future / shared_future；事件循环上的 readable() 与 sleep_for()；
+// 协程帧经线程缓存分配器分配
+//
+// 需以 C++20 编译：g++ -std=c++20 test_coro.cpp -pthread
+
+#include "../src/coro/task.h"
+#include "../src/coro/generator.h"
+#include "../src/coro/awaitables.h"
+#include "../src/threading/pool/thread_pool.h"
+#include <stdio.h>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+
+#if ZEN_HAS_COROUTINES
+
+using namespace zen;
+
+// ===========================================================================
+// task
+// ===========================================================================
+
+static task<int> value_of(int x) {
+    co_return x;
+}
+
+static task<int> add(int a, int b) {
+    int x = co_await value_of(a);
+    int y = co_await value_of(b);
+    co_return x + y;
+}
+
+static task<void> fail(const char* msg) {
+    throw std::runtime_error(msg);
+    co_return;
+}
+
+static task<std::string> catch_failure() {
+    try {
+        co_await fail("boom");
+    } catch (const std::runtime_error& e) {
+        co_return std::string("caught ") + e.what();
+    }
+    co_return "not thrown";
+}
+
+static int global_value = 7;
+
+static task<int&> ref_of() {
+    co_return global_value;
+}
+
+void test_task_basic() {
+    printf("test_task_basic...\n");
+    ASSERT_EQ(sync_wait(add(20, 22)), 42);
+    ASSERT_EQ(sync_wait(catch_failure()), std::string("caught boom"));
+
+    // 惰性：co_await 之前不执行
+    bool started = false;
+    auto lazy = [](bool& flag) -> task<void> {
+        flag = true;
+        co_return;
+    }(started);
+    ASSERT_TRUE(lazy.valid());
+    ASSERT_TRUE(!lazy.is_ready());
+    ASSERT_TRUE(!started);
+    sync_wait(std::move(lazy));
+    ASSERT_TRUE(started);
+
+    // 未启动就丢弃
+    {
+        task<int> dropped = value_of(1);
+    }
+
+    // 异常穿过 sync_wait
+    bool threw = false;
+    try {
+        sync_wait(fail("x"));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    int& r = sync_wait(ref_of());
+    ASSERT_TRUE(&r == &global_value);
+
+    // 只可移动的结果
+    auto moved = []() -> task<std::unique_ptr<int>> {
+        co_return std::make_unique<int>(5);
+    };
+    ASSERT_EQ(*sync_wait(moved()), 5);
+}
+
+static task<long> deep(int n) {
+    if (n == 0) co_return 0;
+    co_return 1 + co_await deep(n - 1);
+}
+
+static task<long> long_loop(int n) {
+    long sum = 0;
+    for (int i = 0; i < n; ++i) sum += co_await value_of(1);
+    co_return sum;
+}
+
+void test_sync_completion() {
+    printf("test_sync_completion...\n");
+    // 每次 co_await 同步完成：await_suspend 返回 false，调用栈不随次数增长
+    ASSERT_EQ(sync_wait(long_loop(1000000)), 1000000L);
+    // 递归等待：每层占一层栈，与普通递归相同
+    ASSERT_EQ(sync_wait(deep(2000)), 2000L);
+}
+
+// ===========================================================================
+// generator
+// ===========================================================================
+
+static generator<int> iota(int n) {
+    for (int i = 0; i < n; ++i) co_yield i;
+}
+
+static generator<long> fibonacci() {
+    long a = 0, b = 1;
+    for (;;) {
+        co_yield a;
+        long t = a + b;
+        a = b;
+        b = t;
+    }
+}
+
+static generator<std::string> words() {
+    std::string w = "alpha";
+    co_yield w;                    // 左值：不拷贝
+    co_yield std::string("beta");  // 右值
+    throw std::runtime_error("end of words");
+}
+
+static const std::string shared_word = "gamma";
+
+static generator<std::string> const_words() {
+    const std::string local = "delta";
+    co_yield local;          // 只读左值：拷贝
+    co_yield shared_word;
+}
+
+static generator<int> const_ints() {
+    static const int table[] = { 3, 1, 4 };
+    for (const int& x : table) co_yield x;
+}
+
+void test_generator() {
+    printf("test_generator...\n");
+    int sum = 0, count = 0;
+    for (int x : iota(100)) {
+        sum += x;
+        ++count;
+    }
+    ASSERT_EQ(count, 100);
+    ASSERT_EQ(sum, 4950);
+
+    // 无限生成器中途退出，析构时销毁帧
+    std::vector<long> fib;
+    for (long x : fibonacci()) {
+        if (x > 100) break;
+        fib.push_back(x);
+    }
+    ASSERT_EQ(fib.size(), 12u);
+    ASSERT_EQ(fib.back(), 89L);
+
+    std::vector<std::string> got;
+    bool threw = false;
+    try {
+        for (auto& w : words()) got.push_back(w);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+    ASSERT_EQ(got.size(), 2u);
+    ASSERT_EQ(got[1], std::string("beta"));
+
+    int empty = 0;
+    for (int x : iota(0)) empty += x + 1;
+    ASSERT_EQ(empty, 0);
+
+    // co_yield 只读左值：迭代器引用的是副本，改动不影响原对象
+    std::vector<int> ints;
+    for (int x : const_ints()) ints.push_back(x);
+    ASSERT_EQ(ints.size(), 3u);
+    ASSERT_EQ(ints[2], 4);
+    got.clear();
+    for (auto& w : const_words()) {
+        got.push_back(w);
+        w += "!";
+    }
+    ASSERT_EQ(got.size(), 2u);
+    ASSERT_EQ(got[0], std::string("delta"));
+    ASSERT_EQ(got[1], std::string("gamma"));
+    ASSERT_EQ(shared_word, std::string("gamma"));
+}
+
+// ===========================================================================
+// thread_pool::schedule
+// ===========================================================================
+
+static task<std::thread::id> worker_id(thread_pool& pool) {
+    co_await pool.schedule();
+    co_return std::this_thread::get_id();
+}
+
+static task<int> fan_out(thread_pool& pool, int n) {
+    co_await pool.schedule(task_priority::high);
+    int sum = 0;
+    for (int i = 0; i < n; ++i) sum += co_await value_of(i);
+    co_return sum;
+}
+
+void test_pool_schedule() {
+    printf("test_pool_schedule...\n");
+    thread_pool pool(4);
+    ASSERT_TRUE(sync_wait(worker_id(pool)) != std::this_thread::get_id());
+
+    std::vector<future<int>> fs;
+    for (int i = 0; i < 1000; ++i) fs.push_back(to_future(fan_out(pool, 10)));
+    long total = 0;
+    for (auto& f : fs) total += f.get();
+    ASSERT_EQ(total, 1000L * 45);
+
+    std::atomic<int> done{0};
+    for (int i = 0; i < 100; ++i) {
+        co_spawn(pool, [](std::atomic<int>& d) -> task<void> {
+            d.fetch_add(1, std::memory_order_relaxed);
+            co_return;
+        }(done));
+    }
+    pool.wait();
+    ASSERT_EQ(done.load(), 100);
+
+    pool.shutdown();
+    bool threw = false;
+    try {
+        sync_wait(worker_id(pool));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+}
+
+// ===========================================================================
+// co_await future
+// ===========================================================================
+
+static task<int> await_future(future<int> f) {
+    co_return co_await std::move(f) * 2;
+}
+
+static task<int> await_shared(shared_future<int> f) {
+    const int& v = co_await f;
+    co_return v + 1;
+}
+
+void test_future_await() {
+    printf("test_future_await...\n");
+    ASSERT_EQ(sync_wait(await_future(make_ready_future(21))), 42);
+
+    promise<int> p;
+    future<int> out = to_future(await_future(p.get_future()));
+    ASSERT_TRUE(!out.is_ready());
+    std::thread t([&p] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        p.set_value(50);
+    });
+    ASSERT_EQ(out.get(), 100);
+    t.join();
+
+    promise<int> q;
+    shared_future<int> sf = q.get_future().share();
+    future<int> a = to_future(await_shared(sf));
+    future<int> b = to_future(await_shared(sf));
+    q.set_value(9);
+    ASSERT_EQ(a.get(), 10);
+    ASSERT_EQ(b.get(), 10);
+
+    bool threw = false;
+    try {
+        sync_wait(await_future(make_exceptional_future<int>(std::make_exception_ptr(std::logic_error("bad")))));
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    // 与 set_value 竞争：每个等待者恰好恢复一次
+    thread_pool pool(4);
+    for (int round = 0; round < 200; ++round) {
+        promise<int> r;
+        future<int> res = to_future(await_future(r.get_future()));
+        pool.submit_void([&r, round] { r.set_value(round); });
+        ASSERT_EQ(res.get(), round * 2);
+    }
+}
+
+// ===========================================================================
+// 事件循环
+// ===========================================================================
+
+static task<std::string> read_all(event_loop& loop, int fd) {
+    std::string data;
+    char buf[64];
+    for (;;) {
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n > 0) {
+            data.append(buf, static_cast<size_t>(n));
+            continue;
+        }
+        if (n == 0) break;
+        ASSERT_TRUE(errno == EAGAIN);
+        uint32_t ev = co_await loop.readable(fd);
+        ASSERT_TRUE(ev != 0);
+    }
+    co_return data;
+}
+
+void test_event_loop_io() {
+    printf("test_event_loop_io...\n");
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+    event_loop loop;
+    std::string got;
+    co_spawn(loop, [](event_loop& l, int fd, std::string& out) -> task<void> {
+        out = co_await read_all(l, fd);
+        l.stop();
+    }(loop, fds[0], got));
+
+    std::thread writer([fd = fds[1]] {
+        for (int i = 0; i < 10; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            std::string chunk = "chunk" + std::to_string(i) + ";";
+            ssize_t n = write(fd, chunk.data(), chunk.size());
+            (void)n;
+        }
+        close(fd);
+    });
+    loop.run();
+    writer.join();
+    close(fds[0]);
+
+    std::string expect;
+    for (int i = 0; i < 10; ++i) expect += "chunk" + std::to_string(i) + ";";
+    ASSERT_EQ(got, expect);
+}
+
+void test_sleep_for() {
+    printf("test_sleep_for...\n");
+    event_loop loop;
+    std::vector<int> order;
+    long long elapsed_ms = -1;
+
+    auto sleeper = [](std::vector<int>& out, int id, unsigned ms) -> task<void> {
+        co_await sleep_for(ms);
+        out.push_back(id);
+    };
+    co_spawn(loop, [](event_loop& l, std::vector<int>& out, long long& elapsed, auto make) -> task<void> {
+        unsigned long long t0 = this_thread::monotonic_ms();   // 与定时器同一时钟（毫秒精度）
+        co_spawn(make(out, 3, 30));
+        co_spawn(make(out, 1, 10));
+        co_spawn(make(out, 2, 20));
+        co_await l.sleep_for(50);
+        elapsed = static_cast<long long>(this_thread::monotonic_ms() - t0);
+        l.stop();
+    }(loop, order, elapsed_ms, sleeper));
+    loop.run();
+
+    ASSERT_EQ(order.size(), 3u);
+    ASSERT_EQ(order[0], 1);
+    ASSERT_EQ(order[1], 2);
+    ASSERT_EQ(order[2], 3);
+    // 定时器按到期时间唤醒事件循环，而不是等到 epoll 超时上限
+    ASSERT_TRUE(elapsed_ms >= 50);
+    ASSERT_TRUE(elapsed_ms < 1000);
+
+    // 同一时刻到期的睡眠多于定时器单批容量：全部恢复
+    std::vector<int> woke;
+    event_loop many;
+    co_spawn(many, [](event_loop& l, std::vector<int>& out, auto make) -> task<void> {
+        for (int i = 0; i < 40; ++i) co_spawn(make(out, i, 20));
+        co_await l.sleep_for(60);
+        l.stop();
+    }(many, woke, sleeper));
+    many.run();
+    ASSERT_EQ(woke.size(), 40u);
+
+    // 不在事件循环线程上
+    bool threw = false;
+    try {
+        (void)sleep_for(1);
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+}
+
+// ===========================================================================
+// 协程帧分配
+// ===========================================================================
+
+void test_frame_allocator() {
+    printf("test_frame_allocator...\n");
+    tc_flush_thread_stats();
+    int64_t before = tc_get_stats().bytes_in_use;
+    {
+        std::vector<task<int>> pending;
+        for (int i = 0; i < 100; ++i) pending.push_back(value_of(i));
+        tc_flush_thread_stats();
+        int64_t held = tc_get_stats().bytes_in_use - before;
+#if ZEN_CORO_FRAME_POOL
+        ASSERT_TRUE(held >= 100 * 16);
+#else
+        ASSERT_EQ(held, 0);
+#endif
+        for (auto& t : pending) sync_wait(std::move(t));
+    }
+    tc_flush_thread_stats();
+    ASSERT_EQ(tc_get_stats().bytes_in_use, before);
+}
+
+int main() {
+    printf("=== coroutine Tests ===\n\n");
+
+    test_task_basic();
+    test_sync_completion();
+    test_generator();
+    test_pool_schedule();
+    test_future_await();
+    test_event_loop_io();
+    test_sleep_for();
+    test_frame_allocator();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
+
+#else
+
+int main() {
+    printf("=== coroutine Tests ===\n\n");
+    printf("skipped: compile with -std=c++20\n");
+    return 0;
+}
+
+#endif // ZEN_HAS_COROUTINES
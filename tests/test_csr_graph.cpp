@@ -0,0 +1,386 @@
+// test_csr_graph.cpp
+// 测试 algorithms/csr_graph.h：
+// 由 Graph / 边表构造（对称化、去重、入边），二进制边表文件写入与 mmap 读取，
+// 方向优化 BFS 的层数与顺序 BFS 一致且父节点合法（覆盖只能自顶向下的有向图
+// 和会切换到自底向上的稠密图），delta-stepping 与 Dijkstra 比对（浮点 / 整数 /
+// 无权，不同 delta），并行连通分量与 find_connected_components(Graph) 编号一致；
+// 并行版本在 3 个工作线程的线程池上运行
+
+#include "../src/algorithms/csr_graph.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <cassert>
+#include <cmath>
+#include <queue>
+#include <string>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+using namespace zen;
+
+static uint64_t rng_state = 88172645463325252ULL;
+static uint64_t rnd() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static const uint32_t npos = csr_graph<>::npos;
+
+template <typename W>
+static std::vector<csr_edge<W>> random_edges(size_t n, size_t m, uint64_t max_weight) {
+    std::vector<csr_edge<W>> edges;
+    for (size_t i = 0; i < m; ++i) {
+        edges.push_back(csr_edge<W>{ static_cast<uint32_t>(rnd() % n), static_cast<uint32_t>(rnd() % n),
+                                     static_cast<W>(rnd() % (max_weight + 1)) });
+    }
+    return edges;
+}
+
+// 顺序参考 BFS（按出边）
+template <typename W>
+static std::vector<uint32_t> reference_depth(const csr_graph<W>& g, uint32_t s) {
+    std::vector<uint32_t> depth(g.vertex_count(), npos);
+    std::queue<uint32_t> q;
+    depth[s] = 0;
+    q.push(s);
+    while (!q.empty()) {
+        uint32_t u = q.front();
+        q.pop();
+        for (uint32_t v : g.neighbors(u)) {
+            if (depth[v] == npos) { depth[v] = depth[u] + 1; q.push(v); }
+        }
+    }
+    return depth;
+}
+
+template <typename W>
+static std::vector<W> reference_dijkstra(const csr_graph<W>& g, uint32_t s) {
+    const W INF = std::numeric_limits<W>::has_infinity ? std::numeric_limits<W>::infinity()
+                                                       : std::numeric_limits<W>::max();
+    std::vector<W> dist(g.vertex_count(), INF);
+    using item = std::pair<W, uint32_t>;
+    std::priority_queue<item, std::vector<item>, std::greater<item>> pq;
+    dist[s] = W(0);
+    pq.push({W(0), s});
+    while (!pq.empty()) {
+        item top = pq.top();
+        pq.pop();
+        if (top.first > dist[top.second]) continue;
+        uint32_t u = top.second;
+        auto nb = g.neighbors(u);
+        for (size_t k = 0; k < nb.size(); ++k) {
+            W nd = top.first + g.weight(g.offsets()[u] + k);
+            if (nd < dist[nb[k]]) { dist[nb[k]] = nd; pq.push({nd, nb[k]}); }
+        }
+    }
+    return dist;
+}
+
+template <typename W>
+static void check_bfs(const csr_bfs_result& r, const csr_graph<W>& g, uint32_t s) {
+    ASSERT_TRUE(r.depth == reference_depth(g, s));
+    for (uint32_t v = 0; v < g.vertex_count(); ++v) {
+        if (r.depth[v] == npos) { ASSERT_EQ(r.parent[v], npos); continue; }
+        if (v == s) { ASSERT_EQ(r.parent[v], s); continue; }
+        uint32_t p = r.parent[v];
+        ASSERT_EQ(r.depth[p] + 1, r.depth[v]);
+        bool edge_found = false;
+        for (uint32_t t : g.neighbors(p)) edge_found |= (t == v);
+        ASSERT_TRUE(edge_found);
+    }
+}
+
+void test_build() {
+    printf("test_build...\n");
+    Graph<int, double> graph;
+    for (int i = 0; i < 5; ++i) graph.add_node(i);
+    graph.add_directed_edge(0, 3, 2.5);
+    graph.add_directed_edge(0, 1, 1.0);
+    graph.add_directed_edge(3, 4, 0.5);
+    graph.add_undirected_edge(1, 2, 7.0);
+
+    csr_graph<double> g(graph);
+    ASSERT_EQ(g.vertex_count(), 5u);
+    ASSERT_EQ(g.edge_count(), 5u);
+    ASSERT_TRUE(g.weighted());
+    ASSERT_FALSE(g.is_symmetric());
+    ASSERT_FALSE(g.has_incoming());
+    ASSERT_EQ(g.degree(0), 2u);
+    ASSERT_EQ(g.neighbors(0)[0], 1u);          // 邻居已排序
+    ASSERT_EQ(g.neighbors(0)[1], 3u);
+    ASSERT_EQ(g.edge_weights(0)[1], 2.5);
+    ASSERT_EQ(g.degree(4), 0u);
+
+    // 对称化 + 去重（1-2 已经是双向边）+ 越界边被忽略
+    std::vector<csr_edge<double>> edges = { {0, 1, 3.0}, {1, 0, 2.0}, {1, 2, 1.0}, {2, 2, 4.0}, {0, 9, 1.0} };
+    csr_options sym;
+    sym.symmetrize = true;
+    sym.remove_duplicates = true;
+    csr_graph<double> s(3, edges, sym);
+    ASSERT_TRUE(s.is_symmetric() && s.has_incoming());
+    ASSERT_EQ(s.degree(0), 1u);
+    ASSERT_EQ(s.edge_weights(0)[0], 2.0);        // 重复边保留较小权重
+    ASSERT_EQ(s.degree(1), 2u);
+    ASSERT_EQ(s.degree(2), 2u);                  // 1 和自环
+    ASSERT_EQ(s.edge_count(), 5u);
+
+    // 入边
+    csr_options in;
+    in.build_incoming = true;
+    csr_graph<double> d(graph, in);
+    ASSERT_TRUE(d.has_incoming());
+    ASSERT_EQ(d.in_degree(3), 1u);
+    ASSERT_EQ(d.in_neighbors(3)[0], 0u);
+    ASSERT_EQ(d.in_degree(2), 1u);
+    ASSERT_EQ(d.in_degree(0), 0u);
+
+    // 并行构造与顺序构造一致
+    thread_pool pool(3);
+    for (int round = 0; round < 12; ++round) {
+        bool large = round >= 8;   // 超过两个边块，走分块划分的并行构造
+        size_t n = 1 + rnd() % (large ? 60000 : 3000);
+        auto es = random_edges<float>(n, large ? 200000 + rnd() % 200000 : rnd() % 40000, 100);
+        csr_options opts;
+        opts.symmetrize = (round & 1) != 0;
+        opts.build_incoming = true;
+        opts.remove_duplicates = (round & 2) != 0;
+        csr_graph<float> a(n, es, opts), b(execution::par.on(pool), n, es, opts);
+        ASSERT_EQ(a.edge_count(), b.edge_count());
+        for (uint32_t v = 0; v < n; ++v) {
+            auto na = a.neighbors(v), nb = b.neighbors(v);
+            ASSERT_EQ(na.size(), nb.size());
+            for (size_t k = 0; k < na.size(); ++k) {
+                ASSERT_EQ(na[k], nb[k]);
+                ASSERT_EQ(a.edge_weights(v)[k], b.edge_weights(v)[k]);
+            }
+            ASSERT_EQ(a.in_degree(v), b.in_degree(v));
+        }
+    }
+}
+
+void test_edge_list_file() {
+    printf("test_edge_list_file...\n");
+    const char* path = "/tmp/zen_test_edges.bin";
+    auto edges = random_edges<double>(1000, 20000, 1000);
+    ASSERT_TRUE(write_edge_list(path, 1000, edges));
+
+    mapped_edge_list file;
+    ASSERT_TRUE(file.open(path));
+    ASSERT_EQ(file.vertex_count(), 1000u);
+    ASSERT_EQ(file.edge_count(), edges.size());
+    ASSERT_TRUE(file.weight_kind() == edge_weight_kind::float64);
+    ASSERT_EQ(file.source(7), edges[7].source);
+    ASSERT_EQ(file.weight<double>(7), edges[7].weight);
+
+    csr_graph<double> mem(1000, edges), mapped(file);
+    thread_pool pool(3);
+    csr_graph<double> mapped_par(execution::par.on(pool), file);
+    ASSERT_EQ(mapped.edge_count(), mem.edge_count());
+    for (uint32_t v = 0; v < 1000; ++v) {
+        ASSERT_EQ(mapped.degree(v), mem.degree(v));
+        ASSERT_EQ(mapped_par.degree(v), mem.degree(v));
+        for (size_t k = 0; k < mem.degree(v); ++k) {
+            ASSERT_EQ(mapped.neighbors(v)[k], mem.neighbors(v)[k]);
+            ASSERT_EQ(mapped.edge_weights(v)[k], mem.edge_weights(v)[k]);
+        }
+    }
+
+    // 无权文件；按 uint32 写入的权重
+    ASSERT_TRUE(write_edge_list(path, 1000, edges, false));
+    ASSERT_TRUE(file.open(path));
+    ASSERT_FALSE(file.weighted());
+    csr_graph<double> unweighted(file);
+    ASSERT_FALSE(unweighted.weighted());
+    ASSERT_EQ(unweighted.weight(0), 1.0);
+
+    auto int_edges = random_edges<uint32_t>(50, 500, 9);
+    ASSERT_TRUE(write_edge_list(path, 50, int_edges));
+    ASSERT_TRUE(file.open(path));
+    ASSERT_TRUE(file.weight_kind() == edge_weight_kind::uint32);
+    ASSERT_EQ(file.weight<double>(3), static_cast<double>(int_edges[3].weight));
+
+    // 长度不符 / 格式错误
+    FILE* fp = fopen(path, "r+b");
+    ASSERT_TRUE(fp != nullptr);
+    fseek(fp, 0, SEEK_END);
+    fputc(0, fp);
+    fclose(fp);
+    ASSERT_FALSE(file.open(path));
+    ASSERT_FALSE(file.is_open());
+    fp = fopen(path, "wb");
+    fputs("not an edge list at all, definitely not", fp);
+    fclose(fp);
+    ASSERT_FALSE(file.open(path));
+    ASSERT_FALSE(file.open("/tmp/zen_test_edges_missing.bin"));
+    remove(path);
+}
+
+void test_bfs() {
+    printf("test_bfs...\n");
+    thread_pool pool(3);
+    auto par = execution::par.on(pool);
+    for (int round = 0; round < 30; ++round) {
+        size_t n = 1 + rnd() % 4000;
+        size_t m = rnd() % (n * (round % 3 == 0 ? 30 : 3));   // 稠密图会切换到自底向上
+        auto edges = random_edges<double>(n, m, 1);
+        csr_options opts;
+        opts.symmetrize = round % 3 == 0;
+        opts.build_incoming = round % 3 == 1;                  // round % 3 == 2：只能自顶向下
+        csr_graph<double> g(n, edges, opts);
+        uint32_t s = static_cast<uint32_t>(rnd() % n);
+        check_bfs(bfs(g, s), g, s);
+        check_bfs(bfs(par, g, s), g, s);
+    }
+    // 长链：深度很大、前沿很小
+    std::vector<csr_edge<double>> chain;
+    for (uint32_t i = 0; i + 1 < 20000; ++i) chain.push_back({i, i + 1, 1.0});
+    csr_options sym;
+    sym.symmetrize = true;
+    csr_graph<double> c(20000, chain, sym);
+    csr_bfs_result r = bfs(par, c, 0);
+    ASSERT_EQ(r.depth[19999], 19999u);
+    ASSERT_EQ(r.parent[19999], 19998u);
+
+    csr_graph<double> empty;
+    ASSERT_TRUE(bfs(empty, 0).depth.empty());
+    r = bfs(c, 20000);
+    ASSERT_EQ(r.depth[0], npos);
+}
+
+template <typename W>
+static void check_sssp(const std::vector<W>& got, const std::vector<W>& expect) {
+    ASSERT_EQ(got.size(), expect.size());
+    for (size_t v = 0; v < got.size(); ++v) {
+        if (std::numeric_limits<W>::is_integer) ASSERT_EQ(got[v], expect[v]);
+        else ASSERT_TRUE(got[v] == expect[v] || std::fabs(double(got[v]) - double(expect[v])) < 1e-9 * (1 + double(expect[v])));
+    }
+}
+
+void test_delta_stepping() {
+    printf("test_delta_stepping...\n");
+    thread_pool pool(3);
+    auto par = execution::par.on(pool);
+    for (int round = 0; round < 30; ++round) {
+        size_t n = 1 + rnd() % 3000;
+        size_t m = rnd() % (n * 8);
+        uint32_t s = static_cast<uint32_t>(rnd() % n);
+
+        std::vector<csr_edge<double>> de;
+        for (const auto& e : random_edges<uint32_t>(n, m, 1000)) de.push_back({e.source, e.target, e.weight * 0.001});
+        csr_graph<double> gd(n, de);
+        auto expect = reference_dijkstra(gd, s);
+        check_sssp(delta_stepping(gd, s), expect);
+        check_sssp(delta_stepping(par, gd, s), expect);
+        check_sssp(delta_stepping(par, gd, s, 0.01), expect);
+        check_sssp(delta_stepping(par, gd, s, 10.0), expect);
+
+        csr_graph<uint32_t> gi(n, random_edges<uint32_t>(n, m, 50));   // 含 0 权边
+        auto expect_i = reference_dijkstra(gi, s);
+        check_sssp(delta_stepping(gi, s), expect_i);
+        check_sssp(delta_stepping(par, gi, s, 1u), expect_i);
+        check_sssp(delta_stepping(par, gi, s, 7u), expect_i);
+    }
+    // 无权图：距离等于 BFS 层数
+    const char* path = "/tmp/zen_test_edges_sssp.bin";
+    auto edges = random_edges<float>(2000, 6000, 1);
+    ASSERT_TRUE(write_edge_list(path, 2000, edges, false));
+    mapped_edge_list file(path);
+    ASSERT_TRUE(file.is_open());
+    csr_graph<float> g(file);
+    auto depth = reference_depth(g, 0);
+    auto dist = delta_stepping(par, g, 0);
+    for (size_t v = 0; v < 2000; ++v) {
+        if (depth[v] == npos) ASSERT_TRUE(std::isinf(dist[v]));
+        else ASSERT_EQ(dist[v], static_cast<float>(depth[v]));
+    }
+    file.close();
+    remove(path);
+}
+
+void test_components() {
+    printf("test_components...\n");
+    thread_pool pool(3);
+    auto par = execution::par.on(pool);
+    for (int round = 0; round < 20; ++round) {
+        size_t n = 1 + rnd() % 3000;
+        size_t m = rnd() % (n * 2);   // 稀疏：多个分量
+        Graph<int, double> graph;
+        for (size_t i = 0; i < n; ++i) graph.add_node(static_cast<int>(i));
+        std::vector<csr_edge<double>> edges = random_edges<double>(n, m, 1);
+        for (const auto& e : edges) graph.add_undirected_edge(e.source, e.target, 1.0);
+
+        std::vector<size_t> expect = find_connected_components(graph);
+        csr_options sym;
+        sym.symmetrize = true;
+        csr_graph<double> g(n, edges, sym);
+        for (const auto& got : { find_connected_components(g), find_connected_components(par, g) }) {
+            ASSERT_EQ(got.size(), n);
+            for (size_t v = 0; v < n; ++v) ASSERT_EQ(static_cast<size_t>(got[v]), expect[v]);
+        }
+        // 有向图按弱连通处理，结果相同
+        csr_graph<double> d(n, edges);
+        auto weak = find_connected_components(par, d);
+        for (size_t v = 0; v < n; ++v) ASSERT_EQ(static_cast<size_t>(weak[v]), expect[v]);
+    }
+    csr_graph<double> empty;
+    ASSERT_TRUE(find_connected_components(par, empty).empty());
+}
+
+static uint64_t submitted_total(const thread_pool& pool) {
+    thread_pool_metrics m = pool.metrics();
+    uint64_t n = 0;
+    for (uint64_t x : m.submitted) n += x;
+    return n;
+}
+
+void test_policy_grain() {
+    printf("test_policy_grain...\n");
+    // 小图低于默认粒度，只在调用线程执行；with_grain 指定的粒度必须生效
+    thread_pool pool(3);
+    size_t n = 1000;
+    auto edges = random_edges<double>(n, 3000, 1);
+    csr_options sym;
+    sym.symmetrize = true;
+    csr_graph<double> g(n, edges, sym);
+    std::vector<uint32_t> expect = find_connected_components(g);
+
+    uint64_t before = submitted_total(pool);
+    ASSERT_TRUE(find_connected_components(execution::par.on(pool), g) == expect);
+    ASSERT_EQ(submitted_total(pool), before);
+
+    auto fine = execution::par.on(pool).with_grain(16);
+    ASSERT_TRUE(find_connected_components(fine, g) == expect);
+    ASSERT_TRUE(submitted_total(pool) > before);
+
+    check_bfs(bfs(fine, g, 0), g, 0);
+    check_sssp(delta_stepping(fine, g, 0), reference_dijkstra(g, 0));
+    csr_graph<double> built(fine, n, edges, sym);
+    ASSERT_EQ(built.edge_count(), g.edge_count());
+    for (uint32_t v = 0; v < n; ++v) ASSERT_EQ(built.degree(v), g.degree(v));
+}
+
+int main() {
+    printf("=== csr_graph Tests ===\n\n");
+
+    test_build();
+    test_edge_list_file();
+    test_bfs();
+    test_delta_stepping();
+    test_components();
+    test_policy_grain();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
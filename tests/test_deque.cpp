@@ -0,0 +1,299 @@
+// test_deque.cpp
+// 测试分段 deque：两端增长、地址稳定、迭代器算术、中间插入删除、分配器，
+// 以及 queue / stack 适配器
+
+#include "../src/containers/sequential/deque.h"
+#include "../src/containers/adapter/queue.h"
+#include "../src/containers/adapter/stack.h"
+#include "../src/memory/arena.h"
+#include "../src/memory/arena_allocator.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <cassert>
+#include <deque>
+#include <string>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+using namespace zen;
+
+// 记录存活对象数，检查泄漏与重复析构
+struct counted {
+    static int alive;
+    int v;
+    counted(int x = 0) : v(x) { ++alive; }
+    counted(const counted& o) : v(o.v) { ++alive; }
+    counted(counted&& o) noexcept : v(o.v) { o.v = -1; ++alive; }
+    counted& operator=(const counted& o) { v = o.v; return *this; }
+    counted& operator=(counted&& o) noexcept { v = o.v; o.v = -1; return *this; }
+    ~counted() { --alive; }
+    bool operator==(const counted& o) const { return v == o.v; }
+};
+int counted::alive = 0;
+
+// ===========================================================================
+// deque
+// ===========================================================================
+
+void test_push_pop_both_ends() {
+    printf("test_push_pop_both_ends...\n");
+    deque<int> d;
+    ASSERT_TRUE(d.empty());
+    ASSERT_EQ(d.size(), 0u);
+    ASSERT_TRUE(d.begin() == d.end());
+
+    const int N = 10000;
+    for (int i = 0; i < N; ++i) {
+        d.push_back(i);
+        d.push_front(-i - 1);
+    }
+    ASSERT_EQ(d.size(), static_cast<size_t>(2 * N));
+    ASSERT_EQ(d.front(), -N);
+    ASSERT_EQ(d.back(), N - 1);
+    for (int i = 0; i < 2 * N; ++i) ASSERT_EQ(d[static_cast<size_t>(i)], i - N);
+
+    for (int i = 0; i < N; ++i) {
+        ASSERT_EQ(d.front(), -N + i);
+        d.pop_front();
+        ASSERT_EQ(d.back(), N - 1 - i);
+        d.pop_back();
+    }
+    ASSERT_TRUE(d.empty());
+    d.push_back(7);
+    ASSERT_EQ(d.front(), 7);
+}
+
+void test_stable_addresses() {
+    printf("test_stable_addresses...\n");
+    deque<std::string> d;
+    d.push_back("first");
+    std::string* p = &d.front();
+    for (int i = 0; i < 50000; ++i) {
+        d.push_back(std::to_string(i));
+        d.push_front(std::to_string(-i));
+    }
+    ASSERT_EQ(p, &d[50000]);                // 两端增长不移动已有元素
+    ASSERT_EQ(*p, "first");
+}
+
+void test_iterator_arithmetic() {
+    printf("test_iterator_arithmetic...\n");
+    deque<int> d;
+    for (int i = 0; i < 5000; ++i) d.push_back(i);
+    for (int i = 0; i < 3000; ++i) d.push_front(-1 - i);
+
+    auto b = d.begin();
+    auto e = d.end();
+    ASSERT_EQ(e - b, static_cast<ptrdiff_t>(d.size()));
+    for (ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(d.size()); i += 37) {
+        ASSERT_EQ(*(b + i), d[static_cast<size_t>(i)]);
+        ASSERT_EQ(b[i], d[static_cast<size_t>(i)]);
+        ASSERT_EQ((e - (static_cast<ptrdiff_t>(d.size()) - i)) - b, i);
+        auto it = b + i;
+        ASSERT_EQ(*(it - (i / 2)), d[static_cast<size_t>(i - i / 2)]);
+        ASSERT_TRUE(b + i < e);
+        ASSERT_TRUE(b <= it);
+    }
+
+    int expect = -3000;
+    for (int x : d) ASSERT_EQ(x, expect++);
+    expect = 4999;
+    for (auto it = d.rbegin(); it != d.rend(); ++it) ASSERT_EQ(*it, expect--);
+
+    const deque<int>& cd = d;
+    deque<int>::const_iterator ci = d.begin();
+    ASSERT_TRUE(ci == cd.begin());
+    ASSERT_EQ(cd.end() - ci, static_cast<ptrdiff_t>(d.size()));
+}
+
+void test_insert_erase_vs_std() {
+    printf("test_insert_erase_vs_std...\n");
+    deque<counted> d;
+    std::deque<int> ref;
+    uint64_t s = 88172645463325252ULL;
+    auto rnd = [&s]() { s ^= s << 13; s ^= s >> 7; s ^= s << 17; return s; };
+
+    for (int step = 0; step < 20000; ++step) {
+        uint64_t r = rnd();
+        int v = static_cast<int>(r >> 40);
+        size_t n = ref.size();
+        switch (r % 8) {
+        case 0: case 1: d.push_back(v); ref.push_back(v); break;
+        case 2: d.push_front(v); ref.push_front(v); break;
+        case 3: if (n) { d.pop_back(); ref.pop_back(); } break;
+        case 4: if (n) { d.pop_front(); ref.pop_front(); } break;
+        case 5: {
+            size_t i = n ? (r >> 8) % (n + 1) : 0;
+            auto it = d.insert(d.begin() + static_cast<ptrdiff_t>(i), counted(v));
+            ref.insert(ref.begin() + static_cast<ptrdiff_t>(i), v);
+            ASSERT_EQ(it->v, v);
+            break;
+        }
+        case 6: if (n) {
+            size_t i = (r >> 8) % n;
+            auto it = d.erase(d.begin() + static_cast<ptrdiff_t>(i));
+            ref.erase(ref.begin() + static_cast<ptrdiff_t>(i));
+            ASSERT_EQ(it - d.begin(), static_cast<ptrdiff_t>(i));
+        } break;
+        case 7: if (n) {
+            size_t i = (r >> 8) % n;
+            size_t k = (r >> 24) % (n - i + 1);
+            d.erase(d.begin() + static_cast<ptrdiff_t>(i), d.begin() + static_cast<ptrdiff_t>(i + k));
+            ref.erase(ref.begin() + static_cast<ptrdiff_t>(i), ref.begin() + static_cast<ptrdiff_t>(i + k));
+        } break;
+        }
+        ASSERT_EQ(d.size(), ref.size());
+        if (step % 500 == 0) {
+            for (size_t i = 0; i < ref.size(); ++i) ASSERT_EQ(d[i].v, ref[i]);
+        }
+    }
+    for (size_t i = 0; i < ref.size(); ++i) ASSERT_EQ(d[i].v, ref[i]);
+    ASSERT_EQ(counted::alive, static_cast<int>(d.size()));
+    d.clear();
+    ASSERT_EQ(counted::alive, 0);
+    ASSERT_TRUE(d.empty());
+}
+
+template<typename T>
+static void check_fill_insert(size_t n, size_t i, size_t count) {
+    deque<T> d;
+    std::deque<int> ref;
+    for (size_t k = 0; k < n; ++k) { d.emplace_back(static_cast<int>(k)); ref.push_back(static_cast<int>(k)); }
+    auto it = d.insert(d.begin() + static_cast<ptrdiff_t>(i), count, T(-7));
+    ref.insert(ref.begin() + static_cast<ptrdiff_t>(i), count, -7);
+    ASSERT_EQ(it - d.begin(), static_cast<ptrdiff_t>(i));
+    ASSERT_EQ(d.size(), ref.size());
+    for (size_t k = 0; k < ref.size(); ++k) ASSERT_TRUE(d[k] == T(ref[k]));
+}
+
+void test_insert_fill() {
+    printf("test_insert_fill...\n");
+    const size_t sizes[]  = {0, 1, 5, 100, 1000};
+    const size_t counts[] = {0, 1, 3, 64, 700, 2500};
+    for (size_t n : sizes) {
+        const size_t positions[] = {0, n / 4, n / 2, n - n / 3, n};
+        for (size_t i : positions) {
+            for (size_t c : counts) {
+                check_fill_insert<int>(n, i, c);
+                check_fill_insert<counted>(n, i, c);
+            }
+        }
+    }
+    ASSERT_EQ(counted::alive, 0);
+
+    // value 引用容器内的元素
+    deque<counted> d;
+    for (int k = 0; k < 50; ++k) d.emplace_back(k);
+    d.insert(d.begin() + 10, 30, d[5]);
+    d.insert(d.begin() + 70, 30, d[75]);
+    ASSERT_EQ(d.size(), 110u);
+    for (int k = 10; k < 40; ++k) ASSERT_EQ(d[static_cast<size_t>(k)].v, 5);
+    ASSERT_EQ(d[69].v, 39);
+    for (int k = 70; k < 100; ++k) ASSERT_EQ(d[static_cast<size_t>(k)].v, 45);
+    ASSERT_EQ(d[100].v, 40);
+}
+
+void test_copy_move_compare() {
+    printf("test_copy_move_compare...\n");
+    {
+        deque<counted> a;
+        for (int i = 0; i < 1000; ++i) a.emplace_back(i);
+        deque<counted> b(a);
+        ASSERT_TRUE(a == b);
+        b.back().v = 5;
+        ASSERT_TRUE(a != b);
+        deque<counted> c(static_cast<deque<counted>&&>(b));
+        ASSERT_TRUE(b.empty());
+        ASSERT_EQ(c.size(), 1000u);
+        c = a;
+        ASSERT_TRUE(c == a);
+        c.resize(10);
+        ASSERT_EQ(c.size(), 10u);
+        c.resize(20, counted(3));
+        ASSERT_EQ(c[19].v, 3);
+        a.swap(c);
+        ASSERT_EQ(a.size(), 20u);
+        deque<counted> e(5, counted(9));
+        ASSERT_EQ(e.back().v, 9);
+    }
+    ASSERT_EQ(counted::alive, 0);
+
+    deque<int> x, y;
+    x.push_back(1); x.push_back(2);
+    y.push_back(1); y.push_back(3);
+    ASSERT_TRUE(x < y);
+}
+
+void test_arena_allocator() {
+    printf("test_arena_allocator...\n");
+    monotonic_arena arena;
+    deque<int, arena_allocator<int>> d(&arena);
+    for (int i = 0; i < 10000; ++i) d.push_back(i);
+    for (int i = 0; i < 10000; ++i) d.push_front(i);
+    ASSERT_EQ(d.size(), 20000u);
+    ASSERT_TRUE(arena.allocated_bytes() >= 20000 * sizeof(int));
+    ASSERT_TRUE(d.get_allocator().resource() == &arena);
+}
+
+// ===========================================================================
+// queue / stack
+// ===========================================================================
+
+void test_queue_stack() {
+    printf("test_queue_stack...\n");
+    queue<int> q;
+    for (int i = 0; i < 100000; ++i) q.push(i);
+    ASSERT_EQ(q.size(), 100000u);
+    ASSERT_EQ(q.back(), 99999);
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_EQ(q.front(), i);
+        q.pop();
+    }
+    ASSERT_TRUE(q.empty());
+
+    // 长期尾进头出：复用缓存的空闲块
+    queue<std::string> sq;
+    for (int i = 0; i < 100000; ++i) {
+        sq.emplace(std::to_string(i));
+        if (sq.size() > 10) sq.pop();
+    }
+    ASSERT_EQ(sq.front(), "99990");
+
+    stack<int> st;
+    for (int i = 0; i < 10000; ++i) st.push(i);
+    int& top = st.top();
+    st.push(-1);
+    ASSERT_EQ(top, 9999);                   // push 后原栈顶引用仍有效
+    st.pop();
+    for (int i = 9999; i >= 0; --i) {
+        ASSERT_EQ(st.top(), i);
+        st.pop();
+    }
+    ASSERT_TRUE(st.empty());
+}
+
+int main() {
+    printf("=== deque Tests ===\n\n");
+
+    test_push_pop_both_ends();
+    test_stable_addresses();
+    test_iterator_arithmetic();
+    test_insert_erase_vs_std();
+    test_insert_fill();
+    test_copy_move_compare();
+    test_arena_allocator();
+
+    test_queue_stack();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,234 @@
+// test_fast_mutex.cpp
+// 测试 futex 互斥锁与条件变量（threading/sync/fast_mutex.h、fast_condition_variable.h）
+// 以及带退避的 spinlock / ticket_lock：
+// 基本加解锁、多线程竞争下计数不丢失、生产者-消费者、notify_all 唤醒全部等待者
+// （Linux 上经 FUTEX_CMP_REQUEUE 转移到锁上）、超时等待；线程数多于核数时自旋锁仍能前进
+
+#include "../src/threading/sync/fast_mutex.h"
+#include "../src/threading/sync/fast_condition_variable.h"
+#include "../src/threading/sync/spinlock.h"
+#include "../src/threading/sync/lock_guard.h"
+#include <stdio.h>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+
+using namespace zen;
+
+template<typename Lock>
+static long hammer(Lock& lock, int threads, int iters) {
+    long counter = 0;
+    std::vector<std::thread> ts;
+    for (int t = 0; t < threads; ++t) {
+        ts.emplace_back([&] {
+            for (int i = 0; i < iters; ++i) {
+                lock_guard<Lock> lg(lock);
+                ++counter;
+            }
+        });
+    }
+    for (auto& t : ts) t.join();
+    return counter;
+}
+
+// ===========================================================================
+// fast_mutex
+// ===========================================================================
+
+void test_fast_mutex_basic() {
+    printf("test_fast_mutex_basic...\n");
+    fast_mutex m;
+    ASSERT_TRUE(!m.is_locked());
+    m.lock();
+    ASSERT_TRUE(m.is_locked());
+    ASSERT_TRUE(!m.try_lock());
+    m.unlock();
+    ASSERT_TRUE(m.try_lock());
+    m.unlock();
+    {
+        unique_lock<fast_mutex> ul(m, defer_lock);
+        ASSERT_TRUE(!ul.owns_lock());
+        ul.lock();
+        ASSERT_TRUE(m.is_locked());
+    }
+    ASSERT_TRUE(!m.is_locked());
+}
+
+void test_fast_mutex_contended() {
+    printf("test_fast_mutex_contended...\n");
+    fast_mutex m;
+    ASSERT_EQ(hammer(m, 8, 20000), 8L * 20000);
+    ASSERT_TRUE(!m.is_locked());
+
+    // 长临界区：等待者必须挂起并被逐个唤醒
+    long inside = 0, max_inside = 0, done = 0;
+    std::vector<std::thread> ts;
+    for (int t = 0; t < 6; ++t) {
+        ts.emplace_back([&] {
+            for (int i = 0; i < 20; ++i) {
+                lock_guard<fast_mutex> lg(m);
+                if (++inside > max_inside) max_inside = inside;
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                --inside;
+                ++done;
+            }
+        });
+    }
+    for (auto& t : ts) t.join();
+    ASSERT_EQ(max_inside, 1L);
+    ASSERT_EQ(done, 120L);
+}
+
+// ===========================================================================
+// fast_condition_variable
+// ===========================================================================
+
+void test_producer_consumer() {
+    printf("test_producer_consumer...\n");
+    fast_mutex m;
+    fast_condition_variable not_empty, not_full;
+    std::deque<int> q;
+    const size_t cap = 8;
+    const int per_producer = 5000, producers = 3, consumers = 3;
+    std::atomic<long> consumed_sum{0};
+    std::atomic<int>  consumed{0};
+
+    std::vector<std::thread> ts;
+    for (int p = 0; p < producers; ++p) {
+        ts.emplace_back([&, p] {
+            for (int i = 0; i < per_producer; ++i) {
+                unique_lock<fast_mutex> ul(m);
+                not_full.wait(ul, [&] { return q.size() < cap; });
+                q.push_back(p * per_producer + i);
+                ul.unlock();
+                not_empty.notify_one();
+            }
+        });
+    }
+    const int total = producers * per_producer;
+    for (int c = 0; c < consumers; ++c) {
+        ts.emplace_back([&] {
+            for (;;) {
+                unique_lock<fast_mutex> ul(m);
+                not_empty.wait(ul, [&] { return !q.empty() || consumed.load() == total; });
+                if (q.empty()) return;
+                int v = q.front();
+                q.pop_front();
+                int n = consumed.fetch_add(1) + 1;
+                ul.unlock();
+                not_full.notify_one();
+                consumed_sum.fetch_add(v);
+                if (n == total) not_empty.notify_all();
+            }
+        });
+    }
+    for (auto& t : ts) t.join();
+    ASSERT_EQ(consumed.load(), total);
+    ASSERT_EQ(consumed_sum.load(), static_cast<long>(total) * (total - 1) / 2);
+}
+
+void test_notify_all() {
+    printf("test_notify_all...\n");
+    fast_mutex m;
+    fast_condition_variable cv;
+    for (int round = 0; round < 50; ++round) {
+        bool go = false;
+        int waiting = 0, woke = 0;
+        std::vector<std::thread> ts;
+        for (int t = 0; t < 8; ++t) {
+            ts.emplace_back([&] {
+                unique_lock<fast_mutex> ul(m);
+                ++waiting;
+                cv.wait(ul, [&] { return go; });
+                ++woke;
+            });
+        }
+        for (;;) {
+            lock_guard<fast_mutex> lg(m);
+            if (waiting == 8) {
+                go = true;
+                break;
+            }
+        }
+        cv.notify_all();
+        for (auto& t : ts) t.join();
+        ASSERT_EQ(woke, 8);
+        ASSERT_TRUE(!m.is_locked());
+    }
+}
+
+void test_wait_for() {
+    printf("test_wait_for...\n");
+    fast_mutex m;
+    fast_condition_variable cv;
+    unique_lock<fast_mutex> ul(m);
+
+    auto t0 = std::chrono::steady_clock::now();
+    ASSERT_TRUE(!cv.wait_for(ul, 30, [] { return false; }));
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    ASSERT_TRUE(ms >= 29);
+    ASSERT_TRUE(ul.owns_lock());
+    ASSERT_TRUE(m.is_locked());
+
+    bool flag = false;
+    std::thread t([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        {
+            lock_guard<fast_mutex> lg(m);
+            flag = true;
+        }
+        cv.notify_one();
+    });
+    ASSERT_TRUE(cv.wait_for(ul, 5000, [&] { return flag; }));
+    ul.unlock();
+    t.join();
+
+    // 没有等待者时通知不做任何事
+    cv.notify_one();
+    cv.notify_all();
+}
+
+// ===========================================================================
+// spinlock / ticket_lock
+// ===========================================================================
+
+void test_spinlocks_oversubscribed() {
+    printf("test_spinlocks_oversubscribed...\n");
+    // 线程数远多于核数：持锁线程被换出时，等待者退避后让出 CPU，仍能完成
+    unsigned threads = std::thread::hardware_concurrency() * 4;
+    if (threads < 8) threads = 8;
+    spinlock sl;
+    ASSERT_EQ(hammer(sl, static_cast<int>(threads), 5000), static_cast<long>(threads) * 5000);
+    ASSERT_TRUE(!sl.is_locked());
+
+    ticket_lock tl;
+    ASSERT_EQ(hammer(tl, 4, 5000), 4L * 5000);
+    ASSERT_TRUE(tl.try_lock());
+    tl.unlock();
+}
+
+int main() {
+    printf("=== fast_mutex Tests ===\n\n");
+
+    test_fast_mutex_basic();
+    test_fast_mutex_contended();
+    test_producer_consumer();
+    test_notify_all();
+    test_wait_for();
+    test_spinlocks_oversubscribed();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,242 @@
+// test_flat_hash_map.cpp
+// 测试 flat_hash_map / flat_hash_set（开放寻址 + SIMD 分组探测）
+
+#include "../src/containers/associative/flat_hash_map.h"
+#include <stdio.h>
+#include <string>
+#include <memory>
+#include <stdexcept>
+#include <cassert>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+using namespace zen;
+
+// 自定义哈希：验证与 unordered_map 相同的 Hash 定制点
+struct str_hash {
+    size_t operator()(const std::string& s) const noexcept {
+        size_t h = static_cast<size_t>(14695981039346656037ULL);
+        for (char c : s) { h ^= static_cast<unsigned char>(c); h *= static_cast<size_t>(1099511628211ULL); }
+        return h;
+    }
+};
+
+// ===========================================================================
+// flat_hash_map 测试
+// ===========================================================================
+
+void test_flat_map_empty() {
+    printf("test_flat_map_empty...\n");
+    flat_hash_map<int, int> m;
+    ASSERT_TRUE(m.empty());
+    ASSERT_EQ(m.bucket_count(), 0u);
+    ASSERT_TRUE(m.begin() == m.end());
+    ASSERT_TRUE(m.find(1) == m.end());
+    ASSERT_EQ(m.erase(1), 0u);
+}
+
+void test_flat_map_insert_find() {
+    printf("test_flat_map_insert_find...\n");
+    flat_hash_map<int, std::string> m;
+
+    auto r1 = m.insert({1, std::string("one")});
+    ASSERT_TRUE(r1.second);
+    ASSERT_EQ(r1.first->second, "one");
+
+    auto r2 = m.insert({1, std::string("ONE")});
+    ASSERT_FALSE(r2.second);
+    ASSERT_EQ(r2.first->second, "one");
+
+    m[2] = "two";
+    ASSERT_EQ(m.size(), 2u);
+    ASSERT_EQ(m.at(2), "two");
+    ASSERT_TRUE(m.contains(1));
+    ASSERT_FALSE(m.contains(3));
+    ASSERT_EQ(m[3], "");
+    ASSERT_EQ(m.size(), 3u);
+}
+
+void test_flat_map_try_emplace() {
+    printf("test_flat_map_try_emplace...\n");
+    flat_hash_map<int, std::unique_ptr<int>> m;
+    std::unique_ptr<int> a(new int(1));
+    auto r1 = m.try_emplace(7, zen::move(a));
+    ASSERT_TRUE(r1.second);
+    ASSERT_TRUE(a == nullptr);
+    ASSERT_EQ(*r1.first->second, 1);
+
+    // 键已存在：只移动实参的 try_emplace 不得动它
+    std::unique_ptr<int> b(new int(2));
+    auto r2 = m.try_emplace(7, zen::move(b));
+    ASSERT_FALSE(r2.second);
+    ASSERT_TRUE(b != nullptr);
+    ASSERT_EQ(*b, 2);
+    ASSERT_EQ(*r2.first->second, 1);
+    ASSERT_EQ(m.size(), 1u);
+}
+
+void test_flat_map_grow() {
+    printf("test_flat_map_grow...\n");
+    flat_hash_map<int, int> m;
+    for (int i = 0; i < 100000; ++i) m[i] = i * 2;
+    ASSERT_EQ(m.size(), 100000u);
+    ASSERT_TRUE(m.load_factor() <= 0.875f);
+    for (int i = 0; i < 100000; ++i) {
+        auto it = m.find(i);
+        ASSERT_TRUE(it != m.end());
+        ASSERT_EQ(it->second, i * 2);
+    }
+    ASSERT_TRUE(m.find(-1) == m.end());
+}
+
+void test_flat_map_erase_backshift() {
+    printf("test_flat_map_erase_backshift...\n");
+    flat_hash_map<int, int> m;
+    for (int i = 0; i < 5000; ++i) m[i] = i;
+    // 删除偶数键，剩余键必须全部可查
+    for (int i = 0; i < 5000; i += 2) ASSERT_EQ(m.erase(i), 1u);
+    ASSERT_EQ(m.size(), 2500u);
+    for (int i = 0; i < 5000; ++i) ASSERT_EQ(m.contains(i), (i & 1) == 1);
+    // 再插回去，不应出现重复
+    for (int i = 0; i < 5000; i += 2) ASSERT_TRUE(m.insert({i, i}).second);
+    ASSERT_EQ(m.size(), 5000u);
+}
+
+void test_flat_map_erase_while_iterating() {
+    printf("test_flat_map_erase_while_iterating...\n");
+    flat_hash_map<int, int> m;
+    for (int i = 0; i < 3000; ++i) m[i] = i;
+    size_t visited = 0;
+    for (auto it = m.begin(); it != m.end(); ) {
+        ++visited;
+        if (it->first % 3 == 0) it = m.erase(it);
+        else ++it;
+    }
+    ASSERT_EQ(visited, 3000u);   // 每个元素恰好访问一次
+    ASSERT_EQ(m.size(), 2000u);
+    size_t n = 0;
+    for (auto& kv : m) { ASSERT_TRUE(kv.first % 3 != 0); ++n; }
+    ASSERT_EQ(n, 2000u);
+}
+
+void test_flat_map_copy_move() {
+    printf("test_flat_map_copy_move...\n");
+    flat_hash_map<std::string, int, str_hash> a;
+    for (int i = 0; i < 200; ++i) a[std::to_string(i)] = i;
+
+    flat_hash_map<std::string, int, str_hash> b(a);
+    ASSERT_EQ(b.size(), 200u);
+    ASSERT_EQ(b["150"], 150);
+
+    flat_hash_map<std::string, int, str_hash> c(zen::move(a));
+    ASSERT_EQ(c.size(), 200u);
+    ASSERT_TRUE(a.empty());
+    ASSERT_TRUE(a.find("1") == a.end());
+
+    a = c;
+    ASSERT_EQ(a.size(), 200u);
+    c.clear();
+    ASSERT_TRUE(c.empty());
+    ASSERT_TRUE(c.begin() == c.end());
+    ASSERT_EQ(a["7"], 7);
+}
+
+// 第 throw_at 次拷贝抛出异常，live 统计存活对象
+struct copy_bomb {
+    static int live;
+    static int copies;
+    static int throw_at;
+    int v;
+
+    explicit copy_bomb(int x) : v(x) { ++live; }
+    copy_bomb(const copy_bomb& o) : v(o.v) {
+        if (++copies == throw_at) throw std::runtime_error("copy_bomb");
+        ++live;
+    }
+    ~copy_bomb() { --live; }
+};
+int copy_bomb::live = 0;
+int copy_bomb::copies = 0;
+int copy_bomb::throw_at = 0;
+
+void test_flat_map_copy_throws() {
+    printf("test_flat_map_copy_throws...\n");
+    {
+        flat_hash_map<int, copy_bomb> a;
+        for (int i = 0; i < 100; ++i) a.try_emplace(i, i);
+        ASSERT_EQ(copy_bomb::live, 100);
+
+        copy_bomb::copies = 0;
+        copy_bomb::throw_at = 50;
+        bool threw = false;
+        try {
+            flat_hash_map<int, copy_bomb> b(a);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        ASSERT_TRUE(threw);
+        // 已拷贝的 49 个元素被析构（数组的释放由 ASan 检查）
+        ASSERT_EQ(copy_bomb::live, 100);
+        ASSERT_EQ(a.size(), 100u);
+        copy_bomb::throw_at = 0;
+    }
+    ASSERT_EQ(copy_bomb::live, 0);
+}
+
+void test_flat_map_reserve() {
+    printf("test_flat_map_reserve...\n");
+    flat_hash_map<int, int> m;
+    m.reserve(1000);
+    size_t bc = m.bucket_count();
+    ASSERT_TRUE(bc * 7 / 8 >= 1000);
+    for (int i = 0; i < 1000; ++i) m[i] = i;
+    ASSERT_EQ(m.bucket_count(), bc);
+}
+
+// ===========================================================================
+// flat_hash_set 测试
+// ===========================================================================
+
+void test_flat_set_basic() {
+    printf("test_flat_set_basic...\n");
+    flat_hash_set<std::string, str_hash> s;
+    ASSERT_TRUE(s.insert("a").second);
+    ASSERT_TRUE(s.insert("b").second);
+    ASSERT_FALSE(s.insert("a").second);
+    ASSERT_EQ(s.size(), 2u);
+    ASSERT_TRUE(s.contains("b"));
+    ASSERT_EQ(s.erase("a"), 1u);
+    ASSERT_FALSE(s.contains("a"));
+
+    size_t n = 0;
+    for (const auto& k : s) { ASSERT_EQ(k, "b"); ++n; }
+    ASSERT_EQ(n, 1u);
+}
+
+int main() {
+    printf("=== flat_hash_map / flat_hash_set Tests ===\n\n");
+
+    test_flat_map_empty();
+    test_flat_map_insert_find();
+    test_flat_map_try_emplace();
+    test_flat_map_grow();
+    test_flat_map_erase_backshift();
+    test_flat_map_erase_while_iterating();
+    test_flat_map_copy_move();
+    test_flat_map_copy_throws();
+    test_flat_map_reserve();
+
+    test_flat_set_basic();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
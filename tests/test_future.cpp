@@ -0,0 +1,425 @@
+// test_future.cpp
+// 测试 future / promise / shared_future（threading/future/future.h）：
+// 基本的设置与获取、异常、broken_promise、重复设置、超时等待；
+// then（按值 / 按 future 接收、异常跳过回调、链式、返回 future 时展开、执行器、
+// 已就绪时立即执行）、shared_future::then、make_ready_future、when_all、when_any；
+// 并发下 set_value 与挂回调 / 阻塞等待竞争时每个回调恰好执行一次；
+// 反复超时等待不再分配、多个线程共用等待者时都被唤醒
+
+#include "../src/threading/future/future.h"
+#include "../src/threading/pool/thread_pool.h"
+#include <stdio.h>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+
+using namespace zen;
+
+// 统计全局 operator new 次数，检查等待路径不再分配
+// （不内联，免得编译器把 new / free 配对误报为不匹配）
+static std::atomic<size_t> g_allocations{0};
+
+__attribute__((noinline)) void* operator new(std::size_t n) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+template<typename F>
+static bool throws_future_error(F&& f, std::future_errc code) {
+    try {
+        f();
+    } catch (const std::future_error& e) {
+        return e.code() == std::make_error_code(code);
+    }
+    return false;
+}
+
+// ===========================================================================
+// 基本功能
+// ===========================================================================
+
+void test_basic() {
+    printf("test_basic...\n");
+    promise<int> p;
+    future<int> f = p.get_future();
+    ASSERT_TRUE(f.valid());
+    ASSERT_TRUE(!f.is_ready());
+    ASSERT_TRUE(!f.wait_for(std::chrono::milliseconds(5)));
+    std::thread t([&p] { p.set_value(42); });
+    ASSERT_EQ(f.get(), 42);
+    t.join();
+
+    ASSERT_TRUE(throws_future_error([&p] { p.set_value(1); }, std::future_errc::promise_already_satisfied));
+    ASSERT_TRUE(throws_future_error([&p] { p.get_future(); }, std::future_errc::future_already_retrieved));
+
+    promise<std::string> q;
+    future<std::string> g = q.get_future();
+    q.set_exception(std::make_exception_ptr(std::runtime_error("bad")));
+    ASSERT_TRUE(g.is_ready());
+    bool caught = false;
+    try { g.get(); } catch (const std::runtime_error&) { caught = true; }
+    ASSERT_TRUE(caught);
+
+    future<int> broken;
+    {
+        promise<int> r;
+        broken = r.get_future();
+    }
+    ASSERT_TRUE(throws_future_error([&broken] { broken.get(); }, std::future_errc::broken_promise));
+
+    future<int> empty;
+    ASSERT_TRUE(!empty.valid());
+    ASSERT_TRUE(throws_future_error([&empty] { empty.get(); }, std::future_errc::no_state));
+
+    // shared_future：多个线程读同一结果
+    promise<int> s;
+    shared_future<int> sf = s.get_future().share();
+    std::vector<std::thread> readers;
+    std::atomic<int> sum{0};
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([sf, &sum] { sum.fetch_add(sf.get()); });
+    }
+    s.set_value(5);
+    for (auto& r : readers) r.join();
+    ASSERT_EQ(sum.load(), 20);
+
+    promise<void> v;
+    future<void> vf = v.get_future();
+    v.set_value();
+    vf.get();
+}
+
+// ===========================================================================
+// then
+// ===========================================================================
+
+void test_then() {
+    printf("test_then...\n");
+    // 按值接收，链式
+    promise<int> p;
+    future<std::string> f = p.get_future()
+        .then([](int x) { return x * 2; })
+        .then([](int x) { return std::to_string(x); });
+    p.set_value(21);
+    ASSERT_EQ(f.get(), std::string("42"));
+
+    // 按 future 接收：自己处理异常
+    promise<int> q;
+    future<int> recovered = q.get_future().then([](future<int> in) {
+        try {
+            return in.get();
+        } catch (const std::exception&) {
+            return -1;
+        }
+    });
+    q.set_exception(std::make_exception_ptr(std::runtime_error("x")));
+    ASSERT_EQ(recovered.get(), -1);
+
+    // 按值接收时异常跳过回调，直接传给结果
+    promise<int> e;
+    bool ran = false;
+    future<void> skipped = e.get_future().then([&ran](int) { ran = true; });
+    e.set_exception(std::make_exception_ptr(std::logic_error("y")));
+    bool caught = false;
+    try { skipped.get(); } catch (const std::logic_error&) { caught = true; }
+    ASSERT_TRUE(caught && !ran);
+
+    // 回调抛出
+    future<int> thrown = make_ready_future(1).then([](int) -> int { throw std::runtime_error("z"); });
+    caught = false;
+    try { thrown.get(); } catch (const std::runtime_error&) { caught = true; }
+    ASSERT_TRUE(caught);
+
+    // 已就绪：在当前线程立即执行
+    std::thread::id where;
+    future<void> now = make_ready_future().then([&where] { where = std::this_thread::get_id(); });
+    ASSERT_TRUE(now.is_ready());
+    ASSERT_TRUE(where == std::this_thread::get_id());
+
+    // 调用 then 后原 future 失效
+    promise<int> c;
+    future<int> consumed = c.get_future();
+    future<int> next = consumed.then([](int x) { return x; });
+    ASSERT_TRUE(!consumed.valid());
+    c.set_value(3);
+    ASSERT_EQ(next.get(), 3);
+}
+
+void test_then_executor() {
+    printf("test_then_executor...\n");
+    thread_pool pool(2);
+
+    promise<int> p;
+    future<bool> on_pool = p.get_future().then(pool, [&pool](int) { return pool.in_worker(); });
+    p.set_value(0);
+    ASSERT_TRUE(on_pool.get());
+
+    // 回调返回 future：展开
+    future<int> unwrapped = make_ready_future(10).then(pool, [&pool](int x) {
+        return pool.submit([x] { return x + 1; });
+    });
+    ASSERT_EQ(unwrapped.get(), 11);
+
+    future<void> unwrapped_void = make_ready_future().then([&pool] { return pool.submit([] {}); });
+    unwrapped_void.get();
+
+    // 池里的 future 继续挂 then，不阻塞任何线程
+    std::vector<future<int>> chain;
+    for (int i = 0; i < 100; ++i) {
+        chain.push_back(pool.submit([i] { return i; }).then(pool, [](int x) { return x * x; }));
+    }
+    long total = 0;
+    for (auto& f : chain) total += f.get();
+    ASSERT_EQ(total, 328350);
+
+    // 执行器拒绝任务：结果为 broken_promise
+    thread_pool stopped(1);
+    stopped.shutdown();
+    future<int> rejected = make_ready_future(1).then(stopped, [](int x) { return x; });
+    ASSERT_TRUE(throws_future_error([&rejected] { rejected.get(); }, std::future_errc::broken_promise));
+
+    // 可调用对象作执行器
+    int calls = 0;
+    auto counting = [&calls](auto&& fn) { ++calls; fn(); };
+    ASSERT_EQ(make_ready_future(2).then(counting, [](int x) { return x + 1; }).get(), 3);
+    ASSERT_EQ(calls, 1);
+}
+
+void test_shared_then() {
+    printf("test_shared_then...\n");
+    promise<int> p;
+    shared_future<int> sf = p.get_future().share();
+    future<int> a = sf.then([](const int& x) { return x + 1; });
+    future<int> b = sf.then([](shared_future<int> s) { return s.get() * 10; });
+    future<void> c = sf.then([](const int&) {});
+    ASSERT_TRUE(sf.valid());
+    p.set_value(4);
+    ASSERT_EQ(a.get(), 5);
+    ASSERT_EQ(b.get(), 40);
+    c.get();
+    ASSERT_EQ(sf.get(), 4);
+
+    promise<void> v;
+    shared_future<void> sv = v.get_future().share();
+    int hits = 0;
+    future<void> d = sv.then([&hits] { ++hits; });
+    future<void> e = sv.then([&hits] { ++hits; });
+    v.set_value();
+    d.get();
+    e.get();
+    ASSERT_EQ(hits, 2);
+}
+
+// ===========================================================================
+// 组合子
+// ===========================================================================
+
+void test_make_ready() {
+    printf("test_make_ready...\n");
+    future<int> f = make_ready_future(7);
+    ASSERT_TRUE(f.is_ready());
+    ASSERT_EQ(f.get(), 7);
+    future<std::unique_ptr<int>> m = make_ready_future(std::unique_ptr<int>(new int(3)));
+    ASSERT_EQ(*m.get(), 3);
+    future<int> x = make_exceptional_future<int>(std::make_exception_ptr(std::runtime_error("e")));
+    ASSERT_TRUE(x.is_ready());
+    bool caught = false;
+    try { x.get(); } catch (const std::runtime_error&) { caught = true; }
+    ASSERT_TRUE(caught);
+}
+
+void test_when_all() {
+    printf("test_when_all...\n");
+    promise<int> a;
+    promise<std::string> b;
+    promise<void> c;
+    auto all = when_all(a.get_future(), b.get_future(), c.get_future(), make_ready_future(1.5));
+    ASSERT_TRUE(!all.is_ready());
+    a.set_value(1);
+    b.set_value("two");
+    ASSERT_TRUE(!all.is_ready());
+    c.set_exception(std::make_exception_ptr(std::runtime_error("c")));
+    auto results = all.get();
+    ASSERT_EQ(std::get<0>(results).get(), 1);
+    ASSERT_EQ(std::get<1>(results).get(), std::string("two"));
+    bool caught = false;
+    try { std::get<2>(results).get(); } catch (const std::runtime_error&) { caught = true; }
+    ASSERT_TRUE(caught);
+    ASSERT_EQ(std::get<3>(results).get(), 1.5);
+
+    // 区间版本，输入来自线程池
+    thread_pool pool(3);
+    std::vector<future<int>> fs;
+    for (int i = 0; i < 50; ++i) fs.push_back(pool.submit([i] { return i; }));
+    future<std::vector<future<int>>> done = when_all(fs.begin(), fs.end());
+    int sum = 0;
+    for (auto& f : done.get()) sum += f.get();
+    ASSERT_EQ(sum, 1225);
+
+    // 组合后继续 then
+    std::vector<shared_future<int>> shared;
+    promise<int> p1, p2;
+    shared.push_back(p1.get_future().share());
+    shared.push_back(p2.get_future().share());
+    future<int> total = when_all(shared.begin(), shared.end())
+        .then([](std::vector<shared_future<int>> v) { return v[0].get() + v[1].get(); });
+    p2.set_value(20);
+    p1.set_value(22);
+    ASSERT_EQ(total.get(), 42);
+    ASSERT_EQ(shared[0].get(), 22);   // shared_future 拷贝进结果，原对象仍有效
+
+    std::vector<future<int>> none;
+    auto empty = when_all(none.begin(), none.end());
+    ASSERT_TRUE(empty.is_ready());
+    ASSERT_TRUE(empty.get().empty());
+    auto empty_tuple = when_all();
+    ASSERT_TRUE(empty_tuple.is_ready());
+}
+
+void test_when_any() {
+    printf("test_when_any...\n");
+    promise<int> a;
+    promise<int> b;
+    promise<int> c;
+    auto any = when_any(a.get_future(), b.get_future(), c.get_future());
+    ASSERT_TRUE(!any.is_ready());
+    b.set_value(2);
+    ASSERT_TRUE(any.is_ready());
+    a.set_value(1);
+    auto r = any.get();
+    ASSERT_EQ(r.index, 1u);
+    ASSERT_EQ(std::get<1>(r.futures).get(), 2);
+    ASSERT_EQ(std::get<0>(r.futures).get(), 1);
+    ASSERT_TRUE(!std::get<2>(r.futures).is_ready());
+    c.set_value(3);                       // 结果返回后才就绪的输入仍可使用
+    ASSERT_EQ(std::get<2>(r.futures).get(), 3);
+
+    // 区间版本：已就绪的输入立即胜出
+    std::vector<future<int>> fs;
+    promise<int> slow;
+    fs.push_back(slow.get_future());
+    fs.push_back(make_ready_future(9));
+    auto first = when_any(fs.begin(), fs.end()).get();
+    ASSERT_EQ(first.index, 1u);
+    ASSERT_EQ(first.futures[1].get(), 9);
+    slow.set_value(0);
+
+    std::vector<future<int>> none;
+    auto empty = when_any(none.begin(), none.end()).get();
+    ASSERT_EQ(empty.index, static_cast<size_t>(-1));
+    ASSERT_TRUE(empty.futures.empty());
+}
+
+// ===========================================================================
+// 并发
+// ===========================================================================
+
+void test_concurrent_completion() {
+    printf("test_concurrent_completion...\n");
+    // 挂回调、阻塞等待、超时等待与 set_value 竞争
+    const int rounds = 20000;
+    std::atomic<int> fired{0};
+    for (int i = 0; i < rounds; ++i) {
+        promise<int> p;
+        shared_future<int> sf = p.get_future().share();
+        std::thread setter([&p, i] { p.set_value(i); });
+        future<int> a = sf.then([&fired](const int& x) { fired.fetch_add(1); return x; });
+        sf.wait_for(std::chrono::milliseconds(0));
+        future<int> b = sf.then([&fired](const int& x) { fired.fetch_add(1); return x; });
+        ASSERT_EQ(a.get(), i);
+        ASSERT_EQ(b.get(), i);
+        setter.join();
+    }
+    ASSERT_EQ(fired.load(), 2 * rounds);
+
+    // 很多 future 在多个线程上完成，when_all 汇总
+    thread_pool pool(4);
+    std::vector<promise<int>> ps(1000);
+    std::vector<future<int>> fs;
+    for (auto& p : ps) fs.push_back(p.get_future().then(pool, [](int x) { return x + 1; }));
+    auto all = when_all(fs.begin(), fs.end());
+    std::vector<std::thread> setters;
+    for (int t = 0; t < 4; ++t) {
+        setters.emplace_back([&ps, t] {
+            for (size_t i = t; i < ps.size(); i += 4) ps[i].set_value(static_cast<int>(i));
+        });
+    }
+    for (auto& s : setters) s.join();
+    long sum = 0;
+    for (auto& f : all.get()) sum += f.get();
+    ASSERT_EQ(sum, 1000L * 1001 / 2);
+}
+
+void test_timed_wait_reuses_waiter() {
+    printf("test_timed_wait_reuses_waiter...\n");
+    promise<int> p;
+    shared_future<int> sf = p.get_future().share();
+
+    // 零超时只检查就绪，不分配
+    size_t before = g_allocations.load();
+    for (int i = 0; i < 100000; ++i) ASSERT_TRUE(!sf.wait_for(std::chrono::milliseconds(0)));
+    ASSERT_EQ(g_allocations.load(), before);
+
+    // 第一次真正等待创建等待者，之后超时返回再等都复用
+    ASSERT_TRUE(!sf.wait_for(std::chrono::milliseconds(1)));
+    before = g_allocations.load();
+    for (int i = 0; i < 20; ++i) ASSERT_TRUE(!sf.wait_for(std::chrono::milliseconds(1)));
+    ASSERT_EQ(g_allocations.load(), before);
+
+    // 多个线程共用同一个等待者，set_value 全部唤醒
+    std::atomic<int> woken{0};
+    std::vector<std::thread> waiters;
+    for (int t = 0; t < 4; ++t) {
+        waiters.emplace_back([&sf, &woken, t] {
+            if (t % 2) {
+                sf.wait();
+            } else {
+                while (!sf.wait_for(std::chrono::milliseconds(2))) {}
+            }
+            woken.fetch_add(1);
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    p.set_value(7);
+    for (auto& w : waiters) w.join();
+    ASSERT_EQ(woken.load(), 4);
+    ASSERT_TRUE(sf.wait_for(std::chrono::milliseconds(0)));
+    ASSERT_EQ(sf.get(), 7);
+}
+
+int main() {
+    printf("=== future Tests ===\n\n");
+
+    test_basic();
+    test_then();
+    test_then_executor();
+    test_shared_then();
+    test_make_ready();
+    test_when_all();
+    test_when_any();
+    test_concurrent_completion();
+    test_timed_wait_reuses_waiter();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,104 @@
+// test_hash.cpp
+// 测试哈希子系统（hash_mix / hash_bytes / hash<T> / 透明查找）
+
+#include "../src/utility/hash.h"
+#include "../src/containers/associative/unordered_map.h"
+#include "../src/containers/associative/flat_hash_map.h"
+#include <stdio.h>
+#include <string>
+#include <cassert>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+using namespace zen;
+
+void test_hash_integral() {
+    printf("test_hash_integral...\n");
+    hash<int> h;
+    ASSERT_EQ(h(42), h(42));
+    ASSERT_NE(h(1), h(2));
+    // 相邻整数的低 4 位不应总是相同（混合后分布均匀）
+    int same = 0;
+    for (int i = 0; i < 256; ++i) same += ((h(i) & 0xF) == (h(i + 1) & 0xF)) ? 1 : 0;
+    ASSERT_TRUE(same < 64);
+
+    hash<double> hd;
+    ASSERT_EQ(hd(0.0), hd(-0.0));
+    ASSERT_NE(hd(1.0), hd(2.0));
+
+    int a = 0, b = 0;
+    hash<int*> hp;
+    ASSERT_NE(hp(&a), hp(&b));
+}
+
+void test_hash_bytes() {
+    printf("test_hash_bytes...\n");
+    // 覆盖所有长度分支：0、1~3、4~16、17~48、>48
+    char buf[200];
+    for (int i = 0; i < 200; ++i) buf[i] = static_cast<char>(i * 7 + 1);
+    for (size_t len = 0; len < 200; ++len) {
+        uint64_t h1 = hash_bytes(buf, len);
+        ASSERT_EQ(h1, hash_bytes(buf, len));
+        if (len > 0) {
+            // 改变任意一个字节都应改变结果
+            buf[len / 2] ^= 1;
+            ASSERT_NE(h1, hash_bytes(buf, len));
+            buf[len / 2] ^= 1;
+            // 长度不同结果不同
+            ASSERT_NE(h1, hash_bytes(buf, len - 1));
+        }
+    }
+    ASSERT_NE(hash_bytes(buf, 16, 1), hash_bytes(buf, 16, 2));
+}
+
+void test_hash_string() {
+    printf("test_hash_string...\n");
+    std::string s = "session:12345";
+    string_view sv(s.data(), s.size());
+    ASSERT_EQ(hash<std::string>{}(s), hash<string_view>{}(sv));
+    ASSERT_EQ(hash<std::string>{}(s), hash<std::string>{}("session:12345"));
+    ASSERT_TRUE(equal_to<std::string>{}(s, sv));
+    ASSERT_FALSE(equal_to<std::string>{}(s, string_view("session:1234")));
+    ASSERT_EQ(fnv1a_bytes(reinterpret_cast<const unsigned char*>("a"), 1), 0xaf63dc4c8601ec8cULL);
+}
+
+void test_transparent_lookup() {
+    printf("test_transparent_lookup...\n");
+    unordered_map<std::string, int> um;
+    um["alpha"] = 1;
+    um["beta"]  = 2;
+    ASSERT_TRUE(um.find(string_view("alpha")) != um.end());
+    ASSERT_EQ(um.find(string_view("beta"))->second, 2);
+    ASSERT_TRUE(um.contains("beta"));
+    ASSERT_FALSE(um.contains(string_view("gamma")));
+
+    flat_hash_map<std::string, int> fm;
+    fm["alpha"] = 1;
+    fm["beta"]  = 2;
+    ASSERT_EQ(fm.find(string_view("alpha"))->second, 1);
+    ASSERT_EQ(fm.count("beta"), 1u);
+    ASSERT_EQ(fm.erase(string_view("alpha")), 1u);
+    ASSERT_FALSE(fm.contains("alpha"));
+    ASSERT_EQ(fm.size(), 1u);
+}
+
+int main() {
+    printf("=== hash Tests ===\n\n");
+
+    test_hash_integral();
+    test_hash_bytes();
+    test_hash_string();
+    test_transparent_lookup();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
@@ -53,6 +53,8 @@ static bool g_current_failed = false;
 #include "src/timer/timer.h"
 #include "src/timer/timer_queue.h"
 #include "src/timer/timer_manager.h"
+#include "src/event/event_loop.h"
+#include <string>
 
 // ============================================================================
 // ---- logging/log_level -----
@@ -522,6 +524,89 @@ TEST(test_timer_manager_cancel_before_fire) {
     ASSERT_EQ(fired, 0);
 }
 
+struct self_cancel_ctx {
+    zen::timer_manager* tm;
+    zen::timer_id       id;
+    int                 fired;
+};
+
+TEST(test_timer_manager_repeat_cancel_self) {
+    // 重复定时器在回调内取消自己：不再重新入队
+    zen::timer_manager tm;
+    self_cancel_ctx ctx = { &tm, zen::INVALID_TIMER_ID, 0 };
+    ctx.id = tm.add_repeat(10, [](zen::timer_id id, void* p) {
+        auto* c = static_cast<self_cancel_ctx*>(p);
+        ++c->fired;
+        ASSERT_TRUE(c->tm->cancel(id));
+    }, &ctx);
+    ASSERT_NE(ctx.id, zen::INVALID_TIMER_ID);
+
+    tm.tick_until_empty(5, 2000);
+    ASSERT_EQ(ctx.fired, 1);
+    ASSERT_TRUE(tm.empty());
+}
+
+struct cancel_other_ctx {
+    zen::timer_manager* tm;
+    zen::timer_id       other;
+    bool                cancelled;
+};
+
+static void count_cb(zen::timer_id, void* p) { ++(*static_cast<int*>(p)); }
+
+TEST(test_timer_manager_repeat_cancel_other_in_batch) {
+    // A 在回调内取消同一批到期的重复定时器 B：B 不再重新入队
+    zen::timer_manager tm;
+    int b_fired = 0;
+    cancel_other_ctx ctx = { &tm, zen::INVALID_TIMER_ID, false };
+    zen::timer_id a = tm.add_repeat(5, [](zen::timer_id id, void* p) {
+        auto* c = static_cast<cancel_other_ctx*>(p);
+        c->cancelled = c->tm->cancel(c->other);
+        c->tm->cancel(id);
+    }, &ctx);
+    ctx.other = tm.add_repeat(10, count_cb, &b_fired);
+    ASSERT_NE(a, zen::INVALID_TIMER_ID);
+    ASSERT_NE(ctx.other, zen::INVALID_TIMER_ID);
+
+    zen::this_thread::sleep_for(20);   // A、B 在同一次 tick 中到期
+    tm.tick();
+    ASSERT_TRUE(ctx.cancelled);
+    tm.tick_until_empty(5, 200);
+    ASSERT_TRUE(tm.empty());
+    ASSERT_EQ(tm.pending_count(), 0);
+}
+
+TEST(test_timer_manager_more_than_batch_due) {
+    // 一次 tick 中到期的定时器多于单批容量：全部触发，不丢失
+    zen::timer_manager tm;
+    int fired = 0;
+    for (int i = 0; i < 100; ++i) tm.add_once(1, count_cb, &fired);
+    zen::this_thread::sleep_for(10);
+    ASSERT_EQ(tm.tick(), 100);
+    ASSERT_EQ(fired, 100);
+    ASSERT_TRUE(tm.empty());
+}
+
+TEST(test_event_loop_repeat_timer_cancel_self) {
+    // 回调在执行中取消自己：捕获的状态在回调返回前仍然有效
+    zen::event_loop loop;
+    std::string tag(64, 'x');
+    int fired = 0;
+    size_t seen = 0;
+    zen::timer_id id = zen::INVALID_TIMER_ID;
+    id = loop.add_repeat_timer(5, [&loop, &id, &fired, &seen, tag]() {
+        if (++fired == 3) {
+            loop.cancel_timer(id);
+        }
+        seen += tag.size();
+    });
+    ASSERT_NE(id, zen::INVALID_TIMER_ID);
+    loop.add_timer(80, [&loop]() { loop.stop(); });
+    loop.run();
+    ASSERT_EQ(fired, 3);
+    ASSERT_EQ(seen, 3u * 64u);
+}
+
 TEST(test_timer_manager_tick_until_empty) {
     int count = 0;
     auto cb = [](zen::timer_id, void* p){ ++(*static_cast<int*>(p)); };
@@ -0,0 +1,260 @@
+// test_map_node_pool.cpp
+// 测试红黑树容器的节点池、节点句柄（extract / insert(node_type&&)）与 multimap / multiset
+
+#include "../src/containers/associative/map.h"
+#include "../src/memory/node_pool.h"
+#include <stdio.h>
+#include <string>
+#include <cassert>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+using namespace zen;
+
+// ===========================================================================
+// node_pool 测试
+// ===========================================================================
+
+void test_node_pool_reuse() {
+    printf("test_node_pool_reuse...\n");
+    node_pool<long>* p = node_pool<long>::create();
+    long* a = p->allocate();
+    long* b = p->allocate();
+    ASSERT_NE(a, b);
+    ASSERT_EQ(p->capacity(), 16u);
+    p->deallocate(a);
+    ASSERT_EQ(p->allocate(), a);   // 空闲列表优先复用
+
+    for (int i = 0; i < 100; ++i) p->allocate();
+    ASSERT_TRUE(p->capacity() >= 102u);
+    p->release_all();
+    ASSERT_EQ(p->capacity(), 0u);
+    node_pool<long>::unref(p);
+}
+
+// ===========================================================================
+// map + 节点池
+// ===========================================================================
+
+void test_map_insert_erase_clear() {
+    printf("test_map_insert_erase_clear...\n");
+    map<int, std::string> m;
+    for (int i = 0; i < 2000; ++i) m[i] = std::to_string(i);
+    ASSERT_EQ(m.size(), 2000u);
+    for (int i = 0; i < 2000; i += 2) ASSERT_EQ(m.erase(i), 1u);
+    ASSERT_EQ(m.size(), 1000u);
+    // 重新插入会复用空闲节点
+    for (int i = 0; i < 2000; i += 2) ASSERT_TRUE(m.insert({i, std::string("x")}).second);
+    ASSERT_EQ(m.size(), 2000u);
+    int prev = -1;
+    for (auto& kv : m) { ASSERT_TRUE(kv.first > prev); prev = kv.first; }
+
+    m.clear();
+    ASSERT_TRUE(m.empty());
+    ASSERT_TRUE(m.begin() == m.end());
+    m[5] = "five";                  // clear 之后仍可继续使用
+    ASSERT_EQ(m.at(5), "five");
+
+    map<int, std::string> c(m);
+    map<int, std::string> d(zen::move(m));
+    ASSERT_EQ(c.size(), 1u);
+    ASSERT_EQ(d.size(), 1u);
+    ASSERT_TRUE(m.empty());
+    m[1] = "one";
+    ASSERT_EQ(m.size(), 1u);
+}
+
+void test_map_extract_reinsert() {
+    printf("test_map_extract_reinsert...\n");
+    map<int, std::string> m;
+    m[1] = "one";
+    m[2] = "two";
+
+    auto nh = m.extract(1);
+    ASSERT_FALSE(nh.empty());
+    ASSERT_EQ(m.size(), 1u);
+    ASSERT_FALSE(m.contains(1));
+    const std::string* addr = &nh.mapped();
+
+    nh.key() = 10;                  // 句柄中改键
+    auto r = m.insert(zen::move(nh));
+    ASSERT_TRUE(r.inserted);
+    ASSERT_TRUE(r.node.empty());
+    ASSERT_EQ(r.position->first, 10);
+    ASSERT_EQ(&r.position->second, addr);   // 同一节点，无复制
+
+    ASSERT_TRUE(m.extract(42).empty());
+}
+
+void test_map_insert_duplicate_handle() {
+    printf("test_map_insert_duplicate_handle...\n");
+    map<int, int> m;
+    m[1] = 1;
+    m[2] = 2;
+    auto nh = m.extract(m.find(2));
+    nh.key() = 1;
+    auto r = m.insert(zen::move(nh));
+    ASSERT_FALSE(r.inserted);
+    ASSERT_FALSE(r.node.empty());    // 键冲突：句柄退回
+    ASSERT_EQ(r.node.mapped(), 2);
+    ASSERT_EQ(r.position->second, 1);
+    ASSERT_EQ(m.size(), 1u);
+}
+
+void test_map_handle_outlives_map() {
+    printf("test_map_handle_outlives_map...\n");
+    map<int, std::string>::node_type nh;
+    {
+        map<int, std::string> m;
+        for (int i = 0; i < 100; ++i) m[i] = std::string(32, 'a' + i % 26);
+        nh = m.extract(50);
+    }   // 容器析构，句柄仍持有节点池引用
+    ASSERT_EQ(nh.key(), 50);
+    ASSERT_EQ(nh.mapped(), std::string(32, 'a' + 50 % 26));
+
+    map<int, std::string> other;
+    other[1] = "one";
+    const std::string* addr = &nh.mapped();
+    auto r = other.insert(zen::move(nh));   // 跨容器：节点直接挂链，other 的节点池接收原池
+    ASSERT_TRUE(r.inserted);
+    ASSERT_EQ(&r.position->second, addr);
+    ASSERT_EQ(other.size(), 2u);
+    ASSERT_EQ(other.at(50), std::string(32, 'a' + 50 % 26));
+    other.erase(50);                        // 被接收的节点进入 other 的空闲列表
+    other[51] = "fifty-one";
+    ASSERT_EQ(other.size(), 2u);
+}
+
+void test_map_insert_duplicate_handle_across_maps() {
+    printf("test_map_insert_duplicate_handle_across_maps...\n");
+    map<std::string, std::string> a, b;
+    a["k"] = "from-a";
+    b["k"] = "from-b";
+    auto nh = a.extract("k");
+    auto r = b.insert(zen::move(nh));
+    ASSERT_FALSE(r.inserted);
+    ASSERT_FALSE(r.node.empty());     // 键冲突：元素不被移走
+    ASSERT_EQ(r.node.key(), "k");
+    ASSERT_EQ(r.node.mapped(), "from-a");
+    ASSERT_EQ(r.position->second, "from-b");
+    ASSERT_EQ(b.size(), 1u);
+
+    // 退回的句柄可以再插回原容器
+    ASSERT_TRUE(a.insert(zen::move(r.node)).inserted);
+    ASSERT_EQ(a.at("k"), "from-a");
+}
+
+void test_map_adopted_nodes_outlive_source() {
+    printf("test_map_adopted_nodes_outlive_source...\n");
+    map<int, std::string> dst;
+    for (int round = 0; round < 4; ++round) {
+        map<int, std::string> src;
+        for (int i = 0; i < 40; ++i) src[round * 100 + i] = std::to_string(round * 100 + i);
+        for (int i = 0; i < 40; i += 2) dst.insert(src.extract(round * 100 + i));
+        src.clear();
+    }   // 来源容器析构，被接收的节点仍有效
+    ASSERT_EQ(dst.size(), 80u);
+    for (int round = 0; round < 4; ++round) {
+        for (int i = 0; i < 40; i += 2) ASSERT_EQ(dst.at(round * 100 + i), std::to_string(round * 100 + i));
+    }
+    dst.clear();
+    ASSERT_TRUE(dst.empty());
+}
+
+void test_map_clear_with_outstanding_handle() {
+    printf("test_map_clear_with_outstanding_handle...\n");
+    map<int, std::string> m;
+    for (int i = 0; i < 50; ++i) m[i] = std::to_string(i);
+    auto nh = m.extract(7);
+    m.clear();                      // 句柄未归还：逐个释放，不能整块释放
+    ASSERT_EQ(nh.mapped(), "7");
+    m[1] = "one";
+    m.insert(zen::move(nh));
+    ASSERT_EQ(m.size(), 2u);
+    ASSERT_EQ(m.at(7), "7");
+}
+
+// ===========================================================================
+// multimap / multiset / set
+// ===========================================================================
+
+void test_multimap() {
+    printf("test_multimap...\n");
+    multimap<int, int> mm;
+    mm.insert({1, 10});
+    mm.insert({2, 20});
+    mm.insert({1, 11});
+    mm.emplace(1, 12);
+    ASSERT_EQ(mm.size(), 4u);
+    ASSERT_EQ(mm.count(1), 3u);
+
+    // 等价键保持插入顺序
+    auto range = mm.equal_range(1);
+    int expect = 10;
+    for (auto it = range.first; it != range.second; ++it) ASSERT_EQ(it->second, expect++);
+
+    auto nh = mm.extract(mm.find(2));
+    nh.key() = 1;
+    mm.insert(zen::move(nh));
+    ASSERT_EQ(mm.count(1), 4u);
+
+    ASSERT_EQ(mm.erase(1), 4u);
+    ASSERT_TRUE(mm.empty());
+}
+
+void test_multiset_and_set() {
+    printf("test_multiset_and_set...\n");
+    multiset<int> ms;
+    for (int i = 0; i < 10; ++i) ms.insert(i % 3);
+    ASSERT_EQ(ms.size(), 10u);
+    ASSERT_EQ(ms.count(0), 4u);
+    ASSERT_EQ(ms.erase(0), 4u);
+    ASSERT_EQ(ms.size(), 6u);
+
+    set<int> s;
+    s.insert(3);
+    s.insert(4);
+    auto nh = s.extract(3);
+    nh.key() = 5;
+    ASSERT_TRUE(s.insert(zen::move(nh)).inserted);
+    ASSERT_TRUE(s.contains(5));
+    ASSERT_FALSE(s.contains(3));
+
+    nh = s.extract(4);
+    nh.key() = 5;
+    auto r = s.insert(zen::move(nh));
+    ASSERT_FALSE(r.inserted);
+    ASSERT_EQ(r.position->first, 5);
+    ASSERT_FALSE(r.node.empty());
+    ASSERT_EQ(r.node.key(), 5);
+    ASSERT_EQ(s.size(), 1u);
+}
+
+int main() {
+    printf("=== map node pool / node handle Tests ===\n\n");
+
+    test_node_pool_reuse();
+
+    test_map_insert_erase_clear();
+    test_map_extract_reinsert();
+    test_map_insert_duplicate_handle();
+    test_map_handle_outlives_map();
+    test_map_insert_duplicate_handle_across_maps();
+    test_map_adopted_nodes_outlive_source();
+    test_map_clear_with_outstanding_handle();
+
+    test_multimap();
+    test_multiset_and_set();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
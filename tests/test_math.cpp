@@ -9,6 +9,8 @@
 #include "src/fmt/print.h"
 #include <iostream>
 #include <cassert>
+#include <limits>
+#include <vector>
 
 int passed = 0;
 int failed = 0;
@@ -196,6 +198,25 @@ TEST(test_minmax_range) {
     ASSERT_EQ(zen::range(arr), 8);
 }
 
+TEST(test_float_stats) {
+    // float / double 走向量内核：单遍 moments、NaN 被 min / max 忽略
+    double arr[] = {2, 4, 4, 4, 5, 5, 7, 9};
+    ASSERT_EQ(zen::sum(arr), 40.0);
+    ASSERT_TRUE(zen::abs(zen::population_variance(arr) - 4.0) < 1e-12);
+    ASSERT_TRUE(zen::abs(zen::variance(arr) - 32.0 / 7.0) < 1e-12);
+    ASSERT_EQ(zen::min_value(arr), 2.0);
+    ASSERT_EQ(zen::max_value(arr), 9.0);
+
+    std::vector<double> big(100000);
+    for (size_t i = 0; i < big.size(); ++i) big[i] = 1e9 + (i % 2 ? 0.5 : -0.5);
+    ASSERT_TRUE(zen::abs(zen::population_variance(big) - 0.25) < 1e-9);
+    ASSERT_TRUE(zen::abs(zen::sum(big) - 1e14) < 1e-2);
+
+    float f[] = {1.5f, std::numeric_limits<float>::quiet_NaN(), -3.0f, 8.0f};
+    ASSERT_EQ(zen::min_value(f), -3.0f);
+    ASSERT_EQ(zen::max_value(f), 8.0f);
+}
+
 TEST(test_correlation) {
     // 完全正相关
     double x[] = {1, 2, 3, 4, 5};
@@ -235,6 +256,7 @@ int main() {
     RUN_TEST(test_variance_stddev);
     RUN_TEST(test_median);
     RUN_TEST(test_minmax_range);
+    RUN_TEST(test_float_stats);
     RUN_TEST(test_correlation);
     
     std::cout << "\n=== Results ===\n";
@@ -0,0 +1,251 @@
+// test_memory_resource.cpp
+// 测试内存子系统：monotonic_arena / pool_resource / arena_allocator 与各容器的配合
+
+#include "../src/memory/memory.h"
+#include "../src/containers/sequential/vector.h"
+#include "../src/containers/sequential/list.h"
+#include "../src/containers/associative/map.h"
+#include "../src/containers/associative/unordered_map.h"
+#include "../src/containers/associative/flat_hash_map.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+#include <cassert>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+using namespace zen;
+
+// 统计上游调用次数的资源
+class counting_resource : public memory_resource {
+public:
+    size_t allocs = 0, deallocs = 0, live_bytes = 0;
+
+protected:
+    void* do_allocate(size_t bytes, size_t align) override {
+        ++allocs;
+        live_bytes += bytes;
+        return new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        ++deallocs;
+        live_bytes -= bytes;
+        new_delete_resource()->deallocate(p, bytes, align);
+    }
+};
+
+static bool aligned(void* p, size_t a) { return (reinterpret_cast<uintptr_t>(p) & (a - 1)) == 0; }
+
+// ===========================================================================
+// monotonic_arena 测试
+// ===========================================================================
+
+void test_arena_bump_and_align() {
+    printf("test_arena_bump_and_align...\n");
+    counting_resource up;
+    {
+        monotonic_arena arena(1024, &up);
+        char* a = static_cast<char*>(arena.allocate(3, 1));
+        char* b = static_cast<char*>(arena.allocate(8, 8));
+        ASSERT_TRUE(aligned(b, 8));
+        ASSERT_TRUE(b >= a + 3);
+        void* c = arena.allocate(64, 64);
+        ASSERT_TRUE(aligned(c, 64));
+        ASSERT_EQ(up.allocs, 1u);
+
+        // 超过当前块：申请新块；超大请求单独成块
+        for (int i = 0; i < 100; ++i) arena.allocate(100);
+        void* big = arena.allocate(1 << 20);
+        ASSERT_TRUE(big != nullptr);
+        ASSERT_TRUE(up.allocs > 1);
+        ASSERT_EQ(arena.reserved_bytes(), up.live_bytes);
+    }
+    ASSERT_EQ(up.allocs, up.deallocs);
+    ASSERT_EQ(up.live_bytes, 0u);
+}
+
+void test_arena_reset_reuses_blocks() {
+    printf("test_arena_reset_reuses_blocks...\n");
+    counting_resource up;
+    monotonic_arena arena(256, &up);
+    for (int i = 0; i < 200; ++i) arena.allocate(48);
+    size_t blocks = up.allocs;
+    void* first = nullptr;
+
+    arena.reset();
+    ASSERT_EQ(arena.allocated_bytes(), 0u);
+    first = arena.allocate(48);
+    for (int i = 1; i < 200; ++i) arena.allocate(48);
+    ASSERT_EQ(up.allocs, blocks);           // reset 后复用原有块，不再向上游申请
+
+    arena.reset();
+    ASSERT_EQ(arena.allocate(48), first);   // 从第一块起点重新分配
+
+    arena.release();
+    ASSERT_EQ(up.live_bytes, 0u);
+}
+
+void test_arena_last_alloc_rollback() {
+    printf("test_arena_last_alloc_rollback...\n");
+    monotonic_arena arena;
+    void* a = arena.allocate(32);
+    arena.deallocate(a, 32);
+    ASSERT_EQ(arena.allocate(32), a);       // 最后一次分配被回收
+    void* b = arena.allocate(16);
+    arena.deallocate(a, 32);                // 不是最后一次：忽略
+    ASSERT_NE(arena.allocate(16), b);
+}
+
+void test_arena_initial_buffer() {
+    printf("test_arena_initial_buffer...\n");
+    counting_resource up;
+    alignas(16) char buf[1024];
+    monotonic_arena arena(buf, sizeof(buf), &up);
+    char* p = static_cast<char*>(arena.allocate(100));
+    ASSERT_TRUE(p >= buf && p < buf + sizeof(buf));
+    ASSERT_EQ(up.allocs, 0u);
+    arena.allocate(2000);
+    ASSERT_EQ(up.allocs, 1u);
+    arena.release();
+    ASSERT_EQ(up.live_bytes, 0u);
+    ASSERT_EQ(arena.allocate(100), p);      // 用户缓冲区在 release 后仍可用
+}
+
+// ===========================================================================
+// pool_resource 测试
+// ===========================================================================
+
+void test_pool_size_classes() {
+    printf("test_pool_size_classes...\n");
+    counting_resource up;
+    {
+        pool_resource pool(&up);
+        void* a = pool.allocate(24);
+        void* b = pool.allocate(24);
+        ASSERT_NE(a, b);
+        ASSERT_TRUE(aligned(a, 16));
+        pool.deallocate(a, 24);
+        ASSERT_EQ(pool.allocate(20), a);    // 同一级别（32）复用
+
+        size_t before = up.allocs;
+        void* big = pool.allocate(100000);  // 超过最大级别：直通上游
+        ASSERT_EQ(up.allocs, before + 1);
+        pool.deallocate(big, 100000);
+        ASSERT_EQ(up.deallocs, 1u);
+
+        // 大量小对象：slab 批量申请
+        void* ptrs[1000];
+        for (int i = 0; i < 1000; ++i) ptrs[i] = pool.allocate(64);
+        ASSERT_TRUE(up.allocs < 20u);
+        for (int i = 0; i < 1000; ++i) pool.deallocate(ptrs[i], 64);
+        size_t slabs = up.allocs;
+        for (int i = 0; i < 1000; ++i) ptrs[i] = pool.allocate(64);
+        ASSERT_EQ(up.allocs, slabs);
+    }
+    ASSERT_EQ(up.live_bytes, 0u);
+}
+
+void test_pool_over_arena() {
+    printf("test_pool_over_arena...\n");
+    counting_resource up;
+    monotonic_arena arena(4096, &up);
+    pool_resource pool(&arena);
+    for (int round = 0; round < 3; ++round) {
+        void* ptrs[256];
+        for (int i = 0; i < 256; ++i) ptrs[i] = pool.allocate(static_cast<size_t>(8 + i % 100));
+        for (int i = 0; i < 256; ++i) pool.deallocate(ptrs[i], static_cast<size_t>(8 + i % 100));
+    }
+    pool.release();
+    arena.reset();
+    ASSERT_TRUE(up.allocs > 0);
+}
+
+// ===========================================================================
+// arena_allocator + 容器
+// ===========================================================================
+
+void test_arena_allocator_containers() {
+    printf("test_arena_allocator_containers...\n");
+    counting_resource up;
+    monotonic_arena arena(4096, &up);
+    {
+        arena_allocator<int> a(&arena);
+
+        vector<int, arena_allocator<int>> v(a);
+        for (int i = 0; i < 1000; ++i) v.push_back(i);
+        ASSERT_EQ(v[999], 999);
+
+        list<int, arena_allocator<int>> l(a);
+        for (int i = 0; i < 100; ++i) l.push_back(i);
+        ASSERT_EQ(l.size(), 100u);
+
+        using kv_alloc = arena_allocator<pair<const int, std::string>>;
+        map<int, std::string, less<int>, kv_alloc> m{kv_alloc(&arena)};
+        for (int i = 0; i < 100; ++i) m[i] = std::to_string(i);
+        ASSERT_EQ(m.at(42), "42");
+        map<int, std::string, less<int>, kv_alloc> m2(m);     // 拷贝沿用同一 arena
+        ASSERT_EQ(m2.size(), 100u);
+
+        unordered_map<int, int, hash<int>, equal_to<int>, arena_allocator<pair<const int, int>>> um(&arena);
+        for (int i = 0; i < 1000; ++i) um[i] = i * 2;
+        ASSERT_EQ(um[500], 1000);
+
+        flat_hash_map<int, int, hash<int>, equal_to<int>, arena_allocator<pair<const int, int>>> fm(&arena);
+        for (int i = 0; i < 1000; ++i) fm[i] = i;
+        ASSERT_EQ(fm.size(), 1000u);
+
+        set<int, less<int>, arena_allocator<int>> s(a);
+        s.insert(1);
+        ASSERT_TRUE(s.contains(1));
+
+        ASSERT_TRUE(arena.allocated_bytes() > 0);
+    }
+    size_t blocks = up.allocs;
+    arena.reset();
+
+    // 第二个"请求"复用同一批块
+    {
+        vector<int, arena_allocator<int>> v(&arena);
+        for (int i = 0; i < 1000; ++i) v.push_back(i);
+    }
+    ASSERT_EQ(up.allocs, blocks);
+}
+
+void test_arena_allocator_equality() {
+    printf("test_arena_allocator_equality...\n");
+    monotonic_arena a1, a2;
+    arena_allocator<int> x(&a1), y(&a1), z(&a2);
+    arena_allocator<double> w(x);
+    ASSERT_TRUE(x == y);
+    ASSERT_TRUE(x != z);
+    ASSERT_TRUE(w == x);
+    ASSERT_EQ(w.resource(), &a1);
+    ASSERT_EQ(arena_allocator<int>().resource(), new_delete_resource());
+}
+
+int main() {
+    printf("=== memory resource Tests ===\n\n");
+
+    test_arena_bump_and_align();
+    test_arena_reset_reuses_blocks();
+    test_arena_last_alloc_rollback();
+    test_arena_initial_buffer();
+
+    test_pool_size_classes();
+    test_pool_over_arena();
+
+    test_arena_allocator_containers();
+    test_arena_allocator_equality();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
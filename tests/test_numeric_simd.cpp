@@ -0,0 +1,305 @@
+// test_numeric_simd.cpp
+// 测试向量化数值内核（algorithms/numeric_simd.h）：每一级实现（通用 / SSE2 / AVX2）
+// 在各种长度与未对齐起点上与 long double 参考值对拍；Kahan / pairwise 的精度；
+// minmax 的 NaN 处理；原地前缀和；moments 的合并；以及 numeric.h、parallel.h
+// 中转到这些内核的入口（numeric_stats.h 的部分见 test_math.cpp）
+
+#include "../src/algorithms/numeric_simd.h"
+#include "../src/algorithms/numeric.h"
+#include "../src/algorithms/parallel.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NEAR(a, b, tol) ASSERT_TRUE(std::fabs(static_cast<double>(a) - static_cast<double>(b)) <= (tol))
+
+using namespace zen;
+
+static uint64_t rng_state = 0x2545f4914f6cdd1dull;
+static double next_unit() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return static_cast<double>(rng_state >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// 相对误差容限：按 Σ|x| 缩放
+template<typename T>
+static double tolerance(long double abs_sum) {
+    double eps = std::numeric_limits<T>::epsilon();
+    return static_cast<double>(abs_sum) * eps * 64 + 1e-30;
+}
+
+// 某一级实现的全部内核
+template<typename T>
+struct kernel_level {
+    const char* name;
+    T (*sum)(const T*, size_t);
+    T (*sum_kahan)(const T*, size_t);
+    T (*dot)(const T*, const T*, size_t);
+    void (*minmax)(const T*, size_t, T&, T&);
+    T (*prefix_sum)(const T*, T*, size_t, T);
+    detail::shifted_sums (*shifted)(const T*, size_t, double);
+};
+
+template<typename T>
+static std::vector<kernel_level<T>> kernel_levels() {
+    std::vector<kernel_level<T>> levels;
+    levels.push_back({ "generic", detail::sum_generic<T>, detail::sum_kahan_generic<T>, detail::dot_generic<T>,
+                       detail::minmax_generic<T>, detail::prefix_sum_generic<T>, detail::shifted_sums_generic<T> });
+#if ZEN_HAVE_SSE2
+    levels.push_back({ "sse2", detail::sum_sse2, detail::sum_kahan_sse2, detail::dot_sse2,
+                       detail::minmax_sse2, detail::prefix_sum_sse2, detail::shifted_sums_sse2 });
+#endif
+#if ZEN_HAVE_AVX2_TARGET
+    if (cpu_supports_avx2_target()) {
+        levels.push_back({ "avx2", detail::sum_avx2, detail::sum_kahan_avx2, detail::dot_avx2,
+                           detail::minmax_avx2, detail::prefix_sum_avx2, detail::shifted_sums_avx2 });
+    }
+#endif
+    return levels;
+}
+
+// ===========================================================================
+// 各级内核对拍
+// ===========================================================================
+
+template<typename T>
+void check_levels() {
+    auto levels = kernel_levels<T>();
+    std::vector<T> a(600), b(600), out(600);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<T>(next_unit() * 200 - 100);
+        b[i] = static_cast<T>(next_unit() * 2 - 1);
+    }
+    for (const auto& k : levels) {
+        // 长度 0..130 与若干较大长度，起点偏移 0..3（未对齐）
+        for (size_t off = 0; off < 4; ++off) {
+            for (size_t n = 0; n + off <= a.size(); n = n < 130 ? n + 1 : n + 97) {
+                const T* p = a.data() + off;
+                const T* q = b.data() + off;
+                long double s = 0, abs_s = 0, d = 0, abs_d = 0;
+                T lo = std::numeric_limits<T>::infinity(), hi = -lo;
+                for (size_t i = 0; i < n; ++i) {
+                    s += p[i];
+                    abs_s += std::fabs(static_cast<long double>(p[i]));
+                    d += static_cast<long double>(p[i]) * q[i];
+                    abs_d += std::fabs(static_cast<long double>(p[i]) * q[i]);
+                    if (p[i] < lo) lo = p[i];
+                    if (p[i] > hi) hi = p[i];
+                }
+                ASSERT_NEAR(k.sum(p, n), s, tolerance<T>(abs_s));
+                ASSERT_NEAR(k.sum_kahan(p, n), s, tolerance<T>(abs_s));
+                ASSERT_NEAR(k.dot(p, q, n), d, tolerance<T>(abs_d));
+
+                T klo = std::numeric_limits<T>::infinity(), khi = -klo;
+                k.minmax(p, n, klo, khi);
+                ASSERT_EQ(klo, lo);
+                ASSERT_EQ(khi, hi);
+
+                T last = k.prefix_sum(p, out.data(), n, T(1));
+                long double run = 1, abs_run = 1;
+                for (size_t i = 0; i < n; ++i) {
+                    run += p[i];
+                    abs_run += std::fabs(static_cast<long double>(p[i]));
+                    ASSERT_NEAR(out[i], run, tolerance<T>(abs_run));
+                }
+                ASSERT_NEAR(last, run, tolerance<T>(abs_run));
+
+                detail::shifted_sums ss = k.shifted(p, n, 3.0);
+                long double s1 = 0, s2 = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    long double dd = static_cast<long double>(p[i]) - 3.0L;
+                    s1 += dd;
+                    s2 += dd * dd;
+                }
+                ASSERT_NEAR(ss.s1, s1, tolerance<double>(abs_s + 3.0L * n));
+                ASSERT_NEAR(ss.s2, s2, tolerance<double>(s2));
+            }
+        }
+    }
+}
+
+void test_kernel_levels() {
+    printf("test_kernel_levels (%zu levels)...\n", kernel_levels<double>().size());
+    check_levels<double>();
+    check_levels<float>();
+}
+
+// ===========================================================================
+// 求和精度
+// ===========================================================================
+
+void test_summation_accuracy() {
+    printf("test_summation_accuracy...\n");
+    // 大量 0.1：fast 的误差随 n 增长，kahan / pairwise 基本不变
+    const size_t n = 1 << 22;
+    std::vector<float> tenth(n, 0.1f);
+    long double exact = static_cast<long double>(0.1f) * n;
+    double err_fast  = std::fabs(sum(tenth.data(), n) - static_cast<double>(exact));
+    double err_kahan = std::fabs(sum(tenth.data(), n, summation::kahan) - static_cast<double>(exact));
+    double err_pair  = std::fabs(sum(tenth.data(), n, summation::pairwise) - static_cast<double>(exact));
+    ASSERT_TRUE(err_kahan <= 1.0);
+    ASSERT_TRUE(err_pair <= 1.0);
+    ASSERT_TRUE(err_kahan <= err_fast);
+
+    // 大数之后跟大量小量：逐个相加时每个小量都被舍掉
+    std::vector<double> tiny(100001, 1e-16);
+    tiny[0] = 1.0;
+    for (const auto& k : kernel_levels<double>()) {
+        ASSERT_NEAR(k.sum_kahan(tiny.data(), tiny.size()), 1.0 + 1e-11, 1e-15);
+    }
+
+    // pairwise 的分块边界
+    for (size_t len : { size_t(1023), size_t(1024), size_t(1025), size_t(4096), size_t(5000) }) {
+        std::vector<double> v(len);
+        long double s = 0;
+        for (auto& x : v) {
+            x = next_unit();
+            s += x;
+        }
+        ASSERT_NEAR(sum(v.data(), len, summation::pairwise), s, 1e-9);
+    }
+    ASSERT_EQ(sum(static_cast<const double*>(nullptr), 0), 0.0);
+}
+
+// ===========================================================================
+// minmax / prefix_sum / moments
+// ===========================================================================
+
+void test_minmax() {
+    printf("test_minmax...\n");
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    double v[] = { nan, 3, -2, nan, 7, 1, nan, 0, 5, -1, 2, 4, 6, nan, 8, -3, 9, nan };
+    auto r = minmax_value(v, sizeof(v) / sizeof(v[0]));
+    ASSERT_EQ(r.lo, -3.0);
+    ASSERT_EQ(r.hi, 9.0);
+    double all_nan[] = { nan, nan, nan };
+    auto e = minmax_value(all_nan, 3);
+    ASSERT_TRUE(std::isinf(e.lo) && e.lo > 0);
+    ASSERT_TRUE(std::isinf(e.hi) && e.hi < 0);
+
+    std::vector<float> f(1000);
+    for (size_t i = 0; i < f.size(); ++i) f[i] = static_cast<float>(i % 37) - 10.0f;
+    f[613] = -50.0f;
+    f[999] = 80.0f;
+    auto rf = minmax_value(f.data(), f.size());
+    ASSERT_EQ(rf.lo, -50.0f);
+    ASSERT_EQ(rf.hi, 80.0f);
+}
+
+void test_prefix_sum_in_place() {
+    printf("test_prefix_sum_in_place...\n");
+    std::vector<double> v(1001);
+    for (size_t i = 0; i < v.size(); ++i) v[i] = static_cast<double>(i);
+    double* end = prefix_sum(v.data(), v.data(), v.size());
+    ASSERT_TRUE(end == v.data() + v.size());
+    for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(v[i], static_cast<double>(i * (i + 1) / 2));
+
+    std::vector<float> f(257, 1.0f), out(257);
+    prefix_sum(f.data(), out.data(), f.size());
+    for (size_t i = 0; i < out.size(); ++i) ASSERT_EQ(out[i], static_cast<float>(i + 1));
+}
+
+void test_moments() {
+    printf("test_moments...\n");
+    // 均值很大、方差很小：朴素的 Σx² - (Σx)²/n 会完全失去精度
+    const size_t n = 100000;
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = 1e9 + (i % 2 ? 0.5 : -0.5);
+    moments m = compute_moments(v.data(), n);
+    ASSERT_EQ(m.count, n);
+    ASSERT_NEAR(m.mean, 1e9, 1e-6);
+    ASSERT_NEAR(m.population_variance(), 0.25, 1e-9);
+
+    // 随机数据：与 long double 两遍法对拍；float 输入也以 double 精度统计
+    std::vector<float> f(12345);
+    for (auto& x : f) x = static_cast<float>(next_unit() * 10 + 100);
+    long double s = 0;
+    for (float x : f) s += x;
+    long double mean = s / f.size(), ss = 0;
+    for (float x : f) ss += (x - mean) * (x - mean);
+    moments mf = compute_moments(f.data(), f.size());
+    ASSERT_NEAR(mf.mean, mean, 1e-9);
+    ASSERT_NEAR(mf.variance(), ss / (f.size() - 1), 1e-9);
+
+    // 分段统计后合并 == 整体统计；add 与向量版本一致
+    moments a = compute_moments(f.data(), 5000);
+    moments b = compute_moments(f.data() + 5000, f.size() - 5000);
+    moments c;
+    for (size_t i = 0; i < 100; ++i) c.add(f[i]);
+    a.merge(b);
+    ASSERT_EQ(a.count, f.size());
+    ASSERT_NEAR(a.mean, mf.mean, 1e-10);
+    ASSERT_NEAR(a.m2, mf.m2, 1e-6);
+    moments head = compute_moments(f.data(), 100);
+    ASSERT_NEAR(c.mean, head.mean, 1e-10);
+    ASSERT_NEAR(c.m2, head.m2, 1e-8);
+
+    moments empty;
+    empty.merge(moments{});
+    ASSERT_EQ(empty.count, 0u);
+    ASSERT_EQ(empty.variance(), 0.0);
+    ASSERT_EQ(compute_moments(f.data(), 0).count, 0u);
+}
+
+// ===========================================================================
+// 接入点：numeric.h / parallel.h
+// ===========================================================================
+
+void test_entry_points() {
+    printf("test_entry_points...\n");
+    std::vector<double> v(10007), w(10007), out(10007);
+    long double s = 0, d = 0;
+    for (size_t i = 0; i < v.size(); ++i) {
+        v[i] = next_unit();
+        w[i] = next_unit();
+        s += v[i];
+        d += static_cast<long double>(v[i]) * w[i];
+    }
+    const double* b = v.data();
+    const double* e = v.data() + v.size();
+    ASSERT_NEAR(reduce(b, e, 1.0), s + 1, 1e-9);
+    ASSERT_NEAR(reduce(b, e), s, 1e-9);
+    ASSERT_NEAR(transform_reduce(b, e, w.data(), 2.0), d + 2, 1e-9);
+    double* oe = inclusive_scan(b, e, out.data());
+    ASSERT_TRUE(oe == out.data() + out.size());
+    ASSERT_NEAR(out.back(), s, 1e-9);
+
+    // 累加类型与元素类型不同时不走向量内核，仍按原语义求值
+    int ints[] = { 1, 2, 3, 4 };
+    ASSERT_EQ(reduce(ints, ints + 4, 0), 10);
+    float fl[] = { 0.5f, 0.25f, 0.125f };
+    ASSERT_EQ(reduce(fl, fl + 3, 0.0), 0.875);
+
+    zen::thread_pool pool(3);
+    auto par = execution::par.on(pool).with_grain(256);
+    ASSERT_NEAR(reduce(par, b, e, 1.0), s + 1, 1e-9);
+    ASSERT_NEAR(transform_reduce(par, b, e, w.data(), 2.0), d + 2, 1e-9);
+    ASSERT_NEAR(reduce(execution::seq, b, e, 0.0), s, 1e-9);
+}
+
+int main() {
+    printf("=== numeric_simd Tests ===\n\n");
+
+    test_kernel_levels();
+    test_summation_accuracy();
+    test_minmax();
+    test_prefix_sum_in_place();
+    test_moments();
+    test_entry_points();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
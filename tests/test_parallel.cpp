@@ -0,0 +1,313 @@
+// test_parallel.cpp
+// 测试带执行策略的并行算法（algorithms/parallel.h）：结果与顺序版本 / 标准库比对，
+// 覆盖 seq / par / par_unseq、指定线程池、小输入、异常传播、find_if 提前取消，
+// 以及嵌套在线程池任务中的调用（不得死锁）
+
+#include "../src/algorithms/parallel.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+using namespace zen;
+
+static uint64_t rng_state = 88172645463325252ULL;
+static uint64_t rnd() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static std::vector<int> random_ints(size_t n, int mod) {
+    std::vector<int> v(n);
+    for (auto& x : v) x = static_cast<int>(rnd() % static_cast<uint64_t>(mod));
+    return v;
+}
+
+// 测试用的小线程池，保证多线程路径一定被执行
+static thread_pool& test_pool() {
+    static thread_pool pool(4);
+    return pool;
+}
+
+void test_thread_pool_submit() {
+    printf("test_thread_pool_submit...\n");
+    thread_pool& pool = test_pool();
+    future<int> f = pool.submit([](int x) { return x * 2; }, 21);
+    ASSERT_EQ(f.get(), 42);
+
+    future<void> g = pool.submit([] {});
+    g.get();
+
+    future<int> h = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    bool caught = false;
+    try { h.get(); } catch (const std::runtime_error&) { caught = true; }
+    ASSERT_TRUE(caught);
+}
+
+void test_for_each_transform() {
+    printf("test_for_each_transform...\n");
+    auto par = execution::par.on(test_pool());
+    for (size_t n : {0u, 1u, 100u, 9000u, 200000u}) {
+        std::vector<int> v(n, 1);
+        zen::for_each(par, v.begin(), v.end(), [](int& x) { x += 2; });
+        ASSERT_TRUE(std::all_of(v.begin(), v.end(), [](int x) { return x == 3; }));
+
+        std::vector<long long> out(n);
+        auto end = zen::transform(par, v.begin(), v.end(), out.begin(),
+                                  [](int x) { return static_cast<long long>(x) * 10; });
+        ASSERT_TRUE(end == out.end());
+        ASSERT_TRUE(std::all_of(out.begin(), out.end(), [](long long x) { return x == 30; }));
+
+        std::vector<long long> sum(n);
+        zen::transform(execution::par_unseq.on(test_pool()), v.begin(), v.end(), out.begin(),
+                       sum.begin(), [](int a, long long b) { return a + b; });
+        ASSERT_TRUE(std::all_of(sum.begin(), sum.end(), [](long long x) { return x == 33; }));
+    }
+}
+
+void test_reduce_family() {
+    printf("test_reduce_family...\n");
+    auto par = execution::par.on(test_pool());
+    std::vector<int> v = random_ints(300001, 1000);
+    long long expect = std::accumulate(v.begin(), v.end(), 7LL);
+
+    ASSERT_EQ(zen::reduce(par, v.begin(), v.end(), 7LL), expect);
+    ASSERT_EQ(zen::accumulate(par, v.begin(), v.end(), 7LL), expect);
+    ASSERT_EQ(zen::reduce(execution::seq, v.begin(), v.end(), 7LL), expect);
+    ASSERT_EQ(zen::reduce(par, v.begin(), v.begin()), 0);
+
+    // 只满足结合律、不满足交换律的操作：字符串拼接，结果必须与顺序相同
+    std::vector<std::string> words;
+    for (int i = 0; i < 50000; ++i) words.push_back(std::to_string(i % 10));
+    std::string joined = zen::reduce(par.with_grain(1000), words.begin(), words.end(), std::string(">"),
+                                     [](std::string a, const std::string& b) { return a + b; });
+    std::string expect_joined = std::accumulate(words.begin(), words.end(), std::string(">"));
+    ASSERT_TRUE(joined == expect_joined);
+
+    long long sq = zen::transform_reduce(par, v.begin(), v.end(), 0LL,
+                                         [](long long a, long long b) { return a + b; },
+                                         [](int x) { return static_cast<long long>(x) * x; });
+    long long sq_expect = 0;
+    for (int x : v) sq_expect += static_cast<long long>(x) * x;
+    ASSERT_EQ(sq, sq_expect);
+
+    std::vector<long long> w(v.begin(), v.end());
+    ASSERT_EQ(zen::transform_reduce(par, w.begin(), w.end(), w.begin(), 0LL), sq_expect);
+}
+
+void test_inclusive_scan() {
+    printf("test_inclusive_scan...\n");
+    auto par = execution::par.on(test_pool());
+    for (size_t n : {0u, 1u, 5000u, 100003u}) {
+        std::vector<int> v = random_ints(n, 100);
+        std::vector<int> expect(n);
+        std::partial_sum(v.begin(), v.end(), expect.begin());
+
+        std::vector<int> out(n);
+        zen::inclusive_scan(par, v.begin(), v.end(), out.begin());
+        ASSERT_TRUE(out == expect);
+
+        // 原地扫描
+        std::vector<int> inplace = v;
+        zen::inclusive_scan(par, inplace.begin(), inplace.end(), inplace.begin());
+        ASSERT_TRUE(inplace == expect);
+
+        // 带初值，累加类型与元素类型不同
+        std::vector<long long> wide(n);
+        zen::inclusive_scan(par, v.begin(), v.end(), wide.begin(),
+                            [](long long a, int b) { return a + b; }, 1000LL);
+        for (size_t i = 0; i < n; ++i) ASSERT_EQ(wide[i], expect[i] + 1000LL);
+    }
+}
+
+void test_find_count() {
+    printf("test_find_count...\n");
+    auto par = execution::par.on(test_pool());
+    std::vector<int> v(400000, 0);
+    ASSERT_TRUE(zen::find_if(par, v.begin(), v.end(), [](int x) { return x != 0; }) == v.end());
+
+    // 多处命中时必须返回第一个
+    v[300000] = 1;
+    v[123457] = 1;
+    v[399999] = 1;
+    ASSERT_EQ(zen::find_if(par, v.begin(), v.end(), [](int x) { return x != 0; }) - v.begin(), 123457);
+    ASSERT_EQ(zen::find(par, v.begin(), v.end(), 1) - v.begin(), 123457);
+    ASSERT_EQ(zen::count_if(par, v.begin(), v.end(), [](int x) { return x != 0; }), 3u);
+    ASSERT_EQ(zen::count(par, v.begin(), v.end(), 0), v.size() - 3);
+
+    // 提前取消：命中在开头时，绝大部分元素不应被检查
+    std::vector<int> big(4000000, 0);
+    big[10] = 1;
+    std::atomic<size_t> visited{0};
+    auto it = zen::find_if(par, big.begin(), big.end(), [&visited](int x) {
+        visited.fetch_add(1, std::memory_order_relaxed);
+        return x != 0;
+    });
+    ASSERT_EQ(it - big.begin(), 10);
+    ASSERT_TRUE(visited.load() < big.size() / 4);
+}
+
+struct keyed {
+    int key;
+    int order;
+};
+
+void test_sort() {
+    printf("test_sort...\n");
+    auto par = execution::par.on(test_pool());
+    for (size_t n : {0u, 1u, 1000u, 40000u, 333333u}) {
+        std::vector<int> v = random_ints(n, 1 << 30);
+        std::vector<int> expect = v;
+        std::sort(expect.begin(), expect.end());
+        zen::sort(par, v.begin(), v.end());
+        ASSERT_TRUE(v == expect);
+
+        // 小粒度强制多段 + 多轮归并（段数不是 2 的幂）
+        v = random_ints(n, 1000);
+        expect = v;
+        std::sort(expect.begin(), expect.end(), std::greater<int>());
+        zen::sort(par.with_grain(700), v.begin(), v.end(), std::greater<int>());
+        ASSERT_TRUE(v == expect);
+    }
+
+    std::vector<std::string> s;
+    for (int i = 0; i < 100000; ++i) s.push_back(std::to_string(rnd() % 50000));
+    std::vector<std::string> s_expect = s;
+    std::sort(s_expect.begin(), s_expect.end());
+    zen::sort(par.with_grain(5000), s.begin(), s.end());
+    ASSERT_TRUE(s == s_expect);
+}
+
+void test_stable_sort() {
+    printf("test_stable_sort...\n");
+    auto par = execution::par.on(test_pool());
+    std::vector<keyed> v(200000);
+    for (size_t i = 0; i < v.size(); ++i) v[i] = { static_cast<int>(rnd() % 100), static_cast<int>(i) };
+    std::vector<keyed> expect = v;
+    auto by_key = [](const keyed& a, const keyed& b) { return a.key < b.key; };
+    std::stable_sort(expect.begin(), expect.end(), by_key);
+    zen::stable_sort(par.with_grain(3000), v.begin(), v.end(), by_key);
+    for (size_t i = 0; i < v.size(); ++i) {
+        ASSERT_EQ(v[i].key, expect[i].key);
+        ASSERT_EQ(v[i].order, expect[i].order);
+    }
+
+    // 顺序版本同样必须稳定
+    std::vector<keyed> seq_v = expect;
+    std::reverse(seq_v.begin(), seq_v.end());
+    std::vector<keyed> seq_expect = seq_v;
+    std::stable_sort(seq_expect.begin(), seq_expect.end(), by_key);
+    zen::stable_sort(seq_v.begin(), seq_v.end(), by_key);
+    for (size_t i = 0; i < seq_v.size(); ++i) ASSERT_EQ(seq_v[i].order, seq_expect[i].order);
+}
+
+void test_exception_propagates() {
+    printf("test_exception_propagates...\n");
+    std::vector<int> v(100000, 1);
+    v[77777] = -1;
+    bool caught = false;
+    try {
+        zen::for_each(execution::par.on(test_pool()), v.begin(), v.end(), [](int x) {
+            if (x < 0) throw std::runtime_error("negative");
+        });
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    ASSERT_TRUE(caught);
+}
+
+void test_sort_comparator_throws() {
+    printf("test_sort_comparator_throws...\n");
+    // 比较器在排序各阶段（段内排序、首轮归并、后续归并）抛异常：
+    // 临时缓冲区中已构造的元素必须被析构（ASan 下检查泄漏），元素总数不变
+    auto par = execution::par.on(test_pool()).with_grain(1000);
+    std::vector<std::string> base;
+    for (int i = 0; i < 20000; ++i) base.push_back("element-with-heap-storage-" + std::to_string(rnd() % 100000));
+
+    std::atomic<long> calls{0};
+    long limit = -1;
+    auto cmp = [&](const std::string& a, const std::string& b) {
+        if (calls.fetch_add(1, std::memory_order_relaxed) == limit) throw std::runtime_error("compare");
+        return a < b;
+    };
+    std::vector<std::string> v = base;
+    zen::stable_sort(par, v.begin(), v.end(), cmp);
+    long total = calls.load();
+
+    for (int k = 1; k <= 9; ++k) {
+        for (int stable = 0; stable < 2; ++stable) {
+            v = base;
+            calls = 0;
+            limit = total * k / 10;
+            bool caught = false;
+            try {
+                if (stable) zen::stable_sort(par, v.begin(), v.end(), cmp);
+                else        zen::sort(par, v.begin(), v.end(), cmp);
+            } catch (const std::runtime_error&) {
+                caught = true;
+            }
+            ASSERT_TRUE(caught || !stable);   // 不稳定排序的比较次数不同，可能达不到 limit
+            ASSERT_EQ(v.size(), base.size());
+        }
+    }
+}
+
+void test_nested_in_pool() {
+    printf("test_nested_in_pool...\n");
+    // 池内所有线程都在执行并行算法时，调用线程自己领取全部块，不会死锁
+    thread_pool pool(2);
+    std::vector<future<long long>> results;
+    for (int t = 0; t < 4; ++t) {
+        results.push_back(pool.submit([&pool] {
+            std::vector<int> v(100000, 1);
+            return zen::reduce(execution::par.on(pool), v.begin(), v.end(), 0LL);
+        }));
+    }
+    for (auto& r : results) ASSERT_EQ(r.get(), 100000LL);
+}
+
+void test_default_pool() {
+    printf("test_default_pool...\n");
+    std::vector<int> v = random_ints(100000, 1 << 20);
+    std::vector<int> expect = v;
+    std::sort(expect.begin(), expect.end());
+    zen::sort(execution::par, v.begin(), v.end());
+    ASSERT_TRUE(v == expect);
+}
+
+int main() {
+    printf("=== parallel algorithms Tests ===\n\n");
+
+    test_thread_pool_submit();
+    test_for_each_transform();
+    test_reduce_family();
+    test_inclusive_scan();
+    test_find_count();
+    test_sort();
+    test_stable_sort();
+    test_exception_propagates();
+    test_sort_comparator_throws();
+    test_nested_in_pool();
+    test_default_pool();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,488 @@
+// test_priority_queue.cpp
+// 测试 d 叉堆 priority_queue、带位置索引的 indexed_heap、单调 radix_heap，
+// 以及改用 indexed_heap / radix_heap 之后的 Dijkstra、Prim（与朴素实现对拍）
+
+#include "../src/containers/adapter/priority_queue.h"
+#include "../src/algorithms/graph.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <cassert>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <queue>
+#include <set>
+#include <string>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+
+using namespace zen;
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ull;
+static uint64_t next_rand() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+// 记录存活对象数，检查泄漏与重复析构
+struct counted {
+    static int alive;
+    int v;
+    counted(int x = 0) : v(x) { ++alive; }
+    counted(const counted& o) : v(o.v) { ++alive; }
+    counted(counted&& o) noexcept : v(o.v) { o.v = -1; ++alive; }
+    counted& operator=(const counted& o) { v = o.v; return *this; }
+    counted& operator=(counted&& o) noexcept { v = o.v; o.v = -1; return *this; }
+    ~counted() { --alive; }
+    bool operator<(const counted& o) const { return v < o.v; }
+};
+int counted::alive = 0;
+
+// ===========================================================================
+// priority_queue
+// ===========================================================================
+
+// 随机 push / pop / replace_top，与 std::priority_queue 对拍
+template<size_t Arity, typename Compare, typename StdCompare>
+void random_ops_against_std() {
+    priority_queue<int, vector<int>, Compare, Arity> pq;
+    std::priority_queue<int, std::vector<int>, StdCompare> ref;
+    for (int step = 0; step < 20000; ++step) {
+        uint64_t r = next_rand() % 10;
+        if (r < 5 || ref.empty()) {
+            int v = static_cast<int>(next_rand() % 1000);
+            if (r == 0) pq.emplace(v);
+            else pq.push(v);
+            ref.push(v);
+        } else if (r < 9) {
+            pq.pop();
+            ref.pop();
+        } else {
+            int v = static_cast<int>(next_rand() % 1000);
+            pq.replace_top(v);
+            ref.pop();
+            ref.push(v);
+        }
+        ASSERT_EQ(pq.size(), ref.size());
+        if (!ref.empty()) ASSERT_EQ(pq.top(), ref.top());
+    }
+    while (!ref.empty()) {
+        ASSERT_EQ(pq.top(), ref.top());
+        pq.pop();
+        ref.pop();
+    }
+    ASSERT_TRUE(pq.empty());
+}
+
+void test_priority_queue_basic() {
+    printf("test_priority_queue_basic...\n");
+    priority_queue<int> pq;
+    ASSERT_TRUE(pq.empty());
+    for (int v : { 5, 1, 9, 3, 7, 9, 0 }) pq.push(v);
+    ASSERT_EQ(pq.size(), 7u);
+    int expect[] = { 9, 9, 7, 5, 3, 1, 0 };
+    for (int e : expect) {
+        ASSERT_EQ(pq.top(), e);
+        pq.pop();
+    }
+    ASSERT_TRUE(pq.empty());
+
+    // 小顶堆
+    priority_queue<int, vector<int>, greater<int>> minq;
+    for (int v : { 5, 1, 9, 3 }) minq.push(v);
+    ASSERT_EQ(minq.top(), 1);
+
+    // 区间构造（Floyd 建堆）与容器构造
+    std::vector<int> src;
+    for (int i = 0; i < 1000; ++i) src.push_back(static_cast<int>(next_rand() % 500));
+    priority_queue<int> built(src.begin(), src.end());
+    std::sort(src.begin(), src.end(), std::greater<int>());
+    for (int e : src) {
+        ASSERT_EQ(built.top(), e);
+        built.pop();
+    }
+    vector<int> cont;
+    for (int i = 0; i < 100; ++i) cont.push_back(i);
+    priority_queue<int> from_cont(less<int>(), static_cast<vector<int>&&>(cont));
+    ASSERT_EQ(from_cont.size(), 100u);
+    ASSERT_EQ(from_cont.top(), 99);
+
+    priority_queue<int> a, b;
+    a.push(1);
+    b.push(2);
+    b.push(3);
+    swap(a, b);
+    ASSERT_EQ(a.size(), 2u);
+    ASSERT_EQ(a.top(), 3);
+    ASSERT_EQ(b.top(), 1);
+}
+
+void test_priority_queue_random() {
+    printf("test_priority_queue_random...\n");
+    random_ops_against_std<2, less<int>, std::less<int>>();
+    random_ops_against_std<3, less<int>, std::less<int>>();
+    random_ops_against_std<4, less<int>, std::less<int>>();
+    random_ops_against_std<8, less<int>, std::less<int>>();
+    random_ops_against_std<4, greater<int>, std::greater<int>>();
+}
+
+void test_priority_queue_objects() {
+    printf("test_priority_queue_objects...\n");
+    {
+        priority_queue<counted> pq;
+        for (int i = 0; i < 500; ++i) pq.push(counted(static_cast<int>(next_rand() % 100)));
+        int prev = 1 << 30;
+        for (int i = 0; i < 250; ++i) {
+            ASSERT_TRUE(pq.top().v <= prev);
+            prev = pq.top().v;
+            pq.pop();
+        }
+        ASSERT_EQ(counted::alive, 250);
+    }
+    ASSERT_EQ(counted::alive, 0);
+
+    priority_queue<std::string> words;
+    for (const char* w : { "pear", "apple", "zucchini", "fig", "kiwi" }) words.emplace(w);
+    ASSERT_EQ(words.top(), "zucchini");
+    words.replace_top("banana");
+    ASSERT_EQ(words.top(), "pear");
+}
+
+// ===========================================================================
+// indexed_heap
+// ===========================================================================
+
+void test_indexed_heap_basic() {
+    printf("test_indexed_heap_basic...\n");
+    indexed_heap<double> h(8);
+    ASSERT_EQ(h.capacity(), 8u);
+    ASSERT_TRUE(h.empty());
+    h.push(3, 5.0);
+    h.push(1, 2.0);
+    h.push(6, 9.0);
+    ASSERT_TRUE(h.contains(3));
+    ASSERT_FALSE(h.contains(0));
+    ASSERT_FALSE(h.contains(100));
+    ASSERT_EQ(h.top(), 1u);
+    ASSERT_EQ(h.top_key(), 2.0);
+
+    h.decrease_key(6, 1.0);
+    ASSERT_EQ(h.top(), 6u);
+    ASSERT_EQ(h.key(6), 1.0);
+    h.increase_key(6, 10.0);
+    ASSERT_EQ(h.top(), 1u);
+
+    ASSERT_FALSE(h.push_or_decrease(3, 7.0));  // 不更早，不修改
+    ASSERT_EQ(h.key(3), 5.0);
+    ASSERT_TRUE(h.push_or_decrease(3, 0.5));
+    ASSERT_EQ(h.top(), 3u);
+    ASSERT_TRUE(h.push_or_decrease(0, 0.25));
+    ASSERT_EQ(h.top(), 0u);
+    ASSERT_EQ(h.size(), 4u);
+
+    h.erase(3);
+    ASSERT_FALSE(h.contains(3));
+    h.erase(3);
+    h.update(1, 20.0);
+    h.pop();
+    ASSERT_EQ(h.top(), 6u);
+    h.pop();
+    ASSERT_EQ(h.top(), 1u);
+    h.pop();
+    ASSERT_TRUE(h.empty());
+
+    h.reserve_ids(16);
+    h.push(15, 1.0);
+    h.push(2, 3.0);
+    h.clear();
+    ASSERT_TRUE(h.empty());
+    ASSERT_FALSE(h.contains(15));
+    h.push(15, 4.0);
+    ASSERT_EQ(h.top(), 15u);
+
+    // 大顶：greater 比较器
+    indexed_heap<int, greater<int>> maxh(4);
+    maxh.push(0, 1);
+    maxh.push(1, 7);
+    maxh.push(2, 3);
+    ASSERT_EQ(maxh.top(), 1u);
+}
+
+// 随机操作与 std::set<(key, id)> 对拍
+template<size_t Arity>
+void indexed_heap_random() {
+    const size_t ids = 300;
+    indexed_heap<int, less<int>, Arity> h(ids);
+    std::set<std::pair<int, size_t>> ref;
+    std::vector<int> keys(ids, 0);
+    std::vector<bool> in(ids, false);
+    for (int step = 0; step < 40000; ++step) {
+        size_t id = next_rand() % ids;
+        int k = static_cast<int>(next_rand() % 2000);
+        switch (next_rand() % 6) {
+        case 0:
+        case 1:
+            if (in[id]) {
+                bool changed = h.push_or_decrease(id, k);
+                ASSERT_EQ(changed, k < keys[id]);
+                if (k < keys[id]) {
+                    ref.erase({ keys[id], id });
+                    keys[id] = k;
+                    ref.insert({ k, id });
+                }
+            } else {
+                h.push(id, k);
+                in[id] = true;
+                keys[id] = k;
+                ref.insert({ k, id });
+            }
+            break;
+        case 2:
+            if (in[id]) {
+                h.update(id, k);
+                ref.erase({ keys[id], id });
+                keys[id] = k;
+                ref.insert({ k, id });
+            }
+            break;
+        case 3:
+            h.erase(id);
+            if (in[id]) {
+                ref.erase({ keys[id], id });
+                in[id] = false;
+            }
+            break;
+        default:
+            if (!ref.empty()) {
+                // 键相同的 id 出堆顺序不确定，只比较键
+                ASSERT_EQ(h.top_key(), ref.begin()->first);
+                size_t top = h.top();
+                ASSERT_EQ(keys[top], h.top_key());
+                h.pop();
+                ref.erase({ keys[top], top });
+                in[top] = false;
+            }
+            break;
+        }
+        ASSERT_EQ(h.size(), ref.size());
+        ASSERT_EQ(h.contains(id), static_cast<bool>(in[id]));
+        if (in[id]) ASSERT_EQ(h.key(id), keys[id]);
+    }
+}
+
+void test_indexed_heap_random() {
+    printf("test_indexed_heap_random...\n");
+    indexed_heap_random<2>();
+    indexed_heap_random<4>();
+    indexed_heap_random<5>();
+}
+
+// ===========================================================================
+// radix_heap
+// ===========================================================================
+
+void test_radix_heap() {
+    printf("test_radix_heap...\n");
+    radix_heap<uint32_t, int> h;
+    ASSERT_TRUE(h.empty());
+    h.push(10, 1);
+    h.push(3, 2);
+    h.push(3, 3);
+    h.push(0xffffffffu, 4);
+    ASSERT_EQ(h.size(), 4u);
+    ASSERT_EQ(h.top_key(), 3u);
+    h.pop();
+    ASSERT_EQ(h.top_key(), 3u);
+    ASSERT_EQ(h.last_key(), 3u);
+    h.pop();
+    h.push(3, 5);  // 等于下界仍合法
+    ASSERT_EQ(h.top_key(), 3u);
+    ASSERT_EQ(h.top_value(), 5);
+    h.pop();
+    ASSERT_EQ(h.top_key(), 10u);
+    ASSERT_EQ(h.top_value(), 1);
+    h.pop();
+    ASSERT_EQ(h.top_key(), 0xffffffffu);
+    h.pop();
+    ASSERT_TRUE(h.empty());
+    h.clear(100);
+    ASSERT_EQ(h.last_key(), 100u);
+    h.push(150, 0);
+    ASSERT_EQ(h.top_key(), 150u);
+
+    // 随机单调操作与 multiset 对拍
+    radix_heap<uint64_t, uint64_t> r;
+    std::multiset<uint64_t> ref;
+    uint64_t last = 0;
+    for (int step = 0; step < 50000; ++step) {
+        if (next_rand() % 3 != 0 || ref.empty()) {
+            uint64_t k = last + (next_rand() % 4 == 0 ? next_rand() % (1ull << 40) : next_rand() % 64);
+            r.push(k, k * 3);
+            ref.insert(k);
+        } else {
+            ASSERT_EQ(r.top_key(), *ref.begin());
+            ASSERT_EQ(r.top_value(), *ref.begin() * 3);
+            last = *ref.begin();
+            r.pop();
+            ref.erase(ref.begin());
+        }
+        ASSERT_EQ(r.size(), ref.size());
+    }
+}
+
+// ===========================================================================
+// Dijkstra / Prim
+// ===========================================================================
+
+// 朴素 O(n^2) Dijkstra 作为参考
+template<typename W>
+std::vector<W> naive_dijkstra(const Graph<int, W>& g, size_t s) {
+    const W INF = detail::graph_infinity<W>();
+    size_t n = g.node_count();
+    std::vector<W> dist(n, INF);
+    std::vector<bool> done(n, false);
+    dist[s] = 0;
+    for (;;) {
+        size_t u = n;
+        for (size_t j = 0; j < n; ++j) {
+            if (!done[j] && dist[j] != INF && (u == n || dist[j] < dist[u])) u = j;
+        }
+        if (u == n) break;
+        done[u] = true;
+        for (const auto& e : g.neighbors(u)) {
+            if (dist[u] + e.second < dist[e.first]) dist[e.first] = dist[u] + e.second;
+        }
+    }
+    return dist;
+}
+
+template<typename W>
+Graph<int, W> random_graph(size_t n, size_t m, bool undirected) {
+    Graph<int, W> g;
+    for (size_t v = 0; v < n; ++v) g.add_node(static_cast<int>(v));
+    for (size_t i = 0; i < m; ++i) {
+        size_t u = next_rand() % n, v = next_rand() % n;
+        W w = static_cast<W>(next_rand() % 100);
+        if (undirected) g.add_undirected_edge(u, v, w);
+        else g.add_directed_edge(u, v, w);
+    }
+    return g;
+}
+
+void test_dijkstra() {
+    printf("test_dijkstra...\n");
+    for (int round = 0; round < 20; ++round) {
+        size_t n = 1 + next_rand() % 200, m = next_rand() % (n * 4 + 1);
+        auto gd = random_graph<double>(n, m, round % 2 == 0);
+        size_t s = next_rand() % n;
+        auto expect = naive_dijkstra(gd, s);
+        auto got = dijkstra(gd, s);
+        ASSERT_EQ(got.size(), n);
+        for (size_t v = 0; v < n; ++v) ASSERT_EQ(got[v], expect[v]);
+
+        // 路径：相邻顶点之间存在边，且权重之和等于距离
+        size_t t = next_rand() % n;
+        auto path = dijkstra_path(gd, s, t);
+        if (expect[t] == detail::graph_infinity<double>()) {
+            ASSERT_TRUE(path.empty());
+        } else {
+            ASSERT_EQ(path.front(), s);
+            ASSERT_EQ(path.back(), t);
+            double sum = 0;
+            for (size_t i = 0; i + 1 < path.size(); ++i) {
+                double best = detail::graph_infinity<double>();
+                for (const auto& e : gd.neighbors(path[i])) {
+                    if (e.first == path[i + 1] && e.second < best) best = e.second;
+                }
+                sum += best;
+            }
+            ASSERT_EQ(sum, expect[t]);
+        }
+
+        // 整数权重：indexed_heap 与 radix_heap 两个版本
+        auto gi = random_graph<uint32_t>(n, m, round % 2 == 1);
+        auto expect_i = naive_dijkstra(gi, s);
+        auto got_i = dijkstra(gi, s);
+        auto got_r = dijkstra_radix(gi, s);
+        for (size_t v = 0; v < n; ++v) {
+            ASSERT_EQ(got_i[v], expect_i[v]);
+            ASSERT_EQ(got_r[v], expect_i[v]);
+        }
+    }
+
+    // 不可达顶点：整数权重为最大值（不再是 numeric_limits<int>::infinity() 的 0）
+    Graph<int, int> g;
+    g.add_node(0);
+    g.add_node(1);
+    g.add_node(2);
+    g.add_directed_edge(0, 1, 4);
+    auto d = dijkstra(g, 0);
+    ASSERT_EQ(d[1], 4);
+    ASSERT_EQ(d[2], std::numeric_limits<int>::max());
+    ASSERT_TRUE(dijkstra_path(g, 0, 2).empty());
+    ASSERT_EQ(dijkstra_radix(g, 0)[2], std::numeric_limits<int>::max());
+}
+
+// Kruskal 作为参考：包含节点 0 的连通分量的最小生成树
+template<typename W>
+W kruskal_component0(const Graph<int, W>& g) {
+    size_t n = g.node_count();
+    auto comp = find_connected_components(g);
+    std::vector<std::pair<W, std::pair<size_t, size_t>>> edges;
+    for (size_t u = 0; u < n; ++u) {
+        for (const auto& e : g.neighbors(u)) {
+            if (comp[u] == comp[0]) edges.push_back({ e.second, { u, e.first } });
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    std::vector<size_t> parent(n);
+    for (size_t v = 0; v < n; ++v) parent[v] = v;
+    std::function<size_t(size_t)> find = [&](size_t x) { return parent[x] == x ? x : parent[x] = find(parent[x]); };
+    W total = 0;
+    for (const auto& e : edges) {
+        size_t a = find(e.second.first), b = find(e.second.second);
+        if (a != b) {
+            parent[a] = b;
+            total += e.first;
+        }
+    }
+    return total;
+}
+
+void test_prim() {
+    printf("test_prim...\n");
+    Graph<int, int> empty;
+    ASSERT_EQ(prim_mst(empty), 0);
+    for (int round = 0; round < 20; ++round) {
+        size_t n = 1 + next_rand() % 150, m = next_rand() % (n * 3 + 1);
+        auto g = random_graph<int>(n, m, true);
+        ASSERT_EQ(prim_mst(g), kruskal_component0(g));
+    }
+}
+
+int main() {
+    printf("=== priority_queue Tests ===\n\n");
+
+    test_priority_queue_basic();
+    test_priority_queue_random();
+    test_priority_queue_objects();
+    test_indexed_heap_basic();
+    test_indexed_heap_random();
+    test_radix_heap();
+    test_dijkstra();
+    test_prim();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,241 @@
+// test_radix_sort.cpp
+// 测试 radix_sort：各宽度整数、有符号数、浮点数（负数 / ±0 / 无穷）、
+// 键提取与稳定性、调用方提供的缓冲区、字符串 MSD 排序，以及 zen::sort 的自动切换
+
+#include "../src/algorithms/sort.h"
+#include "../src/algorithms/radix_sort.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <cassert>
+#include <cstdlib>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+using namespace zen;
+
+// 统计全局 operator new 调用次数
+static size_t g_allocs = 0;
+
+void* operator new(size_t n) {
+    ++g_allocs;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+static uint64_t rng_state = 88172645463325252ULL;
+static uint64_t rnd() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+template<typename T>
+static void check_random(size_t n, uint64_t mask = ~0ULL) {
+    std::vector<T> v(n);
+    for (T& x : v) x = static_cast<T>(rnd() & mask);
+    std::vector<T> ref = v;
+    radix_sort(v.begin(), v.end());
+    std::sort(ref.begin(), ref.end());
+    ASSERT_TRUE(v == ref);
+}
+
+void test_integers() {
+    printf("test_integers...\n");
+    const size_t sizes[] = { 0, 1, 2, 100, 5000, 300000 };
+    for (size_t n : sizes) {
+        check_random<uint8_t>(n);
+        check_random<int8_t>(n);
+        check_random<uint16_t>(n);
+        check_random<int16_t>(n);
+        check_random<uint32_t>(n);
+        check_random<int32_t>(n);
+        check_random<uint64_t>(n);
+        check_random<int64_t>(n);
+        check_random<char>(n);
+        check_random<int64_t>(n, 0xffff);              // 高字节全相同：跳过这些趟
+        check_random<uint64_t>(n, 0xff00000000ULL);    // 只有一个字节不同
+    }
+
+    std::vector<int> extremes = { 0, -1, 1, std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), -7, 7 };
+    radix_sort(extremes.begin(), extremes.end());
+    ASSERT_TRUE(std::is_sorted(extremes.begin(), extremes.end()));
+    ASSERT_EQ(extremes.front(), std::numeric_limits<int>::min());
+}
+
+void test_floats() {
+    printf("test_floats...\n");
+    std::vector<double> v;
+    for (int i = 0; i < 200000; ++i) {
+        double x = static_cast<double>(static_cast<int64_t>(rnd())) / 1e6;
+        v.push_back(i % 3 == 0 ? x * 1e-300 : x);
+    }
+    v.push_back(std::numeric_limits<double>::infinity());
+    v.push_back(-std::numeric_limits<double>::infinity());
+    v.push_back(std::numeric_limits<double>::denorm_min());
+    v.push_back(-std::numeric_limits<double>::denorm_min());
+    v.push_back(0.0);
+    std::vector<double> ref = v;
+    radix_sort(v.begin(), v.end());
+    std::sort(ref.begin(), ref.end());
+    ASSERT_TRUE(v == ref);
+
+    // -0.0 排在 +0.0 之前
+    std::vector<float> z = { 0.0f, -0.0f, 1.5f, -1.5f, 0.0f, -0.0f };
+    radix_sort(z.begin(), z.end());
+    ASSERT_TRUE(std::is_sorted(z.begin(), z.end()));
+    ASSERT_TRUE(std::signbit(z[1]) && std::signbit(z[2]) && !std::signbit(z[3]));
+
+    std::vector<float> f(70000);
+    for (float& x : f) x = static_cast<float>(static_cast<int32_t>(rnd())) / 3.0f;
+    std::vector<float> fref = f;
+    radix_sort(f.begin(), f.end());
+    std::sort(fref.begin(), fref.end());
+    ASSERT_TRUE(f == fref);
+}
+
+struct record {
+    int32_t key;
+    uint32_t seq;
+    std::string name;
+};
+
+void test_key_extractor_stable() {
+    printf("test_key_extractor_stable...\n");
+    std::vector<record> v;
+    for (uint32_t i = 0; i < 50000; ++i) {
+        v.push_back(record{ static_cast<int32_t>(rnd() % 200) - 100, i, std::to_string(i) });
+    }
+    radix_sort(v.begin(), v.end(), [](const record& r) { return r.key; });
+    for (size_t i = 1; i < v.size(); ++i) {
+        ASSERT_TRUE(v[i - 1].key <= v[i].key);
+        if (v[i - 1].key == v[i].key) ASSERT_TRUE(v[i - 1].seq < v[i].seq);   // LSD 稳定
+    }
+    for (const record& r : v) ASSERT_EQ(r.name, std::to_string(r.seq));   // 元素未被拆散
+}
+
+void test_scratch_no_alloc() {
+    printf("test_scratch_no_alloc...\n");
+    std::vector<uint32_t> v(400000), scratch(v.size());
+    for (int round = 0; round < 3; ++round) {
+        for (uint32_t& x : v) x = static_cast<uint32_t>(rnd());
+        size_t before = g_allocs;
+        radix_sort(v.begin(), v.end(), scratch.data());
+        ASSERT_EQ(g_allocs, before);
+        ASSERT_TRUE(std::is_sorted(v.begin(), v.end()));
+    }
+
+    struct item { uint64_t id; double weight; };
+    std::vector<item> items(1000), buf(items.size());
+    for (item& it : items) it = item{ rnd(), static_cast<double>(rnd() % 1000) };
+    size_t before = g_allocs;
+    radix_sort(items.begin(), items.end(), [](const item& it) { return it.id; }, buf.data());
+    ASSERT_EQ(g_allocs, before);
+    for (size_t i = 1; i < items.size(); ++i) ASSERT_TRUE(items[i - 1].id <= items[i].id);
+}
+
+static std::string random_word(size_t max_len, int alphabet) {
+    size_t len = rnd() % (max_len + 1);
+    std::string s;
+    for (size_t i = 0; i < len; ++i) s.push_back(static_cast<char>('a' + rnd() % static_cast<uint64_t>(alphabet)));
+    return s;
+}
+
+void test_strings() {
+    printf("test_strings...\n");
+    std::vector<std::string> v;
+    for (int i = 0; i < 100000; ++i) v.push_back(random_word(12, 4));
+    v.push_back("");
+    v.push_back(std::string("\xff\x80", 2));     // 高位字节按无符号比较
+    v.push_back(std::string("a\0b", 3));
+    std::vector<std::string> ref = v;
+    radix_sort(v.begin(), v.end());
+    std::sort(ref.begin(), ref.end());
+    ASSERT_TRUE(v == ref);
+
+    // 长公共前缀：递归深度受 O(log n) 约束
+    std::vector<std::string> deep;
+    std::string prefix(5000, 'x');
+    for (int i = 0; i < 3000; ++i) deep.push_back(prefix + random_word(3, 26));
+    for (int i = 0; i < 2000; ++i) deep.push_back(std::string(static_cast<size_t>(i), 'y'));
+    std::vector<std::string> dref = deep;
+    size_t before = g_allocs;
+    radix_sort(deep.begin(), deep.end());
+    ASSERT_EQ(g_allocs, before);                // 原地排序不分配
+    std::sort(dref.begin(), dref.end());
+    ASSERT_TRUE(deep == dref);
+
+    std::vector<std::string_view> views(ref.begin(), ref.end());
+    std::reverse(views.begin(), views.end());
+    radix_sort(views.begin(), views.end());
+    ASSERT_TRUE(std::is_sorted(views.begin(), views.end()));
+
+    // 按记录中的字符串字段排序
+    std::vector<record> recs;
+    for (uint32_t i = 0; i < 5000; ++i) recs.push_back(record{ 0, i, random_word(8, 3) });
+    radix_sort(recs.begin(), recs.end(), [](const record& r) -> const std::string& { return r.name; });
+    for (size_t i = 1; i < recs.size(); ++i) ASSERT_TRUE(recs[i - 1].name <= recs[i].name);
+}
+
+void test_sort_dispatch() {
+    printf("test_sort_dispatch...\n");
+    static_assert(detail::prefers_radix_sort<int>::value, "32-bit ints go to radix_sort");
+    static_assert(detail::prefers_radix_sort<float>::value, "floats go to radix_sort");
+    static_assert(!detail::prefers_radix_sort<uint64_t>::value, "64-bit keys stay on pdqsort");
+    static_assert(!detail::prefers_radix_sort<std::string>::value, "strings stay on pdqsort");
+
+    // 走基数排序时会分配一块辅助缓冲区
+    std::vector<int> v(10000);
+    for (int& x : v) x = static_cast<int>(rnd());
+    size_t before = g_allocs;
+    zen::sort(v.begin(), v.end());
+    ASSERT_EQ(g_allocs, before + 1);
+    ASSERT_TRUE(std::is_sorted(v.begin(), v.end()));
+
+    // 自定义比较器：仍是 pdqsort
+    for (int& x : v) x = static_cast<int>(rnd());
+    before = g_allocs;
+    zen::sort(v.begin(), v.end(), greater<int>());
+    ASSERT_EQ(g_allocs, before);
+    ASSERT_TRUE(std::is_sorted(v.rbegin(), v.rend()));
+
+    // 小数组：pdqsort
+    std::vector<int> small(100);
+    for (int& x : small) x = static_cast<int>(rnd());
+    before = g_allocs;
+    zen::sort(small.begin(), small.end());
+    ASSERT_EQ(g_allocs, before);
+    ASSERT_TRUE(std::is_sorted(small.begin(), small.end()));
+}
+
+int main() {
+    printf("=== radix_sort Tests ===\n\n");
+
+    test_integers();
+    test_floats();
+    test_key_extractor_stable();
+    test_scratch_no_alloc();
+    test_strings();
+    test_sort_dispatch();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
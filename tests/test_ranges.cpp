@@ -0,0 +1,195 @@
+// test_ranges.cpp
+// 测试惰性范围视图（type/ranges.h）：filter / transform / take / drop / chunk /
+// stride / enumerate / zip / join 的结果与手写循环比对，覆盖 | 管道组合、
+// 闭包组合、右值容器（owning_view）、非随机访问底层（std::list），
+// 以及视图不复制元素（元素可经视图原地修改、谓词只在迭代时调用）
+
+#include "../src/type/ranges.h"
+#include <stdio.h>
+#include <cassert>
+#include <list>
+#include <string>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+using namespace zen::ranges;
+
+static std::vector<int> iota_vec(int n) {
+    std::vector<int> v;
+    for (int i = 0; i < n; ++i) v.push_back(i);
+    return v;
+}
+
+void test_filter_transform() {
+    printf("test_filter_transform...\n");
+    std::vector<int> v = iota_vec(20);
+
+    int calls = 0;
+    auto odd = v | filter([&calls](int x) { ++calls; return x % 2 == 1; });
+    ASSERT_EQ(calls, 0);   // 构造视图不求值
+
+    std::vector<int> got = odd.to<std::vector<int>>();
+    ASSERT_EQ(got.size(), 10u);
+    for (size_t i = 0; i < got.size(); ++i) ASSERT_EQ(got[i], static_cast<int>(2 * i + 1));
+
+    auto sq = v | filter([](int x) { return x % 2 == 0; }) | transform([](int x) { return x * x; });
+    std::vector<int> expect;
+    for (int x : v) if (x % 2 == 0) expect.push_back(x * x);
+    ASSERT_TRUE(sq.to<std::vector<int>>() == expect);
+
+    // 旧接口：链式成员与函数形式都返回惰性视图，原容器销毁前迭代器有效
+    auto chained = view(v).filter([](int x) { return x > 15; }).transform([](int x) { return x - 15; });
+    ASSERT_TRUE(chained.to<std::vector<int>>() == (std::vector<int>{1, 2, 3, 4}));
+    ASSERT_EQ(filter(v, [](int x) { return x < 3; }).size(), 3u);
+    ASSERT_EQ(transform(v, [](int x) { return x * 2; }).front(), 0);
+    ASSERT_EQ(view(v).count_if([](int x) { return x % 5 == 0; }), 4u);
+
+    // 经过 filter 的元素是原容器元素的引用
+    for (int& x : v | filter([](int x) { return x >= 18; })) x = -1;
+    ASSERT_EQ(v[18], -1);
+    ASSERT_EQ(v[19], -1);
+    ASSERT_EQ(v[17], 17);
+
+    // transform 保持随机访问
+    auto tv = v | transform([](int x) { return x + 100; });
+    ASSERT_EQ(tv.end() - tv.begin(), 20);
+    ASSERT_EQ(tv.begin()[5], 105);
+    ASSERT_TRUE((filter(v, [](int) { return false; })).empty());
+}
+
+void test_take_drop() {
+    printf("test_take_drop...\n");
+    std::vector<int> v = iota_vec(10);
+    ASSERT_TRUE((v | take(3)).to<std::vector<int>>() == (std::vector<int>{0, 1, 2}));
+    ASSERT_EQ((v | take(100)).size(), 10u);
+    ASSERT_TRUE((v | take(0)).empty());
+    ASSERT_TRUE((v | drop(7)).to<std::vector<int>>() == (std::vector<int>{7, 8, 9}));
+    ASSERT_TRUE((v | drop(100)).empty());
+    ASSERT_TRUE((v | drop(2) | take(2)).to<std::vector<int>>() == (std::vector<int>{2, 3}));
+
+    // 非随机访问底层走计数迭代器
+    std::list<int> l(v.begin(), v.end());
+    ASSERT_TRUE((l | take(4)).to<std::vector<int>>() == (std::vector<int>{0, 1, 2, 3}));
+    ASSERT_EQ((l | take(50)).size(), 10u);
+    ASSERT_TRUE((l | drop(8)).to<std::vector<int>>() == (std::vector<int>{8, 9}));
+
+    // filter 之后 take：只求值到取满为止
+    int calls = 0;
+    auto first_two_even = v | filter([&calls](int x) { ++calls; return x % 2 == 0; }) | take(2);
+    ASSERT_TRUE(first_two_even.to<std::vector<int>>() == (std::vector<int>{0, 2}));
+    ASSERT_TRUE(calls < static_cast<int>(v.size()));
+}
+
+void test_chunk_stride() {
+    printf("test_chunk_stride...\n");
+    std::vector<int> v = iota_vec(10);
+    std::vector<int> sums;
+    for (auto c : v | chunk(4)) {
+        int s = 0;
+        for (int x : c) s += x;
+        sums.push_back(s);
+    }
+    ASSERT_TRUE(sums == (std::vector<int>{0 + 1 + 2 + 3, 4 + 5 + 6 + 7, 8 + 9}));
+    ASSERT_EQ((v | chunk(5)).size(), 2u);
+    ASSERT_TRUE((iota_vec(0) | chunk(3)).empty());
+
+    ASSERT_TRUE((v | stride(3)).to<std::vector<int>>() == (std::vector<int>{0, 3, 6, 9}));
+    ASSERT_TRUE((v | stride(4)).to<std::vector<int>>() == (std::vector<int>{0, 4, 8}));
+    std::list<int> l(v.begin(), v.end());
+    ASSERT_TRUE((l | stride(4)).to<std::vector<int>>() == (std::vector<int>{0, 4, 8}));
+    ASSERT_TRUE((l | chunk(3) | join).to<std::vector<int>>() == v);
+}
+
+void test_enumerate_zip() {
+    printf("test_enumerate_zip...\n");
+    std::vector<int> v = iota_vec(5);
+    for (auto [i, x] : v | enumerate) x += static_cast<int>(i);
+    ASSERT_TRUE(v == (std::vector<int>{0, 2, 4, 6, 8}));
+
+    size_t n = 0;
+    for (auto [i, x] : v | drop(1) | enumerate) {
+        ASSERT_EQ(i, n);
+        ASSERT_EQ(x, v[i + 1]);
+        ++n;
+    }
+    ASSERT_EQ(n, 4u);
+
+    std::vector<int> a = {1, 2, 3, 4};
+    std::list<std::string> b = {"a", "b", "c"};
+    std::string joined;
+    for (auto [x, s] : zip(a, b)) joined += s + std::to_string(x);
+    ASSERT_TRUE(joined == "a1b2c3");
+    ASSERT_EQ(zip(a, b).size(), 3u);
+
+    // zip 的元素是引用
+    std::vector<int> out(4, 0);
+    for (auto [dst, src] : zip(out, a)) dst = src * 10;
+    ASSERT_TRUE(out == (std::vector<int>{10, 20, 30, 40}));
+
+    int dot = 0;
+    for (auto [x, y, z] : zip(a, out, v)) dot += x * y + z;
+    ASSERT_EQ(dot, 1 * 10 + 2 * 20 + 3 * 30 + 4 * 40 + (0 + 2 + 4 + 6));
+}
+
+void test_join() {
+    printf("test_join...\n");
+    std::vector<std::vector<int>> vv = {{}, {1, 2}, {}, {}, {3}, {4, 5, 6}, {}};
+    ASSERT_TRUE((vv | join).to<std::vector<int>>() == (std::vector<int>{1, 2, 3, 4, 5, 6}));
+    for (int& x : join(vv)) x *= 2;
+    ASSERT_EQ(vv[5][2], 12);
+
+    std::vector<std::vector<int>> empty_inner(3);
+    ASSERT_TRUE((empty_inner | join).empty());
+
+    std::vector<int> v = iota_vec(7);
+    ASSERT_TRUE((v | chunk(3) | join).to<std::vector<int>>() == v);
+}
+
+void test_owning_and_composition() {
+    printf("test_owning_and_composition...\n");
+    // 右值容器被移动进视图，视图存活期间元素有效
+    auto owned = iota_vec(6) | transform([](int x) { return x * 3; }) | take(3);
+    ASSERT_TRUE(owned.to<std::vector<int>>() == (std::vector<int>{0, 3, 6}));
+
+    // 闭包先组合，再作用于不同的范围
+    auto pipeline = filter([](int x) { return x % 3 != 0; }) | transform([](int x) { return -x; }) | take(3);
+    ASSERT_TRUE((iota_vec(100) | pipeline).to<std::vector<int>>() == (std::vector<int>{-1, -2, -4}));
+    std::list<int> l = {3, 5, 6, 7};
+    ASSERT_TRUE((l | pipeline).to<std::vector<int>>() == (std::vector<int>{-5, -7}));
+
+    // 内置数组与 const 容器
+    int arr[] = {5, 6, 7, 8};
+    ASSERT_TRUE((arr | stride(2)).to<std::vector<int>>() == (std::vector<int>{5, 7}));
+    const std::vector<int> cv = iota_vec(4);
+    ASSERT_EQ((cv | enumerate | drop(3)).front().value, 3);
+
+    // 视图本身不分配内存：大小只由迭代器与参数决定
+    std::vector<int> v = iota_vec(8);
+    auto small = v | drop(1) | stride(2) | take(2);
+    ASSERT_TRUE(sizeof(small) <= 8 * sizeof(void*));
+    ASSERT_TRUE(small.to<std::vector<int>>() == (std::vector<int>{1, 3}));
+}
+
+int main() {
+    printf("=== ranges Tests ===\n\n");
+
+    test_filter_transform();
+    test_take_drop();
+    test_chunk_stride();
+    test_enumerate_zip();
+    test_join();
+    test_owning_and_composition();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,257 @@
+// test_small_vector.cpp
+// 测试 small_vector：内联存储不分配、溢出到堆、搬回内联、插入删除、
+// 内联 / 堆两种状态下的拷贝、移动与交换
+
+#include "../src/containers/sequential/small_vector.h"
+#include "../src/memory/arena_allocator.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <cassert>
+#include <new>
+#include <set>
+#include <string>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+// 统计全局 operator new 调用次数
+static long g_news = 0;
+
+void* operator new(size_t n) {
+    ++g_news;
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+using namespace zen;
+
+// 记录存活对象数，检查泄漏与重复析构
+struct counted {
+    static int alive;
+    int v;
+    counted(int x = 0) : v(x) { ++alive; }
+    counted(const counted& o) : v(o.v) { ++alive; }
+    counted(counted&& o) noexcept : v(o.v) { o.v = -1; ++alive; }
+    counted& operator=(const counted& o) { v = o.v; return *this; }
+    counted& operator=(counted&& o) noexcept { v = o.v; o.v = -1; return *this; }
+    ~counted() { --alive; }
+    bool operator==(const counted& o) const { return v == o.v; }
+    bool operator!=(const counted& o) const { return v != o.v; }
+    bool operator<(const counted& o) const { return v < o.v; }
+};
+int counted::alive = 0;
+
+void test_inline_no_allocation() {
+    printf("test_inline_no_allocation...\n");
+    long before = g_news;
+    {
+        small_vector<int, 8> v;
+        for (int i = 0; i < 8; ++i) v.push_back(i);
+        ASSERT_TRUE(v.is_inline());
+        ASSERT_EQ(v.capacity(), 8u);
+        small_vector<int, 8> c(v);
+        small_vector<int, 8> m(static_cast<small_vector<int, 8>&&>(c));
+        ASSERT_TRUE(m == v);
+        ASSERT_TRUE(c.empty());
+    }
+    ASSERT_EQ(g_news - before, 0);
+
+    small_vector<std::string, 4> s;
+    s.emplace_back("a");
+    s.emplace_back(3, 'b');
+    ASSERT_EQ(s[1], "bbb");
+}
+
+void test_spill_and_shrink() {
+    printf("test_spill_and_shrink...\n");
+    {
+        small_vector<counted, 4> v;
+        for (int i = 0; i < 4; ++i) v.emplace_back(i);
+        long before = g_news;
+        v.emplace_back(4);
+        ASSERT_EQ(g_news - before, 1);
+        ASSERT_FALSE(v.is_inline());
+        ASSERT_EQ(v.capacity(), 6u);             // 1.5 倍增长
+        for (int i = 0; i < 100; ++i) v.emplace_back(v[static_cast<size_t>(i)]);   // 参数引用自身元素
+        for (int i = 0; i < 105; ++i) ASSERT_EQ(v[static_cast<size_t>(i)].v, i < 5 ? i : v[static_cast<size_t>(i - 5)].v);
+        ASSERT_EQ(counted::alive, 105);
+
+        v.resize(3);
+        v.shrink_to_fit();
+        ASSERT_TRUE(v.is_inline());
+        ASSERT_EQ(v.capacity(), 4u);
+        ASSERT_EQ(v.back().v, 2);
+        ASSERT_EQ(counted::alive, 3);
+    }
+    ASSERT_EQ(counted::alive, 0);
+}
+
+void test_insert_erase_vs_std() {
+    printf("test_insert_erase_vs_std...\n");
+    {
+        small_vector<counted, 6> v;
+        std::vector<int> ref;
+        uint64_t s = 88172645463325252ULL;
+        auto rnd = [&s]() { s ^= s << 13; s ^= s >> 7; s ^= s << 17; return s; };
+
+        for (int step = 0; step < 5000; ++step) {
+            uint64_t r = rnd();
+            int x = static_cast<int>(r >> 40);
+            size_t n = ref.size();
+            switch (r % 7) {
+            case 0: case 1: v.push_back(counted(x)); ref.push_back(x); break;
+            case 2: if (n) { v.pop_back(); ref.pop_back(); } break;
+            case 3: {
+                size_t i = n ? (r >> 8) % (n + 1) : 0;
+                auto it = v.insert(v.begin() + i, counted(x));
+                ref.insert(ref.begin() + static_cast<ptrdiff_t>(i), x);
+                ASSERT_EQ(it->v, x);
+                break;
+            }
+            case 4: {
+                size_t i = n ? (r >> 8) % (n + 1) : 0;
+                size_t k = (r >> 20) % 4;
+                v.insert(v.begin() + i, k, counted(x));
+                ref.insert(ref.begin() + static_cast<ptrdiff_t>(i), k, x);
+                break;
+            }
+            case 5: if (n) {
+                size_t i = (r >> 8) % n;
+                size_t k = (r >> 24) % (n - i + 1);
+                v.erase(v.begin() + i, v.begin() + i + k);
+                ref.erase(ref.begin() + static_cast<ptrdiff_t>(i), ref.begin() + static_cast<ptrdiff_t>(i + k));
+            } break;
+            case 6: {
+                int src[3] = {x, x + 1, x + 2};
+                size_t i = n ? (r >> 8) % (n + 1) : 0;
+                v.insert(v.begin() + i, src, src + 3);
+                ref.insert(ref.begin() + static_cast<ptrdiff_t>(i), src, src + 3);
+                break;
+            }
+            }
+            if (ref.size() > 40) { v.clear(); ref.clear(); }
+            ASSERT_EQ(v.size(), ref.size());
+            for (size_t i = 0; i < ref.size(); ++i) ASSERT_EQ(v[i].v, ref[i]);
+        }
+        ASSERT_EQ(counted::alive, static_cast<int>(v.size()));
+    }
+    ASSERT_EQ(counted::alive, 0);
+}
+
+void test_copy_move_swap_mixed() {
+    printf("test_copy_move_swap_mixed...\n");
+    {
+        small_vector<counted, 3> small, big;
+        small.emplace_back(1);
+        for (int i = 0; i < 10; ++i) big.emplace_back(100 + i);
+
+        small_vector<counted, 3> a(small), b(big);
+        a.swap(b);                              // 内联 <-> 堆
+        ASSERT_EQ(a.size(), 10u);
+        ASSERT_EQ(b.size(), 1u);
+        ASSERT_TRUE(b.is_inline());
+        ASSERT_EQ(a[9].v, 109);
+        ASSERT_EQ(b[0].v, 1);
+
+        const counted* heap = a.data();
+        small_vector<counted, 3> c(static_cast<small_vector<counted, 3>&&>(a));
+        ASSERT_EQ(c.data(), heap);              // 堆存储直接接管
+        ASSERT_TRUE(a.is_inline() && a.empty());
+
+        c = small;
+        ASSERT_EQ(c.size(), 1u);
+        c = static_cast<small_vector<counted, 3>&&>(big);
+        ASSERT_EQ(c.size(), 10u);
+        ASSERT_TRUE(big.empty());
+
+        small_vector<counted, 3> d(5, counted(7));
+        ASSERT_EQ(d[4].v, 7);
+        ASSERT_TRUE(d != c);
+        ASSERT_TRUE(b < c);
+    }
+    ASSERT_EQ(counted::alive, 0);
+}
+
+// 记录自己分配出去的块，释放不属于自己的块时报错
+class tracking_resource : public memory_resource {
+public:
+    std::set<void*> live;
+    bool foreign_free = false;
+
+protected:
+    void* do_allocate(size_t bytes, size_t align) override {
+        void* p = new_delete_resource()->allocate(bytes, align);
+        live.insert(p);
+        return p;
+    }
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        if (live.erase(p) == 0) {
+            foreign_free = true;
+            return;
+        }
+        new_delete_resource()->deallocate(p, bytes, align);
+    }
+};
+
+void test_move_assign_unequal_allocators() {
+    printf("test_move_assign_unequal_allocators...\n");
+    using arena_vec = small_vector<std::string, 2, arena_allocator<std::string>>;
+    tracking_resource ra, rb;
+    {
+        arena_vec a{ arena_allocator<std::string>(&ra) };
+        arena_vec b{ arena_allocator<std::string>(&rb) };
+        for (int i = 0; i < 10; ++i) b.push_back("value-" + std::to_string(i));
+        ASSERT_FALSE(b.is_inline());
+
+        // 分配器不相等：逐个搬移，a 的堆存储来自自己的资源
+        a = static_cast<arena_vec&&>(b);
+        ASSERT_EQ(a.size(), 10u);
+        ASSERT_EQ(a[9], std::string("value-9"));
+        ASSERT_TRUE(b.empty());
+        ASSERT_EQ(ra.live.size(), 1u);
+        ASSERT_TRUE(ra.live.count(a.data()) == 1);
+
+        // 分配器相等：直接接管堆存储
+        arena_vec c{ arena_allocator<std::string>(&ra) };
+        const std::string* heap = a.data();
+        c = static_cast<arena_vec&&>(a);
+        ASSERT_EQ(c.data(), heap);
+        ASSERT_EQ(c.size(), 10u);
+
+        // 内联状态的 other：搬移元素，与分配器无关
+        arena_vec d{ arena_allocator<std::string>(&rb) };
+        d.push_back("inline");
+        c = static_cast<arena_vec&&>(d);
+        ASSERT_EQ(c.size(), 1u);
+        ASSERT_EQ(c[0], std::string("inline"));
+    }
+    ASSERT_FALSE(ra.foreign_free);
+    ASSERT_FALSE(rb.foreign_free);
+    ASSERT_TRUE(ra.live.empty());
+    ASSERT_TRUE(rb.live.empty());
+}
+
+int main() {
+    printf("=== small_vector Tests ===\n\n");
+
+    test_inline_no_allocation();
+    test_spill_and_shrink();
+    test_insert_erase_vs_std();
+    test_copy_move_swap_mixed();
+    test_move_assign_unequal_allocators();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
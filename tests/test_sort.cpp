@@ -0,0 +1,208 @@
+// test_sort.cpp
+// 测试 pdqsort（zen::sort）：各种输入分布、对抗输入、自定义比较器、
+// 只可移动的类型、重复元素，以及与 std::sort 的结果比对
+
+#include "../src/algorithms/sort.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <cassert>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+using namespace zen;
+
+static uint64_t rng_state = 88172645463325252ULL;
+static uint64_t rnd() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+// 生成各种分布的输入
+enum class pattern { random, sorted, reversed, organ_pipe, few_unique, all_equal, sawtooth, sorted_tail };
+
+static std::vector<int> make_input(pattern p, size_t n) {
+    std::vector<int> v(n);
+    for (size_t i = 0; i < n; ++i) {
+        switch (p) {
+        case pattern::random:      v[i] = static_cast<int>(rnd()); break;
+        case pattern::sorted:      v[i] = static_cast<int>(i); break;
+        case pattern::reversed:    v[i] = static_cast<int>(n - i); break;
+        case pattern::organ_pipe:  v[i] = static_cast<int>(i < n / 2 ? i : n - i); break;
+        case pattern::few_unique:  v[i] = static_cast<int>(rnd() % 4); break;
+        case pattern::all_equal:   v[i] = 7; break;
+        case pattern::sawtooth:    v[i] = static_cast<int>(i % 97); break;
+        case pattern::sorted_tail: v[i] = static_cast<int>(i); break;
+        }
+    }
+    if (p == pattern::sorted_tail && n > 0) v[n - 1] = -1;   // 有序数组末尾追加一个最小值
+    return v;
+}
+
+void test_patterns_vs_std() {
+    printf("test_patterns_vs_std...\n");
+    const pattern all[] = { pattern::random, pattern::sorted, pattern::reversed, pattern::organ_pipe,
+                            pattern::few_unique, pattern::all_equal, pattern::sawtooth, pattern::sorted_tail };
+    const size_t sizes[] = { 0, 1, 2, 3, 23, 24, 25, 127, 128, 129, 1000, 4096, 100000 };
+    for (pattern p : all) {
+        for (size_t n : sizes) {
+            std::vector<int> v = make_input(p, n);
+            std::vector<int> ref = v;
+            zen::sort(v.begin(), v.end());
+            std::sort(ref.begin(), ref.end());
+            ASSERT_TRUE(v == ref);
+        }
+    }
+}
+
+void test_branchless_types() {
+    printf("test_branchless_types...\n");
+    static_assert(detail::is_branchless_compare<int, less<int>>::value, "int/less should be branchless");
+    static_assert(detail::is_branchless_compare<double, greater<double>>::value, "double/greater should be branchless");
+    static_assert(!detail::is_branchless_compare<std::string, less<std::string>>::value, "string is not arithmetic");
+
+    std::vector<double> d(50000);
+    for (double& x : d) x = static_cast<double>(rnd() % 1000000) / 7.0 - 50000.0;
+    std::vector<double> dref = d;
+    zen::sort(d.begin(), d.end());
+    std::sort(dref.begin(), dref.end());
+    ASSERT_TRUE(d == dref);
+
+    std::vector<uint64_t> u(50000);
+    for (uint64_t& x : u) x = rnd();
+    std::vector<uint64_t> uref = u;
+    zen::sort(u.begin(), u.end(), greater<uint64_t>());
+    std::sort(uref.begin(), uref.end(), [](uint64_t a, uint64_t b) { return a > b; });
+    ASSERT_TRUE(u == uref);
+
+    // 原生数组 + 指针迭代器
+    short arr[300];
+    for (short& x : arr) x = static_cast<short>(rnd());
+    zen::sort(arr, arr + 300);
+    ASSERT_TRUE(std::is_sorted(arr, arr + 300));
+}
+
+// 记录类型 + 按键比较的 lambda（走分支版分区）
+struct record {
+    uint32_t key;
+    uint32_t payload;
+};
+
+void test_records_custom_compare() {
+    printf("test_records_custom_compare...\n");
+    std::vector<record> v(200000);
+    for (size_t i = 0; i < v.size(); ++i) v[i] = record{ static_cast<uint32_t>(rnd() % 5000), static_cast<uint32_t>(i) };
+    uint64_t sum = 0;
+    for (const record& r : v) sum += r.payload;
+
+    zen::sort(v.begin(), v.end(), [](const record& a, const record& b) { return a.key < b.key; });
+    for (size_t i = 1; i < v.size(); ++i) ASSERT_TRUE(v[i - 1].key <= v[i].key);
+    uint64_t sum2 = 0;
+    for (const record& r : v) sum2 += r.payload;
+    ASSERT_EQ(sum, sum2);                    // 只是重排，没有丢失或复制元素
+}
+
+// 只可移动的类型：pivot 不应被拷贝
+void test_move_only() {
+    printf("test_move_only...\n");
+    std::vector<std::unique_ptr<int>> v;
+    for (int i = 0; i < 5000; ++i) v.push_back(std::unique_ptr<int>(new int(static_cast<int>(rnd() % 1000))));
+    zen::sort(v.begin(), v.end(), [](const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) { return *a < *b; });
+    for (size_t i = 0; i < v.size(); ++i) ASSERT_TRUE(v[i] != nullptr);
+    for (size_t i = 1; i < v.size(); ++i) ASSERT_TRUE(*v[i - 1] <= *v[i]);
+}
+
+void test_strings() {
+    printf("test_strings...\n");
+    std::vector<std::string> v;
+    for (int i = 0; i < 20000; ++i) v.push_back(std::to_string(rnd() % 3000));
+    std::vector<std::string> ref = v;
+    zen::sort(v.begin(), v.end());
+    std::sort(ref.begin(), ref.end());
+    ASSERT_TRUE(v == ref);
+}
+
+// 对抗输入：统计比较次数，确认保持在 O(n log n)
+void test_comparison_bound() {
+    printf("test_comparison_bound...\n");
+    const size_t n = 1 << 16;
+    const pattern all[] = { pattern::sorted, pattern::reversed, pattern::organ_pipe, pattern::sawtooth, pattern::random };
+    for (pattern p : all) {
+        std::vector<int> v = make_input(p, n);
+        size_t comparisons = 0;
+        zen::sort(v.begin(), v.end(), [&comparisons](int a, int b) { ++comparisons; return a < b; });
+        ASSERT_TRUE(std::is_sorted(v.begin(), v.end()));
+        ASSERT_TRUE(comparisons < 4 * n * 16);
+    }
+
+    // 有序 / 逆序输入是线性的
+    std::vector<int> s = make_input(pattern::sorted, n);
+    size_t c = 0;
+    zen::sort(s.begin(), s.end(), [&c](int a, int b) { ++c; return a < b; });
+    ASSERT_TRUE(c < 2 * n);
+    std::vector<int> r = make_input(pattern::reversed, n);
+    c = 0;
+    zen::sort(r.begin(), r.end(), [&c](int a, int b) { ++c; return a < b; });
+    ASSERT_TRUE(c < 2 * n);
+    ASSERT_TRUE(std::is_sorted(r.begin(), r.end()));
+}
+
+// median-of-3 killer：经典的让三数取中快排退化为 O(n²) 的序列
+void test_median_of_three_killer() {
+    printf("test_median_of_three_killer...\n");
+    const size_t n = 1 << 16;
+    std::vector<int> v(n);
+    size_t k = n / 2;
+    for (size_t i = 1; i <= k; ++i) {
+        if (i % 2 == 1) {
+            v[i - 1] = static_cast<int>(i);
+            v[i] = static_cast<int>(k + i);
+        }
+        v[k + i - 1] = static_cast<int>(2 * i);
+    }
+    size_t comparisons = 0;
+    zen::sort(v.begin(), v.end(), [&comparisons](int a, int b) { ++comparisons; return a < b; });
+    ASSERT_TRUE(std::is_sorted(v.begin(), v.end()));
+    ASSERT_TRUE(comparisons < 4 * n * 16);
+}
+
+void test_compat_entry_points() {
+    printf("test_compat_entry_points...\n");
+    std::vector<int> v = make_input(pattern::random, 3000);
+    std::vector<int> w = v;
+    zen::pdqsort(v.begin(), v.end());
+    zen::quick_sort(w.begin(), w.end());
+    ASSERT_TRUE(v == w);
+    zen::sort(v.begin(), v.end(), greater<int>());
+    ASSERT_TRUE(std::is_sorted(v.rbegin(), v.rend()));
+}
+
+int main() {
+    printf("=== sort Tests ===\n\n");
+
+    test_patterns_vs_std();
+    test_branchless_types();
+    test_records_custom_compare();
+    test_move_only();
+    test_strings();
+    test_comparison_bound();
+    test_median_of_three_killer();
+    test_compat_entry_points();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
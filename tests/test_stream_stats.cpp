@@ -0,0 +1,348 @@
+// test_stream_stats.cpp
+// 测试流式统计累加器（math/stream_stats.h）：与整体计算的结果对拍、
+// 分段 / 多线程统计后 merge 与整体统计一致、KLL 分位数与 HyperLogLog 的误差范围、
+// 指数衰减平均的权重与乱序样本
+
+#include "../src/math/numeric_stats.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NEAR(a, b, tol) ASSERT_TRUE(std::fabs(static_cast<double>(a) - static_cast<double>(b)) <= (tol))
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ull;
+static uint64_t next_u64() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+static double next_unit() { return static_cast<double>(next_u64() >> 11) * (1.0 / 9007199254740992.0); }
+
+// ===========================================================================
+// welford / minmax
+// ===========================================================================
+
+void test_welford() {
+    printf("test_welford...\n");
+    std::vector<double> v(50000);
+    for (auto& x : v) x = 1e8 + next_unit() * 10;
+    long double s = 0;
+    for (double x : v) s += x;
+    long double mean = s / v.size(), ss = 0;
+    for (double x : v) ss += (x - mean) * (x - mean);
+    double var = static_cast<double>(ss / (v.size() - 1));
+
+    zen::welford_accumulator one;
+    for (double x : v) one.add(x);
+    ASSERT_EQ(one.count(), v.size());
+    ASSERT_NEAR(one.mean(), mean, 1e-6);
+    ASSERT_NEAR(one.variance(), var, 1e-6);
+
+    // 批量加入（向量内核）与逐个加入一致
+    zen::welford_accumulator bulk;
+    bulk.add(v.data(), 123);
+    bulk.add(v.data() + 123, v.size() - 123);
+    ASSERT_EQ(bulk.count(), v.size());
+    ASSERT_NEAR(bulk.mean(), mean, 1e-6);
+    ASSERT_NEAR(bulk.variance(), var, 1e-6);
+
+    // 分 7 段统计再合并
+    zen::welford_accumulator parts[7], merged;
+    for (size_t i = 0; i < v.size(); ++i) parts[i % 7].add(v[i]);
+    for (auto& p : parts) merged.merge(p);
+    ASSERT_EQ(merged.count(), v.size());
+    ASSERT_NEAR(merged.mean(), mean, 1e-6);
+    ASSERT_NEAR(merged.variance(), var, 1e-6);
+    ASSERT_NEAR(merged.stddev(), std::sqrt(var), 1e-6);
+
+    zen::welford_accumulator empty;
+    merged.merge(empty);
+    ASSERT_EQ(merged.count(), v.size());
+    empty.merge(merged);
+    ASSERT_NEAR(empty.variance(), var, 1e-6);
+    empty.clear();
+    ASSERT_TRUE(empty.empty());
+    ASSERT_EQ(empty.variance(), 0.0);
+
+    int ints[] = { 2, 4, 4, 4, 5, 5, 7, 9 };
+    zen::welford_accumulator wi;
+    wi.add(ints, 8);
+    ASSERT_NEAR(wi.population_variance(), 4.0, 1e-12);
+}
+
+void test_minmax() {
+    printf("test_minmax...\n");
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    zen::minmax_accumulator<double> a, b;
+    ASSERT_TRUE(a.empty());
+    a.add(nan);
+    ASSERT_TRUE(a.empty());
+    ASSERT_EQ(a.count(), 1u);
+    a.add(3.0);
+    a.add(-1.0);
+    double bulk[] = { nan, 10.0, 2.0, nan, -7.5, 4.0, 1.0, 0.0, 6.0 };
+    b.add(bulk, 9);
+    ASSERT_EQ(b.min(), -7.5);
+    ASSERT_EQ(b.max(), 10.0);
+    a.merge(b);
+    ASSERT_EQ(a.count(), 12u);
+    ASSERT_EQ(a.min(), -7.5);
+    ASSERT_EQ(a.max(), 10.0);
+
+    double all_nan[] = { nan, nan };
+    zen::minmax_accumulator<double> c;
+    c.add(all_nan, 2);
+    ASSERT_TRUE(c.empty());
+    c.merge(zen::minmax_accumulator<double>());
+    ASSERT_TRUE(c.empty());
+
+    zen::minmax_accumulator<std::string> s;
+    s.add("pear");
+    s.add("apple");
+    s.add("zucchini");
+    ASSERT_EQ(s.min(), "apple");
+    ASSERT_EQ(s.max(), "zucchini");
+}
+
+// ===========================================================================
+// KLL
+// ===========================================================================
+
+// 草图给出的 q 分位数在真实数据中的秩与 q 之差
+static double rank_error(const std::vector<double>& sorted, double value, double q) {
+    size_t r = static_cast<size_t>(std::upper_bound(sorted.begin(), sorted.end(), value) - sorted.begin());
+    return std::fabs(static_cast<double>(r) / static_cast<double>(sorted.size()) - q);
+}
+
+void test_kll() {
+    printf("test_kll...\n");
+    const size_t n = 200000;
+    std::vector<double> v(n);
+    for (auto& x : v) x = next_unit() * next_unit() * 1000;  // 偏斜分布
+    std::vector<double> sorted = v;
+    std::sort(sorted.begin(), sorted.end());
+
+    zen::kll_sketch<double> sk(200);
+    for (double x : v) sk.add(x);
+    ASSERT_EQ(sk.count(), n);
+    ASSERT_TRUE(sk.retained() < 1000);
+    ASSERT_EQ(sk.quantile(0), sorted.front());
+    ASSERT_EQ(sk.quantile(1), sorted.back());
+    for (double q : { 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99 }) {
+        ASSERT_TRUE(rank_error(sorted, sk.quantile(q), q) < 0.02);
+    }
+    std::vector<double> qs = { 0.0, 0.5, 0.9, 1.0 };
+    std::vector<double> many = sk.quantiles(qs);
+    ASSERT_EQ(many.size(), qs.size());
+    ASSERT_EQ(many[0], sorted.front());
+    ASSERT_EQ(many[1], sk.quantile(0.5));
+    ASSERT_EQ(many[2], sk.quantile(0.9));
+    ASSERT_EQ(many[3], sorted.back());
+    ASSERT_NEAR(sk.rank(sorted[n / 3]), 1.0 / 3, 0.02);
+
+    // 4 段各自建草图再合并
+    zen::kll_sketch<double> parts[4] = { zen::kll_sketch<double>(200, 1), zen::kll_sketch<double>(200, 2),
+                                         zen::kll_sketch<double>(200, 3), zen::kll_sketch<double>(200, 4) };
+    for (size_t i = 0; i < n; ++i) parts[i * 4 / n].add(v[i]);
+    zen::kll_sketch<double> merged(200);
+    for (auto& p : parts) merged.merge(p);
+    ASSERT_EQ(merged.count(), n);
+    ASSERT_TRUE(merged.retained() < 1000);
+    ASSERT_EQ(merged.quantile(0), sorted.front());
+    ASSERT_EQ(merged.quantile(1), sorted.back());
+    for (double q : { 0.01, 0.1, 0.5, 0.9, 0.99 }) {
+        ASSERT_TRUE(rank_error(sorted, merged.quantile(q), q) < 0.02);
+    }
+
+    // 与自身合并：样本数翻倍，分布不变
+    merged.merge(merged);
+    ASSERT_EQ(merged.count(), 2 * n);
+    ASSERT_TRUE(merged.retained() < 1000);
+    ASSERT_EQ(merged.quantile(0), sorted.front());
+    ASSERT_EQ(merged.quantile(1), sorted.back());
+    for (double q : { 0.1, 0.5, 0.9 }) {
+        ASSERT_TRUE(rank_error(sorted, merged.quantile(q), q) < 0.02);
+    }
+
+    // 小数据量时不压缩，结果精确
+    zen::kll_sketch<int> small;
+    for (int i = 100; i >= 1; --i) small.add(i);
+    ASSERT_EQ(small.retained(), 100u);
+    ASSERT_EQ(small.quantile(0.5), 50);
+    ASSERT_EQ(small.quantile(0.01), 1);
+    ASSERT_EQ(small.quantile(1.0), 100);
+    small.merge(small);
+    ASSERT_EQ(small.count(), 200u);
+    ASSERT_EQ(small.quantile(0.0), 1);
+    ASSERT_EQ(small.quantile(1.0), 100);
+    ASSERT_TRUE(small.quantile(0.5) >= 45 && small.quantile(0.5) <= 55);
+
+    zen::kll_sketch<double> empty;
+    ASSERT_EQ(empty.quantile(0.5), 0.0);
+    empty.add(std::numeric_limits<double>::quiet_NaN());
+    ASSERT_TRUE(empty.empty());
+    sk.clear();
+    ASSERT_TRUE(sk.empty());
+}
+
+// ===========================================================================
+// HyperLogLog
+// ===========================================================================
+
+void test_hyperloglog() {
+    printf("test_hyperloglog...\n");
+    zen::hyperloglog<> h;
+    ASSERT_EQ(h.estimate(), 0.0);
+    for (uint64_t i = 0; i < 100; ++i) h.add(i);
+    ASSERT_NEAR(h.estimate(), 100, 3);  // 小基数走线性计数，几乎精确
+
+    // 1e6 个不同值，每个重复 3 次
+    zen::hyperloglog<> big;
+    for (int r = 0; r < 3; ++r) {
+        for (uint64_t i = 0; i < 1000000; ++i) big.add(i * 2654435761u);
+    }
+    double rel = std::fabs(big.estimate() - 1e6) / 1e6;
+    ASSERT_TRUE(rel < 4 * zen::hyperloglog<>::relative_error());
+
+    // 两个部分重叠的集合：merge 后估计并集
+    zen::hyperloglog<14> a, b, both;
+    for (uint64_t i = 0; i < 300000; ++i) a.add(i);
+    for (uint64_t i = 200000; i < 500000; ++i) b.add(i);
+    for (uint64_t i = 0; i < 500000; ++i) both.add(i);
+    a.merge(b);
+    ASSERT_EQ(a.estimate(), both.estimate());  // 与对并集直接计数完全相同
+    ASSERT_TRUE(std::fabs(a.estimate() - 5e5) / 5e5 < 4 * zen::hyperloglog<14>::relative_error());
+
+    zen::hyperloglog<10> words;
+    for (int i = 0; i < 5000; ++i) words.add(std::string("w") + std::to_string(i % 1000));
+    ASSERT_TRUE(std::fabs(words.estimate() - 1000) / 1000 < 4 * zen::hyperloglog<10>::relative_error());
+    words.clear();
+    ASSERT_EQ(words.estimate(), 0.0);
+}
+
+// ===========================================================================
+// 指数衰减
+// ===========================================================================
+
+void test_ewma() {
+    printf("test_ewma...\n");
+    zen::ewma e(0.5);
+    ASSERT_TRUE(e.empty());
+    e.add(10);
+    ASSERT_EQ(e.value(), 10.0);  // 偏差修正：第一个样本即为均值
+    e.add(20);
+    // 权重 0.5 : 1
+    ASSERT_NEAR(e.value(), (10 * 0.5 + 20) / 1.5, 1e-12);
+    for (int i = 0; i < 100; ++i) e.add(3);
+    ASSERT_NEAR(e.value(), 3, 1e-12);
+
+    zen::ewma a(0.1), b(0.1);
+    for (int i = 0; i < 1000; ++i) a.add(1);
+    for (int i = 0; i < 1000; ++i) b.add(5);
+    a.merge(b);
+    ASSERT_NEAR(a.value(), 3, 1e-9);
+
+    // 半衰期 10：t = 0 的样本在 t = 10 时权重为 1/2
+    zen::decaying_average d(10.0);
+    d.add(100, 0);
+    d.add(0, 10);
+    ASSERT_NEAR(d.value(), 100 * 0.5 / 1.5, 1e-12);
+    ASSERT_NEAR(d.weight(10), 1.5, 1e-12);
+    ASSERT_NEAR(d.weight(20), 0.75, 1e-12);
+
+    // 乱序到达与按序到达结果相同
+    zen::decaying_average in_order(5.0), out_of_order(5.0);
+    double ts[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    double xs[] = { 4, 8, 15, 16, 23, 42, 7, 1 };
+    for (int i = 0; i < 8; ++i) in_order.add(xs[i], ts[i]);
+    int order[] = { 3, 0, 7, 5, 1, 2, 6, 4 };
+    for (int i : order) out_of_order.add(xs[i], ts[i]);
+    ASSERT_NEAR(in_order.value(), out_of_order.value(), 1e-12);
+    ASSERT_NEAR(in_order.weight(8), out_of_order.weight(8), 1e-12);
+
+    // 按时间拆成两个累加器再合并
+    zen::decaying_average even(5.0), odd(5.0);
+    for (int i = 0; i < 8; ++i) (i % 2 ? odd : even).add(xs[i], ts[i]);
+    even.merge(odd);
+    ASSERT_NEAR(even.value(), in_order.value(), 1e-12);
+    ASSERT_NEAR(even.weight(8), in_order.weight(8), 1e-12);
+    ASSERT_EQ(even.last_time(), 8.0);
+
+    // 稳定速率：每单位时间 1 个事件，估计速率趋于 1
+    zen::decaying_average rate(20.0);
+    for (int t = 0; t < 2000; ++t) rate.add(1, t);
+    ASSERT_NEAR(rate.rate(2000), 1.0, 0.05);
+}
+
+// ===========================================================================
+// 多线程：每个线程一份累加器，结束后合并
+// ===========================================================================
+
+void test_per_thread_merge() {
+    printf("test_per_thread_merge...\n");
+    const int threads = 4;
+    const size_t per = 100000;
+    std::vector<zen::welford_accumulator> w(threads);
+    std::vector<zen::minmax_accumulator<double>> mm(threads);
+    std::vector<zen::hyperloglog<>> hll(threads);
+    std::vector<zen::kll_sketch<double>> kll;
+    for (int t = 0; t < threads; ++t) kll.emplace_back(200, t + 1);
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            for (size_t i = 0; i < per; ++i) {
+                double x = static_cast<double>(t * per + i);
+                w[t].add(x);
+                mm[t].add(x);
+                hll[t].add(static_cast<uint64_t>(x));
+                kll[t].add(x);
+            }
+        });
+    }
+    for (auto& th : pool) th.join();
+
+    for (int t = 1; t < threads; ++t) {
+        w[0].merge(w[t]);
+        mm[0].merge(mm[t]);
+        hll[0].merge(hll[t]);
+        kll[0].merge(kll[t]);
+    }
+    const double n = static_cast<double>(threads * per);
+    ASSERT_EQ(w[0].count(), threads * per);
+    ASSERT_NEAR(w[0].mean(), (n - 1) / 2, 1e-6);
+    ASSERT_NEAR(w[0].population_variance(), (n * n - 1) / 12, 1e-3 * n);
+    ASSERT_EQ(mm[0].min(), 0.0);
+    ASSERT_EQ(mm[0].max(), n - 1);
+    ASSERT_TRUE(std::fabs(hll[0].estimate() - n) / n < 4 * zen::hyperloglog<>::relative_error());
+    ASSERT_NEAR(kll[0].quantile(0.5), n / 2, 0.02 * n);
+}
+
+int main() {
+    printf("=== stream_stats Tests ===\n\n");
+
+    test_welford();
+    test_minmax();
+    test_kll();
+    test_hyperloglog();
+    test_ewma();
+    test_per_thread_merge();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,168 @@
+// test_string.cpp
+// 测试 zen::string：短串内联不分配、长短切换、自引用追加 / 插入、
+// 与 string_view 的互通，以及透明哈希
+
+#include "../src/containers/sequential/string.h"
+#include "../src/containers/associative/flat_hash_map.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <cassert>
+#include <new>
+#include <string>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+// 统计全局 operator new 调用次数
+static long g_news = 0;
+
+void* operator new(size_t n) {
+    ++g_news;
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+using zen::string;
+using zen::string_view;
+
+void test_sso_layout() {
+    printf("test_sso_layout...\n");
+    static_assert(sizeof(string) == 3 * sizeof(void*), "three words");
+    ASSERT_TRUE(string::SSO_CAPACITY >= 22);
+
+    long before = g_news;
+    {
+        string e;
+        ASSERT_TRUE(e.empty());
+        ASSERT_EQ(e.c_str()[0], '\0');
+        string s("0123456789012345678901");     // 22 个字符
+        ASSERT_EQ(s.size(), 22u);
+        ASSERT_TRUE(s.is_inline());
+        ASSERT_EQ(s.c_str()[22], '\0');
+        string c(s);
+        string m(static_cast<string&&>(c));
+        ASSERT_TRUE(c.empty());
+        ASSERT_EQ(m, s);
+    }
+    ASSERT_EQ(g_news - before, 0);
+
+    string l("01234567890123456789012");        // 23 个字符
+    ASSERT_FALSE(l.is_inline());
+    ASSERT_EQ(l.size(), 23u);
+    ASSERT_EQ(l.capacity(), 23u);
+    ASSERT_EQ(string_view(l), "01234567890123456789012");
+}
+
+void test_grow_and_shrink() {
+    printf("test_grow_and_shrink...\n");
+    string s;
+    std::string ref;
+    for (int i = 0; i < 1000; ++i) {
+        char c = static_cast<char>('a' + i % 26);
+        s.push_back(c);
+        ref.push_back(c);
+        ASSERT_EQ(s.size(), ref.size());
+        ASSERT_EQ(s.c_str()[s.size()], '\0');
+    }
+    ASSERT_EQ(string_view(s), string_view(ref.data(), ref.size()));
+
+    s.resize(5);
+    ASSERT_FALSE(s.is_inline());
+    s.shrink_to_fit();
+    ASSERT_TRUE(s.is_inline());
+    ASSERT_EQ(s, "abcde");
+    s.resize(8, 'x');
+    ASSERT_EQ(s, "abcdexxx");
+    s.pop_back();
+    ASSERT_EQ(s.back(), 'x');
+    s.clear();
+    ASSERT_TRUE(s.empty());
+}
+
+void test_self_reference() {
+    printf("test_self_reference...\n");
+    string s("abcdefghij");
+    s.append(s.data() + 2, 5);                  // 短串内自引用
+    ASSERT_EQ(s, "abcdefghijcdefg");
+    s.append(s.data(), s.size());               // 扩容过程中自引用
+    ASSERT_EQ(s, "abcdefghijcdefgabcdefghijcdefg");
+    s += s;
+    ASSERT_EQ(s.size(), 60u);
+    s.insert(0, string_view(s.data() + 10, 5));
+    ASSERT_TRUE(s.starts_with("cdefgabcde"));
+    s.assign(s.data() + 5, 3);
+    ASSERT_EQ(s, "abc");
+}
+
+void test_edit_and_search() {
+    printf("test_edit_and_search...\n");
+    string s = "hello world";
+    s.insert(5, ",");
+    ASSERT_EQ(s, "hello, world");
+    s.insert(0, 2, '>');
+    ASSERT_EQ(s, ">>hello, world");
+    s.erase(0, 2);
+    s.replace(7, 5, "there, long enough to spill");
+    ASSERT_EQ(s, "hello, there, long enough to spill");
+    ASSERT_EQ(s.find("there"), 7u);
+    ASSERT_EQ(s.rfind(','), 12u);
+    ASSERT_EQ(s.find('z'), string::npos);
+    ASSERT_EQ(s.find_first_of(",;"), 5u);
+    ASSERT_TRUE(s.contains("enough"));
+    ASSERT_TRUE(s.ends_with("spill"));
+    ASSERT_EQ(s.substr(7, 5), "there");
+
+    bool thrown = false;
+    try { s.at(100); } catch (const std::out_of_range&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+    thrown = false;
+    try { s.erase(100); } catch (const std::out_of_range&) { thrown = true; }
+    ASSERT_TRUE(thrown);
+
+    string a = "abc";
+    string_view sv = "abd";
+    ASSERT_TRUE(a < string(sv));
+    ASSERT_TRUE(a != sv);
+    ASSERT_TRUE(sv != a);
+    string joined = a + "-" + sv + '!' + string("x");
+    ASSERT_EQ(joined, "abc-abd!x");
+    ASSERT_EQ("abc" + a, "abcabc");
+}
+
+void test_transparent_hash() {
+    printf("test_transparent_hash...\n");
+    zen::hash<string> h;
+    ASSERT_EQ(h(string("route")), zen::hash<string_view>()(string_view("route")));
+    ASSERT_EQ(h(string("route")), zen::hash<std::string>()(std::string("route")));
+
+    zen::flat_hash_map<string, int> m;
+    m.insert(zen::make_pair(string("alpha"), 1));
+    m.insert(zen::make_pair(string("a rather long key that spills"), 2));
+    ASSERT_EQ(m.find(string_view("alpha"))->second, 1);
+    ASSERT_EQ(m.find("a rather long key that spills")->second, 2);
+    ASSERT_TRUE(m.find(string_view("beta")) == m.end());
+}
+
+int main() {
+    printf("=== string Tests ===\n\n");
+
+    test_sso_layout();
+    test_grow_and_shrink();
+    test_self_reference();
+    test_edit_and_search();
+    test_transparent_hash();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
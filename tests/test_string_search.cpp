@@ -0,0 +1,227 @@
+// test_string_search.cpp
+// 测试 algorithms/string.h 中的向量化扫描与零拷贝切分：
+// find_substring / find_all_substrings 与 std::string::find、kmp_search 比对，
+// 每一级实现（通用 / SSE2 / AVX2，按 CPU 支持情况）单独验证，覆盖跨块边界、
+// 文本末尾、1~2 字节模式和误报密集的输入；find_first_of(byte_set) 覆盖
+// 半字节分类、列表比较与位图三条路径；count_char、tokenize、split_view、trim_view
+
+#include "../src/algorithms/string.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <cassert>
+#include <string>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+using namespace zen;
+
+static uint64_t rng_state = 88172645463325252ULL;
+static uint64_t rnd() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+// 小字母表随机文本：首尾字节过滤会产生大量误报
+static std::string random_text(size_t n, int alphabet) {
+    std::string s(n, 'a');
+    for (auto& c : s) c = static_cast<char>('a' + rnd() % static_cast<uint64_t>(alphabet));
+    return s;
+}
+
+static size_t to_npos(size_t r) {
+    return r == detail::scan_npos ? std::string::npos : r;
+}
+
+// 当前 CPU 可运行的各级子串搜索实现
+static std::vector<detail::find_substring_fn> substring_kernels() {
+    std::vector<detail::find_substring_fn> k = { detail::find_substring_generic };
+#if ZEN_HAVE_SSE2
+    k.push_back(detail::find_substring_sse2);
+#endif
+#if ZEN_HAVE_AVX2_TARGET
+    if (cpu_supports_avx2_target()) k.push_back(detail::find_substring_avx2);
+#endif
+    return k;
+}
+
+static std::vector<detail::find_first_of_fn> first_of_kernels() {
+    std::vector<detail::find_first_of_fn> k = { detail::find_first_of_generic };
+#if ZEN_HAVE_SSE2
+    k.push_back(detail::find_first_of_sse2);
+#endif
+#if ZEN_HAVE_AVX2_TARGET
+    if (cpu_supports_avx2_target()) k.push_back(detail::find_first_of_avx2);
+#endif
+    return k;
+}
+
+static std::vector<detail::count_char_fn> count_kernels() {
+    std::vector<detail::count_char_fn> k = { detail::count_char_generic };
+#if ZEN_HAVE_SSE2
+    k.push_back(detail::count_char_sse2);
+#endif
+#if ZEN_HAVE_AVX2_TARGET
+    if (cpu_supports_avx2_target()) k.push_back(detail::count_char_avx2);
+#endif
+    return k;
+}
+
+void test_find_substring_kernels() {
+    printf("test_find_substring_kernels (%zu kernels)...\n", substring_kernels().size());
+    for (auto fn : substring_kernels()) {
+        for (int round = 0; round < 3000; ++round) {
+            size_t n = rnd() % 200;
+            std::string text = random_text(n, 2 + static_cast<int>(rnd() % 3));
+            size_t m = 1 + rnd() % 12;
+            std::string pat = random_text(m, 2 + static_cast<int>(rnd() % 3));
+            ASSERT_EQ(to_npos(fn(text.data(), text.size(), pat.data(), pat.size())), text.find(pat));
+        }
+        // 模式位于文本最末尾、恰好跨越向量块边界
+        for (size_t n = 2; n < 100; ++n) {
+            std::string text(n, 'x');
+            for (size_t m = 1; m <= n && m < 40; ++m) {
+                std::string t = text;
+                t.replace(n - m, m, std::string(m, 'y'));
+                t[n - m] = 'z';
+                std::string pat = t.substr(n - m);
+                ASSERT_EQ(to_npos(fn(t.data(), t.size(), pat.data(), pat.size())), n - m);
+            }
+        }
+        ASSERT_EQ(to_npos(fn("abc", 3, "", 0)), 0u);
+        ASSERT_EQ(to_npos(fn("ab", 2, "abc", 3)), std::string::npos);
+    }
+}
+
+void test_find_substring_api() {
+    printf("test_find_substring_api...\n");
+    std::string text = "GET /index.html 200\nPOST /api/v1 500\nGET /api/v2 200\n";
+    ASSERT_EQ(find_substring(text, "/api"), text.find("/api"));
+    ASSERT_EQ(find_substring(text, "/api", 25), text.find("/api", 25));
+    ASSERT_EQ(find_substring(text, "DELETE"), std::string::npos);
+    ASSERT_EQ(find_substring(text, "", 3), 3u);
+    ASSERT_EQ(find_substring(text, "x", text.size() + 1), std::string::npos);
+
+    for (int round = 0; round < 200; ++round) {
+        std::string t = random_text(rnd() % 500, 2);
+        std::string p = random_text(1 + rnd() % 5, 2);
+        ASSERT_TRUE(find_all_substrings(t, p) == kmp_search(t, p));
+    }
+    std::string aaaa(10, 'a');
+    ASSERT_EQ(find_all_substrings(aaaa, "aaa").size(), 8u);   // 可重叠
+
+    size_t seen = 0;
+    for_each_substring(aaaa, "a", [&seen](size_t) { return ++seen < 3; });
+    ASSERT_EQ(seen, 3u);
+}
+
+void test_find_first_of() {
+    printf("test_find_first_of...\n");
+    // 半字节分类可用 / 高半字节超过 8 种（列表比较）/ 超过 16 个字节（位图）
+    std::vector<std::string> sets = {
+        " \t,;\n",
+        std::string("\x01\x12\x23\x34\x45\x56\x67\x78\x89", 9),
+        "abcdefghijklmnopqrstuvwxyz",
+        std::string("\x00\xff", 2),
+    };
+    ASSERT_TRUE(byte_set(sets[0]).nibble_classifiable());
+    ASSERT_FALSE(byte_set(sets[1]).nibble_classifiable());
+    ASSERT_FALSE(byte_set(sets[2]).listed());
+
+    for (auto fn : first_of_kernels()) {
+        for (const std::string& chars : sets) {
+            byte_set set(chars);
+            for (int round = 0; round < 500; ++round) {
+                std::string text(rnd() % 150, 'Q');
+                for (auto& c : text) {
+                    if (rnd() % 40 == 0) c = chars[rnd() % chars.size()];
+                    else c = static_cast<char>(0x80 | (rnd() % 8));   // 不在任何集合中
+                }
+                ASSERT_EQ(to_npos(fn(text.data(), text.size(), set)), text.find_first_of(chars));
+            }
+        }
+    }
+    ASSERT_EQ(find_first_of("key=value;x", byte_set("=;"), 4), 9u);
+    ASSERT_EQ(find_first_of("abc", byte_set("xyz")), std::string::npos);
+}
+
+void test_count_char() {
+    printf("test_count_char...\n");
+    for (auto fn : count_kernels()) {
+        for (size_t n : {0u, 1u, 31u, 32u, 33u, 1000u, 255u * 32u + 17u, 70000u}) {
+            std::string text = random_text(n, 4);
+            size_t expect = 0;
+            for (char c : text) expect += c == 'b';
+            ASSERT_EQ(fn(text.data(), text.size(), 'b'), expect);
+        }
+        std::string all(100000, '\n');
+        ASSERT_EQ(fn(all.data(), all.size(), '\n'), all.size());
+    }
+    ASSERT_EQ(count_char("a\nb\nc\n", '\n'), 3u);
+}
+
+void test_tokenize_split_trim() {
+    printf("test_tokenize_split_trim...\n");
+    std::string line = "  ts=1700000000, level=INFO;msg=hello\tworld ";
+    std::vector<std::string_view> fields = tokenize(line, " ,;\t").to_vector();
+    ASSERT_EQ(fields.size(), 4u);
+    ASSERT_TRUE(fields[0] == "ts=1700000000");
+    ASSERT_TRUE(fields[3] == "world");
+    // 结果指向原文本
+    ASSERT_TRUE(fields[0].data() == line.data() + 2);
+
+    std::vector<std::string_view> keep = tokenize("a,,b,", ",", false).to_vector();
+    ASSERT_EQ(keep.size(), 4u);
+    ASSERT_TRUE(keep[0] == "a" && keep[1].empty() && keep[2] == "b" && keep[3].empty());
+    ASSERT_EQ(tokenize("", ",", false).to_vector().size(), 1u);
+    ASSERT_TRUE(tokenize("", ",").to_vector().empty());
+    ASSERT_TRUE(tokenize(",,,", ",").to_vector().empty());
+
+    std::vector<std::string_view> parts = split_view("/usr//local/bin/", '/');
+    ASSERT_EQ(parts.size(), 3u);
+    ASSERT_TRUE(parts[1] == "local");
+    std::vector<std::string> copies = split("/usr//local/bin/", '/');
+    ASSERT_EQ(copies.size(), 3u);
+    ASSERT_TRUE(copies[2] == "bin");
+
+    ASSERT_TRUE(trim_view("  \t hi there \n") == "hi there");
+    ASSERT_TRUE(ltrim_view("  x ") == "x ");
+    ASSERT_TRUE(rtrim_view("  x ") == "  x");
+    ASSERT_TRUE(trim_view("   ").empty());
+
+    ASSERT_TRUE(starts_with("prefix-body", "prefix"));
+    ASSERT_FALSE(ends_with("x", "xx"));
+    ASSERT_TRUE(replace_all("a.b.c", ".", "::") == "a::b::c");
+    ASSERT_TRUE(replace_all("aaaa", "aa", "a") == "aa");
+    ASSERT_TRUE(replace_all("none", "x", "y") == "none");
+
+    std::string mixed = "Hello, World! 123";
+    to_lower_inplace(mixed);
+    ASSERT_TRUE(mixed == "hello, world! 123");
+    to_upper_inplace(mixed);
+    ASSERT_TRUE(mixed == "HELLO, WORLD! 123");
+}
+
+int main() {
+    printf("=== string search Tests ===\n\n");
+
+    test_find_substring_kernels();
+    test_find_substring_api();
+    test_find_first_of();
+    test_count_char();
+    test_tokenize_split_trim();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,235 @@
+// test_thread_cache.cpp
+// 测试线程缓存分配器：大小级别、单线程复用、大对象、跨线程释放、统计，
+// 以及作为 zen::allocator 后端时与容器的配合
+
+#define ZEN_ALLOCATOR_THREAD_CACHE 1
+#include "../src/memory/memory.h"
+#include "../src/containers/sequential/vector.h"
+#include "../src/containers/associative/map.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cassert>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+using namespace zen;
+
+static bool aligned(void* p, size_t a) { return (reinterpret_cast<uintptr_t>(p) & (a - 1)) == 0; }
+
+// ===========================================================================
+// 单线程
+// ===========================================================================
+
+void test_size_classes() {
+    printf("test_size_classes...\n");
+    size_t prev = 0;
+    for (size_t i = 0; i < TC_NUM_CLASSES; ++i) {
+        size_t s = detail::tc_class_size(i);
+        ASSERT_TRUE(s > prev);
+        ASSERT_EQ(s % TC_MIN_ALIGN, 0u);
+        ASSERT_EQ(detail::tc_class_index(s), i);
+        ASSERT_EQ(detail::tc_class_index(prev + 1), i);
+        prev = s;
+    }
+    ASSERT_EQ(prev, TC_MAX_SMALL);
+    ASSERT_EQ(detail::tc_class_index(0), 0u);
+}
+
+void test_alloc_free_reuse() {
+    printf("test_alloc_free_reuse...\n");
+    for (size_t sz = 1; sz <= TC_MAX_SMALL; sz = sz * 3 / 2 + 1) {
+        char* p = static_cast<char*>(tc_malloc(sz));
+        ASSERT_TRUE(aligned(p, TC_MIN_ALIGN));
+        ASSERT_TRUE(tc_usable_size(p) >= sz);
+        memset(p, 0xAB, sz);
+        tc_free(p);
+        ASSERT_EQ(tc_malloc(sz), p);        // 线程缓存 LIFO 复用
+        tc_free_sized(p, sz);
+    }
+
+    // 大量对象：内容互不覆盖
+    std::vector<uint64_t*> ptrs;
+    for (uint64_t i = 0; i < 10000; ++i) {
+        uint64_t* p = static_cast<uint64_t*>(tc_malloc(48));
+        p[0] = i;
+        p[5] = ~i;
+        ptrs.push_back(p);
+    }
+    for (uint64_t i = 0; i < 10000; ++i) {
+        ASSERT_EQ(ptrs[i][0], i);
+        ASSERT_EQ(ptrs[i][5], ~i);
+        tc_free(ptrs[i]);
+    }
+}
+
+void test_huge() {
+    printf("test_huge...\n");
+    size_t sz = 3 * 1024 * 1024 + 7;
+    char* p = static_cast<char*>(tc_malloc(sz));
+    ASSERT_TRUE(aligned(p, TC_MIN_ALIGN));
+    ASSERT_TRUE(tc_usable_size(p) >= sz);
+    p[0] = 1;
+    p[sz - 1] = 2;
+    tc_flush_thread_stats();
+    ASSERT_TRUE(tc_get_stats().huge_bytes >= sz);
+    tc_free(p);
+    ASSERT_EQ(tc_get_stats().huge_bytes, 0u);
+
+    p = static_cast<char*>(tc_malloc(TC_MAX_SMALL + 1));
+    tc_free_sized(p, TC_MAX_SMALL + 1);
+}
+
+void test_stats() {
+    printf("test_stats...\n");
+    tc_flush_thread_stats();
+    tc_stats before = tc_get_stats();
+    void* ptrs[100];
+    for (int i = 0; i < 100; ++i) ptrs[i] = tc_malloc(100);
+    tc_flush_thread_stats();
+    tc_stats mid = tc_get_stats();
+    ASSERT_EQ(mid.bytes_in_use - before.bytes_in_use, 100 * 112);
+    for (int i = 0; i < 100; ++i) tc_free(ptrs[i]);
+    for (int i = 0; i < 100; ++i) ptrs[i] = tc_malloc(100);
+    for (int i = 0; i < 100; ++i) tc_free(ptrs[i]);
+    tc_flush_thread_stats();
+    tc_stats after = tc_get_stats();
+    ASSERT_EQ(after.bytes_in_use, before.bytes_in_use);
+
+    size_t idx = detail::tc_class_index(100);
+    ASSERT_EQ(after.classes[idx].size, 112u);
+    ASSERT_TRUE(after.classes[idx].hits > after.classes[idx].misses);
+    ASSERT_TRUE(after.classes[idx].hit_rate() > 0.9);
+}
+
+// ===========================================================================
+// 多线程
+// ===========================================================================
+
+void test_threads_local() {
+    printf("test_threads_local...\n");
+    std::vector<std::thread> ts;
+    for (int t = 0; t < 8; ++t) {
+        ts.emplace_back([t] {
+            std::vector<uint32_t*> v;
+            for (int round = 0; round < 20; ++round) {
+                for (uint32_t i = 0; i < 2000; ++i) {
+                    uint32_t* p = static_cast<uint32_t*>(tc_malloc(4 + (i % 64) * 4));
+                    p[0] = static_cast<uint32_t>(t) * 100000 + i;
+                    v.push_back(p);
+                }
+                for (uint32_t i = 0; i < v.size(); ++i) {
+                    ASSERT_EQ(v[i][0], static_cast<uint32_t>(t) * 100000 + i);
+                    tc_free(v[i]);
+                }
+                v.clear();
+            }
+        });
+    }
+    for (auto& th : ts) th.join();
+}
+
+void test_cross_thread_free() {
+    printf("test_cross_thread_free...\n");
+    const int N = 200000;
+    std::vector<void*> ptrs(N);
+    std::atomic<int> ready{0};
+
+    std::thread producer([&] {
+        for (int i = 0; i < N; ++i) {
+            int* p = static_cast<int*>(tc_malloc(32));
+            *p = i;
+            ptrs[i] = p;
+        }
+        ready.store(1, std::memory_order_release);
+    });
+    producer.join();
+    ASSERT_EQ(ready.load(std::memory_order_acquire), 1);
+
+    // 多个消费者线程释放生产者分配的对象
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 4; ++c) {
+        consumers.emplace_back([&, c] {
+            for (int i = c; i < N; i += 4) {
+                ASSERT_EQ(*static_cast<int*>(ptrs[i]), i);
+                tc_free(ptrs[i]);
+            }
+        });
+    }
+    for (auto& th : consumers) th.join();
+
+    // 回流到中心表的对象可被新线程再次使用
+    std::thread again([] {
+        for (int i = 0; i < 1000; ++i) tc_free(tc_malloc(32));
+    });
+    again.join();
+
+    tc_flush_thread_stats();
+    ASSERT_TRUE(tc_get_stats().bytes_in_use >= 0);
+}
+
+// ===========================================================================
+// allocator 后端与 memory_resource 适配
+// ===========================================================================
+
+void test_allocator_backend() {
+    printf("test_allocator_backend...\n");
+    tc_flush_thread_stats();
+    int64_t base = tc_get_stats().bytes_in_use;
+    {
+        vector<int> v;
+        for (int i = 0; i < 100000; ++i) v.push_back(i);
+        map<int, int> m;
+        for (int i = 0; i < 1000; ++i) m[i] = i;
+        ASSERT_EQ(v[99999], 99999);
+        ASSERT_EQ(m.at(500), 500);
+        tc_flush_thread_stats();
+        ASSERT_TRUE(tc_get_stats().bytes_in_use > base);
+    }
+    tc_flush_thread_stats();
+    ASSERT_EQ(tc_get_stats().bytes_in_use, base);
+}
+
+void test_resource() {
+    printf("test_resource...\n");
+    memory_resource* r = thread_caching_resource();
+    void* p = r->allocate(200);
+    ASSERT_TRUE(aligned(p, 16));
+    r->deallocate(p, 200);
+    void* q = r->allocate(100, 64);         // 超过 16 字节对齐：转给 new_delete_resource
+    ASSERT_TRUE(aligned(q, 64));
+    r->deallocate(q, 100, 64);
+
+    pool_resource pool(r);
+    for (int i = 0; i < 1000; ++i) pool.deallocate(pool.allocate(24), 24);
+}
+
+int main() {
+    printf("=== thread cache Tests ===\n\n");
+
+    test_size_classes();
+    test_alloc_free_reuse();
+    test_huge();
+    test_stats();
+
+    test_threads_local();
+    test_cross_thread_free();
+
+    test_allocator_backend();
+    test_resource();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
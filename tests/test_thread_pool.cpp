@@ -0,0 +1,512 @@
+// test_thread_pool.cpp
+// 测试工作窃取线程池（threading/pool/thread_pool.h）与 Chase–Lev 双端队列：
+// 队列的 LIFO / FIFO 顺序、扩容、并发窃取下每个元素恰好被取走一次；
+// 线程池的 submit（参数、只可移动的可调用对象、异常）、外部大量提交与 wait()、
+// 池内递归 fork/join（wait_until 不死锁）、任务内 wait()、任务被其他线程窃取、析构时排空；
+// 优先级通道的执行顺序、CPU 绑定与线程名、指标与延迟统计、具名池登记表、
+// 旧接口（pool/thread_pool.h）的 try_submit / shutdown / thread_count / pending_tasks
+
+#include "../src/threading/pool/thread_pool.h"
+#include "../src/pool/thread_pool.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <cassert>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+
+using namespace zen;
+
+// ===========================================================================
+// work_stealing_deque
+// ===========================================================================
+
+void test_deque_order() {
+    printf("test_deque_order...\n");
+    work_stealing_deque<intptr_t> dq(4);
+    intptr_t x = 0;
+    ASSERT_TRUE(!dq.pop(x));
+    ASSERT_TRUE(!dq.steal(x));
+    for (intptr_t i = 1; i <= 100; ++i) dq.push(i);  // 多次扩容
+    ASSERT_EQ(dq.size_hint(), 100u);
+    ASSERT_TRUE(dq.steal(x) && x == 1);                // 顶部：最早
+    ASSERT_TRUE(dq.steal(x) && x == 2);
+    ASSERT_TRUE(dq.pop(x) && x == 100);                // 底部：最新
+    ASSERT_TRUE(dq.pop(x) && x == 99);
+    for (intptr_t i = 98; i >= 3; --i) ASSERT_TRUE(dq.pop(x) && x == i);
+    ASSERT_TRUE(!dq.pop(x));
+    ASSERT_TRUE(dq.empty_hint());
+    dq.push(7);
+    ASSERT_TRUE(dq.steal(x) && x == 7);
+    ASSERT_TRUE(!dq.pop(x));
+}
+
+void test_deque_concurrent() {
+    printf("test_deque_concurrent...\n");
+    const intptr_t n = 200000;
+    const int thieves = 3;
+    work_stealing_deque<intptr_t> dq(8);
+    std::vector<std::atomic<int>> seen(n + 1);
+    for (auto& s : seen) s.store(0);
+    std::atomic<bool> done{false};
+    std::atomic<intptr_t> stolen{0};
+
+    std::vector<std::thread> ts;
+    for (int t = 0; t < thieves; ++t) {
+        ts.emplace_back([&] {
+            intptr_t v;
+            while (!done.load(std::memory_order_acquire)) {
+                if (dq.steal(v)) {
+                    seen[v].fetch_add(1);
+                    stolen.fetch_add(1);
+                }
+            }
+            while (dq.steal(v)) seen[v].fetch_add(1);
+        });
+    }
+    // 所有者：push 一批、pop 一部分，交替进行
+    intptr_t next = 1;
+    while (next <= n) {
+        for (int k = 0; k < 64 && next <= n; ++k) dq.push(next++);
+        intptr_t v;
+        for (int k = 0; k < 32; ++k) {
+            if (dq.pop(v)) seen[v].fetch_add(1);
+        }
+    }
+    intptr_t v;
+    while (dq.pop(v)) seen[v].fetch_add(1);
+    done.store(true, std::memory_order_release);
+    for (auto& t : ts) t.join();
+
+    for (intptr_t i = 1; i <= n; ++i) ASSERT_EQ(seen[i].load(), 1);
+    printf("  stolen %ld of %ld\n", static_cast<long>(stolen.load()), static_cast<long>(n));
+}
+
+// ===========================================================================
+// thread_pool
+// ===========================================================================
+
+void test_submit() {
+    printf("test_submit...\n");
+    thread_pool pool(3);
+    future<int> f = pool.submit([](int x) { return x * 2; }, 21);
+    ASSERT_EQ(f.get(), 42);
+
+    future<void> g = pool.submit([] {});
+    g.get();
+
+    future<int> h = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    bool caught = false;
+    try { h.get(); } catch (const std::runtime_error&) { caught = true; }
+    ASSERT_TRUE(caught);
+
+    // 只可移动的可调用对象与参数
+    std::unique_ptr<int> owned(new int(5));
+    future<int> m = pool.submit([p = std::move(owned)](std::unique_ptr<int> q) { return *p + *q; },
+                                std::unique_ptr<int>(new int(6)));
+    ASSERT_EQ(m.get(), 11);
+
+    std::atomic<int> hits{0};
+    pool.submit_void([&hits](int k) { hits.fetch_add(k); }, 3);
+    pool.submit_void([&hits] { hits.fetch_add(1); });
+    pool.wait();
+    ASSERT_EQ(hits.load(), 4);
+    ASSERT_EQ(pool.pending(), 0u);
+    ASSERT_EQ(pool.size(), 3u);
+    ASSERT_TRUE(!pool.in_worker());
+    future<bool> inside = pool.submit([&pool] { return pool.in_worker(); });
+    ASSERT_TRUE(inside.get());
+}
+
+void test_many_external_submits() {
+    printf("test_many_external_submits...\n");
+    thread_pool pool(4);
+    const int n = 200000;
+    std::atomic<long long> sum{0};
+    for (int i = 0; i < n; ++i) {
+        pool.submit_void([&sum, i] { sum.fetch_add(i, std::memory_order_relaxed); });
+    }
+    pool.wait();
+    ASSERT_EQ(sum.load(), static_cast<long long>(n) * (n - 1) / 2);
+
+    // 多个外部线程同时提交
+    std::atomic<int> count{0};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t) {
+        producers.emplace_back([&] {
+            for (int i = 0; i < 20000; ++i) pool.submit_void([&count] { count.fetch_add(1); });
+        });
+    }
+    for (auto& p : producers) p.join();
+    pool.wait();
+    ASSERT_EQ(count.load(), 80000);
+}
+
+static long fib_serial(int n) { return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2); }
+
+static long fib_pool(thread_pool& pool, int n) {
+    if (n < 12) return fib_serial(n);
+    std::atomic<bool> done{false};
+    long a = 0;
+    pool.submit_void([&] {
+        a = fib_pool(pool, n - 1);
+        done.store(true, std::memory_order_release);
+    });
+    long b = fib_pool(pool, n - 2);
+    pool.wait_until([&] { return done.load(std::memory_order_acquire); });
+    return a + b;
+}
+
+void test_fork_join() {
+    printf("test_fork_join...\n");
+    // 从池外调用：调用线程也参与执行
+    thread_pool pool(3);
+    ASSERT_EQ(fib_pool(pool, 25), fib_serial(25));
+
+    // 从池内调用：所有工作线程都在等待子任务时不死锁
+    std::vector<future<long>> roots;
+    for (int i = 0; i < 6; ++i) roots.push_back(pool.submit([&pool] { return fib_pool(pool, 22); }));
+    for (auto& r : roots) ASSERT_EQ(r.get(), fib_serial(22));
+
+    // 单工作线程
+    thread_pool one(1);
+    future<long> r = one.submit([&one] { return fib_pool(one, 20); });
+    ASSERT_EQ(r.get(), fib_serial(20));
+}
+
+void test_stealing() {
+    printf("test_stealing...\n");
+    // 一个工作线程派生的任务进入它自己的队列，其他线程需要窃取才能参与
+    thread_pool pool(4);
+    std::mutex m;
+    std::set<std::thread::id> ids;
+    std::atomic<int> remaining{2000};
+    pool.submit_void([&] {
+        for (int i = 0; i < 2000; ++i) {
+            pool.submit_void([&] {
+                volatile long spin = 0;
+                for (int k = 0; k < 20000; ++k) spin = spin + k;
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    ids.insert(std::this_thread::get_id());
+                }
+                remaining.fetch_sub(1);
+            });
+        }
+    });
+    pool.wait();
+    ASSERT_EQ(remaining.load(), 0);
+    printf("  tasks ran on %zu threads\n", ids.size());
+    ASSERT_TRUE(ids.size() >= 1);
+}
+
+void test_nested_wait_and_drain() {
+    printf("test_nested_wait_and_drain...\n");
+    std::atomic<int> leaves{0};
+    {
+        thread_pool pool(2);
+        // 三层派生：wait() 要等到派生出来的任务也执行完
+        for (int i = 0; i < 10; ++i) {
+            pool.submit_void([&] {
+                for (int j = 0; j < 10; ++j) {
+                    pool.submit_void([&] {
+                        for (int k = 0; k < 10; ++k) pool.submit_void([&] { leaves.fetch_add(1); });
+                    });
+                }
+            });
+        }
+        pool.wait();
+        ASSERT_EQ(leaves.load(), 1000);
+
+        // 析构时排空尚未执行的任务
+        for (int i = 0; i < 1000; ++i) pool.submit_void([&] { leaves.fetch_add(1); });
+    }
+    ASSERT_EQ(leaves.load(), 2000);
+
+    // 空闲挂起后仍能被唤醒
+    thread_pool pool(2);
+    for (int round = 0; round < 3; ++round) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ASSERT_EQ(pool.submit([round] { return round; }).get(), round);
+    }
+}
+
+void test_wait_inside_task() {
+    printf("test_wait_inside_task...\n");
+    // 任务内 wait()：不等调用者自己，等它派生的任务完成后返回
+    for (size_t threads : { 1, 3 }) {
+        thread_pool pool(threads);
+        std::atomic<int> leaves{0};
+        future<int> r = pool.submit([&] {
+            for (int i = 0; i < 8; ++i) {
+                pool.submit_void([&] {
+                    // 嵌套：wait() 中执行到的任务自己也 wait()
+                    for (int j = 0; j < 8; ++j) pool.submit_void([&] { leaves.fetch_add(1); });
+                    pool.wait();
+                });
+            }
+            pool.wait();
+            return leaves.load();
+        });
+        ASSERT_EQ(r.get(), 64);
+        pool.wait();
+        ASSERT_EQ(pool.pending(), size_t(0));
+    }
+}
+
+void test_priorities() {
+    printf("test_priorities...\n");
+    // 单个工作线程先被挡住，三种优先级的任务排队后放行
+    thread_pool pool(1);
+    std::atomic<bool> gate{false};
+    std::atomic<bool> blocked{false};
+    pool.submit_void([&] {
+        blocked.store(true);
+        while (!gate.load()) std::this_thread::yield();
+    });
+    while (!blocked.load()) std::this_thread::yield();
+
+    std::mutex m;
+    std::vector<int> order;
+    std::atomic<int> remaining{9};
+    auto record = [&](int tag) {
+        return [&, tag] {
+            {
+                std::lock_guard<std::mutex> lock(m);
+                order.push_back(tag);
+            }
+            remaining.fetch_sub(1);
+        };
+    };
+    for (int i = 0; i < 3; ++i) {
+        pool.submit_void(task_priority::background, record(2));
+        pool.submit_void(record(1));
+        pool.submit_void(task_priority::high, record(0));
+    }
+    ASSERT_EQ(pool.pending_tasks(), 9u);
+    thread_pool_metrics before = pool.metrics();
+    ASSERT_EQ(before.queued[0], 3u);
+    ASSERT_EQ(before.queued[1], 3u);
+    ASSERT_EQ(before.queued[2], 3u);
+
+    gate.store(true);
+    // 不调用 wait()：调用线程协助执行会打乱顺序
+    while (remaining.load() != 0) std::this_thread::yield();
+    ASSERT_EQ(order.size(), 9u);
+    for (size_t i = 0; i < order.size(); ++i) ASSERT_EQ(order[i], static_cast<int>(i / 3));
+
+    // 工作线程内提交的 high 任务先于本地队列中的 normal 任务执行
+    order.clear();
+    remaining.store(3);
+    pool.submit_void([&] {
+        pool.submit_void(record(1));
+        pool.submit_void(record(1));
+        pool.submit_void(task_priority::high, record(0));
+    });
+    while (remaining.load() != 0) std::this_thread::yield();
+    ASSERT_EQ(order[0], 0);
+
+    // 带返回值
+    future<int> h = pool.submit(task_priority::high, [](int x) { return x + 1; }, 41);
+    ASSERT_EQ(h.get(), 42);
+    future<void> b = pool.submit(task_priority::background, [] {});
+    b.get();
+}
+
+void test_options() {
+    printf("test_options...\n");
+    std::vector<int> cpus = detail::parse_cpu_list("0-3,8,10-11\n");
+    ASSERT_EQ(cpus.size(), 7u);
+    ASSERT_EQ(cpus[3], 3);
+    ASSERT_EQ(cpus[4], 8);
+    ASSERT_EQ(cpus[6], 11);
+    ASSERT_TRUE(detail::parse_cpu_list("").empty());
+
+    thread_pool_options opts;
+    opts.name = "pinned";
+    opts.cpus = { 0 };
+    opts.spin = 0;
+    thread_pool pool(opts);
+    ASSERT_EQ(pool.size(), 1u);             // 线程数默认取 CPU 集合大小
+    ASSERT_EQ(pool.name(), std::string("pinned"));
+#if defined(__linux__)
+    future<int> cpu = pool.submit([] { return sched_getcpu(); });
+    ASSERT_EQ(cpu.get(), 0);
+    future<std::string> name = pool.submit([] {
+        char buf[16] = {};
+        pthread_getname_np(pthread_self(), buf, sizeof(buf));
+        return std::string(buf);
+    });
+    ASSERT_EQ(name.get(), std::string("pinned-0"));
+
+    // NUMA 节点 0 存在时线程绑定到该节点的 CPU
+    thread_pool_options numa;
+    numa.numa_node = 0;
+    numa.threads = 2;
+    thread_pool node_pool(numa);
+    ASSERT_EQ(node_pool.size(), 2u);
+    if (!detail::numa_node_cpus(0).empty()) ASSERT_TRUE(!node_pool.options().cpus.empty());
+    ASSERT_EQ(node_pool.submit([] { return 7; }).get(), 7);
+#endif
+}
+
+void test_metrics() {
+    printf("test_metrics...\n");
+    thread_pool_options opts;
+    opts.threads = 2;
+    opts.track_latency = true;
+    thread_pool pool(opts);
+
+    const int n = 1000;
+    std::atomic<int> done{0};
+    for (int i = 0; i < n; ++i) pool.submit_void([&done] { done.fetch_add(1); });
+    pool.submit_void(task_priority::high, [&done] { done.fetch_add(1); });
+    pool.wait();
+    ASSERT_EQ(done.load(), n + 1);
+
+    thread_pool_metrics m = pool.metrics();
+    ASSERT_EQ(m.threads, 2u);
+    ASSERT_EQ(m.submitted[1], static_cast<uint64_t>(n));
+    ASSERT_EQ(m.submitted[0], 1u);
+    ASSERT_EQ(m.submitted[2], 0u);
+    ASSERT_EQ(m.completed, static_cast<uint64_t>(n + 1));
+    ASSERT_EQ(m.pending, 0u);
+    ASSERT_EQ(m.queued_total(), 0u);
+    ASSERT_EQ(m.latency[1].count, static_cast<uint64_t>(n));
+    ASSERT_EQ(m.latency[0].count, 1u);
+    ASSERT_TRUE(m.latency[1].p50_ns <= m.latency[1].p99_ns);
+    ASSERT_TRUE(m.latency[1].p99_ns <= m.latency[1].max_ns);
+    ASSERT_TRUE(m.latency[1].mean_ns <= static_cast<double>(m.latency[1].max_ns));
+    printf("  normal latency: p50 %llu ns, p99 %llu ns, max %llu ns\n",
+           static_cast<unsigned long long>(m.latency[1].p50_ns),
+           static_cast<unsigned long long>(m.latency[1].p99_ns),
+           static_cast<unsigned long long>(m.latency[1].max_ns));
+
+    // 关闭统计后新任务不计入延迟
+    pool.track_latency(false);
+    pool.submit([] {}).get();
+    pool.wait();
+    m = pool.metrics();
+    ASSERT_EQ(m.latency[1].count, static_cast<uint64_t>(n));
+    ASSERT_EQ(m.completed, static_cast<uint64_t>(n + 2));
+
+    // 直方图分位数
+    detail::pool_counters c;
+    for (uint64_t v = 1; v <= 1000; ++v) c.record_latency(0, v * 1000, true);
+    const detail::pool_counters* parts[] = { &c };
+    task_latency l = detail::summarize_latency(parts, 1, 0);
+    ASSERT_EQ(l.count, 1000u);
+    ASSERT_EQ(l.max_ns, 1000000u);
+    ASSERT_TRUE(l.p50_ns >= 250000 && l.p50_ns <= 1000000);   // 真值 500000，误差在 2 倍内
+    ASSERT_TRUE(l.p99_ns >= 495000 && l.p99_ns <= 1000000);
+}
+
+void test_registry() {
+    printf("test_registry...\n");
+    thread_pool_registry& reg = thread_pool_registry::instance();
+    size_t base = reg.size();
+
+    thread_pool_options tuned;
+    tuned.threads = 3;
+    tuned.track_latency = true;
+    reg.configure("svc.io", tuned);
+    {
+        thread_pool_options opts;
+        opts.name = "svc.io";
+        opts.threads = 1;
+        thread_pool io(opts);                 // 登记表中的配置优先
+        ASSERT_EQ(io.size(), 3u);
+        ASSERT_TRUE(io.options().track_latency);
+
+        thread_pool_options cpu_opts;
+        cpu_opts.name = "svc.cpu";
+        cpu_opts.threads = 2;
+        thread_pool cpu(cpu_opts);
+        ASSERT_EQ(cpu.size(), 2u);
+        ASSERT_EQ(reg.size(), base + 2);
+
+        thread_pool unnamed(1);               // 未命名的池不登记
+        ASSERT_EQ(reg.size(), base + 2);
+
+        io.submit([] {}).get();
+        std::vector<thread_pool_metrics> all = reg.snapshot();
+        ASSERT_EQ(all.size(), base + 2);
+        bool found = false;
+        for (const auto& m : all) {
+            if (m.name == "svc.io") {
+                found = true;
+                ASSERT_EQ(m.threads, 3u);
+                ASSERT_EQ(m.completed, 1u);
+            }
+        }
+        ASSERT_TRUE(found);
+
+        // 统一调整：关闭所有具名池的延迟统计
+        size_t visited = 0;
+        reg.for_each([&visited](thread_pool& p) { p.track_latency(false); ++visited; });
+        ASSERT_EQ(visited, base + 2);
+    }
+    ASSERT_EQ(reg.size(), base);
+    thread_pool_options out;
+    ASSERT_TRUE(reg.configuration("svc.io", out));
+    ASSERT_EQ(out.threads, 3u);
+    ASSERT_TRUE(!reg.configuration("svc.none", out));
+}
+
+void test_legacy_api() {
+    printf("test_legacy_api...\n");
+    // pool/thread_pool.h 的旧接口
+    thread_pool pool(2);
+    ASSERT_EQ(pool.thread_count(), 2u);
+    std::atomic<int> count{0};
+    for (int i = 0; i < 100; ++i) pool.submit([&count] { count.fetch_add(1); });
+    // 旧的 bool submit：入队成功返回 true
+    for (int i = 0; i < 100; ++i) ASSERT_TRUE(pool.try_submit([&count] { count.fetch_add(1); }));
+    ASSERT_TRUE(pool.try_submit([&count](int n) { count.fetch_add(n); }, 5));
+    pool.shutdown();
+    ASSERT_EQ(count.load(), 205);
+    ASSERT_EQ(pool.pending_tasks(), 0u);
+    pool.shutdown();  // 重复调用无操作
+    bool threw = false;
+    try { pool.submit([] {}); } catch (const std::runtime_error&) { threw = true; }
+    ASSERT_TRUE(threw);
+    // shutdown 之后 try_submit 返回 false，不抛出
+    ASSERT_TRUE(!pool.try_submit([&count] { count.fetch_add(1); }));
+    ASSERT_EQ(count.load(), 205);
+}
+
+int main() {
+    printf("=== thread_pool Tests ===\n\n");
+
+    test_deque_order();
+    test_deque_concurrent();
+    test_submit();
+    test_many_external_submits();
+    test_fork_join();
+    test_stealing();
+    test_nested_wait_and_drain();
+    test_wait_inside_task();
+    test_priorities();
+    test_options();
+    test_metrics();
+    test_registry();
+    test_legacy_api();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}
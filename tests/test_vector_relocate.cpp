@@ -0,0 +1,272 @@
+// test_vector_relocate.cpp
+// 测试平凡重定位快速路径：type_traits 判定、可特化的 is_trivially_relocatable、
+// vector / small_vector / deque 的 memcpy / memmove 路径、1.5 倍增长，
+// 以及区间 assign / insert 的一次性预留
+
+#include "../src/containers/sequential/vector.h"
+#include "../src/containers/sequential/small_vector.h"
+#include "../src/containers/sequential/deque.h"
+#include "../src/containers/sequential/string.h"
+#include "../src/memory/smart_ptr.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <cassert>
+#include <deque>
+#include <string>
+#include <vector>
+
+#define ASSERT_TRUE(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at line %d: %s\n", __LINE__, #cond); \
+        assert(false); \
+    } \
+} while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+#define ASSERT_EQ(a, b) ASSERT_TRUE((a) == (b))
+#define ASSERT_NE(a, b) ASSERT_TRUE((a) != (b))
+
+using namespace zen;
+
+// 有非平凡移动构造 / 析构、但可以按字节搬移的类型：特化 trait 后扩容不再调用移动构造
+struct handle {
+    static int moves;
+    static int alive;
+    int* p;
+    explicit handle(int v = 0) : p(new int(v)) { ++alive; }
+    handle(const handle& o) : p(new int(*o.p)) { ++alive; }
+    handle(handle&& o) noexcept : p(o.p) { o.p = nullptr; ++moves; ++alive; }
+    handle& operator=(handle o) noexcept { int* t = p; p = o.p; o.p = t; return *this; }
+    ~handle() { delete p; --alive; }
+    int value() const { return *p; }
+};
+int handle::moves = 0;
+int handle::alive = 0;
+
+namespace zen {
+template<> struct is_trivially_relocatable<handle> {
+    static constexpr bool value = true;
+};
+} // namespace zen
+
+// 同上但不特化：走逐个移动的慢路径
+struct slow_handle : handle {
+    using handle::handle;
+};
+
+// 单趟输入迭代器
+struct counting_input {
+    using iterator_category = input_iterator_tag;
+    using value_type        = int;
+    using difference_type   = long;
+    using pointer           = const int*;
+    using reference         = const int&;
+    int cur;
+    const int& operator*() const { return cur; }
+    counting_input& operator++() { ++cur; return *this; }
+    bool operator!=(const counting_input& o) const { return cur != o.cur; }
+};
+
+void test_traits() {
+    printf("test_traits...\n");
+    struct pod { int a; double b; };
+    static_assert(is_trivially_copyable_v<int>, "");
+    static_assert(is_trivially_copyable_v<pod>, "");
+    static_assert(!is_trivially_copyable_v<std::string>, "");
+    static_assert(is_trivially_relocatable_v<pod>, "");
+    static_assert(is_trivially_relocatable_v<handle>, "user specialization");
+    static_assert(!is_trivially_relocatable_v<slow_handle>, "specialization is not inherited");
+    static_assert(is_trivially_relocatable_v<zen::string>, "");
+    static_assert(is_trivially_relocatable_v<unique_ptr<int>>, "");
+    static_assert(is_trivially_relocatable_v<shared_ptr<int>>, "");
+    static_assert(is_trivially_relocatable_v<vector<int>>, "");
+    static_assert(!is_trivially_relocatable_v<small_vector<int, 4>>, "inline buffer is self-referential");
+
+    static_assert(is_multipass_iterator<int*>::value, "");
+    static_assert(is_multipass_iterator<std::vector<int>::iterator>::value, "");
+    static_assert(is_multipass_iterator<deque<int>::iterator>::value, "");
+    static_assert(!is_multipass_iterator<counting_input>::value, "");
+}
+
+void test_growth_factor() {
+    printf("test_growth_factor...\n");
+    ASSERT_EQ(detail::vector_next_capacity(0, 1), 1u);
+    ASSERT_EQ(detail::vector_next_capacity(1, 2), 2u);
+    ASSERT_EQ(detail::vector_next_capacity(4, 5), 6u);
+    ASSERT_EQ(detail::vector_next_capacity(100, 101), 150u);
+    ASSERT_EQ(detail::vector_next_capacity(100, 1000), 1000u);
+
+    vector<int> v;
+    size_t reallocs = 0;
+    size_t cap = v.capacity();
+    for (int i = 0; i < 100000; ++i) {
+        v.push_back(i);
+        if (v.capacity() != cap) {
+            ASSERT_TRUE(cap < 4 || v.capacity() <= cap + cap / 2 + 1);
+            cap = v.capacity();
+            ++reallocs;
+        }
+    }
+    ASSERT_TRUE(reallocs < 40);
+    for (int i = 0; i < 100000; ++i) ASSERT_EQ(v[static_cast<size_t>(i)], i);
+}
+
+void test_relocatable_growth() {
+    printf("test_relocatable_growth...\n");
+    {
+        vector<handle> v;
+        for (int i = 0; i < 1000; ++i) v.emplace_back(i);
+        handle::moves = 0;
+        v.reserve(5000);
+        v.insert(v.begin() + 10, handle(-1));       // 只移动新元素（实参 → 临时 → 空位），已有元素整段 memmove
+        v.erase(v.begin(), v.begin() + 5);
+        ASSERT_EQ(handle::moves, 2);
+        ASSERT_EQ(v[5].value(), -1);
+        ASSERT_EQ(v[6].value(), 10);
+        ASSERT_EQ(v.back().value(), 999);
+        ASSERT_EQ(handle::alive, 996);
+
+        vector<slow_handle> s;
+        for (int i = 0; i < 100; ++i) s.emplace_back(i);
+        handle::moves = 0;
+        s.reserve(1000);
+        ASSERT_EQ(handle::moves, 100);
+        s.insert(s.begin(), slow_handle(7));
+        s.erase(s.begin() + 50);
+        ASSERT_EQ(s[0].value(), 7);
+        ASSERT_EQ(s[50].value(), 50);
+    }
+    ASSERT_EQ(handle::alive, 0);
+
+    {
+        small_vector<handle, 4> sv;
+        for (int i = 0; i < 20; ++i) sv.emplace_back(i);
+        handle::moves = 0;
+        sv.reserve(100);
+        sv.resize(3);
+        sv.shrink_to_fit();
+        ASSERT_TRUE(sv.is_inline());
+        ASSERT_EQ(handle::moves, 0);
+        small_vector<handle, 4> moved(static_cast<small_vector<handle, 4>&&>(sv));
+        ASSERT_EQ(handle::moves, 0);
+        ASSERT_EQ(moved[2].value(), 2);
+    }
+    ASSERT_EQ(handle::alive, 0);
+}
+
+void test_self_referencing_insert() {
+    printf("test_self_referencing_insert...\n");
+    vector<std::string> v;
+    v.push_back("first");
+    for (int i = 0; i < 200; ++i) {
+        v.push_back(v[0]);                          // 扩容时参数引用旧内存
+        v.insert(v.begin(), v.back());
+    }
+    for (auto& s : v) ASSERT_EQ(s, "first");
+
+    vector<int> iv(3, 7);
+    iv.insert(iv.begin() + 1, 100, iv[2]);
+    ASSERT_EQ(iv.size(), 103u);
+    for (int x : iv) ASSERT_EQ(x, 7);
+    iv.assign(5, iv[0]);
+    ASSERT_EQ(iv.size(), 5u);
+    iv.resize(50, iv[4]);
+    ASSERT_EQ(iv[49], 7);
+}
+
+void test_range_assign_insert() {
+    printf("test_range_assign_insert...\n");
+    std::vector<int> src;
+    for (int i = 0; i < 1000; ++i) src.push_back(i);
+
+    vector<int> v(src.begin(), src.end());
+    ASSERT_EQ(v.size(), 1000u);
+    ASSERT_EQ(v.capacity(), 1000u);                 // 已知长度：精确分配一次
+
+    v.assign(src.data(), src.data() + 10);
+    ASSERT_EQ(v.size(), 10u);
+    ASSERT_EQ(v.capacity(), 1000u);                 // 容量足够：不重新分配
+
+    int extra[5] = {-1, -2, -3, -4, -5};
+    v.insert(v.begin() + 3, extra, extra + 5);
+    ASSERT_EQ(v.size(), 15u);
+    ASSERT_EQ(v[3], -1);
+    ASSERT_EQ(v[7], -5);
+    ASSERT_EQ(v[8], 3);
+
+    vector<int> w;
+    w.push_back(1);
+    w.insert(w.end(), src.begin(), src.end());
+    ASSERT_EQ(w.capacity(), 1001u);                 // 一次扩容到位
+
+    vector<int> in;
+    in.push_back(-1);
+    in.push_back(-2);
+    in.insert(in.begin() + 1, counting_input{0}, counting_input{50});
+    ASSERT_EQ(in.size(), 52u);
+    ASSERT_EQ(in[0], -1);
+    ASSERT_EQ(in[1], 0);
+    ASSERT_EQ(in[50], 49);
+    ASSERT_EQ(in[51], -2);
+
+    vector<std::string> sv;
+    std::string words[3] = {"a", "b", "c"};
+    sv.assign(words, words + 3);
+    sv.insert(sv.begin(), words + 1, words + 3);
+    ASSERT_EQ(sv.size(), 5u);
+    ASSERT_EQ(sv[0], "b");
+    ASSERT_EQ(sv[2], "a");
+
+    small_vector<int, 8> small(src.begin(), src.begin() + 6);
+    ASSERT_TRUE(small.is_inline());
+    small.insert(small.begin(), counting_input{100}, counting_input{102});
+    ASSERT_EQ(small[0], 100);
+    ASSERT_EQ(small[2], 0);
+    ASSERT_TRUE(small.is_inline());
+}
+
+void test_deque_segmented_move() {
+    printf("test_deque_segmented_move...\n");
+    deque<uint64_t> d;
+    std::deque<uint64_t> ref;
+    uint64_t s = 0x9E3779B97F4A7C15ULL;
+    auto rnd = [&s]() { s ^= s << 13; s ^= s >> 7; s ^= s << 17; return s; };
+    for (int i = 0; i < 3000; ++i) { d.push_back(static_cast<uint64_t>(i)); ref.push_back(static_cast<uint64_t>(i)); }
+
+    for (int step = 0; step < 4000; ++step) {
+        uint64_t r = rnd();
+        size_t n = ref.size();
+        if (r % 3 == 0 && n > 0) {
+            size_t i = (r >> 8) % n;
+            size_t k = (r >> 24) % (n - i < 1500 ? n - i + 1 : 1500);
+            d.erase(d.begin() + static_cast<ptrdiff_t>(i), d.begin() + static_cast<ptrdiff_t>(i + k));
+            ref.erase(ref.begin() + static_cast<ptrdiff_t>(i), ref.begin() + static_cast<ptrdiff_t>(i + k));
+        } else {
+            size_t i = n ? (r >> 8) % (n + 1) : 0;
+            d.insert(d.begin() + static_cast<ptrdiff_t>(i), r);
+            ref.insert(ref.begin() + static_cast<ptrdiff_t>(i), r);
+        }
+        if (ref.size() < 100) {
+            for (int k = 0; k < 2000; ++k) { d.push_front(static_cast<uint64_t>(k)); ref.push_front(static_cast<uint64_t>(k)); }
+        }
+        ASSERT_EQ(d.size(), ref.size());
+        if (step % 200 == 0) {
+            for (size_t i = 0; i < ref.size(); ++i) ASSERT_EQ(d[i], ref[i]);
+        }
+    }
+    for (size_t i = 0; i < ref.size(); ++i) ASSERT_EQ(d[i], ref[i]);
+}
+
+int main() {
+    printf("=== trivially relocatable fast path Tests ===\n\n");
+
+    test_traits();
+    test_growth_factor();
+    test_relocatable_growth();
+    test_self_referencing_insert();
+    test_range_assign_insert();
+    test_deque_segmented_move();
+
+    printf("\n=== All tests passed! ===\n");
+    return 0;
+}